@@ -22,6 +22,18 @@ endmacro()
 # ## Add all required libraries and dependencies to the given target so it has access to all available renderers.
 # #####################################
 function(ez_add_renderers TARGET_NAME)
+	# The null renderer does not need any graphics API and is available everywhere.
+	target_link_libraries(${TARGET_NAME}
+		PRIVATE
+		RendererNull
+	)
+
+	if (TARGET ShaderCompilerNull)
+		add_dependencies(${TARGET_NAME}
+			ShaderCompilerNull
+		)
+	endif()
+
 	# PLATFORM-TODO
 	if(EZ_BUILD_EXPERIMENTAL_VULKAN)
 		target_link_libraries(${TARGET_NAME}
@@ -2,6 +2,7 @@
 
 #include <Core/CoreDLL.h>
 #include <Core/ResourceManager/Resource.h>
+#include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
 
 /// \brief Represents one resource to load / preload through an ezCollectionResource
 struct EZ_CORE_DLL ezCollectionEntry
@@ -71,6 +72,7 @@ public:
   /// This has to be called manually. It will return false if no more resources can be queued for preloading. This can be used
   /// as a workflow where PreloadResources and IsLoadingFinished are called repeadedly in tandem, so only a smaller fraction
   /// of resources gets queued and waited for, to allow simple resource load-balancing.
+  /// The files of the queued resources are prefetched in a background task, see ezFileSystem::PrefetchFiles().
   bool PreloadResources(ezUInt32 uiNumResourcesToPreload = ezMath::MaxValue<ezUInt32>());
 
   /// \brief Returns true if all resources added for preloading via PreloadResources have finished loading.
@@ -97,4 +99,5 @@ private:
   bool m_bRegistered = false;
   ezCollectionResourceDescriptor m_Collection;
   ezDynamicArray<ezTypelessResourceHandle> m_PreloadedResources;
+  ezTaskGroupID m_PrefetchTaskGroup;
 };
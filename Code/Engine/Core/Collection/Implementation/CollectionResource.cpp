@@ -1,7 +1,9 @@
 #include <Core/CorePCH.h>
 
 #include <Core/Collection/CollectionResource.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Utilities/AssetFileHeader.h>
 
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezCollectionResource, 1, ezRTTIDefaultAllocator<ezCollectionResource>)
@@ -35,6 +37,38 @@ bool ezCollectionResource::PreloadResources(ezUInt32 uiNumResourcesToPreload)
 
   const ezUInt32 remainingResources = m_Collection.m_Resources.GetCount() - m_PreloadedResources.GetCount();
   const ezUInt32 end = ezMath::Min(remainingResources, uiNumResourcesToPreload) + m_PreloadedResources.GetCount();
+
+  // let the file system fetch all files in one batch, e.g. over fileserve, instead of one by one when each resource is loaded
+  // this may take a while, so it runs in the background, resources that are loaded before it is done simply fetch their own files
+  {
+    class PrefetchFilesTask final : public ezTask
+    {
+    public:
+      ezDynamicArray<ezString> m_Files;
+
+    private:
+      virtual void Execute() override
+      {
+        ezFileSystem::PrefetchFiles(m_Files);
+      }
+    };
+
+    ezSharedPtr<PrefetchFilesTask> pPrefetchTask = EZ_DEFAULT_NEW(PrefetchFilesTask);
+    pPrefetchTask->ConfigureTask("Prefetch Collection Files", ezTaskNesting::Never);
+    pPrefetchTask->m_Files.Reserve(end - m_PreloadedResources.GetCount());
+
+    for (ezUInt32 i = m_PreloadedResources.GetCount(); i < end; ++i)
+    {
+      pPrefetchTask->m_Files.PushBack(m_Collection.m_Resources[i].m_sResourceID);
+    }
+
+    // consecutive prefetches run one after the other, so only the last one needs to be waited for
+    if (m_PrefetchTaskGroup.IsValid())
+      m_PrefetchTaskGroup = ezTaskSystem::StartSingleTask(pPrefetchTask, ezTaskPriority::LongRunning, m_PrefetchTaskGroup);
+    else
+      m_PrefetchTaskGroup = ezTaskSystem::StartSingleTask(pPrefetchTask, ezTaskPriority::LongRunning);
+  }
+
   for (ezUInt32 i = m_PreloadedResources.GetCount(); i < end; ++i)
   {
     const ezCollectionEntry& e = m_Collection.m_Resources[i];
@@ -158,6 +192,14 @@ ezResourceLoadDesc ezCollectionResource::UnloadData(Unload WhatToUnload)
 
   {
     UnregisterNames();
+
+    // the prefetch task doesn't reference this resource, but it must not outlive the data directories it reads from
+    if (m_PrefetchTaskGroup.IsValid())
+    {
+      ezTaskSystem::WaitForGroup(m_PrefetchTaskGroup);
+      m_PrefetchTaskGroup.Invalidate();
+    }
+
     // This lock unnecessary as this function is only called when the reference count is 0, i.e. if we deallocate this.
     // It is intentionally removed as it caused this lock and the resource manager lock to be locked in reverse order.
     // To prevent potential deadlocks and be able to sanity check our locking the entire codebase should never lock any
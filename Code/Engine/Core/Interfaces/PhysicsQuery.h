@@ -97,3 +97,45 @@ enum class ezPhysicsHitCollection
   Closest,
   Any
 };
+
+/// \brief The shape that is used by batched sweep and overlap queries.
+struct ezPhysicsQueryShape
+{
+  enum class Type : ezUInt8
+  {
+    Sphere,
+    Box,
+    Capsule,
+  };
+
+  Type m_Type = Type::Sphere;
+  float m_fRadius = 0.0f;                    ///< Radius of spheres and capsules.
+  float m_fHeight = 0.0f;                    ///< Height of capsules, excluding the caps. Capsules are oriented along the Z axis.
+  ezVec3 m_vBoxExtents = ezVec3::MakeZero(); ///< Full size of boxes.
+};
+
+/// \brief A single raycast in a batch, see ezPhysicsWorldModuleInterface::RaycastBatch()
+struct ezPhysicsRaycastQuery
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezVec3 m_vStart;
+  ezVec3 m_vDir; ///< Has to be normalized.
+  float m_fDistance;
+};
+
+/// \brief A single shape sweep in a batch, see ezPhysicsWorldModuleInterface::SweepBatch()
+struct ezPhysicsSweepQuery
+{
+  ezPhysicsQueryShape m_Shape;
+  ezTransform m_Transform;
+  ezVec3 m_vDir; ///< Has to be normalized.
+  float m_fDistance;
+};
+
+/// \brief A single overlap test in a batch, see ezPhysicsWorldModuleInterface::OverlapBatch()
+struct ezPhysicsOverlapQuery
+{
+  ezPhysicsQueryShape m_Shape;
+  ezTransform m_Transform;
+};
@@ -89,5 +89,82 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezMsgBuildStaticMesh, 1, ezRTTIDefaultAllocator<
 EZ_END_DYNAMIC_REFLECTED_TYPE;
 // clang-format on
 
+ezUInt32 ezPhysicsWorldModuleInterface::RaycastBatch(ezArrayPtr<const ezPhysicsRaycastQuery> queries, ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == queries.GetCount() && out_hits.GetCount() == queries.GetCount(), "Result arrays must have the same size as the query array");
+
+  ezUInt32 uiNumHits = 0;
+  for (ezUInt32 i = 0; i < queries.GetCount(); ++i)
+  {
+    const ezPhysicsRaycastQuery& query = queries[i];
+    out_hits[i] = Raycast(out_results[i], query.m_vStart, query.m_vDir, query.m_fDistance, params, collection);
+    uiNumHits += out_hits[i] ? 1 : 0;
+  }
+
+  return uiNumHits;
+}
+
+ezUInt32 ezPhysicsWorldModuleInterface::SweepBatch(ezArrayPtr<const ezPhysicsSweepQuery> queries, ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == queries.GetCount() && out_hits.GetCount() == queries.GetCount(), "Result arrays must have the same size as the query array");
+
+  ezUInt32 uiNumHits = 0;
+  for (ezUInt32 i = 0; i < queries.GetCount(); ++i)
+  {
+    const ezPhysicsSweepQuery& query = queries[i];
+    const ezPhysicsQueryShape& shape = query.m_Shape;
+
+    switch (shape.m_Type)
+    {
+      case ezPhysicsQueryShape::Type::Sphere:
+        out_hits[i] = SweepTestSphere(out_results[i], shape.m_fRadius, query.m_Transform.m_vPosition, query.m_vDir, query.m_fDistance, params, collection);
+        break;
+
+      case ezPhysicsQueryShape::Type::Box:
+        out_hits[i] = SweepTestBox(out_results[i], shape.m_vBoxExtents, query.m_Transform, query.m_vDir, query.m_fDistance, params, collection);
+        break;
+
+      case ezPhysicsQueryShape::Type::Capsule:
+        out_hits[i] = SweepTestCapsule(out_results[i], shape.m_fRadius, shape.m_fHeight, query.m_Transform, query.m_vDir, query.m_fDistance, params, collection);
+        break;
+    }
+
+    uiNumHits += out_hits[i] ? 1 : 0;
+  }
+
+  return uiNumHits;
+}
+
+ezUInt32 ezPhysicsWorldModuleInterface::OverlapBatch(ezArrayPtr<const ezPhysicsOverlapQuery> queries, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params) const
+{
+  EZ_ASSERT_DEV(out_hits.GetCount() == queries.GetCount(), "Result array must have the same size as the query array");
+
+  ezUInt32 uiNumHits = 0;
+  for (ezUInt32 i = 0; i < queries.GetCount(); ++i)
+  {
+    const ezPhysicsOverlapQuery& query = queries[i];
+    const ezPhysicsQueryShape& shape = query.m_Shape;
+
+    switch (shape.m_Type)
+    {
+      case ezPhysicsQueryShape::Type::Sphere:
+        out_hits[i] = OverlapTestSphere(shape.m_fRadius, query.m_Transform.m_vPosition, params);
+        break;
+
+      case ezPhysicsQueryShape::Type::Capsule:
+        out_hits[i] = OverlapTestCapsule(shape.m_fRadius, shape.m_fHeight, query.m_Transform, params);
+        break;
+
+      default:
+        out_hits[i] = false;
+        break;
+    }
+
+    uiNumHits += out_hits[i] ? 1 : 0;
+  }
+
+  return uiNumHits;
+}
+
 
 EZ_STATICLINK_FILE(Core, Core_Interfaces_PhysicsWorldModule);
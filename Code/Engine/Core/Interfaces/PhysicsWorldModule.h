@@ -41,6 +41,24 @@ public:
 
   virtual void QueryShapesInSphere(ezPhysicsOverlapResultArray& out_results, float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const = 0;
 
+  /// \brief Executes many raycasts with the same query parameters at once.
+  ///
+  /// out_results and out_hits must have the same size as queries. out_hits[i] is set to whether queries[i] hit anything,
+  /// out_results[i] is only valid if it did.
+  /// Returns the number of queries that hit something.
+  ///
+  /// The default implementation calls Raycast() for every query. Physics integrations should override this to
+  /// share the query setup between all queries and to distribute large batches across multiple threads.
+  virtual ezUInt32 RaycastBatch(ezArrayPtr<const ezPhysicsRaycastQuery> queries, ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const;
+
+  /// \brief Executes many shape sweeps with the same query parameters at once. See RaycastBatch() for details.
+  virtual ezUInt32 SweepBatch(ezArrayPtr<const ezPhysicsSweepQuery> queries, ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const;
+
+  /// \brief Executes many overlap tests with the same query parameters at once. See RaycastBatch() for details.
+  ///
+  /// The default implementation only supports spheres and capsules, box queries always report no overlap.
+  virtual ezUInt32 OverlapBatch(ezArrayPtr<const ezPhysicsOverlapQuery> queries, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params) const;
+
   virtual ezVec3 GetGravity() const = 0;
 
   //////////////////////////////////////////////////////////////////////////
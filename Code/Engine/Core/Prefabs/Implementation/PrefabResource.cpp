@@ -66,7 +66,71 @@ ezPrefabResource::InstantiateResult ezPrefabResource::InstantiatePrefab(const ez
   }
 }
 
-void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, const ezDynamicArray<ezGameObject*>& createdChildObjects, const ezDynamicArray<ezGameObject*>& createdRootObjects) const
+void ezPrefabResource::InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues)
+{
+  if (GetLoadingState() != ezResourceState::Loaded)
+    return;
+
+  if (pExposedParamValues != nullptr && !pExposedParamValues->IsEmpty())
+  {
+    ezDynamicArray<ezGameObject*> createdRootObjects;
+    ezDynamicArray<ezGameObject*> createdChildObjects;
+
+    if (options.m_pCreatedRootObjectsOut == nullptr)
+    {
+      options.m_pCreatedRootObjectsOut = &createdRootObjects;
+    }
+
+    if (options.m_pCreatedChildObjectsOut == nullptr)
+    {
+      options.m_pCreatedChildObjectsOut = &createdChildObjects;
+    }
+
+    EZ_ASSERT_DEBUG(options.m_pCreatedRootObjectsOut != options.m_pCreatedChildObjectsOut, "These pointers must point to different arrays, otherwise applying exposed properties doesn't work correctly.");
+
+    // the output arrays may already contain objects from before
+    const ezUInt32 uiFirstRootObject = options.m_pCreatedRootObjectsOut->GetCount();
+    const ezUInt32 uiFirstChildObject = options.m_pCreatedChildObjectsOut->GetCount();
+
+    m_WorldReader.InstantiatePrefabs(ref_world, rootTransforms, options);
+
+    // every instance creates the same number of objects, so each one owns a fixed slice of the output arrays
+    const ezUInt32 uiNumRootObjects = m_WorldReader.GetRootObjectCount();
+    const ezUInt32 uiNumChildObjects = m_WorldReader.GetChildObjectCount();
+
+    for (ezUInt32 i = 0; i < rootTransforms.GetCount(); ++i)
+    {
+      const ezArrayPtr<ezGameObject* const> rootObjects = options.m_pCreatedRootObjectsOut->GetArrayPtr().GetSubArray(uiFirstRootObject + i * uiNumRootObjects, uiNumRootObjects);
+      const ezArrayPtr<ezGameObject* const> childObjects = options.m_pCreatedChildObjectsOut->GetArrayPtr().GetSubArray(uiFirstChildObject + i * uiNumChildObjects, uiNumChildObjects);
+
+      ApplyExposedParameterValues(pExposedParamValues, childObjects, rootObjects);
+    }
+  }
+  else
+  {
+    m_WorldReader.InstantiatePrefabs(ref_world, rootTransforms, options);
+  }
+}
+
+ezPrefabResource::InstantiateResult ezPrefabResource::InstantiatePrefabs(const ezPrefabResourceHandle& hPrefab, bool bBlockTillLoaded, ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, ezPrefabInstantiationOptions options, const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues /*= nullptr*/)
+{
+  ezResourceLock<ezPrefabResource> pPrefab(hPrefab, bBlockTillLoaded ? ezResourceAcquireMode::BlockTillLoaded_NeverFail : ezResourceAcquireMode::AllowLoadingFallback_NeverFail);
+
+  switch (pPrefab.GetAcquireResult())
+  {
+    case ezResourceAcquireResult::Final:
+      pPrefab->InstantiatePrefabs(ref_world, rootTransforms, options, pExposedParamValues);
+      return InstantiateResult::Success;
+
+    case ezResourceAcquireResult::LoadingFallback:
+      return InstantiateResult::NotYetLoaded;
+
+    default:
+      return InstantiateResult::Error;
+  }
+}
+
+void ezPrefabResource::ApplyExposedParameterValues(const ezArrayMap<ezHashedString, ezVariant>* pExposedParamValues, ezArrayPtr<ezGameObject* const> createdChildObjects, ezArrayPtr<ezGameObject* const> createdRootObjects) const
 {
   const ezUInt32 uiNumParamDescs = m_PrefabParamDescs.GetCount();
 
@@ -142,6 +142,9 @@ void ezResource::CallUnloadData(Unload WhatToUnload)
   e.m_Type = ezResourceEvent::Type::ResourceContentUnloading;
   ezResourceManager::BroadcastResourceEvent(e);
 
+  // lock-free acquires must take the regular path from now on
+  m_bIsFullyLoaded = false;
+
   ezResourceLoadDesc ld = UnloadData(WhatToUnload);
 
   EZ_ASSERT_DEV(ld.m_State != ezResourceState::Invalid, "UnloadData() did not return a valid resource load state");
@@ -151,6 +154,12 @@ void ezResource::CallUnloadData(Unload WhatToUnload)
   m_LoadingState = ld.m_State;
   m_uiQualityLevelsDiscardable = ld.m_uiQualityLevelsDiscardable;
   m_uiQualityLevelsLoadable = ld.m_uiQualityLevelsLoadable;
+  UpdateIsFullyLoaded();
+}
+
+void ezResource::UpdateIsFullyLoaded()
+{
+  m_bIsFullyLoaded = (m_LoadingState == ezResourceState::Loaded) && (m_uiQualityLevelsLoadable == 0);
 }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -191,6 +200,7 @@ void ezResource::CallUpdateContent(ezStreamReader* Stream)
   m_uiQualityLevelsDiscardable = ld.m_uiQualityLevelsDiscardable;
   m_uiQualityLevelsLoadable = ld.m_uiQualityLevelsLoadable;
   m_LoadingState = ld.m_State;
+  UpdateIsFullyLoaded();
 
   ezResourceEvent e;
   e.m_pResource = this;
@@ -275,6 +285,7 @@ void ezResource::VerifyAfterCreateResource(const ezResourceLoadDesc& ld)
   m_LoadingState = ld.m_State;
   m_uiQualityLevelsDiscardable = ld.m_uiQualityLevelsDiscardable;
   m_uiQualityLevelsLoadable = ld.m_uiQualityLevelsLoadable;
+  UpdateIsFullyLoaded();
 
   /* Update Memory Usage*/
   {
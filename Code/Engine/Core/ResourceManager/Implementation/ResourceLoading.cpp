@@ -6,6 +6,11 @@
 
 ezTypelessResourceHandle ezResourceManager::LoadResourceByType(const ezRTTI* pResourceType, ezStringView sResourceID)
 {
+  // most of the time the resource exists already, which only requires locking its shard
+  ezTypelessResourceHandle hResource = FindLoadedResourceHandle(pResourceType, sResourceID);
+  if (hResource.IsValid())
+    return hResource;
+
   // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
   EZ_LOCK(s_ResourceMutex);
   return ezTypelessResourceHandle(GetResource(pResourceType, sResourceID, true));
@@ -353,12 +358,16 @@ ezUInt32 ezResourceManager::ReloadResourcesOfType(const ezRTTI* pType, bool bFor
 
   ezUInt32 count = 0;
 
-  LoadedResources& lr = s_pState->m_LoadedResources[pType];
-
-  for (auto it = lr.m_Resources.GetIterator(); it.IsValid(); ++it)
+  for (const LoadedResourcesShard& shard : GetLoadedResourcesShards())
   {
-    if (ReloadResource(it.Value(), bForce))
-      ++count;
+    if (const LoadedResources* pLoadedResources = shard.m_LoadedResources.GetValue(pType))
+    {
+      for (auto it = pLoadedResources->m_Resources.GetIterator(); it.IsValid(); ++it)
+      {
+        if (ReloadResource(it.Value(), bForce))
+          ++count;
+      }
+    }
   }
 
   return count;
@@ -373,12 +382,15 @@ ezUInt32 ezResourceManager::ReloadAllResources(bool bForce)
 
   ezUInt32 count = 0;
 
-  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  for (const LoadedResourcesShard& shard : GetLoadedResourcesShards())
   {
-    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    for (auto itType = shard.m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
     {
-      if (ReloadResource(it.Value(), bForce))
-        ++count;
+      for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+      {
+        if (ReloadResource(it.Value(), bForce))
+          ++count;
+      }
     }
   }
 
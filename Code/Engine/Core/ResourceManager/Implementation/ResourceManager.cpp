@@ -172,32 +172,38 @@ ezUInt32 ezResourceManager::FreeAllUnusedResources()
 
       bUnloadedAny = false;
 
-      for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+      for (LoadedResourcesShard& shard : GetLoadedResourcesShards())
       {
-        LoadedResources& lr = itType.Value();
+        // prevents FindLoadedResourceHandle() from handing out new references while we check the reference count
+        EZ_LOCK(shard.m_Mutex);
 
-        for (auto it = lr.m_Resources.GetIterator(); it.IsValid(); /* empty */)
+        for (auto itType = shard.m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
         {
-          ezResource* pReference = it.Value();
+          LoadedResources& lr = itType.Value();
 
-          if (pReference->m_iReferenceCount == 0)
+          for (auto it = lr.m_Resources.GetIterator(); it.IsValid(); /* empty */)
           {
-            bUnloadedAny = true; // make sure to try again, even if DeallocateResource() fails; need to release our lock for that to prevent dead-locks
+            ezResource* pReference = it.Value();
 
-            if (DeallocateResource(pReference).Succeeded())
+            if (pReference->m_iReferenceCount == 0)
             {
-              ++uiUnloaded;
-
-              it = lr.m_Resources.Remove(it);
-              continue;
-            }
-            else
-            {
-              bAnyFailed = true;
+              bUnloadedAny = true; // make sure to try again, even if DeallocateResource() fails; need to release our lock for that to prevent dead-locks
+
+              if (DeallocateResource(pReference).Succeeded())
+              {
+                ++uiUnloaded;
+
+                it = lr.m_Resources.Remove(it);
+                continue;
+              }
+              else
+              {
+                bAnyFailed = true;
+              }
             }
-          }
 
-          ++it;
+            ++it;
+          }
         }
       }
     }
@@ -229,14 +235,27 @@ ezUInt32 ezResourceManager::FreeUnusedResources(ezTime timeout, ezTime lastAcqui
   EZ_LOG_BLOCK("ezResourceManager::FreeUnusedResources");
   EZ_PROFILE_SCOPE("FreeUnusedResources");
 
-  auto itResourceType = s_pState->m_LoadedResources.Find(s_pState->m_pFreeUnusedLastType);
+  ezArrayPtr<LoadedResourcesShard> shards = GetLoadedResourcesShards();
+
+  ezUInt32 uiShard = s_pState->m_uiFreeUnusedLastShard;
+  auto itResourceType = shards[uiShard].m_LoadedResources.Find(s_pState->m_pFreeUnusedLastType);
   if (!itResourceType.IsValid())
   {
-    itResourceType = s_pState->m_LoadedResources.GetIterator();
+    itResourceType = shards[uiShard].m_LoadedResources.GetIterator();
   }
 
-  if (!itResourceType.IsValid())
-    return 0;
+  while (!itResourceType.IsValid())
+  {
+    if (++uiShard == NumLoadedResourcesShards)
+    {
+      s_pState->m_uiFreeUnusedLastShard = 0;
+      s_pState->m_pFreeUnusedLastType = nullptr;
+      s_pState->m_sFreeUnusedLastResourceID = ezTempHashedString();
+      return 0;
+    }
+
+    itResourceType = shards[uiShard].m_LoadedResources.GetIterator();
+  }
 
   auto itResourceID = itResourceType.Value().m_Resources.Find(s_pState->m_sFreeUnusedLastResourceID);
   if (!itResourceID.IsValid())
@@ -258,16 +277,22 @@ ezUInt32 ezResourceManager::FreeUnusedResources(ezTime timeout, ezTime lastAcqui
     if (!itResourceID.IsValid())
     {
       // reached the end of this resource type
-      // advance to the next resource type
+      // advance to the next resource type, or the first one in the next shard
       ++itResourceType;
 
-      if (!itResourceType.IsValid())
+      while (!itResourceType.IsValid())
       {
-        // if we reached the end, reset everything and stop
+        if (++uiShard == NumLoadedResourcesShards)
+        {
+          // if we reached the end, reset everything and stop
+
+          s_pState->m_uiFreeUnusedLastShard = 0;
+          s_pState->m_pFreeUnusedLastType = nullptr;
+          s_pState->m_sFreeUnusedLastResourceID = ezTempHashedString();
+          return uiDeallocatedCount;
+        }
 
-        s_pState->m_pFreeUnusedLastType = nullptr;
-        s_pState->m_sFreeUnusedLastResourceID = ezTempHashedString();
-        return uiDeallocatedCount;
+        itResourceType = shards[uiShard].m_LoadedResources.GetIterator();
       }
 
 
@@ -276,6 +301,7 @@ ezUInt32 ezResourceManager::FreeUnusedResources(ezTime timeout, ezTime lastAcqui
       continue;
     }
 
+    s_pState->m_uiFreeUnusedLastShard = uiShard;
     s_pState->m_pFreeUnusedLastType = itResourceType.Key();
     s_pState->m_sFreeUnusedLastResourceID = itResourceID.Key();
 
@@ -294,15 +320,21 @@ ezUInt32 ezResourceManager::FreeUnusedResources(ezTime timeout, ezTime lastAcqui
 
     if ((pResource->GetReferenceCount() == 0) && (tStart - pResource->GetLastAcquireTime() > lastAcquireThreshold))
     {
-      sResourceName = pResource->GetResourceID();
+      // FindLoadedResourceHandle() may hand out a new reference until we hold the shard lock, so check again
+      EZ_LOCK(shards[uiShard].m_Mutex);
 
-      if (DeallocateResource(pResource).Succeeded())
+      if (pResource->GetReferenceCount() == 0)
       {
-        ezLog::Debug("Freed '{}'", ezArgSensitive(sResourceName, "ResourceID"));
+        sResourceName = pResource->GetResourceID();
 
-        ++uiDeallocatedCount;
-        itResourceID = itResourceType.Value().m_Resources.Remove(itResourceID);
-        continue;
+        if (DeallocateResource(pResource).Succeeded())
+        {
+          ezLog::Debug("Freed '{}'", ezArgSensitive(sResourceName, "ResourceID"));
+
+          ++uiDeallocatedCount;
+          itResourceID = itResourceType.Value().m_Resources.Remove(itResourceID);
+          continue;
+        }
       }
     }
 
@@ -430,12 +462,15 @@ void ezResourceManager::ResetAllResources()
   EZ_LOCK(s_ResourceMutex);
   EZ_LOG_BLOCK("ezResourceManager::ReloadAllResources");
 
-  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+  for (const LoadedResourcesShard& shard : GetLoadedResourcesShards())
   {
-    for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+    for (auto itType = shard.m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
     {
-      ezResource* pResource = it.Value();
-      pResource->ResetResource();
+      for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+      {
+        ezResource* pResource = it.Value();
+        pResource->ResetResource();
+      }
     }
   }
 }
@@ -452,15 +487,18 @@ void ezResourceManager::PerFrameUpdate()
 
     s_pState->m_bBroadcastExistsEvent = false;
 
-    for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
+    for (const LoadedResourcesShard& shard : GetLoadedResourcesShards())
     {
-      for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+      for (auto itType = shard.m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
       {
-        ezResourceEvent e;
-        e.m_Type = ezResourceEvent::Type::ResourceExists;
-        e.m_pResource = it.Value();
+        for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+        {
+          ezResourceEvent e;
+          e.m_Type = ezResourceEvent::Type::ResourceExists;
+          e.m_pResource = it.Value();
 
-        ezResourceManager::BroadcastResourceEvent(e);
+          ezResourceManager::BroadcastResourceEvent(e);
+        }
       }
     }
   }
@@ -470,23 +508,14 @@ void ezResourceManager::PerFrameUpdate()
 
     for (auto it = s_pState->m_ResourcesToUnloadOnMainThread.GetIterator(); it.IsValid(); it.Next())
     {
-      // Identify the container of loaded resource for the type of resource we want to unload.
-      LoadedResources loadedResourcesForType;
-      if (s_pState->m_LoadedResources.TryGetValue(it.Value(), loadedResourcesForType) == false)
-      {
-        continue;
-      }
-
       // See, if the resource we want to unload still exists.
-      ezResource* resourceToUnload = nullptr;
+      ezResource* resourceToUnload = FindLoadedResource(it.Value(), it.Key());
 
-      if (loadedResourcesForType.m_Resources.TryGetValue(it.Key(), resourceToUnload) == false)
+      if (resourceToUnload == nullptr)
       {
         continue;
       }
 
-      EZ_ASSERT_DEV(resourceToUnload != nullptr, "Found a resource above, should not be nullptr.");
-
       // If the resource was still loaded, we are going to unload it now.
       resourceToUnload->CallUnloadData(ezResource::Unload::AllQualityLevels);
 
@@ -584,15 +613,18 @@ void ezResourceManager::EngineAboutToShutdown()
     // some resources may still be flagged as 'loading', but can never get loaded.
     // That can deadlock the 'FreeAllUnused' function, because it won't delete 'loading' resources.
     // Therefore we need to make sure no resource has the IsQueuedForLoading flag set anymore.
-    for (auto itTypes : s_pState->m_LoadedResources)
+    for (const LoadedResourcesShard& shard : GetLoadedResourcesShards())
     {
-      for (auto itRes : itTypes.Value().m_Resources)
+      for (auto itTypes : shard.m_LoadedResources)
       {
-        ezResource* pRes = itRes.Value();
-
-        if (pRes->GetBaseResourceFlags().IsSet(ezResourceFlags::IsQueuedForLoading))
+        for (auto itRes : itTypes.Value().m_Resources)
         {
-          pRes->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+          ezResource* pRes = itRes.Value();
+
+          if (pRes->GetBaseResourceFlags().IsSet(ezResourceFlags::IsQueuedForLoading))
+          {
+            pRes->m_Flags.Remove(ezResourceFlags::IsQueuedForLoading);
+          }
         }
       }
     }
@@ -651,27 +683,36 @@ void ezResourceManager::OnCoreShutdown()
 
   EZ_LOG_BLOCK("Referenced Resources");
 
-  for (auto itType = s_pState->m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
-  {
-    const ezRTTI* pRtti = itType.Key();
-    LoadedResources& lr = itType.Value();
+  // the resources of one type are spread over all shards, gather them to report them per type
+  ezMap<const ezRTTI*, ezDynamicArray<ezResource*>> referencedResources;
 
-    if (!lr.m_Resources.IsEmpty())
+  for (const LoadedResourcesShard& shard : GetLoadedResourcesShards())
+  {
+    for (auto itType = shard.m_LoadedResources.GetIterator(); itType.IsValid(); ++itType)
     {
-      EZ_LOG_BLOCK("Type", pRtti->GetTypeName());
+      for (auto it = itType.Value().m_Resources.GetIterator(); it.IsValid(); ++it)
+      {
+        referencedResources[itType.Key()].PushBack(it.Value());
+      }
+    }
+  }
 
-      ezLog::Error("{0} resource of type '{1}' are still referenced.", lr.m_Resources.GetCount(), pRtti->GetTypeName());
+  for (auto itType = referencedResources.GetIterator(); itType.IsValid(); ++itType)
+  {
+    const ezRTTI* pRtti = itType.Key();
+    const ezDynamicArray<ezResource*>& resources = itType.Value();
 
-      for (auto it = lr.m_Resources.GetIterator(); it.IsValid(); ++it)
-      {
-        ezResource* pReference = it.Value();
+    EZ_LOG_BLOCK("Type", pRtti->GetTypeName());
+
+    ezLog::Error("{0} resource of type '{1}' are still referenced.", resources.GetCount(), pRtti->GetTypeName());
 
-        ezLog::Info("RC = {0}, ID = '{1}'", pReference->GetReferenceCount(), ezArgSensitive(pReference->GetResourceID(), "ResourceID"));
+    for (ezResource* pReference : resources)
+    {
+      ezLog::Info("RC = {0}, ID = '{1}'", pReference->GetReferenceCount(), ezArgSensitive(pReference->GetResourceID(), "ResourceID"));
 
 #if EZ_ENABLED(EZ_RESOURCEHANDLE_STACK_TRACES)
-        pReference->PrintHandleStackTraces();
+      pReference->PrintHandleStackTraces();
 #endif
-      }
     }
   }
 
@@ -703,14 +744,16 @@ ezResource* ezResourceManager::GetResource(const ezRTTI* pRtti, ezStringView sRe
   ezResource* pResource = nullptr;
   ezTempHashedString sHashedResourceID(sResourceID);
 
-  ezHashedString* redirection;
-  if (s_pState->m_NamedResources.TryGetValue(sHashedResourceID, redirection))
+  ezHashedString sRedirection;
+  if (ResolveNamedResource(sHashedResourceID, sRedirection))
   {
-    sHashedResourceID = *redirection;
-    sResourceID = redirection->GetView();
+    sResourceID = sRedirection.GetView();
   }
 
-  LoadedResources& lr = s_pState->m_LoadedResources[pRtti];
+  LoadedResourcesShard& shard = GetLoadedResourcesShard(pRtti, sHashedResourceID);
+  EZ_LOCK(shard.m_Mutex);
+
+  LoadedResources& lr = shard.m_LoadedResources[pRtti];
 
   if (lr.m_Resources.TryGetValue(sHashedResourceID, pResource))
     return pResource;
@@ -796,15 +839,13 @@ ezString ezResourceManager::GenerateUniqueResourceID(ezStringView sResourceIDPre
 
 ezTypelessResourceHandle ezResourceManager::GetExistingResourceByType(const ezRTTI* pResourceType, ezStringView sResourceID)
 {
-  ezResource* pResource = nullptr;
-
   const ezTempHashedString sResourceHash(sResourceID);
 
   EZ_LOCK(s_ResourceMutex);
 
   const ezRTTI* pRtti = FindResourceTypeOverride(pResourceType, sResourceID);
 
-  if (s_pState->m_LoadedResources[pRtti].m_Resources.TryGetValue(sResourceHash, pResource))
+  if (ezResource* pResource = FindLoadedResource(pRtti, sResourceHash))
     return ezTypelessResourceHandle(pResource);
 
   return ezTypelessResourceHandle();
@@ -851,6 +892,7 @@ void ezResourceManager::RegisterNamedResource(ezStringView sLookupName, ezString
   ezHashedString redirection;
   redirection.Assign(sRedirectionResource);
 
+  EZ_LOCK(s_pState->m_NamedResourcesMutex);
   s_pState->m_NamedResources[lookup] = redirection;
 }
 
@@ -859,6 +901,8 @@ void ezResourceManager::UnregisterNamedResource(ezStringView sLookupName)
   EZ_LOCK(s_ResourceMutex);
 
   ezTempHashedString hash(sLookupName);
+
+  EZ_LOCK(s_pState->m_NamedResourcesMutex);
   s_pState->m_NamedResources.Remove(hash);
 }
 
@@ -942,9 +986,86 @@ ezTime ezResourceManager::GetLastFrameUpdate()
   return s_pState->m_LastFrameUpdate;
 }
 
-ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources>& ezResourceManager::GetLoadedResources()
+ezArrayPtr<ezResourceManager::LoadedResourcesShard> ezResourceManager::GetLoadedResourcesShards()
+{
+  return ezMakeArrayPtr(s_pState->m_LoadedResources);
+}
+
+ezResourceManager::LoadedResourcesShard& ezResourceManager::GetLoadedResourcesShard(const ezRTTI* pRtti, const ezTempHashedString& sResourceID)
+{
+  // the type is part of the hash, but most resources are of few types, so the ID has to distribute them
+  const ezUInt64 uiHash = sResourceID.GetHash() ^ (reinterpret_cast<size_t>(pRtti) >> 4);
+  return s_pState->m_LoadedResources[uiHash % NumLoadedResourcesShards];
+}
+
+ezResource* ezResourceManager::FindLoadedResource(const ezRTTI* pRtti, const ezTempHashedString& sResourceID)
 {
-  return s_pState->m_LoadedResources;
+  // the caller must hold either s_ResourceMutex or the lock of the corresponding shard
+  const LoadedResourcesShard& shard = GetLoadedResourcesShard(pRtti, sResourceID);
+
+  ezResource* pResource = nullptr;
+
+  if (const LoadedResources* pLoadedResources = shard.m_LoadedResources.GetValue(pRtti))
+  {
+    pLoadedResources->m_Resources.TryGetValue(sResourceID, pResource);
+  }
+
+  return pResource;
+}
+
+ezTypelessResourceHandle ezResourceManager::FindLoadedResourceHandle(const ezRTTI* pResourceType, ezStringView sResourceID)
+{
+  if (sResourceID.IsEmpty())
+    return ezTypelessResourceHandle();
+
+  const ezRTTI* pRtti = FindResourceTypeOverride(pResourceType, sResourceID);
+
+  ezTempHashedString sHashedResourceID(sResourceID);
+  ezHashedString sRedirection;
+  ResolveNamedResource(sHashedResourceID, sRedirection);
+
+  // the shard lock prevents a race between resource unloading and storing the pointer in the handle
+  LoadedResourcesShard& shard = GetLoadedResourcesShard(pRtti, sHashedResourceID);
+  EZ_LOCK(shard.m_Mutex);
+
+  return ezTypelessResourceHandle(FindLoadedResource(pRtti, sHashedResourceID));
+}
+
+bool ezResourceManager::ResolveNamedResource(ezTempHashedString& inout_sResourceID, ezHashedString& out_sRedirection)
+{
+  EZ_LOCK(s_pState->m_NamedResourcesMutex);
+
+  const ezHashedString* pRedirection = nullptr;
+  if (!s_pState->m_NamedResources.TryGetValue(inout_sResourceID, pRedirection))
+    return false;
+
+  // copy the redirection, the entry may be removed as soon as we release the lock
+  out_sRedirection = *pRedirection;
+  inout_sResourceID = out_sRedirection;
+  return true;
+}
+
+void ezResourceManager::CollectAllResourcesOfType(const ezRTTI* pBaseType, ezDynamicArray<ezResource*>& out_resources)
+{
+  EZ_ASSERT_DEBUG(s_ResourceMutex.IsLocked(), "The resource mutex must be locked while iterating over the loaded resources");
+
+  for (const LoadedResourcesShard& shard : GetLoadedResourcesShards())
+  {
+    for (auto itType = shard.m_LoadedResources.GetIterator(); itType.IsValid(); itType.Next())
+    {
+      if (itType.Key()->IsDerivedFrom(pBaseType))
+      {
+        const LoadedResources& lr = itType.Value();
+
+        out_resources.Reserve(out_resources.GetCount() + lr.m_Resources.GetCount());
+
+        for (auto itResource : lr.m_Resources)
+        {
+          out_resources.PushBack(itResource.Value());
+        }
+      }
+    }
+  }
 }
 
 ezDynamicArray<ezResource*>& ezResourceManager::GetLoadedResourceOfTypeTempContainer()
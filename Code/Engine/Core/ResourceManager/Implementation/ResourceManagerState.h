@@ -53,7 +53,7 @@ private:
   // resources in this queue are waiting for a task to load them
   ezDeque<ezResourceManager::LoadingInfo> m_LoadingQueue;
 
-  ezHashTable<const ezRTTI*, ezResourceManager::LoadedResources> m_LoadedResources;
+  ezResourceManager::LoadedResourcesShard m_LoadedResources[ezResourceManager::NumLoadedResourcesShards];
 
   bool m_bAllowLaunchDataLoadTask = true;
   bool m_bShutdown = false;
@@ -67,6 +67,7 @@ private:
   ezDynamicArray<ezResource*> m_LoadedResourceOfTypeTempContainer;
   ezHashTable<ezTempHashedString, const ezRTTI*> m_ResourcesToUnloadOnMainThread;
 
+  ezUInt32 m_uiFreeUnusedLastShard = 0;
   const ezRTTI* m_pFreeUnusedLastType = nullptr;
   ezTempHashedString m_sFreeUnusedLastResourceID;
 
@@ -85,6 +86,7 @@ private:
 
   // Named resources
 
+  ezMutex m_NamedResourcesMutex; // lookups happen without s_ResourceMutex
   ezHashTable<ezTempHashedString, ezHashedString> m_NamedResources;
 
   // Asset system interaction
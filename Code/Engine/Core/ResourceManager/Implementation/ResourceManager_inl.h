@@ -11,20 +11,15 @@ ResourceType* ezResourceManager::GetResource(ezStringView sResourceID, bool bIsR
 template <typename ResourceType>
 ezTypedResourceHandle<ResourceType> ezResourceManager::LoadResource(ezStringView sResourceID)
 {
-  // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
-  EZ_LOCK(s_ResourceMutex);
-  return ezTypedResourceHandle<ResourceType>(GetResource<ResourceType>(sResourceID, true));
+  ezTypedResourceHandle<ResourceType> hResource;
+  hResource.m_hTypeless = LoadResourceByType(ezGetStaticRTTI<ResourceType>(), sResourceID);
+  return hResource;
 }
 
 template <typename ResourceType>
 ezTypedResourceHandle<ResourceType> ezResourceManager::LoadResource(ezStringView sResourceID, ezTypedResourceHandle<ResourceType> hLoadingFallback)
 {
-  ezTypedResourceHandle<ResourceType> hResource;
-  {
-    // the mutex here is necessary to prevent a race between resource unloading and storing the pointer in the handle
-    EZ_LOCK(s_ResourceMutex);
-    hResource = ezTypedResourceHandle<ResourceType>(GetResource<ResourceType>(sResourceID, true));
-  }
+  ezTypedResourceHandle<ResourceType> hResource = LoadResource<ResourceType>(sResourceID);
 
   if (hLoadingFallback.IsValid())
   {
@@ -45,7 +40,8 @@ ezTypedResourceHandle<ResourceType> ezResourceManager::GetExistingResource(ezStr
 
   const ezRTTI* pRtti = FindResourceTypeOverride(ezGetStaticRTTI<ResourceType>(), sResourceID);
 
-  if (GetLoadedResources()[pRtti].m_Resources.TryGetValue(sResourceHash, pResource))
+  pResource = FindLoadedResource(pRtti, sResourceHash);
+  if (pResource != nullptr)
     return ezTypedResourceHandle<ResourceType>((ResourceType*)pResource);
 
   return ezTypedResourceHandle<ResourceType>();
@@ -154,7 +150,21 @@ ResourceType* ezResourceManager::BeginAcquireResource(const ezTypedResourceHandl
 
   // only set the last accessed time stamp, if it is actually needed, pointer-only access might not mean that the resource is used
   // productively
-  pResource->m_LastAcquire = GetLastFrameUpdate();
+  // the time stamp only changes once per frame, skipping redundant writes keeps the cache line shared between all acquiring threads
+  const ezTime tLastFrameUpdate = GetLastFrameUpdate();
+  if (pResource->m_LastAcquire != tLastFrameUpdate)
+  {
+    pResource->m_LastAcquire = tLastFrameUpdate;
+  }
+
+  // fast path: a fully loaded resource needs neither fallbacks nor further loading, so there is nothing to check or lock
+  if (pResource->m_bIsFullyLoaded)
+  {
+    if (out_pAcquireResult)
+      *out_pAcquireResult = ezResourceAcquireResult::Final;
+
+    return pResource;
+  }
 
   if (pResource->GetLoadingState() != ezResourceState::LoadedResourceMissing)
   {
@@ -259,22 +269,7 @@ ezLockedObject<ezMutex, ezDynamicArray<ezResource*>> ezResourceManager::GetAllRe
 
   container.Clear();
 
-  for (auto itType = GetLoadedResources().GetIterator(); itType.IsValid(); itType.Next())
-  {
-    const ezRTTI* pDerivedType = itType.Key();
-
-    if (pDerivedType->IsDerivedFrom(pBaseType))
-    {
-      const LoadedResources& lr = GetLoadedResources()[pDerivedType];
-
-      container.Reserve(container.GetCount() + lr.m_Resources.GetCount());
-
-      for (auto itResource : lr.m_Resources)
-      {
-        container.PushBack(itResource.Value());
-      }
-    }
-  }
+  CollectAllResourcesOfType(pBaseType, container);
 
   return loadedResourcesLock;
 }
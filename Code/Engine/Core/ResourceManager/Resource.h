@@ -177,6 +177,14 @@ private:
   ezUInt8 m_uiQualityLevelsDiscardable = 0;
   ezUInt8 m_uiQualityLevelsLoadable = 0;
 
+  /// \brief Set once the resource is loaded and has no further quality levels to load.
+  ///
+  /// Written after the loading state and quality levels were updated, so that ezResourceManager::BeginAcquireResource() can skip all
+  /// loading logic for the common case without taking any lock.
+  ezAtomicBool m_bIsFullyLoaded;
+
+  void UpdateIsFullyLoaded();
+
 
 protected:
   /// \brief Non-const version for resources that want to write this variable directly.
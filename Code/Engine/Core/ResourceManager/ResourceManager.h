@@ -454,6 +454,19 @@ private:
     ezHashTable<ezTempHashedString, ezResource*> m_Resources;
   };
 
+  /// \brief The loaded resources are distributed over several shards, based on the resource type and ID.
+  ///
+  /// Looking up an existing resource only locks its shard, thus loading already loaded resources from many threads doesn't contend on
+  /// s_ResourceMutex. Adding or removing resources requires s_ResourceMutex AND the shard mutex, therefore code that holds
+  /// s_ResourceMutex may read all shards without locking them. The shard mutex must never be held while waiting for s_ResourceMutex.
+  static constexpr ezUInt32 NumLoadedResourcesShards = 16;
+
+  struct LoadedResourcesShard
+  {
+    ezMutex m_Mutex;
+    ezHashTable<const ezRTTI*, LoadedResources> m_LoadedResources;
+  };
+
   struct LoadingInfo
   {
     float m_fPriority = 0;
@@ -476,7 +489,12 @@ private:
 
   static void SetupWorkerTasks();
   static ezTime GetLastFrameUpdate();
-  static ezHashTable<const ezRTTI*, LoadedResources>& GetLoadedResources();
+  static ezArrayPtr<LoadedResourcesShard> GetLoadedResourcesShards();
+  static LoadedResourcesShard& GetLoadedResourcesShard(const ezRTTI* pRtti, const ezTempHashedString& sResourceID);
+  static ezResource* FindLoadedResource(const ezRTTI* pRtti, const ezTempHashedString& sResourceID);
+  static ezTypelessResourceHandle FindLoadedResourceHandle(const ezRTTI* pResourceType, ezStringView sResourceID);
+  static bool ResolveNamedResource(ezTempHashedString& inout_sResourceID, ezHashedString& out_sRedirection);
+  static void CollectAllResourcesOfType(const ezRTTI* pBaseType, ezDynamicArray<ezResource*>& out_resources);
   static ezDynamicArray<ezResource*>& GetLoadedResourceOfTypeTempContainer();
 
   EZ_ALWAYS_INLINE static bool IsQueuedForLoading(ezResource* pResource) { return pResource->m_Flags.IsSet(ezResourceFlags::IsQueuedForLoading); }
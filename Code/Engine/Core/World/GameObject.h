@@ -624,6 +624,10 @@ private:
     void UpdateGlobalBounds();
     void UpdateGlobalBoundsAndSpatialData(ezSpatialSystem& ref_spatialSystem);
 
+    /// \brief Updates the global bounds and returns whether the spatial data needs to be updated with the new bounds.
+    /// This allows to defer the actual spatial system update, e.g. to collect the changes in a multi-threaded transform update.
+    bool UpdateGlobalBoundsAndCheckSpatialData();
+
     void UpdateLastGlobalTransform(ezUInt32 uiUpdateCounter);
 
     void RecreateSpatialData(ezSpatialSystem& ref_spatialSystem);
@@ -19,6 +19,14 @@ void ezSpatialSystem::StartNewFrame()
   ++m_uiFrameCounter;
 }
 
+void ezSpatialSystem::UpdateSpatialDataBoundsBatch(ezArrayPtr<const BoundsUpdate> updates)
+{
+  for (const BoundsUpdate& update : updates)
+  {
+    UpdateSpatialDataBounds(update.m_hData, update.m_Bounds);
+  }
+}
+
 void ezSpatialSystem::FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, ezDynamicArray<ezGameObject*>& out_objects) const
 {
   out_objects.Clear();
@@ -0,0 +1,737 @@
+#include <Core/CorePCH.h>
+
+#include <Core/World/Implementation/SpatialSystemHelper.h>
+#include <Core/World/SpatialSystem_BVH.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  EZ_ALWAYS_INLINE ezSimdBBox MergeBounds(const ezSimdBBox& a, const ezSimdBBox& b)
+  {
+    return ezSimdBBox(a.m_Min.CompMin(b.m_Min), a.m_Max.CompMax(b.m_Max));
+  }
+
+  /// Half the surface area, which is all the insertion heuristic needs.
+  EZ_ALWAYS_INLINE float GetBVHNodeCost(const ezSimdBBox& box)
+  {
+    const ezSimdVec4f extents = box.GetExtents();
+    return extents.CompMul(extents.Get<ezSwizzle::YZXW>()).HorizontalSum<3>();
+  }
+
+  /// The leaf bounds enclose the box and the sphere, so that all queries can use the sphere for the final test like the grid does.
+  EZ_ALWAYS_INLINE ezSimdBBox GetLeafBounds(const ezSimdBBoxSphere& bounds)
+  {
+    const ezSimdBSphere sphere = bounds.GetSphere();
+    const ezSimdVec4f radius = sphere.m_CenterAndRadius.Get<ezSwizzle::WWWW>();
+    const ezSimdBBox sphereBox(sphere.m_CenterAndRadius - radius, sphere.m_CenterAndRadius + radius);
+
+    return MergeBounds(bounds.GetBox(), sphereBox);
+  }
+
+  // Occlusion tests are comparatively expensive, only do them for nodes that contain a reasonable amount of objects.
+  constexpr ezInt32 s_iMinHeightForOcclusionTest = 4;
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem_BVH, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezSpatialSystem_BVH::ezSpatialSystem_BVH()
+  : m_AlignedAllocator("Spatial System Aligned", ezFoundation::GetAlignedAllocator())
+  , m_DataTable(&m_Allocator)
+  , m_LastVisibleFrameIdxAndVisType(&m_Allocator)
+  , m_AlwaysVisibleData(&m_Allocator)
+  , m_Nodes(&m_AlignedAllocator)
+{
+}
+
+ezSpatialSystem_BVH::~ezSpatialSystem_BVH() = default;
+
+ezUInt32 ezSpatialSystem_BVH::GetTreeHeight() const
+{
+  if (m_uiRootNode == ezInvalidIndex)
+    return 0;
+
+  return static_cast<ezUInt32>(m_Nodes[m_uiRootNode].m_iHeight);
+}
+
+void ezSpatialSystem_BVH::GetAllNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezUInt32 uiMaxDepth /*= ezInvalidIndex*/) const
+{
+  if (m_uiRootNode == ezInvalidIndex)
+    return;
+
+  struct StackEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNodeIndex;
+    ezUInt32 m_uiDepth;
+  };
+
+  ezHybridArray<StackEntry, 64> stack;
+  stack.PushBack({m_uiRootNode, 0});
+
+  while (!stack.IsEmpty())
+  {
+    const StackEntry entry = stack.PeekBack();
+    stack.PopBack();
+
+    const Node& node = m_Nodes[entry.m_uiNodeIndex];
+    out_boundingBoxes.PushBack(ezBoundingBox::MakeFromMinMax(ezSimdConversion::ToVec3(node.m_Bounds.m_Min), ezSimdConversion::ToVec3(node.m_Bounds.m_Max)));
+
+    if (!node.IsLeaf() && entry.m_uiDepth < uiMaxDepth)
+    {
+      stack.PushBack({node.m_uiChild1, entry.m_uiDepth + 1});
+      stack.PushBack({node.m_uiChild0, entry.m_uiDepth + 1});
+    }
+  }
+}
+
+ezSpatialDataHandle ezSpatialSystem_BVH::CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  return AddSpatialData(bounds, pObject, uiCategoryBitmask, tags, false);
+}
+
+ezSpatialDataHandle ezSpatialSystem_BVH::CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  return AddSpatialData(ezSimdBBoxSphere(), pObject, uiCategoryBitmask, tags, true);
+}
+
+void ezSpatialSystem_BVH::DeleteSpatialData(const ezSpatialDataHandle& hData)
+{
+  Data oldData;
+  EZ_VERIFY(m_DataTable.Remove(hData.GetInternalID(), &oldData), "Invalid spatial data handle");
+
+  if (oldData.m_uiNodeIndex != ezInvalidIndex)
+  {
+    RemoveLeaf(oldData.m_uiNodeIndex);
+    FreeNode(oldData.m_uiNodeIndex);
+  }
+  else
+  {
+    m_AlwaysVisibleData.RemoveAndSwap(hData.GetInternalID().m_InstanceIndex);
+  }
+}
+
+void ezSpatialSystem_BVH::UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  const ezUInt32 uiLeafIndex = pData->m_uiNodeIndex;
+  if (uiLeafIndex == ezInvalidIndex)
+    return;
+
+  const ezSimdBBox leafBounds = GetLeafBounds(bounds);
+
+  Node& leaf = m_Nodes[uiLeafIndex];
+  leaf.m_Bounds = leafBounds;
+  leaf.m_LeafSphere = bounds.GetSphere();
+
+  ezUInt32 uiNodeIndex = leaf.m_uiParent;
+  if (uiNodeIndex == ezInvalidIndex)
+    return;
+
+  if (m_Nodes[uiNodeIndex].m_Bounds.Contains(leafBounds))
+  {
+    // Still inside the parent, only refit the ancestors. This stops as soon as a node doesn't change anymore.
+    while (uiNodeIndex != ezInvalidIndex)
+    {
+      Node& node = m_Nodes[uiNodeIndex];
+      const ezSimdBBox newBounds = MergeBounds(m_Nodes[node.m_uiChild0].m_Bounds, m_Nodes[node.m_uiChild1].m_Bounds);
+      if (newBounds == node.m_Bounds)
+        break;
+
+      node.m_Bounds = newBounds;
+      uiNodeIndex = node.m_uiParent;
+    }
+  }
+  else
+  {
+    RemoveLeaf(uiLeafIndex);
+    InsertLeaf(uiLeafIndex);
+  }
+}
+
+void ezSpatialSystem_BVH::UpdateSpatialDataBoundsBatch(ezArrayPtr<const BoundsUpdate> updates)
+{
+  EZ_PROFILE_SCOPE("UpdateSpatialDataBoundsBatch");
+
+  for (const BoundsUpdate& update : updates)
+  {
+    // non-virtual call, the batch is usually large
+    ezSpatialSystem_BVH::UpdateSpatialDataBounds(update.m_hData, update.m_Bounds);
+  }
+}
+
+void ezSpatialSystem_BVH::UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  pData->m_pObject = pObject;
+}
+
+void ezSpatialSystem_BVH::FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInSphere");
+
+  ezSimdBSphere simdSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+
+  FindObjectsInShape(simdSphere, queryParams, callback);
+}
+
+void ezSpatialSystem_BVH::FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInBox");
+
+  ezSimdBBox simdBox(ezSimdConversion::ToVec3(box.m_vMin), ezSimdConversion::ToVec3(box.m_vMax));
+
+  FindObjectsInShape(simdBox, queryParams, callback);
+}
+
+void ezSpatialSystem_BVH::FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState::Enum visType, ezSpatialSystem::AreOccludedFunc AreOccluded) const
+{
+  EZ_PROFILE_SCOPE("FindVisibleObjects");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  const ezInternal::FrustumPlaneData planeData = ezInternal::FrustumPlaneData::MakeFromFrustum(frustum);
+  const bool bUseOcclusionCallback = IsOccluded.IsValid();
+  const bool bUseBatchOcclusionCallback = bUseOcclusionCallback && AreOccluded.IsValid();
+  const ezUInt64 uiFrameIdxAndType = (m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
+
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
+
+  // leaves that passed the frustum test, only used with the batched occlusion callback
+  ezDynamicArray<ezSimdBBox> candidateBoxes;
+  ezDynamicArray<ezUInt32> candidateDataIndices;
+
+  TraverseTree(
+    queryParams.m_uiCategoryBitmask,
+    [&](const Node& node)
+    {
+      if (!ezInternal::BoxFrustumIntersect(node.m_Bounds, planeData))
+        return false;
+
+      if (bUseOcclusionCallback && node.m_iHeight >= s_iMinHeightForOcclusionTest && IsOccluded(node.m_Bounds))
+        return false;
+
+      return true;
+    },
+    [&](const Node& leaf)
+    {
+      ++uiNumObjectsTested;
+
+      if (!ezInternal::SphereFrustumIntersect(leaf.m_LeafSphere, planeData))
+        return ezVisitorExecution::Continue;
+
+      const ezUInt32 uiDataIndex = leaf.m_uiChild1;
+      const Data& data = m_DataTable.GetValueUnchecked(uiDataIndex);
+
+      if (ezInternal::FilterByTags(data.m_Tags, queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+        return ezVisitorExecution::Continue;
+
+      if (bUseBatchOcclusionCallback)
+      {
+        candidateBoxes.PushBack(leaf.m_Bounds);
+        candidateDataIndices.PushBack(uiDataIndex);
+        return ezVisitorExecution::Continue;
+      }
+
+      if (bUseOcclusionCallback && IsOccluded(leaf.m_Bounds))
+        return ezVisitorExecution::Continue;
+
+      m_LastVisibleFrameIdxAndVisType[uiDataIndex].Max(uiFrameIdxAndType);
+      out_Objects.PushBack(data.m_pObject);
+
+      ++uiNumObjectsPassed;
+      return ezVisitorExecution::Continue;
+    });
+
+  if (!candidateBoxes.IsEmpty())
+  {
+    ezDynamicArray<bool> occluded;
+    occluded.SetCount(candidateBoxes.GetCount());
+
+    AreOccluded(candidateBoxes, occluded);
+
+    for (ezUInt32 i = 0; i < occluded.GetCount(); ++i)
+    {
+      if (occluded[i])
+        continue;
+
+      const ezUInt32 uiDataIndex = candidateDataIndices[i];
+      m_LastVisibleFrameIdxAndVisType[uiDataIndex].Max(uiFrameIdxAndType);
+      out_Objects.PushBack(m_DataTable.GetValueUnchecked(uiDataIndex).m_pObject);
+
+      ++uiNumObjectsPassed;
+    }
+  }
+
+  ForEachAlwaysVisible(queryParams.m_uiCategoryBitmask,
+    [&](ezUInt32 uiDataIndex, const Data& data)
+    {
+      ++uiNumObjectsTested;
+
+      if (ezInternal::FilterByTags(data.m_Tags, queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+        return ezVisitorExecution::Continue;
+
+      m_LastVisibleFrameIdxAndVisType[uiDataIndex].Max(uiFrameIdxAndType);
+      out_Objects.PushBack(data.m_pObject);
+
+      ++uiNumObjectsPassed;
+      return ezVisitorExecution::Continue;
+    });
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += uiNumObjectsPassed;
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#else
+  EZ_IGNORE_UNUSED(uiNumObjectsTested);
+  EZ_IGNORE_UNUSED(uiNumObjectsPassed);
+#endif
+}
+
+ezVisibilityState::Enum ezSpatialSystem_BVH::GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  if (pData->m_uiNodeIndex == ezInvalidIndex)
+    return ezVisibilityState::Direct;
+
+  const ezUInt64 uiLastVisibleFrameIdxAndVisType = m_LastVisibleFrameIdxAndVisType[hData.GetInternalID().m_InstanceIndex];
+  const ezUInt64 uiLastVisibleFrameIdx = (uiLastVisibleFrameIdxAndVisType >> 4);
+  const ezUInt64 uiLastVisibilityType = (uiLastVisibleFrameIdxAndVisType & static_cast<ezUInt64>(15)); // mask out lower 4 bits
+
+  if (m_uiFrameCounter > uiLastVisibleFrameIdx + uiNumFramesBeforeInvisible)
+    return ezVisibilityState::Invisible;
+
+  return static_cast<ezVisibilityState::Enum>(uiLastVisibilityType);
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+void ezSpatialSystem_BVH::GetInternalStats(ezStringBuilder& sb) const
+{
+  const ezUInt32 uiNumNodes = m_Nodes.GetCount() - m_uiNumFreeNodes;
+
+  sb.SetFormat("Num Objects: {}\nNum Always Visible: {}\nNum Nodes: {}\nTree Height: {}\n", m_DataTable.GetCount(), m_AlwaysVisibleData.GetCount(), uiNumNodes, GetTreeHeight());
+
+  if (m_uiRootNode != ezInvalidIndex)
+  {
+    const ezBoundingBox rootBox = ezBoundingBox::MakeFromMinMax(ezSimdConversion::ToVec3(m_Nodes[m_uiRootNode].m_Bounds.m_Min), ezSimdConversion::ToVec3(m_Nodes[m_uiRootNode].m_Bounds.m_Max));
+    const ezVec3 vExtents = rootBox.GetExtents();
+    sb.AppendFormat("Root Extents: {} x {} x {}\n", ezArgF(vExtents.x, 1), ezArgF(vExtents.y, 1), ezArgF(vExtents.z, 1));
+  }
+}
+#endif
+
+ezSpatialDataHandle ezSpatialSystem_BVH::AddSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags, bool bAlwaysVisible)
+{
+  Data data;
+  data.m_Tags = tags;
+  data.m_pObject = pObject;
+  data.m_uiCategoryBitmask = uiCategoryBitmask;
+
+  auto hData = ezSpatialDataHandle(m_DataTable.Insert(data));
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  m_LastVisibleFrameIdxAndVisType.EnsureCount(uiDataIndex + 1);
+  m_LastVisibleFrameIdxAndVisType[uiDataIndex] = 0;
+
+  if (bAlwaysVisible)
+  {
+    m_AlwaysVisibleData.PushBack(uiDataIndex);
+    return hData;
+  }
+
+  const ezUInt32 uiLeafIndex = AllocateNode();
+
+  Node& leaf = m_Nodes[uiLeafIndex];
+  leaf.m_Bounds = GetLeafBounds(bounds);
+  leaf.m_LeafSphere = bounds.GetSphere();
+  leaf.m_uiChild1 = uiDataIndex;
+  leaf.m_uiCategoryBitmask = uiCategoryBitmask;
+  leaf.m_iHeight = 0;
+
+  m_DataTable.GetValueUnchecked(uiDataIndex).m_uiNodeIndex = uiLeafIndex;
+
+  InsertLeaf(uiLeafIndex);
+
+  return hData;
+}
+
+ezUInt32 ezSpatialSystem_BVH::AllocateNode()
+{
+  ezUInt32 uiNodeIndex = m_uiFreeNodes;
+  if (uiNodeIndex != ezInvalidIndex)
+  {
+    m_uiFreeNodes = m_Nodes[uiNodeIndex].m_uiParent;
+    --m_uiNumFreeNodes;
+  }
+  else
+  {
+    uiNodeIndex = m_Nodes.GetCount();
+    m_Nodes.ExpandAndGetRef();
+  }
+
+  Node& node = m_Nodes[uiNodeIndex];
+  node.m_uiParent = ezInvalidIndex;
+  node.m_uiChild0 = ezInvalidIndex;
+  node.m_uiChild1 = ezInvalidIndex;
+  node.m_uiCategoryBitmask = 0;
+  node.m_iHeight = 0;
+
+  return uiNodeIndex;
+}
+
+void ezSpatialSystem_BVH::FreeNode(ezUInt32 uiNodeIndex)
+{
+  Node& node = m_Nodes[uiNodeIndex];
+  node.m_uiParent = m_uiFreeNodes;
+  node.m_iHeight = -1;
+
+  m_uiFreeNodes = uiNodeIndex;
+  ++m_uiNumFreeNodes;
+}
+
+void ezSpatialSystem_BVH::InsertLeaf(ezUInt32 uiLeafIndex)
+{
+  if (m_uiRootNode == ezInvalidIndex)
+  {
+    m_uiRootNode = uiLeafIndex;
+    m_Nodes[uiLeafIndex].m_uiParent = ezInvalidIndex;
+    return;
+  }
+
+  const ezSimdBBox leafBounds = m_Nodes[uiLeafIndex].m_Bounds;
+
+  auto GetDescendCost = [&](ezUInt32 uiChildIndex)
+  {
+    const Node& child = m_Nodes[uiChildIndex];
+    const float fCost = GetBVHNodeCost(MergeBounds(leafBounds, child.m_Bounds));
+    return child.IsLeaf() ? fCost : fCost - GetBVHNodeCost(child.m_Bounds);
+  };
+
+  // Find the best sibling for the new leaf
+  ezUInt32 uiSibling = m_uiRootNode;
+  while (!m_Nodes[uiSibling].IsLeaf())
+  {
+    const Node& node = m_Nodes[uiSibling];
+
+    const float fArea = GetBVHNodeCost(node.m_Bounds);
+    const float fCombinedArea = GetBVHNodeCost(MergeBounds(node.m_Bounds, leafBounds));
+
+    // Cost of creating a new parent for this node and the new leaf
+    const float fCost = 2.0f * fCombinedArea;
+
+    // Minimum cost of pushing the leaf further down the tree
+    const float fInheritanceCost = 2.0f * (fCombinedArea - fArea);
+
+    const float fCost0 = GetDescendCost(node.m_uiChild0) + fInheritanceCost;
+    const float fCost1 = GetDescendCost(node.m_uiChild1) + fInheritanceCost;
+
+    if (fCost < fCost0 && fCost < fCost1)
+      break;
+
+    uiSibling = (fCost0 < fCost1) ? node.m_uiChild0 : node.m_uiChild1;
+  }
+
+  // Create a new parent for the sibling and the leaf
+  const ezUInt32 uiOldParent = m_Nodes[uiSibling].m_uiParent;
+  const ezUInt32 uiNewParent = AllocateNode();
+
+  {
+    Node& newParent = m_Nodes[uiNewParent];
+    newParent.m_uiParent = uiOldParent;
+    newParent.m_uiChild0 = uiSibling;
+    newParent.m_uiChild1 = uiLeafIndex;
+  }
+
+  if (uiOldParent != ezInvalidIndex)
+  {
+    Node& oldParent = m_Nodes[uiOldParent];
+    if (oldParent.m_uiChild0 == uiSibling)
+      oldParent.m_uiChild0 = uiNewParent;
+    else
+      oldParent.m_uiChild1 = uiNewParent;
+  }
+  else
+  {
+    m_uiRootNode = uiNewParent;
+  }
+
+  m_Nodes[uiSibling].m_uiParent = uiNewParent;
+  m_Nodes[uiLeafIndex].m_uiParent = uiNewParent;
+
+  RefitAncestors(uiNewParent);
+}
+
+void ezSpatialSystem_BVH::RemoveLeaf(ezUInt32 uiLeafIndex)
+{
+  if (uiLeafIndex == m_uiRootNode)
+  {
+    m_uiRootNode = ezInvalidIndex;
+    return;
+  }
+
+  const ezUInt32 uiParent = m_Nodes[uiLeafIndex].m_uiParent;
+  const ezUInt32 uiGrandParent = m_Nodes[uiParent].m_uiParent;
+  const ezUInt32 uiSibling = (m_Nodes[uiParent].m_uiChild0 == uiLeafIndex) ? m_Nodes[uiParent].m_uiChild1 : m_Nodes[uiParent].m_uiChild0;
+
+  // The parent is replaced by the sibling
+  if (uiGrandParent != ezInvalidIndex)
+  {
+    Node& grandParent = m_Nodes[uiGrandParent];
+    if (grandParent.m_uiChild0 == uiParent)
+      grandParent.m_uiChild0 = uiSibling;
+    else
+      grandParent.m_uiChild1 = uiSibling;
+
+    m_Nodes[uiSibling].m_uiParent = uiGrandParent;
+    FreeNode(uiParent);
+
+    RefitAncestors(uiGrandParent);
+  }
+  else
+  {
+    m_uiRootNode = uiSibling;
+    m_Nodes[uiSibling].m_uiParent = ezInvalidIndex;
+    FreeNode(uiParent);
+  }
+
+  m_Nodes[uiLeafIndex].m_uiParent = ezInvalidIndex;
+}
+
+void ezSpatialSystem_BVH::RefitAncestors(ezUInt32 uiNodeIndex)
+{
+  while (uiNodeIndex != ezInvalidIndex)
+  {
+    uiNodeIndex = Balance(uiNodeIndex);
+    RefitNode(uiNodeIndex);
+
+    uiNodeIndex = m_Nodes[uiNodeIndex].m_uiParent;
+  }
+}
+
+void ezSpatialSystem_BVH::RefitNode(ezUInt32 uiNodeIndex)
+{
+  Node& node = m_Nodes[uiNodeIndex];
+  const Node& child0 = m_Nodes[node.m_uiChild0];
+  const Node& child1 = m_Nodes[node.m_uiChild1];
+
+  node.m_Bounds = MergeBounds(child0.m_Bounds, child1.m_Bounds);
+  node.m_uiCategoryBitmask = child0.m_uiCategoryBitmask | child1.m_uiCategoryBitmask;
+  node.m_iHeight = 1 + ezMath::Max(child0.m_iHeight, child1.m_iHeight);
+}
+
+ezUInt32 ezSpatialSystem_BVH::Balance(ezUInt32 uiIndexA)
+{
+  // Performs a left or right rotation if node A is imbalanced and returns the new root of the sub-tree.
+  /*
+         A              C
+        / \            / \
+       B   C    =>    A   F
+          / \        / \
+         F   G      B   G
+  */
+  // The child of C with the larger height (F here) stays at C, the other one becomes a child of A.
+
+  Node& a = m_Nodes[uiIndexA];
+  if (a.IsLeaf() || a.m_iHeight < 2)
+    return uiIndexA;
+
+  const ezUInt32 uiIndexB = a.m_uiChild0;
+  const ezUInt32 uiIndexC = a.m_uiChild1;
+
+  const ezInt32 iBalance = m_Nodes[uiIndexC].m_iHeight - m_Nodes[uiIndexB].m_iHeight;
+
+  auto Rotate = [&](ezUInt32 uiIndexUp, bool bUpIsChild1)
+  {
+    Node& up = m_Nodes[uiIndexUp];
+    const ezUInt32 uiIndexF = up.m_uiChild0;
+    const ezUInt32 uiIndexG = up.m_uiChild1;
+
+    // Swap A and the node that moves up
+    up.m_uiChild0 = uiIndexA;
+    up.m_uiParent = a.m_uiParent;
+    a.m_uiParent = uiIndexUp;
+
+    if (up.m_uiParent != ezInvalidIndex)
+    {
+      Node& upParent = m_Nodes[up.m_uiParent];
+      if (upParent.m_uiChild0 == uiIndexA)
+        upParent.m_uiChild0 = uiIndexUp;
+      else
+        upParent.m_uiChild1 = uiIndexUp;
+    }
+    else
+    {
+      m_uiRootNode = uiIndexUp;
+    }
+
+    // The taller child stays at the node that moves up, the other one replaces it in A
+    const bool bKeepF = m_Nodes[uiIndexF].m_iHeight > m_Nodes[uiIndexG].m_iHeight;
+    const ezUInt32 uiIndexKeep = bKeepF ? uiIndexF : uiIndexG;
+    const ezUInt32 uiIndexMove = bKeepF ? uiIndexG : uiIndexF;
+
+    up.m_uiChild1 = uiIndexKeep;
+
+    if (bUpIsChild1)
+      a.m_uiChild1 = uiIndexMove;
+    else
+      a.m_uiChild0 = uiIndexMove;
+
+    m_Nodes[uiIndexMove].m_uiParent = uiIndexA;
+
+    RefitNode(uiIndexA);
+    RefitNode(uiIndexUp);
+  };
+
+  // Rotate C up
+  if (iBalance > 1)
+  {
+    Rotate(uiIndexC, true);
+    return uiIndexC;
+  }
+
+  // Rotate B up
+  if (iBalance < -1)
+  {
+    Rotate(uiIndexB, false);
+    return uiIndexB;
+  }
+
+  return uiIndexA;
+}
+
+template <typename NodeFunctor, typename LeafFunctor>
+EZ_FORCE_INLINE void ezSpatialSystem_BVH::TraverseTree(ezUInt32 uiCategoryBitmask, NodeFunctor nodeFunc, LeafFunctor leafFunc) const
+{
+  if (m_uiRootNode == ezInvalidIndex)
+    return;
+
+  ezHybridArray<ezUInt32, 64> stack;
+  stack.PushBack(m_uiRootNode);
+
+  while (!stack.IsEmpty())
+  {
+    const Node& node = m_Nodes[stack.PeekBack()];
+    stack.PopBack();
+
+    if ((node.m_uiCategoryBitmask & uiCategoryBitmask) == 0 || !nodeFunc(node))
+      continue;
+
+    if (node.IsLeaf())
+    {
+      if (leafFunc(node) == ezVisitorExecution::Stop)
+        return;
+    }
+    else
+    {
+      stack.PushBack(node.m_uiChild1);
+      stack.PushBack(node.m_uiChild0);
+    }
+  }
+}
+
+template <typename LeafFunctor>
+EZ_FORCE_INLINE void ezSpatialSystem_BVH::ForEachAlwaysVisible(ezUInt32 uiCategoryBitmask, LeafFunctor leafFunc) const
+{
+  for (ezUInt32 uiDataIndex : m_AlwaysVisibleData)
+  {
+    const Data& data = m_DataTable.GetValueUnchecked(uiDataIndex);
+    if ((data.m_uiCategoryBitmask & uiCategoryBitmask) == 0)
+      continue;
+
+    if (leafFunc(uiDataIndex, data) == ezVisitorExecution::Stop)
+      return;
+  }
+}
+
+template <typename Shape>
+void ezSpatialSystem_BVH::FindObjectsInShape(const Shape& shape, const QueryParams& queryParams, QueryCallback callback) const
+{
+  ezUInt32 uiNumObjectsTested = 0;
+  ezUInt32 uiNumObjectsPassed = 0;
+  bool bStopped = false;
+
+  TraverseTree(
+    queryParams.m_uiCategoryBitmask,
+    [&](const Node& node)
+    {
+      return node.m_Bounds.Overlaps(shape);
+    },
+    [&](const Node& leaf)
+    {
+      ++uiNumObjectsTested;
+
+      if (!shape.Overlaps(leaf.m_LeafSphere))
+        return ezVisitorExecution::Continue;
+
+      const Data& data = m_DataTable.GetValueUnchecked(leaf.m_uiChild1);
+      if (ezInternal::FilterByTags(data.m_Tags, queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+        return ezVisitorExecution::Continue;
+
+      ++uiNumObjectsPassed;
+
+      if (callback(data.m_pObject) == ezVisitorExecution::Stop)
+      {
+        bStopped = true;
+        return ezVisitorExecution::Stop;
+      }
+
+      return ezVisitorExecution::Continue;
+    });
+
+  if (!bStopped)
+  {
+    ForEachAlwaysVisible(queryParams.m_uiCategoryBitmask,
+      [&](ezUInt32 uiDataIndex, const Data& data)
+      {
+        EZ_IGNORE_UNUSED(uiDataIndex);
+        ++uiNumObjectsTested;
+
+        if (ezInternal::FilterByTags(data.m_Tags, queryParams.m_pIncludeTags, queryParams.m_pExcludeTags))
+          return ezVisitorExecution::Continue;
+
+        ++uiNumObjectsPassed;
+        return callback(data.m_pObject);
+      });
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += uiNumObjectsPassed;
+  }
+#else
+  EZ_IGNORE_UNUSED(uiNumObjectsTested);
+  EZ_IGNORE_UNUSED(uiNumObjectsPassed);
+#endif
+}
+
+EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_BVH);
@@ -1,5 +1,6 @@
 #include <Core/CorePCH.h>
 
+#include <Core/World/Implementation/SpatialSystemHelper.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
@@ -8,19 +9,6 @@
 
 ezCVarInt cvar_SpatialQueriesCachingThreshold("Spatial.Queries.CachingThreshold", 100, ezCVarFlags::Default, "Number of objects that are tested for a query before it is considered for caching");
 
-struct PlaneData
-{
-  ezSimdVec4f m_x0x1x2x3;
-  ezSimdVec4f m_y0y1y2y3;
-  ezSimdVec4f m_z0z1z2z3;
-  ezSimdVec4f m_w0w1w2w3;
-
-  ezSimdVec4f m_x4x5x4x5;
-  ezSimdVec4f m_y4y5y4y5;
-  ezSimdVec4f m_z4z5z4z5;
-  ezSimdVec4f m_w4w5w4w5;
-};
-
 namespace
 {
   enum
@@ -70,17 +58,6 @@ namespace
     return a.IsEmpty();
   }
 
-  EZ_ALWAYS_INLINE bool FilterByTags(const ezTagSet& tags, const ezTagSet* pIncludeTags, const ezTagSet* pExcludeTags)
-  {
-    if (pExcludeTags != nullptr && !pExcludeTags->IsEmpty() && pExcludeTags->IsAnySet(tags))
-      return true;
-
-    if (pIncludeTags != nullptr && !pIncludeTags->IsEmpty() && !pIncludeTags->IsAnySet(tags))
-      return true;
-
-    return false;
-  }
-
   EZ_ALWAYS_INLINE bool CanBeCached(ezSpatialData::Category category)
   {
     return ezSpatialData::GetCategoryFlags(category).IsSet(ezSpatialData::Flags::FrequentChanges) == false;
@@ -107,72 +84,6 @@ namespace
   }
 #endif
 
-  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const PlaneData& planeData)
-  {
-    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
-    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
-    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
-    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
-
-    ezSimdVec4f dot_0123;
-    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
-    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
-
-    ezSimdVec4f dot_4545;
-    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
-    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
-
-    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
-    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
-    return (cmp_0123 || cmp_4545).NoneSet<4>();
-  }
-
-  EZ_FORCE_INLINE ezUInt32 SphereFrustumIntersect(const ezSimdBSphere& sphereA, const ezSimdBSphere& sphereB, const PlaneData& planeData)
-  {
-    ezSimdVec4f posA_xxxx(sphereA.m_CenterAndRadius.x());
-    ezSimdVec4f posA_yyyy(sphereA.m_CenterAndRadius.y());
-    ezSimdVec4f posA_zzzz(sphereA.m_CenterAndRadius.z());
-    ezSimdVec4f posA_rrrr(sphereA.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotA_0123;
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_yyyy, planeData.m_y0y1y2y3, dotA_0123);
-    dotA_0123 = ezSimdVec4f::MulAdd(posA_zzzz, planeData.m_z0z1z2z3, dotA_0123);
-
-    ezSimdVec4f posB_xxxx(sphereB.m_CenterAndRadius.x());
-    ezSimdVec4f posB_yyyy(sphereB.m_CenterAndRadius.y());
-    ezSimdVec4f posB_zzzz(sphereB.m_CenterAndRadius.z());
-    ezSimdVec4f posB_rrrr(sphereB.m_CenterAndRadius.w());
-
-    ezSimdVec4f dotB_0123;
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_yyyy, planeData.m_y0y1y2y3, dotB_0123);
-    dotB_0123 = ezSimdVec4f::MulAdd(posB_zzzz, planeData.m_z0z1z2z3, dotB_0123);
-
-    ezSimdVec4f posAB_xxxx = posA_xxxx.GetCombined<ezSwizzle::XXXX>(posB_xxxx);
-    ezSimdVec4f posAB_yyyy = posA_yyyy.GetCombined<ezSwizzle::XXXX>(posB_yyyy);
-    ezSimdVec4f posAB_zzzz = posA_zzzz.GetCombined<ezSwizzle::XXXX>(posB_zzzz);
-    ezSimdVec4f posAB_rrrr = posA_rrrr.GetCombined<ezSwizzle::XXXX>(posB_rrrr);
-
-    ezSimdVec4f dot_A45B45;
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_yyyy, planeData.m_y4y5y4y5, dot_A45B45);
-    dot_A45B45 = ezSimdVec4f::MulAdd(posAB_zzzz, planeData.m_z4z5z4z5, dot_A45B45);
-
-    ezSimdVec4b cmp_A0123 = dotA_0123 > posA_rrrr;
-    ezSimdVec4b cmp_B0123 = dotB_0123 > posB_rrrr;
-    ezSimdVec4b cmp_A45B45 = dot_A45B45 > posAB_rrrr;
-
-    ezSimdVec4b cmp_A45 = cmp_A45B45.Get<ezSwizzle::XYXY>();
-    ezSimdVec4b cmp_B45 = cmp_A45B45.Get<ezSwizzle::ZWZW>();
-
-    ezUInt32 result = (cmp_A0123 || cmp_A45).NoneSet<4>() ? 1 : 0;
-    result |= (cmp_B0123 || cmp_B45).NoneSet<4>() ? 2 : 0;
-
-    return result;
-  }
 } // namespace
 
 //////////////////////////////////////////////////////////////////////////
@@ -369,7 +280,7 @@ struct ezSpatialSystem_RegularGrid::Grid
     auto& pOtherCell = other.m_Cells[mapping.m_uiCellIndex];
 
     const ezTagSet& tags = pOtherCell->m_TagSets[mapping.m_uiCellDataIndex];
-    if (FilterByTags(tags, &m_IncludeTags, &m_ExcludeTags))
+    if (ezInternal::FilterByTags(tags, &m_IncludeTags, &m_ExcludeTags))
       return false;
 
     ezSimdBBoxSphere bounds;
@@ -532,17 +443,39 @@ namespace ezInternal
 
     struct FrustumQueryData
     {
-      PlaneData m_PlaneData;
+      FrustumPlaneData m_PlaneData;
       ezDynamicArray<const ezGameObject*>* m_pOutObjects;
       ezUInt64 m_uiFrameCounter;
       ezSpatialSystem::IsOccludedFunc m_IsOccludedCB;
+      ezSpatialSystem::AreOccludedFunc m_AreOccludedCB;
+
+      // objects that passed the frustum test, only used with m_AreOccludedCB
+      ezDynamicArray<ezSimdBBox> m_CandidateBoxes;
+      ezDynamicArray<ezGameObject*> m_CandidateObjects;
+      ezDynamicArray<ezAtomicInteger64*> m_CandidateLastVisibleFrameIdxAndVisType;
     };
 
+    /// \brief Either defers the occlusion test of an object to the batched callback or tests it right away. Returns false if the object is occluded or deferred.
+    EZ_FORCE_INLINE static bool TestObjectOcclusion(FrustumQueryData& ref_queryData, const ezSimdBSphere& sphere, const ezSimdVec4f& vHalfExtents, ezGameObject* pObject, ezAtomicInteger64& ref_lastVisibleFrameIdxAndVisType)
+    {
+      const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(sphere.GetCenter(), vHalfExtents);
+
+      if (ref_queryData.m_AreOccludedCB.IsValid())
+      {
+        ref_queryData.m_CandidateBoxes.PushBack(bbox);
+        ref_queryData.m_CandidateObjects.PushBack(pObject);
+        ref_queryData.m_CandidateLastVisibleFrameIdxAndVisType.PushBack(&ref_lastVisibleFrameIdxAndVisType);
+        return false;
+      }
+
+      return !ref_queryData.m_IsOccludedCB(bbox);
+    }
+
     template <bool UseTagsFilter, bool UseOcclusionCallback>
     static ezVisitorExecution::Enum FrustumQueryCallback(const ezSpatialSystem_RegularGrid::Cell& cell, const ezSpatialSystem::QueryParams& queryParams, ezSpatialSystem_RegularGrid::Stats& ref_stats, void* pUserData, ezVisibilityState::Enum visType)
     {
       auto pQueryData = static_cast<FrustumQueryData*>(pUserData);
-      PlaneData planeData = pQueryData->m_PlaneData;
+      FrustumPlaneData planeData = pQueryData->m_PlaneData;
 
       ezSimdBSphere cellSphere = cell.m_Bounds.GetSphere();
       if (!SphereFrustumIntersect(cellSphere, planeData))
@@ -598,8 +531,7 @@ namespace ezInternal
 
             if constexpr (UseOcclusionCallback)
             {
-              const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-              if (pQueryData->m_IsOccludedCB(bbox))
+              if (!TestObjectOcclusion(*pQueryData, boundingSpheres[i], boundingBoxHalfExtents[i], objectPointers[i], lastVisibleFrameIdxAndVisType[i]))
               {
                 continue;
               }
@@ -632,9 +564,7 @@ namespace ezInternal
 
           if constexpr (UseOcclusionCallback)
           {
-            const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(boundingSpheres[i].GetCenter(), boundingBoxHalfExtents[i]);
-
-            if (pQueryData->m_IsOccludedCB(bbox))
+            if (!TestObjectOcclusion(*pQueryData, boundingSpheres[i], boundingBoxHalfExtents[i], objectPointers[i], lastVisibleFrameIdxAndVisType[i]))
             {
               continue;
             }
@@ -847,6 +777,17 @@ void ezSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const ezSpatialDataHan
     });
 }
 
+void ezSpatialSystem_RegularGrid::UpdateSpatialDataBoundsBatch(ezArrayPtr<const BoundsUpdate> updates)
+{
+  EZ_PROFILE_SCOPE("UpdateSpatialDataBoundsBatch");
+
+  for (const BoundsUpdate& update : updates)
+  {
+    // non-virtual call, the batch is usually large
+    ezSpatialSystem_RegularGrid::UpdateSpatialDataBounds(update.m_hData, update.m_Bounds);
+  }
+}
+
 void ezSpatialSystem_RegularGrid::UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject)
 {
   Data* pData = nullptr;
@@ -891,7 +832,7 @@ void ezSpatialSystem_RegularGrid::FindObjectsInBox(const ezBoundingBox& box, con
     &queryData, ezVisibilityState::Indirect);
 }
 
-void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState::Enum visType) const
+void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState::Enum visType, ezSpatialSystem::AreOccludedFunc AreOccluded) const
 {
   EZ_PROFILE_SCOPE("FindVisibleObjects");
 
@@ -912,33 +853,13 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, c
 
   ezInternal::QueryHelper::FrustumQueryData queryData;
   {
-    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
-    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
-    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
-    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
-    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
-    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
-    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
-
-    ezSimdMat4f helperMat;
-    helperMat.SetRows(plane0, plane1, plane2, plane3);
-
-    queryData.m_PlaneData.m_x0x1x2x3 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y0y1y2y3 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z0z1z2z3 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w0w1w2w3 = helperMat.m_col3;
-
-    helperMat.SetRows(plane4, plane5, plane4, plane5);
-
-    queryData.m_PlaneData.m_x4x5x4x5 = helperMat.m_col0;
-    queryData.m_PlaneData.m_y4y5y4y5 = helperMat.m_col1;
-    queryData.m_PlaneData.m_z4z5z4z5 = helperMat.m_col2;
-    queryData.m_PlaneData.m_w4w5w4w5 = helperMat.m_col3;
+    queryData.m_PlaneData = ezInternal::FrustumPlaneData::MakeFromFrustum(frustum);
 
     queryData.m_pOutObjects = &out_Objects;
     queryData.m_uiFrameCounter = m_uiFrameCounter;
 
     queryData.m_IsOccludedCB = IsOccluded;
+    queryData.m_AreOccludedCB = AreOccluded;
   }
 
   if (IsOccluded.IsValid())
@@ -947,6 +868,32 @@ void ezSpatialSystem_RegularGrid::FindVisibleObjects(const ezFrustum& frustum, c
       &ezInternal::QueryHelper::FrustumQueryCallback<false, true>,
       &ezInternal::QueryHelper::FrustumQueryCallback<true, true>,
       &queryData, visType);
+
+    if (!queryData.m_CandidateBoxes.IsEmpty())
+    {
+      ezDynamicArray<bool> occluded;
+      occluded.SetCount(queryData.m_CandidateBoxes.GetCount());
+
+      AreOccluded(queryData.m_CandidateBoxes, occluded);
+
+      const ezUInt64 uiFrameIdxAndType = (m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType);
+
+      for (ezUInt32 i = 0; i < occluded.GetCount(); ++i)
+      {
+        if (occluded[i])
+          continue;
+
+        queryData.m_CandidateLastVisibleFrameIdxAndVisType[i]->Max(uiFrameIdxAndType);
+        out_Objects.PushBack(queryData.m_CandidateObjects[i]);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+        if (queryParams.m_pStats != nullptr)
+        {
+          queryParams.m_pStats->m_uiNumObjectsPassed++;
+        }
+#endif
+      }
+    }
   }
   else
   {
@@ -1066,7 +1013,7 @@ ezSpatialDataHandle ezSpatialSystem_RegularGrid::AddSpatialDataToGrids(const ezS
       continue;
 
     if ((pGrid->m_Category.GetBitmask() & uiCategoryBitmask) == 0 ||
-        FilterByTags(tags, &pGrid->m_IncludeTags, &pGrid->m_ExcludeTags))
+        ezInternal::FilterByTags(tags, &pGrid->m_IncludeTags, &pGrid->m_ExcludeTags))
       continue;
 
     data.m_uiGridBitmask |= EZ_BIT(uiCachedGridIndex);
@@ -404,24 +404,7 @@ void ezWorld::PostMessage(const ezGameObjectHandle& receiverObject, const ezMess
   metaData.m_uiReceiverIsComponent = false;
   metaData.m_uiRecursive = bRecursive;
 
-  if (m_Data.m_ProcessingMessageQueue == queueType)
-  {
-    delay = ezMath::Max(delay, ezTime::MakeFromMilliseconds(1));
-  }
-
-  ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
-  if (delay.IsPositive())
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
-
-    metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
-  else
-  {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
-  }
+  PostMessage(msg, metaData, delay, queueType);
 }
 
 void ezWorld::PostMessage(const ezComponentHandle& hReceiverComponent, const ezMessage& msg, ezTime delay, ezObjectMsgQueueType::Enum queueType) const
@@ -435,26 +418,50 @@ void ezWorld::PostMessage(const ezComponentHandle& hReceiverComponent, const ezM
   metaData.m_uiReceiverIsComponent = true;
   metaData.m_uiRecursive = false;
 
+  PostMessage(msg, metaData, delay, queueType);
+}
+
+void ezWorld::PostMessage(const ezMessage& msg, QueuedMsgMetaData metaData, ezTime delay, ezObjectMsgQueueType::Enum queueType) const
+{
   if (m_Data.m_ProcessingMessageQueue == queueType)
   {
     delay = ezMath::Max(delay, ezTime::MakeFromMilliseconds(1));
   }
 
+  // Every thread appends to its own buffer, the buffers are merged when the queue gets processed.
+  // The lock is only contended while the world is moving the messages out of the buffer.
+  ezInternal::WorldData::ThreadMessageBuffer& buffer = m_Data.GetThreadMessageBuffer();
+
   ezRTTIAllocator* pMsgRTTIAllocator = msg.GetDynamicRTTI()->GetAllocator();
   if (delay.IsPositive())
   {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
+    ezInternal::WorldData::QueuedMessage entry;
+    entry.m_pMessage = pMsgRTTIAllocator->Clone<ezMessage>(&msg, &m_Data.m_Allocator);
+    entry.m_MetaData = metaData;
+    entry.m_MetaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
 
-    metaData.m_Due = m_Data.m_Clock.GetAccumulatedTime() + delay;
-    m_Data.m_TimedMessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    EZ_LOCK(buffer.m_Mutex);
+    buffer.m_uiIdleUpdates = 0;
+    buffer.m_TimedMessages[queueType].PushBack(entry);
   }
   else
   {
-    ezMessage* pMsgCopy = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
-    m_Data.m_MessageQueues[queueType].Enqueue(pMsgCopy, metaData);
+    ezInternal::WorldData::QueuedMessage entry;
+    entry.m_pMessage = pMsgRTTIAllocator->Clone<ezMessage>(&msg, m_Data.m_StackAllocator.GetCurrentAllocator());
+    entry.m_MetaData = metaData;
+
+    EZ_LOCK(buffer.m_Mutex);
+    buffer.m_uiIdleUpdates = 0;
+    buffer.m_Messages[queueType].PushBack(entry);
   }
 }
 
+ezUInt32 ezWorld::GetThreadMessageBufferCount() const
+{
+  EZ_LOCK(m_Data.m_ThreadMessageBuffersMutex);
+  return m_Data.m_ThreadMessageBuffers.GetCount();
+}
+
 void ezWorld::FindEventMsgHandlers(const ezMessage& msg, ezGameObject* pSearchObject, ezDynamicArray<ezComponent*>& out_components)
 {
   FindEventMsgHandlers(*this, msg, pSearchObject, out_components);
@@ -572,6 +579,8 @@ void ezWorld::Update()
     ProcessQueuedMessages(ezObjectMsgQueueType::AfterInitialized);
   }
 
+  m_Data.RecycleIdleThreadMessageBuffers();
+
   // Swap our double buffered stack allocator
   m_Data.m_StackAllocator.Swap();
 }
@@ -832,7 +841,7 @@ ezStringView ezWorld::GetObjectGlobalKey(const ezGameObject* pObject) const
   return {};
 }
 
-void ezWorld::ProcessQueuedMessage(const ezInternal::WorldData::MessageQueue::Entry& entry)
+void ezWorld::ProcessQueuedMessage(const ezInternal::WorldData::QueuedMessage& entry)
 {
   if (entry.m_MetaData.m_uiReceiverIsComponent)
   {
@@ -887,7 +896,7 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
 
   struct MessageComparer
   {
-    EZ_FORCE_INLINE bool Less(const ezInternal::WorldData::MessageQueue::Entry& a, const ezInternal::WorldData::MessageQueue::Entry& b) const
+    EZ_FORCE_INLINE bool Less(const ezInternal::WorldData::QueuedMessage& a, const ezInternal::WorldData::QueuedMessage& b) const
     {
       if (a.m_MetaData.m_Due != b.m_MetaData.m_Due)
         return a.m_MetaData.m_Due < b.m_MetaData.m_Due;
@@ -917,44 +926,62 @@ void ezWorld::ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType)
     }
   };
 
+  ezDynamicArray<ezInternal::WorldData::QueuedMessage>& messages = m_Data.m_ProcessingMessages;
+  EZ_ASSERT_DEV(messages.IsEmpty(), "Queued messages must not be processed recursively");
+
+  // merge the messages that were posted by all threads
+  {
+    EZ_LOCK(m_Data.m_ThreadMessageBuffersMutex);
+
+    for (auto& pBuffer : m_Data.m_ThreadMessageBuffers)
+    {
+      EZ_LOCK(pBuffer->m_Mutex);
+
+      messages.PushBackRange(pBuffer->m_Messages[queueType]);
+      pBuffer->m_Messages[queueType].Clear();
+
+      for (const auto& entry : pBuffer->m_TimedMessages[queueType])
+      {
+        m_Data.m_TimedMessages[queueType].Insert(entry);
+      }
+      pBuffer->m_TimedMessages[queueType].Clear();
+    }
+  }
+
   // regular messages
   {
-    ezInternal::WorldData::MessageQueue& queue = m_Data.m_MessageQueues[queueType];
-    queue.Sort(MessageComparer());
+    messages.Sort(MessageComparer());
 
     m_Data.m_ProcessingMessageQueue = queueType;
-    for (ezUInt32 i = 0; i < queue.GetCount(); ++i)
+    for (ezUInt32 i = 0; i < messages.GetCount(); ++i)
     {
-      ProcessQueuedMessage(queue[i]);
+      ProcessQueuedMessage(messages[i]);
 
       // no need to deallocate these messages, they are allocated through a frame allocator
     }
     m_Data.m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
 
-    queue.Clear();
+    messages.Clear();
   }
 
   // timed messages
   {
-    ezInternal::WorldData::MessageQueue& queue = m_Data.m_TimedMessageQueues[queueType];
-    queue.Sort(MessageComparer());
-
     const ezTime now = m_Data.m_Clock.GetAccumulatedTime();
 
+    // only the buckets of the elapsed time are touched, messages that are due later are not looked at
+    m_Data.m_TimedMessages[queueType].ExtractDue(now, messages);
+    messages.Sort(MessageComparer());
+
     m_Data.m_ProcessingMessageQueue = queueType;
-    while (!queue.IsEmpty())
+    for (ezUInt32 i = 0; i < messages.GetCount(); ++i)
     {
-      auto& entry = queue.Peek();
-      if (entry.m_MetaData.m_Due > now)
-        break;
-
-      ProcessQueuedMessage(entry);
+      ProcessQueuedMessage(messages[i]);
 
-      EZ_DELETE(&m_Data.m_Allocator, entry.m_pMessage);
-
-      queue.Dequeue();
+      EZ_DELETE(&m_Data.m_Allocator, messages[i].m_pMessage);
     }
     m_Data.m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
+
+    messages.Clear();
   }
 }
 
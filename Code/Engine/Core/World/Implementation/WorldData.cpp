@@ -2,6 +2,7 @@
 
 #include <Core/ResourceManager/ResourceManager.h>
 #include <Core/World/Implementation/WorldData.h>
+#include <Core/World/SpatialSystem_BVH.h>
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 
@@ -27,6 +28,8 @@ namespace ezInternal
     }
   };
 
+  static ezAtomicInteger64 s_iNextWorldInstanceID;
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
   void WorldData::UpdateTask::Execute()
@@ -51,12 +54,15 @@ namespace ezInternal
     , m_Clock(desc.m_sName)
     , m_WriteThreadID((ezThreadID)0)
     , m_bReportErrorWhenStaticObjectMoves(desc.m_bReportErrorWhenStaticObjectMoves)
+    , m_bMultiThreadedSpatialDataUpdate(desc.m_bMultiThreadedSpatialDataUpdate)
     , m_ReadMarker(*this)
     , m_WriteMarker(*this)
 
   {
     m_AllocatorWrapper.Reset();
 
+    m_uiInstanceID = static_cast<ezUInt64>(s_iNextWorldInstanceID.Increment());
+
     if (desc.m_uiRandomNumberGeneratorSeed == 0)
     {
       m_Random.InitializeFromCurrentTime();
@@ -90,7 +96,14 @@ namespace ezInternal
 
     if (m_pSpatialSystem == nullptr && desc.m_bAutoCreateSpatialSystem)
     {
-      m_pSpatialSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_RegularGrid);
+      if (desc.m_SpatialSystemType == ezSpatialSystemType::BVH)
+      {
+        m_pSpatialSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_BVH);
+      }
+      else
+      {
+        m_pSpatialSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_RegularGrid);
+      }
     }
 
     if (m_pCoordinateSystemProvider == nullptr)
@@ -169,28 +182,273 @@ namespace ezInternal
     m_UpdateTasks.Clear();
 
     // delete queued messages
-    for (ezUInt32 i = 0; i < ezObjectMsgQueueType::COUNT; ++i)
     {
+      ezDynamicArray<QueuedMessage> timedMessages;
+
+      for (ezUInt32 i = 0; i < ezObjectMsgQueueType::COUNT; ++i)
+      {
+        m_TimedMessages[i].ExtractAll(timedMessages);
+      }
+
+      EZ_LOCK(m_ThreadMessageBuffersMutex);
+      for (auto& pBuffer : m_ThreadMessageBuffers)
+      {
+        for (ezUInt32 i = 0; i < ezObjectMsgQueueType::COUNT; ++i)
+        {
+          // The regular messages are allocated through a frame allocator and thus mustn't (and don't need to be) deallocated
+          pBuffer->m_Messages[i].Clear();
+
+          timedMessages.PushBackRange(pBuffer->m_TimedMessages[i]);
+          pBuffer->m_TimedMessages[i].Clear();
+        }
+      }
+
+      for (QueuedMessage& entry : timedMessages)
       {
-        MessageQueue& queue = m_MessageQueues[i];
+        EZ_DELETE(&m_Allocator, entry.m_pMessage);
+      }
+    }
+  }
+
+  WorldData::ThreadMessageBuffer& WorldData::GetThreadMessageBuffer() const
+  {
+    struct CacheEntry
+    {
+      ezUInt64 m_uiWorldInstanceID = 0;
+      ThreadMessageBuffer* m_pBuffer = nullptr;
+    };
+
+    // every thread remembers its buffers of the last few worlds that it posted messages to
+    static constexpr ezUInt32 s_uiCacheSize = 4;
+    static thread_local CacheEntry s_Cache[s_uiCacheSize];
+    static thread_local ezUInt32 s_uiNextCacheEntry = 0;
+
+    for (const CacheEntry& entry : s_Cache)
+    {
+      if (entry.m_uiWorldInstanceID == m_uiInstanceID)
+        return *entry.m_pBuffer;
+    }
+
+    const ezThreadID threadID = ezThreadUtils::GetCurrentThreadID();
+    ThreadMessageBuffer* pBuffer = nullptr;
+
+    {
+      EZ_LOCK(m_ThreadMessageBuffersMutex);
+
+      ThreadMessageBuffer* pFreeBuffer = nullptr;
+
+      for (auto& pExistingBuffer : m_ThreadMessageBuffers)
+      {
+        if (pExistingBuffer->m_ThreadID == threadID)
+        {
+          pBuffer = pExistingBuffer.Borrow();
+          break;
+        }
+
+        if (pFreeBuffer == nullptr && pExistingBuffer->m_ThreadID == (ezThreadID)0)
+        {
+          pFreeBuffer = pExistingBuffer.Borrow();
+        }
+      }
+
+      if (pBuffer == nullptr)
+      {
+        if (pFreeBuffer != nullptr)
+        {
+          pBuffer = pFreeBuffer;
+        }
+        else
+        {
+          m_ThreadMessageBuffers.PushBack(EZ_NEW(&m_Allocator, ThreadMessageBuffer));
+          pBuffer = m_ThreadMessageBuffers.PeekBack().Borrow();
+        }
+
+        EZ_LOCK(pBuffer->m_Mutex);
+        pBuffer->m_ThreadID = threadID;
+        pBuffer->m_uiIdleUpdates = 0;
+      }
+    }
+
+    CacheEntry& entry = s_Cache[s_uiNextCacheEntry];
+    entry.m_uiWorldInstanceID = m_uiInstanceID;
+    entry.m_pBuffer = pBuffer;
+    s_uiNextCacheEntry = (s_uiNextCacheEntry + 1) % s_uiCacheSize;
+
+    return *pBuffer;
+  }
+
+  void WorldData::RecycleIdleThreadMessageBuffers()
+  {
+    EZ_LOCK(m_ThreadMessageBuffersMutex);
+
+    for (auto& pBuffer : m_ThreadMessageBuffers)
+    {
+      EZ_LOCK(pBuffer->m_Mutex);
+
+      if (pBuffer->m_ThreadID == (ezThreadID)0)
+        continue;
+
+      // the thread may have exited, we can't tell, so just stop reserving the buffer for it
+      if (++pBuffer->m_uiIdleUpdates >= MaxIdleThreadMessageBufferUpdates)
+      {
+        pBuffer->m_ThreadID = (ezThreadID)0;
+      }
+    }
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////////////////////////
+
+  ezUInt64 WorldData::TimedMessageWheel::GetTick(ezTime t)
+  {
+    const double fSeconds = t.GetSeconds();
+    return fSeconds > 0.0 ? static_cast<ezUInt64>(fSeconds * TicksPerSecond) : 0;
+  }
+
+  void WorldData::TimedMessageWheel::Insert(const QueuedMessage& msg)
+  {
+    ++m_uiCount;
+
+    // messages that are already overdue go into the current bucket
+    InsertAtTick(msg, ezMath::Max(GetTick(msg.m_MetaData.m_Due), m_uiCurrentTick));
+  }
+
+  void WorldData::TimedMessageWheel::InsertAtTick(const QueuedMessage& msg, ezUInt64 uiTick)
+  {
+    // use the lowest level, whose current revolution contains the tick
+    for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+    {
+      const ezUInt32 uiRevolutionShift = SlotBits * (uiLevel + 1);
+
+      if ((uiTick >> uiRevolutionShift) == (m_uiCurrentTick >> uiRevolutionShift))
+      {
+        m_Slots[uiLevel][(uiTick >> (SlotBits * uiLevel)) & (NumSlots - 1)].PushBack(msg);
+        return;
+      }
+    }
+
+    m_Overflow.PushBack(msg);
+  }
+
+  void WorldData::TimedMessageWheel::Cascade()
+  {
+    ezHybridArray<QueuedMessage, 16> messages;
+
+    // whenever a level starts a new revolution, the bucket of the next higher level that covers it gets distributed to the lower levels
+    for (ezUInt32 uiLevel = NumLevels; uiLevel > 0; --uiLevel)
+    {
+      const ezUInt32 uiShift = SlotBits * uiLevel;
+
+      if ((m_uiCurrentTick & ((ezUInt64(1) << uiShift) - 1)) != 0)
+        continue;
+
+      ezDynamicArray<QueuedMessage>& slot = (uiLevel == NumLevels) ? m_Overflow : m_Slots[uiLevel][(m_uiCurrentTick >> uiShift) & (NumSlots - 1)];
+
+      if (slot.IsEmpty())
+        continue;
 
-        // The messages in this queue are allocated through a frame allocator and thus mustn't (and don't need to be) deallocated
-        queue.Clear();
+      messages = slot;
+      slot.Clear();
+
+      for (const QueuedMessage& msg : messages)
+      {
+        InsertAtTick(msg, ezMath::Max(GetTick(msg.m_MetaData.m_Due), m_uiCurrentTick));
       }
+    }
+  }
+
+  void WorldData::TimedMessageWheel::ExtractDue(ezTime now, ezDynamicArray<QueuedMessage>& out_dueMessages)
+  {
+    const ezUInt64 uiNowTick = ezMath::Max(GetTick(now), m_uiCurrentTick);
+
+    if (m_uiCount == 0)
+    {
+      m_uiCurrentTick = uiNowTick;
+      return;
+    }
 
+    // after a large jump in time, it is cheaper to rebuild the wheel than to step through all the buckets
+    if (uiNowTick - m_uiCurrentTick > NumSlots * NumSlots)
+    {
+      ezDynamicArray<QueuedMessage> messages;
+      ExtractAll(messages);
+
+      m_uiCurrentTick = uiNowTick;
+
+      for (const QueuedMessage& msg : messages)
       {
-        MessageQueue& queue = m_TimedMessageQueues[i];
-        while (!queue.IsEmpty())
+        if (msg.m_MetaData.m_Due <= now)
+        {
+          out_dueMessages.PushBack(msg);
+        }
+        else
         {
-          MessageQueue::Entry& entry = queue.Peek();
-          EZ_DELETE(&m_Allocator, entry.m_pMessage);
+          Insert(msg);
+        }
+      }
+
+      return;
+    }
 
-          queue.Dequeue();
+    while (true)
+    {
+      if (m_uiCount == 0)
+      {
+        m_uiCurrentTick = uiNowTick;
+        break;
+      }
+
+      Cascade();
+
+      ezDynamicArray<QueuedMessage>& slot = m_Slots[0][m_uiCurrentTick & (NumSlots - 1)];
+
+      if (m_uiCurrentTick < uiNowTick)
+      {
+        // all messages in buckets before the current tick are due
+        out_dueMessages.PushBackRange(slot);
+        m_uiCount -= slot.GetCount();
+        slot.Clear();
+
+        ++m_uiCurrentTick;
+      }
+      else
+      {
+        // the bucket of the current tick may also contain messages that are due a little later
+        for (ezUInt32 i = 0; i < slot.GetCount();)
+        {
+          if (slot[i].m_MetaData.m_Due <= now)
+          {
+            out_dueMessages.PushBack(slot[i]);
+            slot.RemoveAtAndSwap(i);
+            --m_uiCount;
+          }
+          else
+          {
+            ++i;
+          }
         }
+
+        break;
       }
     }
   }
 
+  void WorldData::TimedMessageWheel::ExtractAll(ezDynamicArray<QueuedMessage>& out_messages)
+  {
+    for (ezUInt32 uiLevel = 0; uiLevel < NumLevels; ++uiLevel)
+    {
+      for (ezUInt32 uiSlot = 0; uiSlot < NumSlots; ++uiSlot)
+      {
+        out_messages.PushBackRange(m_Slots[uiLevel][uiSlot]);
+        m_Slots[uiLevel][uiSlot].Clear();
+      }
+    }
+
+    out_messages.PushBackRange(m_Overflow);
+    m_Overflow.Clear();
+
+    m_uiCount = 0;
+  }
+
   ezGameObject::TransformationData* WorldData::CreateTransformationData(bool bDynamic, ezUInt32 uiHierarchyLevel)
   {
     Hierarchy& hierarchy = m_Hierarchies[GetHierarchyType(bDynamic)];
@@ -361,6 +619,22 @@ namespace ezInternal
       }
     };
 
+    struct RootLevelCollectSpatialData
+    {
+      EZ_ALWAYS_INLINE static void Visit(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, SpatialDataBoundsUpdates& ref_updates)
+      {
+        WorldData::UpdateGlobalTransformAndCollectSpatialData(pData, uiUpdateCounter, ref_updates);
+      }
+    };
+
+    struct WithParentCollectSpatialData
+    {
+      EZ_ALWAYS_INLINE static void Visit(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, SpatialDataBoundsUpdates& ref_updates)
+      {
+        WorldData::UpdateGlobalTransformWithParentAndCollectSpatialData(pData, uiUpdateCounter, ref_updates);
+      }
+    };
+
     Hierarchy& hierarchy = m_Hierarchies[HierarchyType::Dynamic];
     if (!hierarchy.m_Data.IsEmpty())
     {
@@ -377,6 +651,19 @@ namespace ezInternal
           TraverseHierarchyLevelMultiThreaded<WithParent>(*dataPtr[i], &userData);
         }
       }
+      else if (m_bMultiThreadedSpatialDataUpdate)
+      {
+        // The spatial system is not thread-safe, so the bounds changes are only collected here
+        // and passed to the spatial system after all levels have been updated.
+        TraverseHierarchyLevelMultiThreadedWithSpatialData<RootLevelCollectSpatialData>(*dataPtr[0], m_uiUpdateCounter);
+
+        for (ezUInt32 i = 1; i < hierarchy.m_Data.GetCount(); ++i)
+        {
+          TraverseHierarchyLevelMultiThreadedWithSpatialData<WithParentCollectSpatialData>(*dataPtr[i], m_uiUpdateCounter);
+        }
+
+        ApplySpatialDataBoundsUpdates();
+      }
       else
       {
         TraverseHierarchyLevel<RootLevelWithSpatialData>(*dataPtr[0], &userData);
@@ -389,6 +676,20 @@ namespace ezInternal
     }
   }
 
+  void WorldData::ApplySpatialDataBoundsUpdates()
+  {
+    EZ_PROFILE_SCOPE("ApplySpatialDataBoundsUpdates");
+
+    for (SpatialDataBoundsUpdates& updates : m_SpatialDataBoundsUpdates)
+    {
+      if (!updates.IsEmpty())
+      {
+        m_pSpatialSystem->UpdateSpatialDataBoundsBatch(updates);
+        updates.Clear();
+      }
+    }
+  }
+
   void WorldData::ResourceEventHandler(const ezResourceEvent& e)
   {
     if (e.m_Type != ezResourceEvent::Type::ResourceContentUnloading || e.m_pResource->GetReferenceCount() == 0)
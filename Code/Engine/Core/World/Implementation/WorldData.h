@@ -7,6 +7,7 @@
 #include <Foundation/Threading/DelegateTask.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Types/SharedPtr.h>
+#include <Foundation/Types/UniquePtr.h>
 
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/World/GameObject.h>
@@ -46,6 +47,9 @@ namespace ezInternal
     ezEvent<const ezGameObject*> m_ObjectDeletionEvent;
 
   public:
+    /// \brief The message buffer of a thread may be recycled after this many world updates without new messages.
+    static constexpr ezUInt32 MaxIdleThreadMessageBufferUpdates = 64;
+
     class EZ_CORE_DLL ConstObjectIterator
     {
     public:
@@ -140,8 +144,23 @@ namespace ezInternal
     static void UpdateGlobalTransformAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem);
     static void UpdateGlobalTransformWithParentAndSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, ezSpatialSystem& spatialSystem);
 
+    using SpatialDataBoundsUpdates = ezDynamicArray<ezSpatialSystem::BoundsUpdate, ezAlignedAllocatorWrapper>;
+
+    static void UpdateGlobalTransformAndCollectSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, SpatialDataBoundsUpdates& ref_updates);
+    static void UpdateGlobalTransformWithParentAndCollectSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, SpatialDataBoundsUpdates& ref_updates);
+
+    /// \brief Like TraverseHierarchyLevelMultiThreaded, but every task slice gets its own buffer to collect spatial data bounds changes into.
+    template <typename VISITOR>
+    void TraverseHierarchyLevelMultiThreadedWithSpatialData(Hierarchy::DataBlockArray& blocks, ezUInt32 uiUpdateCounter);
+
     void UpdateGlobalTransforms();
 
+    /// \brief Passes all bounds changes that were collected during the multi-threaded transform update to the spatial system.
+    void ApplySpatialDataBoundsUpdates();
+
+    // One buffer per task slice of the multi-threaded transform update. They are applied in slice order so the result is deterministic.
+    ezDynamicArray<SpatialDataBoundsUpdates, ezLocalAllocatorWrapper> m_SpatialDataBoundsUpdates;
+
     void ResourceEventHandler(const ezResourceEvent& e);
 
     // game object lookups
@@ -231,9 +250,69 @@ namespace ezInternal
       ezTime m_Due;
     };
 
-    using MessageQueue = ezMessageQueue<QueuedMsgMetaData, ezLocalAllocatorWrapper>;
-    mutable MessageQueue m_MessageQueues[ezObjectMsgQueueType::COUNT];
-    mutable MessageQueue m_TimedMessageQueues[ezObjectMsgQueueType::COUNT];
+    using QueuedMessage = ezMessageQueueBase<QueuedMsgMetaData>::Entry;
+
+    /// \brief Append-only message buffers of a single thread that posted messages to this world.
+    ///
+    /// Only the owning thread appends to it, so posting doesn't contend with other threads.
+    /// The mutex is only taken by someone else, while the world moves the messages out of the buffer.
+    ///
+    /// Buffers are never deleted while the world is alive, since threads cache a pointer to their buffer.
+    /// Instead the buffer of a thread that hasn't posted messages for a while is handed to the next thread that needs one,
+    /// so threads that come and go don't add more and more buffers. Should the previous owner post again,
+    /// both threads share the buffer, which is safe since all appends are done under the mutex.
+    struct ThreadMessageBuffer
+    {
+      ezThreadID m_ThreadID = (ezThreadID)0; ///< Zero if the buffer is free to be used by another thread.
+      ezUInt32 m_uiIdleUpdates = 0;
+      ezMutex m_Mutex;
+      ezDynamicArray<QueuedMessage> m_Messages[ezObjectMsgQueueType::COUNT];
+      ezDynamicArray<QueuedMessage> m_TimedMessages[ezObjectMsgQueueType::COUNT];
+    };
+
+    /// \brief Hierarchical timing wheel that holds the timed messages of one queue type.
+    ///
+    /// Messages are put into buckets by their due time, with coarser buckets for messages further in the future.
+    /// Extracting the due messages only touches the buckets of the elapsed time, instead of all pending messages.
+    class TimedMessageWheel
+    {
+    public:
+      void Insert(const QueuedMessage& msg);
+
+      /// \brief Moves all messages that are due at or before 'now' into out_dueMessages. They are not sorted.
+      void ExtractDue(ezTime now, ezDynamicArray<QueuedMessage>& out_dueMessages);
+
+      /// \brief Moves all messages into out_messages and resets the wheel.
+      void ExtractAll(ezDynamicArray<QueuedMessage>& out_messages);
+
+      ezUInt32 GetCount() const { return m_uiCount; }
+
+    private:
+      static constexpr ezUInt32 SlotBits = 6;
+      static constexpr ezUInt32 NumSlots = 1 << SlotBits;
+      static constexpr ezUInt32 NumLevels = 4;
+      static constexpr double TicksPerSecond = 1024.0;
+
+      static ezUInt64 GetTick(ezTime t);
+      void InsertAtTick(const QueuedMessage& msg, ezUInt64 uiTick);
+      void Cascade();
+
+      ezUInt64 m_uiCurrentTick = 0; ///< All buckets before this tick have been extracted already.
+      ezUInt32 m_uiCount = 0;
+      ezDynamicArray<QueuedMessage> m_Slots[NumLevels][NumSlots];
+      ezDynamicArray<QueuedMessage> m_Overflow; ///< Messages that are too far in the future for the top level.
+    };
+
+    ThreadMessageBuffer& GetThreadMessageBuffer() const;
+
+    /// \brief Frees the buffers of threads that haven't posted messages for a while, so that other threads can reuse them.
+    void RecycleIdleThreadMessageBuffers();
+
+    ezUInt64 m_uiInstanceID = 0; ///< Unique across all worlds that were ever created, used to find the thread message buffers.
+    mutable ezMutex m_ThreadMessageBuffersMutex;
+    mutable ezDynamicArray<ezUniquePtr<ThreadMessageBuffer>> m_ThreadMessageBuffers;
+    TimedMessageWheel m_TimedMessages[ezObjectMsgQueueType::COUNT];
+    ezDynamicArray<QueuedMessage> m_ProcessingMessages;
     ezObjectMsgQueueType::Enum m_ProcessingMessageQueue = ezObjectMsgQueueType::COUNT;
 
     ezThreadID m_WriteThreadID;
@@ -243,6 +322,7 @@ namespace ezInternal
     ezUInt32 m_uiUpdateCounter = 0;
     bool m_bSimulateWorld = true;
     bool m_bReportErrorWhenStaticObjectMoves = true;
+    bool m_bMultiThreadedSpatialDataUpdate = true;
 
     /// \brief Maps some data (given as void*) to an ezGameObjectHandle. Only available in special situations (e.g. editor use cases).
     ezDelegate<ezGameObjectHandle(const void*, ezComponentHandle, ezStringView)> m_GameObjectReferenceResolver;
@@ -60,6 +60,50 @@ namespace ezInternal
     return ezVisitorExecution::Continue;
   }
 
+  template <typename VISITOR>
+  EZ_FORCE_INLINE void WorldData::TraverseHierarchyLevelMultiThreadedWithSpatialData(Hierarchy::DataBlockArray& blocks, ezUInt32 uiUpdateCounter)
+  {
+    ezParallelForParams parallelForParams;
+    parallelForParams.m_uiBinSize = 100;
+    parallelForParams.m_uiMaxTasksPerThread = 2;
+    parallelForParams.m_pTaskAllocator = m_StackAllocator.GetCurrentAllocator();
+
+    // determine the slicing up front, so that each slice can be mapped to its own buffer
+    const ezUInt32 uiNumBlocks = blocks.GetCount();
+    ezUInt32 uiNumSlices = 1;
+    ezUInt64 uiBlocksPerSlice = ezMath::Max(uiNumBlocks, 1u);
+    if (uiNumBlocks > parallelForParams.m_uiBinSize)
+    {
+      parallelForParams.DetermineThreading(uiNumBlocks, uiNumSlices, uiBlocksPerSlice);
+    }
+
+    if (m_SpatialDataBoundsUpdates.GetCount() < uiNumSlices)
+    {
+      m_SpatialDataBoundsUpdates.SetCount(uiNumSlices);
+    }
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumBlocks,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        SpatialDataBoundsUpdates& updates = m_SpatialDataBoundsUpdates[static_cast<ezUInt32>(uiStartIndex / uiBlocksPerSlice)];
+
+        for (ezUInt32 uiBlockIndex = uiStartIndex; uiBlockIndex < uiEndIndex; ++uiBlockIndex)
+        {
+          WorldData::Hierarchy::DataBlock& block = blocks[uiBlockIndex];
+          ezGameObject::TransformationData* pCurrentData = block.m_pData;
+          ezGameObject::TransformationData* pEndData = block.m_pData + block.m_uiCount;
+
+          while (pCurrentData < pEndData)
+          {
+            VISITOR::Visit(pCurrentData, uiUpdateCounter, updates);
+            ++pCurrentData;
+          }
+        }
+      },
+      "World DataBlock Traversal Task", ezTaskNesting::Never, parallelForParams);
+  }
+
   // static
   EZ_FORCE_INLINE void WorldData::UpdateGlobalTransform(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter)
   {
@@ -88,6 +132,30 @@ namespace ezInternal
     pData->UpdateGlobalBoundsAndSpatialData(spatialSystem);
   }
 
+  // static
+  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformAndCollectSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, SpatialDataBoundsUpdates& ref_updates)
+  {
+    pData->UpdateGlobalTransformWithoutParent(uiUpdateCounter);
+    if (pData->UpdateGlobalBoundsAndCheckSpatialData())
+    {
+      auto& update = ref_updates.ExpandAndGetRef();
+      update.m_Bounds = pData->m_globalBounds;
+      update.m_hData = pData->m_hSpatialData;
+    }
+  }
+
+  // static
+  EZ_FORCE_INLINE void WorldData::UpdateGlobalTransformWithParentAndCollectSpatialData(ezGameObject::TransformationData* pData, ezUInt32 uiUpdateCounter, SpatialDataBoundsUpdates& ref_updates)
+  {
+    pData->UpdateGlobalTransformWithParent(uiUpdateCounter);
+    if (pData->UpdateGlobalBoundsAndCheckSpatialData())
+    {
+      auto& update = ref_updates.ExpandAndGetRef();
+      update.m_Bounds = pData->m_globalBounds;
+      update.m_hData = pData->m_hSpatialData;
+    }
+  }
+
   ///////////////////////////////////////////////////////////////////////////////////////////////////
 
   EZ_ALWAYS_INLINE const ezGameObject& WorldData::ConstObjectIterator::operator*() const
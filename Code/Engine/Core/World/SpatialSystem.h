@@ -25,6 +25,21 @@ public:
   virtual void DeleteSpatialData(const ezSpatialDataHandle& hData) = 0;
 
   virtual void UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds) = 0;
+
+  struct BoundsUpdate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdBBoxSphere m_Bounds;
+    ezSpatialDataHandle m_hData;
+  };
+
+  /// \brief Updates the bounds of many spatial data entries at once, in the given order.
+  ///
+  /// This is used by the world to apply all bounds changes that were collected during the multi-threaded transform update.
+  /// The default implementation simply calls UpdateSpatialDataBounds() for every entry.
+  virtual void UpdateSpatialDataBoundsBatch(ezArrayPtr<const BoundsUpdate> updates);
+
   virtual void UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject) = 0;
 
   ///@}
@@ -65,7 +80,15 @@ public:
 
   using IsOccludedFunc = ezDelegate<bool(const ezSimdBBox&)>;
 
-  virtual void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, IsOccludedFunc isOccluded, ezVisibilityState::Enum visType) const = 0;
+  /// \brief Checks many boxes at once and writes true into out_occluded for every box that is fully occluded.
+  using AreOccludedFunc = ezDelegate<void(ezArrayPtr<const ezSimdBBox> boxes, ezArrayPtr<bool> out_occluded)>;
+
+  /// \brief Finds all objects inside the frustum that are not occluded.
+  ///
+  /// \param isOccluded If set, it is used to skip whole parts of the scene that are occluded.
+  /// \param areOccluded Only used together with isOccluded. If set, the bounding boxes of all objects that pass the frustum test are collected
+  ///   and checked with a single call, otherwise isOccluded is called for every object.
+  virtual void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_objects, IsOccludedFunc isOccluded, ezVisibilityState::Enum visType, AreOccludedFunc areOccluded = {}) const = 0;
 
   /// \brief Retrieves a state describing how visible the object is.
   ///
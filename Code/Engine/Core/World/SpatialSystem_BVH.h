@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/IdTable.h>
+
+/// \brief A spatial system that stores all spatial data in one dynamic bounding volume hierarchy.
+///
+/// In contrast to ezSpatialSystem_RegularGrid there are no fixed cells, so scenes that mix very large objects with many small ones
+/// are handled without overflow cells or excessive overlap.
+/// Every node stores the combined category bitmask of its sub-tree, thus one tree serves all categories and queries skip
+/// sub-trees that don't contain any of the requested categories.
+/// Bounds updates only refit the ancestors of a leaf as long as the new bounds still fit into the parent node,
+/// otherwise the leaf is removed and re-inserted. The tree is kept balanced with AVL-style rotations.
+class EZ_CORE_DLL ezSpatialSystem_BVH : public ezSpatialSystem
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezSpatialSystem_BVH, ezSpatialSystem);
+
+public:
+  ezSpatialSystem_BVH();
+  ~ezSpatialSystem_BVH();
+
+  /// \brief Returns the height of the tree, 0 if it is empty or only contains a single leaf.
+  ezUInt32 GetTreeHeight() const;
+
+  /// \brief Returns the bounding boxes of all nodes down to the given depth. Useful for debug visualizations.
+  void GetAllNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezUInt32 uiMaxDepth = ezInvalidIndex) const;
+
+private:
+  // ezSpatialSystem implementation
+  ezSpatialDataHandle CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+  ezSpatialDataHandle CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+
+  void DeleteSpatialData(const ezSpatialDataHandle& hData) override;
+
+  void UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataBoundsBatch(ezArrayPtr<const BoundsUpdate> updates) override;
+  void UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject) override;
+
+  void FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
+
+  void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState::Enum visType, ezSpatialSystem::AreOccludedFunc AreOccluded = {}) const override;
+
+  ezVisibilityState::Enum GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const override;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  virtual void GetInternalStats(ezStringBuilder& sb) const override;
+#endif
+
+  ezProxyAllocator m_AlignedAllocator;
+
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    EZ_ALWAYS_INLINE bool IsLeaf() const { return m_uiChild0 == ezInvalidIndex; }
+
+    ezSimdBBox m_Bounds;
+    ezSimdBSphere m_LeafSphere;  ///< Only used by leaves, the bounding sphere of the spatial data.
+    ezUInt32 m_uiParent;         ///< Also used as the next index in the free list.
+    ezUInt32 m_uiChild0;         ///< ezInvalidIndex for leaves.
+    ezUInt32 m_uiChild1;         ///< For leaves this is the instance index of the spatial data.
+    ezUInt32 m_uiCategoryBitmask;
+    ezInt32 m_iHeight;           ///< 0 for leaves, -1 for free nodes.
+  };
+
+  struct Data
+  {
+    ezTagSet m_Tags;
+    ezGameObject* m_pObject = nullptr;
+    ezUInt32 m_uiNodeIndex = ezInvalidIndex; ///< ezInvalidIndex for always visible data
+    ezUInt32 m_uiCategoryBitmask = 0;
+  };
+
+  ezIdTable<ezSpatialDataId, Data, ezLocalAllocatorWrapper> m_DataTable;
+  mutable ezDynamicArray<ezAtomicInteger64> m_LastVisibleFrameIdxAndVisType;
+  ezDynamicArray<ezUInt32> m_AlwaysVisibleData;
+
+  ezDynamicArray<Node> m_Nodes;
+  ezUInt32 m_uiRootNode = ezInvalidIndex;
+  ezUInt32 m_uiFreeNodes = ezInvalidIndex;
+  ezUInt32 m_uiNumFreeNodes = 0;
+
+  ezSpatialDataHandle AddSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags, bool bAlwaysVisible);
+
+  ezUInt32 AllocateNode();
+  void FreeNode(ezUInt32 uiNodeIndex);
+
+  void InsertLeaf(ezUInt32 uiLeafIndex);
+  void RemoveLeaf(ezUInt32 uiLeafIndex);
+  void RefitAncestors(ezUInt32 uiNodeIndex);
+  void RefitNode(ezUInt32 uiNodeIndex);
+  ezUInt32 Balance(ezUInt32 uiNodeIndex);
+
+  template <typename NodeFunctor, typename LeafFunctor>
+  void TraverseTree(ezUInt32 uiCategoryBitmask, NodeFunctor nodeFunc, LeafFunctor leafFunc) const;
+
+  template <typename LeafFunctor>
+  void ForEachAlwaysVisible(ezUInt32 uiCategoryBitmask, LeafFunctor leafFunc) const;
+
+  template <typename Shape>
+  void FindObjectsInShape(const Shape& shape, const QueryParams& queryParams, QueryCallback callback) const;
+};
@@ -245,6 +245,11 @@ public:
   /// \copydoc ezWorld::FindEventMsgHandlers()
   void FindEventMsgHandlers(const ezMessage& msg, const ezGameObject* pSearchObject, ezDynamicArray<const ezComponent*>& out_components) const;
 
+  /// \brief Returns how many per-thread buffers for queued messages the world has allocated. Mainly useful for debugging.
+  ///
+  /// The buffers of threads that stop posting messages are reused, so this stays close to the number of threads that post regularly.
+  ezUInt32 GetThreadMessageBufferCount() const;
+
   ///@}
 
   /// \brief If enabled, the full simulation should be executed, otherwise only the rendering related updates should be done
@@ -385,7 +390,8 @@ private:
   ezStringView GetObjectGlobalKey(const ezGameObject* pObject) const;
 
   void PostMessage(const ezGameObjectHandle& receiverObject, const ezMessage& msg, ezObjectMsgQueueType::Enum queueType, ezTime delay, bool bRecursive) const;
-  void ProcessQueuedMessage(const ezInternal::WorldData::MessageQueue::Entry& entry);
+  void PostMessage(const ezMessage& msg, ezInternal::WorldData::QueuedMsgMetaData metaData, ezTime delay, ezObjectMsgQueueType::Enum queueType) const;
+  void ProcessQueuedMessage(const ezInternal::WorldData::QueuedMessage& entry);
   void ProcessQueuedMessages(ezObjectMsgQueueType::Enum queueType);
 
   template <typename World, typename GameObject, typename Component>
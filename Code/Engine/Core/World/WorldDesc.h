@@ -9,6 +9,20 @@
 
 class ezTimeStepSmoothing;
 
+/// \brief Selects which spatial system is created automatically when ezWorldDesc::m_pSpatialSystem is not set.
+struct ezSpatialSystemType
+{
+  using StorageType = ezUInt8;
+
+  enum Enum : StorageType
+  {
+    RegularGrid, ///< ezSpatialSystem_RegularGrid, good for evenly distributed objects of similar size.
+    BVH,         ///< ezSpatialSystem_BVH, handles scenes with very different object sizes better.
+
+    Default = RegularGrid
+  };
+};
+
 /// \brief Describes the initial state of a world.
 struct ezWorldDesc
 {
@@ -21,11 +35,16 @@ struct ezWorldDesc
 
   ezUniquePtr<ezSpatialSystem> m_pSpatialSystem;
   bool m_bAutoCreateSpatialSystem = true;                ///< automatically create a default spatial system if none is set
+  ezEnum<ezSpatialSystemType> m_SpatialSystemType;       ///< which spatial system to create if m_bAutoCreateSpatialSystem is set
 
   ezSharedPtr<ezCoordinateSystemProvider> m_pCoordinateSystemProvider;
   ezUniquePtr<ezTimeStepSmoothing> m_pTimeStepSmoothing; ///< if nullptr, ezDefaultTimeStepSmoothing will be used
 
   bool m_bReportErrorWhenStaticObjectMoves = true;
 
+  /// If enabled, global transforms are also updated multi-threaded when the world has a spatial system.
+  /// The resulting bounds changes are collected per task and passed to the spatial system in one batch afterwards.
+  bool m_bMultiThreadedSpatialDataUpdate = true;
+
   ezTime m_MaxComponentInitializationTimePerFrame = ezTime::MakeFromHours(10000); // max time to spend on component initialization per frame
 };
@@ -93,6 +93,19 @@ ezUniquePtr<ezWorldReader::InstantiationContextBase> ezWorldReader::InstantiateP
   return Instantiate(ref_world, true, rootTransform, options);
 }
 
+void ezWorldReader::InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options)
+{
+  EZ_ASSERT_DEV(options.m_MaxStepTime <= ezTime::MakeZero(), "Time-sliced instantiation is not supported for batches.");
+  EZ_ASSERT_DEV(options.m_ReplaceNamedRootWithParent.IsEmpty(), "m_ReplaceNamedRootWithParent is not supported for batches.");
+  EZ_ASSERT_DEV(options.m_pProgress == nullptr, "Progress reporting is not supported for batches.");
+
+  if (rootTransforms.IsEmpty())
+    return;
+
+  InstantiationContext context = InstantiationContext(*this, &ref_world, true, ezTransform(), options);
+  context.InstantiateBatch(rootTransforms);
+}
+
 ezStreamReader& ezWorldReader::GetStream() const
 {
   ezWorldReader::InstantiationContext* pContext = ((ezWorldReader::InstantiationContext*)tl_pReaderContext);
@@ -162,8 +175,8 @@ void ezWorldReader::ClearAndCompact()
   m_ComponentTypeVersions.Clear();
   m_ComponentTypeVersions.Compact();
 
-  m_ComponentCreationStream.Clear();
-  m_ComponentCreationStream.Compact();
+  m_ComponentsToCreate.Clear();
+  m_ComponentsToCreate.Compact();
 
   m_ComponentDataStream.Clear();
   m_ComponentDataStream.Compact();
@@ -171,7 +184,7 @@ void ezWorldReader::ClearAndCompact()
 
 ezUInt64 ezWorldReader::GetHeapMemoryUsage() const
 {
-  return /*m_IndexToGameObjectHandle.GetHeapMemoryUsage() +*/ m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentCreationStream.GetHeapMemoryUsage() +
+  return /*m_IndexToGameObjectHandle.GetHeapMemoryUsage() +*/ m_RootObjectsToCreate.GetHeapMemoryUsage() + m_ChildObjectsToCreate.GetHeapMemoryUsage() + m_ComponentTypes.GetHeapMemoryUsage() + m_ComponentTypeVersions.GetHeapMemoryUsage() + m_ComponentsToCreate.GetHeapMemoryUsage() +
          m_ComponentDataStream.GetHeapMemoryUsage();
 }
 
@@ -301,8 +314,36 @@ void ezWorldReader::ReadComponentDataToMemStream(bool warningOnUnknownSkip)
   };
 
   {
-    ezMemoryStreamWriter writer(&m_ComponentCreationStream);
-    WriteToMemStream(writer, true);
+    ezDefaultMemoryStreamStorage creationStream;
+    {
+      ezMemoryStreamWriter writer(&creationStream);
+      WriteToMemStream(writer, true);
+    }
+
+    // decode the creation data right away, so that it doesn't need to be parsed again for every instantiation
+    ezMemoryStreamReader reader(&creationStream);
+    m_ComponentsToCreate.Reserve(static_cast<ezUInt32>(m_uiTotalNumComponents));
+
+    for (auto& compTypeInfo : m_ComponentTypes)
+    {
+      compTypeInfo.m_uiFirstComponentToCreate = m_ComponentsToCreate.GetCount();
+
+      if (compTypeInfo.m_pRtti == nullptr)
+        continue;
+
+      for (ezUInt32 i = 0; i < compTypeInfo.m_uiNumComponents; ++i)
+      {
+        ComponentToCreate& comp = m_ComponentsToCreate.ExpandAndGetRef();
+
+        ezUInt32 uiComponentIdx = 0;
+        reader >> comp.m_uiOwnerIndex;
+        reader >> uiComponentIdx;
+        reader >> comp.m_bActive;
+        reader >> comp.m_uiUserFlags;
+
+        EZ_ASSERT_DEBUG(uiComponentIdx == i + 1, "Component index doesn't match");
+      }
+    }
   }
 
   {
@@ -434,26 +475,14 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
     if (!CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_Options.m_pCreatedChildObjectsOut, endTime))
       return StepResult::Continue;
 
-    m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentCreationStream);
     m_Phase = Phase::CreateComponents;
     BeginNextProgressStep("CreateComponents");
   }
 
   if (m_Phase == Phase::CreateComponents)
   {
-    if (m_WorldReader.m_ComponentCreationStream.GetStorageSize64() > 0)
-    {
-      m_WorldReader.m_pStringDedupReadContext->SetActive(true);
-      tl_pReaderContext = this;
-
-      // ezStreamReader* pPrevReader = m_WorldReader.m_pStream;
-      // m_WorldReader.m_pStream = &m_CurrentReader;
-
-      EZ_SCOPE_EXIT(/*m_WorldReader.m_pStream = pPrevReader; */ m_WorldReader.m_pStringDedupReadContext->SetActive(false); tl_pReaderContext = nullptr;);
-
-      if (!CreateComponents(endTime))
-        return StepResult::Continue;
-    }
+    if (!CreateComponents(endTime))
+      return StepResult::Continue;
 
     m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
     m_Phase = Phase::DeserializeComponents;
@@ -510,6 +539,47 @@ ezWorldReader::InstantiationContext::StepResult ezWorldReader::InstantiationCont
   return StepResult::Finished;
 }
 
+void ezWorldReader::InstantiationContext::InstantiateBatch(ezArrayPtr<const ezTransform> rootTransforms)
+{
+  EZ_PROFILE_SCOPE("ezWorldReader::InstContext::InstantiateBatch");
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  // no time slicing, every phase always runs to completion
+  const ezTime endTime = ezTime::Now() + m_Options.m_MaxStepTime;
+
+  m_WorldReader.m_pStringDedupReadContext->SetActive(true);
+  tl_pReaderContext = this;
+
+  EZ_SCOPE_EXIT(m_WorldReader.m_pStringDedupReadContext->SetActive(false); tl_pReaderContext = nullptr; m_CurrentReader.SetStorage(nullptr););
+
+  for (const ezTransform& rootTransform : rootTransforms)
+  {
+    // reset the lookup tables, but keep their memory and the cached component managers for the next instance
+    m_IndexToGameObjectHandle.SetCount(1);
+    for (auto& compTypeState : m_ComponentTypeStates)
+    {
+      compTypeState.m_ComponentIndexToHandle.SetCount(1);
+    }
+
+    m_RootTransform = rootTransform;
+
+    CreateGameObjects<true>(m_WorldReader.m_RootObjectsToCreate, m_Options.m_hParent, m_Options.m_pCreatedRootObjectsOut, endTime);
+    CreateGameObjects<false>(m_WorldReader.m_ChildObjectsToCreate, ezGameObjectHandle(), m_Options.m_pCreatedChildObjectsOut, endTime);
+    CreateComponents(endTime);
+
+    if (m_WorldReader.m_ComponentDataStream.GetStorageSize64() > 0)
+    {
+      m_CurrentReader.SetStorage(&m_WorldReader.m_ComponentDataStream);
+      DeserializeComponents(endTime);
+    }
+
+    AddComponentsToBatch(endTime);
+  }
+
+  m_Phase = Phase::Invalid;
+}
+
 void ezWorldReader::InstantiationContext::Cancel()
 {
   if (!m_hComponentInitBatch.IsInvalidated())
@@ -610,8 +680,6 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
 {
   EZ_PROFILE_SCOPE("ezWorldReader::CreateComponents");
 
-  ezStreamReader& s = m_CurrentReader;
-
   for (; m_uiCurrentComponentTypeIndex < m_WorldReader.m_ComponentTypes.GetCount(); ++m_uiCurrentComponentTypeIndex)
   {
     const auto& compTypeInfo = m_WorldReader.m_ComponentTypes[m_uiCurrentComponentTypeIndex];
@@ -621,39 +689,34 @@ bool ezWorldReader::InstantiationContext::CreateComponents(ezTime endTime)
     if (compTypeInfo.m_pRtti == nullptr || compTypeInfo.m_uiNumComponents == 0)
       continue;
 
-    ezComponentManagerBase* pManager = m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
-    EZ_ASSERT_DEV(pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
-
-    while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
+    if (compTypeState.m_pManager == nullptr)
     {
-      const ezGameObjectHandle hOwner = m_WorldReader.ReadGameObjectHandle();
-
-      ezUInt32 uiComponentIdx = 0;
-      s >> uiComponentIdx;
+      compTypeState.m_pManager = m_pWorld->GetOrCreateManagerForComponentType(compTypeInfo.m_pRtti);
+      EZ_ASSERT_DEV(compTypeState.m_pManager != nullptr, "Cannot create components of type '{0}', manager is not available.", compTypeInfo.m_pRtti->GetTypeName());
+    }
 
-      bool bActive = true;
-      s >> bActive;
+    const ComponentToCreate* pComponentsToCreate = m_WorldReader.m_ComponentsToCreate.GetData() + compTypeInfo.m_uiFirstComponentToCreate;
 
-      ezUInt8 userFlags = 0;
-      s >> userFlags;
+    while (m_uiCurrentIndex < compTypeInfo.m_uiNumComponents)
+    {
+      const ComponentToCreate& compToCreate = pComponentsToCreate[m_uiCurrentIndex];
 
       ezGameObject* pOwnerObject = nullptr;
-      if (!m_pWorld->TryGetObject(hOwner, pOwnerObject))
+      if (!m_pWorld->TryGetObject(m_IndexToGameObjectHandle[compToCreate.m_uiOwnerIndex], pOwnerObject))
       {
         EZ_REPORT_FAILURE("Owner object must be not null");
       }
 
       ezComponent* pComponent = nullptr;
-      auto hComponent = pManager->CreateComponentNoInit(pOwnerObject, pComponent);
+      auto hComponent = compTypeState.m_pManager->CreateComponentNoInit(pOwnerObject, pComponent);
 
-      pComponent->SetActiveFlag(bActive);
+      pComponent->SetActiveFlag(compToCreate.m_bActive);
 
       for (ezUInt8 j = 0; j < 8; ++j)
       {
-        pComponent->SetUserFlag(j, (userFlags & EZ_BIT(j)) != 0);
+        pComponent->SetUserFlag(j, (compToCreate.m_uiUserFlags & EZ_BIT(j)) != 0);
       }
 
-      EZ_ASSERT_DEBUG(uiComponentIdx == compTypeState.m_ComponentIndexToHandle.GetCount(), "Component index doesn't match");
       compTypeState.m_ComponentIndexToHandle.PushBack(hComponent);
 
       ++m_uiCurrentIndex;
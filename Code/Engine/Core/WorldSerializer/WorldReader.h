@@ -117,6 +117,15 @@ public:
   /// has to be valid as long as the instantiation is in progress.
   ezUniquePtr<InstantiationContextBase> InstantiatePrefab(ezWorld& ref_world, const ezTransform& rootTransform, const ezPrefabInstantiationOptions& options);
 
+  /// \brief Creates one instance of the world that was previously read by ReadWorldDescription() for every transform in \a rootTransforms.
+  ///
+  /// This is equivalent to calling InstantiatePrefab() once per transform, but a lot cheaper when spawning many instances at once,
+  /// because the world is only locked once and the lookup tables and component managers are only set up once for the entire batch.
+  ///
+  /// The created objects of all instances are appended to the output arrays given in \a options, one instance after the other.
+  /// Time-sliced instantiation (m_MaxStepTime), progress reporting and m_ReplaceNamedRootWithParent are not supported here.
+  void InstantiatePrefabs(ezWorld& ref_world, ezArrayPtr<const ezTransform> rootTransforms, const ezPrefabInstantiationOptions& options);
+
   /// \brief Gives access to the stream of data. Use this inside component deserialization functions to read data.
   ezStreamReader& GetStream() const;
 
@@ -183,11 +192,20 @@ private:
     const ezRTTI* m_pRtti = nullptr;
     ezUInt32 m_uiNumComponents = 0;
     ezUInt32 m_uiComponentDataSize = 0;
+    ezUInt32 m_uiFirstComponentToCreate = 0; ///< Index into m_ComponentsToCreate
+  };
+
+  /// The component creation data is decoded once after reading, so that instantiating doesn't have to parse it again every time.
+  struct ComponentToCreate
+  {
+    ezUInt32 m_uiOwnerIndex = 0; ///< Index into the game object handle table of the instantiation context
+    bool m_bActive = true;
+    ezUInt8 m_uiUserFlags = 0;
   };
 
   ezDynamicArray<ComponentTypeInfo> m_ComponentTypes;
   ezHashTable<const ezRTTI*, ezUInt32> m_ComponentTypeVersions;
-  ezDefaultMemoryStreamStorage m_ComponentCreationStream;
+  ezDynamicArray<ComponentToCreate> m_ComponentsToCreate;
   ezDefaultMemoryStreamStorage m_ComponentDataStream;
   ezUInt64 m_uiTotalNumComponents = 0;
 
@@ -209,6 +227,8 @@ private:
     bool DeserializeComponents(ezTime endTime);
     bool AddComponentsToBatch(ezTime endTime);
 
+    void InstantiateBatch(ezArrayPtr<const ezTransform> rootTransforms);
+
     void SetMaxStepTime(ezTime stepTime);
     ezTime GetMaxStepTime() const;
 
@@ -229,6 +249,7 @@ private:
     struct ComponentTypeState
     {
       ezUInt64 m_uiDataReadOffset = 0;
+      ezComponentManagerBase* m_pManager = nullptr;
       ezDynamicArray<ezComponentHandle> m_ComponentIndexToHandle;
     };
 
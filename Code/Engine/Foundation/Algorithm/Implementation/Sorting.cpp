@@ -0,0 +1,32 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Algorithm/Sorting.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+ezUInt32 ezSorting::GetNumRadixSortTasks(ezUInt32 uiNumElements)
+{
+  // below this, scheduling the tasks costs more than sorting the range
+  constexpr ezUInt32 uiMinElementsPerTask = 16 * 1024;
+  constexpr ezUInt32 uiMaxTasks = 64;
+
+  const ezUInt32 uiNumThreads = ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) + 1;
+
+  return ezMath::Clamp(uiNumElements / uiMinElementsPerTask, 1u, ezMath::Min(uiNumThreads, uiMaxTasks));
+}
+
+void ezSorting::RunRadixSortTasks(ezUInt32 uiNumTasks, RadixSortTaskFunc taskFunc, void* pUserData)
+{
+  ezParallelForParams params;
+  params.m_uiBinSize = 1;
+  params.m_uiMaxTasksPerThread = 1;
+
+  ezTaskSystem::ParallelForIndexed(
+    0u, uiNumTasks, [=](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+    {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        taskFunc(pUserData, i);
+      }
+    },
+    "RadixSort", ezTaskNesting::Never, params);
+}
@@ -270,3 +270,171 @@ void ezSorting::InsertionSort(ezArrayPtr<T>& inout_arrayPtr, ezUInt32 uiStartInd
     }
   }
 }
+
+template <typename Container, typename KeyFunc>
+void ezSorting::RadixSort(Container& inout_container, const KeyFunc& keyFunc, bool bAllowMultiThreading)
+{
+  auto arrayPtr = inout_container.GetArrayPtr();
+  using T = typename decltype(arrayPtr)::ValueType;
+
+  if (arrayPtr.GetCount() <= RADIX_SORT_INSERTION_THRESHOLD)
+  {
+    RadixSort(arrayPtr, ezArrayPtr<T>(), keyFunc, false);
+    return;
+  }
+
+  ezAllocator* pAllocator = ezFoundation::GetDefaultAllocator();
+  T* pScratchBuffer = EZ_NEW_RAW_BUFFER(pAllocator, T, arrayPtr.GetCount());
+
+  RadixSort(arrayPtr, ezMakeArrayPtr(pScratchBuffer, arrayPtr.GetCount()), keyFunc, bAllowMultiThreading);
+
+  EZ_DELETE_RAW_BUFFER(pAllocator, pScratchBuffer);
+}
+
+template <typename T, typename KeyFunc>
+void ezSorting::RadixSort(ezArrayPtr<T> inout_arrayPtr, ezArrayPtr<T> scratchBuffer, const KeyFunc& keyFunc, bool bAllowMultiThreading)
+{
+  using KeyType = std::decay_t<decltype(keyFunc(inout_arrayPtr[0]))>;
+  static_assert(std::is_integral<KeyType>::value && std::is_unsigned<KeyType>::value, "The radix sort key has to be an unsigned integer.");
+  static_assert(ezIsPodType<T>::value, "Radix sort only supports POD types. Use EZ_DECLARE_POD_TYPE() to mark the element type as POD.");
+
+  constexpr ezUInt32 uiNumPasses = sizeof(KeyType);
+  constexpr ezUInt32 uiNumBuckets = 256;
+
+  const ezUInt32 uiCount = inout_arrayPtr.GetCount();
+
+  if (uiCount <= RADIX_SORT_INSERTION_THRESHOLD)
+  {
+    // the histogram passes aren't worth it for a handful of elements
+    InsertionSort(inout_arrayPtr, [&](const T& a, const T& b)
+      { return keyFunc(a) < keyFunc(b); });
+    return;
+  }
+
+  EZ_ASSERT_DEV(scratchBuffer.GetCount() >= uiCount, "Radix sort scratch buffer is too small, got {} elements, need {}.", scratchBuffer.GetCount(), uiCount);
+
+  T* pSrc = inout_arrayPtr.GetPtr();
+  T* pDst = scratchBuffer.GetPtr();
+
+  const ezUInt32 uiNumTasks = bAllowMultiThreading ? GetNumRadixSortTasks(uiCount) : 1;
+
+  if (uiNumTasks <= 1)
+  {
+    // the histograms of all digits are independent of the element order, so they are computed in one go
+    ezUInt32 histograms[uiNumPasses][uiNumBuckets] = {};
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const KeyType key = keyFunc(pSrc[i]);
+      for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+      {
+        ++histograms[uiPass][(key >> (uiPass * 8)) & 0xFF];
+      }
+    }
+
+    for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+    {
+      const ezUInt32 uiShift = uiPass * 8;
+      ezUInt32* pOffsets = histograms[uiPass];
+
+      // all elements have the same digit, nothing to do in this pass
+      if (pOffsets[(keyFunc(pSrc[0]) >> uiShift) & 0xFF] == uiCount)
+        continue;
+
+      ezUInt32 uiOffset = 0;
+      for (ezUInt32 uiBucket = 0; uiBucket < uiNumBuckets; ++uiBucket)
+      {
+        const ezUInt32 uiBucketCount = pOffsets[uiBucket];
+        pOffsets[uiBucket] = uiOffset;
+        uiOffset += uiBucketCount;
+      }
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        const ezUInt32 uiBucket = (keyFunc(pSrc[i]) >> uiShift) & 0xFF;
+        pDst[pOffsets[uiBucket]++] = pSrc[i];
+      }
+
+      ezMath::Swap(pSrc, pDst);
+    }
+  }
+  else
+  {
+    // every task owns a contiguous range of the elements and has its own histogram,
+    // scattering the ranges in order keeps the sort stable
+    ezAllocator* pAllocator = ezFoundation::GetDefaultAllocator();
+    ezUInt32* pTaskHistograms = EZ_NEW_RAW_BUFFER(pAllocator, ezUInt32, uiNumTasks * uiNumBuckets);
+
+    const ezUInt32 uiElementsPerTask = (uiCount + uiNumTasks - 1) / uiNumTasks;
+
+    for (ezUInt32 uiPass = 0; uiPass < uiNumPasses; ++uiPass)
+    {
+      const ezUInt32 uiShift = uiPass * 8;
+
+      RunRadixSortTasks(uiNumTasks, [&](ezUInt32 uiTask)
+        {
+          ezUInt32* pHistogram = pTaskHistograms + uiTask * uiNumBuckets;
+          ezMemoryUtils::ZeroFill(pHistogram, uiNumBuckets);
+
+          const ezUInt32 uiEnd = ezMath::Min(uiCount, (uiTask + 1) * uiElementsPerTask);
+          for (ezUInt32 i = uiTask * uiElementsPerTask; i < uiEnd; ++i)
+          {
+            ++pHistogram[(keyFunc(pSrc[i]) >> uiShift) & 0xFF];
+          }
+        });
+
+      const ezUInt32 uiFirstBucket = (keyFunc(pSrc[0]) >> uiShift) & 0xFF;
+      ezUInt32 uiFirstBucketCount = 0;
+      for (ezUInt32 uiTask = 0; uiTask < uiNumTasks; ++uiTask)
+      {
+        uiFirstBucketCount += pTaskHistograms[uiTask * uiNumBuckets + uiFirstBucket];
+      }
+
+      // all elements have the same digit, nothing to do in this pass
+      if (uiFirstBucketCount == uiCount)
+        continue;
+
+      ezUInt32 uiOffset = 0;
+      for (ezUInt32 uiBucket = 0; uiBucket < uiNumBuckets; ++uiBucket)
+      {
+        for (ezUInt32 uiTask = 0; uiTask < uiNumTasks; ++uiTask)
+        {
+          ezUInt32& uiTaskBucket = pTaskHistograms[uiTask * uiNumBuckets + uiBucket];
+          const ezUInt32 uiBucketCount = uiTaskBucket;
+          uiTaskBucket = uiOffset;
+          uiOffset += uiBucketCount;
+        }
+      }
+
+      RunRadixSortTasks(uiNumTasks, [&](ezUInt32 uiTask)
+        {
+          ezUInt32* pOffsets = pTaskHistograms + uiTask * uiNumBuckets;
+
+          const ezUInt32 uiEnd = ezMath::Min(uiCount, (uiTask + 1) * uiElementsPerTask);
+          for (ezUInt32 i = uiTask * uiElementsPerTask; i < uiEnd; ++i)
+          {
+            const ezUInt32 uiBucket = (keyFunc(pSrc[i]) >> uiShift) & 0xFF;
+            pDst[pOffsets[uiBucket]++] = pSrc[i];
+          }
+        });
+
+      ezMath::Swap(pSrc, pDst);
+    }
+
+    EZ_DELETE_RAW_BUFFER(pAllocator, pTaskHistograms);
+  }
+
+  if (pSrc != inout_arrayPtr.GetPtr())
+  {
+    ezMemoryUtils::Copy(inout_arrayPtr.GetPtr(), pSrc, uiCount);
+  }
+}
+
+template <typename Func>
+void ezSorting::RunRadixSortTasks(ezUInt32 uiNumTasks, const Func& func)
+{
+  RunRadixSortTasks(
+    uiNumTasks, [](void* pUserData, ezUInt32 uiTaskIndex)
+    { (*static_cast<const Func*>(pUserData))(uiTaskIndex); },
+    const_cast<Func*>(&func));
+}
@@ -5,6 +5,7 @@
 
 #include <Foundation/Algorithm/Comparer.h>
 #include <Foundation/Math/Math.h>
+#include <Foundation/Memory/Allocator.h>
 #include <Foundation/Types/ArrayPtr.h>
 
 /// \brief This class provides implementations of different sorting algorithms.
@@ -28,10 +29,25 @@ public:
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& inout_arrayPtr, const Comparer& comparer = Comparer()); // [tested]
 
+  /// \brief Sorts the elements in container by an integer key using a LSD radix sort (stable, needs a temporary buffer of the same size).
+  ///
+  /// \a keyFunc is called with an element and has to return its sorting key as an unsigned integer type (ezUInt8 up to ezUInt64).
+  /// Elements are sorted by ascending key. The container has to store its elements contiguously and the elements must be POD types.
+  /// If \a bAllowMultiThreading is true, large arrays are sorted on multiple threads using the ezTaskSystem.
+  template <typename Container, typename KeyFunc>
+  static void RadixSort(Container& inout_container, const KeyFunc& keyFunc, bool bAllowMultiThreading = false); // [tested]
+
+  /// \brief Sorts the elements in the array by an integer key using a LSD radix sort (stable).
+  ///
+  /// Same as above, but uses the given \a scratchBuffer as temporary storage, which must have at least as many elements as \a arrayPtr.
+  template <typename T, typename KeyFunc>
+  static void RadixSort(ezArrayPtr<T> inout_arrayPtr, ezArrayPtr<T> scratchBuffer, const KeyFunc& keyFunc, bool bAllowMultiThreading = false); // [tested]
+
 private:
   enum
   {
-    INSERTION_THRESHOLD = 16
+    INSERTION_THRESHOLD = 16,
+    RADIX_SORT_INSERTION_THRESHOLD = 64,
   };
 
   // Perform comparison either with "Less(a,b)" (prefered) or with operator ()(a,b)
@@ -73,6 +89,17 @@ private:
 
   template <typename T, typename Comparer>
   static void InsertionSort(ezArrayPtr<T>& inout_arrayPtr, ezUInt32 uiStartIndex, ezUInt32 uiEndIndex, const Comparer& comparer);
+
+  using RadixSortTaskFunc = void (*)(void* pUserData, ezUInt32 uiTaskIndex);
+
+  /// Returns into how many parts an array of the given size is split for sorting on multiple threads. Returns 1 for small arrays.
+  EZ_FOUNDATION_DLL static ezUInt32 GetNumRadixSortTasks(ezUInt32 uiNumElements);
+
+  /// Runs \a taskFunc for every task index in [0; uiNumTasks) through the ezTaskSystem and waits for all of them to finish.
+  EZ_FOUNDATION_DLL static void RunRadixSortTasks(ezUInt32 uiNumTasks, RadixSortTaskFunc taskFunc, void* pUserData);
+
+  template <typename Func>
+  static void RunRadixSortTasks(ezUInt32 uiNumTasks, const Func& func);
 };
 
 #include <Foundation/Algorithm/Implementation/Sorting_inl.h>
@@ -21,8 +21,12 @@ public:
       MapStreamsByName = EZ_BIT(0),
       ScalarizeStreams = EZ_BIT(1),
 
+      /// Large instance counts are split across the task system. All registered functions must be thread-safe when this is set.
+      /// Inside tasks that are flagged with ezTaskNesting::Never the instances are still executed serially.
+      AllowMultiThreading = EZ_BIT(2),
+
       UserFriendly = MapStreamsByName | ScalarizeStreams,
-      BestPerformance = 0,
+      BestPerformance = AllowMultiThreading,
 
       Default = UserFriendly
     };
@@ -31,9 +35,14 @@ public:
     {
       StorageType MapStreamsByName : 1;
       StorageType ScalarizeStreams : 1;
+      StorageType AllowMultiThreading : 1;
     };
   };
 
+  /// \brief Executes the byte code for uiNumInstances instances.
+  ///
+  /// The instances are processed in small blocks that go through the whole byte code at once, so that the temp registers stay in the cache.
+  /// With Flags::AllowMultiThreading the blocks are distributed across the task system, if there are enough of them.
   ezResult Execute(const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream> inputs, ezArrayPtr<ezProcessingStream> outputs, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData = ezExpression::GlobalData(), ezBitflags<Flags> flags = Flags::Default);
 
 private:
@@ -4,7 +4,68 @@
 #include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
 #include <Foundation/CodeUtils/Expression/ExpressionVM.h>
 #include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations_AVX2.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/System/SystemInformation.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+namespace
+{
+  /// All instructions are executed for one block of instances before the next block starts.
+  /// With 256 instances a temp register is 1 KB, so the registers of typical expressions stay in the L1 cache.
+  constexpr ezUInt32 s_uiInstancesPerBlock = 256;
+
+  /// Fewer blocks than this are always executed on the calling thread.
+  constexpr ezUInt32 s_uiMinBlocksPerTask = 8;
+
+  ezUInt32 GetNumRegistersPerBlock(ezUInt32 uiNumTempRegisters, ezUInt32 uiNumInstances)
+  {
+    const ezUInt32 uiNumBlockInstances = ezMath::Min(uiNumInstances, s_uiInstancesPerBlock);
+    return uiNumTempRegisters * ((uiNumBlockInstances + 7) / 8) * 2;
+  }
+
+  ezResult ExecuteBlocks(const ezExpressionByteCode& byteCode, ExecutionContext& ref_context, ezUInt32 uiFirstBlock, ezUInt32 uiEndBlock, ezUInt32 uiNumInstances, bool bUseSimd8)
+  {
+    const ezExpressionByteCode::StorageType* pByteCodeStart = byteCode.GetByteCodeStart();
+    const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
+
+    for (ezUInt32 uiBlock = uiFirstBlock; uiBlock < uiEndBlock; ++uiBlock)
+    {
+      ref_context.m_uiFirstInstance = uiBlock * s_uiInstancesPerBlock;
+      ref_context.m_uiNumInstances = ezMath::Min(uiNumInstances - ref_context.m_uiFirstInstance, s_uiInstancesPerBlock);
+      ref_context.m_uiNumSimd4Instances = ((ref_context.m_uiNumInstances + 7) / 8) * 2;
+
+      const ezExpressionByteCode::StorageType* pByteCode = pByteCodeStart;
+      while (pByteCode < pByteCodeEnd)
+      {
+        ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
+
+        OpFunc func = s_Simd4Funcs[opCode];
+#if EZ_ENABLED(EZ_EXPRESSION_VM_AVX2_SUPPORT)
+        if (bUseSimd8 && s_Simd8Funcs[opCode] != nullptr)
+        {
+          func = s_Simd8Funcs[opCode];
+        }
+#else
+        EZ_IGNORE_UNUSED(bUseSimd8);
+#endif
+
+        if (func != nullptr)
+        {
+          func(pByteCode, ref_context);
+        }
+        else
+        {
+          EZ_ASSERT_NOT_IMPLEMENTED;
+          ezLog::Error("Unknown OpCode '{}'. Execution aborted.", opCode);
+          return EZ_FAILURE;
+        }
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+} // namespace
 
 ezExpressionVM::ezExpressionVM()
 {
@@ -59,40 +120,52 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
 
   EZ_SUCCEED_OR_RETURN(MapFunctions(byteCode.GetFunctions(), globalData));
 
-  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * ((uiNumInstances + 3) / 4);
-  m_Registers.SetCountUninitialized(uiTotalNumRegisters);
-
-  // Execute bytecode
-  const ezExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCodeStart();
-  const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
-
   ExecutionContext context;
-  context.m_pRegisters = m_Registers.GetData();
-  context.m_uiNumInstances = uiNumInstances;
-  context.m_uiNumSimd4Instances = (uiNumInstances + 3) / 4;
   context.m_Inputs = m_MappedInputs;
   context.m_Outputs = m_MappedOutputs;
   context.m_Functions = m_MappedFunctions;
   context.m_pGlobalData = &globalData;
 
-  while (pByteCode < pByteCodeEnd)
+  const ezUInt32 uiNumRegistersPerBlock = GetNumRegistersPerBlock(byteCode.GetNumTempRegisters(), uiNumInstances);
+  const ezUInt32 uiNumBlocks = (uiNumInstances + s_uiInstancesPerBlock - 1) / s_uiInstancesPerBlock;
+
+#if EZ_ENABLED(EZ_EXPRESSION_VM_AVX2_SUPPORT)
+  const bool bUseSimd8 = ezSystemInformation::Get().GetCpuFeatures().IsAvx2Available();
+#else
+  const bool bUseSimd8 = false;
+#endif
+
+  // tasks that must not wait for other tasks can still use BestPerformance, they just run serially
+  if (flags.IsSet(Flags::AllowMultiThreading) && uiNumBlocks > s_uiMinBlocksPerTask && ezTaskSystem::IsCurrentThreadAllowedToWait())
   {
-    ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
+    ezAtomicInteger32 iNumFailedTasks;
 
-    OpFunc func = s_Simd4Funcs[opCode];
-    if (func != nullptr)
-    {
-      func(pByteCode, context);
-    }
-    else
-    {
-      EZ_ASSERT_NOT_IMPLEMENTED;
-      ezLog::Error("Unknown OpCode '{}'. Execution aborted.", opCode);
-      return EZ_FAILURE;
-    }
+    ezParallelForParams parallelParams;
+    parallelParams.m_uiBinSize = s_uiMinBlocksPerTask;
+
+    ezTaskSystem::ParallelForIndexed(
+      0u, uiNumBlocks, [&](ezUInt32 uiStartBlock, ezUInt32 uiEndBlock)
+      {
+        // every task needs its own registers
+        ezDynamicArray<ezExpression::Register, ezAlignedAllocatorWrapper> registers;
+        registers.SetCountUninitialized(uiNumRegistersPerBlock);
+
+        ExecutionContext taskContext = context;
+        taskContext.m_pRegisters = registers.GetData();
+
+        if (ExecuteBlocks(byteCode, taskContext, uiStartBlock, uiEndBlock, uiNumInstances, bUseSimd8).Failed())
+        {
+          iNumFailedTasks.Increment();
+        } },
+      "ExpressionVM", ezTaskNesting::Never, parallelParams);
+
+    return iNumFailedTasks == 0 ? EZ_SUCCESS : EZ_FAILURE;
   }
 
-  return EZ_SUCCESS;
+  m_Registers.SetCountUninitialized(uiNumRegistersPerBlock);
+  context.m_pRegisters = m_Registers.GetData();
+
+  return ExecuteBlocks(byteCode, context, 0, uiNumBlocks, uiNumInstances, bUseSimd8);
 }
 
 void ezExpressionVM::RegisterDefaultFunctions()
@@ -9,7 +9,10 @@ namespace
   struct ExecutionContext
   {
     ezExpression::Register* m_pRegisters = nullptr;
+    ezUInt32 m_uiFirstInstance = 0;
     ezUInt32 m_uiNumInstances = 0;
+
+    /// Number of registers per temp register. Always a multiple of two, so that 8-wide operations don't need a remainder loop.
     ezUInt32 m_uiNumSimd4Instances = 0;
     ezArrayPtr<const ezProcessingStream*> m_Inputs;
     ezArrayPtr<ezProcessingStream*> m_Outputs;
@@ -226,10 +229,10 @@ namespace
   }
 
   template <typename RegisterType, typename ValueType, typename StreamType>
-  void LoadInput(RegisterType* r, RegisterType* pRe, const ezProcessingStream& input, ezUInt32 uiNumRemainderInstances)
+  void LoadInput(RegisterType* r, RegisterType* pRe, const ezProcessingStream& input, ezUInt32 uiFirstInstance, ezUInt32 uiNumRemainderInstances)
   {
-    const ezUInt8* pInputData = input.GetData<ezUInt8>();
     const ezUInt32 uiByteStride = input.GetElementStride();
+    const ezUInt8* pInputData = input.GetData<ezUInt8>() + static_cast<size_t>(uiFirstInstance) * uiByteStride;
 
     if (uiByteStride == sizeof(ValueType) && std::is_same<ValueType, StreamType>::value)
     {
@@ -276,10 +279,10 @@ namespace
   }
 
   template <typename RegisterType, typename ValueType, typename StreamType>
-  void StoreOutput(RegisterType* r, RegisterType* pRe, ezProcessingStream& ref_output, ezUInt32 uiNumRemainderInstances)
+  void StoreOutput(RegisterType* r, RegisterType* pRe, ezProcessingStream& ref_output, ezUInt32 uiFirstInstance, ezUInt32 uiNumRemainderInstances)
   {
-    ezUInt8* pOutputData = ref_output.GetWritableData<ezUInt8>();
     const ezUInt32 uiByteStride = ref_output.GetElementStride();
+    ezUInt8* pOutputData = ref_output.GetWritableData<ezUInt8>() + static_cast<size_t>(uiFirstInstance) * uiByteStride;
 
     if (uiByteStride == sizeof(ValueType) && std::is_same<ValueType, StreamType>::value)
     {
@@ -319,26 +322,38 @@ namespace
     }
   }
 
+  /// Copies the last loaded register into the padding registers, so that operations on the padding never see uninitialized values
+  /// (e.g. an integer division by zero).
+  EZ_ALWAYS_INLINE void FillPaddingRegisters(ezExpression::Register* r, ezExpression::Register* pRe, const ExecutionContext& context)
+  {
+    const ezExpression::Register* pLast = r + (context.m_uiNumInstances + 3) / 4 - 1;
+    for (ezExpression::Register* pPadding = r + (context.m_uiNumInstances + 3) / 4; pPadding != pRe; ++pPadding)
+    {
+      *pPadding = *pLast;
+    }
+  }
+
   void VM_LoadF_4(const ByteCodeType*& pByteCode, ExecutionContext& context)
   {
     const ezUInt32 uiNumRemainderInstances = context.m_uiNumInstances & 0x3;
 
     DEFINE_TARGET_REGISTER();
-    if (uiNumRemainderInstances > 0)
-      --re;
+    ezExpression::Register* pLoadEnd = r + context.m_uiNumInstances / 4;
 
     const ezUInt32 uiInputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode);
     auto& input = *context.m_Inputs[uiInputIndex];
 
     if (input.GetDataType() == ezProcessingStream::DataType::Float)
     {
-      LoadInput<ezSimdVec4f, float, float>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4f, float, float>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(pLoadEnd), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else
     {
       EZ_ASSERT_DEBUG(input.GetDataType() == ezProcessingStream::DataType::Half, "Unsupported input type '{}' for LoadF instruction", ezProcessingStream::GetDataTypeName(input.GetDataType()));
-      LoadInput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(pLoadEnd), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
+
+    FillPaddingRegisters(r, re, context);
   }
 
   void VM_LoadI_4(const ByteCodeType*& pByteCode, ExecutionContext& context)
@@ -346,25 +361,26 @@ namespace
     const ezUInt32 uiNumRemainderInstances = context.m_uiNumInstances & 0x3;
 
     DEFINE_TARGET_REGISTER();
-    if (uiNumRemainderInstances > 0)
-      --re;
+    ezExpression::Register* pLoadEnd = r + context.m_uiNumInstances / 4;
 
     const ezUInt32 uiInputIndex = ezExpressionByteCode::GetRegisterIndex(pByteCode);
     auto& input = *context.m_Inputs[uiInputIndex];
 
     if (input.GetDataType() == ezProcessingStream::DataType::Int)
     {
-      LoadInput<ezSimdVec4i, int, int>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4i, int, int>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(pLoadEnd), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else if (input.GetDataType() == ezProcessingStream::DataType::Short)
     {
-      LoadInput<ezSimdVec4i, int, ezInt16>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4i, int, ezInt16>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(pLoadEnd), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else
     {
       EZ_ASSERT_DEBUG(input.GetDataType() == ezProcessingStream::DataType::Byte, "Unsupported input type '{}' for LoadI instruction", ezProcessingStream::GetDataTypeName(input.GetDataType()));
-      LoadInput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(pLoadEnd), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
+
+    FillPaddingRegisters(r, re, context);
   }
 
   void VM_StoreF_4(const ByteCodeType*& pByteCode, ExecutionContext& context)
@@ -376,17 +392,16 @@ namespace
 
     // actually not target register but operand register in the is case, but we need something to loop over so we use the target register macro here.
     DEFINE_TARGET_REGISTER();
-    if (uiNumRemainderInstances > 0)
-      --re;
+    ezExpression::Register* pStoreEnd = r + context.m_uiNumInstances / 4;
 
     if (output.GetDataType() == ezProcessingStream::DataType::Float)
     {
-      StoreOutput<ezSimdVec4f, float, float>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4f, float, float>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(pStoreEnd), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else
     {
       EZ_ASSERT_DEBUG(output.GetDataType() == ezProcessingStream::DataType::Half, "Unsupported input type '{}' for StoreF instruction", ezProcessingStream::GetDataTypeName(output.GetDataType()));
-      StoreOutput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(pStoreEnd), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
   }
 
@@ -399,21 +414,20 @@ namespace
 
     // actually not target register but operand register in the is case, but we need something to loop over so we use the target register macro here.
     DEFINE_TARGET_REGISTER();
-    if (uiNumRemainderInstances > 0)
-      --re;
+    ezExpression::Register* pStoreEnd = r + context.m_uiNumInstances / 4;
 
     if (output.GetDataType() == ezProcessingStream::DataType::Int)
     {
-      StoreOutput<ezSimdVec4i, int, int>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4i, int, int>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(pStoreEnd), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else if (output.GetDataType() == ezProcessingStream::DataType::Short)
     {
-      StoreOutput<ezSimdVec4i, int, ezInt16>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4i, int, ezInt16>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(pStoreEnd), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else
     {
       EZ_ASSERT_DEBUG(output.GetDataType() == ezProcessingStream::DataType::Byte, "Unsupported input type '{}' for StoreI instruction", ezProcessingStream::GetDataTypeName(output.GetDataType()));
-      StoreOutput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(pStoreEnd), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
   }
 
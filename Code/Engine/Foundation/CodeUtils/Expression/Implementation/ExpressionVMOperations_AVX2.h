@@ -0,0 +1,383 @@
+#pragma once
+
+#include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_ARCH_X86) && EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+
+#  define EZ_EXPRESSION_VM_AVX2_SUPPORT EZ_ON
+
+#  include <immintrin.h>
+
+// The engine is compiled for SSE4.1, these functions are only called when the CPU supports AVX2 (see ezExpressionVM::Execute).
+#  if EZ_ENABLED(EZ_COMPILER_MSVC_PURE)
+#    define EZ_AVX2_FUNC
+#  else
+#    define EZ_AVX2_FUNC __attribute__((target("avx2")))
+#  endif
+
+namespace
+{
+  // All values are kept in float registers, integer operations reinterpret them. Two consecutive registers form one 8-wide value.
+
+  EZ_AVX2_FUNC EZ_ALWAYS_INLINE __m256 Load8(const ezExpression::Register* p)
+  {
+    return _mm256_loadu_ps(reinterpret_cast<const float*>(p));
+  }
+
+  EZ_AVX2_FUNC EZ_ALWAYS_INLINE void Store8(ezExpression::Register* p, __m256 v)
+  {
+    _mm256_storeu_ps(reinterpret_cast<float*>(p), v);
+  }
+
+  EZ_AVX2_FUNC EZ_ALWAYS_INLINE __m256 Broadcast8(const ezExpression::Register& constant)
+  {
+    return _mm256_broadcast_ps(reinterpret_cast<const __m128*>(&constant));
+  }
+
+  EZ_AVX2_FUNC EZ_ALWAYS_INLINE __m256i I8(__m256 v)
+  {
+    return _mm256_castps_si256(v);
+  }
+
+  EZ_AVX2_FUNC EZ_ALWAYS_INLINE __m256 F8(__m256i v)
+  {
+    return _mm256_castsi256_ps(v);
+  }
+
+  EZ_AVX2_FUNC EZ_ALWAYS_INLINE __m256 AllTrue8()
+  {
+    return F8(_mm256_set1_epi32(-1));
+  }
+
+#  define DEFINE_TARGET_REGISTER_8()                                                                                                  \
+    ezExpression::Register* r = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances; \
+    ezExpression::Register* re = r + context.m_uiNumSimd4Instances;
+
+#  define DEFINE_OP_REGISTER_8(name) \
+    const ezExpression::Register* name = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances;
+
+#  define DEFINE_UNARY_OP_8(name, code)                                                               \
+    EZ_AVX2_FUNC void EZ_PP_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context) \
+    {                                                                                                 \
+      DEFINE_TARGET_REGISTER_8();                                                                     \
+      DEFINE_OP_REGISTER_8(pA);                                                                       \
+      for (; r != re; r += 2, pA += 2)                                                                \
+      {                                                                                               \
+        const __m256 a = Load8(pA);                                                                   \
+        Store8(r, code);                                                                              \
+      }                                                                                               \
+    }
+
+#  define DEFINE_BINARY_OP_8(name, code)                                                                                           \
+    template <bool RightIsConstant>                                                                                                \
+    EZ_AVX2_FUNC void EZ_PP_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context)                            \
+    {                                                                                                                              \
+      DEFINE_TARGET_REGISTER_8();                                                                                                  \
+      DEFINE_OP_REGISTER_8(pA);                                                                                                    \
+      const ezExpression::Register* pB = nullptr;                                                                                  \
+      __m256 b = _mm256_setzero_ps();                                                                                              \
+      if constexpr (RightIsConstant)                                                                                               \
+      {                                                                                                                            \
+        b = Broadcast8(ezExpressionByteCode::GetConstant(pByteCode));                                                              \
+      }                                                                                                                            \
+      else                                                                                                                         \
+      {                                                                                                                            \
+        pB = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances;              \
+      }                                                                                                                            \
+      for (; r != re; r += 2, pA += 2)                                                                                             \
+      {                                                                                                                            \
+        const __m256 a = Load8(pA);                                                                                                \
+        if constexpr (RightIsConstant == false)                                                                                    \
+        {                                                                                                                          \
+          b = Load8(pB);                                                                                                           \
+          pB += 2;                                                                                                                 \
+        }                                                                                                                          \
+        Store8(r, code);                                                                                                           \
+      }                                                                                                                            \
+    }
+
+#  define DEFINE_SHIFT_OP_8(name, code)                                                               \
+    EZ_AVX2_FUNC void EZ_PP_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context) \
+    {                                                                                                 \
+      DEFINE_TARGET_REGISTER_8();                                                                     \
+      DEFINE_OP_REGISTER_8(pA);                                                                       \
+      const __m128i b = _mm_cvtsi32_si128(static_cast<int>(*pByteCode));                              \
+      ezExpressionByteCode::GetConstant(pByteCode);                                                   \
+      for (; r != re; r += 2, pA += 2)                                                                \
+      {                                                                                               \
+        const __m256 a = Load8(pA);                                                                   \
+        Store8(r, code);                                                                              \
+      }                                                                                               \
+    }
+
+#  define DEFINE_TERNARY_OP_8(name, code)                                                             \
+    EZ_AVX2_FUNC void EZ_PP_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context) \
+    {                                                                                                 \
+      DEFINE_TARGET_REGISTER_8();                                                                     \
+      DEFINE_OP_REGISTER_8(pA);                                                                       \
+      DEFINE_OP_REGISTER_8(pB);                                                                       \
+      DEFINE_OP_REGISTER_8(pC);                                                                       \
+      for (; r != re; r += 2, pA += 2, pB += 2, pC += 2)                                              \
+      {                                                                                               \
+        const __m256 a = Load8(pA);                                                                   \
+        const __m256 b = Load8(pB);                                                                   \
+        const __m256 c = Load8(pC);                                                                   \
+        Store8(r, code);                                                                              \
+      }                                                                                               \
+    }
+
+  // Every operation has to produce exactly the same results as its 4-wide counterpart in ExpressionVMOperations.h.
+  // Operations without a cheap AVX2 equivalent (transcendentals, integer division, variable shifts, loads, stores and calls)
+  // are not part of the 8-wide table and fall back to the 4-wide implementation.
+
+  DEFINE_UNARY_OP_8(AbsF, _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a));
+  DEFINE_UNARY_OP_8(AbsI, F8(_mm256_abs_epi32(I8(a))));
+  DEFINE_UNARY_OP_8(SqrtF, _mm256_sqrt_ps(a));
+
+  DEFINE_UNARY_OP_8(RoundF, _mm256_round_ps(a, _MM_FROUND_NINT));
+  DEFINE_UNARY_OP_8(FloorF, _mm256_round_ps(a, _MM_FROUND_FLOOR));
+  DEFINE_UNARY_OP_8(CeilF, _mm256_round_ps(a, _MM_FROUND_CEIL));
+  DEFINE_UNARY_OP_8(TruncF, _mm256_round_ps(a, _MM_FROUND_TRUNC));
+
+  DEFINE_UNARY_OP_8(NotI, _mm256_xor_ps(a, AllTrue8()));
+  DEFINE_UNARY_OP_8(NotB, _mm256_xor_ps(a, AllTrue8()));
+
+  DEFINE_UNARY_OP_8(IToF, _mm256_cvtepi32_ps(I8(a)));
+  DEFINE_UNARY_OP_8(FToI, F8(_mm256_cvttps_epi32(a)));
+
+  DEFINE_BINARY_OP_8(AddF, _mm256_add_ps(a, b));
+  DEFINE_BINARY_OP_8(AddI, F8(_mm256_add_epi32(I8(a), I8(b))));
+
+  DEFINE_BINARY_OP_8(SubF, _mm256_sub_ps(a, b));
+  DEFINE_BINARY_OP_8(SubI, F8(_mm256_sub_epi32(I8(a), I8(b))));
+
+  DEFINE_BINARY_OP_8(MulF, _mm256_mul_ps(a, b));
+  DEFINE_BINARY_OP_8(MulI, F8(_mm256_mullo_epi32(I8(a), I8(b))));
+
+  DEFINE_BINARY_OP_8(DivF, _mm256_div_ps(a, b));
+
+  DEFINE_BINARY_OP_8(MinF, _mm256_min_ps(a, b));
+  DEFINE_BINARY_OP_8(MinI, F8(_mm256_min_epi32(I8(a), I8(b))));
+
+  DEFINE_BINARY_OP_8(MaxF, _mm256_max_ps(a, b));
+  DEFINE_BINARY_OP_8(MaxI, F8(_mm256_max_epi32(I8(a), I8(b))));
+
+  DEFINE_SHIFT_OP_8(ShlI_C, F8(_mm256_sll_epi32(I8(a), b)));
+  DEFINE_SHIFT_OP_8(ShrI_C, F8(_mm256_sra_epi32(I8(a), b)));
+  DEFINE_BINARY_OP_8(AndI, _mm256_and_ps(a, b));
+  DEFINE_BINARY_OP_8(XorI, _mm256_xor_ps(a, b));
+  DEFINE_BINARY_OP_8(OrI, _mm256_or_ps(a, b));
+
+  DEFINE_BINARY_OP_8(EqF, _mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+  DEFINE_BINARY_OP_8(EqI, F8(_mm256_cmpeq_epi32(I8(a), I8(b))));
+  DEFINE_BINARY_OP_8(EqB, _mm256_xor_ps(_mm256_xor_ps(a, b), AllTrue8()));
+
+  DEFINE_BINARY_OP_8(NEqF, _mm256_cmp_ps(a, b, _CMP_NEQ_UQ));
+  DEFINE_BINARY_OP_8(NEqI, _mm256_xor_ps(F8(_mm256_cmpeq_epi32(I8(a), I8(b))), AllTrue8()));
+  DEFINE_BINARY_OP_8(NEqB, _mm256_xor_ps(a, b));
+
+  DEFINE_BINARY_OP_8(LtF, _mm256_cmp_ps(a, b, _CMP_LT_OS));
+  DEFINE_BINARY_OP_8(LtI, F8(_mm256_cmpgt_epi32(I8(b), I8(a))));
+
+  DEFINE_BINARY_OP_8(LEqF, _mm256_cmp_ps(a, b, _CMP_LE_OS));
+  DEFINE_BINARY_OP_8(LEqI, _mm256_xor_ps(F8(_mm256_cmpgt_epi32(I8(a), I8(b))), AllTrue8()));
+
+  DEFINE_BINARY_OP_8(GtF, _mm256_cmp_ps(a, b, _CMP_GT_OS));
+  DEFINE_BINARY_OP_8(GtI, F8(_mm256_cmpgt_epi32(I8(a), I8(b))));
+
+  DEFINE_BINARY_OP_8(GEqF, _mm256_cmp_ps(a, b, _CMP_GE_OS));
+  DEFINE_BINARY_OP_8(GEqI, _mm256_xor_ps(F8(_mm256_cmpgt_epi32(I8(b), I8(a))), AllTrue8()));
+
+  DEFINE_BINARY_OP_8(AndB, _mm256_and_ps(a, b));
+  DEFINE_BINARY_OP_8(OrB, _mm256_or_ps(a, b));
+
+  DEFINE_TERNARY_OP_8(SelF, _mm256_blendv_ps(c, b, a));
+  DEFINE_TERNARY_OP_8(SelI, _mm256_blendv_ps(c, b, a));
+  DEFINE_TERNARY_OP_8(SelB, _mm256_blendv_ps(c, b, a));
+
+  DEFINE_UNARY_OP_8(VM_MovX_R, a);
+
+  EZ_AVX2_FUNC void VM_MovX_C_8(const ByteCodeType*& pByteCode, ExecutionContext& context)
+  {
+    DEFINE_TARGET_REGISTER_8();
+    const __m256 a = Broadcast8(ezExpressionByteCode::GetConstant(pByteCode));
+    for (; r != re; r += 2)
+    {
+      Store8(r, a);
+    }
+  }
+
+  static constexpr OpFunc s_Simd8Funcs[] = {
+    nullptr,         // Nop,
+
+    nullptr,         // FirstUnary,
+
+    &AbsF_8,         // AbsF_R,
+    &AbsI_8,         // AbsI_R,
+    &SqrtF_8,        // SqrtF_R,
+
+    nullptr,         // ExpF_R,
+    nullptr,         // LnF_R,
+    nullptr,         // Log2F_R,
+    nullptr,         // Log2I_R,
+    nullptr,         // Log10F_R,
+    nullptr,         // Pow2F_R,
+
+    nullptr,         // SinF_R,
+    nullptr,         // CosF_R,
+    nullptr,         // TanF_R,
+
+    nullptr,         // ASinF_R,
+    nullptr,         // ACosF_R,
+    nullptr,         // ATanF_R,
+
+    &RoundF_8,       // RoundF_R,
+    &FloorF_8,       // FloorF_R,
+    &CeilF_8,        // CeilF_R,
+    &TruncF_8,       // TruncF_R,
+
+    &NotI_8,         // NotI_R,
+    &NotB_8,         // NotB_R,
+
+    &IToF_8,         // IToF_R,
+    &FToI_8,         // FToI_R,
+
+    nullptr,         // LastUnary,
+    nullptr,         // FirstBinary,
+
+    &AddF_8<false>,  // AddF_RR,
+    &AddI_8<false>,  // AddI_RR,
+
+    &SubF_8<false>,  // SubF_RR,
+    &SubI_8<false>,  // SubI_RR,
+
+    &MulF_8<false>,  // MulF_RR,
+    &MulI_8<false>,  // MulI_RR,
+
+    &DivF_8<false>,  // DivF_RR,
+    nullptr,         // DivI_RR,
+
+    &MinF_8<false>,  // MinF_RR,
+    &MinI_8<false>,  // MinI_RR,
+
+    &MaxF_8<false>,  // MaxF_RR,
+    &MaxI_8<false>,  // MaxI_RR,
+
+    nullptr,         // ShlI_RR,
+    nullptr,         // ShrI_RR,
+    &AndI_8<false>,  // AndI_RR,
+    &XorI_8<false>,  // XorI_RR,
+    &OrI_8<false>,   // OrI_RR,
+
+    &EqF_8<false>,   // EqF_RR,
+    &EqI_8<false>,   // EqI_RR,
+    &EqB_8<false>,   // EqB_RR,
+
+    &NEqF_8<false>,  // NEqF_RR,
+    &NEqI_8<false>,  // NEqI_RR,
+    &NEqB_8<false>,  // NEqB_RR,
+
+    &LtF_8<false>,   // LtF_RR,
+    &LtI_8<false>,   // LtI_RR,
+
+    &LEqF_8<false>,  // LEqF_RR,
+    &LEqI_8<false>,  // LEqI_RR,
+
+    &GtF_8<false>,   // GtF_RR,
+    &GtI_8<false>,   // GtI_RR,
+
+    &GEqF_8<false>,  // GEqF_RR,
+    &GEqI_8<false>,  // GEqI_RR,
+
+    &AndB_8<false>,  // AndB_RR,
+    &OrB_8<false>,   // OrB_RR,
+
+    nullptr,         // LastBinary,
+    nullptr,         // FirstBinaryWithConstant,
+
+    &AddF_8<true>,   // AddF_RC,
+    &AddI_8<true>,   // AddI_RC,
+
+    &SubF_8<true>,   // SubF_RC,
+    &SubI_8<true>,   // SubI_RC,
+
+    &MulF_8<true>,   // MulF_RC,
+    &MulI_8<true>,   // MulI_RC,
+
+    &DivF_8<true>,   // DivF_RC,
+    nullptr,         // DivI_RC,
+
+    &MinF_8<true>,   // MinF_RC,
+    &MinI_8<true>,   // MinI_RC,
+
+    &MaxF_8<true>,   // MaxF_RC,
+    &MaxI_8<true>,   // MaxI_RC,
+
+    &ShlI_C_8,       // ShlI_RC,
+    &ShrI_C_8,       // ShrI_RC,
+    &AndI_8<true>,   // AndI_RC,
+    &XorI_8<true>,   // XorI_RC,
+    &OrI_8<true>,    // OrI_RC,
+
+    &EqF_8<true>,    // EqF_RC,
+    &EqI_8<true>,    // EqI_RC,
+    &EqB_8<true>,    // EqB_RC
+
+    &NEqF_8<true>,   // NEqF_RC,
+    &NEqI_8<true>,   // NEqI_RC,
+    &NEqB_8<true>,   // NEqB_RC
+
+    &LtF_8<true>,    // LtF_RC,
+    &LtI_8<true>,    // LtI_RC
+
+    &LEqF_8<true>,   // LEqF_RC,
+    &LEqI_8<true>,   // LEqI_RC
+
+    &GtF_8<true>,    // GtF_RC,
+    &GtI_8<true>,    // GtI_RC
+
+    &GEqF_8<true>,   // GEqF_RC,
+    &GEqI_8<true>,   // GEqI_RC
+
+    &AndB_8<true>,   // AndB_RC,
+    &OrB_8<true>,    // OrB_RC,
+
+    nullptr,         // LastBinaryWithConstant,
+    nullptr,         // FirstTernary,
+
+    &SelF_8,         // SelF_RRR,
+    &SelI_8,         // SelI_RRR,
+    &SelB_8,         // SelB_RRR,
+
+    nullptr,         // LastTernary,
+    nullptr,         // FirstSpecial,
+
+    &VM_MovX_R_8,    // MovX_R,
+    &VM_MovX_C_8,    // MovX_C,
+    nullptr,         // LoadF,
+    nullptr,         // LoadI,
+    nullptr,         // StoreF,
+    nullptr,         // StoreI,
+
+    nullptr,         // Call,
+
+    nullptr,         // LastSpecial,
+  };
+
+  static_assert(EZ_ARRAY_SIZE(s_Simd8Funcs) == ezExpressionByteCode::OpCode::Count);
+
+} // namespace
+
+#  undef EZ_AVX2_FUNC
+#  undef DEFINE_TARGET_REGISTER_8
+#  undef DEFINE_OP_REGISTER_8
+#  undef DEFINE_UNARY_OP_8
+#  undef DEFINE_BINARY_OP_8
+#  undef DEFINE_SHIFT_OP_8
+#  undef DEFINE_TERNARY_OP_8
+
+#else
+
+#  define EZ_EXPRESSION_VM_AVX2_SUPPORT EZ_OFF
+
+#endif
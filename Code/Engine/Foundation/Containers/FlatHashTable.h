@@ -0,0 +1,334 @@
+#pragma once
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/Math/Math.h>
+#include <Foundation/Memory/AllocatorWrapper.h>
+
+template <typename KeyType, typename ValueType, typename Hasher>
+class ezFlatHashTableBase;
+
+/// \brief Const iterator.
+template <typename KeyType, typename ValueType, typename Hasher>
+struct ezFlatHashTableBaseConstIterator
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezFlatHashTableBaseConstIterator() = default;
+
+  /// \brief Checks whether this iterator points to a valid element.
+  bool IsValid() const; // [tested]
+
+  /// \brief Checks whether the two iterators point to the same element.
+  bool operator==(const ezFlatHashTableBaseConstIterator& rhs) const;
+  EZ_ADD_DEFAULT_OPERATOR_NOTEQUAL(const ezFlatHashTableBaseConstIterator&);
+
+  /// \brief Returns the 'key' of the element that this iterator points to.
+  const KeyType& Key() const; // [tested]
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  const ValueType& Value() const; // [tested]
+
+  /// \brief Advances the iterator to the next element in the map. The iterator will not be valid anymore, if the end is reached.
+  void Next(); // [tested]
+
+  /// \brief Shorthand for 'Next'
+  void operator++(); // [tested]
+
+  /// \brief Returns '*this' to enable foreach
+  EZ_ALWAYS_INLINE ezFlatHashTableBaseConstIterator& operator*() { return *this; } // [tested]
+
+protected:
+  friend class ezFlatHashTableBase<KeyType, ValueType, Hasher>;
+
+  explicit ezFlatHashTableBaseConstIterator(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& hashTable);
+  void SetToBegin();
+  void SetToEnd();
+
+  const ezFlatHashTableBase<KeyType, ValueType, Hasher>* m_pHashTable = nullptr;
+  ezUInt32 m_uiCurrentIndex = 0; // current element index that this iterator points to.
+  ezUInt32 m_uiCurrentCount = 0; // current number of valid elements that this iterator has found so far.
+};
+
+/// \brief Iterator with write access.
+template <typename KeyType, typename ValueType, typename Hasher>
+struct ezFlatHashTableBaseIterator : public ezFlatHashTableBaseConstIterator<KeyType, ValueType, Hasher>
+{
+  EZ_DECLARE_POD_TYPE();
+
+  /// \brief Creates a new iterator from another.
+  EZ_ALWAYS_INLINE ezFlatHashTableBaseIterator(const ezFlatHashTableBaseIterator& rhs); // [tested]
+
+  /// \brief Assigns one iterator no another.
+  EZ_ALWAYS_INLINE void operator=(const ezFlatHashTableBaseIterator& rhs); // [tested]
+
+  // this is required to pull in the const version of this function
+  using ezFlatHashTableBaseConstIterator<KeyType, ValueType, Hasher>::Value;
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  EZ_FORCE_INLINE ValueType& Value(); // [tested]
+
+  /// \brief Returns the 'value' of the element that this iterator points to.
+  EZ_FORCE_INLINE ValueType& Value() const;
+
+  /// \brief Returns '*this' to enable foreach
+  EZ_ALWAYS_INLINE ezFlatHashTableBaseIterator& operator*() { return *this; } // [tested]
+
+private:
+  friend class ezFlatHashTableBase<KeyType, ValueType, Hasher>;
+
+  explicit ezFlatHashTableBaseIterator(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& hashTable);
+};
+
+/// \brief Implementation of a hashtable which stores key/value pairs in open addressing groups of 16 entries, similar to Abseil's SwissTable.
+///
+/// Next to the entries, the table stores one control byte per entry. A control byte either marks the entry as free or deleted,
+/// or it stores 7 bits of the hash of the key that is stored in the entry. Lookups compare the control bytes of a whole group
+/// at once (with SSE2, where available) and only compare the keys of those entries whose hash bits match, so most probes
+/// never touch the entries at all. A lookup for a key that is not in the table stops at the first group with a free entry.
+///
+/// Removed entries only become tombstones if their group has been full before, otherwise they are freed right away.
+/// Tombstones count towards the load, which is at most 87.5%. Once that is reached, the table either doubles its capacity or,
+/// if at least half of the occupied entries are tombstones, rebuilds itself at the same capacity.
+///
+/// Compared to ezHashTable, this table has a higher maximum load and is faster for lookups, especially for misses and in tables
+/// with many removals. The interface is the same, except that elements can't be accessed through structured bindings.
+///
+/// The hash computed by the Hasher is mixed again, before it is used, so even hashes that only differ in a few low bits
+/// (e.g. ezHashHelper<ezUInt64> for consecutive keys) are spread across the whole table.
+///
+/// \see ezHashTable, ezHashHelper
+template <typename KeyType, typename ValueType, typename Hasher>
+class ezFlatHashTableBase
+{
+public:
+  using Iterator = ezFlatHashTableBaseIterator<KeyType, ValueType, Hasher>;
+  using ConstIterator = ezFlatHashTableBaseConstIterator<KeyType, ValueType, Hasher>;
+
+protected:
+  /// \brief Creates an empty hashtable. Does not allocate any data yet.
+  explicit ezFlatHashTableBase(ezAllocator* pAllocator); // [tested]
+
+  /// \brief Creates a copy of the given hashtable.
+  ezFlatHashTableBase(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs, ezAllocator* pAllocator); // [tested]
+
+  /// \brief Moves data from an existing hashtable into this one.
+  ezFlatHashTableBase(ezFlatHashTableBase<KeyType, ValueType, Hasher>&& rhs, ezAllocator* pAllocator); // [tested]
+
+  /// \brief Destructor.
+  ~ezFlatHashTableBase(); // [tested]
+
+  /// \brief Copies the data from another hashtable into this one.
+  void operator=(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs); // [tested]
+
+  /// \brief Moves data from an existing hashtable into this one.
+  void operator=(ezFlatHashTableBase<KeyType, ValueType, Hasher>&& rhs); // [tested]
+
+public:
+  /// \brief Compares this table to another table.
+  bool operator==(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs) const; // [tested]
+  EZ_ADD_DEFAULT_OPERATOR_NOTEQUAL(const ezFlatHashTableBase<KeyType, ValueType, Hasher>&);
+
+  /// \brief Expands the hashtable, so that the given number of entries can be inserted without growing it again.
+  void Reserve(ezUInt32 uiCapacity); // [tested]
+
+  /// \brief Tries to compact the hashtable to avoid wasting memory. This also removes all tombstones.
+  ///
+  /// The resulting capacity is at least 'GetCount' (no elements get removed).
+  /// Will deallocate all data, if the hashtable is empty.
+  void Compact(); // [tested]
+
+  /// \brief Returns the number of active entries in the table.
+  ezUInt32 GetCount() const; // [tested]
+
+  /// \brief Returns true, if the hashtable does not contain any elements.
+  bool IsEmpty() const; // [tested]
+
+  /// \brief Clears the table.
+  void Clear(); // [tested]
+
+  /// \brief Inserts the key value pair or replaces value if an entry with the given key already exists.
+  ///
+  /// Returns true if an existing value was replaced and optionally writes out the old value to out_oldValue.
+  template <typename CompatibleKeyType, typename CompatibleValueType>
+  bool Insert(CompatibleKeyType&& key, CompatibleValueType&& value, ValueType* out_pOldValue = nullptr); // [tested]
+
+  /// \brief Removes the entry with the given key. Returns whether an entry was removed and optionally writes out the old value to out_oldValue.
+  template <typename CompatibleKeyType>
+  bool Remove(const CompatibleKeyType& key, ValueType* out_pOldValue = nullptr); // [tested]
+
+  /// \brief Erases the key/value pair at the given Iterator. Returns an iterator to the element after the given iterator.
+  Iterator Remove(const Iterator& pos); // [tested]
+
+  /// \brief Cannot remove an element with just a ezFlatHashTableBaseConstIterator
+  void Remove(const ConstIterator& pos) = delete;
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the corresponding value to out_value.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType& out_value) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, const ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Returns whether an entry with the given key was found and if found writes out the pointer to the corresponding value to out_pValue.
+  template <typename CompatibleKeyType>
+  bool TryGetValue(const CompatibleKeyType& key, ValueType*& out_pValue) const; // [tested]
+
+  /// \brief Searches for key, returns a ezFlatHashTableBaseConstIterator to it or an invalid iterator, if no such key is found. O(1) operation.
+  template <typename CompatibleKeyType>
+  ConstIterator Find(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Searches for key, returns an Iterator to it or an invalid iterator, if no such key is found. O(1) operation.
+  template <typename CompatibleKeyType>
+  Iterator Find(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  const ValueType* GetValue(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns a pointer to the value of the entry with the given key if found, otherwise returns nullptr.
+  template <typename CompatibleKeyType>
+  ValueType* GetValue(const CompatibleKeyType& key); // [tested]
+
+  /// \brief Returns the value to the given key if found or creates a new entry with the given key and a default constructed value.
+  ValueType& operator[](const KeyType& key); // [tested]
+
+  /// \brief Returns the value stored at the given key. If none exists, one is created. \a bExisted indicates whether an element needed to be created.
+  ValueType& FindOrAdd(const KeyType& key, bool* out_pExisted = nullptr); // [tested]
+
+  /// \brief Returns if an entry with given key exists in the table.
+  template <typename CompatibleKeyType>
+  bool Contains(const CompatibleKeyType& key) const; // [tested]
+
+  /// \brief Returns an Iterator to the very first element.
+  Iterator GetIterator(); // [tested]
+
+  /// \brief Returns an Iterator to the first element that is not part of the hash-table. Needed to support range based for loops.
+  Iterator GetEndIterator(); // [tested]
+
+  /// \brief Returns a constant Iterator to the very first element.
+  ConstIterator GetIterator() const; // [tested]
+
+  /// \brief Returns a ezFlatHashTableBaseConstIterator to the first element that is not part of the hash-table. Needed to support range based for loops.
+  ConstIterator GetEndIterator() const; // [tested]
+
+  /// \brief Returns the allocator that is used by this instance.
+  ezAllocator* GetAllocator() const;
+
+  /// \brief Returns the amount of bytes that are currently allocated on the heap.
+  ezUInt64 GetHeapMemoryUsage() const; // [tested]
+
+  /// \brief Swaps this map with the other one.
+  void Swap(ezFlatHashTableBase<KeyType, ValueType, Hasher>& other); // [tested]
+
+private:
+  friend struct ezFlatHashTableBaseConstIterator<KeyType, ValueType, Hasher>;
+  friend struct ezFlatHashTableBaseIterator<KeyType, ValueType, Hasher>;
+
+  struct Entry
+  {
+    KeyType key;
+    ValueType value;
+  };
+
+  Entry* m_pEntries = nullptr;
+  ezUInt8* m_pControlBytes = nullptr;
+
+  ezUInt32 m_uiCount = 0;
+  ezUInt32 m_uiCapacity = 0;
+  ezUInt32 m_uiNumDeleted = 0; // number of tombstones
+  ezUInt32 m_uiGrowthLeft = 0; // number of free entries that can still be used before the table needs to be rebuilt
+
+  ezAllocator* m_pAllocator = nullptr;
+
+  enum
+  {
+    GROUP_SIZE = 16,
+    FREE_ENTRY = 0x80,
+    DELETED_ENTRY = 0xFE,
+  };
+
+  static ezUInt32 GetMaxLoad(ezUInt32 uiCapacity);
+
+  void SetCapacity(ezUInt32 uiCapacity);
+  void GrowOrRehash();
+
+  /// \brief Returns the index of a free or deleted entry for the given hash and marks it as used. Might grow the table.
+  ezUInt32 PrepareInsert(ezUInt32 uiHash);
+  ezUInt32 FindInsertIndex(ezUInt32 uiHash) const;
+
+  void RemoveInternal(ezUInt32 uiIndex);
+
+  template <typename CompatibleKeyType>
+  static ezUInt32 ComputeHash(const CompatibleKeyType& key);
+
+  template <typename CompatibleKeyType>
+  ezUInt32 FindEntry(const CompatibleKeyType& key) const;
+
+  template <typename CompatibleKeyType>
+  ezUInt32 FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const;
+
+  bool IsValidEntry(ezUInt32 uiEntryIndex) const;
+};
+
+/// \brief \see ezFlatHashTableBase
+template <typename KeyType, typename ValueType, typename Hasher = ezHashHelper<KeyType>, typename AllocatorWrapper = ezDefaultAllocatorWrapper>
+class ezFlatHashTable : public ezFlatHashTableBase<KeyType, ValueType, Hasher>
+{
+public:
+  ezFlatHashTable();
+  explicit ezFlatHashTable(ezAllocator* pAllocator);
+
+  ezFlatHashTable(const ezFlatHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>& other);
+  ezFlatHashTable(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& other);
+
+  ezFlatHashTable(ezFlatHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>&& other);
+  ezFlatHashTable(ezFlatHashTableBase<KeyType, ValueType, Hasher>&& other);
+
+  void operator=(const ezFlatHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>& rhs);
+  void operator=(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& rhs);
+
+  void operator=(ezFlatHashTable<KeyType, ValueType, Hasher, AllocatorWrapper>&& rhs);
+  void operator=(ezFlatHashTableBase<KeyType, ValueType, Hasher>&& rhs);
+};
+
+//////////////////////////////////////////////////////////////////////////
+// begin() /end() for range-based for-loop support
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::Iterator begin(ezFlatHashTableBase<KeyType, ValueType, Hasher>& ref_container)
+{
+  return ref_container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator begin(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator cbegin(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::Iterator end(ezFlatHashTableBase<KeyType, ValueType, Hasher>& ref_container)
+{
+  return ref_container.GetEndIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator end(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetEndIterator();
+}
+
+template <typename KeyType, typename ValueType, typename Hasher>
+typename ezFlatHashTableBase<KeyType, ValueType, Hasher>::ConstIterator cend(const ezFlatHashTableBase<KeyType, ValueType, Hasher>& container)
+{
+  return container.GetEndIterator();
+}
+
+#include <Foundation/Containers/Implementation/FlatHashTable_inl.h>
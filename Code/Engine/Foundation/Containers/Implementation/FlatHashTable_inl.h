@@ -0,0 +1,884 @@
+/// \brief Value used by containers for indices to indicate an invalid index.
+#ifndef ezInvalidIndex
+#  define ezInvalidIndex 0xFFFFFFFF
+#endif
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+#  include <emmintrin.h>
+#endif
+
+namespace ezInternal
+{
+  /// \brief Compares the 16 control bytes of one group of an ezFlatHashTable at once.
+  ///
+  /// All functions return a bit mask with one bit per entry of the group.
+  struct ezFlatHashTableGroup
+  {
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+    EZ_ALWAYS_INLINE explicit ezFlatHashTableGroup(const ezUInt8* pControlBytes)
+      : m_ControlBytes(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pControlBytes)))
+    {
+    }
+
+    /// \brief Entries that store the given hash bits.
+    EZ_ALWAYS_INLINE ezUInt32 Match(ezUInt8 uiHashBits) const
+    {
+      return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ControlBytes, _mm_set1_epi8(static_cast<char>(uiHashBits)))));
+    }
+
+    /// \brief Entries that have never been used since the table was rebuilt.
+    EZ_ALWAYS_INLINE ezUInt32 MatchFree() const
+    {
+      return static_cast<ezUInt32>(_mm_movemask_epi8(_mm_cmpeq_epi8(m_ControlBytes, _mm_set1_epi8(static_cast<char>(0x80)))));
+    }
+
+    /// \brief Entries that are free or tombstones. Both have the highest bit set.
+    EZ_ALWAYS_INLINE ezUInt32 MatchFreeOrDeleted() const { return static_cast<ezUInt32>(_mm_movemask_epi8(m_ControlBytes)); }
+
+    __m128i m_ControlBytes;
+#else
+    EZ_ALWAYS_INLINE explicit ezFlatHashTableGroup(const ezUInt8* pControlBytes)
+      : m_pControlBytes(pControlBytes)
+    {
+    }
+
+    EZ_FORCE_INLINE ezUInt32 Match(ezUInt8 uiHashBits) const
+    {
+      ezUInt32 uiMask = 0;
+      for (ezUInt32 i = 0; i < 16; ++i)
+      {
+        uiMask |= static_cast<ezUInt32>(m_pControlBytes[i] == uiHashBits) << i;
+      }
+      return uiMask;
+    }
+
+    EZ_FORCE_INLINE ezUInt32 MatchFree() const { return Match(0x80); }
+
+    EZ_FORCE_INLINE ezUInt32 MatchFreeOrDeleted() const
+    {
+      ezUInt32 uiMask = 0;
+      for (ezUInt32 i = 0; i < 16; ++i)
+      {
+        uiMask |= static_cast<ezUInt32>(m_pControlBytes[i] >> 7) << i;
+      }
+      return uiMask;
+    }
+
+    const ezUInt8* m_pControlBytes;
+#endif
+  };
+} // namespace ezInternal
+
+// ***** Const Iterator *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBaseConstIterator<K, V, H>::ezFlatHashTableBaseConstIterator(const ezFlatHashTableBase<K, V, H>& hashTable)
+  : m_pHashTable(&hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBaseConstIterator<K, V, H>::SetToBegin()
+{
+  if (m_pHashTable->IsEmpty())
+  {
+    m_uiCurrentIndex = m_pHashTable->m_uiCapacity;
+    return;
+  }
+  while (!m_pHashTable->IsValidEntry(m_uiCurrentIndex))
+  {
+    ++m_uiCurrentIndex;
+  }
+}
+
+template <typename K, typename V, typename H>
+inline void ezFlatHashTableBaseConstIterator<K, V, H>::SetToEnd()
+{
+  m_uiCurrentCount = m_pHashTable->m_uiCount;
+  m_uiCurrentIndex = m_pHashTable->m_uiCapacity;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBaseConstIterator<K, V, H>::IsValid() const
+{
+  return m_uiCurrentCount < m_pHashTable->m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBaseConstIterator<K, V, H>::operator==(const ezFlatHashTableBaseConstIterator<K, V, H>& rhs) const
+{
+  return m_uiCurrentIndex == rhs.m_uiCurrentIndex && m_pHashTable->m_pEntries == rhs.m_pHashTable->m_pEntries;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const K& ezFlatHashTableBaseConstIterator<K, V, H>::Key() const
+{
+  return m_pHashTable->m_pEntries[m_uiCurrentIndex].key;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE const V& ezFlatHashTableBaseConstIterator<K, V, H>::Value() const
+{
+  return m_pHashTable->m_pEntries[m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBaseConstIterator<K, V, H>::Next()
+{
+  // if we already iterated over the amount of valid elements that the hash-table stores, early out
+  if (m_uiCurrentCount >= m_pHashTable->m_uiCount)
+    return;
+
+  ++m_uiCurrentCount;
+  ++m_uiCurrentIndex;
+
+  while (m_uiCurrentIndex < m_pHashTable->m_uiCapacity)
+  {
+    if (m_pHashTable->IsValidEntry(m_uiCurrentIndex))
+      return;
+
+    ++m_uiCurrentIndex;
+  }
+
+  // we reached the end of all elements in the container, make 'IsValid' return 'false'
+  m_uiCurrentCount = m_pHashTable->m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBaseConstIterator<K, V, H>::operator++()
+{
+  Next();
+}
+
+// ***** Iterator *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBaseIterator<K, V, H>::ezFlatHashTableBaseIterator(const ezFlatHashTableBase<K, V, H>& hashTable)
+  : ezFlatHashTableBaseConstIterator<K, V, H>(hashTable)
+{
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBaseIterator<K, V, H>::ezFlatHashTableBaseIterator(const ezFlatHashTableBaseIterator<K, V, H>& rhs)
+  : ezFlatHashTableBaseConstIterator<K, V, H>(*rhs.m_pHashTable)
+{
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiCurrentCount = rhs.m_uiCurrentCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE void ezFlatHashTableBaseIterator<K, V, H>::operator=(const ezFlatHashTableBaseIterator& rhs)
+{
+  this->m_pHashTable = rhs.m_pHashTable;
+  this->m_uiCurrentIndex = rhs.m_uiCurrentIndex;
+  this->m_uiCurrentCount = rhs.m_uiCurrentCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE V& ezFlatHashTableBaseIterator<K, V, H>::Value()
+{
+  return this->m_pHashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE V& ezFlatHashTableBaseIterator<K, V, H>::Value() const
+{
+  return this->m_pHashTable->m_pEntries[this->m_uiCurrentIndex].value;
+}
+
+// ***** ezFlatHashTableBase *****
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(ezAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(const ezFlatHashTableBase<K, V, H>& other, ezAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+
+  *this = other;
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::ezFlatHashTableBase(ezFlatHashTableBase<K, V, H>&& other, ezAllocator* pAllocator)
+{
+  m_pAllocator = pAllocator;
+
+  *this = std::move(other);
+}
+
+template <typename K, typename V, typename H>
+ezFlatHashTableBase<K, V, H>::~ezFlatHashTableBase()
+{
+  Clear();
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+  m_uiCapacity = 0;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::operator=(const ezFlatHashTableBase<K, V, H>& rhs)
+{
+  Clear();
+  Reserve(rhs.GetCount());
+
+  ezUInt32 uiCopied = 0;
+  for (ezUInt32 i = 0; uiCopied < rhs.GetCount(); ++i)
+  {
+    if (rhs.IsValidEntry(i))
+    {
+      Insert(rhs.m_pEntries[i].key, rhs.m_pEntries[i].value);
+      ++uiCopied;
+    }
+  }
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::operator=(ezFlatHashTableBase<K, V, H>&& rhs)
+{
+  // Clear any existing data (calls destructors if necessary)
+  Clear();
+
+  if (m_pAllocator != rhs.m_pAllocator)
+  {
+    Reserve(rhs.m_uiCount);
+
+    ezUInt32 uiCopied = 0;
+    for (ezUInt32 i = 0; uiCopied < rhs.GetCount(); ++i)
+    {
+      if (rhs.IsValidEntry(i))
+      {
+        Insert(std::move(rhs.m_pEntries[i].key), std::move(rhs.m_pEntries[i].value));
+        ++uiCopied;
+      }
+    }
+
+    rhs.Clear();
+  }
+  else
+  {
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+
+    // Move all data over.
+    m_pEntries = rhs.m_pEntries;
+    m_pControlBytes = rhs.m_pControlBytes;
+    m_uiCount = rhs.m_uiCount;
+    m_uiCapacity = rhs.m_uiCapacity;
+    m_uiNumDeleted = rhs.m_uiNumDeleted;
+    m_uiGrowthLeft = rhs.m_uiGrowthLeft;
+
+    // Temp copy forgets all its state.
+    rhs.m_pEntries = nullptr;
+    rhs.m_pControlBytes = nullptr;
+    rhs.m_uiCount = 0;
+    rhs.m_uiCapacity = 0;
+    rhs.m_uiNumDeleted = 0;
+    rhs.m_uiGrowthLeft = 0;
+  }
+}
+
+template <typename K, typename V, typename H>
+bool ezFlatHashTableBase<K, V, H>::operator==(const ezFlatHashTableBase<K, V, H>& rhs) const
+{
+  if (m_uiCount != rhs.m_uiCount)
+    return false;
+
+  ezUInt32 uiCompared = 0;
+  for (ezUInt32 i = 0; uiCompared < m_uiCount; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      const V* pRhsValue = nullptr;
+      if (!rhs.TryGetValue(m_pEntries[i].key, pRhsValue))
+        return false;
+
+      if (m_pEntries[i].value != *pRhsValue)
+        return false;
+
+      ++uiCompared;
+    }
+  }
+
+  return true;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Reserve(ezUInt32 uiCapacity)
+{
+  if (uiCapacity <= m_uiCount + m_uiGrowthLeft)
+    return;
+
+  // ensure a maximum load of 87.5%
+  ezUInt64 uiNewCapacity64 = static_cast<ezUInt64>(uiCapacity) + static_cast<ezUInt64>(uiCapacity) / 7 + 1;
+  uiNewCapacity64 = ezMath::Min<ezUInt64>(uiNewCapacity64, 0x80000000llu); // the largest power-of-two in 32 bit
+
+  ezUInt32 uiNewCapacity32 = static_cast<ezUInt32>(uiNewCapacity64 & 0xFFFFFFFF);
+  EZ_ASSERT_DEBUG(uiCapacity <= GetMaxLoad(uiNewCapacity32), "ezFlatHashTable does not support more than 1.8 billion entries.");
+
+  uiNewCapacity32 = ezMath::Max<ezUInt32>(ezMath::PowerOfTwo_Ceil(uiNewCapacity32), GROUP_SIZE);
+  if (m_uiCapacity >= uiNewCapacity32 && m_uiNumDeleted == 0)
+    return;
+
+  SetCapacity(ezMath::Max(uiNewCapacity32, m_uiCapacity));
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Compact()
+{
+  if (IsEmpty())
+  {
+    // completely deallocate all data, if the table is empty.
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pEntries);
+    EZ_DELETE_RAW_BUFFER(m_pAllocator, m_pControlBytes);
+    m_uiCapacity = 0;
+    m_uiNumDeleted = 0;
+    m_uiGrowthLeft = 0;
+  }
+  else
+  {
+    ezUInt32 uiNewCapacity = ezMath::Max<ezUInt32>(ezMath::PowerOfTwo_Ceil(m_uiCount), GROUP_SIZE);
+    if (GetMaxLoad(uiNewCapacity) < m_uiCount)
+      uiNewCapacity *= 2;
+
+    if (m_uiCapacity != uiNewCapacity || m_uiNumDeleted > 0)
+      SetCapacity(uiNewCapacity);
+  }
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetCount() const
+{
+  return m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE bool ezFlatHashTableBase<K, V, H>::IsEmpty() const
+{
+  return m_uiCount == 0;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Clear()
+{
+  for (ezUInt32 i = 0; i < m_uiCapacity; ++i)
+  {
+    if (IsValidEntry(i))
+    {
+      ezMemoryUtils::Destruct(&m_pEntries[i].key, 1);
+      ezMemoryUtils::Destruct(&m_pEntries[i].value, 1);
+    }
+  }
+
+  if (m_pControlBytes != nullptr)
+  {
+    ezMemoryUtils::PatternFill(m_pControlBytes, FREE_ENTRY, m_uiCapacity);
+  }
+
+  m_uiCount = 0;
+  m_uiNumDeleted = 0;
+  m_uiGrowthLeft = GetMaxLoad(m_uiCapacity);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType, typename CompatibleValueType>
+bool ezFlatHashTableBase<K, V, H>::Insert(CompatibleKeyType&& key, CompatibleValueType&& value, V* out_pOldValue /*= nullptr*/)
+{
+  const ezUInt32 uiHash = ComputeHash(key);
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_pOldValue != nullptr)
+      *out_pOldValue = std::move(m_pEntries[uiIndex].value);
+
+    m_pEntries[uiIndex].value = std::forward<CompatibleValueType>(value); // Either move or copy assignment.
+    return true;
+  }
+
+  uiIndex = PrepareInsert(uiHash);
+
+  // Both constructions might either be a move or a copy.
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].key, std::forward<CompatibleKeyType>(key));
+  ezMemoryUtils::CopyOrMoveConstruct(&m_pEntries[uiIndex].value, std::forward<CompatibleValueType>(value));
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+bool ezFlatHashTableBase<K, V, H>::Remove(const CompatibleKeyType& key, V* out_pOldValue /*= nullptr*/)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    if (out_pOldValue != nullptr)
+      *out_pOldValue = std::move(m_pEntries[uiIndex].value);
+
+    RemoveInternal(uiIndex);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::Remove(const typename ezFlatHashTableBase<K, V, H>::Iterator& pos)
+{
+  EZ_ASSERT_DEBUG(pos.m_pHashTable == this, "Iterator from wrong hashtable");
+  Iterator it = pos;
+  ezUInt32 uiIndex = pos.m_uiCurrentIndex;
+  ++it;
+  --it.m_uiCurrentCount;
+  RemoveInternal(uiIndex);
+  return it;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::RemoveInternal(ezUInt32 uiIndex)
+{
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].key, 1);
+  ezMemoryUtils::Destruct(&m_pEntries[uiIndex].value, 1);
+
+  // A lookup only continues past a group that has no free entries. If this group still has a free entry, it has never been full,
+  // so no lookup depends on this entry and it can be freed right away. Otherwise it has to become a tombstone.
+  const ezInternal::ezFlatHashTableGroup group(m_pControlBytes + (uiIndex & ~(GROUP_SIZE - 1)));
+  if (group.MatchFree() != 0)
+  {
+    m_pControlBytes[uiIndex] = FREE_ENTRY;
+    ++m_uiGrowthLeft;
+  }
+  else
+  {
+    m_pControlBytes[uiIndex] = DELETED_ENTRY;
+    ++m_uiNumDeleted;
+  }
+
+  --m_uiCount;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V& out_value) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    EZ_ASSERT_DEBUG(m_pEntries != nullptr, "No entries present"); // To fix static analysis
+    out_value = m_pEntries[uiIndex].value;
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, const V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    EZ_ANALYSIS_ASSUME(out_pValue != nullptr);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline bool ezFlatHashTableBase<K, V, H>::TryGetValue(const CompatibleKeyType& key, V*& out_pValue) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex != ezInvalidIndex)
+  {
+    out_pValue = &m_pEntries[uiIndex].value;
+    EZ_ANALYSIS_ASSUME(out_pValue != nullptr);
+    return true;
+  }
+
+  return false;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::Find(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  ConstIterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  it.m_uiCurrentCount = 0; // we do not know the 'count' (which is used as an optimization), so we just use 0
+
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::Find(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  if (uiIndex == ezInvalidIndex)
+  {
+    return GetEndIterator();
+  }
+
+  Iterator it(*this);
+  it.m_uiCurrentIndex = uiIndex;
+  it.m_uiCurrentCount = 0; // we do not know the 'count' (which is used as an optimization), so we just use 0
+  return it;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline const V* ezFlatHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key) const
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline V* ezFlatHashTableBase<K, V, H>::GetValue(const CompatibleKeyType& key)
+{
+  ezUInt32 uiIndex = FindEntry(key);
+  return (uiIndex != ezInvalidIndex) ? &m_pEntries[uiIndex].value : nullptr;
+}
+
+template <typename K, typename V, typename H>
+inline V& ezFlatHashTableBase<K, V, H>::operator[](const K& key)
+{
+  return FindOrAdd(key, nullptr);
+}
+
+template <typename K, typename V, typename H>
+V& ezFlatHashTableBase<K, V, H>::FindOrAdd(const K& key, bool* out_pExisted)
+{
+  const ezUInt32 uiHash = ComputeHash(key);
+  ezUInt32 uiIndex = FindEntry(uiHash, key);
+
+  if (out_pExisted)
+  {
+    *out_pExisted = uiIndex != ezInvalidIndex;
+  }
+
+  if (uiIndex == ezInvalidIndex)
+  {
+    uiIndex = PrepareInsert(uiHash);
+
+    ezMemoryUtils::CopyConstruct(&m_pEntries[uiIndex].key, key, 1);
+    ezMemoryUtils::Construct<ConstructAll>(&m_pEntries[uiIndex].value, 1);
+  }
+
+  EZ_ASSERT_DEBUG(m_pEntries != nullptr, "Entries should be present");
+  return m_pEntries[uiIndex].value;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::Contains(const CompatibleKeyType& key) const
+{
+  return FindEntry(key) != ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::GetIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::Iterator ezFlatHashTableBase<K, V, H>::GetEndIterator()
+{
+  Iterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::GetIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToBegin();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE typename ezFlatHashTableBase<K, V, H>::ConstIterator ezFlatHashTableBase<K, V, H>::GetEndIterator() const
+{
+  ConstIterator iterator(*this);
+  iterator.SetToEnd();
+  return iterator;
+}
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezAllocator* ezFlatHashTableBase<K, V, H>::GetAllocator() const
+{
+  return m_pAllocator;
+}
+
+template <typename K, typename V, typename H>
+ezUInt64 ezFlatHashTableBase<K, V, H>::GetHeapMemoryUsage() const
+{
+  return (ezUInt64)m_uiCapacity * (sizeof(Entry) + sizeof(ezUInt8));
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::Swap(ezFlatHashTableBase<K, V, H>& other)
+{
+  ezMath::Swap(this->m_pEntries, other.m_pEntries);
+  ezMath::Swap(this->m_pControlBytes, other.m_pControlBytes);
+  ezMath::Swap(this->m_uiCount, other.m_uiCount);
+  ezMath::Swap(this->m_uiCapacity, other.m_uiCapacity);
+  ezMath::Swap(this->m_uiNumDeleted, other.m_uiNumDeleted);
+  ezMath::Swap(this->m_uiGrowthLeft, other.m_uiGrowthLeft);
+  ezMath::Swap(this->m_pAllocator, other.m_pAllocator);
+}
+
+// private methods
+
+template <typename K, typename V, typename H>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::GetMaxLoad(ezUInt32 uiCapacity)
+{
+  return uiCapacity - uiCapacity / 8;
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::SetCapacity(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEBUG(ezMath::IsPowerOf2(uiCapacity) && uiCapacity >= GROUP_SIZE, "uiCapacity must be a power of two and at least one group.");
+  EZ_ASSERT_DEBUG(GetMaxLoad(uiCapacity) >= m_uiCount, "Capacity is too small for the current number of elements.");
+
+  const ezUInt32 uiOldCapacity = m_uiCapacity;
+  Entry* pOldEntries = m_pEntries;
+  ezUInt8* pOldControlBytes = m_pControlBytes;
+
+  m_uiCapacity = uiCapacity;
+  m_pEntries = EZ_NEW_RAW_BUFFER(m_pAllocator, Entry, m_uiCapacity);
+  m_pControlBytes = EZ_NEW_RAW_BUFFER(m_pAllocator, ezUInt8, m_uiCapacity);
+  ezMemoryUtils::PatternFill(m_pControlBytes, FREE_ENTRY, m_uiCapacity);
+
+  m_uiNumDeleted = 0;
+  m_uiGrowthLeft = GetMaxLoad(m_uiCapacity) - m_uiCount;
+
+  // the new table has no tombstones and all keys are unique, so each entry can go into the first free slot without any comparisons
+  for (ezUInt32 i = 0; i < uiOldCapacity; ++i)
+  {
+    if ((pOldControlBytes[i] & 0x80) == 0)
+    {
+      const ezUInt32 uiHash = ComputeHash(pOldEntries[i].key);
+      const ezUInt32 uiIndex = FindInsertIndex(uiHash);
+      m_pControlBytes[uiIndex] = static_cast<ezUInt8>(uiHash & 0x7F);
+
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].key, &pOldEntries[i].key, 1);
+      ezMemoryUtils::RelocateConstruct(&m_pEntries[uiIndex].value, &pOldEntries[i].value, 1);
+    }
+  }
+
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldEntries);
+  EZ_DELETE_RAW_BUFFER(m_pAllocator, pOldControlBytes);
+}
+
+template <typename K, typename V, typename H>
+void ezFlatHashTableBase<K, V, H>::GrowOrRehash()
+{
+  if (m_uiCapacity == 0)
+  {
+    SetCapacity(GROUP_SIZE);
+  }
+  else if (m_uiCount <= GetMaxLoad(m_uiCapacity) / 2)
+  {
+    // at least half of the used entries are tombstones, just get rid of them
+    SetCapacity(m_uiCapacity);
+  }
+  else
+  {
+    EZ_ASSERT_DEBUG(m_uiCapacity < 0x80000000u, "ezFlatHashTable does not support more than 1.8 billion entries.");
+    SetCapacity(m_uiCapacity * 2);
+  }
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::PrepareInsert(ezUInt32 uiHash)
+{
+  ezUInt32 uiIndex = m_uiCapacity > 0 ? FindInsertIndex(uiHash) : ezInvalidIndex;
+
+  // reusing a tombstone is always fine, taking a free entry needs to respect the maximum load
+  if (uiIndex == ezInvalidIndex || (m_uiGrowthLeft == 0 && m_pControlBytes[uiIndex] == FREE_ENTRY))
+  {
+    GrowOrRehash();
+    uiIndex = FindInsertIndex(uiHash);
+  }
+
+  if (m_pControlBytes[uiIndex] == FREE_ENTRY)
+  {
+    --m_uiGrowthLeft;
+  }
+  else
+  {
+    --m_uiNumDeleted;
+  }
+
+  m_pControlBytes[uiIndex] = static_cast<ezUInt8>(uiHash & 0x7F);
+  ++m_uiCount;
+
+  return uiIndex;
+}
+
+template <typename K, typename V, typename H>
+ezUInt32 ezFlatHashTableBase<K, V, H>::FindInsertIndex(ezUInt32 uiHash) const
+{
+  const ezUInt32 uiGroupMask = (m_uiCapacity / GROUP_SIZE) - 1;
+  ezUInt32 uiGroup = (uiHash >> 7) & uiGroupMask;
+
+  // triangular probing visits every group exactly once, since the number of groups is a power of two
+  for (ezUInt32 uiProbe = 1; uiProbe <= uiGroupMask + 1; ++uiProbe)
+  {
+    const ezUInt32 uiMask = ezInternal::ezFlatHashTableGroup(m_pControlBytes + uiGroup * GROUP_SIZE).MatchFreeOrDeleted();
+    if (uiMask != 0)
+    {
+      return uiGroup * GROUP_SIZE + ezMath::FirstBitLow(uiMask);
+    }
+
+    uiGroup = (uiGroup + uiProbe) & uiGroupMask;
+  }
+
+  return ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::ComputeHash(const CompatibleKeyType& key)
+{
+  // The lowest 7 bits are stored in the control bytes, the others select the group. Many hashers only mix the bits
+  // of the key a little, so the final mix of Murmur3 is applied to make sure that all bits of the hash are usable.
+  ezUInt32 uiHash = H::Hash(key);
+  uiHash ^= uiHash >> 16;
+  uiHash *= 0x85ebca6bu;
+  uiHash ^= uiHash >> 13;
+  uiHash *= 0xc2b2ae35u;
+  uiHash ^= uiHash >> 16;
+  return uiHash;
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+EZ_ALWAYS_INLINE ezUInt32 ezFlatHashTableBase<K, V, H>::FindEntry(const CompatibleKeyType& key) const
+{
+  return FindEntry(ComputeHash(key), key);
+}
+
+template <typename K, typename V, typename H>
+template <typename CompatibleKeyType>
+inline ezUInt32 ezFlatHashTableBase<K, V, H>::FindEntry(ezUInt32 uiHash, const CompatibleKeyType& key) const
+{
+  if (m_uiCapacity == 0)
+    return ezInvalidIndex;
+
+  const ezUInt8 uiHashBits = static_cast<ezUInt8>(uiHash & 0x7F);
+  const ezUInt32 uiGroupMask = (m_uiCapacity / GROUP_SIZE) - 1;
+  ezUInt32 uiGroup = (uiHash >> 7) & uiGroupMask;
+
+  for (ezUInt32 uiProbe = 1; uiProbe <= uiGroupMask + 1; ++uiProbe)
+  {
+    const ezUInt8* pControlBytes = m_pControlBytes + uiGroup * GROUP_SIZE;
+    const ezInternal::ezFlatHashTableGroup group(pControlBytes);
+
+    ezUInt32 uiMask = group.Match(uiHashBits);
+    while (uiMask != 0)
+    {
+      const ezUInt32 uiIndex = uiGroup * GROUP_SIZE + ezMath::FirstBitLow(uiMask);
+      if (H::Equal(m_pEntries[uiIndex].key, key))
+        return uiIndex;
+
+      uiMask &= uiMask - 1;
+    }
+
+    // the key would have been inserted into this group, if it wasn't full
+    if (group.MatchFree() != 0)
+      break;
+
+    uiGroup = (uiGroup + uiProbe) & uiGroupMask;
+  }
+
+  // not found
+  return ezInvalidIndex;
+}
+
+template <typename K, typename V, typename H>
+EZ_FORCE_INLINE bool ezFlatHashTableBase<K, V, H>::IsValidEntry(ezUInt32 uiEntryIndex) const
+{
+  return (m_pControlBytes[uiEntryIndex] & 0x80) == 0;
+}
+
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable()
+  : ezFlatHashTableBase<K, V, H>(A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezAllocator* pAllocator)
+  : ezFlatHashTableBase<K, V, H>(pAllocator)
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(const ezFlatHashTable<K, V, H, A>& other)
+  : ezFlatHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(const ezFlatHashTableBase<K, V, H>& other)
+  : ezFlatHashTableBase<K, V, H>(other, A::GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezFlatHashTable<K, V, H, A>&& other)
+  : ezFlatHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+ezFlatHashTable<K, V, H, A>::ezFlatHashTable(ezFlatHashTableBase<K, V, H>&& other)
+  : ezFlatHashTableBase<K, V, H>(std::move(other), other.GetAllocator())
+{
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(const ezFlatHashTable<K, V, H, A>& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(const ezFlatHashTableBase<K, V, H>& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(rhs);
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(ezFlatHashTable<K, V, H, A>&& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
+
+template <typename K, typename V, typename H, typename A>
+void ezFlatHashTable<K, V, H, A>::operator=(ezFlatHashTableBase<K, V, H>&& rhs)
+{
+  ezFlatHashTableBase<K, V, H>::operator=(std::move(rhs));
+}
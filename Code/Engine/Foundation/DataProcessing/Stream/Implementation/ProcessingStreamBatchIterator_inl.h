@@ -0,0 +1,215 @@
+
+template <typename Type>
+EZ_ALWAYS_INLINE ezProcessingStreamBatchIterator<Type>::ezProcessingStreamBatchIterator(const ezProcessingStream* pStream, ezUInt64 uiNumElements, ezUInt64 uiStartIndex, ezUInt32 uiElementStep)
+{
+  EZ_ASSERT_DEV(pStream != nullptr, "Stream pointer may not be null!");
+  EZ_ASSERT_DEV(pStream->GetElementSize() == sizeof(Type), "Data size missmatch");
+  EZ_ASSERT_DEV(uiElementStep > 0, "Element step must not be zero");
+
+  m_uiElementStride = pStream->GetElementStride();
+  m_uiStepStride = m_uiElementStride * uiElementStep;
+  m_uiElementStep = uiElementStep;
+
+  m_pCurrentPtr = static_cast<ezUInt8*>(ezMemoryUtils::AddByteOffset(pStream->GetWritableData(), static_cast<std::ptrdiff_t>(uiStartIndex * m_uiElementStride)));
+  m_pEndPtr = static_cast<ezUInt8*>(ezMemoryUtils::AddByteOffset(pStream->GetWritableData(), static_cast<std::ptrdiff_t>((uiStartIndex + uiNumElements) * m_uiElementStride)));
+
+  UpdateNumElements();
+}
+
+template <typename Type>
+EZ_ALWAYS_INLINE Type& ezProcessingStreamBatchIterator<Type>::Element(ezUInt32 i) const
+{
+  EZ_ASSERT_DEBUG(i < m_uiNumElements, "Out of bounds access");
+  return *reinterpret_cast<Type*>(m_pCurrentPtr + i * m_uiStepStride);
+}
+
+template <typename Type>
+EZ_ALWAYS_INLINE ezUInt32 ezProcessingStreamBatchIterator<Type>::GetNumElements() const
+{
+  return m_uiNumElements;
+}
+
+template <typename Type>
+EZ_ALWAYS_INLINE bool ezProcessingStreamBatchIterator<Type>::IsContiguous() const
+{
+  return m_bIsContiguous;
+}
+
+template <typename Type>
+EZ_ALWAYS_INLINE bool ezProcessingStreamBatchIterator<Type>::HasReachedEnd() const
+{
+  return m_pCurrentPtr >= m_pEndPtr;
+}
+
+template <typename Type>
+EZ_ALWAYS_INLINE void ezProcessingStreamBatchIterator<Type>::Advance()
+{
+  m_pCurrentPtr += m_uiStepStride * Width;
+  UpdateNumElements();
+}
+
+template <typename Type>
+EZ_ALWAYS_INLINE void ezProcessingStreamBatchIterator<Type>::UpdateNumElements()
+{
+  const ezUInt64 uiRemainingBytes = m_pCurrentPtr < m_pEndPtr ? static_cast<ezUInt64>(m_pEndPtr - m_pCurrentPtr) : 0;
+
+  // common case, avoids the division
+  if (uiRemainingBytes > m_uiStepStride * (Width - 1))
+  {
+    m_uiNumElements = Width;
+    m_bIsContiguous = m_uiElementStep == 1 && m_uiElementStride == sizeof(Type);
+    return;
+  }
+
+  m_uiNumElements = static_cast<ezUInt32>((uiRemainingBytes + m_uiStepStride - 1) / m_uiStepStride);
+  m_bIsContiguous = false;
+}
+
+namespace ezProcessingStreamBatch
+{
+  inline ezSimdVec4f Load(const ezProcessingStreamBatchIterator<float>& it)
+  {
+    if (it.IsContiguous())
+    {
+      ezSimdVec4f v;
+      v.Load<4>(&it.Element(0));
+      return v;
+    }
+
+    float values[4] = {};
+    for (ezUInt32 i = 0; i < it.GetNumElements(); ++i)
+    {
+      values[i] = it.Element(i);
+    }
+
+    ezSimdVec4f v;
+    v.Load<4>(values);
+    return v;
+  }
+
+  inline ezSimdVec4f Load(const ezProcessingStreamBatchIterator<ezFloat16>& it)
+  {
+    if (it.IsContiguous())
+    {
+      return ezSimdConversion::ToVec4(&it.Element(0));
+    }
+
+    ezFloat16 values[4] = {};
+    for (ezUInt32 i = 0; i < it.GetNumElements(); ++i)
+    {
+      values[i] = it.Element(i);
+    }
+
+    return ezSimdConversion::ToVec4(values);
+  }
+
+  inline void Load(const ezProcessingStreamBatchIterator<ezFloat16Vec2>& it, ezSimdVec4f& out_x, ezSimdVec4f& out_y)
+  {
+    ezSimdVec4f xy01, xy23;
+
+    if (it.IsContiguous())
+    {
+      xy01 = ezSimdConversion::ToVec4(&it.Element(0).x);
+      xy23 = ezSimdConversion::ToVec4(&it.Element(2).x);
+    }
+    else
+    {
+      ezFloat16 values[8] = {};
+      for (ezUInt32 i = 0; i < it.GetNumElements(); ++i)
+      {
+        values[i * 2 + 0] = it.Element(i).x;
+        values[i * 2 + 1] = it.Element(i).y;
+      }
+
+      xy01 = ezSimdConversion::ToVec4(values + 0);
+      xy23 = ezSimdConversion::ToVec4(values + 4);
+    }
+
+    out_x = xy01.GetCombined<ezSwizzle::XZXZ>(xy23);
+    out_y = xy01.GetCombined<ezSwizzle::YWYW>(xy23);
+  }
+
+  inline void Load(const ezProcessingStreamBatchIterator<ezVec3>& it, ezSimdVec4f& out_x, ezSimdVec4f& out_y, ezSimdVec4f& out_z)
+  {
+    ezSimdVec4f e[4] = {ezSimdVec4f::MakeZero(), ezSimdVec4f::MakeZero(), ezSimdVec4f::MakeZero(), ezSimdVec4f::MakeZero()};
+    for (ezUInt32 i = 0; i < it.GetNumElements(); ++i)
+    {
+      e[i].Load<3>(&it.Element(i).x);
+    }
+
+    const ezSimdMat4f m = ezSimdMat4f::MakeFromColumns(e[0], e[1], e[2], e[3]).GetTranspose();
+    out_x = m.m_col0;
+    out_y = m.m_col1;
+    out_z = m.m_col2;
+  }
+
+  EZ_ALWAYS_INLINE void LoadInterleaved(const ezProcessingStreamBatchIterator<ezVec3>& it, ezSimdVec4f& out_xyzx, ezSimdVec4f& out_yzxy, ezSimdVec4f& out_zxyz)
+  {
+    EZ_ASSERT_DEBUG(it.IsContiguous(), "Interleaved access requires a full block of consecutive elements");
+
+    const float* pData = &it.Element(0).x;
+    out_xyzx.Load<4>(pData + 0);
+    out_yzxy.Load<4>(pData + 4);
+    out_zxyz.Load<4>(pData + 8);
+  }
+
+  inline void Store(const ezProcessingStreamBatchIterator<float>& it, const ezSimdVec4f& v)
+  {
+    if (it.IsContiguous())
+    {
+      v.Store<4>(&it.Element(0));
+      return;
+    }
+
+    float values[4];
+    v.Store<4>(values);
+
+    for (ezUInt32 i = 0; i < it.GetNumElements(); ++i)
+    {
+      it.Element(i) = values[i];
+    }
+  }
+
+  inline void Store(const ezProcessingStreamBatchIterator<ezFloat16>& it, const ezSimdVec4f& v)
+  {
+    if (it.IsContiguous())
+    {
+      ezSimdConversion::ToFloat16(v, &it.Element(0));
+      return;
+    }
+
+    ezFloat16 values[4];
+    ezSimdConversion::ToFloat16(v, values);
+
+    for (ezUInt32 i = 0; i < it.GetNumElements(); ++i)
+    {
+      it.Element(i) = values[i];
+    }
+  }
+
+  inline void Store(const ezProcessingStreamBatchIterator<ezVec3>& it, const ezSimdVec4f& x, const ezSimdVec4f& y, const ezSimdVec4f& z)
+  {
+    const ezSimdMat4f m = ezSimdMat4f::MakeFromColumns(x, y, z, ezSimdVec4f::MakeZero()).GetTranspose();
+    const ezSimdVec4f* e[4] = {&m.m_col0, &m.m_col1, &m.m_col2, &m.m_col3};
+
+    for (ezUInt32 i = 0; i < it.GetNumElements(); ++i)
+    {
+      e[i]->Store<3>(&it.Element(i).x);
+    }
+  }
+
+  EZ_ALWAYS_INLINE void StoreInterleaved(const ezProcessingStreamBatchIterator<ezVec3>& it, const ezSimdVec4f& xyzx, const ezSimdVec4f& yzxy, const ezSimdVec4f& zxyz)
+  {
+    EZ_ASSERT_DEBUG(it.IsContiguous(), "Interleaved access requires a full block of consecutive elements");
+
+    float* pData = &it.Element(0).x;
+    xyzx.Store<4>(pData + 0);
+    yzxy.Store<4>(pData + 4);
+    zxyz.Store<4>(pData + 8);
+  }
+
+  EZ_ALWAYS_INLINE void StoreColor(const ezProcessingStreamBatchIterator<ezColorLinear16f>& it, ezUInt32 i, const ezSimdVec4f& rgba)
+  {
+    ezSimdConversion::ToFloat16(rgba, &it.Element(i).r);
+  }
+} // namespace ezProcessingStreamBatch
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <Foundation/DataProcessing/Stream/ProcessingStream.h>
+#include <Foundation/Math/Color16f.h>
+#include <Foundation/Math/Float16.h>
+#include <Foundation/Memory/MemoryUtils.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
+
+/// \brief Helper template class to iterate over stream elements in blocks of ezProcessingStreamBatchIterator::Width elements.
+///
+/// This is meant for stream processors that use SIMD code to process several elements at once.
+/// The functions in the ezProcessingStreamBatch namespace load a block into one ezSimdVec4f per component (structure of arrays)
+/// and write it back, so the actual kernel can work on all lanes at once. The streams themselves keep their regular layout.
+///
+/// An element step larger than one makes the iterator only visit every n-th element,
+/// which is useful for processors that only update a subset of all elements each frame.
+///
+/// The last block may contain fewer than Width elements, GetNumElements() returns how many lanes are valid.
+/// Unused lanes are loaded as zero and are never written back.
+template <typename Type>
+class ezProcessingStreamBatchIterator
+{
+public:
+  static constexpr ezUInt32 Width = 4;
+
+  /// \brief Constructor.
+  ezProcessingStreamBatchIterator(const ezProcessingStream* pStream, ezUInt64 uiNumElements, ezUInt64 uiStartIndex, ezUInt32 uiElementStep = 1);
+
+  /// \brief Returns the i-th element of the current block. Note that the behavior is undefined if i >= GetNumElements()!
+  Type& Element(ezUInt32 i) const;
+
+  /// \brief Returns the number of valid elements in the current block. This is only less than Width for the last block.
+  ezUInt32 GetNumElements() const;
+
+  /// \brief Returns true if all elements of the current block are stored consecutively, i.e. the block is full, the element step is one and the stream is not interleaved with other data.
+  bool IsContiguous() const;
+
+  /// \brief Returns true of the iterator has reached the end of the stream or the number of elements it should iterate over.
+  bool HasReachedEnd() const;
+
+  /// \brief Advances the iterator to the next block.
+  void Advance();
+
+protected:
+  void UpdateNumElements();
+
+  ezUInt8* m_pCurrentPtr = nullptr;
+  ezUInt8* m_pEndPtr = nullptr;
+
+  ezUInt64 m_uiElementStride = 0;
+  ezUInt64 m_uiStepStride = 0;
+  ezUInt32 m_uiElementStep = 1;
+  ezUInt32 m_uiNumElements = 0;
+  bool m_bIsContiguous = false;
+};
+
+/// \brief Load and store functions that convert blocks of stream elements to and from ezSimdVec4f lanes.
+namespace ezProcessingStreamBatch
+{
+  /// \brief Loads a block of floats.
+  ezSimdVec4f Load(const ezProcessingStreamBatchIterator<float>& it);
+
+  /// \brief Loads a block of half-precision floats.
+  ezSimdVec4f Load(const ezProcessingStreamBatchIterator<ezFloat16>& it);
+
+  /// \brief Loads a block of half-precision 2D vectors, one register per component.
+  void Load(const ezProcessingStreamBatchIterator<ezFloat16Vec2>& it, ezSimdVec4f& out_x, ezSimdVec4f& out_y);
+
+  /// \brief Loads a block of 3D vectors, one register per component.
+  void Load(const ezProcessingStreamBatchIterator<ezVec3>& it, ezSimdVec4f& out_x, ezSimdVec4f& out_y, ezSimdVec4f& out_z);
+
+  /// \brief Loads a contiguous block of 3D vectors as three registers of interleaved xyz values.
+  ///
+  /// This avoids the transpose of the regular Load() and is preferable when all components are processed the same way, e.g. when adding a constant.
+  void LoadInterleaved(const ezProcessingStreamBatchIterator<ezVec3>& it, ezSimdVec4f& out_xyzx, ezSimdVec4f& out_yzxy, ezSimdVec4f& out_zxyz);
+
+  /// \brief Stores a block of floats.
+  void Store(const ezProcessingStreamBatchIterator<float>& it, const ezSimdVec4f& v);
+
+  /// \brief Stores a block of half-precision floats.
+  void Store(const ezProcessingStreamBatchIterator<ezFloat16>& it, const ezSimdVec4f& v);
+
+  /// \brief Stores a block of 3D vectors from one register per component.
+  void Store(const ezProcessingStreamBatchIterator<ezVec3>& it, const ezSimdVec4f& x, const ezSimdVec4f& y, const ezSimdVec4f& z);
+
+  /// \brief Stores a contiguous block of 3D vectors from three registers of interleaved xyz values, see LoadInterleaved().
+  void StoreInterleaved(const ezProcessingStreamBatchIterator<ezVec3>& it, const ezSimdVec4f& xyzx, const ezSimdVec4f& yzxy, const ezSimdVec4f& zxyz);
+
+  /// \brief Stores a single color of the block. The components of \a rgba are converted to half-precision in one go.
+  void StoreColor(const ezProcessingStreamBatchIterator<ezColorLinear16f>& it, ezUInt32 i, const ezSimdVec4f& rgba);
+} // namespace ezProcessingStreamBatch
+
+#include <Foundation/DataProcessing/Stream/Implementation/ProcessingStreamBatchIterator_inl.h>
@@ -12,6 +12,7 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_chunked, ///< Independently compressed zstd chunks followed by a seek table, see ezArchiveChunkedReaderZstd.
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -8,6 +8,11 @@
 /// \brief Utility class to build an ezArchive file from files/folders on disk
 ///
 /// All functionality for writing an ezArchive file is available through ezArchiveUtils.
+///
+/// The source files are read and compressed in parallel on the ezTaskSystem, but always written in the order of m_Entries,
+/// so the resulting archive is deterministic. Files larger than ezArchiveUtils::ArchiveChunkSize are split into chunks that are
+/// compressed independently (see ezArchiveCompressionMode::Compressed_zstd_chunked), which allows to compress a single large file
+/// on multiple threads and to seek within it without decompressing everything in front of the read position.
 class EZ_FOUNDATION_DLL ezArchiveBuilder
 {
 public:
@@ -22,6 +27,16 @@ public:
   // all the source files from disk that should be put into the ezArchive
   ezDeque<SourceEntry> m_Entries;
 
+  /// \brief Summary of a WriteArchive() run, see WriteArchiveResultCallback().
+  struct Statistics
+  {
+    ezUInt32 m_uiNumEntries = 0;
+    ezUInt64 m_uiUncompressedSize = 0;
+    ezUInt64 m_uiStoredSize = 0;
+    ezTime m_TotalDuration;      ///< How long writing the archive took.
+    ezTime m_ProcessingDuration; ///< Sum of the time that all threads spent on reading and compressing the source files.
+  };
+
   enum class InclusionMode
   {
     Exclude,               ///< Do not add this file to the archive
@@ -56,6 +71,7 @@ protected:
   virtual bool WriteFileProgressCallback(ezUInt64 bytesWritten, ezUInt64 bytesTotal) const;
 
   /// Override this to get a callback after a file has been processed. Gets additional information about the compression result and duration.
+  /// The duration is the time spent on reading and compressing the file, summed up over all threads that worked on it.
   virtual void WriteFileResultCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile, ezUInt64 uiSourceSize, ezUInt64 uiStoredSize, ezTime duration) const
   {
     EZ_IGNORE_UNUSED(uiCurEntry);
@@ -65,4 +81,10 @@ protected:
     EZ_IGNORE_UNUSED(uiStoredSize);
     EZ_IGNORE_UNUSED(duration);
   }
+
+  /// Override this to get a callback after the entire archive was written successfully.
+  virtual void WriteArchiveResultCallback(const Statistics& stats) const
+  {
+    EZ_IGNORE_UNUSED(stats);
+  }
 };
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/Archive/ArchiveUtils.h>
+#include <Foundation/IO/Stream.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+class ezRawMemoryStreamReader;
+
+/// \brief Reads the data of an archive entry that was stored with ezArchiveCompressionMode::Compressed_zstd_chunked.
+///
+/// Such entries consist of chunks that were compressed independently of each other, followed by a seek table:
+///   - for every chunk its stored size as ezUInt32, with ezArchiveUtils::ArchiveChunkStoredUncompressedFlag set if compression did not pay off for this chunk
+///   - the uncompressed chunk size as ezUInt32, all chunks but the last one have exactly this size
+///   - the number of chunks as ezUInt32
+///
+/// Since every chunk can be decompressed on its own, SkipBytes() and SetReadPosition() only decompress the chunk that
+/// is read from next, instead of everything in front of it.
+class EZ_FOUNDATION_DLL ezArchiveChunkedReaderZstd : public ezStreamReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezArchiveChunkedReaderZstd);
+
+public:
+  ezArchiveChunkedReaderZstd();
+  ~ezArchiveChunkedReaderZstd();
+
+  /// \brief Sets the stream that provides the stored entry data and reads the seek table from it.
+  ///
+  /// Fails, if the seek table does not match the stored data or the uncompressed size.
+  ezResult SetInputStream(ezRawMemoryStreamReader* pInputStream, ezUInt64 uiUncompressedSize);
+
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override;
+
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override;
+
+  /// \brief Moves the read position within the uncompressed data. Moving backwards is supported as well.
+  void SetReadPosition(ezUInt64 uiReadPosition);
+
+  /// \brief Returns the read position within the uncompressed data.
+  ezUInt64 GetReadPosition() const { return m_uiReadPosition; }
+
+  /// \brief Returns how many chunks had to be decompressed so far. Mostly useful for testing.
+  ezUInt32 GetNumDecompressedChunks() const { return m_uiNumDecompressedChunks; }
+
+private:
+  ezResult LoadChunk(ezUInt32 uiChunk);
+
+  ezRawMemoryStreamReader* m_pInputStream = nullptr;
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt64 m_uiReadPosition = 0;
+  ezUInt32 m_uiChunkSize = 0;
+
+  ezDynamicArray<ezUInt32> m_ChunkSizes;   ///< Stored size of each chunk, including the ezArchiveUtils::ArchiveChunkStoredUncompressedFlag.
+  ezDynamicArray<ezUInt64> m_ChunkOffsets; ///< Offset of each chunk in the stored data.
+
+  ezUInt32 m_uiLoadedChunk = ezInvalidIndex;
+  ezUInt32 m_uiNumDecompressedChunks = 0;
+  ezDynamicArray<ezUInt8> m_StoredChunk;
+  ezDynamicArray<ezUInt8> m_UncompressedChunk;
+};
+
+#endif
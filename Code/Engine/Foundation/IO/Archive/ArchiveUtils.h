@@ -16,7 +16,9 @@ namespace ezArchiveUtils
 {
   using FileWriteProgressCallback = ezDelegate<bool(ezUInt64, ezUInt64)>;
   constexpr ezUInt32 ArchiveHeaderSize = 16;
-  constexpr ezUInt32 ArchiveTOCMetaMaxFooterSize = 14 + 12; //< note that it's the MAX size, i.e. toc meta can be smaller
+  constexpr ezUInt32 ArchiveTOCMetaMaxFooterSize = 14 + 12;           //< note that it's the MAX size, i.e. toc meta can be smaller
+  constexpr ezUInt32 ArchiveChunkSize = 1024 * 1024;                   //< entries larger than this are compressed in independent chunks of this size
+  constexpr ezUInt32 ArchiveChunkStoredUncompressedFlag = 0x80000000u; //< set in the seek table of chunked entries for chunks that were stored uncompressed
 
   struct TOCMeta
   {
@@ -3,11 +3,17 @@
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+#  include <zstd/zstd.h>
+#endif
+
 void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressionMode defaultMode /*= ezArchiveCompressionMode::Uncompressed*/, InclusionCallback callback /*= InclusionCallback()*/)
 {
 #if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
@@ -97,10 +103,98 @@ ezResult ezArchiveBuilder::WriteArchive(ezStringView sFile) const
   return WriteArchive(file);
 }
 
+struct ezArchiveBuilderWorkItem
+{
+  ezUInt32 m_uiEntry = 0;
+  ezUInt32 m_uiChunk = 0;
+  ezUInt32 m_uiNumChunks = 0;
+  ezUInt64 m_uiSourceOffset = 0;
+  ezUInt32 m_uiSourceSize = 0;
+  bool m_bCompressed = false;
+  ezResult m_Result = EZ_FAILURE;
+  ezTime m_Duration;
+  ezDynamicArray<ezUInt8> m_Data;
+};
+
+static void ProcessWorkItem(ezArchiveBuilderWorkItem& ref_item, const ezArchiveBuilder::SourceEntry& entry)
+{
+  ezStopwatch sw;
+
+  ezFileReader file;
+  if (file.Open(entry.m_sAbsSourcePath).Failed())
+  {
+    ezLog::Error("Could not open file for reading: '{}'", entry.m_sAbsSourcePath);
+    return;
+  }
+
+  ezDynamicArray<ezUInt8> source;
+  source.SetCountUninitialized(ref_item.m_uiSourceSize);
+
+  if (file.SkipBytes(ref_item.m_uiSourceOffset) != ref_item.m_uiSourceOffset || file.ReadBytes(source.GetData(), ref_item.m_uiSourceSize) != ref_item.m_uiSourceSize)
+  {
+    ezLog::Error("Failed to read {} bytes at offset {} from '{}'", ref_item.m_uiSourceSize, ref_item.m_uiSourceOffset, entry.m_sAbsSourcePath);
+    return;
+  }
+
+  ref_item.m_bCompressed = false;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd)
+  {
+    ref_item.m_Data.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(ref_item.m_uiSourceSize)));
+
+    const size_t uiCompressedSize = ZSTD_compress(ref_item.m_Data.GetData(), ref_item.m_Data.GetCount(), source.GetData(), ref_item.m_uiSourceSize, entry.m_iCompressionLevel);
+
+    if (ZSTD_isError(uiCompressedSize))
+    {
+      ezLog::Error("Compressing '{}' failed: '{}'", entry.m_sAbsSourcePath, ZSTD_getErrorName(uiCompressedSize));
+      return;
+    }
+
+    ref_item.m_Data.SetCountUninitialized(static_cast<ezUInt32>(uiCompressedSize));
+
+    if (ref_item.m_uiNumChunks == 1)
+    {
+      // entries that consist of a single chunk are stored as Compressed_zstd, which is read through ezCompressedStreamReaderZstd
+      // that format splits the compressed data into blocks with a 16 bit size and a zero size as the terminator
+      ezDynamicArray<ezUInt8> framed;
+      framed.Reserve(ref_item.m_Data.GetCount() + (ref_item.m_Data.GetCount() / 0xFFFF + 2) * sizeof(ezUInt16));
+
+      ezUInt32 uiOffset = 0;
+      do
+      {
+        const ezUInt16 uiBlockSize = static_cast<ezUInt16>(ezMath::Min<ezUInt32>(0xFFFF, ref_item.m_Data.GetCount() - uiOffset));
+        framed.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(&uiBlockSize), sizeof(ezUInt16)));
+        framed.PushBackRange(ref_item.m_Data.GetArrayPtr().GetSubArray(uiOffset, uiBlockSize));
+        uiOffset += uiBlockSize;
+      } while (uiOffset < ref_item.m_Data.GetCount());
+
+      const ezUInt16 uiTerminator = 0;
+      framed.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(&uiTerminator), sizeof(ezUInt16)));
+
+      ref_item.m_Data = std::move(framed);
+    }
+
+    // less than 20% size saving -> store this chunk uncompressed
+    ref_item.m_bCompressed = static_cast<ezUInt64>(ref_item.m_Data.GetCount()) * 12 < static_cast<ezUInt64>(ref_item.m_uiSourceSize) * 10;
+  }
+#endif
+
+  if (!ref_item.m_bCompressed)
+  {
+    ref_item.m_Data = std::move(source);
+  }
+
+  ref_item.m_Duration = sw.GetRunningTotal();
+  ref_item.m_Result = EZ_SUCCESS;
+}
+
 ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
 {
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(inout_stream));
 
+  ezStopwatch sw;
+
   ezArchiveTOC toc;
 
   ezStringBuilder sHashablePath;
@@ -108,31 +202,136 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
   ezUInt64 uiStreamSize = 0;
   const ezUInt32 uiNumEntries = m_Entries.GetCount();
 
-  ezStopwatch sw;
-
+  // split every entry into work items, files larger than the chunk size get one item per chunk
+  ezDynamicArray<ezArchiveBuilderWorkItem> items;
   for (ezUInt32 i = 0; i < uiNumEntries; ++i)
   {
-    const SourceEntry& e = m_Entries[i];
+    ezFileReader file;
+    if (file.Open(m_Entries[i].m_sAbsSourcePath).Failed())
+    {
+      ezLog::Error("Could not open file for reading: '{}'", m_Entries[i].m_sAbsSourcePath);
+      return EZ_FAILURE;
+    }
+
+    const ezUInt64 uiFileSize = file.GetFileSize();
+    const ezUInt32 uiNumChunks = ezMath::Max(1u, static_cast<ezUInt32>((uiFileSize + ezArchiveUtils::ArchiveChunkSize - 1) / ezArchiveUtils::ArchiveChunkSize));
+
+    for (ezUInt32 uiChunk = 0; uiChunk < uiNumChunks; ++uiChunk)
+    {
+      ezArchiveBuilderWorkItem& item = items.ExpandAndGetRef();
+      item.m_uiEntry = i;
+      item.m_uiChunk = uiChunk;
+      item.m_uiNumChunks = uiNumChunks;
+      item.m_uiSourceOffset = static_cast<ezUInt64>(uiChunk) * ezArchiveUtils::ArchiveChunkSize;
+      item.m_uiSourceSize = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(ezArchiveUtils::ArchiveChunkSize, uiFileSize - item.m_uiSourceOffset));
+    }
+  }
+
+  Statistics stats;
+  stats.m_uiNumEntries = uiNumEntries;
+
+  ezHybridArray<ezUInt32, 64> chunkSizes;
+  bool bAnyChunkCompressed = false;
+  ezTime entryDuration;
+
+  // the items are processed in batches to limit memory consumption, the results are always written in order
+  const ezUInt32 uiBatchSize = ezMath::Max(8u, 4u * ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks));
+
+  for (ezUInt32 uiBatchStart = 0; uiBatchStart < items.GetCount(); uiBatchStart += uiBatchSize)
+  {
+    ezArrayPtr<ezArchiveBuilderWorkItem> batch = items.GetArrayPtr().GetSubArray(uiBatchStart, ezMath::Min(uiBatchSize, items.GetCount() - uiBatchStart));
 
-    const ezUInt32 uiPathStringOffset = toc.AddPathString(e.m_sRelTargetPath);
+    ezTaskSystem::ParallelForSingle(
+      batch, [&](ezArchiveBuilderWorkItem& ref_item)
+      { ProcessWorkItem(ref_item, m_Entries[ref_item.m_uiEntry]); },
+      "ezArchiveBuilder::WriteArchive");
 
-    sHashablePath = e.m_sRelTargetPath;
-    sHashablePath.ToLower();
+    for (ezArchiveBuilderWorkItem& item : batch)
+    {
+      const SourceEntry& e = m_Entries[item.m_uiEntry];
 
-    toc.m_PathToEntryIndex[ezArchiveStoredString(ezHashingUtils::StringHash(sHashablePath), uiPathStringOffset)] = toc.m_Entries.GetCount();
+      if (item.m_uiChunk == 0)
+      {
+        const ezUInt32 uiPathStringOffset = toc.AddPathString(e.m_sRelTargetPath);
 
-    if (!WriteNextFileCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath))
-      return EZ_FAILURE;
+        sHashablePath = e.m_sRelTargetPath;
+        sHashablePath.ToLower();
+
+        toc.m_PathToEntryIndex[ezArchiveStoredString(ezHashingUtils::StringHash(sHashablePath), uiPathStringOffset)] = toc.m_Entries.GetCount();
+
+        if (!WriteNextFileCallback(item.m_uiEntry + 1, uiNumEntries, e.m_sAbsSourcePath))
+          return EZ_FAILURE;
+
+        ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+        tocEntry.m_uiPathStringOffset = uiPathStringOffset;
+        tocEntry.m_uiDataStartOffset = uiStreamSize;
+
+        chunkSizes.Clear();
+        bAnyChunkCompressed = false;
+        entryDuration = ezTime::MakeZero();
+      }
+
+      if (item.m_Result.Failed())
+        return EZ_FAILURE;
 
-    ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
+      ezArchiveEntry& tocEntry = toc.m_Entries.PeekBack();
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+      EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(item.m_Data.GetData(), item.m_Data.GetCount()));
 
-    WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
+      tocEntry.m_uiUncompressedDataSize += item.m_uiSourceSize;
+      tocEntry.m_uiStoredDataSize += item.m_Data.GetCount();
+      chunkSizes.PushBack(item.m_bCompressed ? item.m_Data.GetCount() : (item.m_Data.GetCount() | ezArchiveUtils::ArchiveChunkStoredUncompressedFlag));
+      bAnyChunkCompressed |= item.m_bCompressed;
+      entryDuration += item.m_Duration;
+
+      item.m_Data.Clear();
+      item.m_Data.Compact();
+
+      if (!WriteFileProgressCallback(item.m_uiSourceOffset + item.m_uiSourceSize, static_cast<ezUInt64>(item.m_uiNumChunks - 1) * ezArchiveUtils::ArchiveChunkSize + item.m_uiSourceSize))
+        return EZ_FAILURE;
+
+      if (item.m_uiChunk + 1 < item.m_uiNumChunks)
+        continue;
+
+      // all chunks of this entry are written, chunks that were stored uncompressed are identical to the source data
+      if (!bAnyChunkCompressed)
+      {
+        tocEntry.m_CompressionMode = ezArchiveCompressionMode::Uncompressed;
+      }
+      else if (item.m_uiNumChunks == 1)
+      {
+        tocEntry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+      }
+      else
+      {
+        tocEntry.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd_chunked;
+
+        for (ezUInt32 uiChunkSize : chunkSizes)
+        {
+          inout_stream << uiChunkSize;
+        }
+
+        inout_stream << ezArchiveUtils::ArchiveChunkSize;
+        inout_stream << chunkSizes.GetCount();
+
+        tocEntry.m_uiStoredDataSize += (chunkSizes.GetCount() + 2) * sizeof(ezUInt32);
+      }
+
+      uiStreamSize += tocEntry.m_uiStoredDataSize;
+
+      stats.m_uiUncompressedSize += tocEntry.m_uiUncompressedDataSize;
+      stats.m_uiStoredSize += tocEntry.m_uiStoredDataSize;
+      stats.m_ProcessingDuration += entryDuration;
+
+      WriteFileResultCallback(item.m_uiEntry + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, entryDuration);
+    }
   }
 
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::AppendTOC(inout_stream, toc));
 
+  stats.m_TotalDuration = sw.GetRunningTotal();
+  WriteArchiveResultCallback(stats);
+
   return EZ_SUCCESS;
 }
 
@@ -0,0 +1,174 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveChunkedReaderZstd.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+#  include <Foundation/IO/MemoryStream.h>
+#  include <Foundation/Logging/Log.h>
+#  include <zstd/zstd.h>
+
+ezArchiveChunkedReaderZstd::ezArchiveChunkedReaderZstd() = default;
+ezArchiveChunkedReaderZstd::~ezArchiveChunkedReaderZstd() = default;
+
+ezResult ezArchiveChunkedReaderZstd::SetInputStream(ezRawMemoryStreamReader* pInputStream, ezUInt64 uiUncompressedSize)
+{
+  // on failure the reader behaves like an empty stream
+  m_pInputStream = pInputStream;
+  m_uiUncompressedSize = 0;
+  m_uiReadPosition = 0;
+  m_uiChunkSize = 0;
+  m_uiLoadedChunk = ezInvalidIndex;
+  m_uiNumDecompressedChunks = 0;
+  m_ChunkSizes.Clear();
+  m_ChunkOffsets.Clear();
+
+  const ezUInt64 uiStoredSize = pInputStream->GetByteCount();
+
+  if (uiStoredSize < 2 * sizeof(ezUInt32))
+  {
+    ezLog::Error("Archive entry is corrupt. Missing chunk table.");
+    return EZ_FAILURE;
+  }
+
+  ezUInt32 uiChunkSize = 0;
+  ezUInt32 uiNumChunks = 0;
+
+  pInputStream->SetReadPosition(uiStoredSize - 2 * sizeof(ezUInt32));
+  *pInputStream >> uiChunkSize;
+  *pInputStream >> uiNumChunks;
+
+  const ezUInt64 uiTableSize = static_cast<ezUInt64>(uiNumChunks) * sizeof(ezUInt32) + 2 * sizeof(ezUInt32);
+
+  const bool bValidTable = uiChunkSize > 0 && uiTableSize <= uiStoredSize &&
+                           static_cast<ezUInt64>(uiNumChunks) * uiChunkSize >= uiUncompressedSize &&
+                           (uiNumChunks == 0 || static_cast<ezUInt64>(uiNumChunks - 1) * uiChunkSize < uiUncompressedSize);
+
+  if (!bValidTable)
+  {
+    ezLog::Error("Archive entry is corrupt. Invalid chunk table.");
+    return EZ_FAILURE;
+  }
+
+  pInputStream->SetReadPosition(uiStoredSize - uiTableSize);
+
+  m_ChunkSizes.SetCountUninitialized(uiNumChunks);
+  m_ChunkOffsets.SetCountUninitialized(uiNumChunks);
+
+  ezUInt64 uiOffset = 0;
+  for (ezUInt32 i = 0; i < uiNumChunks; ++i)
+  {
+    *pInputStream >> m_ChunkSizes[i];
+
+    m_ChunkOffsets[i] = uiOffset;
+    uiOffset += m_ChunkSizes[i] & ~ezArchiveUtils::ArchiveChunkStoredUncompressedFlag;
+  }
+
+  if (uiOffset + uiTableSize != uiStoredSize)
+  {
+    ezLog::Error("Archive entry is corrupt. Chunk sizes do not match the stored data.");
+    m_ChunkSizes.Clear();
+    m_ChunkOffsets.Clear();
+    return EZ_FAILURE;
+  }
+
+  m_uiChunkSize = uiChunkSize;
+  m_uiUncompressedSize = uiUncompressedSize;
+  return EZ_SUCCESS;
+}
+
+ezUInt64 ezArchiveChunkedReaderZstd::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  EZ_ASSERT_DEV(m_pInputStream != nullptr, "No input stream has been specified");
+
+  uiBytesToRead = ezMath::Min(uiBytesToRead, m_uiUncompressedSize - m_uiReadPosition);
+
+  ezUInt8* pWritePtr = static_cast<ezUInt8*>(pReadBuffer);
+  ezUInt64 uiBytesRead = 0;
+
+  while (uiBytesRead < uiBytesToRead)
+  {
+    const ezUInt32 uiChunk = static_cast<ezUInt32>(m_uiReadPosition / m_uiChunkSize);
+
+    if (LoadChunk(uiChunk).Failed())
+      break;
+
+    const ezUInt64 uiOffsetInChunk = m_uiReadPosition - static_cast<ezUInt64>(uiChunk) * m_uiChunkSize;
+    const ezUInt64 uiBytesFromChunk = ezMath::Min<ezUInt64>(uiBytesToRead - uiBytesRead, m_UncompressedChunk.GetCount() - uiOffsetInChunk);
+
+    if (pWritePtr != nullptr)
+    {
+      ezMemoryUtils::Copy(pWritePtr + uiBytesRead, m_UncompressedChunk.GetData() + uiOffsetInChunk, static_cast<size_t>(uiBytesFromChunk));
+    }
+
+    uiBytesRead += uiBytesFromChunk;
+    m_uiReadPosition += uiBytesFromChunk;
+  }
+
+  return uiBytesRead;
+}
+
+ezUInt64 ezArchiveChunkedReaderZstd::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  // chunks are only decompressed once data is actually read from them
+  uiBytesToSkip = ezMath::Min(uiBytesToSkip, m_uiUncompressedSize - m_uiReadPosition);
+  m_uiReadPosition += uiBytesToSkip;
+  return uiBytesToSkip;
+}
+
+void ezArchiveChunkedReaderZstd::SetReadPosition(ezUInt64 uiReadPosition)
+{
+  EZ_ASSERT_DEV(uiReadPosition <= m_uiUncompressedSize, "Read position {} is outside the data range ({} bytes)", uiReadPosition, m_uiUncompressedSize);
+  m_uiReadPosition = uiReadPosition;
+}
+
+ezResult ezArchiveChunkedReaderZstd::LoadChunk(ezUInt32 uiChunk)
+{
+  if (m_uiLoadedChunk == uiChunk)
+    return EZ_SUCCESS;
+
+  m_uiLoadedChunk = ezInvalidIndex;
+
+  if (uiChunk >= m_ChunkSizes.GetCount())
+    return EZ_FAILURE;
+
+  const ezUInt32 uiStoredSize = m_ChunkSizes[uiChunk] & ~ezArchiveUtils::ArchiveChunkStoredUncompressedFlag;
+  const bool bStoredUncompressed = (m_ChunkSizes[uiChunk] & ezArchiveUtils::ArchiveChunkStoredUncompressedFlag) != 0;
+  const ezUInt64 uiChunkStart = static_cast<ezUInt64>(uiChunk) * m_uiChunkSize;
+  const ezUInt32 uiUncompressedSize = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(m_uiChunkSize, m_uiUncompressedSize - uiChunkStart));
+
+  m_UncompressedChunk.SetCountUninitialized(uiUncompressedSize);
+  m_pInputStream->SetReadPosition(m_ChunkOffsets[uiChunk]);
+
+  if (bStoredUncompressed)
+  {
+    if (uiStoredSize != uiUncompressedSize || m_pInputStream->ReadBytes(m_UncompressedChunk.GetData(), uiStoredSize) != uiStoredSize)
+    {
+      ezLog::Error("Archive entry is corrupt. Invalid uncompressed chunk {}.", uiChunk);
+      return EZ_FAILURE;
+    }
+  }
+  else
+  {
+    m_StoredChunk.SetCountUninitialized(uiStoredSize);
+    if (m_pInputStream->ReadBytes(m_StoredChunk.GetData(), uiStoredSize) != uiStoredSize)
+    {
+      ezLog::Error("Archive entry is corrupt. Chunk {} is cut off.", uiChunk);
+      return EZ_FAILURE;
+    }
+
+    const size_t res = ZSTD_decompress(m_UncompressedChunk.GetData(), uiUncompressedSize, m_StoredChunk.GetData(), uiStoredSize);
+    if (ZSTD_isError(res) || res != uiUncompressedSize)
+    {
+      ezLog::Error("Archive entry is corrupt. Decompressing chunk {} failed: '{}'", uiChunk, ZSTD_isError(res) ? ZSTD_getErrorName(res) : "size mismatch");
+      return EZ_FAILURE;
+    }
+
+    ++m_uiNumDecompressedChunks;
+  }
+
+  m_uiLoadedChunk = uiChunk;
+  return EZ_SUCCESS;
+}
+
+#endif
@@ -71,7 +71,8 @@ ezResult ezArchiveReader::OpenArchive(ezStringView sPath)
         return EZ_FAILURE;
       }
 
-      if (e.m_uiUncompressedDataSize < e.m_uiStoredDataSize)
+      // chunked entries carry a seek table, the chunk reader validates their sizes itself
+      if (e.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_chunked && e.m_uiUncompressedDataSize < e.m_uiStoredDataSize)
       {
         ezLog::Error("Archive is corrupt. Invalid compression info.");
         return EZ_FAILURE;
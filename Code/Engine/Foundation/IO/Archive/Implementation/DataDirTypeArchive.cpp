@@ -93,6 +93,21 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
         }
         break;
       }
+
+      case ezArchiveCompressionMode::Compressed_zstd_chunked:
+      {
+        if (!m_FreeReadersZstdChunked.IsEmpty())
+        {
+          pReader = m_FreeReadersZstdChunked.PeekBack();
+          m_FreeReadersZstdChunked.PopBack();
+        }
+        else
+        {
+          m_ReadersZstdChunked.PushBack(EZ_DEFAULT_NEW(ArchiveReaderZstdChunked, 3));
+          pReader = m_ReadersZstdChunked.PeekBack().Borrow();
+        }
+        break;
+      }
 #endif
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
       case ezArchiveCompressionMode::Compressed_zip:
@@ -255,6 +270,12 @@ void ezDataDirectory::ArchiveType::OnReaderWriterClose(ezDataDirectoryReaderWrit
     m_FreeReadersZstd.PushBack(static_cast<ArchiveReaderZstd*>(pClosed));
     return;
   }
+
+  if (pClosed->GetDataDirUserData() == 3)
+  {
+    m_FreeReadersZstdChunked.PushBack(static_cast<ArchiveReaderZstdChunked*>(pClosed));
+    return;
+  }
 #endif
 
 #ifdef BUILDSYSTEM_ENABLE_ZLIB_SUPPORT
@@ -338,6 +359,38 @@ void ezDataDirectory::ArchiveReaderZstd::InternalClose()
 {
   // nothing to do
 }
+
+//////////////////////////////////////////////////////////////////////////
+
+ezDataDirectory::ArchiveReaderZstdChunked::ArchiveReaderZstdChunked(ezInt32 iDataDirUserData)
+  : ArchiveReaderCommon(iDataDirUserData)
+{
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdChunked::Skip(ezUInt64 uiBytes)
+{
+  return m_ChunkedStreamReader.SkipBytes(uiBytes);
+}
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdChunked::Read(void* pBuffer, ezUInt64 uiBytes)
+{
+  return m_ChunkedStreamReader.ReadBytes(pBuffer, uiBytes);
+}
+
+ezResult ezDataDirectory::ArchiveReaderZstdChunked::InternalOpen(ezFileShareMode::Enum FileShareMode)
+{
+  EZ_IGNORE_UNUSED(FileShareMode);
+  EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
+
+  // a corrupt seek table is logged and makes the reader behave like an empty file
+  m_ChunkedStreamReader.SetInputStream(&m_MemStreamReader, m_uiUncompressedSize).IgnoreResult();
+  return EZ_SUCCESS;
+}
+
+void ezDataDirectory::ArchiveReaderZstdChunked::InternalClose()
+{
+  // nothing to do
+}
 #endif
 
 //////////////////////////////////////////////////////////////////////////
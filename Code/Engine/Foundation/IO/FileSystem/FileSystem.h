@@ -244,6 +244,14 @@ public:
   /// \brief Returns true, if any data directory knows how to redirect the given path. Otherwise the original string is returned in out_sRedirection.
   static bool ResolveAssetRedirection(ezStringView sPathOrAssetGuid, ezStringBuilder& out_sRedirection);
 
+  /// \brief Tells the data directories that the given files are likely going to be read soon.
+  ///
+  /// The paths are treated like in GetFileReader(), ie. they may be rooted, relative or asset GUIDs, which the data directories resolve themselves.
+  /// This is only a hint. For regular folders nothing happens, but data directories that have to fetch files over the network
+  /// can fetch all of them in one batch, instead of paying for one round trip per file later.
+  /// Other threads can keep accessing the file system while the data directories wait for the files.
+  static void PrefetchFiles(ezArrayPtr<const ezString> files);
+
   /// \brief Migrates a file from an old location to a new one, and returns the path that should be used to open it (either the old or the new path).
   ///
   /// If the file does not exist in the old location, nothing is done, and the new location is returned.
@@ -108,6 +108,17 @@ protected:
     return false;
   }
 
+  /// \brief Called by ezFileSystem::PrefetchFiles() with files that are likely going to be read soon.
+  ///
+  /// Data directories that have to fetch files from somewhere else can use this to fetch all of them in one batch.
+  /// If \a bOneSpecificDataDir is false, the files may also end up being read from another data directory.
+  /// The default implementation does nothing.
+  virtual void PrefetchFiles(ezArrayPtr<const ezString> files, bool bOneSpecificDataDir)
+  {
+    EZ_IGNORE_UNUSED(files);
+    EZ_IGNORE_UNUSED(bOneSpecificDataDir);
+  }
+
 protected:
   friend class ezDataDirectoryReaderWriterBase;
 
@@ -797,6 +797,65 @@ bool ezFileSystem::ResolveAssetRedirection(ezStringView sPathOrAssetGuid, ezStri
   return false;
 }
 
+void ezFileSystem::PrefetchFiles(ezArrayPtr<const ezString> files)
+{
+  EZ_ASSERT_DEV(s_pData != nullptr, "FileSystem is not initialized.");
+
+  // per data directory, the files that may be found in any data directory and the ones that were requested from exactly this one
+  ezHybridArray<ezDataDirectoryType*, 16> dataDirs;
+  ezHybridArray<ezDynamicArray<ezString>, 16> anyDataDirFiles;
+  ezHybridArray<ezDynamicArray<ezString>, 16> specificDataDirFiles;
+
+  {
+    EZ_LOCK(s_pData->m_FsMutex);
+
+    const ezUInt32 uiNumDataDirs = s_pData->m_DataDirectories.GetCount();
+    dataDirs.SetCount(uiNumDataDirs);
+    anyDataDirFiles.SetCount(uiNumDataDirs);
+    specificDataDirFiles.SetCount(uiNumDataDirs);
+
+    for (ezUInt32 i = 0; i < uiNumDataDirs; ++i)
+    {
+      dataDirs[i] = s_pData->m_DataDirectories[i].m_pDataDirType;
+    }
+
+    ezStringBuilder sPath;
+    ezString sRootName;
+
+    for (const ezString& sFile : files)
+    {
+      sPath = ExtractRootName(sFile, sRootName);
+      sPath.MakeCleanPath();
+
+      const bool bOneSpecificDataDir = !sRootName.IsEmpty();
+
+      for (ezUInt32 i = 0; i < uiNumDataDirs; ++i)
+      {
+        if (bOneSpecificDataDir && s_pData->m_DataDirectories[i].m_sRootName != sRootName)
+          continue;
+
+        ezDynamicArray<ezString>& dataDirFiles = bOneSpecificDataDir ? specificDataDirFiles[i] : anyDataDirFiles[i];
+        dataDirFiles.PushBack(GetDataDirRelativePath(sPath, i));
+      }
+    }
+  }
+
+  // the data directories may wait for the network here, which must not block all other file accesses in the mean time
+  // just like for open files, the data directories must not be removed while this is running
+  for (ezUInt32 i = 0; i < dataDirs.GetCount(); ++i)
+  {
+    if (!anyDataDirFiles[i].IsEmpty())
+    {
+      dataDirs[i]->PrefetchFiles(anyDataDirFiles[i], false);
+    }
+
+    if (!specificDataDirFiles[i].IsEmpty())
+    {
+      dataDirs[i]->PrefetchFiles(specificDataDirFiles[i], true);
+    }
+  }
+}
+
 ezStringView ezFileSystem::MigrateFileLocation(ezStringView sOldLocation, ezStringView sNewLocation)
 {
   ezStringBuilder sOldPathFull, sNewPathFull;
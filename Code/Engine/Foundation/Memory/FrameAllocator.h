@@ -1,6 +1,21 @@
 #pragma once
 
 #include <Foundation/Memory/LinearAllocator.h>
+#include <Foundation/Memory/ThreadLocalLinearAllocator.h>
+
+/// \brief Selects how an ezDoubleBufferedLinearAllocator hands out memory.
+struct ezLinearAllocatorMode
+{
+  using StorageType = ezUInt8;
+
+  enum Enum : StorageType
+  {
+    Shared,      ///< One ezLinearAllocator per buffer, every allocation is protected by a mutex.
+    ThreadLocal, ///< One ezThreadLocalLinearAllocator per buffer, every thread allocates from its own pages without any locking.
+
+    Default = Shared
+  };
+};
 
 /// \brief A double buffered stack allocator
 class EZ_FOUNDATION_DLL ezDoubleBufferedLinearAllocator
@@ -13,17 +28,22 @@ public:
 #endif
   using StackAllocatorType = ezLinearAllocator<ezAllocatorTrackingMode::Basics, OverwriteMemoryOnReset>;
 
-  ezDoubleBufferedLinearAllocator(ezStringView sName, ezAllocator* pParent);
+  ezDoubleBufferedLinearAllocator(ezStringView sName, ezAllocator* pParent, ezLinearAllocatorMode::Enum mode = ezLinearAllocatorMode::Default);
   ~ezDoubleBufferedLinearAllocator();
 
   EZ_ALWAYS_INLINE ezAllocator* GetCurrentAllocator() const { return m_pCurrentAllocator; }
 
+  EZ_ALWAYS_INLINE ezLinearAllocatorMode::Enum GetMode() const { return m_Mode; }
+
   void Swap();
   void Reset();
 
 private:
-  StackAllocatorType* m_pCurrentAllocator;
-  StackAllocatorType* m_pOtherAllocator;
+  void ResetAllocator(ezAllocator* pAllocator);
+
+  ezLinearAllocatorMode::Enum m_Mode;
+  ezAllocator* m_pCurrentAllocator;
+  ezAllocator* m_pOtherAllocator;
 };
 
 class EZ_FOUNDATION_DLL ezFrameAllocator
@@ -34,6 +54,12 @@ public:
   static void Swap();
   static void Reset();
 
+  /// \brief Switches between a mutex protected and a thread local allocator. Uses ezLinearAllocatorMode::Shared by default.
+  ///
+  /// This recreates the underlying allocators, so it must only be called when no memory from the frame allocator is in use anymore.
+  static void SetMode(ezLinearAllocatorMode::Enum mode);
+  static ezLinearAllocatorMode::Enum GetMode();
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, FrameAllocator);
 
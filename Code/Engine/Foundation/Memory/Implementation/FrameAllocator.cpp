@@ -5,17 +5,26 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Strings/StringBuilder.h>
 
-ezDoubleBufferedLinearAllocator::ezDoubleBufferedLinearAllocator(ezStringView sName0, ezAllocator* pParent)
+ezDoubleBufferedLinearAllocator::ezDoubleBufferedLinearAllocator(ezStringView sName0, ezAllocator* pParent, ezLinearAllocatorMode::Enum mode)
+  : m_Mode(mode)
 {
+  auto CreateAllocator = [&](ezStringView sName) -> ezAllocator*
+  {
+    if (m_Mode == ezLinearAllocatorMode::ThreadLocal)
+      return EZ_DEFAULT_NEW(ezThreadLocalLinearAllocator, sName, pParent);
+
+    return EZ_DEFAULT_NEW(StackAllocatorType, sName, pParent);
+  };
+
   ezStringBuilder sName = sName0;
   sName.Append("0");
 
-  m_pCurrentAllocator = EZ_DEFAULT_NEW(StackAllocatorType, sName, pParent);
+  m_pCurrentAllocator = CreateAllocator(sName);
 
   sName = sName0;
   sName.Append("1");
 
-  m_pOtherAllocator = EZ_DEFAULT_NEW(StackAllocatorType, sName, pParent);
+  m_pOtherAllocator = CreateAllocator(sName);
 }
 
 ezDoubleBufferedLinearAllocator::~ezDoubleBufferedLinearAllocator()
@@ -28,13 +37,25 @@ void ezDoubleBufferedLinearAllocator::Swap()
 {
   ezMath::Swap(m_pCurrentAllocator, m_pOtherAllocator);
 
-  m_pCurrentAllocator->Reset();
+  ResetAllocator(m_pCurrentAllocator);
 }
 
 void ezDoubleBufferedLinearAllocator::Reset()
 {
-  m_pCurrentAllocator->Reset();
-  m_pOtherAllocator->Reset();
+  ResetAllocator(m_pCurrentAllocator);
+  ResetAllocator(m_pOtherAllocator);
+}
+
+void ezDoubleBufferedLinearAllocator::ResetAllocator(ezAllocator* pAllocator)
+{
+  if (m_Mode == ezLinearAllocatorMode::ThreadLocal)
+  {
+    static_cast<ezThreadLocalLinearAllocator*>(pAllocator)->Reset();
+  }
+  else
+  {
+    static_cast<StackAllocatorType*>(pAllocator)->Reset();
+  }
 }
 
 
@@ -73,6 +94,22 @@ void ezFrameAllocator::Reset()
   }
 }
 
+// static
+void ezFrameAllocator::SetMode(ezLinearAllocatorMode::Enum mode)
+{
+  if (s_pAllocator == nullptr || s_pAllocator->GetMode() == mode)
+    return;
+
+  EZ_DEFAULT_DELETE(s_pAllocator);
+  s_pAllocator = EZ_DEFAULT_NEW(ezDoubleBufferedLinearAllocator, "FrameAllocator", ezFoundation::GetAlignedAllocator(), mode);
+}
+
+// static
+ezLinearAllocatorMode::Enum ezFrameAllocator::GetMode()
+{
+  return s_pAllocator != nullptr ? s_pAllocator->GetMode() : ezLinearAllocatorMode::Default;
+}
+
 // static
 void ezFrameAllocator::Startup()
 {
@@ -7,6 +7,7 @@
 #include <Foundation/Memory/Policies/AllocPolicyHeap.h>
 #include <Foundation/Strings/String.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/AtomicInteger.h>
 #include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/Mutex.h>
 
@@ -37,6 +38,30 @@ namespace
     EZ_ALWAYS_INLINE static ezAllocator* GetAllocator() { return s_pTrackerDataAllocator; }
   };
 
+  using AllocationTable = ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper>;
+
+  /// The stats of an allocator are split into several stripes. Each thread only updates one of them, so threads that allocate from the
+  /// same allocator don't fight over the same cache line. The stripes are summed up when the stats are read.
+  /// The tracker data allocator can't guarantee more than the default alignment, so the stripes are padded to the size of a cache line instead.
+  struct StatsStripe
+  {
+    ezAtomicInteger64 m_iNumAllocations;
+    ezAtomicInteger64 m_iNumDeallocations;
+    ezAtomicInteger64 m_iAllocationSize; ///< Can become negative in a single stripe, when memory is freed on another thread than it was allocated on.
+    ezAtomicInteger64 m_iPerFrameAllocationSize;
+    ezAtomicInteger64 m_iPerFrameAllocationTimeNS;
+    ezUInt8 m_Padding[64 - 5 * sizeof(ezAtomicInteger64)];
+  };
+
+  /// The live allocations of an allocator are distributed over several tables by their address, each with its own lock.
+  struct AllocationShard
+  {
+    ezMutex m_Mutex;
+    AllocationTable m_Allocations;
+  };
+
+  static constexpr ezUInt32 s_uiNumStatsStripes = 8;
+  static constexpr ezUInt32 s_uiNumAllocationShards = 16;
 
   struct AllocatorData
   {
@@ -47,9 +72,72 @@ namespace
 
     ezAllocatorId m_ParentId;
 
-    ezAllocator::Stats m_Stats;
+    StatsStripe m_Stats[s_uiNumStatsStripes];
+    AllocationShard m_Shards[s_uiNumAllocationShards];
+
+    EZ_ALWAYS_INLINE AllocationShard& GetShard(const void* pPtr)
+    {
+      // allocations are at least 8 byte aligned, mix the remaining bits so that neighboring allocations end up in different shards
+      const ezUInt64 uiHash = (reinterpret_cast<size_t>(pPtr) >> 3) * 0x9E3779B97F4A7C15ull;
+      return m_Shards[uiHash >> (64 - 4)];
+    }
+
+    ezAllocator::Stats GetStats() const
+    {
+      ezInt64 iNumAllocations = 0;
+      ezInt64 iNumDeallocations = 0;
+      ezInt64 iAllocationSize = 0;
+      ezInt64 iPerFrameAllocationSize = 0;
+      ezInt64 iPerFrameAllocationTimeNS = 0;
+
+      for (const StatsStripe& stripe : m_Stats)
+      {
+        iNumAllocations += stripe.m_iNumAllocations;
+        iNumDeallocations += stripe.m_iNumDeallocations;
+        iAllocationSize += stripe.m_iAllocationSize;
+        iPerFrameAllocationSize += stripe.m_iPerFrameAllocationSize;
+        iPerFrameAllocationTimeNS += stripe.m_iPerFrameAllocationTimeNS;
+      }
+
+      // the stripes are read without locking, so while other threads allocate and free, a deallocation may already be counted
+      // while its allocation is not yet, don't let such a snapshot wrap around to a huge unsigned value
+      ezAllocator::Stats stats;
+      stats.m_uiNumAllocations = static_cast<ezUInt64>(ezMath::Max<ezInt64>(iNumAllocations, 0));
+      stats.m_uiNumDeallocations = static_cast<ezUInt64>(ezMath::Max<ezInt64>(iNumDeallocations, 0));
+      stats.m_uiAllocationSize = static_cast<ezUInt64>(ezMath::Max<ezInt64>(iAllocationSize, 0));
+      stats.m_uiPerFrameAllocationSize = static_cast<ezUInt64>(ezMath::Max<ezInt64>(iPerFrameAllocationSize, 0));
+      stats.m_PerFrameAllocationTime = ezTime::MakeFromNanoseconds(static_cast<double>(ezMath::Max<ezInt64>(iPerFrameAllocationTimeNS, 0)));
+      return stats;
+    }
+
+    void SetStats(const ezAllocator::Stats& stats)
+    {
+      for (StatsStripe& stripe : m_Stats)
+      {
+        stripe.m_iNumAllocations = 0;
+        stripe.m_iNumDeallocations = 0;
+        stripe.m_iAllocationSize = 0;
+        stripe.m_iPerFrameAllocationSize = 0;
+        stripe.m_iPerFrameAllocationTimeNS = 0;
+      }
+
+      m_Stats[0].m_iNumAllocations = static_cast<ezInt64>(stats.m_uiNumAllocations);
+      m_Stats[0].m_iNumDeallocations = static_cast<ezInt64>(stats.m_uiNumDeallocations);
+      m_Stats[0].m_iAllocationSize = static_cast<ezInt64>(stats.m_uiAllocationSize);
+      m_Stats[0].m_iPerFrameAllocationSize = static_cast<ezInt64>(stats.m_uiPerFrameAllocationSize);
+      m_Stats[0].m_iPerFrameAllocationTimeNS = static_cast<ezInt64>(stats.m_PerFrameAllocationTime.GetNanoseconds());
+    }
 
-    ezHashTable<const void*, ezMemoryTracker::AllocationInfo, ezHashHelper<const void*>, TrackerDataAllocatorWrapper> m_Allocations;
+    ezUInt32 GetNumAllocations()
+    {
+      ezUInt32 uiNumAllocations = 0;
+      for (AllocationShard& shard : m_Shards)
+      {
+        EZ_LOCK(shard.m_Mutex);
+        uiNumAllocations += shard.m_Allocations.GetCount();
+      }
+      return uiNumAllocations;
+    }
   };
 
   struct TrackerData
@@ -59,7 +147,7 @@ namespace
 
     ezMutex m_Mutex;
 
-    using AllocatorTable = ezIdTable<ezAllocatorId, AllocatorData, TrackerDataAllocatorWrapper>;
+    using AllocatorTable = ezIdTable<ezAllocatorId, AllocatorData*, TrackerDataAllocatorWrapper>;
     AllocatorTable m_AllocatorData;
   };
 
@@ -67,6 +155,17 @@ namespace
   static bool s_bIsInitialized = false;
   static bool s_bIsInitializing = false;
 
+  // Maps the instance index of an allocator id to its data without taking the tracker lock.
+  // The pages are only added and removed while holding the lock. A page is freed once the last allocator in it is deregistered,
+  // nobody can look it up anymore at that point.
+  static constexpr ezUInt32 s_uiAllocatorLookupPageSize = 1024;
+  static constexpr ezUInt32 s_uiNumAllocatorLookupPages = (1u << 24) / s_uiAllocatorLookupPageSize;
+  static AllocatorData** s_AllocatorLookupPages[s_uiNumAllocatorLookupPages];
+  static ezUInt16 s_AllocatorLookupPageUseCount[s_uiNumAllocatorLookupPages];
+
+  static ezAtomicInteger32 s_iNextStatsStripe;
+  static ezUInt32 s_uiStackTraceSamplingInterval = 512 * 1024;
+
   static void Initialize()
   {
     if (s_bIsInitialized)
@@ -93,6 +192,54 @@ namespace
     s_bIsInitializing = false;
   }
 
+  EZ_ALWAYS_INLINE AllocatorData*& GetAllocatorLookupEntry(ezAllocatorId allocatorId)
+  {
+    const ezUInt32 uiIndex = allocatorId.m_InstanceIndex;
+    return s_AllocatorLookupPages[uiIndex / s_uiAllocatorLookupPageSize][uiIndex % s_uiAllocatorLookupPageSize];
+  }
+
+  EZ_ALWAYS_INLINE AllocatorData& GetAllocatorData(ezAllocatorId allocatorId)
+  {
+    AllocatorData* pData = GetAllocatorLookupEntry(allocatorId);
+    EZ_ASSERT_DEBUG(pData != nullptr, "Invalid allocator id");
+    return *pData;
+  }
+
+  EZ_ALWAYS_INLINE StatsStripe& GetStatsStripe(AllocatorData& ref_data)
+  {
+    static thread_local ezUInt32 s_uiStripe = static_cast<ezUInt32>(s_iNextStatsStripe.PostIncrement()) % s_uiNumStatsStripes;
+    return ref_data.m_Stats[s_uiStripe];
+  }
+
+  /// \brief Decides whether an allocation gets a stack trace in the sampling mode.
+  ///
+  /// Like a sampling heap profiler, every thread counts down the allocated bytes and picks the allocation that crosses zero.
+  /// The distance to the next sample is randomized, so allocation patterns that repeat with a fixed size don't get over- or under-sampled.
+  static bool ShouldSampleAllocation(size_t uiSize)
+  {
+    static thread_local ezUInt32 s_uiRandomState = 0;
+    static thread_local ezInt64 s_iBytesUntilNextSample = -1;
+
+    s_iBytesUntilNextSample -= static_cast<ezInt64>(uiSize);
+    if (s_iBytesUntilNextSample >= 0)
+      return false;
+
+    if (s_uiRandomState == 0)
+    {
+      s_uiRandomState = static_cast<ezUInt32>(reinterpret_cast<size_t>(&s_uiRandomState)) | 1u;
+    }
+
+    // xorshift, uniformly distributed in [0; 2 * interval), so on average every 'interval' bytes one allocation is sampled
+    s_uiRandomState ^= s_uiRandomState << 13;
+    s_uiRandomState ^= s_uiRandomState >> 17;
+    s_uiRandomState ^= s_uiRandomState << 5;
+
+    const ezUInt64 uiInterval = ezMath::Max(s_uiStackTraceSamplingInterval, 1u);
+    s_iBytesUntilNextSample = static_cast<ezInt64>(s_uiRandomState % (2 * uiInterval));
+
+    return true;
+  }
+
   static void DumpLeak(const ezMemoryTracker::AllocationInfo& info, const char* szAllocatorName)
   {
     char szBuffer[512];
@@ -120,17 +267,17 @@ ezAllocatorId ezMemoryTracker::Iterator::Id() const
 
 ezStringView ezMemoryTracker::Iterator::Name() const
 {
-  return CAST_ITER(m_pData)->Value().m_sName;
+  return CAST_ITER(m_pData)->Value()->m_sName;
 }
 
 ezAllocatorId ezMemoryTracker::Iterator::ParentId() const
 {
-  return CAST_ITER(m_pData)->Value().m_ParentId;
+  return CAST_ITER(m_pData)->Value()->m_ParentId;
 }
 
-const ezAllocator::Stats& ezMemoryTracker::Iterator::Stats() const
+ezAllocator::Stats ezMemoryTracker::Iterator::Stats() const
 {
-  return CAST_ITER(m_pData)->Value().m_Stats;
+  return CAST_ITER(m_pData)->Value()->GetStats();
 }
 
 void ezMemoryTracker::Iterator::Next()
@@ -158,12 +305,26 @@ ezAllocatorId ezMemoryTracker::RegisterAllocator(ezStringView sName, ezAllocator
 
   EZ_LOCK(*s_pTrackerData);
 
-  AllocatorData data;
-  data.m_sName = sName;
-  data.m_TrackingMode = mode;
-  data.m_ParentId = parentId;
+  AllocatorData* pData = EZ_NEW(s_pTrackerDataAllocator, AllocatorData);
+  pData->m_sName = sName;
+  pData->m_TrackingMode = mode;
+  pData->m_ParentId = parentId;
+
+  const ezAllocatorId id = s_pTrackerData->m_AllocatorData.Insert(pData);
+
+  const ezUInt32 uiPageIndex = id.m_InstanceIndex / s_uiAllocatorLookupPageSize;
+
+  AllocatorData**& pPage = s_AllocatorLookupPages[uiPageIndex];
+  if (pPage == nullptr)
+  {
+    pPage = EZ_NEW_RAW_BUFFER(s_pTrackerDataAllocator, AllocatorData*, s_uiAllocatorLookupPageSize);
+    ezMemoryUtils::ZeroFill(pPage, s_uiAllocatorLookupPageSize);
+  }
 
-  return s_pTrackerData->m_AllocatorData.Insert(data);
+  GetAllocatorLookupEntry(id) = pData;
+  ++s_AllocatorLookupPageUseCount[uiPageIndex];
+
+  return id;
 }
 
 // static
@@ -171,20 +332,32 @@ void ezMemoryTracker::DeregisterAllocator(ezAllocatorId allocatorId)
 {
   EZ_LOCK(*s_pTrackerData);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  AllocatorData* pData = s_pTrackerData->m_AllocatorData[allocatorId];
 
-  ezUInt32 uiLiveAllocations = data.m_Allocations.GetCount();
-  if (uiLiveAllocations != 0 && data.m_TrackingMode > ezAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
+  ezUInt32 uiLiveAllocations = pData->GetNumAllocations();
+  if (uiLiveAllocations != 0 && pData->m_TrackingMode > ezAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
   {
-    for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+    for (const AllocationShard& shard : pData->m_Shards)
     {
-      DumpLeak(it.Value(), data.m_sName.GetData());
+      for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
+      {
+        DumpLeak(it.Value(), pData->m_sName.GetData());
+      }
     }
 
-    EZ_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", data.m_sName.GetData(), uiLiveAllocations);
+    EZ_REPORT_FAILURE("Allocator '{0}' leaked {1} allocation(s)", pData->m_sName.GetData(), uiLiveAllocations);
   }
 
+  GetAllocatorLookupEntry(allocatorId) = nullptr;
   s_pTrackerData->m_AllocatorData.Remove(allocatorId);
+
+  const ezUInt32 uiPageIndex = allocatorId.m_InstanceIndex / s_uiAllocatorLookupPageSize;
+  if (--s_AllocatorLookupPageUseCount[uiPageIndex] == 0)
+  {
+    EZ_DELETE_RAW_BUFFER(s_pTrackerDataAllocator, s_AllocatorLookupPages[uiPageIndex]);
+  }
+
+  EZ_DELETE(s_pTrackerDataAllocator, pData);
 }
 
 // static
@@ -193,7 +366,8 @@ void ezMemoryTracker::AddAllocation(ezAllocatorId allocatorId, ezAllocatorTracki
   EZ_ASSERT_DEV(uiAlign < 0xFFFF, "Alignment too big");
 
   ezArrayPtr<void*> stackTrace;
-  if (mode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces)
+  if (mode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces ||
+      (mode == ezAllocatorTrackingMode::AllocationStatsAndSampledStacktraces && ShouldSampleAllocation(uiSize)))
   {
     void* pBuffer[64];
     ezArrayPtr<void*> tempTrace(pBuffer);
@@ -203,106 +377,108 @@ void ezMemoryTracker::AddAllocation(ezAllocatorId allocatorId, ezAllocatorTracki
     ezMemoryUtils::Copy(stackTrace.GetPtr(), pBuffer, uiNumTraces);
   }
 
-  {
-    EZ_LOCK(*s_pTrackerData);
+  AllocatorData& data = GetAllocatorData(allocatorId);
+
+  StatsStripe& stats = GetStatsStripe(data);
+  stats.m_iNumAllocations.Increment();
+  stats.m_iAllocationSize.Add(static_cast<ezInt64>(uiSize));
+  stats.m_iPerFrameAllocationSize.Add(static_cast<ezInt64>(uiSize));
+  stats.m_iPerFrameAllocationTimeNS.Add(static_cast<ezInt64>(allocationTime.GetNanoseconds()));
 
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-    data.m_Stats.m_uiNumAllocations++;
-    data.m_Stats.m_uiAllocationSize += uiSize;
-    data.m_Stats.m_uiPerFrameAllocationSize += uiSize;
-    data.m_Stats.m_PerFrameAllocationTime += allocationTime;
+  {
+    AllocationShard& shard = data.GetShard(pPtr);
+    EZ_LOCK(shard.m_Mutex);
 
-    auto pInfo = &data.m_Allocations[pPtr];
+    auto pInfo = &shard.m_Allocations[pPtr];
     pInfo->m_uiSize = uiSize;
     pInfo->m_uiAlignment = (ezUInt16)uiAlign;
     pInfo->SetStackTrace(stackTrace);
+  }
 
-    if (mode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces)
-    {
-      EZ_TRACY_ALLOC_CS(pPtr, uiSize, data.m_sName.GetData());
-    }
-    else
-    {
-      EZ_TRACY_ALLOC(pPtr, uiSize, data.m_sName.GetData());
-    }
+  if (mode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces)
+  {
+    EZ_TRACY_ALLOC_CS(pPtr, uiSize, data.m_sName.GetData());
+  }
+  else
+  {
+    EZ_TRACY_ALLOC(pPtr, uiSize, data.m_sName.GetData());
   }
 }
 
 // static
 void ezMemoryTracker::RemoveAllocation(ezAllocatorId allocatorId, const void* pPtr)
 {
-  ezArrayPtr<void*> stackTrace;
+  AllocatorData& data = GetAllocatorData(allocatorId);
 
-  {
-    EZ_LOCK(*s_pTrackerData);
+  AllocationInfo info;
+  bool bFound = false;
 
-    AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
+  {
+    AllocationShard& shard = data.GetShard(pPtr);
+    EZ_LOCK(shard.m_Mutex);
 
-    AllocationInfo info;
-    if (data.m_Allocations.Remove(pPtr, &info))
-    {
-      data.m_Stats.m_uiNumDeallocations++;
-      data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    bFound = shard.m_Allocations.Remove(pPtr, &info);
+  }
 
-      stackTrace = info.GetStackTrace();
+  if (bFound)
+  {
+    StatsStripe& stats = GetStatsStripe(data);
+    stats.m_iNumDeallocations.Increment();
+    stats.m_iAllocationSize.Subtract(static_cast<ezInt64>(info.m_uiSize));
 
-      if (data.m_TrackingMode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces)
-      {
-        EZ_TRACY_FREE_CS(pPtr, data.m_sName.GetData());
-      }
-      else
-      {
-        EZ_TRACY_FREE(pPtr, data.m_sName.GetData());
-      }
+    if (data.m_TrackingMode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces)
+    {
+      EZ_TRACY_FREE_CS(pPtr, data.m_sName.GetData());
     }
     else
     {
-      EZ_REPORT_FAILURE("Invalid Allocation '{0}'. Memory corruption?", ezArgP(pPtr));
+      EZ_TRACY_FREE(pPtr, data.m_sName.GetData());
     }
-  }
 
-  EZ_DELETE_ARRAY(s_pTrackerDataAllocator, stackTrace);
+    EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+  }
+  else
+  {
+    EZ_REPORT_FAILURE("Invalid Allocation '{0}'. Memory corruption?", ezArgP(pPtr));
+  }
 }
 
 // static
 void ezMemoryTracker::RemoveAllAllocations(ezAllocatorId allocatorId)
 {
-  EZ_LOCK(*s_pTrackerData);
-  AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
-  for (auto it = data.m_Allocations.GetIterator(); it.IsValid(); ++it)
+  AllocatorData& data = GetAllocatorData(allocatorId);
+  StatsStripe& stats = GetStatsStripe(data);
+
+  for (AllocationShard& shard : data.m_Shards)
   {
-    auto& info = it.Value();
-    data.m_Stats.m_uiNumDeallocations++;
-    data.m_Stats.m_uiAllocationSize -= info.m_uiSize;
+    EZ_LOCK(shard.m_Mutex);
 
-    if (data.m_TrackingMode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces)
+    for (auto it = shard.m_Allocations.GetIterator(); it.IsValid(); ++it)
     {
-      for (const auto& alloc : data.m_Allocations)
+      auto& info = it.Value();
+      stats.m_iNumDeallocations.Increment();
+      stats.m_iAllocationSize.Subtract(static_cast<ezInt64>(info.m_uiSize));
+
+      if (data.m_TrackingMode >= ezAllocatorTrackingMode::AllocationStatsAndStacktraces)
       {
-        EZ_IGNORE_UNUSED(alloc);
-        EZ_TRACY_FREE_CS(alloc.Key(), data.m_sName.GetData());
+        EZ_TRACY_FREE_CS(it.Key(), data.m_sName.GetData());
       }
-    }
-    else
-    {
-      for (const auto& alloc : data.m_Allocations)
+      else
       {
-        EZ_IGNORE_UNUSED(alloc);
-        EZ_TRACY_FREE(alloc.Key(), data.m_sName.GetData());
+        EZ_TRACY_FREE(it.Key(), data.m_sName.GetData());
       }
+
+      EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
     }
 
-    EZ_DELETE_ARRAY(s_pTrackerDataAllocator, info.GetStackTrace());
+    shard.m_Allocations.Clear();
   }
-  data.m_Allocations.Clear();
 }
 
 // static
 void ezMemoryTracker::SetAllocatorStats(ezAllocatorId allocatorId, const ezAllocator::Stats& stats)
 {
-  EZ_LOCK(*s_pTrackerData);
-
-  s_pTrackerData->m_AllocatorData[allocatorId].m_Stats = stats;
+  GetAllocatorData(allocatorId).SetStats(stats);
 }
 
 // static
@@ -312,44 +488,52 @@ void ezMemoryTracker::ResetPerFrameAllocatorStats()
 
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    AllocatorData& data = it.Value();
-    data.m_Stats.m_uiPerFrameAllocationSize = 0;
-    data.m_Stats.m_PerFrameAllocationTime = ezTime::MakeZero();
+    for (StatsStripe& stripe : it.Value()->m_Stats)
+    {
+      stripe.m_iPerFrameAllocationSize = 0;
+      stripe.m_iPerFrameAllocationTimeNS = 0;
+    }
   }
 }
 
 // static
-ezStringView ezMemoryTracker::GetAllocatorName(ezAllocatorId allocatorId)
+void ezMemoryTracker::SetStackTraceSamplingInterval(ezUInt32 uiBytes)
 {
-  EZ_LOCK(*s_pTrackerData);
+  s_uiStackTraceSamplingInterval = uiBytes;
+}
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_sName;
+// static
+ezUInt32 ezMemoryTracker::GetStackTraceSamplingInterval()
+{
+  return s_uiStackTraceSamplingInterval;
 }
 
 // static
-const ezAllocator::Stats& ezMemoryTracker::GetAllocatorStats(ezAllocatorId allocatorId)
+ezStringView ezMemoryTracker::GetAllocatorName(ezAllocatorId allocatorId)
 {
-  EZ_LOCK(*s_pTrackerData);
+  return GetAllocatorData(allocatorId).m_sName;
+}
 
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_Stats;
+// static
+ezAllocator::Stats ezMemoryTracker::GetAllocatorStats(ezAllocatorId allocatorId)
+{
+  return GetAllocatorData(allocatorId).GetStats();
 }
 
 // static
 ezAllocatorId ezMemoryTracker::GetAllocatorParentId(ezAllocatorId allocatorId)
 {
-  EZ_LOCK(*s_pTrackerData);
-
-  return s_pTrackerData->m_AllocatorData[allocatorId].m_ParentId;
+  return GetAllocatorData(allocatorId).m_ParentId;
 }
 
 // static
 const ezMemoryTracker::AllocationInfo& ezMemoryTracker::GetAllocationInfo(ezAllocatorId allocatorId, const void* pPtr)
 {
-  EZ_LOCK(*s_pTrackerData);
+  AllocationShard& shard = GetAllocatorData(allocatorId).GetShard(pPtr);
+  EZ_LOCK(shard.m_Mutex);
 
-  const AllocatorData& data = s_pTrackerData->m_AllocatorData[allocatorId];
   const AllocationInfo* info = nullptr;
-  if (data.m_Allocations.TryGetValue(pPtr, info))
+  if (shard.m_Allocations.TryGetValue(pPtr, info))
   {
     return *info;
   }
@@ -382,19 +566,22 @@ ezUInt32 ezMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
   // first collect all leaks
   for (auto it = s_pTrackerData->m_AllocatorData.GetIterator(); it.IsValid(); ++it)
   {
-    const AllocatorData& data = it.Value();
-    for (auto it2 = data.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
+    const AllocatorData& data = *it.Value();
+    for (const AllocationShard& shard : data.m_Shards)
     {
-      LeakInfo leak;
-      leak.m_AllocatorId = it.Id();
-      leak.m_uiSize = it2.Value().m_uiSize;
-
-      if (data.m_TrackingMode == ezAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
+      for (auto it2 = shard.m_Allocations.GetIterator(); it2.IsValid(); ++it2)
       {
-        leak.m_bIsRootLeak = false;
-      }
+        LeakInfo leak;
+        leak.m_AllocatorId = it.Id();
+        leak.m_uiSize = it2.Value().m_uiSize;
 
-      leakTable.Insert(it2.Key(), leak);
+        if (data.m_TrackingMode == ezAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
+        {
+          leak.m_bIsRootLeak = false;
+        }
+
+        leakTable.Insert(it2.Key(), leak);
+      }
     }
   }
 
@@ -431,7 +618,7 @@ ezUInt32 ezMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
 
     if (leak.m_bIsRootLeak)
     {
-      const AllocatorData& data = s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
+      AllocatorData& data = *s_pTrackerData->m_AllocatorData[leak.m_AllocatorId];
 
       if (data.m_TrackingMode != ezAllocatorTrackingMode::AllocationStatsIgnoreLeaks)
       {
@@ -443,7 +630,7 @@ ezUInt32 ezMemoryTracker::PrintMemoryLeaks(PrintFunc printfunc)
         }
 
         ezMemoryTracker::AllocationInfo info;
-        data.m_Allocations.TryGetValue(ptr, info);
+        data.GetShard(ptr).m_Allocations.TryGetValue(ptr, info);
 
         DumpLeak(info, data.m_sName.GetData());
 
@@ -0,0 +1,211 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Memory/ThreadLocalLinearAllocator.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Lock.h>
+
+namespace
+{
+  // The slots are per thread and shared by all ezThreadLocalLinearAllocator instances.
+  ezAtomicInteger32 s_SlotInUse[ezThreadLocalLinearAllocator::MaxThreads];
+
+  struct ezThreadLocalLinearAllocatorSlot
+  {
+    ~ezThreadLocalLinearAllocatorSlot()
+    {
+      // Hand the slot to the next thread that needs one. Its pages stay alive and are reused by that thread.
+      if (m_uiSlot < ezThreadLocalLinearAllocator::MaxThreads)
+      {
+        s_SlotInUse[m_uiSlot].Set(0);
+      }
+    }
+
+    ezUInt32 m_uiSlot = ezInvalidIndex;
+  };
+
+  thread_local ezThreadLocalLinearAllocatorSlot tl_LinearAllocatorThreadSlot;
+
+  ezUInt32 AcquireThreadSlot()
+  {
+    for (ezUInt32 i = 0; i < ezThreadLocalLinearAllocator::MaxThreads; ++i)
+    {
+      if (s_SlotInUse[i].TestAndSet(0, 1))
+        return i;
+    }
+
+    return ezThreadLocalLinearAllocator::MaxThreads;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 GetThreadSlot()
+  {
+    if (tl_LinearAllocatorThreadSlot.m_uiSlot == ezInvalidIndex)
+    {
+      tl_LinearAllocatorThreadSlot.m_uiSlot = AcquireThreadSlot();
+    }
+
+    return tl_LinearAllocatorThreadSlot.m_uiSlot;
+  }
+} // namespace
+
+ezThreadLocalLinearAllocator::ezThreadLocalLinearAllocator(ezStringView sName, ezAllocator* pParent)
+  : m_pParent(pParent)
+{
+  m_Id = ezMemoryTracker::RegisterAllocator(sName, ezAllocatorTrackingMode::Basics, pParent != nullptr ? pParent->GetId() : ezAllocatorId());
+}
+
+ezThreadLocalLinearAllocator::~ezThreadLocalLinearAllocator()
+{
+  Reset();
+
+  for (ThreadData*& pData : m_ThreadData)
+  {
+    EZ_DELETE(m_pParent, pData);
+  }
+
+  EZ_DELETE(m_pParent, m_pOverflowData);
+
+  ezMemoryTracker::DeregisterAllocator(m_Id);
+}
+
+void* ezThreadLocalLinearAllocator::Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc)
+{
+  // zero size allocations always return nullptr (since deallocate nullptr is ignored)
+  if (uiSize == 0)
+    return nullptr;
+
+  EZ_IGNORE_UNUSED(uiAlign);
+  EZ_ASSERT_DEV(uiAlign <= ezAllocPolicyLinear<>::Alignment && ezAllocPolicyLinear<>::Alignment % uiAlign == 0, "Unsupported alignment {0}", ((ezUInt32)uiAlign));
+
+  const ezUInt32 uiThreadSlot = GetThreadSlot();
+  if (uiThreadSlot < MaxThreads)
+  {
+    ThreadData* pData = m_ThreadData[uiThreadSlot];
+    if (pData == nullptr)
+    {
+      pData = &CreateThreadData(uiThreadSlot);
+    }
+
+    return AllocateFromThreadData(*pData, uiSize, destructorFunc);
+  }
+
+  EZ_LOCK(m_OverflowMutex);
+
+  if (m_pOverflowData == nullptr)
+  {
+    m_pOverflowData = EZ_NEW(m_pParent, ThreadData, m_pParent);
+  }
+
+  return AllocateFromThreadData(*m_pOverflowData, uiSize, destructorFunc);
+}
+
+void ezThreadLocalLinearAllocator::Deallocate(void* pPtr)
+{
+  if (pPtr == nullptr)
+    return;
+
+  // The object has been destructed already, make sure Reset() doesn't do it again.
+  // The header is never touched by the owning thread after the allocation, so this is safe from any thread.
+  Header* pHeader = static_cast<Header*>(ezMemoryUtils::AddByteOffset(pPtr, -static_cast<ptrdiff_t>(HeaderSize)));
+  pHeader->m_Func = nullptr;
+}
+
+size_t ezThreadLocalLinearAllocator::AllocatedSize(const void* pPtr)
+{
+  const Header* pHeader = static_cast<const Header*>(ezMemoryUtils::AddByteOffset(pPtr, -static_cast<ptrdiff_t>(HeaderSize)));
+  return pHeader->m_uiSize;
+}
+
+ezAllocatorId ezThreadLocalLinearAllocator::GetId() const
+{
+  return m_Id;
+}
+
+ezAllocator::Stats ezThreadLocalLinearAllocator::GetStats() const
+{
+  return ezMemoryTracker::GetAllocatorStats(m_Id);
+}
+
+void ezThreadLocalLinearAllocator::Reset()
+{
+  EZ_LOCK(m_OverflowMutex);
+
+  // Run all destructors before any page is reset, destructors might still access memory that was allocated by other threads.
+  auto CallDestructors = [](ThreadData* pData)
+  {
+    if (pData == nullptr)
+      return;
+
+    // destruct in reverse order of allocation
+    for (Header* pHeader = pData->m_pLastWithDestructor; pHeader != nullptr; pHeader = pHeader->m_pPrevWithDestructor)
+    {
+      if (pHeader->m_Func != nullptr)
+      {
+        pHeader->m_Func(ezMemoryUtils::AddByteOffset(pHeader, HeaderSize));
+      }
+    }
+
+    pData->m_pLastWithDestructor = nullptr;
+  };
+
+  ezAllocator::Stats stats;
+
+  auto ResetPages = [&](ThreadData* pData)
+  {
+    if (pData == nullptr)
+      return;
+
+    stats.m_uiPerFrameAllocationSize += pData->m_uiAllocationSize;
+    pData->m_uiAllocationSize = 0;
+
+    pData->m_Pages.Reset();
+
+    ezAllocator::Stats pageStats;
+    pData->m_Pages.FillStats(pageStats);
+    stats.m_uiNumAllocations += pageStats.m_uiNumAllocations;
+    stats.m_uiAllocationSize += pageStats.m_uiAllocationSize;
+  };
+
+  for (ThreadData* pData : m_ThreadData)
+  {
+    CallDestructors(pData);
+  }
+  CallDestructors(m_pOverflowData);
+
+  for (ThreadData* pData : m_ThreadData)
+  {
+    ResetPages(pData);
+  }
+  ResetPages(m_pOverflowData);
+
+  ezMemoryTracker::SetAllocatorStats(m_Id, stats);
+}
+
+void* ezThreadLocalLinearAllocator::AllocateFromThreadData(ThreadData& ref_data, size_t uiSize, ezMemoryUtils::DestructorFunction destructorFunc)
+{
+  const size_t uiTotalSize = uiSize + HeaderSize;
+
+  Header* pHeader = static_cast<Header*>(ref_data.m_Pages.Allocate(uiTotalSize, ezAllocPolicyLinear<>::Alignment));
+  pHeader->m_Func = destructorFunc;
+  pHeader->m_pPrevWithDestructor = nullptr;
+  pHeader->m_uiSize = uiSize;
+
+  if (destructorFunc != nullptr)
+  {
+    pHeader->m_pPrevWithDestructor = ref_data.m_pLastWithDestructor;
+    ref_data.m_pLastWithDestructor = pHeader;
+  }
+
+  ref_data.m_uiAllocationSize += uiTotalSize;
+
+  return ezMemoryUtils::AddByteOffset(pHeader, HeaderSize);
+}
+
+ezThreadLocalLinearAllocator::ThreadData& ezThreadLocalLinearAllocator::CreateThreadData(ezUInt32 uiThreadSlot)
+{
+  // Only the thread that owns the slot ever writes it, so no synchronization is needed here.
+  ThreadData* pData = EZ_NEW(m_pParent, ThreadData, m_pParent);
+  m_ThreadData[uiThreadSlot] = pData;
+  return *pData;
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Memory_Implementation_ThreadLocalLinearAllocator);
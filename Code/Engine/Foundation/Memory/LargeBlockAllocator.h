@@ -53,7 +53,7 @@ public:
 
   ezAllocatorId GetId() const;
 
-  const ezAllocator::Stats& GetStats() const;
+  ezAllocator::Stats GetStats() const;
 
 private:
   void* Allocate(size_t uiAlign);
@@ -8,11 +8,12 @@
 
 enum class ezAllocatorTrackingMode : ezUInt32
 {
-  Nothing,                       ///< The allocator doesn't track anything. Use this for best performance.
-  Basics,                        ///< The allocator will be known to the system, so it can show up in debugging tools, but barely anything more.
-  AllocationStats,               ///< The allocator keeps track of how many allocations and deallocations it did and how large its memory usage is.
-  AllocationStatsIgnoreLeaks,    ///< Same as AllocationStats, but any remaining allocations at shutdown are not reported as leaks.
-  AllocationStatsAndStacktraces, ///< The allocator will record stack traces for each allocation, which can be used to find memory leaks.
+  Nothing,                              ///< The allocator doesn't track anything. Use this for best performance.
+  Basics,                               ///< The allocator will be known to the system, so it can show up in debugging tools, but barely anything more.
+  AllocationStats,                      ///< The allocator keeps track of how many allocations and deallocations it did and how large its memory usage is.
+  AllocationStatsIgnoreLeaks,           ///< Same as AllocationStats, but any remaining allocations at shutdown are not reported as leaks.
+  AllocationStatsAndSampledStacktraces, ///< Same as AllocationStats, but only records stack traces for a random sample of allocations, see ezMemoryTracker::SetStackTraceSamplingInterval().
+  AllocationStatsAndStacktraces,        ///< The allocator will record stack traces for each allocation, which can be used to find memory leaks.
 
   Default = EZ_ALLOC_TRACKING_DEFAULT,
 };
@@ -54,7 +55,7 @@ public:
     ezAllocatorId Id() const;
     ezStringView Name() const;
     ezAllocatorId ParentId() const;
-    const ezAllocator::Stats& Stats() const;
+    ezAllocator::Stats Stats() const;
 
     void Next();
     bool IsValid() const;
@@ -82,8 +83,16 @@ public:
 
   static void ResetPerFrameAllocatorStats();
 
+  /// \brief Sets the average number of allocated bytes between two allocations that get a stack trace with ezAllocatorTrackingMode::AllocationStatsAndSampledStacktraces.
+  ///
+  /// Large allocations are more likely to be sampled than small ones. The default is 512 KB.
+  static void SetStackTraceSamplingInterval(ezUInt32 uiBytes);
+  static ezUInt32 GetStackTraceSamplingInterval();
+
   static ezStringView GetAllocatorName(ezAllocatorId allocatorId);
-  static const ezAllocator::Stats& GetAllocatorStats(ezAllocatorId allocatorId);
+
+  /// \brief Returns the stats of the allocator. The stats are tracked per thread and summed up here, so this is not meant to be called for every allocation.
+  static ezAllocator::Stats GetAllocatorStats(ezAllocatorId allocatorId);
   static ezAllocatorId GetAllocatorParentId(ezAllocatorId allocatorId);
   static const AllocationInfo& GetAllocationInfo(ezAllocatorId allocatorId, const void* pPtr);
 
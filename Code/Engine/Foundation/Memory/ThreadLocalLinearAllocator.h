@@ -0,0 +1,80 @@
+#pragma once
+
+#include <Foundation/Memory/MemoryTracker.h>
+#include <Foundation/Memory/Policies/AllocPolicyLinear.h>
+#include <Foundation/Threading/Mutex.h>
+
+/// \brief A linear allocator that hands out memory from separate pages for each thread.
+///
+/// In contrast to ezLinearAllocator, allocations don't need any synchronization, since every thread only ever touches its own pages.
+/// This makes it well suited for allocators that are used by many tasks at once, like the frame allocator.
+///
+/// Every allocation is prefixed with a small header that stores its size and the destructor function, if there is any.
+/// Deallocate() may be called from any thread, but, like with every linear allocator, it doesn't free any memory.
+/// All memory is reclaimed at once in Reset(), which also calls the destructors of all objects that weren't deleted explicitly.
+/// Reset() must not be called while other threads are still allocating from this allocator.
+///
+/// The stats of all threads are combined and passed to ezMemoryTracker in Reset(). Like for ezLinearAllocator the allocation count
+/// and size refer to the pages, the per frame allocation size is the amount of memory that was handed out since the last reset.
+class EZ_FOUNDATION_DLL ezThreadLocalLinearAllocator : public ezAllocator
+{
+public:
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static constexpr bool OverwriteMemoryOnReset = true;
+#else
+  static constexpr bool OverwriteMemoryOnReset = false;
+#endif
+
+  /// \brief Threads beyond this number share one set of pages that is protected by a mutex.
+  ///
+  /// The slots are handed to the threads that are currently running, a thread releases its slot when it exits.
+  static constexpr ezUInt32 MaxThreads = 128;
+
+  ezThreadLocalLinearAllocator(ezStringView sName, ezAllocator* pParent);
+  ~ezThreadLocalLinearAllocator();
+
+  // ezAllocator implementation
+  virtual void* Allocate(size_t uiSize, size_t uiAlign, ezMemoryUtils::DestructorFunction destructorFunc = nullptr) override;
+  virtual void Deallocate(void* pPtr) override;
+  virtual size_t AllocatedSize(const void* pPtr) override;
+  virtual ezAllocatorId GetId() const override;
+  virtual Stats GetStats() const override;
+
+  /// \brief Calls all pending destructors and resets the pages of all threads. The pages themselves are kept for reuse.
+  void Reset();
+
+private:
+  struct Header
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezMemoryUtils::DestructorFunction m_Func;
+    Header* m_pPrevWithDestructor;
+    size_t m_uiSize;
+  };
+
+  static constexpr size_t HeaderSize = (sizeof(Header) + ezAllocPolicyLinear<>::Alignment - 1) & ~static_cast<size_t>(ezAllocPolicyLinear<>::Alignment - 1);
+
+  struct ThreadData
+  {
+    ThreadData(ezAllocator* pParent)
+      : m_Pages(pParent)
+    {
+    }
+
+    ezAllocPolicyLinear<OverwriteMemoryOnReset> m_Pages;
+    Header* m_pLastWithDestructor = nullptr;
+    ezUInt64 m_uiAllocationSize = 0; ///< bytes handed out since the last reset
+  };
+
+  void* AllocateFromThreadData(ThreadData& ref_data, size_t uiSize, ezMemoryUtils::DestructorFunction destructorFunc);
+  ThreadData& CreateThreadData(ezUInt32 uiThreadSlot);
+
+  ezAllocator* m_pParent = nullptr;
+  ezAllocatorId m_Id;
+
+  ThreadData* m_ThreadData[MaxThreads] = {};
+
+  ezMutex m_OverflowMutex;
+  ThreadData* m_pOverflowData = nullptr;
+};
@@ -6,9 +6,12 @@
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Containers/IdTable.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/JSONWriter.h>
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
 #if EZ_ENABLED(EZ_USE_PROFILING)
@@ -32,6 +35,9 @@ static ezProfileCaptureDataTransfer s_ProfileCaptureDataTransfer;
 
 namespace
 {
+  /// Incremented whenever a plugin is unloaded or the name table is cleared, so that all threads forget the name IDs that they cached.
+  static ezAtomicInteger32 s_iNameCachesGeneration;
+
   static ezEventSubscriptionID s_PluginEventSubscription = 0;
   void PluginEvent(const ezPluginEvent& e)
   {
@@ -40,6 +46,7 @@ namespace
       // When a plugin is unloaded we need to clear all profiling data
       // since they can contain pointers to function names that don't exist anymore.
       ezProfilingSystem::Clear();
+      s_iNameCachesGeneration.Increment();
     }
   }
 } // namespace
@@ -60,6 +67,7 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(Foundation, ProfilingSystem)
   }
   ON_CORESYSTEMS_SHUTDOWN
   {
+    ezProfilingSystem::StopContinuousCapture();
     s_ProfileCaptureDataTransfer.DisableDataTransfer();
     ezPlugin::Events().RemoveEventHandler(s_PluginEventSubscription);
     ezProfilingSystem::Reset();
@@ -85,12 +93,58 @@ namespace
 
   static ezUInt64 s_MainThreadId = 0;
 
+  /// The header of a continuous capture file is followed by a sequence of chunks, each starting with a ContinuousCaptureChunk::Enum.
+  static constexpr ezUInt32 s_uiContinuousCaptureMagic = 0x4350457A; // 'ezPC'
+  static constexpr ezUInt8 s_uiContinuousCaptureVersion = 1;
+
+  struct ContinuousCaptureChunk
+  {
+    enum Enum : ezUInt8
+    {
+      ThreadName, ///< ezUInt64 thread ID, string
+      ScopeName,  ///< ezUInt32 name ID, string
+      Scopes,     ///< ezUInt64 thread ID, ezUInt32 count, count * ContinuousCaptureScope
+      Frame,      ///< ezUInt64 frame number, ezInt64 frame start time in nanoseconds
+    };
+  };
+
+  /// The compact representation of a CPU scope in a continuous capture. Function names are interned like scope names.
+  struct ContinuousCaptureScope
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNameId;
+    ezUInt32 m_uiFunctionNameId; ///< ezInvalidIndex if the scope has no function name.
+    ezInt64 m_iBeginTime;        ///< In nanoseconds.
+    ezInt64 m_iEndTime;          ///< In nanoseconds.
+  };
+
+  struct ContinuousCaptureFrame
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiFrameNumber;
+    ezTime m_StartTime;
+  };
+
   struct CpuScopesBufferBase
   {
     virtual ~CpuScopesBufferBase() = default;
 
     ezUInt64 m_uiThreadId = 0;
     bool IsMainThread() const { return m_uiThreadId == s_MainThreadId; }
+
+    /// The name IDs that this thread already knows, keyed by the hash of the name. Only a cache miss needs to lock the global name table.
+    ezHashTable<ezUInt64, ezUInt32> m_ScopeNameIds;
+
+    /// The name IDs of function names, keyed by the address of the name. Only used by continuous captures.
+    ezHashTable<ezUInt64, ezUInt32> m_FunctionNameIds;
+    ezInt32 m_iNameCachesGeneration = 0;
+
+    /// Scopes recorded while a continuous capture is running. The writer thread swaps them with m_ContinuousCaptureScratch.
+    ezMutex m_ContinuousCaptureMutex;
+    ezDynamicArray<ContinuousCaptureScope> m_ContinuousCaptureScopes;
+    ezDynamicArray<ContinuousCaptureScope> m_ContinuousCaptureScratch;
   };
 
   template <ezUInt32 SizeInBytes>
@@ -120,8 +174,68 @@ namespace
   static ezHybridArray<ezUInt64, 16> s_DeadThreadIDs;
   static ezMutex s_ThreadInfosMutex;
 
+  static ezDynamicArray<ezString> s_ScopeNames;
+  static ezHashTable<ezUInt64, ezUInt32> s_ScopeNameIds;
+  static ezMutex s_ScopeNamesMutex;
+
+  ezUInt32 InternScopeName(ezStringView sName, ezUInt64 uiNameHash)
+  {
+    EZ_LOCK(s_ScopeNamesMutex);
+
+    ezUInt32 uiNameId = 0;
+    if (!s_ScopeNameIds.TryGetValue(uiNameHash, uiNameId))
+    {
+      uiNameId = s_ScopeNames.GetCount();
+      s_ScopeNames.PushBack(sName);
+      s_ScopeNameIds.Insert(uiNameHash, uiNameId);
+    }
+
+    return uiNameId;
+  }
+
+  void UpdateNameCaches(CpuScopesBufferBase* pScopes)
+  {
+    const ezInt32 iGeneration = s_iNameCachesGeneration;
+    if (pScopes->m_iNameCachesGeneration != iGeneration)
+    {
+      pScopes->m_ScopeNameIds.Clear();
+      pScopes->m_FunctionNameIds.Clear();
+      pScopes->m_iNameCachesGeneration = iGeneration;
+    }
+  }
+
+  ezUInt32 GetScopeNameId(CpuScopesBufferBase* pScopes, const ezProfilingScopeName& name)
+  {
+    ezUInt32 uiNameId = 0;
+    if (!pScopes->m_ScopeNameIds.TryGetValue(name.m_uiHash, uiNameId))
+    {
+      uiNameId = InternScopeName(name.m_sName, name.m_uiHash);
+      pScopes->m_ScopeNameIds.Insert(name.m_uiHash, uiNameId);
+    }
+
+    return uiNameId;
+  }
+
+  ezUInt32 GetFunctionNameId(CpuScopesBufferBase* pScopes, const char* szFunctionName)
+  {
+    if (szFunctionName == nullptr)
+      return ezInvalidIndex;
+
+    const ezUInt64 uiAddress = reinterpret_cast<ezUInt64>(szFunctionName);
+
+    ezUInt32 uiNameId = 0;
+    if (!pScopes->m_FunctionNameIds.TryGetValue(uiAddress, uiNameId))
+    {
+      const ezStringView sFunctionName = szFunctionName;
+      uiNameId = InternScopeName(sFunctionName, ezHashingUtils::StringHash(sFunctionName));
+      pScopes->m_FunctionNameIds.Insert(uiAddress, uiNameId);
+    }
+
+    return uiNameId;
+  }
+
 #  if EZ_ENABLED(EZ_PLATFORM_64BIT)
-  static_assert(sizeof(ezProfilingSystem::CPUScope) == 64);
+  static_assert(sizeof(ezProfilingSystem::CPUScope) == 32);
   static_assert(sizeof(ezProfilingSystem::GPUScope) == 64);
 #  endif
 
@@ -131,6 +245,142 @@ namespace
   static ezProfilingSystem::ScopeTimeoutDelegate s_ScopeTimeoutCallback;
 
   static ezDynamicArray<ezUniquePtr<GPUScopesBuffer>> s_GPUScopes;
+
+  static ezDynamicArray<ContinuousCaptureFrame> s_ContinuousCaptureFrames;
+  static ezMutex s_ContinuousCaptureFramesMutex;
+
+  /// Regularly writes everything that was recorded by a continuous capture into the capture file.
+  class ezContinuousCaptureThread : public ezThread
+  {
+  public:
+    ezContinuousCaptureThread()
+      : ezThread("Profiling Capture")
+    {
+    }
+
+    ezResult Open(ezStringView sFilePath)
+    {
+      EZ_SUCCEED_OR_RETURN(m_File.Open(sFilePath));
+
+      m_File << s_uiContinuousCaptureMagic;
+      m_File << s_uiContinuousCaptureVersion;
+#  if EZ_ENABLED(EZ_SUPPORTS_PROCESSES)
+      m_File << ezProcess::GetCurrentProcessID();
+#  else
+      m_File << static_cast<ezOsProcessID>(0);
+#  endif
+
+      return EZ_SUCCESS;
+    }
+
+    /// Stops the thread, writes the remaining data and closes the file.
+    void Close()
+    {
+      m_bStop = true;
+      m_WakeUp.RaiseSignal();
+      Join();
+
+      WritePendingData();
+      m_File.Close();
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        m_WakeUp.WaitForSignal(ezTime::MakeFromMilliseconds(100));
+        WritePendingData();
+      }
+
+      return 0;
+    }
+
+    void WritePendingData()
+    {
+      {
+        EZ_LOCK(s_AllCpuScopesMutex);
+
+        for (CpuScopesBufferBase* pBuffer : s_AllCpuScopes)
+        {
+          {
+            EZ_LOCK(pBuffer->m_ContinuousCaptureMutex);
+            pBuffer->m_ContinuousCaptureScopes.Swap(pBuffer->m_ContinuousCaptureScratch);
+          }
+
+          const ezDynamicArray<ContinuousCaptureScope>& scopes = pBuffer->m_ContinuousCaptureScratch;
+          if (scopes.IsEmpty())
+            continue;
+
+          // the names of these scopes were interned before the scopes were recorded, so writing all names that are known now is sufficient
+          WriteScopeNames();
+
+          m_File << static_cast<ezUInt8>(ContinuousCaptureChunk::Scopes);
+          m_File << pBuffer->m_uiThreadId;
+          m_File << scopes.GetCount();
+          m_File.WriteBytes(scopes.GetData(), scopes.GetCount() * sizeof(ContinuousCaptureScope)).IgnoreResult();
+
+          pBuffer->m_ContinuousCaptureScratch.Clear();
+        }
+      }
+
+      {
+        EZ_LOCK(s_ThreadInfosMutex);
+
+        for (const ezProfilingSystem::ThreadInfo& info : s_ThreadInfos)
+        {
+          if (!m_WrittenThreadIds.Contains(info.m_uiThreadId))
+          {
+            m_WrittenThreadIds.Insert(info.m_uiThreadId);
+
+            m_File << static_cast<ezUInt8>(ContinuousCaptureChunk::ThreadName);
+            m_File << info.m_uiThreadId;
+            m_File << info.m_sName;
+          }
+        }
+      }
+
+      {
+        EZ_LOCK(s_ContinuousCaptureFramesMutex);
+        s_ContinuousCaptureFrames.Swap(m_Frames);
+      }
+
+      for (const ContinuousCaptureFrame& frame : m_Frames)
+      {
+        m_File << static_cast<ezUInt8>(ContinuousCaptureChunk::Frame);
+        m_File << frame.m_uiFrameNumber;
+        m_File << static_cast<ezInt64>(frame.m_StartTime.GetNanoseconds());
+      }
+
+      m_Frames.Clear();
+
+      m_File.Flush().IgnoreResult();
+    }
+
+    void WriteScopeNames()
+    {
+      EZ_LOCK(s_ScopeNamesMutex);
+
+      for (; m_uiNumWrittenScopeNames < s_ScopeNames.GetCount(); ++m_uiNumWrittenScopeNames)
+      {
+        m_File << static_cast<ezUInt8>(ContinuousCaptureChunk::ScopeName);
+        m_File << m_uiNumWrittenScopeNames;
+        m_File << s_ScopeNames[m_uiNumWrittenScopeNames];
+      }
+    }
+
+    ezFileWriter m_File;
+    ezAtomicBool m_bStop;
+    ezThreadSignal m_WakeUp;
+
+    ezUInt32 m_uiNumWrittenScopeNames = 0;
+    ezHashSet<ezUInt64> m_WrittenThreadIds;
+    ezDynamicArray<ContinuousCaptureFrame> m_Frames;
+  };
+
+  static ezAtomicBool s_bContinuousCaptureActive;
+  static ezMutex s_ContinuousCaptureMutex;
+  static ezUniquePtr<ezContinuousCaptureThread> s_pContinuousCaptureThread;
 } // namespace
 
 void ezProfilingSystem::ProfilingData::Clear()
@@ -143,6 +393,7 @@ void ezProfilingSystem::ProfilingData::Clear()
   m_FrameStartTimes.Clear();
   m_GPUScopes.Clear();
   m_ThreadInfos.Clear();
+  m_ScopeNames.Clear();
 }
 
 void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_merged, ezArrayPtr<const ProfilingData*> inputs)
@@ -203,6 +454,31 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_merged, ezArrayP
     }
   }
 
+  // merge m_ScopeNames, the inputs may have been captured in different processes, so their name IDs are remapped
+  ezHybridArray<ezDynamicArray<ezUInt32>, 4> nameIdRemapping;
+  {
+    ezHashTable<ezUInt64, ezUInt32> mergedNameIds;
+
+    nameIdRemapping.SetCount(inputs.GetCount());
+    for (ezUInt32 i = 0; i < inputs.GetCount(); ++i)
+    {
+      for (const ezString& sName : inputs[i]->m_ScopeNames)
+      {
+        const ezUInt64 uiNameHash = ezHashingUtils::StringHash(sName);
+
+        ezUInt32 uiMergedNameId = 0;
+        if (!mergedNameIds.TryGetValue(uiNameHash, uiMergedNameId))
+        {
+          uiMergedNameId = out_merged.m_ScopeNames.GetCount();
+          out_merged.m_ScopeNames.PushBack(sName);
+          mergedNameIds.Insert(uiNameHash, uiMergedNameId);
+        }
+
+        nameIdRemapping[i].PushBack(uiMergedNameId);
+      }
+    }
+  }
+
   // merge m_AllEventBuffers
   {
     struct CountAndIndex
@@ -238,13 +514,23 @@ void ezProfilingSystem::ProfilingData::Merge(ProfilingData& out_merged, ezArrayP
     }
 
     // fill the output array
-    for (const auto& pd : inputs)
+    for (ezUInt32 i = 0; i < inputs.GetCount(); ++i)
     {
-      for (const auto& eb : pd->m_AllEventBuffers)
+      for (const auto& eb : inputs[i]->m_AllEventBuffers)
       {
         const auto& ebInfo = eventBufferInfos[eb.m_uiThreadId];
 
-        out_merged.m_AllEventBuffers[ebInfo.m_uiIndex].m_Data.PushBackRange(eb.m_Data);
+        for (CPUScope scope : eb.m_Data)
+        {
+          scope.m_uiNameId = nameIdRemapping[i][scope.m_uiNameId];
+
+          if (scope.m_uiFunctionNameId != ezInvalidIndex)
+          {
+            scope.m_uiFunctionNameId = nameIdRemapping[i][scope.m_uiFunctionNameId];
+          }
+
+          out_merged.m_AllEventBuffers[ebInfo.m_uiIndex].m_Data.PushBack(scope);
+        }
       }
     }
   }
@@ -426,16 +712,16 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& ref_outputStrea
       for (const CPUScope& e : sortedScopes)
       {
         writer.BeginObject();
-        writer.AddVariableString("name", static_cast<const char*>(e.m_szName));
+        writer.AddVariableString("name", m_ScopeNames[e.m_uiNameId]);
         writer.AddVariableUInt32("pid", m_uiProcessID);
         writer.AddVariableUInt64("tid", uiThreadId);
         writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_BeginTime.GetMicroseconds()));
         writer.AddVariableString("ph", "B");
 
-        if (e.m_szFunctionName != nullptr)
+        if (e.m_uiFunctionNameId != ezInvalidIndex)
         {
           writer.BeginObject("args");
-          writer.AddVariableString("function", e.m_szFunctionName);
+          writer.AddVariableString("function", m_ScopeNames[e.m_uiFunctionNameId]);
           writer.EndObject();
         }
 
@@ -444,7 +730,7 @@ ezResult ezProfilingSystem::ProfilingData::Write(ezStreamWriter& ref_outputStrea
         if (e.m_EndTime.IsPositive())
         {
           writer.BeginObject();
-          writer.AddVariableString("name", static_cast<const char*>(e.m_szName));
+          writer.AddVariableString("name", m_ScopeNames[e.m_uiNameId]);
           writer.AddVariableUInt32("pid", m_uiProcessID);
           writer.AddVariableUInt64("tid", uiThreadId);
           writer.AddVariableUInt64("ts", static_cast<ezUInt64>(e.m_EndTime.GetMicroseconds()));
@@ -567,6 +853,22 @@ void ezProfilingSystem::Clear()
       gpuScopes->Clear();
     }
   }
+
+  // no recorded scope references the interned names anymore, so start over, otherwise dynamic names would let the table grow forever
+  // a running continuous capture has already written name IDs to its file though, those must stay valid
+  {
+    EZ_LOCK(s_ContinuousCaptureMutex);
+
+    if (s_pContinuousCaptureThread == nullptr)
+    {
+      EZ_LOCK(s_ScopeNamesMutex);
+      s_ScopeNames.Clear();
+      s_ScopeNames.Compact();
+      s_ScopeNameIds.Clear();
+      s_ScopeNameIds.Compact();
+      s_iNameCachesGeneration.Increment();
+    }
+  }
 }
 
 // static
@@ -609,14 +911,57 @@ void ezProfilingSystem::Capture(ezProfilingSystem::ProfilingData& ref_profilingD
       targetEventBuffer.m_Data.SetCountUninitialized(uiSourceCount);
       for (ezUInt32 j = 0; j < uiSourceCount; ++j)
       {
-        const CPUScope& sourceEvent = sourceEventBuffer->IsMainThread() ? CastToMainThreadEventBuffer(sourceEventBuffer)->m_Data[j] : CastToOtherThreadEventBuffer(sourceEventBuffer)->m_Data[j];
+        targetEventBuffer.m_Data[j] = sourceEventBuffer->IsMainThread() ? CastToMainThreadEventBuffer(sourceEventBuffer)->m_Data[j] : CastToOtherThreadEventBuffer(sourceEventBuffer)->m_Data[j];
+      }
+    }
+  }
+
+  {
+    // only the names that the copied scopes reference are copied, they get new IDs in the order in which they are encountered
+    // function names are copied as well, so that the capture doesn't point into code that may get unloaded
+    EZ_LOCK(s_ScopeNamesMutex);
+
+    ezHashTable<ezUInt32, ezUInt32> nameIdRemapping;
+    ezHashTable<ezUInt64, ezUInt32> functionNameIds;
+
+    for (CPUScopesBufferFlat& eventBuffer : ref_profilingData.m_AllEventBuffers)
+    {
+      ezUInt32 uiNumScopes = 0;
+
+      for (CPUScope scope : eventBuffer.m_Data)
+      {
+        // recorded concurrently to the name table getting cleared, the name can't be resolved anymore
+        if (scope.m_uiNameId >= s_ScopeNames.GetCount())
+          continue;
+
+        ezUInt32 uiNameId = 0;
+        if (!nameIdRemapping.TryGetValue(scope.m_uiNameId, uiNameId))
+        {
+          uiNameId = ref_profilingData.m_ScopeNames.GetCount();
+          ref_profilingData.m_ScopeNames.PushBack(s_ScopeNames[scope.m_uiNameId]);
+          nameIdRemapping.Insert(scope.m_uiNameId, uiNameId);
+        }
+
+        scope.m_uiNameId = uiNameId;
+
+        if (scope.m_szFunctionName != nullptr)
+        {
+          const ezUInt64 uiAddress = reinterpret_cast<ezUInt64>(scope.m_szFunctionName);
+          if (!functionNameIds.TryGetValue(uiAddress, scope.m_uiFunctionNameId))
+          {
+            scope.m_uiFunctionNameId = ref_profilingData.m_ScopeNames.GetCount();
+            ref_profilingData.m_ScopeNames.PushBack(scope.m_szFunctionName);
+            functionNameIds.Insert(uiAddress, scope.m_uiFunctionNameId);
+          }
+
+          scope.m_szFunctionName = nullptr;
+        }
 
-        CPUScope& copiedEvent = targetEventBuffer.m_Data[j];
-        copiedEvent.m_szFunctionName = sourceEvent.m_szFunctionName;
-        copiedEvent.m_BeginTime = sourceEvent.m_BeginTime;
-        copiedEvent.m_EndTime = sourceEvent.m_EndTime;
-        ezStringUtils::Copy(copiedEvent.m_szName, CPUScope::NAME_SIZE, sourceEvent.m_szName);
+        eventBuffer.m_Data[uiNumScopes] = scope;
+        ++uiNumScopes;
       }
+
+      eventBuffer.m_Data.SetCountUninitialized(uiNumScopes);
     }
   }
 
@@ -682,13 +1027,20 @@ void ezProfilingSystem::StartNewFrame()
     s_FrameStartTimes.PopFront();
   }
 
-  s_FrameStartTimes.PushBack(ezTime::Now());
+  const ezTime now = ezTime::Now();
+  s_FrameStartTimes.PushBack(now);
+
+  if (s_bContinuousCaptureActive)
+  {
+    EZ_LOCK(s_ContinuousCaptureFramesMutex);
+    s_ContinuousCaptureFrames.PushBack({s_uiFrameCount, now});
+  }
 
   EZ_PROFILER_FRAME_MARKER();
 }
 
 // static
-void ezProfilingSystem::AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezTime scopeTimeout)
+void ezProfilingSystem::AddCPUScope(const ezProfilingScopeName& name, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezTime scopeTimeout)
 {
   const ezTime duration = endTime - beginTime;
 
@@ -718,11 +1070,26 @@ void ezProfilingSystem::AddCPUScope(ezStringView sName, const char* szFunctionNa
     }
   }
 
+  UpdateNameCaches(pScopes);
+
   CPUScope scope;
   scope.m_szFunctionName = szFunctionName;
   scope.m_BeginTime = beginTime;
   scope.m_EndTime = endTime;
-  ezStringUtils::Copy(scope.m_szName, EZ_ARRAY_SIZE(scope.m_szName), sName.GetStartPointer(), sName.GetEndPointer());
+  scope.m_uiNameId = GetScopeNameId(pScopes, name);
+  scope.m_uiFunctionNameId = ezInvalidIndex;
+
+  if (s_bContinuousCaptureActive)
+  {
+    ContinuousCaptureScope continuousScope;
+    continuousScope.m_uiNameId = scope.m_uiNameId;
+    continuousScope.m_uiFunctionNameId = GetFunctionNameId(pScopes, szFunctionName);
+    continuousScope.m_iBeginTime = static_cast<ezInt64>(beginTime.GetNanoseconds());
+    continuousScope.m_iEndTime = static_cast<ezInt64>(endTime.GetNanoseconds());
+
+    EZ_LOCK(pScopes->m_ContinuousCaptureMutex);
+    pScopes->m_ContinuousCaptureScopes.PushBack(continuousScope);
+  }
 
   if (ezThreadUtils::IsMainThread())
   {
@@ -747,8 +1114,174 @@ void ezProfilingSystem::AddCPUScope(ezStringView sName, const char* szFunctionNa
 
   if (scopeTimeout.IsPositive() && duration > scopeTimeout && s_ScopeTimeoutCallback.IsValid())
   {
-    s_ScopeTimeoutCallback(sName, szFunctionName, duration);
+    s_ScopeTimeoutCallback(name.m_sName, szFunctionName, duration);
+  }
+}
+
+// static
+ezResult ezProfilingSystem::StartContinuousCapture(ezStringView sFilePath)
+{
+  EZ_LOCK(s_ContinuousCaptureMutex);
+
+  if (s_pContinuousCaptureThread != nullptr)
+  {
+    ezLog::Error("A continuous profiling capture is already running.");
+    return EZ_FAILURE;
   }
+
+  ezUniquePtr<ezContinuousCaptureThread> pThread = EZ_DEFAULT_NEW(ezContinuousCaptureThread);
+  if (pThread->Open(sFilePath).Failed())
+  {
+    ezLog::Error("Could not open '{}' for a continuous profiling capture.", sFilePath);
+    return EZ_FAILURE;
+  }
+
+  pThread->Start();
+  s_pContinuousCaptureThread = std::move(pThread);
+  s_bContinuousCaptureActive = true;
+
+  return EZ_SUCCESS;
+}
+
+// static
+void ezProfilingSystem::StopContinuousCapture()
+{
+  EZ_LOCK(s_ContinuousCaptureMutex);
+
+  if (s_pContinuousCaptureThread == nullptr)
+    return;
+
+  s_bContinuousCaptureActive = false;
+
+  s_pContinuousCaptureThread->Close();
+  s_pContinuousCaptureThread.Clear();
+
+  // the array may have received the capacity of the thread's array, release it, since the capture is over
+  EZ_LOCK(s_ContinuousCaptureFramesMutex);
+  s_ContinuousCaptureFrames.Clear();
+  s_ContinuousCaptureFrames.Compact();
+}
+
+// static
+bool ezProfilingSystem::IsContinuousCaptureActive()
+{
+  return s_bContinuousCaptureActive;
+}
+
+// static
+ezResult ezProfilingSystem::ReadContinuousCapture(ezStreamReader& inout_stream, ProfilingData& out_data)
+{
+  out_data.Clear();
+
+  ezUInt32 uiMagic = 0;
+  ezUInt8 uiVersion = 0;
+  inout_stream >> uiMagic;
+  inout_stream >> uiVersion;
+
+  if (uiMagic != s_uiContinuousCaptureMagic || uiVersion != s_uiContinuousCaptureVersion)
+  {
+    ezLog::Error("The stream does not contain a continuous profiling capture of a supported version.");
+    return EZ_FAILURE;
+  }
+
+  inout_stream >> out_data.m_uiProcessID;
+
+  ezHashTable<ezUInt64, ezUInt32> eventBufferIndices;
+  ezDynamicArray<ezDynamicArray<ContinuousCaptureScope>> allScopes;
+  ezStringBuilder sName;
+
+  // the last chunk may be incomplete, if the process crashed during the capture
+  ezUInt8 uiChunk = 0;
+  while (inout_stream.ReadBytes(&uiChunk, sizeof(ezUInt8)) == sizeof(ezUInt8))
+  {
+    if (uiChunk == ContinuousCaptureChunk::ThreadName)
+    {
+      ThreadInfo& info = out_data.m_ThreadInfos.ExpandAndGetRef();
+      inout_stream >> info.m_uiThreadId;
+      inout_stream >> info.m_sName;
+    }
+    else if (uiChunk == ContinuousCaptureChunk::ScopeName)
+    {
+      ezUInt32 uiNameId = 0;
+      inout_stream >> uiNameId;
+      inout_stream >> sName;
+
+      if (uiNameId >= out_data.m_ScopeNames.GetCount())
+      {
+        out_data.m_ScopeNames.SetCount(uiNameId + 1);
+      }
+
+      out_data.m_ScopeNames[uiNameId] = sName;
+    }
+    else if (uiChunk == ContinuousCaptureChunk::Scopes)
+    {
+      ezUInt64 uiThreadId = 0;
+      ezUInt32 uiNumScopes = 0;
+      inout_stream >> uiThreadId;
+      inout_stream >> uiNumScopes;
+
+      ezUInt32 uiBufferIndex = 0;
+      if (!eventBufferIndices.TryGetValue(uiThreadId, uiBufferIndex))
+      {
+        uiBufferIndex = allScopes.GetCount();
+        eventBufferIndices.Insert(uiThreadId, uiBufferIndex);
+
+        allScopes.ExpandAndGetRef();
+        out_data.m_AllEventBuffers.ExpandAndGetRef().m_uiThreadId = uiThreadId;
+      }
+
+      ezDynamicArray<ContinuousCaptureScope>& scopes = allScopes[uiBufferIndex];
+      const ezUInt32 uiOldCount = scopes.GetCount();
+      scopes.SetCountUninitialized(uiOldCount + uiNumScopes);
+
+      const ezUInt64 uiBytesRead = inout_stream.ReadBytes(scopes.GetData() + uiOldCount, uiNumScopes * sizeof(ContinuousCaptureScope));
+      if (uiBytesRead != uiNumScopes * sizeof(ContinuousCaptureScope))
+      {
+        scopes.SetCount(uiOldCount + static_cast<ezUInt32>(uiBytesRead / sizeof(ContinuousCaptureScope)));
+        break;
+      }
+    }
+    else if (uiChunk == ContinuousCaptureChunk::Frame)
+    {
+      ezInt64 iStartTime = 0;
+      inout_stream >> out_data.m_uiFrameCount;
+      inout_stream >> iStartTime;
+
+      out_data.m_FrameStartTimes.PushBack(ezTime::MakeFromNanoseconds(static_cast<double>(iStartTime)));
+    }
+    else
+    {
+      ezLog::Error("Invalid chunk type {} in continuous profiling capture.", uiChunk);
+      return EZ_FAILURE;
+    }
+  }
+
+  for (ezUInt32 i = 0; i < allScopes.GetCount(); ++i)
+  {
+    ezDynamicArray<CPUScope>& targetScopes = out_data.m_AllEventBuffers[i].m_Data;
+    targetScopes.SetCountUninitialized(allScopes[i].GetCount());
+
+    for (ezUInt32 j = 0; j < allScopes[i].GetCount(); ++j)
+    {
+      const ContinuousCaptureScope& sourceScope = allScopes[i][j];
+
+      if (sourceScope.m_uiNameId >= out_data.m_ScopeNames.GetCount() ||
+          (sourceScope.m_uiFunctionNameId != ezInvalidIndex && sourceScope.m_uiFunctionNameId >= out_data.m_ScopeNames.GetCount()))
+      {
+        ezLog::Error("Continuous profiling capture references an unknown scope name.");
+        return EZ_FAILURE;
+      }
+
+      CPUScope& targetScope = targetScopes[j];
+      targetScope.m_szFunctionName = nullptr;
+      targetScope.m_BeginTime = ezTime::MakeFromNanoseconds(static_cast<double>(sourceScope.m_iBeginTime));
+      targetScope.m_EndTime = ezTime::MakeFromNanoseconds(static_cast<double>(sourceScope.m_iEndTime));
+      targetScope.m_uiNameId = sourceScope.m_uiNameId;
+      targetScope.m_uiFunctionNameId = sourceScope.m_uiFunctionNameId;
+    }
+  }
+
+  return EZ_SUCCESS;
 }
 
 // static
@@ -848,8 +1381,8 @@ void ezProfilingSystem::AddGPUScope(ezStringView sName, ezTime beginTime, ezTime
 
 //////////////////////////////////////////////////////////////////////////
 
-ezProfilingScope::ezProfilingScope(ezStringView sName, const char* szFunctionName, ezTime timeout)
-  : m_sName(sName)
+ezProfilingScope::ezProfilingScope(const ezProfilingScopeName& name, const char* szFunctionName, ezTime timeout)
+  : m_Name(name)
   , m_szFunction(szFunctionName)
   , m_BeginTime(ezTime::Now())
   , m_Timeout(timeout)
@@ -858,18 +1391,18 @@ ezProfilingScope::ezProfilingScope(ezStringView sName, const char* szFunctionNam
 
 ezProfilingScope::~ezProfilingScope()
 {
-  ezProfilingSystem::AddCPUScope(m_sName, m_szFunction, m_BeginTime, ezTime::Now(), m_Timeout);
+  ezProfilingSystem::AddCPUScope(m_Name, m_szFunction, m_BeginTime, ezTime::Now(), m_Timeout);
 }
 
 //////////////////////////////////////////////////////////////////////////
 
 thread_local ezProfilingListScope* ezProfilingListScope::s_pCurrentList = nullptr;
 
-ezProfilingListScope::ezProfilingListScope(ezStringView sListName, ezStringView sFirstSectionName, const char* szFunctionName)
-  : m_sListName(sListName)
+ezProfilingListScope::ezProfilingListScope(const ezProfilingScopeName& listName, const ezProfilingScopeName& firstSectionName, const char* szFunctionName)
+  : m_ListName(listName)
   , m_szListFunction(szFunctionName)
   , m_ListBeginTime(ezTime::Now())
-  , m_sCurSectionName(sFirstSectionName)
+  , m_CurSectionName(firstSectionName)
   , m_CurSectionBeginTime(m_ListBeginTime)
 {
   m_pPreviousList = s_pCurrentList;
@@ -879,21 +1412,21 @@ ezProfilingListScope::ezProfilingListScope(ezStringView sListName, ezStringView
 ezProfilingListScope::~ezProfilingListScope()
 {
   ezTime now = ezTime::Now();
-  ezProfilingSystem::AddCPUScope(m_sCurSectionName, nullptr, m_CurSectionBeginTime, now, ezTime::MakeZero());
-  ezProfilingSystem::AddCPUScope(m_sListName, m_szListFunction, m_ListBeginTime, now, ezTime::MakeZero());
+  ezProfilingSystem::AddCPUScope(m_CurSectionName, nullptr, m_CurSectionBeginTime, now, ezTime::MakeZero());
+  ezProfilingSystem::AddCPUScope(m_ListName, m_szListFunction, m_ListBeginTime, now, ezTime::MakeZero());
 
   s_pCurrentList = m_pPreviousList;
 }
 
 // static
-void ezProfilingListScope::StartNextSection(ezStringView sNextSectionName)
+void ezProfilingListScope::StartNextSection(const ezProfilingScopeName& nextSectionName)
 {
   ezProfilingListScope* pCurScope = s_pCurrentList;
 
   ezTime now = ezTime::Now();
-  ezProfilingSystem::AddCPUScope(pCurScope->m_sCurSectionName, nullptr, pCurScope->m_CurSectionBeginTime, now, ezTime::MakeZero());
+  ezProfilingSystem::AddCPUScope(pCurScope->m_CurSectionName, nullptr, pCurScope->m_CurSectionBeginTime, now, ezTime::MakeZero());
 
-  pCurScope->m_sCurSectionName = sNextSectionName;
+  pCurScope->m_CurSectionName = nextSectionName;
   pCurScope->m_CurSectionBeginTime = now;
 }
 
@@ -921,9 +1454,31 @@ void ezProfilingSystem::SetDiscardThreshold(ezTime threshold)
 
 void ezProfilingSystem::StartNewFrame() {}
 
-void ezProfilingSystem::AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezTime scopeTimeout)
+ezResult ezProfilingSystem::StartContinuousCapture(ezStringView sFilePath)
 {
-  EZ_IGNORE_UNUSED(sName);
+  EZ_IGNORE_UNUSED(sFilePath);
+
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::StopContinuousCapture() {}
+
+bool ezProfilingSystem::IsContinuousCaptureActive()
+{
+  return false;
+}
+
+ezResult ezProfilingSystem::ReadContinuousCapture(ezStreamReader& inout_stream, ProfilingData& out_data)
+{
+  EZ_IGNORE_UNUSED(inout_stream);
+  EZ_IGNORE_UNUSED(out_data);
+
+  return EZ_FAILURE;
+}
+
+void ezProfilingSystem::AddCPUScope(const ezProfilingScopeName& name, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezTime scopeTimeout)
+{
+  EZ_IGNORE_UNUSED(name);
   EZ_IGNORE_UNUSED(szFunctionName);
   EZ_IGNORE_UNUSED(beginTime);
   EZ_IGNORE_UNUSED(endTime);
@@ -74,3 +74,29 @@ ezResult ezProfilingUtils::MergeProfilingCaptures(ezStringView sCapturePath1, ez
   ezLog::Info("Merged profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
   return EZ_SUCCESS;
 }
+
+ezResult ezProfilingUtils::ConvertContinuousCapture(ezStringView sContinuousCapturePath, ezStringView sCapturePath)
+{
+  ezProfilingSystem::ProfilingData profilingData;
+  {
+    ezFileReader reader;
+    if (reader.Open(sContinuousCapturePath).Failed() || ezProfilingSystem::ReadContinuousCapture(reader, profilingData).Failed())
+    {
+      ezLog::Error("Failed to read continuous profiling capture: {}.", sContinuousCapturePath);
+      return EZ_FAILURE;
+    }
+  }
+
+  // Same sort index as in SaveProfilingCapture.
+  profilingData.m_uiProcessSortIndex = ezInvalidIndex;
+
+  ezFileWriter fileWriter;
+  if (fileWriter.Open(sCapturePath).Failed() || profilingData.Write(fileWriter).Failed())
+  {
+    ezLog::Error("Failed to write profiling capture: {}.", sCapturePath);
+    return EZ_FAILURE;
+  }
+
+  ezLog::Info("Converted profiling capture saved to '{0}'.", fileWriter.GetFilePathAbsolute().GetData());
+  return EZ_SUCCESS;
+}
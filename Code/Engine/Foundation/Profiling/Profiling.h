@@ -1,14 +1,47 @@
 #pragma once
 
+#include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
 #include <Foundation/System/Process.h>
 #include <Foundation/Time/Time.h>
 
+class ezStreamReader;
 class ezStreamWriter;
 class ezThread;
 
+/// \brief A profiling scope name together with its hash.
+///
+/// The hash of a string constant is computed at compile time, so recording a scope doesn't need to hash its name again.
+/// Other strings are hashed once, when the profiling scope starts.
+struct ezProfilingScopeName
+{
+  template <size_t N>
+  constexpr ezProfilingScopeName(const char (&szName)[N])
+    : m_sName(szName)
+    , m_uiHash(ezHashingUtils::StringHash<N>(szName))
+  {
+  }
+
+  template <size_t N>
+  ezProfilingScopeName(char (&szName)[N])
+    : m_sName(szName)
+    , m_uiHash(ezHashingUtils::StringHash(m_sName))
+  {
+  }
+
+  template <typename T, typename = std::enable_if_t<!std::is_array_v<std::remove_reference_t<T>>>>
+  ezProfilingScopeName(const T& name)
+    : m_sName(name)
+    , m_uiHash(ezHashingUtils::StringHash(m_sName))
+  {
+  }
+
+  ezStringView m_sName;
+  ezUInt64 m_uiHash;
+};
+
 /// \brief This class encapsulates a profiling scope.
 ///
 /// The constructor creates a new scope in the profiling system and the destructor pops the scope.
@@ -16,11 +49,11 @@ class ezThread;
 class EZ_FOUNDATION_DLL ezProfilingScope
 {
 public:
-  ezProfilingScope(ezStringView sName, const char* szFunctionName, ezTime timeout);
+  ezProfilingScope(const ezProfilingScopeName& name, const char* szFunctionName, ezTime timeout);
   ~ezProfilingScope();
 
 protected:
-  ezStringView m_sName;
+  ezProfilingScopeName m_Name;
   const char* m_szFunction;
   ezTime m_BeginTime;
   ezTime m_Timeout;
@@ -37,21 +70,21 @@ protected:
 class ezProfilingListScope
 {
 public:
-  EZ_FOUNDATION_DLL ezProfilingListScope(ezStringView sListName, ezStringView sFirstSectionName, const char* szFunctionName);
+  EZ_FOUNDATION_DLL ezProfilingListScope(const ezProfilingScopeName& listName, const ezProfilingScopeName& firstSectionName, const char* szFunctionName);
   EZ_FOUNDATION_DLL ~ezProfilingListScope();
 
-  EZ_FOUNDATION_DLL static void StartNextSection(ezStringView sNextSectionName);
+  EZ_FOUNDATION_DLL static void StartNextSection(const ezProfilingScopeName& nextSectionName);
 
 protected:
   static thread_local ezProfilingListScope* s_pCurrentList;
 
   ezProfilingListScope* m_pPreviousList;
 
-  ezStringView m_sListName;
+  ezProfilingScopeName m_ListName;
   const char* m_szListFunction;
   ezTime m_ListBeginTime;
 
-  ezStringView m_sCurSectionName;
+  ezProfilingScopeName m_CurSectionName;
   ezTime m_CurSectionBeginTime;
 };
 
@@ -65,16 +98,19 @@ public:
     ezString m_sName;
   };
 
+  /// \brief A recorded CPU scope.
+  ///
+  /// The scope name is stored as an ID into the name table of the profiling system, see ProfilingData::m_ScopeNames.
+  /// Names are interned when a scope name is used for the first time, so recording a scope doesn't need to copy the name.
   struct CPUScope
   {
     EZ_DECLARE_POD_TYPE();
 
-    static constexpr ezUInt32 NAME_SIZE = 40;
-
-    const char* m_szFunctionName;
+    const char* m_szFunctionName; ///< Only set while recording. In ProfilingData it is always nullptr, use m_uiFunctionNameId instead.
     ezTime m_BeginTime;
     ezTime m_EndTime;
-    char m_szName[NAME_SIZE];
+    ezUInt32 m_uiNameId;
+    ezUInt32 m_uiFunctionNameId; ///< Index into ProfilingData::m_ScopeNames, ezInvalidIndex if the scope has no function name.
   };
 
   struct CPUScopesBufferFlat
@@ -110,6 +146,11 @@ public:
 
     ezDynamicArray<ezDynamicArray<GPUScope>> m_GPUScopes;
 
+    /// \brief Resolves CPUScope::m_uiNameId and CPUScope::m_uiFunctionNameId.
+    ///
+    /// Only holds the names that the captured scopes reference, the IDs are only meaningful within the same ProfilingData.
+    ezDynamicArray<ezString> m_ScopeNames;
+
     /// \brief Writes profiling data as JSON to the output stream.
     ezResult Write(ezStreamWriter& ref_outputStream) const;
 
@@ -136,11 +177,27 @@ public:
   static void StartNewFrame();
 
   /// \brief Adds a new scoped event for the calling thread in the profiling system
-  static void AddCPUScope(ezStringView sName, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezTime scopeTimeout);
+  static void AddCPUScope(const ezProfilingScopeName& name, const char* szFunctionName, ezTime beginTime, ezTime endTime, ezTime scopeTimeout);
 
   /// \brief Get current frame counter
   static ezUInt64 GetFrameCount();
 
+  /// \brief Starts streaming all CPU scopes and frame markers into a binary file, until StopContinuousCapture() is called.
+  ///
+  /// In contrast to Capture(), which only returns what still fits into the per-thread ring buffers, a continuous capture records
+  /// everything. The calling threads only append compact events to per-thread buffers, a background thread regularly writes them to the file.
+  /// Use ezProfilingUtils::ConvertContinuousCapture() to convert the file into the JSON format that Write() produces.
+  static ezResult StartContinuousCapture(ezStringView sFilePath);
+
+  /// \brief Writes all remaining events and closes the file that was opened with StartContinuousCapture().
+  static void StopContinuousCapture();
+
+  /// \brief Returns whether a continuous capture is currently running.
+  static bool IsContinuousCaptureActive();
+
+  /// \brief Reads a file that was written by a continuous capture, so that it can be written as JSON with ProfilingData::Write().
+  static ezResult ReadContinuousCapture(ezStreamReader& inout_stream, ProfilingData& out_data);
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, ProfilingSystem);
   friend ezUInt32 RunThread(ezThread* pThread);
@@ -9,4 +9,6 @@ public:
   static ezResult SaveProfilingCapture(ezStringView sCapturePath);
   /// \brief Reads two profiling captures and merges them into one.
   static ezResult MergeProfilingCaptures(ezStringView sCapturePath1, ezStringView sCapturePath2, ezStringView sMergedCapturePath);
+  /// \brief Converts a binary file written by ezProfilingSystem::StartContinuousCapture() into the JSON format of SaveProfilingCapture.
+  static ezResult ConvertContinuousCapture(ezStringView sContinuousCapturePath, ezStringView sCapturePath);
 };
@@ -84,6 +84,23 @@ EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec4i::Truncate(const ezSimdVec4f& f)
   return result;
 }
 
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec4i::ReinterpretAsFloat() const
+{
+  ezSimdVec4f result;
+  ezMemoryUtils::RawByteCopy(&result.m_v, &m_v, sizeof(m_v));
+
+  return result;
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec4i::ReinterpretFromFloat(const ezSimdVec4f& f)
+{
+  ezSimdVec4i result;
+  ezMemoryUtils::RawByteCopy(&result.m_v, &f.m_v, sizeof(f.m_v));
+
+  return result;
+}
+
 template <int N>
 EZ_ALWAYS_INLINE ezInt32 ezSimdVec4i::GetComponent() const
 {
@@ -110,6 +110,17 @@ EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec4i::Truncate(const ezSimdVec4f& f)
   return vcvtq_s32_f32(f.m_v);
 }
 
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec4i::ReinterpretAsFloat() const
+{
+  return vreinterpretq_f32_s32(m_v);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec4i::ReinterpretFromFloat(const ezSimdVec4f& f)
+{
+  return vreinterpretq_s32_f32(f.m_v);
+}
+
 template <int N>
 EZ_ALWAYS_INLINE ezInt32 ezSimdVec4i::GetComponent() const
 {
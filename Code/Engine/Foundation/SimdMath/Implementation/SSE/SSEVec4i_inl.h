@@ -112,6 +112,17 @@ EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec4i::Truncate(const ezSimdVec4f& f)
   return _mm_cvttps_epi32(f.m_v);
 }
 
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec4i::ReinterpretAsFloat() const
+{
+  return _mm_castsi128_ps(m_v);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec4i::ReinterpretFromFloat(const ezSimdVec4f& f)
+{
+  return _mm_castps_si128(f.m_v);
+}
+
 template <int N>
 EZ_ALWAYS_INLINE ezInt32 ezSimdVec4i::GetComponent() const
 {
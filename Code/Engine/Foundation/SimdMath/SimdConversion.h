@@ -3,6 +3,7 @@
 #include <Foundation/Math/BoundingBox.h>
 #include <Foundation/Math/BoundingBoxSphere.h>
 #include <Foundation/Math/BoundingSphere.h>
+#include <Foundation/Math/Float16.h>
 #include <Foundation/Math/Transform.h>
 #include <Foundation/SimdMath/SimdBBox.h>
 #include <Foundation/SimdMath/SimdBBoxSphere.h>
@@ -134,4 +135,60 @@ namespace ezSimdConversion
     return ezBoundingBox::MakeFromMinMax(ToVec3(b.m_Min), ToVec3(b.m_Max));
   }
 
+  /// \brief Converts four consecutive half-precision floats to single precision.
+  ///
+  /// The results are identical to the conversion of ezFloat16, including denormals, infinity and NaN.
+  inline ezSimdVec4f ToVec4(const ezFloat16* pHalfs)
+  {
+    const ezSimdVec4i h(pHalfs[0].GetRawData(), pHalfs[1].GetRawData(), pHalfs[2].GetRawData(), pHalfs[3].GetRawData());
+
+    const ezSimdVec4i shiftedExp(0x7c00 << 13);
+
+    ezSimdVec4i o = (h & ezSimdVec4i(0x7fff)) << 13; // exponent and mantissa
+    const ezSimdVec4i exp = o & shiftedExp;
+    o += ezSimdVec4i((127 - 15) << 23);              // exponent bias
+
+    // infinity and NaN need the maximum exponent
+    o = ezSimdVec4i::Select(exp == shiftedExp, o + ezSimdVec4i((128 - 16) << 23), o);
+
+    // zero and denormals are renormalized by subtracting the smallest normalized half
+    const ezSimdVec4f fMagic = ezSimdVec4i(113 << 23).ReinterpretAsFloat();
+    const ezSimdVec4f fDenormal = (o + ezSimdVec4i(1 << 23)).ReinterpretAsFloat() - fMagic;
+    o = ezSimdVec4i::Select(exp == ezSimdVec4i::MakeZero(), ezSimdVec4i::ReinterpretFromFloat(fDenormal), o);
+
+    return (o | ((h & ezSimdVec4i(0x8000)) << 16)).ReinterpretAsFloat();
+  }
+
+  /// \brief Converts the four components to half-precision and writes them to consecutive ezFloat16 values.
+  ///
+  /// The results are identical to the conversion of ezFloat16, i.e. the mantissa is truncated, not rounded.
+  inline void ToFloat16(const ezSimdVec4f& v, ezFloat16* out_pHalfs)
+  {
+    const ezSimdVec4i zero = ezSimdVec4i::MakeZero();
+    const ezSimdVec4i i = ezSimdVec4i::ReinterpretFromFloat(v);
+
+    const ezSimdVec4i s = (i >> 16) & ezSimdVec4i(0x8000);
+    const ezSimdVec4i e = ((i >> 23) & ezSimdVec4i(0xff)) - ezSimdVec4i(127 - 15);
+    const ezSimdVec4i m = i & ezSimdVec4i(0x007fffff);
+
+    ezSimdVec4i h = (e << 10) | (m >> 13);
+
+    // denormals, scaling by 2^24 turns the smallest half denormal into 1
+    const ezSimdVec4i denormal = ezSimdVec4i::Truncate(v.Abs() * ezSimdFloat(16777216.0f));
+    h = ezSimdVec4i::Select(e <= zero, denormal, h);
+
+    // overflow and infinity, NaN keeps the upper bits of its payload
+    const ezSimdVec4b isNaN = (e == ezSimdVec4i(0xff - (127 - 15))) && (m != zero);
+    const ezSimdVec4i nanMantissa = ezSimdVec4i::Select(isNaN, (m >> 13).CompMax(ezSimdVec4i(1)), zero);
+    h = ezSimdVec4i::Select(e > ezSimdVec4i(30), ezSimdVec4i(0x7c00) | nanMantissa, h);
+
+    // values that are too small for a denormal become positive zero
+    h = ezSimdVec4i::Select(e < ezSimdVec4i(-10), zero, h | s);
+
+    out_pHalfs[0].SetRawData(static_cast<ezUInt16>(h.x()));
+    out_pHalfs[1].SetRawData(static_cast<ezUInt16>(h.y()));
+    out_pHalfs[2].SetRawData(static_cast<ezUInt16>(h.z()));
+    out_pHalfs[3].SetRawData(static_cast<ezUInt16>(h.w()));
+  }
+
 }; // namespace ezSimdConversion
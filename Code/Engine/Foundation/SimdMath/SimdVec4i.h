@@ -41,6 +41,12 @@ public:
 
   [[nodiscard]] static ezSimdVec4i Truncate(const ezSimdVec4f& f); // [tested]
 
+  /// \brief Returns the bits of this vector as an ezSimdVec4f, without any numeric conversion.
+  ezSimdVec4f ReinterpretAsFloat() const; // [tested]
+
+  /// \brief Returns the bits of the given float vector as integers, without any numeric conversion.
+  [[nodiscard]] static ezSimdVec4i ReinterpretFromFloat(const ezSimdVec4f& f); // [tested]
+
 public:
   template <int N>
   ezInt32 GetComponent() const; // [tested]
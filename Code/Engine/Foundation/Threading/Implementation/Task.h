@@ -88,6 +88,19 @@ private:
   /// \brief Decremented when a task is finished, set to zero when canceled.
   ezAtomicInteger32 m_iRemainingRuns;
 
+  /// \brief Hands out the invocation indices for tasks that are executed from the work-stealing queues.
+  ezAtomicInteger32 m_iNextInvocation;
+
+  /// \brief Decides whether a queued task without multiplicity gets executed or canceled. See ExecutionClaim.
+  ezAtomicInteger32 m_iExecutionClaim;
+
+  enum ExecutionClaim : ezInt32
+  {
+    Unclaimed = 0,
+    Executing = 1,
+    Canceled = 2,
+  };
+
   /// \brief Set to true when the task is SUPPOSED to cancel. Whether the task is able to do that, depends on its implementation.
   bool m_bCancelExecution = false;
 
@@ -4,6 +4,7 @@
 #include <Foundation/Threading/Implementation/TaskGroup.h>
 #include <Foundation/Threading/Implementation/TaskSystemState.h>
 #include <Foundation/Threading/Implementation/TaskWorkerThread.h>
+#include <Foundation/Threading/Lock.h>
 #include <Foundation/Threading/TaskSystem.h>
 
 ezMutex ezTaskSystem::s_TaskSystemMutex;
@@ -62,4 +63,70 @@ void ezTaskSystem::SetTargetFrameTime(ezTime targetFrameTime)
   s_pState->m_TargetFrameTime = targetFrameTime;
 }
 
+void ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::Enum mode)
+{
+  EZ_LOCK(s_TaskSystemMutex);
+
+  if (s_pState->m_SchedulerMode == mode)
+    return;
+
+  s_pState->m_SchedulerMode = mode;
+
+  if (mode != ezTaskSchedulerMode::WorkStealing)
+  {
+    // new tasks are only pushed into the local queues while holding the mutex, so they can't fill up again
+    for (ezUInt32 type = 0; type < ezWorkerThreadType::ENUM_COUNT; ++type)
+    {
+      const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
+
+      for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+      {
+        MoveLocalTasksToSharedQueue(s_pThreadState->m_Workers[type][i]);
+      }
+    }
+  }
+}
+
+ezTaskSchedulerMode::Enum ezTaskSystem::GetSchedulerMode()
+{
+  return s_pState->m_SchedulerMode;
+}
+
+ezTaskSchedulerStats ezTaskSystem::GetSchedulerStats()
+{
+  ezTaskSchedulerStats stats;
+  stats.m_uiTasksFromSharedQueue = s_pState->m_uiNumSharedQueueTasks;
+  stats.m_uiTasksStolen = s_pState->m_iNumStolenTasks;
+
+  for (ezUInt32 type = 0; type < ezWorkerThreadType::ENUM_COUNT; ++type)
+  {
+    const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
+
+    for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      stats.m_uiTasksFromLocalQueue += static_cast<ezUInt32>(s_pThreadState->m_Workers[type][i]->m_iNumLocalQueueTasks);
+    }
+  }
+
+  return stats;
+}
+
+void ezTaskSystem::ResetSchedulerStats()
+{
+  EZ_LOCK(s_TaskSystemMutex);
+
+  s_pState->m_uiNumSharedQueueTasks = 0;
+  s_pState->m_iNumStolenTasks = 0;
+
+  for (ezUInt32 type = 0; type < ezWorkerThreadType::ENUM_COUNT; ++type)
+  {
+    const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
+
+    for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      s_pThreadState->m_Workers[type][i]->m_iNumLocalQueueTasks = 0;
+    }
+  }
+}
+
 EZ_STATICLINK_FILE(Foundation, Foundation_Threading_Implementation_TaskSystem);
@@ -98,6 +98,27 @@ struct ezWorkerThreadType
   static const char* GetThreadTypeName(ezWorkerThreadType::Enum threadType);
 };
 
+/// \brief Describes how the ezTaskSystem hands out scheduled tasks to the worker threads.
+struct ezTaskSchedulerMode
+{
+  enum Enum : ezUInt8
+  {
+    SharedQueue,  ///< All tasks are stored in one list per priority, which is protected by the task system mutex.
+    WorkStealing, ///< Tasks that are scheduled by a worker thread are put into lock-free queues owned by that worker. Idle workers steal
+                  ///< tasks from other workers. Reduces lock contention when many small tasks are spawned from within tasks.
+
+    Default = SharedQueue
+  };
+};
+
+/// \brief Counters that show from where the worker threads picked up their tasks. See ezTaskSystem::GetSchedulerStats().
+struct ezTaskSchedulerStats
+{
+  ezUInt64 m_uiTasksFromSharedQueue = 0; ///< Tasks that were taken from the mutex protected queues.
+  ezUInt64 m_uiTasksFromLocalQueue = 0;  ///< Tasks that a worker took from its own queue (only in ezTaskSchedulerMode::WorkStealing).
+  ezUInt64 m_uiTasksStolen = 0;          ///< Tasks that were taken from another worker's queue (only in ezTaskSchedulerMode::WorkStealing).
+};
+
 /// \brief Given out by ezTaskSystem::CreateTaskGroup to identify a task group.
 class EZ_FOUNDATION_DLL ezTaskGroupID
 {
@@ -156,10 +156,19 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
     {
       iRemainingTasks += ezMath::Max(1u, pTask->m_uiMultiplicity);
       pTask->m_iRemainingRuns = ezMath::Max(1u, pTask->m_uiMultiplicity);
+      pTask->m_iNextInvocation = 0;
+      pTask->m_iExecutionClaim = ezTask::Unclaimed;
     }
 
     pGroup->m_iNumRemainingTasks = iRemainingTasks;
 
+    // in work-stealing mode, a worker thread puts the tasks into its own queue, from where other workers can steal them
+    // the entries point into pGroup->m_Tasks, which stays unmodified until all tasks of the group are finished
+    ezTaskWorkerThread::LocalQueue* pLocalQueue = nullptr;
+    if (s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing && tl_TaskWorkerInfo.m_pWorkerThread != nullptr)
+    {
+      pLocalQueue = tl_TaskWorkerInfo.m_pWorkerThread->GetLocalQueue(pGroup->m_Priority);
+    }
 
     for (ezUInt32 task = 0; task < pGroup->m_Tasks.GetCount(); ++task)
     {
@@ -167,16 +176,36 @@ void ezTaskSystem::ScheduleGroupTasks(ezTaskGroup* pGroup, bool bHighPriority)
 
       for (ezUInt32 mult = 0; mult < ezMath::Max(1u, pTask->m_uiMultiplicity); ++mult)
       {
+        pTask->m_bTaskIsScheduled = true;
+
+        if (pLocalQueue != nullptr)
+        {
+          if (pLocalQueue->PushBottom(&pTask))
+            continue;
+
+          // the local queue is full, the remaining invocations go into the shared queue
+          TaskData td = MakeTaskData(pTask);
+
+          if (bHighPriority)
+            s_pState->m_Tasks[pGroup->m_Priority].PushFront(td);
+          else
+            s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+
+          s_pState->m_iNumSharedTasks[pGroup->m_Priority].Increment();
+          continue;
+        }
+
         TaskData td;
         td.m_pBelongsToGroup = pGroup;
         td.m_pTask = pTask;
-        td.m_pTask->m_bTaskIsScheduled = true;
         td.m_uiInvocation = mult;
 
         if (bHighPriority)
           s_pState->m_Tasks[pGroup->m_Priority].PushFront(td);
         else
           s_pState->m_Tasks[pGroup->m_Priority].PushBack(td);
+
+        s_pState->m_iNumSharedTasks[pGroup->m_Priority].Increment();
       }
     }
 
@@ -31,4 +31,14 @@ private:
 
   // The lists of all scheduled tasks, for each priority.
   ezList<ezTaskSystem::TaskData> m_Tasks[ezTaskPriority::ENUM_COUNT];
+
+  // The number of tasks in each of the m_Tasks lists. Allows to check for work without entering the mutex.
+  ezAtomicInteger32 m_iNumSharedTasks[ezTaskPriority::ENUM_COUNT];
+
+  // How tasks are distributed to the worker threads. Only modified while holding the task system mutex.
+  ezTaskSchedulerMode::Enum m_SchedulerMode = ezTaskSchedulerMode::Default;
+
+  // Statistics, see ezTaskSystem::GetSchedulerStats()
+  ezUInt64 m_uiNumSharedQueueTasks = 0; // only modified while holding the task system mutex
+  ezAtomicInteger64 m_iNumStolenTasks;
 };
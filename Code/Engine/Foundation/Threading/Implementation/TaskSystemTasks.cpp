@@ -94,6 +94,11 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   EZ_ASSERT_DEV(FirstPriority >= ezTaskPriority::EarlyThisFrame && LastPriority < ezTaskPriority::ENUM_COUNT, "Priority Range is invalid: {0} to {1}",
     FirstPriority, LastPriority);
 
+  if (s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing)
+  {
+    return GetNextTaskWorkStealing(FirstPriority, LastPriority, bOnlyTasksThatNeverWait, WaitingForGroup, pWorkerState);
+  }
+
   EZ_LOCK(s_TaskSystemMutex);
 
   // go through all the task lists that this thread is willing to work on
@@ -106,6 +111,8 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
         TaskData td = *it;
 
         s_pState->m_Tasks[prio].Remove(it);
+        s_pState->m_iNumSharedTasks[prio].Decrement();
+        ++s_pState->m_uiNumSharedQueueTasks;
         return td;
       }
     }
@@ -119,6 +126,215 @@ ezTaskSystem::TaskData ezTaskSystem::GetNextTask(ezTaskPriority::Enum FirstPrior
   return TaskData();
 }
 
+ezTaskSystem::TaskData ezTaskSystem::GetNextTaskWorkStealing(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority,
+  bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState)
+{
+  ezTaskWorkerThread* pWorker = tl_TaskWorkerInfo.m_pWorkerThread;
+  TaskData td;
+
+  while (true)
+  {
+    for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+    {
+      const ezTaskPriority::Enum priority = (ezTaskPriority::Enum)prio;
+
+      // prefer our own tasks, they are most likely to still be in the cache
+      if (pWorker != nullptr && TakeTaskFromLocalQueue(pWorker, priority, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+        return td;
+
+      if (TakeTaskFromSharedQueue(priority, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+        return td;
+
+      if (UsesLocalQueues(priority) && StealTask(priority, bOnlyTasksThatNeverWait, WaitingForGroup, td))
+        return td;
+    }
+
+    if (pWorkerState == nullptr)
+      return TaskData();
+
+    EZ_VERIFY(pWorkerState->Set((int)ezTaskWorkerState::Idle) == (int)ezTaskWorkerState::Active, "Corrupt Worker State");
+
+    // Tasks may have been queued after we looked and before we went idle. The thread that queued them may have seen us as
+    // 'active' and thus not woken anyone up. Setting the worker state is a full memory barrier, so one more check is sufficient.
+    if (!HasQueuedTasks(FirstPriority, LastPriority))
+      return TaskData();
+
+    if (pWorkerState->CompareAndSwap((int)ezTaskWorkerState::Idle, (int)ezTaskWorkerState::Active) != (int)ezTaskWorkerState::Idle)
+    {
+      // someone else has woken us up in the mean time, the raised wake-up signal will make the thread look for work again
+      return TaskData();
+    }
+  }
+}
+
+bool ezTaskSystem::TakeTaskFromSharedQueue(ezTaskPriority::Enum priority, bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup, TaskData& out_task)
+{
+  // allows to skip the mutex entirely, when there is nothing to do
+  if (s_pState->m_iNumSharedTasks[priority] == 0)
+    return false;
+
+  EZ_LOCK(s_TaskSystemMutex);
+
+  for (auto it = s_pState->m_Tasks[priority].GetIterator(); it.IsValid(); ++it)
+  {
+    if (!bOnlyTasksThatNeverWait || (it->m_pTask->m_NestingMode == ezTaskNesting::Never) || it->m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+    {
+      out_task = *it;
+
+      s_pState->m_Tasks[priority].Remove(it);
+      s_pState->m_iNumSharedTasks[priority].Decrement();
+      ++s_pState->m_uiNumSharedQueueTasks;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool ezTaskSystem::TakeTaskFromLocalQueue(ezTaskWorkerThread* pWorker, ezTaskPriority::Enum priority, bool bOnlyTasksThatNeverWait,
+  const ezTaskGroupID& WaitingForGroup, TaskData& out_task)
+{
+  ezTaskWorkerThread::LocalQueue* pQueue = pWorker->GetLocalQueue(priority);
+
+  if (pQueue == nullptr)
+    return false;
+
+  while (const ezSharedPtr<ezTask>* pEntry = pQueue->PopBottom())
+  {
+    TaskData td = MakeTaskData(*pEntry);
+
+    if (!bOnlyTasksThatNeverWait || (td.m_pTask->m_NestingMode == ezTaskNesting::Never) || td.m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+    {
+      pWorker->m_iNumLocalQueueTasks.Increment();
+      out_task = std::move(td);
+      return true;
+    }
+
+    // this thread is waiting for another group and must not pick up tasks that may wait themselves
+    // hand the task over to the shared queue, so that some other thread executes it
+    AddTaskToSharedQueue(std::move(td), priority);
+  }
+
+  return false;
+}
+
+bool ezTaskSystem::StealTask(ezTaskPriority::Enum priority, bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup, TaskData& out_task)
+{
+  const ezWorkerThreadType::Enum victimType = GetWorkerTypeForPriority(priority);
+  const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[victimType];
+
+  // start with a different victim on every worker, to spread out the contention
+  const ezUInt32 uiFirstVictim = (tl_TaskWorkerInfo.m_WorkerType == victimType) ? static_cast<ezUInt32>(tl_TaskWorkerInfo.m_iWorkerIndex + 1) : 0u;
+
+  for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+  {
+    ezTaskWorkerThread* pVictim = s_pThreadState->m_Workers[victimType][(uiFirstVictim + i) % uiNumWorkers];
+
+    if (pVictim == tl_TaskWorkerInfo.m_pWorkerThread)
+      continue;
+
+    ezTaskWorkerThread::LocalQueue* pQueue = pVictim->GetLocalQueue(priority);
+
+    while (!pQueue->IsEmpty())
+    {
+      const ezSharedPtr<ezTask>* pEntry = pQueue->Steal();
+
+      // lost the race against another thread, try again as long as there is something left
+      if (pEntry == nullptr)
+        continue;
+
+      TaskData td = MakeTaskData(*pEntry);
+
+      if (!bOnlyTasksThatNeverWait || (td.m_pTask->m_NestingMode == ezTaskNesting::Never) || td.m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup)
+      {
+        s_pState->m_iNumStolenTasks.Increment();
+        out_task = std::move(td);
+        return true;
+      }
+
+      // see TakeTaskFromLocalQueue()
+      AddTaskToSharedQueue(std::move(td), priority);
+      break;
+    }
+  }
+
+  return false;
+}
+
+bool ezTaskSystem::HasQueuedTasks(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority)
+{
+  for (ezUInt32 prio = FirstPriority; prio <= (ezUInt32)LastPriority; ++prio)
+  {
+    if (s_pState->m_iNumSharedTasks[prio] > 0)
+      return true;
+
+    if (!UsesLocalQueues((ezTaskPriority::Enum)prio))
+      continue;
+
+    const ezWorkerThreadType::Enum type = GetWorkerTypeForPriority((ezTaskPriority::Enum)prio);
+    const ezUInt32 uiNumWorkers = s_pThreadState->m_iAllocatedWorkers[type];
+
+    for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
+    {
+      if (!s_pThreadState->m_Workers[type][i]->GetLocalQueue((ezTaskPriority::Enum)prio)->IsEmpty())
+        return true;
+    }
+  }
+
+  return false;
+}
+
+void ezTaskSystem::AddTaskToSharedQueue(TaskData&& task, ezTaskPriority::Enum priority)
+{
+  {
+    EZ_LOCK(s_TaskSystemMutex);
+
+    s_pState->m_Tasks[priority].PushBack() = std::move(task);
+    s_pState->m_iNumSharedTasks[priority].Increment();
+  }
+
+  const ezWorkerThreadType::Enum type = GetWorkerTypeForPriority(priority);
+
+  if (type != ezWorkerThreadType::MainThread)
+  {
+    WakeUpThreads(type, 1);
+  }
+}
+
+void ezTaskSystem::MoveLocalTasksToSharedQueue(ezTaskWorkerThread* pWorker)
+{
+  EZ_LOCK(s_TaskSystemMutex);
+
+  for (ezUInt32 prio = 0; prio < ezTaskPriority::ENUM_COUNT; ++prio)
+  {
+    ezTaskWorkerThread::LocalQueue* pQueue = pWorker->GetLocalQueue((ezTaskPriority::Enum)prio);
+
+    if (pQueue == nullptr)
+      continue;
+
+    // the owner may still pop concurrently, so take the tasks out the same way other threads steal them
+    while (!pQueue->IsEmpty())
+    {
+      if (const ezSharedPtr<ezTask>* pEntry = pQueue->Steal())
+      {
+        s_pState->m_Tasks[prio].PushBack(MakeTaskData(*pEntry));
+        s_pState->m_iNumSharedTasks[prio].Increment();
+      }
+    }
+  }
+}
+
+ezTaskSystem::TaskData ezTaskSystem::MakeTaskData(const ezSharedPtr<ezTask>& pTask)
+{
+  TaskData td;
+  td.m_pTask = pTask;
+  td.m_pBelongsToGroup = pTask->m_BelongsToGroup.m_pTaskGroup;
+
+  // tasks in the local queues don't store which invocation they are, whoever dequeues an entry takes the next one
+  td.m_uiInvocation = pTask->m_iNextInvocation.PostIncrement();
+  return td;
+}
+
 bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
   const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState)
 {
@@ -135,6 +351,13 @@ bool ezTaskSystem::ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriorit
     EZ_ASSERT_DEV(td.m_pBelongsToGroup == WaitingForGroup.m_pTaskGroup, "");
   }
 
+  if (!td.m_pTask->m_bUsesMultiplicity && !td.m_pTask->m_iExecutionClaim.TestAndSet(ezTask::Unclaimed, ezTask::Executing))
+  {
+    // the task was canceled while it was queued (see CancelTask()), just mark it as finished
+    TaskHasFinished(std::move(td.m_pTask), td.m_pBelongsToGroup);
+    return true;
+  }
+
   tl_TaskWorkerInfo.m_bAllowNestedTasks = td.m_pTask->m_NestingMode != ezTaskNesting::Never;
   tl_TaskWorkerInfo.m_szTaskName = td.m_pTask->m_sTaskName;
   td.m_pTask->Run(td.m_uiInvocation);
@@ -191,6 +414,7 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
             TaskHasFinished(std::move(it->m_pTask), it->m_pBelongsToGroup);
 
             s_pState->m_Tasks[i].Remove(it);
+            s_pState->m_iNumSharedTasks[i].Decrement();
             return EZ_SUCCESS;
           }
 
@@ -198,6 +422,17 @@ ezResult ezTaskSystem::CancelTask(const ezSharedPtr<ezTask>& pTask, ezOnTaskRunn
         }
       }
     }
+
+    // in work-stealing mode the task may still sit in the queue of some worker thread, from where it can't be removed
+    // instead claim it for cancellation, whoever dequeues it will then skip its execution
+    // in the shared queue mode, a scheduled task that is not in the queue anymore is already running, as before
+    if (s_pState->m_SchedulerMode == ezTaskSchedulerMode::WorkStealing && pTask->m_bTaskIsScheduled && !pTask->m_bUsesMultiplicity &&
+        pTask->m_iExecutionClaim.TestAndSet(ezTask::Unclaimed, ezTask::Canceled))
+    {
+      // we set the task to finished, even though it was not executed
+      pTask->m_iRemainingRuns = 0;
+      return EZ_SUCCESS;
+    }
   }
 
   // if we made it here, the task was already running
@@ -277,6 +512,11 @@ void ezTaskSystem::ReprioritizeFrameTasks()
     // remove the tasks from their current queue
     s_pState->m_Tasks[i].Clear();
   }
+
+  for (ezUInt32 i = (ezUInt32)ezTaskPriority::EarlyThisFrame; i <= (ezUInt32)ezTaskPriority::In9Frames; ++i)
+  {
+    s_pState->m_iNumSharedTasks[i] = s_pState->m_Tasks[i].GetCount();
+  }
 }
 
 void ezTaskSystem::ExecuteSomeFrameTasks(ezTime smoothFrameTime)
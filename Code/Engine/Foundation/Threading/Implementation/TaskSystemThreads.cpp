@@ -96,6 +96,10 @@ void ezTaskSystem::StopWorkerThreads()
     for (ezUInt32 i = 0; i < uiNumWorkers; ++i)
     {
       s_pThreadState->m_Workers[type][i]->Join();
+
+      // don't lose tasks that were still queued on this worker, new workers will pick them up from the shared queue
+      MoveLocalTasksToSharedQueue(s_pThreadState->m_Workers[type][i]);
+
       EZ_DEFAULT_DELETE(s_pThreadState->m_Workers[type][i]);
     }
 
@@ -188,6 +192,11 @@ ezWorkerThreadType::Enum ezTaskSystem::GetCurrentThreadWorkerType()
   return tl_TaskWorkerInfo.m_WorkerType;
 }
 
+bool ezTaskSystem::IsCurrentThreadAllowedToWait()
+{
+  return tl_TaskWorkerInfo.m_bAllowNestedTasks;
+}
+
 double ezTaskSystem::GetThreadUtilization(ezWorkerThreadType::Enum type, ezUInt32 uiThreadIndex, ezUInt32* pNumTasksExecuted /*= nullptr*/)
 {
   return s_pThreadState->m_Workers[type][uiThreadIndex]->GetThreadUtilization(pNumTasksExecuted);
@@ -240,3 +249,40 @@ void ezTaskSystem::DetermineTasksToExecuteOnThread(ezTaskPriority::Enum& out_Fir
     }
   }
 }
+
+bool ezTaskSystem::UsesLocalQueues(ezTaskPriority::Enum priority)
+{
+  switch (priority)
+  {
+    case ezTaskPriority::EarlyThisFrame:
+    case ezTaskPriority::ThisFrame:
+    case ezTaskPriority::LateThisFrame:
+    case ezTaskPriority::LongRunningHighPriority:
+    case ezTaskPriority::LongRunning:
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+ezWorkerThreadType::Enum ezTaskSystem::GetWorkerTypeForPriority(ezTaskPriority::Enum priority)
+{
+  switch (priority)
+  {
+    case ezTaskPriority::LongRunningHighPriority:
+    case ezTaskPriority::LongRunning:
+      return ezWorkerThreadType::LongTasks;
+
+    case ezTaskPriority::FileAccessHighPriority:
+    case ezTaskPriority::FileAccess:
+      return ezWorkerThreadType::FileAccess;
+
+    case ezTaskPriority::ThisFrameMainThread:
+    case ezTaskPriority::SomeFrameMainThread:
+      return ezWorkerThreadType::MainThread;
+
+    default:
+      return ezWorkerThreadType::ShortTasks;
+  }
+}
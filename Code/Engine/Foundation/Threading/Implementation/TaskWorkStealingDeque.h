@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Foundation/Threading/AtomicInteger.h>
+
+/// \internal Fixed-capacity, lock-free work-stealing deque (Chase-Lev).
+///
+/// Only the owning thread may call PushBottom() and PopBottom(). Any thread may call Steal() concurrently.
+/// The owner works in LIFO order on the bottom end, thieves take the oldest items from the top end.
+/// The deque only stores pointers, the pointed-to data has to stay alive until it has been popped or stolen.
+///
+/// All index updates go through ezAtomicInteger64, which uses full memory barriers on every platform,
+/// so the sequentially consistent ordering the algorithm relies on is guaranteed.
+template <typename T>
+class ezTaskWorkStealingDeque
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezTaskWorkStealingDeque);
+
+public:
+  static constexpr ezInt64 Capacity = 1024;
+
+  ezTaskWorkStealingDeque() = default;
+
+  /// \brief Adds an item at the bottom. Returns false if the deque is full, in which case the item needs to be stored elsewhere.
+  bool PushBottom(T* pItem)
+  {
+    const ezInt64 b = m_iBottom;
+    const ezInt64 t = m_iTop;
+
+    if (b - t >= Capacity)
+      return false;
+
+    m_Items[b & (Capacity - 1)] = reinterpret_cast<ezInt64>(pItem);
+
+    // publishes the item to thieves
+    m_iBottom = b + 1;
+    return true;
+  }
+
+  /// \brief Removes the most recently pushed item. Returns nullptr if the deque is empty or the last item was stolen concurrently.
+  T* PopBottom()
+  {
+    const ezInt64 b = m_iBottom - 1;
+    m_iBottom.Set(b);
+
+    const ezInt64 t = m_iTop;
+
+    if (t > b)
+    {
+      // was empty, restore the previous state
+      m_iBottom = b + 1;
+      return nullptr;
+    }
+
+    T* pItem = reinterpret_cast<T*>((ezInt64)m_Items[b & (Capacity - 1)]);
+
+    if (t == b)
+    {
+      // this was the last item, race against the thieves for it
+      if (!m_iTop.TestAndSet(t, t + 1))
+        pItem = nullptr;
+
+      m_iBottom = t + 1;
+    }
+
+    return pItem;
+  }
+
+  /// \brief Removes the oldest item. Returns nullptr if the deque is empty or another thread won the race for that item.
+  T* Steal()
+  {
+    const ezInt64 t = m_iTop;
+    const ezInt64 b = m_iBottom;
+
+    if (t >= b)
+      return nullptr;
+
+    T* pItem = reinterpret_cast<T*>((ezInt64)m_Items[t & (Capacity - 1)]);
+
+    // only dereference the item if we actually won it
+    if (!m_iTop.TestAndSet(t, t + 1))
+      return nullptr;
+
+    return pItem;
+  }
+
+  /// \brief Returns whether the deque currently holds no items. This is only a snapshot when called from other threads.
+  bool IsEmpty() const { return (ezInt64)m_iTop >= (ezInt64)m_iBottom; }
+
+private:
+  static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+  // top and bottom are written by different threads, keep them on separate cache lines
+  ezAtomicInteger64 m_iTop;
+  ezUInt8 m_TopPadding[64 - sizeof(ezAtomicInteger64)];
+  ezAtomicInteger64 m_iBottom;
+  ezUInt8 m_BottomPadding[64 - sizeof(ezAtomicInteger64)];
+  ezAtomicInteger64 m_Items[Capacity];
+};
@@ -19,6 +19,14 @@ ezTaskWorkerThread::ezTaskWorkerThread(ezWorkerThreadType::Enum threadType, ezUI
 {
   m_WorkerType = threadType;
   m_uiWorkerThreadNumber = uiThreadNumber & 0xFFFF;
+
+  for (ezUInt32 prio = 0; prio < ezTaskPriority::ENUM_COUNT; ++prio)
+  {
+    if (ezTaskSystem::UsesLocalQueues((ezTaskPriority::Enum)prio) && ezTaskSystem::GetWorkerTypeForPriority((ezTaskPriority::Enum)prio) == threadType)
+    {
+      m_LocalQueues[prio] = EZ_DEFAULT_NEW(LocalQueue);
+    }
+  }
 }
 
 ezTaskWorkerThread::~ezTaskWorkerThread() = default;
@@ -49,6 +57,7 @@ ezUInt32 ezTaskWorkerThread::Run()
   tl_TaskWorkerInfo.m_WorkerType = m_WorkerType;
   tl_TaskWorkerInfo.m_iWorkerIndex = m_uiWorkerThreadNumber;
   tl_TaskWorkerInfo.m_pWorkerState = &m_iWorkerState;
+  tl_TaskWorkerInfo.m_pWorkerThread = this;
 
   const bool bIsReserve = m_uiWorkerThreadNumber >= ezTaskSystem::s_pThreadState->m_uiMaxWorkersToUse[m_WorkerType];
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Implementation/TaskWorkStealingDeque.h>
 
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Threading/ThreadSignal.h>
@@ -75,6 +76,25 @@ private:
   ezAtomicInteger32 m_iWorkerState; // ezTaskWorkerState
 
   ///@}
+
+  /// \name Work Stealing
+  ///@{
+
+public:
+  using LocalQueue = ezTaskWorkStealingDeque<const ezSharedPtr<ezTask>>;
+
+  /// \brief Returns the lock-free queue for tasks of the given priority, or nullptr if this worker does not keep one for that priority.
+  ///
+  /// Only the worker itself may push and pop, all other threads may only steal from it.
+  LocalQueue* GetLocalQueue(ezTaskPriority::Enum priority) { return m_LocalQueues[priority].Borrow(); }
+
+  /// \brief How many tasks this worker took from its own queue since the last reset.
+  ezAtomicInteger32 m_iNumLocalQueueTasks;
+
+private:
+  ezUniquePtr<LocalQueue> m_LocalQueues[ezTaskPriority::ENUM_COUNT];
+
+  ///@}
 };
 
 /// \internal Thread local state used by the task system (and for better debugging)
@@ -85,6 +105,7 @@ struct ezTaskWorkerInfo
   ezInt32 m_iWorkerIndex = -1;
   const char* m_szTaskName = nullptr;
   ezAtomicInteger32* m_pWorkerState = nullptr;
+  ezTaskWorkerThread* m_pWorkerThread = nullptr;
 };
 
 extern thread_local ezTaskWorkerInfo tl_TaskWorkerInfo;
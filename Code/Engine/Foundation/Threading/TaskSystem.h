@@ -90,6 +90,40 @@ private:
   static bool ExecuteTask(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
     const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
 
+  /// \brief GetNextTask() for ezTaskSchedulerMode::WorkStealing. Checks the thread's own queue, the shared queue and other workers' queues.
+  static TaskData GetNextTaskWorkStealing(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority, bool bOnlyTasksThatNeverWait,
+    const ezTaskGroupID& WaitingForGroup, ezAtomicInteger32* pWorkerState);
+
+  /// \brief Takes a task of the given priority from the mutex protected queue.
+  static bool TakeTaskFromSharedQueue(ezTaskPriority::Enum priority, bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup, TaskData& out_task);
+
+  /// \brief Pops a task of the given priority from the calling worker's own queue.
+  static bool TakeTaskFromLocalQueue(ezTaskWorkerThread* pWorker, ezTaskPriority::Enum priority, bool bOnlyTasksThatNeverWait,
+    const ezTaskGroupID& WaitingForGroup, TaskData& out_task);
+
+  /// \brief Steals a task of the given priority from the queue of some other worker thread.
+  static bool StealTask(ezTaskPriority::Enum priority, bool bOnlyTasksThatNeverWait, const ezTaskGroupID& WaitingForGroup, TaskData& out_task);
+
+  /// \brief Returns true if any queue holds a task with a priority in the given range.
+  static bool HasQueuedTasks(ezTaskPriority::Enum FirstPriority, ezTaskPriority::Enum LastPriority);
+
+  /// \brief Adds a task to the mutex protected queue and makes sure a worker thread is awake to pick it up.
+  static void AddTaskToSharedQueue(TaskData&& task, ezTaskPriority::Enum priority);
+
+  /// \brief Moves all tasks out of the worker's own queues into the shared queues. Only used while no new tasks can be pushed to the worker.
+  static void MoveLocalTasksToSharedQueue(ezTaskWorkerThread* pWorker);
+
+  /// \brief Creates the TaskData for an entry that was taken out of a worker's own queue.
+  static TaskData MakeTaskData(const ezSharedPtr<ezTask>& pTask);
+
+  /// \brief Whether worker threads keep tasks of the given priority in their own queues (in ezTaskSchedulerMode::WorkStealing).
+  ///
+  /// 'Next frame' priorities are re-prioritized every frame, which only works on the shared queues.
+  static bool UsesLocalQueues(ezTaskPriority::Enum priority);
+
+  /// \brief Returns the type of worker thread that executes tasks of the given priority. Returns ezWorkerThreadType::MainThread for main thread tasks.
+  static ezWorkerThreadType::Enum GetWorkerTypeForPriority(ezTaskPriority::Enum priority);
+
   /// \brief Called whenever a task has been finished/canceled. Makes sure that groups are marked as finished when all tasks are done.
   static void TaskHasFinished(ezSharedPtr<ezTask>&& pTask, ezTaskGroup* pGroup);
 
@@ -208,6 +242,12 @@ public:
   /// \brief Returns the (thread local) type of tasks that would be executed on this thread
   static ezWorkerThreadType::Enum GetCurrentThreadWorkerType();
 
+  /// \brief Returns false while this thread executes a task that is flagged with ezTaskNesting::Never.
+  ///
+  /// Such a task must not wait for other tasks, neither through WaitForGroup() nor through ParallelFor() and friends.
+  /// Code that is called from arbitrary tasks can use this to fall back to serial execution.
+  static bool IsCurrentThreadAllowedToWait();
+
   /// \brief Returns the utilization (0.0 to 1.0) of the given thread. Note: This will only be valid, if FinishFrameTasks() is called once
   /// per frame.
   ///
@@ -300,6 +340,23 @@ public:
   /// \see FinishFrameTasks() for more details.
   static void SetTargetFrameTime(ezTime targetFrameTime = ezTime::MakeFromSeconds(1.0 / 40.0) /* 40 FPS -> 25 ms */);
 
+  /// \brief Selects how tasks are distributed to the worker threads. See ezTaskSchedulerMode.
+  ///
+  /// Can be changed at any time. When switching away from ezTaskSchedulerMode::WorkStealing, all tasks that are still
+  /// in the workers' own queues are moved into the shared queues.
+  static void SetSchedulerMode(ezTaskSchedulerMode::Enum mode);
+
+  /// \brief Returns the currently used ezTaskSchedulerMode.
+  static ezTaskSchedulerMode::Enum GetSchedulerMode();
+
+  /// \brief Returns how many tasks were taken from which kind of queue since the last call to ResetSchedulerStats().
+  ///
+  /// The values are gathered without synchronization and are only meant for profiling purposes.
+  static ezTaskSchedulerStats GetSchedulerStats();
+
+  /// \brief Resets the counters returned by GetSchedulerStats().
+  static void ResetSchedulerStats();
+
 private:
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Foundation, TaskSystem);
 
@@ -175,36 +175,51 @@ bool ezSensorComponent::RunSensorCheck(ezPhysicsWorldModuleInterface* pPhysicsWo
 
   if (m_bTestVisibility && pPhysicsWorldModule)
   {
+    const ezUInt32 uiNumObjects = out_objectsInSensorVolume.GetCount();
+
+    ezHybridArray<ezPhysicsRaycastQuery, 32> rays;
+    ezHybridArray<ezPhysicsCastResult, 32> hitResults;
+    ezHybridArray<bool, 32> hits;
+    rays.SetCountUninitialized(uiNumObjects);
+    hitResults.SetCount(uiNumObjects);
+    hits.SetCount(uiNumObjects);
+
     const ezVec3 rayStart = pSensorOwner->GetGlobalPosition();
-    for (auto pObject : out_objectsInSensorVolume)
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
     {
-      const ezVec3 rayEnd = pObject->GetGlobalPosition();
-      ezVec3 rayDir = rayEnd - rayStart;
-      const float fDistance = rayDir.GetLengthAndNormalize();
-
-      ezPhysicsCastResult hitResult;
-      ezPhysicsQueryParameters params(m_uiCollisionLayer);
-      params.m_bIgnoreInitialOverlap = true;
-      params.m_ShapeTypes = ezPhysicsShapeType::Default;
-
-      // TODO: probably best to expose the ezPhysicsShapeType bitflags on the component
-      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Rope);
-      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Ragdoll);
-      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Trigger);
-      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Query);
-      params.m_ShapeTypes.Remove(ezPhysicsShapeType::Character);
-
-      if (pPhysicsWorldModule->Raycast(hitResult, rayStart, rayDir, fDistance, params))
+      ezVec3 rayDir = out_objectsInSensorVolume[i]->GetGlobalPosition() - rayStart;
+
+      rays[i].m_vStart = rayStart;
+      rays[i].m_fDistance = rayDir.GetLengthAndNormalize();
+      rays[i].m_vDir = rayDir;
+    }
+
+    ezPhysicsQueryParameters params(m_uiCollisionLayer);
+    params.m_bIgnoreInitialOverlap = true;
+    params.m_ShapeTypes = ezPhysicsShapeType::Default;
+
+    // TODO: probably best to expose the ezPhysicsShapeType bitflags on the component
+    params.m_ShapeTypes.Remove(ezPhysicsShapeType::Rope);
+    params.m_ShapeTypes.Remove(ezPhysicsShapeType::Ragdoll);
+    params.m_ShapeTypes.Remove(ezPhysicsShapeType::Trigger);
+    params.m_ShapeTypes.Remove(ezPhysicsShapeType::Query);
+    params.m_ShapeTypes.Remove(ezPhysicsShapeType::Character);
+
+    pPhysicsWorldModule->RaycastBatch(rays, hitResults, hits, params);
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      if (hits[i])
       {
         // hit something in between -> not visible
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-        m_LastOccludedObjectPositions.PushBack(rayEnd);
+        m_LastOccludedObjectPositions.PushBack(out_objectsInSensorVolume[i]->GetGlobalPosition());
 #endif
 
         continue;
       }
 
-      ref_detectedObjects.PushBack(pObject->GetHandle());
+      ref_detectedObjects.PushBack(out_objectsInSensorVolume[i]->GetHandle());
     }
   }
   else
@@ -10,7 +10,6 @@ struct ezIkJointEntry
 {
   ezHashedString m_sJointName;
   float m_fWeight = 1.0f;
-  mutable ezUInt16 m_uiJointIdx = 0;
 
   ezResult Serialize(ezStreamWriter& inout_stream) const;
   ezResult Deserialize(ezStreamReader& inout_stream);
@@ -21,9 +21,12 @@ public:
 
 private:
   void Update(const ezWorldModule::UpdateContext& context);
+  void GeneratePoses(const ezWorldModule::UpdateContext& context);
+  void ApplyPoses(const ezWorldModule::UpdateContext& context);
   void ResourceEvent(const ezResourceEvent& e);
 
   ezDeque<ezComponentHandle> m_ComponentsToReset;
+  bool m_bGeneratePosesInParallel = true;
 };
 
 /// \brief Evaluates an ezAnimGraphResource and provides the result through the ezMsgAnimationPoseUpdated.
@@ -33,6 +36,11 @@ private:
 ///
 /// The result is sent as a recursive message, which is usually consumed by an ezAnimatedMeshComponent.
 /// The mesh component may be on the same game object or a child object.
+///
+/// The update is split into three stages. The anim graphs are stepped in the PreAsync phase.
+/// The expensive pose generation (sampling, blending, IK) runs in the Async phase, in parallel for all components.
+/// With the CVar 'Animation.ParallelPoseGeneration' disabled, the poses are generated right after stepping the graphs instead.
+/// Events, root motion and the final pose are then applied in the PostAsync phase.
 class EZ_GAMEENGINE_DLL ezAnimationControllerComponent : public ezComponent
 {
   EZ_DECLARE_COMPONENT_TYPE(ezAnimationControllerComponent, ezComponent, ezAnimationControllerComponentManager);
@@ -61,7 +69,9 @@ public:
   bool m_bEnableIK = false; // [ property ]
 
 protected:
-  void Update();
+  void StepAnimation();
+  void GeneratePose();
+  void ApplyPose();
 
   ezEnum<ezRootMotionMode> m_RootMotionMode;
 
@@ -70,4 +80,5 @@ protected:
   ezAnimPoseGenerator m_PoseGenerator;
 
   ezTime m_ElapsedTimeSinceUpdate = ezTime::MakeZero();
+  bool m_bPoseGenerationPending = false;
 };
@@ -58,7 +58,6 @@ ezResult ezIkJointEntry::Deserialize(ezStreamReader& inout_stream)
 {
   inout_stream >> m_sJointName;
   inout_stream >> m_fWeight;
-  m_uiJointIdx = 0;
   return EZ_SUCCESS;
 }
 
@@ -123,21 +122,21 @@ void ezAimIKComponent::OnMsgAnimationPoseGeneration(ezMsgAnimationPoseGeneration
     vPoleVectorPos = ezTransform::MakeLocalTransform(ownerTransform, ezTransform(targetTrans * ezVec3(0, 0, 10))).m_vPosition;
   }
 
+  const auto& skel = msg.m_pGenerator->GetSkeleton()->GetDescriptor().m_Skeleton;
+
   for (ezUInt32 i = 0; i < m_Joints.GetCount(); ++i)
   {
     if (m_Joints[i].m_fWeight <= 0.0f)
       continue;
 
-    if (m_Joints[i].m_uiJointIdx == 0)
-    {
-      m_Joints[i].m_uiJointIdx = msg.m_pGenerator->GetSkeleton()->GetDescriptor().m_Skeleton.FindJointByName(m_Joints[i].m_sJointName);
-    }
+    // the pose may be generated on a worker thread, so the joint is looked up every time instead of caching it in the component
+    const ezUInt16 uiJointIdx = skel.FindJointByName(m_Joints[i].m_sJointName);
 
-    if (m_Joints[i].m_uiJointIdx == ezInvalidJointIndex)
+    if (uiJointIdx == ezInvalidJointIndex)
       continue;
 
     auto& cmdIk = msg.m_pGenerator->AllocCommandAimIK();
-    cmdIk.m_uiJointIdx = m_Joints[i].m_uiJointIdx;
+    cmdIk.m_uiJointIdx = uiJointIdx;
     cmdIk.m_Inputs.PushBack(msg.m_pGenerator->GetFinalCommand());
     cmdIk.m_vTargetPosition = localTarget.m_vPosition;
     cmdIk.m_fWeight = m_fWeight * m_Joints[i].m_fWeight;
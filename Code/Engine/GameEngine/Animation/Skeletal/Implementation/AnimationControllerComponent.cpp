@@ -3,6 +3,7 @@
 #include <Core/Input/InputManager.h>
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Strings/HashedString.h>
 #include <GameEngine/Animation/Skeletal/AnimatedMeshComponent.h>
 #include <GameEngine/Animation/Skeletal/AnimationControllerComponent.h>
@@ -11,6 +12,8 @@
 #include <RendererCore/AnimationSystem/AnimGraph/AnimGraphResource.h>
 #include <RendererCore/AnimationSystem/SkeletonResource.h>
 
+ezCVarBool cvar_AnimationParallelPoseGeneration("Animation.ParallelPoseGeneration", true, ezCVarFlags::Default, "Generates the poses of all animation controllers in parallel. Otherwise they are generated one after another on the main thread.");
+
 // clang-format off
 EZ_BEGIN_COMPONENT_TYPE(ezAnimationControllerComponent, 3, ezComponentMode::Static);
 {
@@ -84,8 +87,10 @@ void ezAnimationControllerComponent::OnSimulationStarted()
   m_AnimController.AddAnimGraph(m_hAnimGraph);
 }
 
-void ezAnimationControllerComponent::Update()
+void ezAnimationControllerComponent::StepAnimation()
 {
+  m_bPoseGenerationPending = false;
+
   ezTime tMinStep = ezTime::MakeFromSeconds(0);
   ezVisibilityState::Enum visType = GetOwner()->GetVisibilityState();
 
@@ -102,8 +107,18 @@ void ezAnimationControllerComponent::Update()
   if (m_ElapsedTimeSinceUpdate < tMinStep)
     return;
 
-  m_AnimController.Update(m_ElapsedTimeSinceUpdate, GetOwner(), m_bEnableIK);
+  m_bPoseGenerationPending = m_AnimController.StepGraphs(m_ElapsedTimeSinceUpdate, GetOwner());
   m_ElapsedTimeSinceUpdate = ezTime::MakeZero();
+}
+
+void ezAnimationControllerComponent::GeneratePose()
+{
+  m_AnimController.GeneratePose(GetOwner(), m_bEnableIK);
+}
+
+void ezAnimationControllerComponent::ApplyPose()
+{
+  m_AnimController.SendPoseUpdate(GetOwner());
 
   ezVec3 translation;
   ezAngle rotationX;
@@ -124,11 +139,30 @@ ezAnimationControllerComponentManager::ezAnimationControllerComponentManager(ezW
 
 void ezAnimationControllerComponentManager::Initialize()
 {
-  auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::Update, this);
-  desc.m_bOnlyUpdateWhenSimulating = true;
-  desc.m_Phase = ezWorldUpdatePhase::PreAsync; // TODO: currently can't run in Async phase
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::Update, this);
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_Phase = ezWorldUpdatePhase::PreAsync;
 
-  this->RegisterUpdateFunction(desc);
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::GeneratePoses, this);
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_Phase = ezWorldUpdatePhase::Async;
+    desc.m_uiGranularity = 16;
+
+    this->RegisterUpdateFunction(desc);
+  }
+
+  {
+    auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ezAnimationControllerComponentManager::ApplyPoses, this);
+    desc.m_bOnlyUpdateWhenSimulating = true;
+    desc.m_Phase = ezWorldUpdatePhase::PostAsync;
+
+    this->RegisterUpdateFunction(desc);
+  }
 
   ezResourceManager::GetResourceEvents().AddEventHandler(ezMakeDelegate(&ezAnimationControllerComponentManager::ResourceEvent, this));
 }
@@ -153,12 +187,53 @@ void ezAnimationControllerComponentManager::Update(const ezWorldModule::UpdateCo
     m_ComponentsToReset.Clear();
   }
 
+  // the Async phase must use the same setting, even if the cvar is changed in between
+  m_bGeneratePosesInParallel = cvar_AnimationParallelPoseGeneration;
+
   for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
   {
     ComponentType* pComponent = it;
     if (pComponent->IsActiveAndInitialized())
     {
-      pComponent->Update();
+      pComponent->StepAnimation();
+
+      if (!m_bGeneratePosesInParallel && pComponent->m_bPoseGenerationPending)
+      {
+        pComponent->GeneratePose();
+      }
+    }
+  }
+}
+
+void ezAnimationControllerComponentManager::GeneratePoses(const ezWorldModule::UpdateContext& context)
+{
+  if (!m_bGeneratePosesInParallel)
+    return;
+
+  // only reads from the world, the results are applied in ApplyPoses()
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->m_bPoseGenerationPending)
+    {
+      pComponent->GeneratePose();
+    }
+  }
+}
+
+void ezAnimationControllerComponentManager::ApplyPoses(const ezWorldModule::UpdateContext& context)
+{
+  for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+  {
+    ComponentType* pComponent = it;
+    if (pComponent->m_bPoseGenerationPending)
+    {
+      pComponent->m_bPoseGenerationPending = false;
+
+      if (pComponent->IsActiveAndInitialized())
+      {
+        pComponent->ApplyPose();
+      }
     }
   }
 }
@@ -100,20 +100,18 @@ void ezTwoBoneIKComponent::OnMsgAnimationPoseGeneration(ezMsgAnimationPoseGenera
     vPoleVectorPos = ezTransform::MakeLocalTransform(ownerTransform, ezTransform(targetTrans * ezVec3(0, 0, 10))).m_vPosition;
   }
 
-  if (m_uiJointIdxStart == 0 && m_uiJointIdxMiddle == 0)
-  {
-    auto& skel = msg.m_pGenerator->GetSkeleton()->GetDescriptor().m_Skeleton;
-    m_uiJointIdxStart = skel.FindJointByName(m_sJointStart);
-    m_uiJointIdxMiddle = skel.FindJointByName(m_sJointMiddle);
-    m_uiJointIdxEnd = skel.FindJointByName(m_sJointEnd);
-  }
+  // the pose may be generated on a worker thread, so the joints are looked up every time instead of caching them in the component
+  const auto& skel = msg.m_pGenerator->GetSkeleton()->GetDescriptor().m_Skeleton;
+  const ezUInt16 uiJointIdxStart = skel.FindJointByName(m_sJointStart);
+  const ezUInt16 uiJointIdxMiddle = skel.FindJointByName(m_sJointMiddle);
+  const ezUInt16 uiJointIdxEnd = skel.FindJointByName(m_sJointEnd);
 
-  if (m_uiJointIdxStart != ezInvalidJointIndex && m_uiJointIdxMiddle != ezInvalidJointIndex && m_uiJointIdxEnd != ezInvalidJointIndex)
+  if (uiJointIdxStart != ezInvalidJointIndex && uiJointIdxMiddle != ezInvalidJointIndex && uiJointIdxEnd != ezInvalidJointIndex)
   {
     auto& cmdIk = msg.m_pGenerator->AllocCommandTwoBoneIK();
-    cmdIk.m_uiJointIdxStart = m_uiJointIdxStart;
-    cmdIk.m_uiJointIdxMiddle = m_uiJointIdxMiddle;
-    cmdIk.m_uiJointIdxEnd = m_uiJointIdxEnd;
+    cmdIk.m_uiJointIdxStart = uiJointIdxStart;
+    cmdIk.m_uiJointIdxMiddle = uiJointIdxMiddle;
+    cmdIk.m_uiJointIdxEnd = uiJointIdxEnd;
     cmdIk.m_Inputs.PushBack(msg.m_pGenerator->GetFinalCommand());
     cmdIk.m_vTargetPosition = localTarget.m_vPosition;
     cmdIk.m_vPoleVector = vPoleVectorPos;
@@ -48,9 +48,5 @@ public:
 protected:
   void OnMsgAnimationPoseGeneration(ezMsgAnimationPoseGeneration& msg) const; // [ msg handler ]
 
-  mutable ezUInt16 m_uiJointIdxStart = 0;
-  mutable ezUInt16 m_uiJointIdxMiddle = 0;
-  mutable ezUInt16 m_uiJointIdxEnd = 0;
-
   const char* DummyGetter() const { return nullptr; }
 };
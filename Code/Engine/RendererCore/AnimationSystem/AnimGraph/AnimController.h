@@ -58,8 +58,26 @@ public:
 
   void Initialize(const ezSkeletonResourceHandle& hSkeleton, ezAnimPoseGenerator& ref_poseGenerator, const ezSharedPtr<ezBlackboard>& pBlackboard = nullptr);
 
+  /// \brief Runs all three update stages (StepGraphs(), GeneratePose() and SendPoseUpdate()) at once.
   void Update(ezTime diff, ezGameObject* pTarget, bool bEnableIK);
 
+  /// \brief Steps all anim graphs and records the commands for the pose generator. Also computes the root motion.
+  ///
+  /// This may modify the world (blackboards, event messages), so it must be called on the thread that is allowed to write to the world.
+  /// Returns false, if there is nothing to generate, in which case the other stages must be skipped.
+  bool StepGraphs(ezTime diff, ezGameObject* pTarget);
+
+  /// \brief Executes the recorded pose generator commands, ie. samples and blends the animations and applies IK.
+  ///
+  /// This only reads from the world, so it may run on a worker thread for many controllers in parallel,
+  /// for example in the ezWorldUpdatePhase::Async. Event messages from event tracks are queued until SendPoseUpdate().
+  void GeneratePose(ezGameObject* pTarget, bool bEnableIK);
+
+  /// \brief Sends the queued event messages and then the resulting pose through ezMsgAnimationPoseUpdated.
+  ///
+  /// Must be called on the thread that is allowed to write to the world.
+  void SendPoseUpdate(ezGameObject* pTarget);
+
   void GetRootMotion(ezVec3& ref_vTranslation, ezAngle& ref_rotationX, ezAngle& ref_rotationY, ezAngle& ref_rotationZ) const;
 
   const ezSharedPtr<ezBlackboard>& GetBlackboard() { return m_pBlackboard; }
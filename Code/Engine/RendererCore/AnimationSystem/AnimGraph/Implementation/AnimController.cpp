@@ -49,12 +49,21 @@ void ezAnimController::GetRootMotion(ezVec3& ref_vTranslation, ezAngle& ref_rota
 
 void ezAnimController::Update(ezTime diff, ezGameObject* pTarget, bool bEnableIK)
 {
-  if (!m_hSkeleton.IsValid())
+  if (!StepGraphs(diff, pTarget))
     return;
 
+  GeneratePose(pTarget, bEnableIK);
+  SendPoseUpdate(pTarget);
+}
+
+bool ezAnimController::StepGraphs(ezTime diff, ezGameObject* pTarget)
+{
+  if (!m_hSkeleton.IsValid())
+    return false;
+
   ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
   if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
-    return;
+    return false;
 
   m_pCurrentModelTransforms = nullptr;
 
@@ -80,13 +89,33 @@ void ezAnimController::Update(ezTime diff, ezGameObject* pTarget, bool bEnableIK
 
   GenerateLocalResultProcessors(pSkeleton.GetPointer());
 
+  return true;
+}
+
+void ezAnimController::GeneratePose(ezGameObject* pTarget, bool bEnableIK)
+{
+  // keeps the skeleton locked, while the pose generator uses it
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+  if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
+    return;
+
   {
     ezMsgAnimationPoseGeneration poseGenMsg;
     poseGenMsg.m_pGenerator = &GetPoseGenerator();
     pTarget->SendMessageRecursive(poseGenMsg);
   }
 
+  GetPoseGenerator().SetQueueEventMessages(true);
   GetPoseGenerator().UpdatePose(bEnableIK);
+}
+
+void ezAnimController::SendPoseUpdate(ezGameObject* pTarget)
+{
+  GetPoseGenerator().SendQueuedEventMessages();
+
+  ezResourceLock<ezSkeletonResource> pSkeleton(m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+  if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
+    return;
 
   if (auto newPose = GetPoseGenerator().GetCurrentPose(); !newPose.IsEmpty())
   {
@@ -2,6 +2,7 @@
 
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Foundation/Containers/ArrayMap.h>
+#include <Foundation/Strings/HashedString.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <RendererCore/AnimationSystem/Declarations.h>
 #include <RendererCore/RendererCoreDLL.h>
@@ -233,6 +234,15 @@ public:
 
   void UpdatePose(bool bRequestExternalPoseGeneration);
 
+  /// \brief If enabled, event messages from sampled event tracks are queued, instead of being sent to the target object right away.
+  ///
+  /// This is needed to run UpdatePose() on another thread. The queued messages have to be sent afterwards
+  /// with SendQueuedEventMessages() on the thread that is allowed to modify the world.
+  void SetQueueEventMessages(bool bQueue) { m_bQueueEventMessages = bQueue; }
+
+  /// \brief Sends all event messages that were queued since the last Reset(). See SetQueueEventMessages().
+  void SendQueuedEventMessages();
+
   ezArrayPtr<ezMat4> GetCurrentPose() const { return m_OutputPose; }
 
   void SetFinalCommand(ezAnimPoseGeneratorCommandID cmdId) { m_FinalCommand = cmdId; }
@@ -276,4 +286,7 @@ private:
   ezHybridArray<ezAnimPoseGeneratorCommandTwoBoneIK, 2> m_CommandsTwoBoneIK;
 
   ezArrayMap<ezUInt32, ozz::animation::SamplingJob::Context*> m_SamplingCaches;
+
+  bool m_bQueueEventMessages = false;
+  ezHybridArray<ezHashedString, 4> m_QueuedEventMessages;
 };
@@ -35,6 +35,8 @@ void ezAnimPoseGenerator::Reset(const ezSkeletonResource* pSkeleton, ezGameObjec
 
   m_OutputPose.Clear();
 
+  m_QueuedEventMessages.Clear();
+
   // don't clear these arrays, they are reused
   // m_UsedModelTransforms.Clear();
   // m_SamplingCaches.Clear();
@@ -708,6 +710,12 @@ void ezAnimPoseGenerator::SampleEventTrack(const ezAnimationClipResource* pResou
       EZ_DEFAULT_CASE_NOT_IMPLEMENTED;
   }
 
+  if (m_bQueueEventMessages)
+  {
+    m_QueuedEventMessages.PushBackRange(events);
+    return;
+  }
+
   ezMsgGenericEvent msg;
 
   for (const auto& hs : events)
@@ -718,6 +726,23 @@ void ezAnimPoseGenerator::SampleEventTrack(const ezAnimationClipResource* pResou
   }
 }
 
+void ezAnimPoseGenerator::SendQueuedEventMessages()
+{
+  if (m_QueuedEventMessages.IsEmpty() || m_pTargetGameObject == nullptr)
+    return;
+
+  ezMsgGenericEvent msg;
+
+  for (const auto& hs : m_QueuedEventMessages)
+  {
+    msg.m_sMessage = hs;
+
+    m_pTargetGameObject->SendEventMessage(msg, nullptr);
+  }
+
+  m_QueuedEventMessages.Clear();
+}
+
 ezArrayPtr<ozz::math::SoaTransform> ezAnimPoseGenerator::AcquireLocalPoseTransforms(ezAnimPoseGeneratorLocalPoseID id)
 {
   m_UsedLocalTransforms.EnsureCount(id + 1);
@@ -4,6 +4,7 @@
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/TypeVersionContext.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Components/FogComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Lights/AmbientLightComponent.h>
@@ -12,6 +13,8 @@
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
 #include <RendererCore/Pipeline/View.h>
 
+extern ezCVarBool cvar_RenderingMultithreading;
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool cvar_RenderingLightingVisClusterData("Rendering.Lighting.VisClusterData", false, ezCVarFlags::Default, "Enables debug visualization of clustered light data");
 ezCVarInt cvar_RenderingLightingVisClusterDepthSlice("Rendering.Lighting.VisClusterDepthSlice", -1, ezCVarFlags::Default, "Show the debug visualization only for the given depth slice");
@@ -198,6 +201,8 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
     m_TempLightData.Clear();
     ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData(), NUM_CLUSTERS);
 
+    ezDynamicArray<ClusterLight> clusterLights(ezFrameAllocator::GetCurrentAllocator());
+
     auto batchList = ref_extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
     for (ezUInt32 i = 0; i < uiBatchCount; ++i)
@@ -219,7 +224,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
           FillPointLightData(m_TempLightData.ExpandAndGetRef(), pPointLightRenderData);
 
           ezSimdBSphere pointLightSphere = ezSimdBSphere(ezSimdConversion::ToVec3(pPointLightRenderData->m_GlobalTransform.m_vPosition), pPointLightRenderData->m_fRange);
-          RasterizeSphere(pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          MakeSphereClusterLight(clusterLights.ExpandAndGetRef(), pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix);
 
           if (false)
           {
@@ -244,20 +249,20 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
           cone.m_PositionAndRange.SetW(pSpotLightRenderData->m_fRange);
           cone.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
           cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
-          RasterizeSpotLight(cone, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          MakeConeClusterLight(clusterLights.ExpandAndGetRef(), cone, uiLightIndex, viewMatrix, projectionMatrix);
         }
         else if (auto pDirLightRenderData = ezDynamicCast<const ezDirectionalLightRenderData*>(it))
         {
           FillDirLightData(m_TempLightData.ExpandAndGetRef(), pDirLightRenderData);
 
-          RasterizeDirLight(pDirLightRenderData, uiLightIndex, m_TempLightsClusters.GetArrayPtr());
+          MakeEverywhereClusterLight(clusterLights.ExpandAndGetRef(), uiLightIndex);
         }
         else if (auto pFillLightRenderData = ezDynamicCast<const ezFillLightRenderData*>(it))
         {
           FillFillLightData(m_TempLightData.ExpandAndGetRef(), pFillLightRenderData);
 
           ezSimdBSphere fillLightSphere = ezSimdBSphere(ezSimdConversion::ToVec3(pFillLightRenderData->m_GlobalTransform.m_vPosition), pFillLightRenderData->m_fRange);
-          RasterizeSphere(fillLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          MakeSphereClusterLight(clusterLights.ExpandAndGetRef(), fillLightSphere, uiLightIndex, viewMatrix, projectionMatrix);
         }
         else if (auto pFogRenderData = ezDynamicCast<const ezFogRenderData*>(it))
         {
@@ -285,6 +290,10 @@ void ezClusteredDataExtractor::PostSortAndBatch(const ezView& view, const ezDyna
       }
     }
 
+    // only a few lights are cheaper to assign on this thread than to distribute
+    const bool bMultiThreaded = cvar_RenderingMultithreading && clusterLights.GetCount() >= 32;
+    AssignLightsToClusters<TempCluster<ezClusteredDataCPU::MAX_LIGHT_DATA>>(clusterLights, m_ClusterBoundingSpheres, m_TempLightsClusters, bMultiThreaded);
+
     pData->m_LightData = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezPerLightData, m_TempLightData.GetCount());
     pData->m_LightData.CopyFrom(m_TempLightData);
 
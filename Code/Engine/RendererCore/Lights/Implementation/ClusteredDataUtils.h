@@ -18,6 +18,7 @@ EZ_DEFINE_AS_POD_TYPE(ezPerClusterData);
 #include <Foundation/Math/Float16.h>
 #include <Foundation/SimdMath/SimdConversion.h>
 #include <Foundation/SimdMath/SimdVec4i.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Utilities/GraphicsUtils.h>
 
 namespace
@@ -332,8 +333,17 @@ namespace
     return ezSimdBBox(mi, ma);
   }
 
-  template <typename Cluster, typename IntersectionFunc>
-  EZ_FORCE_INLINE void FillCluster(const ezSimdBBox& screenSpaceBounds, ezUInt32 uiBlockIndex, ezUInt32 uiMask, Cluster* pClusters, IntersectionFunc func)
+  struct ClusterRange
+  {
+    ezUInt32 m_uiMinX;
+    ezUInt32 m_uiMinY;
+    ezUInt32 m_uiMinZ;
+    ezUInt32 m_uiMaxX;
+    ezUInt32 m_uiMaxY;
+    ezUInt32 m_uiMaxZ;
+  };
+
+  EZ_FORCE_INLINE ClusterRange GetClusterRange(const ezSimdBBox& screenSpaceBounds)
   {
     ezSimdVec4f scale = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, -0.5f * NUM_CLUSTERS_Y, 1.0f, 1.0f);
     ezSimdVec4f bias = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, 0.5f * NUM_CLUSTERS_Y, 0.0f, 0.0f);
@@ -347,20 +357,28 @@ namespace
     minXY_maxXY = minXY_maxXY.CompMin(maxClusterIndex - ezSimdVec4i(1));
     minXY_maxXY = minXY_maxXY.CompMax(ezSimdVec4i::MakeZero());
 
-    ezUInt32 xMin = minXY_maxXY.x();
-    ezUInt32 yMin = minXY_maxXY.w();
+    ClusterRange range;
+    range.m_uiMinX = minXY_maxXY.x();
+    range.m_uiMinY = minXY_maxXY.w();
+    range.m_uiMinZ = GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z());
+
+    range.m_uiMaxX = minXY_maxXY.z();
+    range.m_uiMaxY = minXY_maxXY.y();
+    range.m_uiMaxZ = GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z());
 
-    ezUInt32 xMax = minXY_maxXY.z();
-    ezUInt32 yMax = minXY_maxXY.y();
+    return range;
+  }
 
-    ezUInt32 zMin = GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z());
-    ezUInt32 zMax = GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z());
+  template <typename Cluster, typename IntersectionFunc>
+  EZ_FORCE_INLINE void FillCluster(const ezSimdBBox& screenSpaceBounds, ezUInt32 uiBlockIndex, ezUInt32 uiMask, Cluster* pClusters, IntersectionFunc func)
+  {
+    const ClusterRange range = GetClusterRange(screenSpaceBounds);
 
-    for (ezUInt32 z = zMin; z <= zMax; ++z)
+    for (ezUInt32 z = range.m_uiMinZ; z <= range.m_uiMaxZ; ++z)
     {
-      for (ezUInt32 y = yMin; y <= yMax; ++y)
+      for (ezUInt32 y = range.m_uiMinY; y <= range.m_uiMaxY; ++y)
       {
-        for (ezUInt32 x = xMin; x <= xMax; ++x)
+        for (ezUInt32 x = range.m_uiMinX; x <= range.m_uiMaxX; ++x)
         {
           ezUInt32 uiClusterIndex = GetClusterIndexFromCoord(x, y, z);
           if (func(uiClusterIndex))
@@ -394,17 +412,14 @@ namespace
     ezSimdVec4f m_SinCosAngle;
   };
 
-  template <typename Cluster>
-  void RasterizeSpotLight(const BoundingCone& spotLightCone, ezUInt32 uiLightIndex, const ezSimdMat4f& mViewMatrix,
-    const ezSimdMat4f& mProjectionMatrix, Cluster* pClusters, ezSimdBSphere* pClusterBoundingSpheres)
+  EZ_FORCE_INLINE ezSimdBSphere GetConeBoundingSphere(const BoundingCone& cone)
   {
-    ezSimdVec4f position = spotLightCone.m_PositionAndRange;
-    ezSimdFloat range = spotLightCone.m_PositionAndRange.w();
-    ezSimdVec4f forwardDir = spotLightCone.m_ForwardDir;
-    ezSimdFloat sinAngle = spotLightCone.m_SinCosAngle.x();
-    ezSimdFloat cosAngle = spotLightCone.m_SinCosAngle.y();
+    ezSimdVec4f position = cone.m_PositionAndRange;
+    ezSimdFloat range = cone.m_PositionAndRange.w();
+    ezSimdVec4f forwardDir = cone.m_ForwardDir;
+    ezSimdFloat sinAngle = cone.m_SinCosAngle.x();
+    ezSimdFloat cosAngle = cone.m_SinCosAngle.y();
 
-    // First calculate a bounding sphere around the cone to get min and max bounds
     ezSimdVec4f bSphereCenter;
     ezSimdFloat bSphereRadius;
     if (sinAngle > 0.707107f) // sin(45)
@@ -418,39 +433,7 @@ namespace
       bSphereCenter = position + forwardDir * bSphereRadius;
     }
 
-    ezSimdBSphere spotLightSphere(bSphereCenter, bSphereRadius);
-    ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(spotLightSphere, mViewMatrix, mProjectionMatrix);
-
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
-
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, pClusters, [&](ezUInt32 uiClusterIndex)
-      {
-      ezSimdBSphere clusterSphere = pClusterBoundingSpheres[uiClusterIndex];
-      ezSimdFloat clusterRadius = clusterSphere.GetRadius();
-
-      ezSimdVec4f toConePos = clusterSphere.m_CenterAndRadius - position;
-      ezSimdFloat projected = forwardDir.Dot<3>(toConePos);
-      ezSimdFloat distToConeSq = toConePos.Dot<3>(toConePos);
-      ezSimdFloat distClosestP = cosAngle * (distToConeSq - projected * projected).GetSqrt() - projected * sinAngle;
-
-      bool angleCull = distClosestP > clusterRadius;
-      bool frontCull = projected > clusterRadius + range;
-      bool backCull = projected < -clusterRadius;
-
-      return !(angleCull || frontCull || backCull); });
-  }
-
-  template <typename Cluster>
-  void RasterizeDirLight(const ezDirectionalLightRenderData* pDirLightRenderData, ezUInt32 uiLightIndex, ezArrayPtr<Cluster> clusters)
-  {
-    const ezUInt32 uiBlockIndex = uiLightIndex / 32;
-    const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
-
-    for (ezUInt32 i = 0; i < clusters.GetCount(); ++i)
-    {
-      clusters[i].m_BitMask[uiBlockIndex] |= uiMask;
-    }
+    return ezSimdBSphere(bSphereCenter, bSphereRadius);
   }
 
   template <typename Cluster>
@@ -499,4 +482,228 @@ namespace
 
       return localDecalBounds.Overlaps(clusterSphere); });
   }
+
+  /// Bounding spheres of four neighboring clusters in x direction, in SoA layout to test all four at once.
+  struct ClusterBoundingSpheres4
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdVec4f m_CenterX;
+    ezSimdVec4f m_CenterY;
+    ezSimdVec4f m_CenterZ;
+    ezSimdVec4f m_Radius;
+  };
+
+  static_assert(NUM_CLUSTERS_X % 4 == 0);
+
+  void FillClusterBoundingSpheres4(ezArrayPtr<const ezSimdBSphere> clusterBoundingSpheres, ezArrayPtr<ClusterBoundingSpheres4> out_clusterBoundingSpheres4)
+  {
+    for (ezUInt32 i = 0; i < out_clusterBoundingSpheres4.GetCount(); ++i)
+    {
+      const ezSimdBSphere* pSpheres = clusterBoundingSpheres.GetPtr() + i * 4;
+
+      ezSimdMat4f m = ezSimdMat4f::MakeFromColumns(pSpheres[0].m_CenterAndRadius, pSpheres[1].m_CenterAndRadius, pSpheres[2].m_CenterAndRadius, pSpheres[3].m_CenterAndRadius);
+      m.Transpose();
+
+      ClusterBoundingSpheres4& spheres4 = out_clusterBoundingSpheres4[i];
+      spheres4.m_CenterX = m.m_col0;
+      spheres4.m_CenterY = m.m_col1;
+      spheres4.m_CenterZ = m.m_col2;
+      spheres4.m_Radius = m.m_col3;
+    }
+  }
+
+  /// A light that is assigned to clusters by AssignLightsToDepthSlice(). Spheres only use m_PositionAndRange.
+  struct ClusterLight
+  {
+    enum class Shape : ezUInt8
+    {
+      Sphere,
+      Cone,
+      Everywhere,
+    };
+
+    ezSimdVec4f m_PositionAndRange;
+    ezSimdVec4f m_ForwardDir;
+    ezSimdVec4f m_SinCosAngle;
+    ClusterRange m_Range;
+    ezUInt32 m_uiLightIndex;
+    Shape m_Shape;
+  };
+
+  void MakeSphereClusterLight(ClusterLight& out_light, const ezSimdBSphere& sphere, ezUInt32 uiLightIndex, const ezSimdMat4f& mViewMatrix, const ezSimdMat4f& mProjectionMatrix)
+  {
+    out_light.m_PositionAndRange = sphere.m_CenterAndRadius;
+    out_light.m_Range = GetClusterRange(GetScreenSpaceBounds(sphere, mViewMatrix, mProjectionMatrix));
+    out_light.m_uiLightIndex = uiLightIndex;
+    out_light.m_Shape = ClusterLight::Shape::Sphere;
+  }
+
+  void MakeConeClusterLight(ClusterLight& out_light, const BoundingCone& cone, ezUInt32 uiLightIndex, const ezSimdMat4f& mViewMatrix, const ezSimdMat4f& mProjectionMatrix)
+  {
+    out_light.m_PositionAndRange = cone.m_PositionAndRange;
+    out_light.m_ForwardDir = cone.m_ForwardDir;
+    out_light.m_SinCosAngle = cone.m_SinCosAngle;
+    out_light.m_Range = GetClusterRange(GetScreenSpaceBounds(GetConeBoundingSphere(cone), mViewMatrix, mProjectionMatrix));
+    out_light.m_uiLightIndex = uiLightIndex;
+    out_light.m_Shape = ClusterLight::Shape::Cone;
+  }
+
+  void MakeEverywhereClusterLight(ClusterLight& out_light, ezUInt32 uiLightIndex)
+  {
+    out_light.m_Range = {0, 0, 0, NUM_CLUSTERS_X - 1, NUM_CLUSTERS_Y - 1, NUM_CLUSTERS_Z - 1};
+    out_light.m_uiLightIndex = uiLightIndex;
+    out_light.m_Shape = ClusterLight::Shape::Everywhere;
+  }
+
+  /// Same test as ezSimdBSphere::Overlaps, for four cluster spheres at once.
+  EZ_FORCE_INLINE ezSimdVec4b SphereOverlapsClusters(const ClusterLight& light, const ClusterBoundingSpheres4& clusters)
+  {
+    const ezSimdVec4f dx = clusters.m_CenterX - ezSimdVec4f(light.m_PositionAndRange.x());
+    const ezSimdVec4f dy = clusters.m_CenterY - ezSimdVec4f(light.m_PositionAndRange.y());
+    const ezSimdVec4f dz = clusters.m_CenterZ - ezSimdVec4f(light.m_PositionAndRange.z());
+    const ezSimdVec4f radius = clusters.m_Radius + ezSimdVec4f(light.m_PositionAndRange.w());
+
+    const ezSimdVec4f distSq = dx.CompMul(dx) + dy.CompMul(dy) + dz.CompMul(dz);
+    return distSq < radius.CompMul(radius);
+  }
+
+  /// Tests whether the cone of a spot light overlaps four cluster spheres at once. Conservative, like the sphere test.
+  EZ_FORCE_INLINE ezSimdVec4b ConeOverlapsClusters(const ClusterLight& light, const ClusterBoundingSpheres4& clusters)
+  {
+    const ezSimdVec4f range = ezSimdVec4f(light.m_PositionAndRange.w());
+    const ezSimdVec4f sinAngle = ezSimdVec4f(light.m_SinCosAngle.x());
+    const ezSimdVec4f cosAngle = ezSimdVec4f(light.m_SinCosAngle.y());
+
+    const ezSimdVec4f toConePosX = clusters.m_CenterX - ezSimdVec4f(light.m_PositionAndRange.x());
+    const ezSimdVec4f toConePosY = clusters.m_CenterY - ezSimdVec4f(light.m_PositionAndRange.y());
+    const ezSimdVec4f toConePosZ = clusters.m_CenterZ - ezSimdVec4f(light.m_PositionAndRange.z());
+
+    const ezSimdVec4f projected = toConePosX * light.m_ForwardDir.x() + toConePosY * light.m_ForwardDir.y() + toConePosZ * light.m_ForwardDir.z();
+    const ezSimdVec4f distToConeSq = toConePosX.CompMul(toConePosX) + toConePosY.CompMul(toConePosY) + toConePosZ.CompMul(toConePosZ);
+    const ezSimdVec4f distClosestP = cosAngle.CompMul((distToConeSq - projected.CompMul(projected)).GetSqrt()) - projected.CompMul(sinAngle);
+
+    const ezSimdVec4b angleCull = distClosestP > clusters.m_Radius;
+    const ezSimdVec4b frontCull = projected > clusters.m_Radius + range;
+    const ezSimdVec4b backCull = projected < -clusters.m_Radius;
+
+    return !(angleCull || frontCull || backCull);
+  }
+
+  /// \brief Sets the bits of the given lights in all clusters of depth slice z that they overlap.
+  ///
+  /// Only writes to the clusters of the given slice, so all slices can be processed in parallel.
+  template <typename Cluster>
+  void AssignLightsToDepthSlice(ezUInt32 z, ezArrayPtr<const ClusterLight> lights, ezArrayPtr<const ezUInt32> lightIndices, const ClusterBoundingSpheres4* pClusterBoundingSpheres4, Cluster* pClusters)
+  {
+    for (ezUInt32 uiIndex : lightIndices)
+    {
+      const ClusterLight& light = lights[uiIndex];
+      const ClusterRange& range = light.m_Range;
+
+      const ezUInt32 uiBlockIndex = light.m_uiLightIndex / 32;
+      const ezUInt32 uiMask = 1 << (light.m_uiLightIndex - uiBlockIndex * 32);
+
+      for (ezUInt32 y = range.m_uiMinY; y <= range.m_uiMaxY; ++y)
+      {
+        for (ezUInt32 x = range.m_uiMinX & ~3u; x <= range.m_uiMaxX; x += 4)
+        {
+          const ezUInt32 uiClusterIndex = GetClusterIndexFromCoord(x, y, z);
+
+          ezSimdVec4b overlaps;
+          switch (light.m_Shape)
+          {
+            case ClusterLight::Shape::Sphere:
+              overlaps = SphereOverlapsClusters(light, pClusterBoundingSpheres4[uiClusterIndex / 4]);
+              break;
+            case ClusterLight::Shape::Cone:
+              overlaps = ConeOverlapsClusters(light, pClusterBoundingSpheres4[uiClusterIndex / 4]);
+              break;
+            case ClusterLight::Shape::Everywhere:
+              overlaps = ezSimdVec4b(true);
+              break;
+          }
+
+          if (overlaps.NoneSet())
+            continue;
+
+          const bool bOverlaps[4] = {overlaps.x(), overlaps.y(), overlaps.z(), overlaps.w()};
+          const ezUInt32 uiEnd = ezMath::Min(x + 3, range.m_uiMaxX);
+
+          for (ezUInt32 i = ezMath::Max(x, range.m_uiMinX); i <= uiEnd; ++i)
+          {
+            if (bOverlaps[i - x])
+            {
+              pClusters[uiClusterIndex + i - x].m_BitMask[uiBlockIndex] |= uiMask;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /// \brief Assigns all lights to the clusters they overlap. Depth slices are distributed across the worker threads if bMultiThreaded is set.
+  template <typename Cluster>
+  void AssignLightsToClusters(ezArrayPtr<const ClusterLight> lights, ezArrayPtr<const ezSimdBSphere> clusterBoundingSpheres, ezArrayPtr<Cluster> clusters, bool bMultiThreaded)
+  {
+    EZ_PROFILE_SCOPE("AssignLightsToClusters");
+
+    if (lights.IsEmpty())
+      return;
+
+    ezDynamicArray<ClusterBoundingSpheres4> clusterBoundingSpheres4(ezFrameAllocator::GetCurrentAllocator());
+    clusterBoundingSpheres4.SetCountUninitialized(NUM_CLUSTERS / 4);
+    FillClusterBoundingSpheres4(clusterBoundingSpheres, clusterBoundingSpheres4);
+
+    // Bucket the lights by depth slice so that each slice only iterates over the lights that can touch it.
+    ezUInt32 sliceOffsets[NUM_CLUSTERS_Z + 1] = {};
+    for (const ClusterLight& light : lights)
+    {
+      for (ezUInt32 z = light.m_Range.m_uiMinZ; z <= light.m_Range.m_uiMaxZ; ++z)
+      {
+        ++sliceOffsets[z + 1];
+      }
+    }
+
+    for (ezUInt32 z = 0; z < NUM_CLUSTERS_Z; ++z)
+    {
+      sliceOffsets[z + 1] += sliceOffsets[z];
+    }
+
+    ezDynamicArray<ezUInt32> sliceLightIndices(ezFrameAllocator::GetCurrentAllocator());
+    sliceLightIndices.SetCountUninitialized(sliceOffsets[NUM_CLUSTERS_Z]);
+    {
+      ezUInt32 sliceWriteOffsets[NUM_CLUSTERS_Z];
+      ezMemoryUtils::Copy(sliceWriteOffsets, sliceOffsets, NUM_CLUSTERS_Z);
+
+      for (ezUInt32 i = 0; i < lights.GetCount(); ++i)
+      {
+        for (ezUInt32 z = lights[i].m_Range.m_uiMinZ; z <= lights[i].m_Range.m_uiMaxZ; ++z)
+        {
+          sliceLightIndices[sliceWriteOffsets[z]++] = i;
+        }
+      }
+    }
+
+    auto AssignToSlices = [&](ezUInt32 uiStartSlice, ezUInt32 uiEndSlice)
+    {
+      for (ezUInt32 z = uiStartSlice; z < uiEndSlice; ++z)
+      {
+        ezArrayPtr<const ezUInt32> lightIndices = sliceLightIndices.GetArrayPtr().GetSubArray(sliceOffsets[z], sliceOffsets[z + 1] - sliceOffsets[z]);
+        AssignLightsToDepthSlice(z, lights, lightIndices, clusterBoundingSpheres4.GetData(), clusters.GetPtr());
+      }
+    };
+
+    if (bMultiThreaded)
+    {
+      ezParallelForParams params;
+      params.m_uiBinSize = 1;
+
+      ezTaskSystem::ParallelForIndexed(0u, static_cast<ezUInt32>(NUM_CLUSTERS_Z), AssignToSlices, "AssignLightsToClusters", ezTaskNesting::Never, params);
+    }
+    else
+    {
+      AssignToSlices(0, NUM_CLUSTERS_Z);
+    }
+  }
 } // namespace
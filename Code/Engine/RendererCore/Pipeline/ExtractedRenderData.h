@@ -30,6 +30,11 @@ public:
   EZ_ALWAYS_INLINE const ezDebugRendererContext& GetViewDebugContext() const { return m_ViewDebugContext; }
 
   void AddRenderData(const ezRenderData* pRenderData, ezRenderData::Category category);
+
+  /// \brief Appends all render data of \a other, e.g. data that was extracted on another thread.
+  ///
+  /// The sorting keys are not recomputed, so \a other must have been filled using the same camera.
+  void AddRenderData(const ezExtractedRenderData& other);
   void AddFrameData(const ezRenderData* pFrameData);
 
   void SortAndBatch();
@@ -64,4 +69,6 @@ private:
 
   ezHybridArray<DataPerCategory, 16> m_DataPerCategory;
   ezHybridArray<const ezRenderData*, 16> m_FrameData;
+
+  ezDynamicArray<ezRenderDataBatch::SortableRenderData> m_SortScratchBuffer;
 };
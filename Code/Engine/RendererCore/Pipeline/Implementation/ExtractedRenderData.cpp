@@ -12,6 +12,17 @@ void ezExtractedRenderData::AddRenderData(const ezRenderData* pRenderData, ezRen
   auto& sortableRenderData = m_DataPerCategory[category.m_uiValue].m_SortableRenderData.ExpandAndGetRef();
   sortableRenderData.m_pRenderData = pRenderData;
   sortableRenderData.m_uiSortingKey = pRenderData->GetCategorySortingKey(category, m_Camera);
+  sortableRenderData.m_uiBatchId = pRenderData->m_uiBatchId;
+}
+
+void ezExtractedRenderData::AddRenderData(const ezExtractedRenderData& other)
+{
+  m_DataPerCategory.EnsureCount(other.m_DataPerCategory.GetCount());
+
+  for (ezUInt32 i = 0; i < other.m_DataPerCategory.GetCount(); ++i)
+  {
+    m_DataPerCategory[i].m_SortableRenderData.PushBackRange(other.m_DataPerCategory[i].m_SortableRenderData);
+  }
 }
 
 void ezExtractedRenderData::AddFrameData(const ezRenderData* pFrameData)
@@ -23,19 +34,6 @@ void ezExtractedRenderData::SortAndBatch()
 {
   EZ_PROFILE_SCOPE("SortAndBatch");
 
-  struct RenderDataComparer
-  {
-    EZ_FORCE_INLINE bool Less(const ezRenderDataBatch::SortableRenderData& a, const ezRenderDataBatch::SortableRenderData& b) const
-    {
-      if (a.m_uiSortingKey == b.m_uiSortingKey)
-      {
-        return a.m_pRenderData->m_uiBatchId < b.m_pRenderData->m_uiBatchId;
-      }
-
-      return a.m_uiSortingKey < b.m_uiSortingKey;
-    }
-  };
-
   for (auto& dataPerCategory : m_DataPerCategory)
   {
     if (dataPerCategory.m_SortableRenderData.IsEmpty())
@@ -43,8 +41,12 @@ void ezExtractedRenderData::SortAndBatch()
 
     auto& data = dataPerCategory.m_SortableRenderData;
 
-    // Sort
-    data.Sort(RenderDataComparer());
+    // Sort by sorting key, then by batch id. Since radix sort is stable, this is done by sorting by the secondary key first.
+    m_SortScratchBuffer.SetCountUninitialized(data.GetCount());
+    ezSorting::RadixSort(data.GetArrayPtr(), m_SortScratchBuffer.GetArrayPtr(), [](const ezRenderDataBatch::SortableRenderData& d)
+      { return d.m_uiBatchId; }, true);
+    ezSorting::RadixSort(data.GetArrayPtr(), m_SortScratchBuffer.GetArrayPtr(), [](const ezRenderDataBatch::SortableRenderData& d)
+      { return d.m_uiSortingKey; }, true);
 
     // Find batches
     ezUInt32 uiCurrentBatchId = data[0].m_pRenderData->m_uiBatchId;
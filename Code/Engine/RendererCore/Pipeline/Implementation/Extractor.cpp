@@ -10,6 +10,8 @@
 #include <RendererCore/Pipeline/View.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
 
+extern ezCVarBool cvar_RenderingMultithreading;
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 ezCVarBool cvar_SpatialVisBounds("Spatial.VisBounds", false, ezCVarFlags::Default, "Enables debug visualization of object bounds");
 ezCVarBool cvar_SpatialVisLocalBBox("Spatial.VisLocalBBox", false, ezCVarFlags::Default, "Enables debug visualization of object local bounding box");
@@ -23,6 +25,9 @@ ezCVarBool cvar_SpatialExtractionShowStats("Spatial.Extraction.ShowStats", false
 
 namespace
 {
+  // below this number of visible objects, extraction is always done on the view's extract task only
+  constexpr ezUInt32 s_uiNumObjectsPerExtractionTask = 256;
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   void VisualizeSpatialData(const ezView& view)
   {
@@ -161,7 +166,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
     }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    m_uiNumUncachedRenderData += msg.m_ExtractedRenderData.GetCount();
+    m_uiNumUncachedRenderData.Add(msg.m_ExtractedRenderData.GetCount());
 #endif
   };
 
@@ -197,7 +202,7 @@ void ezExtractor::ExtractRenderData(const ezView& view, const ezGameObject* pObj
           extractedRenderData.AddRenderData(cacheEntry.m_pRenderData, msg.m_OverrideCategory != ezInvalidRenderDataCategory ? msg.m_OverrideCategory : ezRenderData::Category(cacheEntry.m_uiCategory));
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-          ++m_uiNumCachedRenderData;
+          m_uiNumCachedRenderData.Increment();
 #endif
         }
         ++uiCacheIndex;
@@ -291,9 +296,6 @@ ezVisibleObjectsExtractor::~ezVisibleObjectsExtractor() = default;
 
 void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData)
 {
-  ezMsgExtractRenderData msg;
-  msg.m_pView = &view;
-
   EZ_LOCK(view.GetWorld()->GetReadMarker());
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -303,21 +305,41 @@ void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray
   m_uiNumUncachedRenderData = 0;
 #endif
 
-  for (auto pObject : visibleObjects)
+  const ezUInt32 uiNumObjects = visibleObjects.GetCount();
+
+  if (!cvar_RenderingMultithreading || uiNumObjects <= s_uiNumObjectsPerExtractionTask)
   {
-    ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+    ExtractObjects(view, visibleObjects, ref_extractedRenderData);
+  }
+  else
+  {
+    EZ_PROFILE_SCOPE("Parallel Extraction");
 
-#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
-    if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
-    {
-      if ((cvar_SpatialVisDataOnlyObject.GetValue().IsEmpty() ||
-            pObject->GetName().FindSubString_NoCase(cvar_SpatialVisDataOnlyObject.GetValue()) != nullptr) &&
-          !cvar_SpatialVisDataOnlySelected)
+    const ezUInt32 uiNumTasks = (uiNumObjects + s_uiNumObjectsPerExtractionTask - 1) / s_uiNumObjectsPerExtractionTask;
+    m_RenderDataPerTask.SetCount(uiNumTasks);
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumTasks, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
       {
-        VisualizeObject(view, pObject);
-      }
+        for (ezUInt32 uiTask = uiStartIndex; uiTask < uiEndIndex; ++uiTask)
+        {
+          const ezUInt32 uiFirstObject = uiTask * s_uiNumObjectsPerExtractionTask;
+          const ezUInt32 uiTaskNumObjects = ezMath::Min(s_uiNumObjectsPerExtractionTask, uiNumObjects - uiFirstObject);
+
+          ezExtractedRenderData& renderData = m_RenderDataPerTask[uiTask];
+          renderData.Clear();
+          renderData.SetCamera(ref_extractedRenderData.GetCamera());
+
+          ExtractObjects(view, visibleObjects.GetArrayPtr().GetSubArray(uiFirstObject, uiTaskNumObjects), renderData);
+        }
+      },
+      "ExtractRenderData");
+
+    // merge in the original object order, so that the result does not depend on the scheduling
+    for (const ezExtractedRenderData& renderData : m_RenderDataPerTask)
+    {
+      ref_extractedRenderData.AddRenderData(renderData);
     }
-#endif
   }
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
@@ -331,15 +353,38 @@ void ezVisibleObjectsExtractor::Extract(const ezView& view, const ezDynamicArray
 
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", "Extraction Stats:");
 
-    sb.SetFormat("Num Cached Render Data: {0}", m_uiNumCachedRenderData);
+    sb.SetFormat("Num Cached Render Data: {0}", static_cast<ezInt32>(m_uiNumCachedRenderData));
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
 
-    sb.SetFormat("Num Uncached Render Data: {0}", m_uiNumUncachedRenderData);
+    sb.SetFormat("Num Uncached Render Data: {0}", static_cast<ezInt32>(m_uiNumUncachedRenderData));
     ezDebugRenderer::DrawInfoText(hView, ezDebugTextPlacement::TopLeft, "ExtractionStats", sb);
   }
 #endif
 }
 
+void ezVisibleObjectsExtractor::ExtractObjects(const ezView& view, ezArrayPtr<const ezGameObject* const> objects, ezExtractedRenderData& ref_extractedRenderData)
+{
+  ezMsgExtractRenderData msg;
+  msg.m_pView = &view;
+
+  for (auto pObject : objects)
+  {
+    ExtractRenderData(view, pObject, msg, ref_extractedRenderData);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    if (cvar_SpatialVisBounds || cvar_SpatialVisLocalBBox || cvar_SpatialVisData)
+    {
+      if ((cvar_SpatialVisDataOnlyObject.GetValue().IsEmpty() ||
+            pObject->GetName().FindSubString_NoCase(cvar_SpatialVisDataOnlyObject.GetValue()) != nullptr) &&
+          !cvar_SpatialVisDataOnlySelected)
+      {
+        VisualizeObject(view, pObject);
+      }
+    }
+#endif
+  }
+}
+
 ezResult ezVisibleObjectsExtractor::Serialize(ezStreamWriter& inout_stream) const
 {
   EZ_SUCCEED_OR_RETURN(SUPER::Serialize(inout_stream));
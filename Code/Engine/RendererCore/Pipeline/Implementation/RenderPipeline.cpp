@@ -8,6 +8,7 @@
 #include <Foundation/Math/Color8UNorm.h>
 #include <Foundation/Math/ColorScheme.h>
 #include <Foundation/Math/Frustum.h>
+#include <Foundation/Memory/FrameAllocator.h>
 #include <Foundation/Reflection/ReflectionUtils.h>
 #include <Foundation/SimdMath/SimdBBox.h>
 #include <Foundation/Time/Clock.h>
@@ -1039,8 +1040,29 @@ void ezRenderPipeline::FindVisibleObjects(const ezView& view)
       return !pRasterizer->IsVisible(aabb2);
     };
 
+    // the individual objects are collected and tested in one batch, which distributes large batches across the worker threads
+    auto AreOccluded = [=](ezArrayPtr<const ezSimdBBox> boxes, ezArrayPtr<bool> out_occluded)
+    {
+      const ezSimdVec4f vInflation(1.0f + cvar_SpatialCullingOcclusionBoundsInlation);
+
+      ezDynamicArray<ezSimdBBox> inflatedBoxes(ezFrameAllocator::GetCurrentAllocator());
+      inflatedBoxes.SetCountUninitialized(boxes.GetCount());
+
+      for (ezUInt32 i = 0; i < boxes.GetCount(); ++i)
+      {
+        inflatedBoxes[i] = ezSimdBBox::MakeFromCenterAndHalfExtents(boxes[i].GetCenter(), boxes[i].GetHalfExtents().CompMul(vInflation));
+      }
+
+      pRasterizer->IsVisible(inflatedBoxes, out_occluded);
+
+      for (bool& bOccluded : out_occluded)
+      {
+        bOccluded = !bOccluded;
+      }
+    };
+
     m_VisibleObjects.Clear();
-    view.GetWorld()->GetSpatialSystem()->FindVisibleObjects(frustum, queryParams, m_VisibleObjects, IsOccluded, visType);
+    view.GetWorld()->GetSpatialSystem()->FindVisibleObjects(frustum, queryParams, m_VisibleObjects, IsOccluded, visType, AreOccluded);
   }
   else
   {
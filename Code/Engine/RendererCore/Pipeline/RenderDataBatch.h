@@ -11,6 +11,7 @@ private:
 
     const ezRenderData* m_pRenderData;
     ezUInt64 m_uiSortingKey;
+    ezUInt32 m_uiBatchId; ///< Copy of m_pRenderData->m_uiBatchId, so that sorting doesn't need to access the render data
   };
 
 public:
@@ -5,25 +5,51 @@
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdBBox.h>
 #include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/SimdMath/SimdMat4f.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Rasterizer/RasterizerObject.h>
 #include <RendererCore/Rasterizer/RasterizerView.h>
 #include <RendererCore/Rasterizer/Thirdparty/Occluder.h>
 #include <RendererCore/Rasterizer/Thirdparty/Rasterizer.h>
 
 ezCVarInt cvar_SpatialCullingOcclusionMaxResolution("Spatial.Occlusion.MaxResolution", 512, ezCVarFlags::Default, "Max resolution for occlusion buffers.");
-ezCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, ezCVarFlags::Default, "Max number of occluders to rasterize per frame.");
+ezCVarInt cvar_SpatialCullingOcclusionMaxOccluders("Spatial.Occlusion.MaxOccluders", 64, ezCVarFlags::Default, "Max number of occluders to rasterize per frame and tile.");
+ezCVarInt cvar_SpatialCullingOcclusionMaxTiles("Spatial.Occlusion.MaxTiles", 8, ezCVarFlags::Default, "Max number of tiles into which the occlusion buffer is split for multi-threaded rasterization.");
+
+extern ezCVarBool cvar_RenderingMultithreading;
+
+// tiles are horizontal bands, if they get too thin, most occluders overlap several of them
+static constexpr ezUInt32 s_uiMinRowsPerTile = 32;
+static constexpr ezUInt32 s_uiNumBoxesPerQueryTask = 128;
 
 ezRasterizerView::ezRasterizerView() = default;
 ezRasterizerView::~ezRasterizerView() = default;
 
 void ezRasterizerView::SetResolution(ezUInt32 uiWidth, ezUInt32 uiHeight, float fAspectRatio)
 {
+  ezUInt32 uiNumTiles = 1;
+  if (cvar_RenderingMultithreading)
+  {
+    const ezUInt32 uiNumWorkers = ezTaskSystem::GetNumAllocatedWorkerThreads(ezWorkerThreadType::ShortTasks) + 1;
+    const ezUInt32 uiMaxTiles = static_cast<ezUInt32>(ezMath::Max(cvar_SpatialCullingOcclusionMaxTiles.GetValue(), 1));
+    uiNumTiles = ezMath::Clamp(ezMath::Min(uiNumWorkers, uiMaxTiles), 1u, ezMath::Max(uiHeight / s_uiMinRowsPerTile, 1u));
+  }
+
+  // the rasterizer works on blocks of 8x8 pixels, tiles must not split them
+  const ezUInt32 uiRowsPerTile = ezMath::RoundUp((uiHeight + uiNumTiles - 1) / uiNumTiles, 8);
+
   if (m_uiResolutionX != uiWidth || m_uiResolutionY != uiHeight)
   {
     m_uiResolutionX = uiWidth;
     m_uiResolutionY = uiHeight;
 
     m_pRasterizer = EZ_DEFAULT_NEW(Rasterizer, uiWidth, uiHeight);
+    m_Tiles.Clear();
+  }
+
+  if (m_Tiles.IsEmpty() || m_uiRowsPerTile != uiRowsPerTile)
+  {
+    SetupTiles(uiRowsPerTile);
   }
 
   if (fAspectRatio == 0.0f)
@@ -32,6 +58,38 @@ void ezRasterizerView::SetResolution(ezUInt32 uiWidth, ezUInt32 uiHeight, float
     m_fAspectRation = fAspectRatio;
 }
 
+void ezRasterizerView::SetupTiles(ezUInt32 uiRowsPerTile)
+{
+  m_uiRowsPerTile = uiRowsPerTile;
+
+  m_Tiles.Clear();
+
+  for (ezUInt32 uiFirstRow = 0; uiFirstRow < m_uiResolutionY; uiFirstRow += m_uiRowsPerTile)
+  {
+    Tile& tile = m_Tiles.ExpandAndGetRef();
+    tile.m_uiFirstRow = uiFirstRow;
+    tile.m_uiNumRows = m_uiResolutionY - uiFirstRow;
+
+    // the last tile takes all remaining rows, instead of leaving a sliver
+    if (tile.m_uiNumRows >= m_uiRowsPerTile + s_uiMinRowsPerTile)
+    {
+      tile.m_uiNumRows = m_uiRowsPerTile;
+    }
+    else
+    {
+      break;
+    }
+  }
+
+  if (m_Tiles.GetCount() > 1)
+  {
+    for (Tile& tile : m_Tiles)
+    {
+      tile.m_pRasterizer = EZ_DEFAULT_NEW(Rasterizer, m_uiResolutionX, tile.m_uiNumRows);
+    }
+  }
+}
+
 void ezRasterizerView::BeginScene()
 {
   EZ_ASSERT_DEV(m_pRasterizer != nullptr, "Call SetResolution() first.");
@@ -63,6 +121,8 @@ void ezRasterizerView::EndScene()
 
   UpdateViewProjectionMatrix();
 
+  BinObjectsToTiles();
+
   // only rasterize a limited number of the closest objects
   RasterizeObjects(cvar_SpatialCullingOcclusionMaxOccluders);
 
@@ -71,36 +131,167 @@ void ezRasterizerView::EndScene()
   m_pRasterizer->setModelViewProjection(m_mViewProjection.m_fElementsCM);
 }
 
+void ezRasterizerView::BinObjectsToTiles()
+{
+  for (Tile& tile : m_Tiles)
+  {
+    tile.m_Instances.Clear();
+  }
+
+  if (m_Tiles.GetCount() == 1)
+  {
+    for (ezUInt32 i = 0; i < m_Instances.GetCount(); ++i)
+    {
+      m_Tiles[0].m_Instances.PushBack(i);
+    }
+
+    return;
+  }
+
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  EZ_PROFILE_SCOPE("Occlusion::BinObjects");
+
+  const ezSimdMat4f mViewProjection = ezSimdConversion::ToMat4(m_mViewProjection);
+
+  // same viewport transform as in Rasterizer::setModelViewProjection()
+  const float fRowScale = m_uiResolutionY * 0.5f - 4.0f;
+  const ezUInt32 uiLastTile = m_Tiles.GetCount() - 1;
+
+  for (ezUInt32 i = 0; i < m_Instances.GetCount(); ++i)
+  {
+    const Instance& inst = m_Instances[i];
+    const Occluder& occluder = inst.m_pObject->m_Occluder;
+
+    const ezSimdMat4f mMVP = mViewProjection * ezSimdConversion::ToMat4(inst.m_Transform.GetAsMat4());
+    const ezSimdVec4f vMin = occluder.m_boundsMin;
+    const ezSimdVec4f vMax = occluder.m_boundsMax;
+
+    ezUInt32 uiFirstTile = 0;
+    ezUInt32 uiLastTileOverlapped = uiLastTile;
+
+    float fMinRow = ezMath::MaxValue<float>();
+    float fMaxRow = -ezMath::MaxValue<float>();
+    bool bCrossesNearPlane = false;
+
+    for (ezUInt32 c = 0; c < 8; ++c)
+    {
+      const ezSimdVec4f vCorner = ezSimdVec4f::Select(ezSimdVec4b((c & 1) != 0, (c & 2) != 0, (c & 4) != 0, false), vMax, vMin);
+      const ezSimdVec4f vClip = mMVP.TransformPosition(vCorner);
+
+      const float w = vClip.w();
+      const float y = vClip.y();
+
+      if (w <= ezMath::DefaultEpsilon<float>())
+      {
+        bCrossesNearPlane = true;
+        break;
+      }
+
+      const float fRow = (y / w + 1.0f) * fRowScale;
+      fMinRow = ezMath::Min(fMinRow, fRow);
+      fMaxRow = ezMath::Max(fMaxRow, fRow);
+    }
+
+    if (!bCrossesNearPlane)
+    {
+      // the rasterizer rounds triangle bounds outwards to full blocks, so pad the range by a block on each side
+      fMinRow = ezMath::Clamp(fMinRow - 8.0f, 0.0f, float(m_uiResolutionY - 1));
+      fMaxRow = ezMath::Clamp(fMaxRow + 16.0f, 0.0f, float(m_uiResolutionY - 1));
+
+      uiFirstTile = ezMath::Min(static_cast<ezUInt32>(fMinRow) / m_uiRowsPerTile, uiLastTile);
+      uiLastTileOverlapped = ezMath::Min(static_cast<ezUInt32>(fMaxRow) / m_uiRowsPerTile, uiLastTile);
+    }
+
+    for (ezUInt32 t = uiFirstTile; t <= uiLastTileOverlapped; ++t)
+    {
+      m_Tiles[t].m_Instances.PushBack(i);
+    }
+  }
+#endif
+}
+
 void ezRasterizerView::RasterizeObjects(ezUInt32 uiMaxObjects)
 {
 #if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
 
   EZ_PROFILE_SCOPE("Occlusion::RasterizeObjects");
 
-  for (const Instance& inst : m_Instances)
+  if (m_Tiles.GetCount() == 1)
+  {
+    RasterizeTile(m_Tiles[0], uiMaxObjects);
+  }
+  else
+  {
+    ezParallelForParams params;
+    params.m_uiBinSize = 1;
+    params.m_uiMaxTasksPerThread = 1;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, m_Tiles.GetCount(), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 t = uiStartIndex; t < uiEndIndex; ++t)
+        {
+          RasterizeTile(m_Tiles[t], uiMaxObjects);
+        }
+      },
+      "Occlusion::RasterizeTiles", ezTaskNesting::Never, params);
+  }
+
+  for (const Tile& tile : m_Tiles)
+  {
+    m_bAnyOccludersRasterized |= tile.m_bAnyOccludersRasterized;
+  }
+#endif
+}
+
+void ezRasterizerView::RasterizeTile(Tile& tile, ezUInt32 uiMaxObjects)
+{
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  tile.m_bAnyOccludersRasterized = false;
+
+  if (tile.m_Instances.IsEmpty())
+    return;
+
+  Rasterizer* pRasterizer = tile.m_pRasterizer != nullptr ? tile.m_pRasterizer.Borrow() : m_pRasterizer.Borrow();
+
+  if (tile.m_pRasterizer != nullptr)
   {
-    ApplyModelViewProjectionMatrix(inst.m_Transform);
+    pRasterizer->clear();
+  }
+
+  for (ezUInt32 uiInstance : tile.m_Instances)
+  {
+    const Instance& inst = m_Instances[uiInstance];
+
+    const ezMat4 mMVP = tile.m_mViewProjection * inst.m_Transform.GetAsMat4();
+    pRasterizer->setModelViewProjection(mMVP.m_fElementsCM);
 
     bool bNeedsClipping;
     const Occluder& occluder = inst.m_pObject->m_Occluder;
 
-    if (m_pRasterizer->queryVisibility(occluder.m_boundsMin, occluder.m_boundsMax, bNeedsClipping))
+    if (pRasterizer->queryVisibility(occluder.m_boundsMin, occluder.m_boundsMax, bNeedsClipping))
     {
-      m_bAnyOccludersRasterized = true;
+      tile.m_bAnyOccludersRasterized = true;
 
       if (bNeedsClipping)
       {
-        m_pRasterizer->rasterize<true>(occluder);
+        pRasterizer->rasterize<true>(occluder);
       }
       else
       {
-        m_pRasterizer->rasterize<false>(occluder);
+        pRasterizer->rasterize<false>(occluder);
       }
 
       if (--uiMaxObjects == 0)
-        return;
+        break;
     }
   }
+
+  if (tile.m_pRasterizer != nullptr)
+  {
+    // the tiles cover disjoint block rows, so they can all write into the view's rasterizer at the same time
+    m_pRasterizer->copyBlockRows(*tile.m_pRasterizer, tile.m_uiFirstRow / 8);
+  }
 #endif
 }
 
@@ -110,14 +301,29 @@ void ezRasterizerView::UpdateViewProjectionMatrix()
   m_pCamera->GetProjectionMatrix(m_fAspectRation, mProjection, ezCameraEye::Left, ezClipSpaceDepthRange::ZeroToOne);
 
   m_mViewProjection = mProjection * m_pCamera->GetViewMatrix();
-}
 
-void ezRasterizerView::ApplyModelViewProjectionMatrix(const ezTransform& modelTransform)
-{
-  const ezMat4 mModel = modelTransform.GetAsMat4();
-  const ezMat4 mMVP = m_mViewProjection * mModel;
+  if (m_Tiles.GetCount() == 1)
+  {
+    m_Tiles[0].m_mViewProjection = m_mViewProjection;
+    return;
+  }
+
+  // The rasterizer maps clip space Y to the rows (y / w + 1) * (height / 2 - 4).
+  // Remap Y such that the tile's rasterizer produces the same rows as the full view, shifted by the tile's first row.
+  const float fViewScale = m_uiResolutionY * 0.5f - 4.0f;
 
-  m_pRasterizer->setModelViewProjection(mMVP.m_fElementsCM);
+  for (Tile& tile : m_Tiles)
+  {
+    const float fTileScale = tile.m_uiNumRows * 0.5f - 4.0f;
+    const float fScale = fViewScale / fTileScale;
+    const float fOffset = fScale - 1.0f - tile.m_uiFirstRow / fTileScale;
+
+    ezMat4 mTileFromView = ezMat4::MakeIdentity();
+    mTileFromView.Element(1, 1) = fScale;
+    mTileFromView.Element(3, 1) = fOffset;
+
+    tile.m_mViewProjection = mTileFromView * m_mViewProjection;
+  }
 }
 
 void ezRasterizerView::SortObjectsFrontToBack()
@@ -144,6 +350,58 @@ bool ezRasterizerView::IsVisible(const ezSimdBBox& aabb) const
 
   EZ_PROFILE_SCOPE("Occlusion::IsVisible");
 
+  return QueryVisibility(aabb);
+#else
+  return true;
+#endif
+}
+
+void ezRasterizerView::IsVisible(ezArrayPtr<const ezSimdBBox> boxes, ezArrayPtr<bool> out_visible) const
+{
+  EZ_ASSERT_DEV(out_visible.GetCount() >= boxes.GetCount(), "Output array is too small.");
+
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  if (!m_bAnyOccludersRasterized)
+  {
+    for (ezUInt32 i = 0; i < boxes.GetCount(); ++i)
+    {
+      out_visible[i] = true;
+    }
+    return;
+  }
+
+  EZ_PROFILE_SCOPE("Occlusion::IsVisibleBatch");
+
+  auto QueryRange = [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+  {
+    for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+    {
+      out_visible[i] = QueryVisibility(boxes[i]);
+    }
+  };
+
+  if (!cvar_RenderingMultithreading || boxes.GetCount() <= s_uiNumBoxesPerQueryTask)
+  {
+    QueryRange(0, boxes.GetCount());
+  }
+  else
+  {
+    ezParallelForParams params;
+    params.m_uiBinSize = s_uiNumBoxesPerQueryTask;
+
+    ezTaskSystem::ParallelForIndexed(0, boxes.GetCount(), QueryRange, "Occlusion::IsVisible", ezTaskNesting::Never, params);
+  }
+#else
+  for (ezUInt32 i = 0; i < boxes.GetCount(); ++i)
+  {
+    out_visible[i] = true;
+  }
+#endif
+}
+
+bool ezRasterizerView::QueryVisibility(const ezSimdBBox& aabb) const
+{
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
   ezSimdVec4f vmin = aabb.m_Min;
   ezSimdVec4f vmax = aabb.m_Max;
 
@@ -152,6 +410,7 @@ bool ezRasterizerView::IsVisible(const ezSimdBBox& aabb) const
   vmin.SetW(1);
   vmax.SetW(1);
 
+  // queries only read the view's rasterizer, so they may run concurrently
   bool needsClipping = false;
   return m_pRasterizer->queryVisibility(vmin.m_v, vmax.m_v, needsClipping);
 #else
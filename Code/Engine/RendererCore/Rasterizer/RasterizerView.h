@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Transform.h>
 #include <Foundation/Threading/Mutex.h>
 #include <Foundation/Types/ArrayPtr.h>
@@ -56,6 +57,12 @@ public:
   /// Note: This only works after EndScene().
   bool IsVisible(const ezSimdBBox& aabb) const;
 
+  /// \brief Checks the visibility of many boxes at once and writes the result for every box into out_visible.
+  ///
+  /// Large batches are distributed across the worker threads.
+  /// Note: This only works after EndScene().
+  void IsVisible(ezArrayPtr<const ezSimdBBox> boxes, ezArrayPtr<bool> out_visible) const;
+
   /// \brief Wether any occluder was actually added and also rasterized. If not, no need to do any visibility checks.
   bool HasRasterizedAnyOccluders() const
   {
@@ -63,10 +70,15 @@ public:
   }
 
 private:
+  struct Tile;
+
+  void SetupTiles(ezUInt32 uiRowsPerTile);
   void SortObjectsFrontToBack();
+  void BinObjectsToTiles();
   void RasterizeObjects(ezUInt32 uiMaxObjects);
+  void RasterizeTile(Tile& tile, ezUInt32 uiMaxObjects);
   void UpdateViewProjectionMatrix();
-  void ApplyModelViewProjectionMatrix(const ezTransform& modelTransform);
+  bool QueryVisibility(const ezSimdBBox& aabb) const;
 
   bool m_bAnyOccludersRasterized = false;
   const ezCamera* m_pCamera = nullptr;
@@ -83,6 +95,22 @@ private:
 
   ezDeque<Instance> m_Instances;
   ezMat4 m_mViewProjection;
+
+  /// \brief A horizontal band of the view. Occluders are binned into the tiles they overlap and each tile is rasterized by its own task.
+  ///
+  /// Once a tile is done, its depth is copied into the view's rasterizer, which is used for all visibility queries.
+  struct Tile
+  {
+    ezUniquePtr<Rasterizer> m_pRasterizer; ///< nullptr if the view only has a single tile, which then renders directly into the view's rasterizer.
+    ezUInt32 m_uiFirstRow = 0;
+    ezUInt32 m_uiNumRows = 0;
+    ezMat4 m_mViewProjection;              ///< The view-projection matrix of the view, remapped to the rows of this tile.
+    ezDynamicArray<ezUInt32> m_Instances;  ///< Indices into m_Instances, front to back.
+    bool m_bAnyOccludersRasterized = false;
+  };
+
+  ezDynamicArray<Tile> m_Tiles;
+  ezUInt32 m_uiRowsPerTile = 0;
 };
 
 class ezRasterizerViewPool
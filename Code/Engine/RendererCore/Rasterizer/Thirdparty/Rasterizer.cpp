@@ -585,6 +585,17 @@ bool Rasterizer::query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t m
   return false;
 }
 
+void Rasterizer::copyBlockRows(const Rasterizer& band, uint32_t firstBlockRow)
+{
+  assert(band.m_blocksX == m_blocksX && firstBlockRow + band.m_blocksY <= m_blocksY);
+
+  const uint32_t firstBlock = firstBlockRow * m_blocksX;
+  const uint32_t numBlocks = band.m_blocksX * band.m_blocksY;
+
+  memcpy(&m_depthBuffer[8 * firstBlock], band.m_depthBuffer.data(), 8 * numBlocks * sizeof(__m128i));
+  memcpy(&m_hiZ[firstBlock], band.m_hiZ.data(), numBlocks * sizeof(uint16_t));
+}
+
 void Rasterizer::readBackDepth(void* target) const
 {
   const float bias = 3.9623753e+28f; // 1.0f / floatCompressionBias
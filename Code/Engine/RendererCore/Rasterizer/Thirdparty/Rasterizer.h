@@ -25,6 +25,9 @@ public:
   bool query2D(uint32_t minX, uint32_t maxX, uint32_t minY, uint32_t maxY, uint32_t maxZ) const;
 
   void readBackDepth(void* target) const;
+
+  // Copies the depth of a rasterizer that covers a horizontal band of this one into the block rows starting at firstBlockRow.
+  void copyBlockRows(const Rasterizer& band, uint32_t firstBlockRow);
 #else
   Rasterizer(uint32_t width, uint32_t height)
   {
@@ -49,6 +52,8 @@ public:
   }
 
   void readBackDepth(void* pTarget) const {}
+
+  void copyBlockRows(const Rasterizer& band, uint32_t firstBlockRow) {}
 #endif
 
 private:
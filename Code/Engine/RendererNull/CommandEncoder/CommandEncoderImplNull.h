@@ -0,0 +1,194 @@
+#pragma once
+
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Time/Time.h>
+#include <RendererFoundation/CommandEncoder/CommandEncoderPlatformInterface.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class ezGALDeviceNull;
+
+/// \brief Counts how often each kind of command was recorded by the null command encoder.
+///
+/// Binding counters count every call that reaches the platform layer. m_uiRedundantBindings is a subset of those and counts calls
+/// that bound the same object to a slot that already had it bound, ie. calls a real backend would not have to forward to the driver.
+struct EZ_RENDERERNULL_DLL ezGALCommandStatsNull
+{
+  ezUInt32 m_uiDrawCalls = 0;
+  ezUInt32 m_uiDispatchCalls = 0;
+  ezUInt64 m_uiVertices = 0;  ///< Vertices or indices submitted by direct draw calls, multiplied by the instance count.
+  ezUInt64 m_uiInstances = 0; ///< Instances submitted by direct draw calls.
+
+  ezUInt32 m_uiRenderingScopes = 0;
+  ezUInt32 m_uiComputeScopes = 0;
+  ezUInt32 m_uiClears = 0;
+
+  ezUInt32 m_uiShaderChanges = 0;
+  ezUInt32 m_uiStateChanges = 0;  ///< Blend, depth stencil, rasterizer, topology and vertex declaration changes.
+  ezUInt32 m_uiViewportChanges = 0; ///< Viewport and scissor rect changes.
+  ezUInt32 m_uiBufferBindings = 0;  ///< Vertex and index buffer bindings.
+
+  ezUInt32 m_uiConstantBufferBindings = 0;
+  ezUInt32 m_uiSamplerBindings = 0;
+  ezUInt32 m_uiResourceViewBindings = 0;
+  ezUInt32 m_uiUnorderedAccessViewBindings = 0;
+  ezUInt32 m_uiRedundantBindings = 0; ///< Subset of the constant buffer, sampler, resource view and UAV bindings.
+  ezUInt32 m_uiPushConstantUpdates = 0;
+
+  ezUInt32 m_uiBufferUpdates = 0;
+  ezUInt64 m_uiBufferUpdateBytes = 0;
+  ezUInt32 m_uiTextureUpdates = 0;
+  ezUInt32 m_uiCopies = 0; ///< Buffer and texture copies, resolves and readbacks.
+
+  /// \brief Returns the total number of pipeline state changes, ie. shader, render state, viewport and all binding changes.
+  ezUInt32 GetTotalStateChanges() const;
+
+  void operator+=(const ezGALCommandStatsNull& rhs);
+  void operator-=(const ezGALCommandStatsNull& rhs);
+};
+
+/// \brief The commands that were recorded between a PushMarker / PopMarker pair, including those of nested scopes.
+///
+/// Render passes, the render pipeline and the frame itself are all wrapped in markers when profiling is enabled,
+/// so each of them results in one scope per frame.
+struct EZ_RENDERERNULL_DLL ezGALCommandScopeNull
+{
+  ezStringView GetName() const { return m_szName; }
+
+  char m_szName[48];
+  ezUInt32 m_uiDepth = 0;  ///< Nesting depth, top-level scopes have a depth of zero.
+  ezTime m_CpuDuration;    ///< CPU time spent between opening and closing the scope.
+  ezGALCommandStatsNull m_Stats;
+};
+
+/// \brief Implements all command encoder functions as no-ops that only record statistics.
+class EZ_RENDERERNULL_DLL ezGALCommandEncoderImplNull final : public ezGALCommandEncoderCommonPlatformInterface
+{
+public:
+  ezGALCommandEncoderImplNull(ezGALDeviceNull& ref_deviceNull);
+  ~ezGALCommandEncoderImplNull();
+
+  /// \brief Moves the statistics and scopes of the current frame into the 'last frame' slots and starts recording a new frame.
+  void EndFrame();
+
+  const ezGALCommandStatsNull& GetCurrentFrameStats() const { return m_CurrentStats; }
+  const ezGALCommandStatsNull& GetLastFrameStats() const { return m_LastFrameStats; }
+  ezArrayPtr<const ezGALCommandScopeNull> GetLastFrameScopes() const { return m_LastFrameScopes; }
+
+  // ezGALCommandEncoderCommonPlatformInterface
+  // State setting functions
+
+  virtual void SetShaderPlatform(const ezGALShader* pShader) override;
+
+  virtual void SetConstantBufferPlatform(const ezShaderResourceBinding& binding, const ezGALBuffer* pBuffer) override;
+  virtual void SetSamplerStatePlatform(const ezShaderResourceBinding& binding, const ezGALSamplerState* pSamplerState) override;
+  virtual void SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureResourceView* pResourceView) override;
+  virtual void SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferResourceView* pResourceView) override;
+  virtual void SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureUnorderedAccessView* pUnorderedAccessView) override;
+  virtual void SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferUnorderedAccessView* pUnorderedAccessView) override;
+  virtual void SetPushConstantsPlatform(ezArrayPtr<const ezUInt8> data) override;
+
+  // GPU -> CPU query functions
+
+  virtual ezGALTimestampHandle InsertTimestampPlatform() override;
+  virtual ezGALOcclusionHandle BeginOcclusionQueryPlatform(ezEnum<ezGALQueryType> type) override;
+  virtual void EndOcclusionQueryPlatform(ezGALOcclusionHandle hOcclusion) override;
+  virtual ezGALFenceHandle InsertFencePlatform() override;
+
+  // Resource update functions
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues) override;
+
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues) override;
+  virtual void ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues) override;
+
+  virtual void CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource) override;
+  virtual void CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount) override;
+
+  virtual void UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> sourceData, ezGALUpdateMode::Enum updateMode) override;
+
+  virtual void CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource) override;
+  virtual void CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezVec3U32& vDestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource, const ezBoundingBoxu32& box) override;
+
+  virtual void UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource,
+    const ezBoundingBoxu32& destinationBox, const ezGALSystemMemoryDescription& sourceData) override;
+
+  virtual void ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource,
+    const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource) override;
+
+  virtual void ReadbackTexturePlatform(const ezGALReadbackTexture* pDestination, const ezGALTexture* pSource) override;
+  virtual void ReadbackBufferPlatform(const ezGALReadbackBuffer* pDestination, const ezGALBuffer* pSource) override;
+
+  virtual void GenerateMipMapsPlatform(const ezGALTextureResourceView* pResourceView) override;
+
+  // Misc
+
+  virtual void FlushPlatform() override;
+
+  // Debug helper functions
+
+  virtual void PushMarkerPlatform(const char* szMarker) override;
+  virtual void PopMarkerPlatform() override;
+  virtual void InsertEventMarkerPlatform(const char* szMarker) override;
+
+  // ezGALCommandEncoderComputePlatformInterface
+  // Dispatch
+  virtual void BeginComputePlatform() override;
+  virtual void EndComputePlatform() override;
+
+  virtual ezResult DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ) override;
+  virtual ezResult DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  // ezGALCommandEncoderRenderPlatformInterface
+  virtual void BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup) override;
+  virtual void EndRenderingPlatform() override;
+
+  // Draw functions
+
+  virtual void ClearPlatform(const ezColor& clearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear) override;
+
+  virtual ezResult DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex) override;
+  virtual ezResult DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex) override;
+  virtual ezResult DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex) override;
+  virtual ezResult DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+  virtual ezResult DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex) override;
+  virtual ezResult DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes) override;
+
+  // State functions
+
+  virtual void SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer) override;
+  virtual void SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer) override;
+  virtual void SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration) override;
+  virtual void SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum topology) override;
+
+  virtual void SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& blendFactor, ezUInt32 uiSampleMask) override;
+  virtual void SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue) override;
+  virtual void SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState) override;
+
+  virtual void SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth) override;
+  virtual void SetScissorRectPlatform(const ezRectU32& rect) override;
+
+private:
+  friend class ezGALDeviceNull;
+
+  /// \brief Remembers which object is bound to the binding's set and slot and counts the call as redundant if it was already bound there.
+  void BindObject(const ezShaderResourceBinding& binding, const void* pObject);
+
+  ezGALDeviceNull& m_GALDeviceNull;
+
+  ezGALCommandStatsNull m_CurrentStats;
+  ezGALCommandStatsNull m_LastFrameStats;
+
+  struct OpenScope
+  {
+    ezUInt32 m_uiScopeIndex;
+    ezTime m_StartTime;
+    ezGALCommandStatsNull m_StatsAtStart;
+  };
+
+  ezHybridArray<OpenScope, 8> m_OpenScopes;
+  ezDynamicArray<ezGALCommandScopeNull> m_CurrentScopes;
+  ezDynamicArray<ezGALCommandScopeNull> m_LastFrameScopes;
+
+  ezHashTable<ezUInt64, const void*> m_BoundObjects;
+};
@@ -0,0 +1,486 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/CommandEncoder/CommandEncoderImplNull.h>
+#include <RendererNull/Device/DeviceNull.h>
+
+ezUInt32 ezGALCommandStatsNull::GetTotalStateChanges() const
+{
+  return m_uiShaderChanges + m_uiStateChanges + m_uiViewportChanges + m_uiBufferBindings + m_uiConstantBufferBindings + m_uiSamplerBindings + m_uiResourceViewBindings + m_uiUnorderedAccessViewBindings + m_uiPushConstantUpdates;
+}
+
+void ezGALCommandStatsNull::operator+=(const ezGALCommandStatsNull& rhs)
+{
+  m_uiDrawCalls += rhs.m_uiDrawCalls;
+  m_uiDispatchCalls += rhs.m_uiDispatchCalls;
+  m_uiVertices += rhs.m_uiVertices;
+  m_uiInstances += rhs.m_uiInstances;
+  m_uiRenderingScopes += rhs.m_uiRenderingScopes;
+  m_uiComputeScopes += rhs.m_uiComputeScopes;
+  m_uiClears += rhs.m_uiClears;
+  m_uiShaderChanges += rhs.m_uiShaderChanges;
+  m_uiStateChanges += rhs.m_uiStateChanges;
+  m_uiViewportChanges += rhs.m_uiViewportChanges;
+  m_uiBufferBindings += rhs.m_uiBufferBindings;
+  m_uiConstantBufferBindings += rhs.m_uiConstantBufferBindings;
+  m_uiSamplerBindings += rhs.m_uiSamplerBindings;
+  m_uiResourceViewBindings += rhs.m_uiResourceViewBindings;
+  m_uiUnorderedAccessViewBindings += rhs.m_uiUnorderedAccessViewBindings;
+  m_uiRedundantBindings += rhs.m_uiRedundantBindings;
+  m_uiPushConstantUpdates += rhs.m_uiPushConstantUpdates;
+  m_uiBufferUpdates += rhs.m_uiBufferUpdates;
+  m_uiBufferUpdateBytes += rhs.m_uiBufferUpdateBytes;
+  m_uiTextureUpdates += rhs.m_uiTextureUpdates;
+  m_uiCopies += rhs.m_uiCopies;
+}
+
+void ezGALCommandStatsNull::operator-=(const ezGALCommandStatsNull& rhs)
+{
+  m_uiDrawCalls -= rhs.m_uiDrawCalls;
+  m_uiDispatchCalls -= rhs.m_uiDispatchCalls;
+  m_uiVertices -= rhs.m_uiVertices;
+  m_uiInstances -= rhs.m_uiInstances;
+  m_uiRenderingScopes -= rhs.m_uiRenderingScopes;
+  m_uiComputeScopes -= rhs.m_uiComputeScopes;
+  m_uiClears -= rhs.m_uiClears;
+  m_uiShaderChanges -= rhs.m_uiShaderChanges;
+  m_uiStateChanges -= rhs.m_uiStateChanges;
+  m_uiViewportChanges -= rhs.m_uiViewportChanges;
+  m_uiBufferBindings -= rhs.m_uiBufferBindings;
+  m_uiConstantBufferBindings -= rhs.m_uiConstantBufferBindings;
+  m_uiSamplerBindings -= rhs.m_uiSamplerBindings;
+  m_uiResourceViewBindings -= rhs.m_uiResourceViewBindings;
+  m_uiUnorderedAccessViewBindings -= rhs.m_uiUnorderedAccessViewBindings;
+  m_uiRedundantBindings -= rhs.m_uiRedundantBindings;
+  m_uiPushConstantUpdates -= rhs.m_uiPushConstantUpdates;
+  m_uiBufferUpdates -= rhs.m_uiBufferUpdates;
+  m_uiBufferUpdateBytes -= rhs.m_uiBufferUpdateBytes;
+  m_uiTextureUpdates -= rhs.m_uiTextureUpdates;
+  m_uiCopies -= rhs.m_uiCopies;
+}
+
+ezGALCommandEncoderImplNull::ezGALCommandEncoderImplNull(ezGALDeviceNull& ref_deviceNull)
+  : m_GALDeviceNull(ref_deviceNull)
+{
+}
+
+ezGALCommandEncoderImplNull::~ezGALCommandEncoderImplNull() = default;
+
+void ezGALCommandEncoderImplNull::EndFrame()
+{
+  EZ_ASSERT_DEV(m_OpenScopes.IsEmpty(), "{} marker(s) were pushed but not popped in this frame.", m_OpenScopes.GetCount());
+
+  m_LastFrameStats = m_CurrentStats;
+  m_CurrentStats = ezGALCommandStatsNull();
+
+  m_LastFrameScopes.Swap(m_CurrentScopes);
+  m_CurrentScopes.Clear();
+
+  m_BoundObjects.Clear();
+}
+
+void ezGALCommandEncoderImplNull::BindObject(const ezShaderResourceBinding& binding, const void* pObject)
+{
+  const ezUInt64 uiKey = (static_cast<ezUInt64>(binding.m_ResourceType.GetValue()) << 32) | (static_cast<ezUInt64>(static_cast<ezUInt16>(binding.m_iSet)) << 16) | static_cast<ezUInt16>(binding.m_iSlot);
+
+  const void*& pBoundObject = m_BoundObjects[uiKey];
+  if (pBoundObject == pObject)
+  {
+    ++m_CurrentStats.m_uiRedundantBindings;
+    return;
+  }
+
+  pBoundObject = pObject;
+}
+
+// State setting functions
+
+void ezGALCommandEncoderImplNull::SetShaderPlatform(const ezGALShader* pShader)
+{
+  EZ_IGNORE_UNUSED(pShader);
+  ++m_CurrentStats.m_uiShaderChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetConstantBufferPlatform(const ezShaderResourceBinding& binding, const ezGALBuffer* pBuffer)
+{
+  ++m_CurrentStats.m_uiConstantBufferBindings;
+  BindObject(binding, pBuffer);
+}
+
+void ezGALCommandEncoderImplNull::SetSamplerStatePlatform(const ezShaderResourceBinding& binding, const ezGALSamplerState* pSamplerState)
+{
+  ++m_CurrentStats.m_uiSamplerBindings;
+  BindObject(binding, pSamplerState);
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureResourceView* pResourceView)
+{
+  ++m_CurrentStats.m_uiResourceViewBindings;
+  BindObject(binding, pResourceView);
+}
+
+void ezGALCommandEncoderImplNull::SetResourceViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferResourceView* pResourceView)
+{
+  ++m_CurrentStats.m_uiResourceViewBindings;
+  BindObject(binding, pResourceView);
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALTextureUnorderedAccessView* pUnorderedAccessView)
+{
+  ++m_CurrentStats.m_uiUnorderedAccessViewBindings;
+  BindObject(binding, pUnorderedAccessView);
+}
+
+void ezGALCommandEncoderImplNull::SetUnorderedAccessViewPlatform(const ezShaderResourceBinding& binding, const ezGALBufferUnorderedAccessView* pUnorderedAccessView)
+{
+  ++m_CurrentStats.m_uiUnorderedAccessViewBindings;
+  BindObject(binding, pUnorderedAccessView);
+}
+
+void ezGALCommandEncoderImplNull::SetPushConstantsPlatform(ezArrayPtr<const ezUInt8> data)
+{
+  EZ_IGNORE_UNUSED(data);
+  ++m_CurrentStats.m_uiPushConstantUpdates;
+}
+
+// GPU -> CPU query functions
+
+ezGALTimestampHandle ezGALCommandEncoderImplNull::InsertTimestampPlatform()
+{
+  return m_GALDeviceNull.InsertTimestamp();
+}
+
+ezGALOcclusionHandle ezGALCommandEncoderImplNull::BeginOcclusionQueryPlatform(ezEnum<ezGALQueryType> type)
+{
+  EZ_IGNORE_UNUSED(type);
+  return m_GALDeviceNull.AllocateOcclusionQuery();
+}
+
+void ezGALCommandEncoderImplNull::EndOcclusionQueryPlatform(ezGALOcclusionHandle hOcclusion)
+{
+  EZ_IGNORE_UNUSED(hOcclusion);
+}
+
+ezGALFenceHandle ezGALCommandEncoderImplNull::InsertFencePlatform()
+{
+  return m_GALDeviceNull.InsertFence();
+}
+
+// Resource update functions
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  ++m_CurrentStats.m_uiClears;
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  ++m_CurrentStats.m_uiClears;
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALTextureUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  ++m_CurrentStats.m_uiClears;
+}
+
+void ezGALCommandEncoderImplNull::ClearUnorderedAccessViewPlatform(const ezGALBufferUnorderedAccessView* pUnorderedAccessView, ezVec4U32 vClearValues)
+{
+  EZ_IGNORE_UNUSED(pUnorderedAccessView);
+  EZ_IGNORE_UNUSED(vClearValues);
+  ++m_CurrentStats.m_uiClears;
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferPlatform(const ezGALBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(pSource);
+  ++m_CurrentStats.m_uiCopies;
+}
+
+void ezGALCommandEncoderImplNull::CopyBufferRegionPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, const ezGALBuffer* pSource, ezUInt32 uiSourceOffset, ezUInt32 uiByteCount)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(uiDestOffset);
+  EZ_IGNORE_UNUSED(pSource);
+  EZ_IGNORE_UNUSED(uiSourceOffset);
+  EZ_IGNORE_UNUSED(uiByteCount);
+  ++m_CurrentStats.m_uiCopies;
+}
+
+void ezGALCommandEncoderImplNull::UpdateBufferPlatform(const ezGALBuffer* pDestination, ezUInt32 uiDestOffset, ezArrayPtr<const ezUInt8> sourceData, ezGALUpdateMode::Enum updateMode)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(uiDestOffset);
+  EZ_IGNORE_UNUSED(updateMode);
+  ++m_CurrentStats.m_uiBufferUpdates;
+  m_CurrentStats.m_uiBufferUpdateBytes += sourceData.GetCount();
+}
+
+void ezGALCommandEncoderImplNull::CopyTexturePlatform(const ezGALTexture* pDestination, const ezGALTexture* pSource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(pSource);
+  ++m_CurrentStats.m_uiCopies;
+}
+
+void ezGALCommandEncoderImplNull::CopyTextureRegionPlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezVec3U32& vDestinationPoint, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource, const ezBoundingBoxu32& box)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+  EZ_IGNORE_UNUSED(vDestinationPoint);
+  EZ_IGNORE_UNUSED(pSource);
+  EZ_IGNORE_UNUSED(sourceSubResource);
+  EZ_IGNORE_UNUSED(box);
+  ++m_CurrentStats.m_uiCopies;
+}
+
+void ezGALCommandEncoderImplNull::UpdateTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezBoundingBoxu32& destinationBox, const ezGALSystemMemoryDescription& sourceData)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+  EZ_IGNORE_UNUSED(destinationBox);
+  EZ_IGNORE_UNUSED(sourceData);
+  ++m_CurrentStats.m_uiTextureUpdates;
+}
+
+void ezGALCommandEncoderImplNull::ResolveTexturePlatform(const ezGALTexture* pDestination, const ezGALTextureSubresource& destinationSubResource, const ezGALTexture* pSource, const ezGALTextureSubresource& sourceSubResource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(destinationSubResource);
+  EZ_IGNORE_UNUSED(pSource);
+  EZ_IGNORE_UNUSED(sourceSubResource);
+  ++m_CurrentStats.m_uiCopies;
+}
+
+void ezGALCommandEncoderImplNull::ReadbackTexturePlatform(const ezGALReadbackTexture* pDestination, const ezGALTexture* pSource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(pSource);
+  ++m_CurrentStats.m_uiCopies;
+}
+
+void ezGALCommandEncoderImplNull::ReadbackBufferPlatform(const ezGALReadbackBuffer* pDestination, const ezGALBuffer* pSource)
+{
+  EZ_IGNORE_UNUSED(pDestination);
+  EZ_IGNORE_UNUSED(pSource);
+  ++m_CurrentStats.m_uiCopies;
+}
+
+void ezGALCommandEncoderImplNull::GenerateMipMapsPlatform(const ezGALTextureResourceView* pResourceView)
+{
+  EZ_IGNORE_UNUSED(pResourceView);
+}
+
+// Misc
+
+void ezGALCommandEncoderImplNull::FlushPlatform()
+{
+}
+
+// Debug helper functions
+
+void ezGALCommandEncoderImplNull::PushMarkerPlatform(const char* szMarker)
+{
+  OpenScope& openScope = m_OpenScopes.ExpandAndGetRef();
+  openScope.m_uiScopeIndex = m_CurrentScopes.GetCount();
+  openScope.m_StatsAtStart = m_CurrentStats;
+
+  ezGALCommandScopeNull& scope = m_CurrentScopes.ExpandAndGetRef();
+  ezStringUtils::Copy(scope.m_szName, EZ_ARRAY_SIZE(scope.m_szName), szMarker);
+  scope.m_uiDepth = m_OpenScopes.GetCount() - 1;
+
+  // take the time last, so that the bookkeeping above is not attributed to the scope
+  openScope.m_StartTime = ezTime::Now();
+}
+
+void ezGALCommandEncoderImplNull::PopMarkerPlatform()
+{
+  const ezTime endTime = ezTime::Now();
+
+  EZ_ASSERT_DEV(!m_OpenScopes.IsEmpty(), "PopMarker was called without a matching PushMarker.");
+  const OpenScope& openScope = m_OpenScopes.PeekBack();
+
+  ezGALCommandScopeNull& scope = m_CurrentScopes[openScope.m_uiScopeIndex];
+  scope.m_CpuDuration = endTime - openScope.m_StartTime;
+  scope.m_Stats = m_CurrentStats;
+  scope.m_Stats -= openScope.m_StatsAtStart;
+
+  m_OpenScopes.PopBack();
+}
+
+void ezGALCommandEncoderImplNull::InsertEventMarkerPlatform(const char* szMarker)
+{
+  EZ_IGNORE_UNUSED(szMarker);
+}
+
+// Dispatch
+
+void ezGALCommandEncoderImplNull::BeginComputePlatform()
+{
+  ++m_CurrentStats.m_uiComputeScopes;
+}
+
+void ezGALCommandEncoderImplNull::EndComputePlatform()
+{
+}
+
+ezResult ezGALCommandEncoderImplNull::DispatchPlatform(ezUInt32 uiThreadGroupCountX, ezUInt32 uiThreadGroupCountY, ezUInt32 uiThreadGroupCountZ)
+{
+  EZ_IGNORE_UNUSED(uiThreadGroupCountX);
+  EZ_IGNORE_UNUSED(uiThreadGroupCountY);
+  EZ_IGNORE_UNUSED(uiThreadGroupCountZ);
+  ++m_CurrentStats.m_uiDispatchCalls;
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DispatchIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  ++m_CurrentStats.m_uiDispatchCalls;
+  return EZ_SUCCESS;
+}
+
+// Render
+
+void ezGALCommandEncoderImplNull::BeginRenderingPlatform(const ezGALRenderingSetup& renderingSetup)
+{
+  EZ_IGNORE_UNUSED(renderingSetup);
+  ++m_CurrentStats.m_uiRenderingScopes;
+}
+
+void ezGALCommandEncoderImplNull::EndRenderingPlatform()
+{
+}
+
+// Draw functions
+
+void ezGALCommandEncoderImplNull::ClearPlatform(const ezColor& clearColor, ezUInt32 uiRenderTargetClearMask, bool bClearDepth, bool bClearStencil, float fDepthClear, ezUInt8 uiStencilClear)
+{
+  EZ_IGNORE_UNUSED(clearColor);
+  EZ_IGNORE_UNUSED(uiRenderTargetClearMask);
+  EZ_IGNORE_UNUSED(bClearDepth);
+  EZ_IGNORE_UNUSED(bClearStencil);
+  EZ_IGNORE_UNUSED(fDepthClear);
+  EZ_IGNORE_UNUSED(uiStencilClear);
+  ++m_CurrentStats.m_uiClears;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawPlatform(ezUInt32 uiVertexCount, ezUInt32 uiStartVertex)
+{
+  EZ_IGNORE_UNUSED(uiStartVertex);
+  ++m_CurrentStats.m_uiDrawCalls;
+  m_CurrentStats.m_uiVertices += uiVertexCount;
+  m_CurrentStats.m_uiInstances += 1;
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedPlatform(ezUInt32 uiIndexCount, ezUInt32 uiStartIndex)
+{
+  EZ_IGNORE_UNUSED(uiStartIndex);
+  ++m_CurrentStats.m_uiDrawCalls;
+  m_CurrentStats.m_uiVertices += uiIndexCount;
+  m_CurrentStats.m_uiInstances += 1;
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedInstancedPlatform(ezUInt32 uiIndexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartIndex)
+{
+  EZ_IGNORE_UNUSED(uiStartIndex);
+  ++m_CurrentStats.m_uiDrawCalls;
+  m_CurrentStats.m_uiVertices += static_cast<ezUInt64>(uiIndexCountPerInstance) * uiInstanceCount;
+  m_CurrentStats.m_uiInstances += uiInstanceCount;
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawIndexedInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  ++m_CurrentStats.m_uiDrawCalls;
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawInstancedPlatform(ezUInt32 uiVertexCountPerInstance, ezUInt32 uiInstanceCount, ezUInt32 uiStartVertex)
+{
+  EZ_IGNORE_UNUSED(uiStartVertex);
+  ++m_CurrentStats.m_uiDrawCalls;
+  m_CurrentStats.m_uiVertices += static_cast<ezUInt64>(uiVertexCountPerInstance) * uiInstanceCount;
+  m_CurrentStats.m_uiInstances += uiInstanceCount;
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALCommandEncoderImplNull::DrawInstancedIndirectPlatform(const ezGALBuffer* pIndirectArgumentBuffer, ezUInt32 uiArgumentOffsetInBytes)
+{
+  EZ_IGNORE_UNUSED(pIndirectArgumentBuffer);
+  EZ_IGNORE_UNUSED(uiArgumentOffsetInBytes);
+  ++m_CurrentStats.m_uiDrawCalls;
+  return EZ_SUCCESS;
+}
+
+// State functions
+
+void ezGALCommandEncoderImplNull::SetIndexBufferPlatform(const ezGALBuffer* pIndexBuffer)
+{
+  EZ_IGNORE_UNUSED(pIndexBuffer);
+  ++m_CurrentStats.m_uiBufferBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetVertexBufferPlatform(ezUInt32 uiSlot, const ezGALBuffer* pVertexBuffer)
+{
+  EZ_IGNORE_UNUSED(uiSlot);
+  EZ_IGNORE_UNUSED(pVertexBuffer);
+  ++m_CurrentStats.m_uiBufferBindings;
+}
+
+void ezGALCommandEncoderImplNull::SetVertexDeclarationPlatform(const ezGALVertexDeclaration* pVertexDeclaration)
+{
+  EZ_IGNORE_UNUSED(pVertexDeclaration);
+  ++m_CurrentStats.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetPrimitiveTopologyPlatform(ezGALPrimitiveTopology::Enum topology)
+{
+  EZ_IGNORE_UNUSED(topology);
+  ++m_CurrentStats.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetBlendStatePlatform(const ezGALBlendState* pBlendState, const ezColor& blendFactor, ezUInt32 uiSampleMask)
+{
+  EZ_IGNORE_UNUSED(pBlendState);
+  EZ_IGNORE_UNUSED(blendFactor);
+  EZ_IGNORE_UNUSED(uiSampleMask);
+  ++m_CurrentStats.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetDepthStencilStatePlatform(const ezGALDepthStencilState* pDepthStencilState, ezUInt8 uiStencilRefValue)
+{
+  EZ_IGNORE_UNUSED(pDepthStencilState);
+  EZ_IGNORE_UNUSED(uiStencilRefValue);
+  ++m_CurrentStats.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetRasterizerStatePlatform(const ezGALRasterizerState* pRasterizerState)
+{
+  EZ_IGNORE_UNUSED(pRasterizerState);
+  ++m_CurrentStats.m_uiStateChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetViewportPlatform(const ezRectFloat& rect, float fMinDepth, float fMaxDepth)
+{
+  EZ_IGNORE_UNUSED(rect);
+  EZ_IGNORE_UNUSED(fMinDepth);
+  EZ_IGNORE_UNUSED(fMaxDepth);
+  ++m_CurrentStats.m_uiViewportChanges;
+}
+
+void ezGALCommandEncoderImplNull::SetScissorRectPlatform(const ezRectU32& rect)
+{
+  EZ_IGNORE_UNUSED(rect);
+  ++m_CurrentStats.m_uiViewportChanges;
+}
@@ -0,0 +1,617 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <Foundation/Configuration/Startup.h>
+#include <RendererFoundation/CommandEncoder/CommandEncoder.h>
+#include <RendererFoundation/Device/DeviceFactory.h>
+#include <RendererFoundation/Profiling/Profiling.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererNull/Device/SwapChainNull.h>
+#include <RendererNull/Resources/ResourcesNull.h>
+#include <RendererNull/Shader/ShaderNull.h>
+#include <RendererNull/State/StateNull.h>
+
+ezInternal::NewInstance<ezGALDevice> CreateNullDevice(ezAllocator* pAllocator, const ezGALDeviceCreationDescription& description)
+{
+  return EZ_NEW(pAllocator, ezGALDeviceNull, description);
+}
+
+// clang-format off
+EZ_BEGIN_SUBSYSTEM_DECLARATION(RendererNull, DeviceFactory)
+
+ON_CORESYSTEMS_STARTUP
+{
+  ezGALDeviceFactory::RegisterCreatorFunc("Null", &CreateNullDevice, "NULL_GAL", "ezShaderCompilerNull");
+}
+
+ON_CORESYSTEMS_SHUTDOWN
+{
+  ezGALDeviceFactory::UnregisterCreatorFunc("Null");
+}
+
+EZ_END_SUBSYSTEM_DECLARATION;
+// clang-format on
+
+ezGALDeviceNull::ezGALDeviceNull(const ezGALDeviceCreationDescription& Description)
+  : ezGALDevice(Description)
+{
+}
+
+ezGALDeviceNull::~ezGALDeviceNull() = default;
+
+ezGALCommandEncoder* ezGALDeviceNull::GetCommandEncoder() const
+{
+  return m_pCommandEncoder.Borrow();
+}
+
+const ezGALCommandStatsNull& ezGALDeviceNull::GetLastFrameStats() const
+{
+  return m_pCommandEncoderImpl->GetLastFrameStats();
+}
+
+ezArrayPtr<const ezGALCommandScopeNull> ezGALDeviceNull::GetLastFrameScopes() const
+{
+  return m_pCommandEncoderImpl->GetLastFrameScopes();
+}
+
+// Init & shutdown functions
+
+ezStringView ezGALDeviceNull::GetRendererPlatform()
+{
+  return "Null";
+}
+
+ezResult ezGALDeviceNull::InitPlatform()
+{
+  EZ_LOG_BLOCK("ezGALDeviceNull::InitPlatform");
+
+  m_pCommandEncoderImpl = EZ_DEFAULT_NEW(ezGALCommandEncoderImplNull, *this);
+  m_pCommandEncoder = EZ_DEFAULT_NEW(ezGALCommandEncoder, *this, *m_pCommandEncoderImpl);
+
+  // Use the same conventions as DX11 so that the CPU side produces the same matrices and pipeline setups.
+  ezClipSpaceDepthRange::Default = ezClipSpaceDepthRange::ZeroToOne;
+  ezClipSpaceYMode::RenderToTextureDefault = ezClipSpaceYMode::Regular;
+
+  ezGALWindowSwapChain::SetFactoryMethod([this](const ezGALWindowSwapChainCreationDescription& desc) -> ezGALSwapChainHandle
+    { return CreateSwapChain([&desc](ezAllocator* pAllocator) -> ezGALSwapChain*
+        { return EZ_NEW(pAllocator, ezGALSwapChainNull, desc); }); });
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALDeviceNull::ShutdownPlatform()
+{
+  ezGALWindowSwapChain::SetFactoryMethod({});
+
+  m_pCommandEncoder = nullptr;
+  m_pCommandEncoderImpl = nullptr;
+
+  return EZ_SUCCESS;
+}
+
+// Command encoder functions
+
+ezGALCommandEncoder* ezGALDeviceNull::BeginCommandsPlatform(const char* szName)
+{
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  m_pPassTimingScope = ezProfilingScopeAndMarker::Start(m_pCommandEncoder.Borrow(), szName);
+#else
+  EZ_IGNORE_UNUSED(szName);
+#endif
+
+  return m_pCommandEncoder.Borrow();
+}
+
+void ezGALDeviceNull::EndCommandsPlatform(ezGALCommandEncoder* pPass)
+{
+  EZ_ASSERT_DEV(m_pCommandEncoder.Borrow() == pPass, "Invalid pass");
+  EZ_IGNORE_UNUSED(pPass);
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  ezProfilingScopeAndMarker::Stop(m_pCommandEncoder.Borrow(), m_pPassTimingScope);
+#endif
+}
+
+void ezGALDeviceNull::FlushPlatform()
+{
+  m_pCommandEncoderImpl->FlushPlatform();
+}
+
+// State creation functions
+
+ezGALBlendState* ezGALDeviceNull::CreateBlendStatePlatform(const ezGALBlendStateCreationDescription& Description)
+{
+  ezGALBlendStateNull* pState = EZ_NEW(&m_Allocator, ezGALBlendStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyBlendStatePlatform(ezGALBlendState* pBlendState)
+{
+  ezGALBlendStateNull* pState = static_cast<ezGALBlendStateNull*>(pBlendState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALDepthStencilState* ezGALDeviceNull::CreateDepthStencilStatePlatform(const ezGALDepthStencilStateCreationDescription& Description)
+{
+  ezGALDepthStencilStateNull* pState = EZ_NEW(&m_Allocator, ezGALDepthStencilStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyDepthStencilStatePlatform(ezGALDepthStencilState* pDepthStencilState)
+{
+  ezGALDepthStencilStateNull* pState = static_cast<ezGALDepthStencilStateNull*>(pDepthStencilState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALRasterizerState* ezGALDeviceNull::CreateRasterizerStatePlatform(const ezGALRasterizerStateCreationDescription& Description)
+{
+  ezGALRasterizerStateNull* pState = EZ_NEW(&m_Allocator, ezGALRasterizerStateNull, Description);
+
+  if (pState->InitPlatform(this).Succeeded())
+  {
+    return pState;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pState);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyRasterizerStatePlatform(ezGALRasterizerState* pRasterizerState)
+{
+  ezGALRasterizerStateNull* pState = static_cast<ezGALRasterizerStateNull*>(pRasterizerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+ezGALSamplerState* ezGALDeviceNull::CreateSamplerStatePlatform(const ezGALSamplerStateCreationDescription& Description)
+{
+  ezGALSamplerStateNull* pSampler = EZ_NEW(&m_Allocator, ezGALSamplerStateNull, Description);
+
+  if (pSampler->InitPlatform(this).Succeeded())
+  {
+    return pSampler;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pSampler);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroySamplerStatePlatform(ezGALSamplerState* pSamplerState)
+{
+  ezGALSamplerStateNull* pState = static_cast<ezGALSamplerStateNull*>(pSamplerState);
+  pState->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pState);
+}
+
+// Resource creation functions
+
+ezGALShader* ezGALDeviceNull::CreateShaderPlatform(const ezGALShaderCreationDescription& Description)
+{
+  ezGALShaderNull* pShader = EZ_NEW(&m_Allocator, ezGALShaderNull, Description);
+
+  if (!pShader->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pShader);
+    return nullptr;
+  }
+
+  return pShader;
+}
+
+void ezGALDeviceNull::DestroyShaderPlatform(ezGALShader* pShader)
+{
+  ezGALShaderNull* pNullShader = static_cast<ezGALShaderNull*>(pShader);
+  pNullShader->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullShader);
+}
+
+ezGALBuffer* ezGALDeviceNull::CreateBufferPlatform(const ezGALBufferCreationDescription& Description, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  ezGALBufferNull* pBuffer = EZ_NEW(&m_Allocator, ezGALBufferNull, Description);
+
+  if (!pBuffer->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+
+  return pBuffer;
+}
+
+void ezGALDeviceNull::DestroyBufferPlatform(ezGALBuffer* pBuffer)
+{
+  ezGALBufferNull* pNullBuffer = static_cast<ezGALBufferNull*>(pBuffer);
+  pNullBuffer->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullBuffer);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  ezGALTextureNull* pTexture = EZ_NEW(&m_Allocator, ezGALTextureNull, Description);
+
+  if (!pTexture->InitPlatform(this, pInitialData).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+
+  return pTexture;
+}
+
+void ezGALDeviceNull::DestroyTexturePlatform(ezGALTexture* pTexture)
+{
+  ezGALTextureNull* pNullTexture = static_cast<ezGALTextureNull*>(pTexture);
+  pNullTexture->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullTexture);
+}
+
+ezGALTexture* ezGALDeviceNull::CreateSharedTexturePlatform(const ezGALTextureCreationDescription& Description, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData, ezEnum<ezGALSharedTextureType> sharedType, ezGALPlatformSharedHandle handle)
+{
+  EZ_IGNORE_UNUSED(Description);
+  EZ_IGNORE_UNUSED(pInitialData);
+  EZ_IGNORE_UNUSED(sharedType);
+  EZ_IGNORE_UNUSED(handle);
+
+  ezLog::Error("Shared textures are not supported by the null device.");
+  return nullptr;
+}
+
+void ezGALDeviceNull::DestroySharedTexturePlatform(ezGALTexture* pTexture)
+{
+  EZ_IGNORE_UNUSED(pTexture);
+  EZ_REPORT_FAILURE("Shared textures are not supported by the null device.");
+}
+
+ezGALReadbackBuffer* ezGALDeviceNull::CreateReadbackBufferPlatform(const ezGALBufferCreationDescription& Description)
+{
+  ezGALReadbackBufferNull* pBuffer = EZ_NEW(&m_Allocator, ezGALReadbackBufferNull, Description);
+
+  if (!pBuffer->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pBuffer);
+    return nullptr;
+  }
+
+  return pBuffer;
+}
+
+void ezGALDeviceNull::DestroyReadbackBufferPlatform(ezGALReadbackBuffer* pReadbackBuffer)
+{
+  ezGALReadbackBufferNull* pBuffer = static_cast<ezGALReadbackBufferNull*>(pReadbackBuffer);
+  pBuffer->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pBuffer);
+}
+
+ezGALReadbackTexture* ezGALDeviceNull::CreateReadbackTexturePlatform(const ezGALTextureCreationDescription& Description)
+{
+  ezGALReadbackTextureNull* pTexture = EZ_NEW(&m_Allocator, ezGALReadbackTextureNull, Description);
+
+  if (!pTexture->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pTexture);
+    return nullptr;
+  }
+
+  return pTexture;
+}
+
+void ezGALDeviceNull::DestroyReadbackTexturePlatform(ezGALReadbackTexture* pReadbackTexture)
+{
+  ezGALReadbackTextureNull* pTexture = static_cast<ezGALReadbackTextureNull*>(pReadbackTexture);
+  pTexture->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pTexture);
+}
+
+ezGALTextureResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description)
+{
+  ezGALTextureResourceViewNull* pResourceView = EZ_NEW(&m_Allocator, ezGALTextureResourceViewNull, pResource, Description);
+
+  if (!pResourceView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pResourceView);
+    return nullptr;
+  }
+
+  return pResourceView;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALTextureResourceView* pResourceView)
+{
+  ezGALTextureResourceViewNull* pNullResourceView = static_cast<ezGALTextureResourceViewNull*>(pResourceView);
+  pNullResourceView->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullResourceView);
+}
+
+ezGALBufferResourceView* ezGALDeviceNull::CreateResourceViewPlatform(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description)
+{
+  ezGALBufferResourceViewNull* pResourceView = EZ_NEW(&m_Allocator, ezGALBufferResourceViewNull, pResource, Description);
+
+  if (!pResourceView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pResourceView);
+    return nullptr;
+  }
+
+  return pResourceView;
+}
+
+void ezGALDeviceNull::DestroyResourceViewPlatform(ezGALBufferResourceView* pResourceView)
+{
+  ezGALBufferResourceViewNull* pNullResourceView = static_cast<ezGALBufferResourceViewNull*>(pResourceView);
+  pNullResourceView->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullResourceView);
+}
+
+ezGALRenderTargetView* ezGALDeviceNull::CreateRenderTargetViewPlatform(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+{
+  ezGALRenderTargetViewNull* pRTView = EZ_NEW(&m_Allocator, ezGALRenderTargetViewNull, pTexture, Description);
+
+  if (!pRTView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pRTView);
+    return nullptr;
+  }
+
+  return pRTView;
+}
+
+void ezGALDeviceNull::DestroyRenderTargetViewPlatform(ezGALRenderTargetView* pRenderTargetView)
+{
+  ezGALRenderTargetViewNull* pNullRenderTargetView = static_cast<ezGALRenderTargetViewNull*>(pRenderTargetView);
+  pNullRenderTargetView->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pNullRenderTargetView);
+}
+
+ezGALTextureUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALTexture* pTextureOfBuffer, const ezGALTextureUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALTextureUnorderedAccessViewNull* pUnorderedAccessView = EZ_NEW(&m_Allocator, ezGALTextureUnorderedAccessViewNull, pTextureOfBuffer, Description);
+
+  if (!pUnorderedAccessView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessView);
+    return nullptr;
+  }
+
+  return pUnorderedAccessView;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALTextureUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALTextureUnorderedAccessViewNull* pUnorderedAccessViewNull = static_cast<ezGALTextureUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pUnorderedAccessViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+}
+
+ezGALBufferUnorderedAccessView* ezGALDeviceNull::CreateUnorderedAccessViewPlatform(ezGALBuffer* pBufferOfBuffer, const ezGALBufferUnorderedAccessViewCreationDescription& Description)
+{
+  ezGALBufferUnorderedAccessViewNull* pUnorderedAccessView = EZ_NEW(&m_Allocator, ezGALBufferUnorderedAccessViewNull, pBufferOfBuffer, Description);
+
+  if (!pUnorderedAccessView->InitPlatform(this).Succeeded())
+  {
+    EZ_DELETE(&m_Allocator, pUnorderedAccessView);
+    return nullptr;
+  }
+
+  return pUnorderedAccessView;
+}
+
+void ezGALDeviceNull::DestroyUnorderedAccessViewPlatform(ezGALBufferUnorderedAccessView* pUnorderedAccessView)
+{
+  ezGALBufferUnorderedAccessViewNull* pUnorderedAccessViewNull = static_cast<ezGALBufferUnorderedAccessViewNull*>(pUnorderedAccessView);
+  pUnorderedAccessViewNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pUnorderedAccessViewNull);
+}
+
+// Other rendering creation functions
+
+ezGALVertexDeclaration* ezGALDeviceNull::CreateVertexDeclarationPlatform(const ezGALVertexDeclarationCreationDescription& Description)
+{
+  ezGALVertexDeclarationNull* pVertexDeclaration = EZ_NEW(&m_Allocator, ezGALVertexDeclarationNull, Description);
+
+  if (pVertexDeclaration->InitPlatform(this).Succeeded())
+  {
+    return pVertexDeclaration;
+  }
+  else
+  {
+    EZ_DELETE(&m_Allocator, pVertexDeclaration);
+    return nullptr;
+  }
+}
+
+void ezGALDeviceNull::DestroyVertexDeclarationPlatform(ezGALVertexDeclaration* pVertexDeclaration)
+{
+  ezGALVertexDeclarationNull* pVertexDeclarationNull = static_cast<ezGALVertexDeclarationNull*>(pVertexDeclaration);
+  pVertexDeclarationNull->DeInitPlatform(this).IgnoreResult();
+  EZ_DELETE(&m_Allocator, pVertexDeclarationNull);
+}
+
+// GPU -> CPU query functions
+
+ezGALTimestampHandle ezGALDeviceNull::InsertTimestamp()
+{
+  const ezUInt64 uiTimestamp = m_uiNextTimestamp++;
+  m_Timestamps[uiTimestamp % TIMESTAMP_COUNT] = ezTime::Now();
+
+  return ezGALTimestampHandle(uiTimestamp % TIMESTAMP_COUNT, uiTimestamp / TIMESTAMP_COUNT);
+}
+
+ezGALOcclusionHandle ezGALDeviceNull::AllocateOcclusionQuery()
+{
+  const ezUInt32 uiQuery = m_uiNextOcclusionQuery++;
+  return ezGALOcclusionHandle(uiQuery % TIMESTAMP_COUNT, uiQuery / TIMESTAMP_COUNT);
+}
+
+ezGALFenceHandle ezGALDeviceNull::InsertFence()
+{
+  return m_uiNextFence++;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetTimestampResultPlatform(ezGALTimestampHandle hTimestamp, ezTime& out_result)
+{
+  const ezUInt64 uiTimestamp = hTimestamp.m_Generation * TIMESTAMP_COUNT + hTimestamp.m_InstanceIndex;
+  if (uiTimestamp >= m_uiNextTimestamp || m_uiNextTimestamp - uiTimestamp > TIMESTAMP_COUNT)
+  {
+    return ezGALAsyncResult::Expired;
+  }
+
+  out_result = m_Timestamps[hTimestamp.m_InstanceIndex];
+  return ezGALAsyncResult::Ready;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetOcclusionResultPlatform(ezGALOcclusionHandle hOcclusion, ezUInt64& out_uiResult)
+{
+  EZ_IGNORE_UNUSED(hOcclusion);
+
+  // Nothing is ever rasterized, so report everything as visible to not have any object culled by occlusion queries.
+  out_uiResult = 1;
+  return ezGALAsyncResult::Ready;
+}
+
+ezEnum<ezGALAsyncResult> ezGALDeviceNull::GetFenceResultPlatform(ezGALFenceHandle hFence, ezTime timeout)
+{
+  EZ_IGNORE_UNUSED(hFence);
+  EZ_IGNORE_UNUSED(timeout);
+  return ezGALAsyncResult::Ready;
+}
+
+ezResult ezGALDeviceNull::LockBufferPlatform(const ezGALReadbackBuffer* pBuffer, ezArrayPtr<const ezUInt8>& out_Memory) const
+{
+  out_Memory = static_cast<const ezGALReadbackBufferNull*>(pBuffer)->GetMemory();
+  return EZ_SUCCESS;
+}
+
+void ezGALDeviceNull::UnlockBufferPlatform(const ezGALReadbackBuffer* pBuffer) const
+{
+  EZ_IGNORE_UNUSED(pBuffer);
+}
+
+ezResult ezGALDeviceNull::LockTexturePlatform(const ezGALReadbackTexture* pTexture, const ezArrayPtr<const ezGALTextureSubresource>& subResources, ezDynamicArray<ezGALSystemMemoryDescription>& out_Memory) const
+{
+  const ezGALReadbackTextureNull* pNullTexture = static_cast<const ezGALReadbackTextureNull*>(pTexture);
+
+  out_Memory.Reserve(subResources.GetCount());
+  for (const ezGALTextureSubresource& subResource : subResources)
+  {
+    pNullTexture->GetSubResourceMemory(subResource, out_Memory.ExpandAndGetRef());
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezGALDeviceNull::UnlockTexturePlatform(const ezGALReadbackTexture* pTexture, const ezArrayPtr<const ezGALTextureSubresource>& subResources) const
+{
+  EZ_IGNORE_UNUSED(pTexture);
+  EZ_IGNORE_UNUSED(subResources);
+}
+
+// Misc functions
+
+void ezGALDeviceNull::BeginFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains, const ezUInt64 uiAppFrame)
+{
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  ezStringBuilder sb;
+  sb.SetFormat("RENDER FRAME {}", uiAppFrame);
+  m_pFrameTimingScope = ezProfilingScopeAndMarker::Start(m_pCommandEncoder.Borrow(), sb);
+#else
+  EZ_IGNORE_UNUSED(uiAppFrame);
+#endif
+
+  for (ezGALSwapChain* pSwapChain : swapchains)
+  {
+    pSwapChain->AcquireNextRenderTarget(this);
+  }
+}
+
+void ezGALDeviceNull::EndFramePlatform(ezArrayPtr<ezGALSwapChain*> swapchains)
+{
+  for (ezGALSwapChain* pSwapChain : swapchains)
+  {
+    pSwapChain->PresentRenderTarget(this);
+  }
+
+#if EZ_ENABLED(EZ_USE_PROFILING)
+  ezProfilingScopeAndMarker::Stop(m_pCommandEncoder.Borrow(), m_pFrameTimingScope);
+#endif
+
+  m_pCommandEncoderImpl->EndFrame();
+
+  // There is no GPU that could still be using the resources of this frame.
+  m_uiSafeFrame = m_uiFrameCounter;
+  ++m_uiFrameCounter;
+}
+
+ezUInt64 ezGALDeviceNull::GetCurrentFramePlatform() const
+{
+  return m_uiFrameCounter;
+}
+
+ezUInt64 ezGALDeviceNull::GetSafeFramePlatform() const
+{
+  return m_uiSafeFrame;
+}
+
+void ezGALDeviceNull::FillCapabilitiesPlatform()
+{
+  m_Capabilities.m_sAdapterName = "Null Device";
+  m_Capabilities.m_bHardwareAccelerated = false;
+
+  m_Capabilities.m_bSupportsMultithreadedResourceCreation = true;
+  m_Capabilities.m_bSupportsNoOverwriteBufferUpdate = true;
+
+  for (ezUInt32 stage = 0; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    m_Capabilities.m_bShaderStageSupported[stage] = true;
+  }
+
+  m_Capabilities.m_bSupportsIndirectDraw = true;
+  m_Capabilities.m_bSupportsConservativeRasterization = true;
+  m_Capabilities.m_bSupportsVSRenderTargetArrayIndex = true;
+  m_Capabilities.m_bSupportsTexelBuffer = true;
+  m_Capabilities.m_bSupportsMultiSampledArrays = true;
+  m_Capabilities.m_bSupportsSharedTextures = false;
+
+  m_Capabilities.m_FormatSupport.SetCount(ezGALResourceFormat::ENUM_COUNT);
+  for (ezUInt32 i = 0; i < ezGALResourceFormat::ENUM_COUNT; i++)
+  {
+    m_Capabilities.m_FormatSupport[i] = ezGALResourceFormatSupport::Texture | ezGALResourceFormatSupport::RenderTarget | ezGALResourceFormatSupport::TextureRW |
+                                        ezGALResourceFormatSupport::MSAA2x | ezGALResourceFormatSupport::MSAA4x | ezGALResourceFormatSupport::MSAA8x |
+                                        ezGALResourceFormatSupport::VertexAttribute;
+  }
+}
+
+void ezGALDeviceNull::WaitIdlePlatform()
+{
+  DestroyDeadObjects();
+}
+
+const ezGALSharedTexture* ezGALDeviceNull::GetSharedTexture(ezGALTextureHandle hTexture) const
+{
+  EZ_IGNORE_UNUSED(hTexture);
+  return nullptr;
+}
+
+EZ_STATICLINK_FILE(RendererNull, RendererNull_Device_Implementation_DeviceNull);
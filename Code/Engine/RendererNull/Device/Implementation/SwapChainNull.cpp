@@ -0,0 +1,81 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <Core/System/Window.h>
+#include <RendererFoundation/Device/Device.h>
+#include <RendererNull/Device/SwapChainNull.h>
+
+void ezGALSwapChainNull::AcquireNextRenderTarget(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+}
+
+void ezGALSwapChainNull::PresentRenderTarget(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+}
+
+ezResult ezGALSwapChainNull::UpdateSwapChain(ezGALDevice* pDevice, ezEnum<ezGALPresentMode> newPresentMode)
+{
+  m_CurrentPresentMode = newPresentMode;
+  DestroyBackBufferInternal(pDevice);
+  return CreateBackBufferInternal(pDevice);
+}
+
+ezGALSwapChainNull::ezGALSwapChainNull(const ezGALWindowSwapChainCreationDescription& Description)
+  : ezGALWindowSwapChain(Description)
+{
+}
+
+ezGALSwapChainNull::~ezGALSwapChainNull() = default;
+
+ezResult ezGALSwapChainNull::InitPlatform(ezGALDevice* pDevice)
+{
+  m_CurrentPresentMode = m_WindowDesc.m_InitialPresentMode;
+
+  // The back buffer size is taken from the window, so it must not be destroyed while the swap chain is still alive.
+  m_WindowDesc.m_pWindow->AddReference();
+
+  return CreateBackBufferInternal(pDevice);
+}
+
+ezResult ezGALSwapChainNull::CreateBackBufferInternal(ezGALDevice* pDevice)
+{
+  ezGALTextureCreationDescription TexDesc;
+  TexDesc.m_uiWidth = m_WindowDesc.m_pWindow->GetClientAreaSize().width;
+  TexDesc.m_uiHeight = m_WindowDesc.m_pWindow->GetClientAreaSize().height;
+  TexDesc.m_SampleCount = m_WindowDesc.m_SampleCount;
+  TexDesc.m_Format = m_WindowDesc.m_BackBufferFormat;
+  TexDesc.m_bAllowShaderResourceView = false;
+  TexDesc.m_bAllowRenderTargetView = true;
+  TexDesc.m_ResourceAccess.m_bImmutable = true;
+
+  m_hBackBufferTexture = pDevice->CreateTexture(TexDesc);
+  if (m_hBackBufferTexture.IsInvalidated())
+  {
+    ezLog::Error("Couldn't create backbuffer texture object!");
+    return EZ_FAILURE;
+  }
+
+  m_RenderTargets.m_hRTs[0] = m_hBackBufferTexture;
+  m_CurrentSize = ezSizeU32(TexDesc.m_uiWidth, TexDesc.m_uiHeight);
+  return EZ_SUCCESS;
+}
+
+void ezGALSwapChainNull::DestroyBackBufferInternal(ezGALDevice* pDevice)
+{
+  if (!m_hBackBufferTexture.IsInvalidated())
+  {
+    pDevice->DestroyTexture(m_hBackBufferTexture);
+    m_hBackBufferTexture.Invalidate();
+  }
+
+  m_RenderTargets.m_hRTs[0].Invalidate();
+}
+
+ezResult ezGALSwapChainNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  DestroyBackBufferInternal(pDevice);
+
+  m_WindowDesc.m_pWindow->RemoveReference();
+  return EZ_SUCCESS;
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <RendererFoundation/Descriptors/Descriptors.h>
+#include <RendererFoundation/Device/SwapChain.h>
+#include <RendererNull/RendererNullDLL.h>
+
+class ezGALDeviceNull;
+
+/// \brief A window swap chain that only owns a back buffer texture matching the window's client area. Presenting is a no-op.
+class ezGALSwapChainNull : public ezGALWindowSwapChain
+{
+public:
+  virtual void AcquireNextRenderTarget(ezGALDevice* pDevice) override;
+  virtual void PresentRenderTarget(ezGALDevice* pDevice) override;
+  virtual ezResult UpdateSwapChain(ezGALDevice* pDevice, ezEnum<ezGALPresentMode> newPresentMode) override;
+
+protected:
+  friend class ezGALDeviceNull;
+  friend class ezMemoryUtils;
+
+  ezGALSwapChainNull(const ezGALWindowSwapChainCreationDescription& Description);
+
+  virtual ~ezGALSwapChainNull();
+
+  virtual ezResult InitPlatform(ezGALDevice* pDevice) override;
+  ezResult CreateBackBufferInternal(ezGALDevice* pDevice);
+  void DestroyBackBufferInternal(ezGALDevice* pDevice);
+  virtual ezResult DeInitPlatform(ezGALDevice* pDevice) override;
+
+  ezGALTextureHandle m_hBackBufferTexture;
+  ezEnum<ezGALPresentMode> m_CurrentPresentMode;
+};
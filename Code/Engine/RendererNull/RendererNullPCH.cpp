@@ -0,0 +1,9 @@
+#include <RendererNull/RendererNullPCH.h>
+
+EZ_STATICLINK_LIBRARY(RendererNull)
+{
+  if (bReturn)
+    return;
+
+  EZ_STATICLINK_REFERENCE(RendererNull_Device_Implementation_DeviceNull);
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Logging/Log.h>
@@ -0,0 +1,240 @@
+#include <RendererNull/RendererNullPCH.h>
+
+#include <RendererNull/Resources/ResourcesNull.h>
+
+namespace
+{
+  ezUInt32 GetRowPitch(const ezGALTextureCreationDescription& desc, ezUInt32 uiMipLevel)
+  {
+    const ezUInt32 uiWidth = ezMath::Max(1u, desc.m_uiWidth >> uiMipLevel);
+    return ezMath::Max(1u, uiWidth * ezGALResourceFormat::GetBitsPerElement(desc.m_Format) / 8);
+  }
+
+  ezUInt32 GetSlicePitch(const ezGALTextureCreationDescription& desc, ezUInt32 uiMipLevel)
+  {
+    const ezUInt32 uiHeight = ezMath::Max(1u, desc.m_uiHeight >> uiMipLevel);
+    return GetRowPitch(desc, uiMipLevel) * uiHeight;
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+// ezGALBufferNull
+
+ezGALBufferNull::ezGALBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALBuffer(Description)
+{
+}
+
+ezGALBufferNull::~ezGALBufferNull() = default;
+
+ezResult ezGALBufferNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<const ezUInt8> pInitialData)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  EZ_IGNORE_UNUSED(pInitialData);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+void ezGALBufferNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ezGALTextureNull
+
+ezGALTextureNull::ezGALTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALTexture(Description)
+{
+}
+
+ezGALTextureNull::~ezGALTextureNull() = default;
+
+ezResult ezGALTextureNull::InitPlatform(ezGALDevice* pDevice, ezArrayPtr<ezGALSystemMemoryDescription> pInitialData)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  EZ_IGNORE_UNUSED(pInitialData);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+void ezGALTextureNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ezGALReadbackBufferNull
+
+ezGALReadbackBufferNull::ezGALReadbackBufferNull(const ezGALBufferCreationDescription& Description)
+  : ezGALReadbackBuffer(Description)
+{
+}
+
+ezGALReadbackBufferNull::~ezGALReadbackBufferNull() = default;
+
+ezResult ezGALReadbackBufferNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  m_Memory.SetCount(m_Description.m_uiTotalSize);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALReadbackBufferNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  m_Memory.Clear();
+  m_Memory.Compact();
+  return EZ_SUCCESS;
+}
+
+void ezGALReadbackBufferNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// ezGALReadbackTextureNull
+
+ezGALReadbackTextureNull::ezGALReadbackTextureNull(const ezGALTextureCreationDescription& Description)
+  : ezGALReadbackTexture(Description)
+{
+}
+
+ezGALReadbackTextureNull::~ezGALReadbackTextureNull() = default;
+
+void ezGALReadbackTextureNull::GetSubResourceMemory(const ezGALTextureSubresource& subResource, ezGALSystemMemoryDescription& out_memory) const
+{
+  // All sub-resources share the same memory, the largest one (mip 0) fits into it.
+  out_memory.m_pData = ezMakeByteBlobPtr(const_cast<ezUInt8*>(m_Memory.GetData()), m_Memory.GetCount());
+  out_memory.m_uiRowPitch = GetRowPitch(m_Description, subResource.m_uiMipLevel);
+  out_memory.m_uiSlicePitch = GetSlicePitch(m_Description, subResource.m_uiMipLevel);
+}
+
+ezResult ezGALReadbackTextureNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  m_Memory.SetCount(GetSlicePitch(m_Description, 0) * ezMath::Max(1u, m_Description.m_uiDepth));
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALReadbackTextureNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  m_Memory.Clear();
+  m_Memory.Compact();
+  return EZ_SUCCESS;
+}
+
+void ezGALReadbackTextureNull::SetDebugNamePlatform(const char* szName) const
+{
+  EZ_IGNORE_UNUSED(szName);
+}
+
+//////////////////////////////////////////////////////////////////////////
+// Views
+
+ezGALTextureResourceViewNull::ezGALTextureResourceViewNull(ezGALTexture* pResource, const ezGALTextureResourceViewCreationDescription& Description)
+  : ezGALTextureResourceView(pResource, Description)
+{
+}
+
+ezGALTextureResourceViewNull::~ezGALTextureResourceViewNull() = default;
+
+ezResult ezGALTextureResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALBufferResourceViewNull::ezGALBufferResourceViewNull(ezGALBuffer* pResource, const ezGALBufferResourceViewCreationDescription& Description)
+  : ezGALBufferResourceView(pResource, Description)
+{
+}
+
+ezGALBufferResourceViewNull::~ezGALBufferResourceViewNull() = default;
+
+ezResult ezGALBufferResourceViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferResourceViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALTextureUnorderedAccessViewNull::ezGALTextureUnorderedAccessViewNull(ezGALTexture* pResource, const ezGALTextureUnorderedAccessViewCreationDescription& Description)
+  : ezGALTextureUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALTextureUnorderedAccessViewNull::~ezGALTextureUnorderedAccessViewNull() = default;
+
+ezResult ezGALTextureUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALTextureUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALBufferUnorderedAccessViewNull::ezGALBufferUnorderedAccessViewNull(ezGALBuffer* pResource, const ezGALBufferUnorderedAccessViewCreationDescription& Description)
+  : ezGALBufferUnorderedAccessView(pResource, Description)
+{
+}
+
+ezGALBufferUnorderedAccessViewNull::~ezGALBufferUnorderedAccessViewNull() = default;
+
+ezResult ezGALBufferUnorderedAccessViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALBufferUnorderedAccessViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezGALRenderTargetViewNull::ezGALRenderTargetViewNull(ezGALTexture* pTexture, const ezGALRenderTargetViewCreationDescription& Description)
+  : ezGALRenderTargetView(pTexture, Description)
+{
+}
+
+ezGALRenderTargetViewNull::~ezGALRenderTargetViewNull() = default;
+
+ezResult ezGALRenderTargetViewNull::InitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
+
+ezResult ezGALRenderTargetViewNull::DeInitPlatform(ezGALDevice* pDevice)
+{
+  EZ_IGNORE_UNUSED(pDevice);
+  return EZ_SUCCESS;
+}
@@ -0,0 +1,383 @@
+#include <ShaderCompilerNull/ShaderCompilerNull.h>
+
+#include <Foundation/CodeUtils/Tokenizer.h>
+#include <Foundation/Types/Bitflags.h>
+#include <Foundation/Utilities/ConversionUtils.h>
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezShaderCompilerNull, 1, ezRTTIDefaultAllocator<ezShaderCompilerNull>)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+namespace
+{
+  /// Tokens of a preprocessed shader stage without whitespace and comments.
+  using Tokens = ezDynamicArray<const ezToken*>;
+
+  void TokenizeSource(ezStringView sSource, ezTokenizer& ref_tokenizer, Tokens& out_tokens)
+  {
+    ref_tokenizer.SetTreatHashSignAsLineComment(true);
+    ref_tokenizer.Tokenize(ezArrayPtr<const ezUInt8>((const ezUInt8*)sSource.GetStartPointer(), sSource.GetElementCount()), ezLog::GetThreadLocalLogSystem(), false);
+
+    out_tokens.Clear();
+    for (const ezToken& token : ref_tokenizer.GetTokens())
+    {
+      if (token.m_iType == ezTokenType::Identifier || token.m_iType == ezTokenType::NonIdentifier || token.m_iType == ezTokenType::Integer)
+      {
+        out_tokens.PushBack(&token);
+      }
+    }
+  }
+
+  /// Returns the index of the first token after the opening brace of 'sKeyword sName ... {', or ezInvalidIndex.
+  ezUInt32 FindBlock(const Tokens& tokens, ezStringView sKeyword, ezStringView sName)
+  {
+    for (ezUInt32 i = 0; i + 1 < tokens.GetCount(); ++i)
+    {
+      if (tokens[i]->m_DataView != sKeyword || tokens[i + 1]->m_DataView != sName)
+        continue;
+
+      // skip register declarations etc. up to the body, a ';' means this was only a forward declaration
+      for (ezUInt32 j = i + 2; j < tokens.GetCount(); ++j)
+      {
+        if (tokens[j]->m_DataView == "{")
+          return j + 1;
+        if (tokens[j]->m_DataView == ";")
+          break;
+      }
+    }
+
+    return ezInvalidIndex;
+  }
+
+  struct ConstantType
+  {
+    ezShaderConstant::Type::Enum m_Type = ezShaderConstant::Type::Default;
+    ezUInt32 m_uiSize = 0;
+    bool m_bStartsNewRegister = false;
+  };
+
+  ezResult ParseMembers(const Tokens& tokens, ezUInt32 uiCurToken, ezShaderConstantBufferLayout* pLayout, ezUInt32& out_uiSize, ezLogInterface* pLog);
+
+  ezResult GetConstantType(const Tokens& tokens, ezStringView sType, ConstantType& out_type, ezLogInterface* pLog)
+  {
+    struct ScalarType
+    {
+      const char* m_szName;
+      ezShaderConstant::Type::Enum m_Types[4];
+    };
+
+    static const ScalarType s_ScalarTypes[] = {
+      {"float", {ezShaderConstant::Type::Float1, ezShaderConstant::Type::Float2, ezShaderConstant::Type::Float3, ezShaderConstant::Type::Float4}},
+      {"half", {ezShaderConstant::Type::Float1, ezShaderConstant::Type::Float2, ezShaderConstant::Type::Float3, ezShaderConstant::Type::Float4}},
+      {"int", {ezShaderConstant::Type::Int1, ezShaderConstant::Type::Int2, ezShaderConstant::Type::Int3, ezShaderConstant::Type::Int4}},
+      {"uint", {ezShaderConstant::Type::UInt1, ezShaderConstant::Type::UInt2, ezShaderConstant::Type::UInt3, ezShaderConstant::Type::UInt4}},
+      {"dword", {ezShaderConstant::Type::UInt1, ezShaderConstant::Type::UInt2, ezShaderConstant::Type::UInt3, ezShaderConstant::Type::UInt4}},
+      {"bool", {ezShaderConstant::Type::Bool, ezShaderConstant::Type::Default, ezShaderConstant::Type::Default, ezShaderConstant::Type::Default}},
+    };
+
+    for (const ScalarType& scalarType : s_ScalarTypes)
+    {
+      if (!sType.StartsWith(scalarType.m_szName))
+        continue;
+
+      ezStringView sDimensions = sType;
+      sDimensions.Shrink(ezStringUtils::GetStringElementCount(scalarType.m_szName), 0);
+
+      // all scalar types take 4 bytes in a constant buffer, even half and bool
+      if (sDimensions.IsEmpty())
+      {
+        out_type.m_Type = scalarType.m_Types[0];
+        out_type.m_uiSize = 4;
+        return EZ_SUCCESS;
+      }
+
+      const char* szDimensions = sDimensions.GetStartPointer();
+      if (sDimensions.GetElementCount() == 1 && szDimensions[0] >= '1' && szDimensions[0] <= '4')
+      {
+        const ezUInt32 uiComponents = szDimensions[0] - '0';
+        out_type.m_Type = scalarType.m_Types[uiComponents - 1];
+        out_type.m_uiSize = uiComponents * 4;
+        return EZ_SUCCESS;
+      }
+
+      if (sDimensions.GetElementCount() == 3 && szDimensions[1] == 'x' && szDimensions[0] >= '1' && szDimensions[0] <= '4' && szDimensions[2] >= '1' && szDimensions[2] <= '4')
+      {
+        const ezUInt32 uiRows = szDimensions[0] - '0';
+        const ezUInt32 uiColumns = szDimensions[2] - '0';
+
+        out_type.m_Type = ezShaderConstant::Type::Default;
+        if (scalarType.m_Types[0] == ezShaderConstant::Type::Float1 && uiRows == uiColumns && uiRows == 3)
+          out_type.m_Type = ezShaderConstant::Type::Mat3x3;
+        else if (scalarType.m_Types[0] == ezShaderConstant::Type::Float1 && uiRows == uiColumns && uiRows == 4)
+          out_type.m_Type = ezShaderConstant::Type::Mat4x4;
+
+        // matrices are column major by default, each column starts a new register
+        out_type.m_uiSize = (uiColumns - 1) * 16 + uiRows * 4;
+        out_type.m_bStartsNewRegister = true;
+        return EZ_SUCCESS;
+      }
+    }
+
+    const ezUInt32 uiStructBody = FindBlock(tokens, "struct", sType);
+    if (uiStructBody == ezInvalidIndex)
+    {
+      ezLog::Error(pLog, "Unknown constant type '{}'", sType);
+      return EZ_FAILURE;
+    }
+
+    EZ_SUCCEED_OR_RETURN(ParseMembers(tokens, uiStructBody, nullptr, out_type.m_uiSize, pLog));
+    out_type.m_Type = sType == "Transform" ? ezShaderConstant::Type::Transform : ezShaderConstant::Type::Struct;
+    out_type.m_bStartsNewRegister = true;
+    return EZ_SUCCESS;
+  }
+
+  /// Parses the member declarations of a cbuffer or struct body up to the closing brace and places them according to the HLSL packing rules.
+  ezResult ParseMembers(const Tokens& tokens, ezUInt32 uiCurToken, ezShaderConstantBufferLayout* pLayout, ezUInt32& out_uiSize, ezLogInterface* pLog)
+  {
+    ezUInt32 uiOffset = 0;
+
+    while (uiCurToken < tokens.GetCount() && tokens[uiCurToken]->m_DataView != "}")
+    {
+      if (tokens[uiCurToken]->m_DataView == ";")
+      {
+        ++uiCurToken;
+        continue;
+      }
+
+      // The type is the last identifier before the first variable name, this skips modifiers like 'row_major'.
+      ezUInt32 uiName = uiCurToken;
+      while (uiName + 1 < tokens.GetCount() && tokens[uiName + 1]->m_iType == ezTokenType::Identifier)
+      {
+        ++uiName;
+      }
+
+      if (tokens[uiCurToken]->m_iType != ezTokenType::Identifier || uiName == uiCurToken)
+      {
+        ezLog::Error(pLog, "Unexpected token '{}' in constant buffer declaration", tokens[uiCurToken]->m_DataView);
+        return EZ_FAILURE;
+      }
+
+      const ezUInt32 uiType = uiName - 1;
+
+      ConstantType type;
+      EZ_SUCCEED_OR_RETURN(GetConstantType(tokens, tokens[uiType]->m_DataView, type, pLog));
+
+      // one or more declarators: name [N] : packoffset(...) , name2 ... ;
+      uiCurToken = uiType + 1;
+      while (uiCurToken < tokens.GetCount())
+      {
+        const ezStringView sName = tokens[uiCurToken]->m_DataView;
+        ++uiCurToken;
+
+        ezUInt32 uiArrayElements = 1;
+        if (uiCurToken + 2 < tokens.GetCount() && tokens[uiCurToken]->m_DataView == "[")
+        {
+          if (ezConversionUtils::StringToUInt(tokens[uiCurToken + 1]->m_DataView, uiArrayElements).Failed() || tokens[uiCurToken + 2]->m_DataView != "]")
+          {
+            ezLog::Error(pLog, "Constant '{}': Only one-dimensional arrays with a literal size are supported", sName);
+            return EZ_FAILURE;
+          }
+          uiCurToken += 3;
+        }
+
+        // skip semantics and packoffset, the declaration order determines the offset
+        while (uiCurToken < tokens.GetCount() && tokens[uiCurToken]->m_DataView != "," && tokens[uiCurToken]->m_DataView != ";")
+        {
+          ++uiCurToken;
+        }
+
+        // array elements and types that start a new register are aligned to 16 bytes, everything else must not straddle a register boundary
+        const bool bIsArray = uiArrayElements > 1;
+        if (type.m_bStartsNewRegister || bIsArray || (uiOffset % 16) + type.m_uiSize > 16)
+        {
+          uiOffset = ezMemoryUtils::AlignSize(uiOffset, 16u);
+        }
+
+        if (pLayout != nullptr)
+        {
+          ezShaderConstant& constant = pLayout->m_Constants.ExpandAndGetRef();
+          constant.m_sName.Assign(sName);
+          constant.m_Type = type.m_Type;
+          constant.m_uiArrayElements = static_cast<ezUInt8>(uiArrayElements);
+          constant.m_uiOffset = static_cast<ezUInt16>(uiOffset);
+        }
+
+        uiOffset += ezMemoryUtils::AlignSize(type.m_uiSize, 16u) * (uiArrayElements - 1) + type.m_uiSize;
+
+        if (uiCurToken >= tokens.GetCount() || tokens[uiCurToken++]->m_DataView == ";")
+          break;
+      }
+    }
+
+    if (uiCurToken >= tokens.GetCount())
+    {
+      ezLog::Error(pLog, "Constant buffer declaration is not terminated");
+      return EZ_FAILURE;
+    }
+
+    out_uiSize = uiOffset;
+    return EZ_SUCCESS;
+  }
+} // namespace
+
+ezResult ezShaderCompilerNull::ModifyShaderSource(ezShaderProgramData& inout_data, ezLogInterface* pLog)
+{
+  // The source is not modified, the same bindings are derived from it again in Compile. This only reports errors early.
+  ezHashTable<ezHashedString, ezShaderResourceBinding> bindings;
+  EZ_SUCCEED_OR_RETURN(CollectShaderResourceBindings(inout_data, bindings, pLog));
+
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    inout_data.m_Resources[stage].Clear();
+  }
+  return EZ_SUCCESS;
+}
+
+ezResult ezShaderCompilerNull::Compile(ezShaderProgramData& inout_data, ezLogInterface* pLog)
+{
+  ezHashTable<ezHashedString, ezShaderResourceBinding> bindings;
+  EZ_SUCCEED_OR_RETURN(CollectShaderResourceBindings(inout_data, bindings, pLog));
+  ReflectConstantBufferLayouts(inout_data, bindings, pLog);
+
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    if (inout_data.m_uiSourceHash[stage] == 0 || !inout_data.m_bWriteToDisk[stage])
+      continue;
+
+    if (inout_data.m_sShaderSource[stage].FindSubString("main") == nullptr)
+      continue;
+
+    ezGALShaderByteCode* pByteCode = inout_data.m_ByteCode[stage].Borrow();
+
+    // There is nothing to execute, but the byte code must not be empty for the stage to be considered present.
+    const ezUInt32 uiSourceHash = inout_data.m_uiSourceHash[stage];
+    pByteCode->m_ByteCode.SetCountUninitialized(sizeof(uiSourceHash));
+    ezMemoryUtils::Copy(pByteCode->m_ByteCode.GetData(), reinterpret_cast<const ezUInt8*>(&uiSourceHash), sizeof(uiSourceHash));
+
+    const ezBitflags<ezGALShaderStageFlags> stageFlag = ezGALShaderStageFlags::MakeFromShaderStage((ezGALShaderStage::Enum)stage);
+    for (auto it : bindings)
+    {
+      if (!it.Value().m_Stages.IsAnySet(stageFlag))
+        continue;
+
+      ezShaderResourceBinding& binding = pByteCode->m_ShaderResourceBindings.ExpandAndGetRef();
+      binding = it.Value();
+      binding.m_Stages = stageFlag;
+    }
+
+    // Sort by set and slot so that the binding order does not depend on the hash table layout.
+    pByteCode->m_ShaderResourceBindings.Sort([](const ezShaderResourceBinding& a, const ezShaderResourceBinding& b)
+      {
+      if (a.m_iSet != b.m_iSet)
+        return a.m_iSet < b.m_iSet;
+      return a.m_iSlot < b.m_iSlot; });
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezShaderCompilerNull::CollectShaderResourceBindings(ezShaderProgramData& inout_data, ezHashTable<ezHashedString, ezShaderResourceBinding>& out_bindings, ezLogInterface* pLog)
+{
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    inout_data.m_Resources[stage].Clear();
+    ezShaderParser::ParseShaderResources(inout_data.m_sShaderSource[stage], inout_data.m_Resources[stage]);
+  }
+
+  EZ_SUCCEED_OR_RETURN(ezShaderParser::MergeShaderResourceBindings(inout_data, out_bindings, pLog));
+  DefineShaderResourceBindings(inout_data, out_bindings);
+  return ezShaderParser::SanityCheckShaderResourceBindings(out_bindings, pLog);
+}
+
+void ezShaderCompilerNull::DefineShaderResourceBindings(const ezShaderProgramData& data, ezHashTable<ezHashedString, ezShaderResourceBinding>& inout_resourceBinding)
+{
+  // Determine which indices are hard-coded in the shader already.
+  ezHybridArray<ezHybridBitfield<64>, 4> slotInUseInSet;
+  for (auto it : inout_resourceBinding)
+  {
+    ezInt16& iSet = it.Value().m_iSet;
+    if (iSet == -1)
+      iSet = 0;
+
+    slotInUseInSet.EnsureCount(iSet + 1);
+
+    if (it.Value().m_iSlot != -1)
+    {
+      slotInUseInSet[iSet].SetCount(ezMath::Max(slotInUseInSet[iSet].GetCount(), static_cast<ezUInt32>(it.Value().m_iSlot + 1)));
+      slotInUseInSet[iSet].SetBit(it.Value().m_iSlot);
+    }
+  }
+
+  // Assign the remaining slots in order of declaration, so that the result is stable.
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    for (const auto& res : data.m_Resources[stage])
+    {
+      ezShaderResourceBinding& binding = inout_resourceBinding[res.m_Binding.m_sName];
+      if (binding.m_iSlot != -1)
+        continue;
+
+      ezHybridBitfield<64>& slotInUse = slotInUseInSet[binding.m_iSet];
+
+      ezUInt32 uiSlot = 0;
+      while (uiSlot < slotInUse.GetCount() && slotInUse.IsBitSet(uiSlot))
+      {
+        uiSlot++;
+      }
+
+      binding.m_iSlot = static_cast<ezInt16>(uiSlot);
+      slotInUse.SetCount(ezMath::Max(slotInUse.GetCount(), uiSlot + 1));
+      slotInUse.SetBit(uiSlot);
+    }
+  }
+}
+
+void ezShaderCompilerNull::ReflectConstantBufferLayouts(const ezShaderProgramData& data, ezHashTable<ezHashedString, ezShaderResourceBinding>& inout_resourceBinding, ezLogInterface* pLog)
+{
+  ezTokenizer tokenizer;
+  Tokens tokens;
+
+  for (ezUInt32 stage = ezGALShaderStage::VertexShader; stage < ezGALShaderStage::ENUM_COUNT; ++stage)
+  {
+    const ezBitflags<ezGALShaderStageFlags> stageFlag = ezGALShaderStageFlags::MakeFromShaderStage((ezGALShaderStage::Enum)stage);
+    bool bTokenized = false;
+
+    for (auto it : inout_resourceBinding)
+    {
+      ezShaderResourceBinding& binding = it.Value();
+      if (binding.m_ResourceType != ezGALShaderResourceType::ConstantBuffer && binding.m_ResourceType != ezGALShaderResourceType::PushConstants)
+        continue;
+
+      if (binding.m_pLayout != nullptr || !binding.m_Stages.IsAnySet(stageFlag))
+        continue;
+
+      if (!bTokenized)
+      {
+        TokenizeSource(data.m_sShaderSource[stage], tokenizer, tokens);
+        bTokenized = true;
+      }
+
+      EZ_LOG_BLOCK("Constant Buffer Layout", binding.m_sName.GetData());
+
+      const ezUInt32 uiBody = FindBlock(tokens, "cbuffer", binding.m_sName);
+      if (uiBody == ezInvalidIndex)
+      {
+        ezLog::Error(pLog, "The declaration of constant buffer '{}' was not found", binding.m_sName);
+        continue;
+      }
+
+      ezShaderConstantBufferLayout* pLayout = EZ_DEFAULT_NEW(ezShaderConstantBufferLayout);
+      binding.m_pLayout = pLayout;
+
+      ezUInt32 uiSize = 0;
+      if (ParseMembers(tokens, uiBody, pLayout, uiSize, pLog).Failed())
+      {
+        binding.m_pLayout = nullptr;
+        continue;
+      }
+
+      pLayout->m_uiTotalSize = ezMemoryUtils::AlignSize(uiSize, 16u);
+    }
+  }
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <RendererCore/ShaderCompiler/ShaderCompiler.h>
+#include <ShaderCompilerNull/ShaderCompilerNullDLL.h>
+
+/// \brief Shader compiler for the null renderer (ezGALDeviceNull).
+///
+/// Does not compile anything. It only parses the resource declarations in the preprocessed shader source, assigns a set and slot to each
+/// of them and writes that binding information together with a small placeholder byte code into the shader binaries.
+/// The layouts of constant buffers are derived from their declarations using the HLSL packing rules, so that materials and other
+/// systems can fill them. This is all the null device needs to bind shader resources through the regular code paths.
+class EZ_SHADERCOMPILERNULL_DLL ezShaderCompilerNull : public ezShaderProgramCompiler
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezShaderCompilerNull, ezShaderProgramCompiler);
+
+public:
+  virtual void GetSupportedPlatforms(ezHybridArray<ezString, 4>& out_platforms) override { out_platforms.PushBack("NULL_GAL"); }
+
+  virtual ezResult ModifyShaderSource(ezShaderProgramData& inout_data, ezLogInterface* pLog) override;
+  virtual ezResult Compile(ezShaderProgramData& inout_data, ezLogInterface* pLog) override;
+
+private:
+  /// \brief Parses the resources of all stages and merges them into one binding per name, each with a valid set and slot.
+  ezResult CollectShaderResourceBindings(ezShaderProgramData& inout_data, ezHashTable<ezHashedString, ezShaderResourceBinding>& out_bindings, ezLogInterface* pLog);
+
+  /// \brief Puts every resource into set 0 (unless it defines a set) and assigns the first free slot to all resources that don't define one.
+  void DefineShaderResourceBindings(const ezShaderProgramData& data, ezHashTable<ezHashedString, ezShaderResourceBinding>& inout_resourceBinding);
+
+  /// \brief Creates the layout of every constant buffer and push constant block from its declaration in the first stage that uses it.
+  void ReflectConstantBufferLayouts(const ezShaderProgramData& data, ezHashTable<ezHashedString, ezShaderResourceBinding>& inout_resourceBinding, ezLogInterface* pLog);
+};
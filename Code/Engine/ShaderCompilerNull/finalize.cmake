@@ -0,0 +1,4 @@
+# Make sure this project is built when the Editor is built
+ez_add_as_runtime_dependency(ShaderCompilerNull)
+
+ez_add_dependency("ShaderCompiler" "ShaderCompilerNull")
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <Foundation/Math/Rect.h>
 #include <Foundation/Math/Size.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Texture/Image/Image.h>
 #include <Texture/Image/ImageEnums.h>
 #include <Texture/Image/ImageFilter.h>
@@ -122,6 +123,30 @@ public:
 
   static ezResult CreateVolumeTextureFromSingleFile(ezImage& ref_dstImg, const ezImageView& srcImg);
 
+  /// \brief The number of pixels that ParallelForPixels() hands to the callback at once. All ranges start at a multiple of this value.
+  static constexpr ezUInt64 PixelsPerParallelChunk = 4096;
+
+  /// \brief Enables or disables distributing the work of the image processing functions across the task system.
+  ///
+  /// Scaling, mipmap generation, the per-pixel operations and ezImageConversion split large images into independent lines or pixel ranges,
+  /// so the result is bit-identical to the single-threaded code path. Multi-threading is enabled by default,
+  /// disabling it is mainly useful for comparisons and benchmarks.
+  static void SetMultiThreadingEnabled(bool bEnable);
+  static bool IsMultiThreadingEnabled();
+
+  /// \brief Calls \a func with sub-ranges of [0; uiNumLines), in parallel if the image is large enough to be worth it.
+  ///
+  /// \a uiPixelsPerLine is used to decide how many lines a single task should process at least.
+  /// The callback must not depend on the way the lines are distributed, i.e. every line must be processed independently.
+  /// Inside tasks that are flagged with ezTaskNesting::Never the lines are processed serially, since such tasks must not wait for other tasks.
+  static void ParallelForLines(ezUInt32 uiNumLines, ezUInt64 uiPixelsPerLine, ezParallelForIndexedFunction32 func, const char* szTaskName = nullptr);
+
+  /// \brief Calls \a func with sub-ranges of [0; uiNumPixels), in parallel if there are enough pixels to be worth it.
+  ///
+  /// Every range starts at a multiple of PixelsPerParallelChunk, so code that processes batches of pixels (e.g. with SIMD)
+  /// sees the same batches as when processing everything at once.
+  static void ParallelForPixels(ezUInt64 uiNumPixels, ezParallelForIndexedFunction64 func, const char* szTaskName = nullptr);
+
   static ezUInt32 GetSampleIndex(ezUInt32 uiNumTexels, ezInt32 iIndex, ezImageAddressMode::Enum addressMode, bool& out_bUseBorderColor);
 
   /// \brief Samples the image at the given UV coordinates with nearest filtering.
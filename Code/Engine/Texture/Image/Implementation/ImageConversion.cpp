@@ -4,6 +4,7 @@
 #include <Foundation/Math/Math.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Texture/Image/ImageConversion.h>
+#include <Texture/Image/ImageUtils.h>
 
 EZ_ENUMERABLE_CLASS_IMPLEMENTATION(ezImageConversionStep);
 
@@ -517,6 +518,38 @@ ezResult ezImageConversion::ConvertRaw(
   return EZ_SUCCESS;
 }
 
+static ezResult ConvertPixelsParallel(const ezImageConversionStepLinear* pStep, ezConstByteBlobPtr source, ezByteBlobPtr target, ezUInt64 uiNumElements, ezImageFormat::Enum sourceFormat, ezImageFormat::Enum targetFormat)
+{
+  const ezUInt64 uiSourceStride = ezImageFormat::GetBitsPerPixel(sourceFormat) / 8;
+  const ezUInt64 uiTargetStride = ezImageFormat::GetBitsPerPixel(targetFormat) / 8;
+
+  const bool bOverlapping = source.GetPtr() < target.GetEndPtr() && target.GetPtr() < source.GetEndPtr();
+  const bool bSameLayout = source.GetPtr() == target.GetPtr() && uiSourceStride == uiTargetStride;
+
+  if (bOverlapping && !bSameLayout)
+  {
+    // in-place conversions that change the pixel size rely on being processed front to back
+    return pStep->ConvertPixels(source, target, uiNumElements, sourceFormat, targetFormat);
+  }
+
+  // the linear conversions treat every pixel individually and the chunks start at multiples of a large power of two,
+  // so SIMD batches and memory alignment are the same as when converting everything at once
+  ezAtomicBool bFailed;
+  ezImageUtils::ParallelForPixels(uiNumElements, [&](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      const ezUInt64 uiCount = uiEnd - uiStart;
+      ezConstByteBlobPtr chunkSource(source.GetPtr() + uiStart * uiSourceStride, uiCount * uiSourceStride);
+      ezByteBlobPtr chunkTarget(target.GetPtr() + uiStart * uiTargetStride, uiCount * uiTargetStride);
+
+      if (pStep->ConvertPixels(chunkSource, chunkTarget, uiCount, sourceFormat, targetFormat).Failed())
+      {
+        bFailed = true;
+      } },
+    "ezImageConversion::ConvertPixels");
+
+  return bFailed ? EZ_FAILURE : EZ_SUCCESS;
+}
+
 ezResult ezImageConversion::ConvertSingleStep(
   const ezImageConversionStep* pStep, const ezImageView& source, ezImage& target, ezImageFormat::Enum targetFormat)
 {
@@ -538,8 +571,7 @@ ezResult ezImageConversion::ConvertSingleStep(
     {
       // we have to do the computation in 64-bit otherwise it might overflow for very large textures (8k x 4k or bigger).
       ezUInt64 numElements = ezUInt64(8) * target.GetByteBlobPtr().GetCount() / (ezUInt64)ezImageFormat::GetBitsPerPixel(targetFormat);
-      return static_cast<const ezImageConversionStepLinear*>(pStep)->ConvertPixels(
-        source.GetByteBlobPtr(), target.GetByteBlobPtr(), (ezUInt32)numElements, sourceFormat, targetFormat);
+      return ConvertPixelsParallel(static_cast<const ezImageConversionStepLinear*>(pStep), source.GetByteBlobPtr(), target.GetByteBlobPtr(), numElements, sourceFormat, targetFormat);
     }
 
     case MakeTypeKey(ezImageFormatType::LINEAR, ezImageFormatType::BLOCK_COMPRESSED):
@@ -5,6 +5,7 @@
 #include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/SimdMath/SimdVec4f.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Timestamp.h>
 #include <Texture/Image/ImageConversion.h>
 #include <Texture/Image/ImageEnums.h>
@@ -680,6 +681,47 @@ ezUInt32 ezImageUtils::GetSampleIndex(ezUInt32 uiNumTexels, ezInt32 iIndex, ezIm
   return iIndex;
 }
 
+// Below this amount of pixels per task, the overhead of the task system outweighs the gains.
+static constexpr ezUInt64 s_uiMinPixelsPerImageTask = 16 * 1024;
+static bool s_bImageMultiThreadingEnabled = true;
+
+void ezImageUtils::SetMultiThreadingEnabled(bool bEnable)
+{
+  s_bImageMultiThreadingEnabled = bEnable;
+}
+
+bool ezImageUtils::IsMultiThreadingEnabled()
+{
+  return s_bImageMultiThreadingEnabled;
+}
+
+void ezImageUtils::ParallelForLines(ezUInt32 uiNumLines, ezUInt64 uiPixelsPerLine, ezParallelForIndexedFunction32 func, const char* szTaskName)
+{
+  if (uiNumLines == 0)
+    return;
+
+  // tasks that are flagged with ezTaskNesting::Never, e.g. the screenshot task, must not wait for the parallel tasks
+  if (!s_bImageMultiThreadingEnabled || !ezTaskSystem::IsCurrentThreadAllowedToWait())
+  {
+    func(0, uiNumLines);
+    return;
+  }
+
+  ezParallelForParams params;
+  params.m_uiBinSize = static_cast<ezUInt32>(ezMath::Clamp<ezUInt64>(s_uiMinPixelsPerImageTask / ezMath::Max<ezUInt64>(uiPixelsPerLine, 1), 1, uiNumLines));
+
+  ezTaskSystem::ParallelForIndexed(0u, uiNumLines, std::move(func), szTaskName, ezTaskNesting::Never, params);
+}
+
+void ezImageUtils::ParallelForPixels(ezUInt64 uiNumPixels, ezParallelForIndexedFunction64 func, const char* szTaskName)
+{
+  const ezUInt64 uiNumChunks = (uiNumPixels + PixelsPerParallelChunk - 1) / PixelsPerParallelChunk;
+  EZ_ASSERT_DEV(uiNumChunks <= ezMath::MaxValue<ezUInt32>(), "Too many pixels.");
+
+  ParallelForLines(static_cast<ezUInt32>(uiNumChunks), PixelsPerParallelChunk, [&](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk)
+    { func(uiStartChunk * PixelsPerParallelChunk, ezMath::Min(uiEndChunk * PixelsPerParallelChunk, uiNumPixels)); }, szTaskName);
+}
+
 static ezSimdVec4f LoadSample(const ezSimdVec4f* pSource, ezUInt32 uiNumSourceElements, ezUInt32 uiStride, ezInt32 iIndex, ezImageAddressMode::Enum addressMode, const ezSimdVec4f& vBorderColor)
 {
   bool useBorderColor = false;
@@ -789,16 +831,17 @@ static void DownScaleFast(const ezImageView& image, ezImage& out_result, ezUInt3
   ezImage intermediate;
   intermediate.ResetAndAlloc(intermediateHeader);
 
-  for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; arrayIndex++)
-  {
-    for (ezUInt32 face = 0; face < numFaces; face++)
+  ezImageUtils::ParallelForLines(numArrayElements * numFaces * originalHeight, originalWidth, [&](ezUInt32 uiStartLine, ezUInt32 uiEndLine)
     {
-      for (ezUInt32 row = 0; row < originalHeight; row++)
+      for (ezUInt32 line = uiStartLine; line < uiEndLine; ++line)
       {
+        const ezUInt32 row = line % originalHeight;
+        const ezUInt32 face = (line / originalHeight) % numFaces;
+        const ezUInt32 arrayIndex = line / (originalHeight * numFaces);
+
         DownScaleFastLine(pixelStride, image.GetPixelPointer<ezUInt8>(0, face, arrayIndex, 0, row), intermediate.GetPixelPointer<ezUInt8>(0, face, arrayIndex, 0, row), originalWidth, pixelStride, uiWidth, pixelStride);
-      }
-    }
-  }
+      } },
+    "DownScaleFast Rows");
 
   // input and output images may be the same, so we can't access the original image below this point
 
@@ -814,16 +857,17 @@ static void DownScaleFast(const ezImageView& image, ezImage& out_result, ezUInt3
   EZ_ASSERT_DEBUG(intermediate.GetRowPitch() < ezMath::MaxValue<ezUInt32>(), "Row pitch exceeds ezUInt32 max value.");
   EZ_ASSERT_DEBUG(out_result.GetRowPitch() < ezMath::MaxValue<ezUInt32>(), "Row pitch exceeds ezUInt32 max value.");
 
-  for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; arrayIndex++)
-  {
-    for (ezUInt32 face = 0; face < numFaces; face++)
+  ezImageUtils::ParallelForLines(numArrayElements * numFaces * uiWidth, originalHeight, [&](ezUInt32 uiStartLine, ezUInt32 uiEndLine)
     {
-      for (ezUInt32 col = 0; col < uiWidth; col++)
+      for (ezUInt32 line = uiStartLine; line < uiEndLine; ++line)
       {
+        const ezUInt32 col = line % uiWidth;
+        const ezUInt32 face = (line / uiWidth) % numFaces;
+        const ezUInt32 arrayIndex = line / (uiWidth * numFaces);
+
         DownScaleFastLine(pixelStride, intermediate.GetPixelPointer<ezUInt8>(0, face, arrayIndex, col), out_result.GetPixelPointer<ezUInt8>(0, face, arrayIndex, col), originalHeight, static_cast<ezUInt32>(intermediate.GetRowPitch()), uiHeight, static_cast<ezUInt32>(out_result.GetRowPitch()));
-      }
-    }
-  }
+      } },
+    "DownScaleFast Columns");
 }
 
 static float EvaluateAverageCoverage(ezBlobPtr<const ezColor> colors, float fAlphaThreshold)
@@ -831,11 +875,17 @@ static float EvaluateAverageCoverage(ezBlobPtr<const ezColor> colors, float fAlp
   EZ_PROFILE_SCOPE("EvaluateAverageCoverage");
 
   ezUInt64 totalPixels = colors.GetCount();
-  ezUInt64 count = 0;
-  for (ezUInt64 idx = 0; idx < totalPixels; ++idx)
-  {
-    count += colors[idx].a >= fAlphaThreshold;
-  }
+  ezAtomicInteger64 count = 0;
+
+  ezImageUtils::ParallelForPixels(totalPixels, [&](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      ezInt64 localCount = 0;
+      for (ezUInt64 idx = uiStart; idx < uiEnd; ++idx)
+      {
+        localCount += colors[idx].a >= fAlphaThreshold;
+      }
+      count.Add(localCount); },
+    "EvaluateAverageCoverage");
 
   return float(count) / float(totalPixels);
 }
@@ -865,10 +915,22 @@ static void NormalizeCoverage(ezImage& inout_currentMip, const ezImageHeader& fu
   constexpr ezUInt32 histogramBits = 8;
   constexpr ezUInt32 histogramSize = 1 << histogramBits;
   ezUInt32 alphaHistogram[histogramSize] = {};
-  for (ezUInt64 idx = 0; idx < totalPixels; ++idx)
-  {
-    alphaHistogram[ezMath::ColorFloatToUnsignedInt<histogramBits>(upscaledColors[idx].a)]++;
-  }
+  ezMutex histogramMutex;
+
+  ezImageUtils::ParallelForPixels(totalPixels, [&](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      ezUInt32 localHistogram[histogramSize] = {};
+      for (ezUInt64 idx = uiStart; idx < uiEnd; ++idx)
+      {
+        localHistogram[ezMath::ColorFloatToUnsignedInt<histogramBits>(upscaledColors[idx].a)]++;
+      }
+
+      EZ_LOCK(histogramMutex);
+      for (ezUInt32 i = 0; i < histogramSize; ++i)
+      {
+        alphaHistogram[i] += localHistogram[i];
+      } },
+    "NormalizeCoverage Histogram");
 
   // Find a new alpha threshold so the number of covered pixels matches by summing up the histogram
   ezInt32 targetCount = ezInt32(fTargetCoverage * totalPixels);
@@ -889,10 +951,13 @@ static void NormalizeCoverage(ezImage& inout_currentMip, const ezImageHeader& fu
 
   const float fNewThreshold = float(newThreshold) / float(histogramSize - 1);
   const float alphaScale = mipOptions.m_alphaThreshold / fNewThreshold;
-  for (ezUInt64 idx = 0; idx < colors.GetCount(); ++idx)
-  {
-    colors[idx].a *= alphaScale;
-  }
+  ezImageUtils::ParallelForPixels(colors.GetCount(), [&](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      for (ezUInt64 idx = uiStart; idx < uiEnd; ++idx)
+      {
+        colors[idx].a *= alphaScale;
+      } },
+    "NormalizeCoverage Rescale");
 }
 
 
@@ -991,6 +1056,8 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepSource = &conversionScratch;
   };
 
+  const ezSimdVec4f vBorderColor(borderColor.r, borderColor.g, borderColor.b, borderColor.a);
+
   ezHybridArray<ezInt32, 256> firstSampleIndices;
   firstSampleIndices.Reserve(ezMath::Max(uiWidth, uiHeight, uiDepth));
 
@@ -1017,21 +1084,21 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetWidth(uiWidth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    // every row is filtered independently
+    ezImageUtils::ParallelForLines(numArrayElements * numFaces * originalDepth * originalHeight, originalWidth, [&](ezUInt32 uiStartLine, ezUInt32 uiEndLine)
       {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
+        for (ezUInt32 line = uiStartLine; line < uiEndLine; ++line)
         {
-          for (ezUInt32 y = 0; y < originalHeight; ++y)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
-            FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+          const ezUInt32 y = line % originalHeight;
+          const ezUInt32 z = (line / originalHeight) % originalDepth;
+          const ezUInt32 face = (line / (originalHeight * originalDepth)) % numFaces;
+          const ezUInt32 arrayIndex = line / (originalHeight * originalDepth * numFaces);
+
+          const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+          ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, 0, y, z);
+          FilterLine(originalWidth, filterSource, filterTarget, 1, weights, firstSampleIndices, addressModeU, vBorderColor);
+        } },
+      "Scale3D Rows");
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1060,21 +1127,21 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetHeight(uiHeight);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    // every column is filtered independently, neighboring columns end up in the same task, which keeps the strided accesses cache friendly
+    ezImageUtils::ParallelForLines(numArrayElements * numFaces * originalDepth * uiWidth, originalHeight, [&](ezUInt32 uiStartLine, ezUInt32 uiEndLine)
       {
-        for (ezUInt32 z = 0; z < originalDepth; ++z)
+        for (ezUInt32 line = uiStartLine; line < uiEndLine; ++line)
         {
-          for (ezUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth, weights, firstSampleIndices, addressModeV, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+          const ezUInt32 x = line % uiWidth;
+          const ezUInt32 z = (line / uiWidth) % originalDepth;
+          const ezUInt32 face = (line / (uiWidth * originalDepth)) % numFaces;
+          const ezUInt32 arrayIndex = line / (uiWidth * originalDepth * numFaces);
+
+          const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
+          ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, 0, z);
+          FilterLine(originalHeight, filterSource, filterTarget, uiWidth, weights, firstSampleIndices, addressModeV, vBorderColor);
+        } },
+      "Scale3D Columns");
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1103,21 +1170,20 @@ ezResult ezImageUtils::Scale3D(const ezImageView& source, ezImage& ref_target, e
     stepHeader.SetDepth(uiDepth);
     stepTarget->ResetAndAlloc(stepHeader);
 
-    for (ezUInt32 arrayIndex = 0; arrayIndex < numArrayElements; ++arrayIndex)
-    {
-      for (ezUInt32 face = 0; face < numFaces; ++face)
+    ezImageUtils::ParallelForLines(numArrayElements * numFaces * uiHeight * uiWidth, originalDepth, [&](ezUInt32 uiStartLine, ezUInt32 uiEndLine)
       {
-        for (ezUInt32 y = 0; y < uiHeight; ++y)
+        for (ezUInt32 line = uiStartLine; line < uiEndLine; ++line)
         {
-          for (ezUInt32 x = 0; x < uiWidth; ++x)
-          {
-            const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
-            FilterLine(originalHeight, filterSource, filterTarget, uiWidth * uiHeight, weights, firstSampleIndices, addressModeW, ezSimdVec4f(borderColor.r, borderColor.g, borderColor.b, borderColor.a));
-          }
-        }
-      }
-    }
+          const ezUInt32 x = line % uiWidth;
+          const ezUInt32 y = (line / uiWidth) % uiHeight;
+          const ezUInt32 face = (line / (uiWidth * uiHeight)) % numFaces;
+          const ezUInt32 arrayIndex = line / (uiWidth * uiHeight * numFaces);
+
+          const ezSimdVec4f* filterSource = stepSource->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
+          ezSimdVec4f* filterTarget = stepTarget->GetPixelPointer<ezSimdVec4f>(0, face, arrayIndex, x, y, 0);
+          FilterLine(originalHeight, filterSource, filterTarget, uiWidth * uiHeight, weights, firstSampleIndices, addressModeW, vBorderColor);
+        } },
+      "Scale3D Slices");
 
     releaseScratch(*stepSource);
     stepSource = stepTarget;
@@ -1217,29 +1283,34 @@ void ezImageUtils::ReconstructNormalZ(ezImage& ref_image)
 
   EZ_ASSERT_DEV(ref_image.GetImageFormat() == ezImageFormat::R32G32B32A32_FLOAT, "This algorithm currently expects a RGBA 32 Float as input");
 
-  ezSimdVec4f* cur = ref_image.GetBlobPtr<ezSimdVec4f>().GetPtr();
-  ezSimdVec4f* const end = ref_image.GetBlobPtr<ezSimdVec4f>().GetEndPtr();
+  ezBlobPtr<ezSimdVec4f> pixels = ref_image.GetBlobPtr<ezSimdVec4f>();
 
-  ezSimdFloat oneScalar = 1.0f;
+  ParallelForPixels(pixels.GetCount(), [pixels](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      ezSimdVec4f* cur = pixels.GetPtr() + uiStart;
+      ezSimdVec4f* const end = pixels.GetPtr() + uiEnd;
 
-  ezSimdVec4f two(2.0f);
+      ezSimdFloat oneScalar = 1.0f;
 
-  ezSimdVec4f minusOne(-1.0f);
+      ezSimdVec4f two(2.0f);
 
-  ezSimdVec4f half(0.5f);
+      ezSimdVec4f minusOne(-1.0f);
 
-  for (; cur < end; cur++)
-  {
-    ezSimdVec4f normal;
-    // unpack from [0,1] to [-1, 1]
-    normal = ezSimdVec4f::MulAdd(*cur, two, minusOne);
+      ezSimdVec4f half(0.5f);
 
-    // compute Z component
-    normal.SetZ((oneScalar - normal.Dot<2>(normal)).GetSqrt());
+      for (; cur < end; cur++)
+      {
+        ezSimdVec4f normal;
+        // unpack from [0,1] to [-1, 1]
+        normal = ezSimdVec4f::MulAdd(*cur, two, minusOne);
 
-    // pack back to [0,1]
-    *cur = ezSimdVec4f::MulAdd(half, normal, half);
-  }
+        // compute Z component
+        normal.SetZ((oneScalar - normal.Dot<2>(normal)).GetSqrt());
+
+        // pack back to [0,1]
+        *cur = ezSimdVec4f::MulAdd(half, normal, half);
+      } },
+    "ReconstructNormalZ");
 }
 
 void ezImageUtils::RenormalizeNormalMap(ezImage& ref_image)
@@ -1248,22 +1319,27 @@ void ezImageUtils::RenormalizeNormalMap(ezImage& ref_image)
 
   EZ_ASSERT_DEV(ref_image.GetImageFormat() == ezImageFormat::R32G32B32A32_FLOAT, "This algorithm currently expects a RGBA 32 Float as input");
 
-  ezSimdVec4f* start = ref_image.GetBlobPtr<ezSimdVec4f>().GetPtr();
-  ezSimdVec4f* const end = ref_image.GetBlobPtr<ezSimdVec4f>().GetEndPtr();
+  ezBlobPtr<ezSimdVec4f> pixels = ref_image.GetBlobPtr<ezSimdVec4f>();
 
-  ezSimdVec4f two(2.0f);
+  ParallelForPixels(pixels.GetCount(), [pixels](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      ezSimdVec4f* start = pixels.GetPtr() + uiStart;
+      ezSimdVec4f* const end = pixels.GetPtr() + uiEnd;
 
-  ezSimdVec4f minusOne(-1.0f);
+      ezSimdVec4f two(2.0f);
 
-  ezSimdVec4f half(0.5f);
+      ezSimdVec4f minusOne(-1.0f);
 
-  for (; start < end; start++)
-  {
-    ezSimdVec4f normal;
-    normal = ezSimdVec4f::MulAdd(*start, two, minusOne);
-    normal.Normalize<3>();
-    *start = ezSimdVec4f::MulAdd(half, normal, half);
-  }
+      ezSimdVec4f half(0.5f);
+
+      for (; start < end; start++)
+      {
+        ezSimdVec4f normal;
+        normal = ezSimdVec4f::MulAdd(*start, two, minusOne);
+        normal.Normalize<3>();
+        *start = ezSimdVec4f::MulAdd(half, normal, half);
+      } },
+    "RenormalizeNormalMap");
 }
 
 void ezImageUtils::AdjustRoughness(ezImage& ref_roughnessMap, const ezImageView& normalMap)
@@ -1302,23 +1378,26 @@ void ezImageUtils::AdjustRoughness(ezImage& ref_roughnessMap, const ezImageView&
     ezBlobPtr<ezSimdVec4f> roughnessData = ref_roughnessMap.GetSubImageView(mipLevel, 0, 0).GetBlobPtr<ezSimdVec4f>();
     ezBlobPtr<ezSimdVec4f> normalData = filteredNormalMap.GetSubImageView(mipLevel, 0, 0).GetBlobPtr<ezSimdVec4f>();
 
-    for (ezUInt64 i = 0; i < roughnessData.GetCount(); ++i)
-    {
-      ezSimdVec4f normal = ezSimdVec4f::MulAdd(normalData[i], two, minusOne);
-
-      float avgNormalLength = normal.GetLength<3>();
-      if (avgNormalLength < 1.0f)
+    ParallelForPixels(roughnessData.GetCount(), [&](ezUInt64 uiStart, ezUInt64 uiEnd)
       {
-        float avgNormalLengthSquare = avgNormalLength * avgNormalLength;
-        float kappa = (3.0f * avgNormalLength - avgNormalLength * avgNormalLengthSquare) / (1.0f - avgNormalLengthSquare);
-        float variance = 1.0f / (2.0f * kappa);
+        for (ezUInt64 i = uiStart; i < uiEnd; ++i)
+        {
+          ezSimdVec4f normal = ezSimdVec4f::MulAdd(normalData[i], two, minusOne);
+
+          float avgNormalLength = normal.GetLength<3>();
+          if (avgNormalLength < 1.0f)
+          {
+            float avgNormalLengthSquare = avgNormalLength * avgNormalLength;
+            float kappa = (3.0f * avgNormalLength - avgNormalLength * avgNormalLengthSquare) / (1.0f - avgNormalLengthSquare);
+            float variance = 1.0f / (2.0f * kappa);
 
-        float oldRoughness = roughnessData[i].GetComponent<0>();
-        float newRoughness = ezMath::Sqrt(oldRoughness * oldRoughness + variance);
+            float oldRoughness = roughnessData[i].GetComponent<0>();
+            float newRoughness = ezMath::Sqrt(oldRoughness * oldRoughness + variance);
 
-        roughnessData[i].Set(newRoughness);
-      }
-    }
+            roughnessData[i].Set(newRoughness);
+          }
+        } },
+      "AdjustRoughness");
   }
 }
 
@@ -1333,10 +1412,15 @@ void ezImageUtils::ChangeExposure(ezImage& ref_image, float fBias)
 
   const float multiplier = ezMath::Pow2(fBias);
 
-  for (ezColor& col : ref_image.GetBlobPtr<ezColor>())
-  {
-    col = multiplier * col;
-  }
+  ezBlobPtr<ezColor> pixels = ref_image.GetBlobPtr<ezColor>();
+
+  ParallelForPixels(pixels.GetCount(), [&](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      for (ezUInt64 i = uiStart; i < uiEnd; ++i)
+      {
+        pixels[i] = multiplier * pixels[i];
+      } },
+    "ChangeExposure");
 }
 
 static ezResult CopyImageRectToFace(ezImage& ref_dstImg, const ezImageView& srcImg, ezUInt32 uiOffsetX, ezUInt32 uiOffsetY, ezUInt32 uiFaceIndex)
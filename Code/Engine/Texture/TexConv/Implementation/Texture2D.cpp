@@ -1,6 +1,7 @@
 #include <Texture/TexturePCH.h>
 
 #include <Foundation/Profiling/Profiling.h>
+#include <Texture/Image/ImageUtils.h>
 #include <Texture/TexConv/TexConvProcessor.h>
 
 ezResult ezTexConvProcessor::Assemble2DTexture(const ezImageHeader& refImg, ezImage& dst) const
@@ -94,21 +95,30 @@ ezResult ezTexConvProcessor::Assemble2DSlice(const ezTexConvSliceChannelMapping&
   {
     EZ_PROFILE_SCOPE("Assemble2DSlice(gather)");
 
-    for (ezUInt32 y = 0; y < uiResolutionY; ++y)
-    {
-      const ezUInt32 pixelWriteRowOffset = uiResolutionX * (bFlip ? (uiResolutionY - y - 1) : y);
-
-      for (ezUInt32 x = 0; x < uiResolutionX; ++x)
+    ezImageUtils::ParallelForLines(uiResolutionY, uiResolutionX, [&](ezUInt32 uiStartRow, ezUInt32 uiEndRow)
       {
-        float* dst = &pPixelOut[pixelWriteRowOffset + x].r;
-
+        const float* pRowSourceValues[4];
         for (ezUInt32 c = 0; c < 4; ++c)
         {
-          dst[c] = *pSourceValues[c];
-          pSourceValues[c] += uiSourceStrides[c];
+          pRowSourceValues[c] = pSourceValues[c] + static_cast<ezUInt64>(uiStartRow) * uiResolutionX * uiSourceStrides[c];
         }
-      }
-    }
+
+        for (ezUInt32 y = uiStartRow; y < uiEndRow; ++y)
+        {
+          const ezUInt32 pixelWriteRowOffset = uiResolutionX * (bFlip ? (uiResolutionY - y - 1) : y);
+
+          for (ezUInt32 x = 0; x < uiResolutionX; ++x)
+          {
+            float* dst = &pPixelOut[pixelWriteRowOffset + x].r;
+
+            for (ezUInt32 c = 0; c < 4; ++c)
+            {
+              dst[c] = *pRowSourceValues[c];
+              pRowSourceValues[c] += uiSourceStrides[c];
+            }
+          }
+        } },
+      "Assemble2DSlice");
   }
 
   return EZ_SUCCESS;
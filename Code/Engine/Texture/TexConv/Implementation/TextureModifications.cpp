@@ -104,12 +104,18 @@ ezResult ezTexConvProcessor::PremultiplyAlpha(ezImage& image) const
   if (!m_Descriptor.m_bPremultiplyAlpha)
     return EZ_SUCCESS;
 
-  for (ezColor& col : image.GetBlobPtr<ezColor>())
-  {
-    col.r *= col.a;
-    col.g *= col.a;
-    col.b *= col.a;
-  }
+  ezBlobPtr<ezColor> pixels = image.GetBlobPtr<ezColor>();
+
+  ezImageUtils::ParallelForPixels(pixels.GetCount(), [&](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      for (ezUInt64 i = uiStart; i < uiEnd; ++i)
+      {
+        ezColor& col = pixels[i];
+        col.r *= col.a;
+        col.g *= col.a;
+        col.b *= col.a;
+      } },
+    "PremultiplyAlpha");
 
   return EZ_SUCCESS;
 }
@@ -245,22 +251,26 @@ ezResult ezTexConvProcessor::ConvertToNormalMap(ezImage& bumpMap) const
       break;
   };
 
-  for (ezUInt32 y = 0; y < bumpMap.GetHeight(); ++y)
-  {
-    for (ezUInt32 x = 0; x < bumpMap.GetWidth(); ++x)
+  // the kernels only read from the bump map, so all rows can be computed independently
+  ezImageUtils::ParallelForLines(bumpMap.GetHeight(), bumpMap.GetWidth(), [&](ezUInt32 uiStartRow, ezUInt32 uiEndRow)
     {
-      Accum accum = filterKernel(x, y);
+      for (ezUInt32 y = uiStartRow; y < uiEndRow; ++y)
+      {
+        for (ezUInt32 x = 0; x < bumpMap.GetWidth(); ++x)
+        {
+          Accum accum = filterKernel(x, y);
 
-      ezVec3 normal = ezVec3(1.f, 0.f, accum.x).CrossRH(ezVec3(0.f, 1.f, accum.y));
-      normal.NormalizeIfNotZero(ezVec3(0, 0, 1), 0.001f).IgnoreResult();
-      normal.y = -normal.y;
+          ezVec3 normal = ezVec3(1.f, 0.f, accum.x).CrossRH(ezVec3(0.f, 1.f, accum.y));
+          normal.NormalizeIfNotZero(ezVec3(0, 0, 1), 0.001f).IgnoreResult();
+          normal.y = -normal.y;
 
-      normal = normal * 0.5f + ezVec3(0.5f);
+          normal = normal * 0.5f + ezVec3(0.5f);
 
-      ezColor& newPixel = getNewPixel(x, y);
-      newPixel.SetRGBA(normal.x, normal.y, normal.z, 0.f);
-    }
-  }
+          ezColor& newPixel = getNewPixel(x, y);
+          newPixel.SetRGBA(normal.x, normal.y, normal.z, 0.f);
+        }
+      } },
+    "ConvertToNormalMap");
 
   bumpMap.ResetAndMove(std::move(newImage));
 
@@ -283,17 +293,23 @@ ezResult ezTexConvProcessor::ClampInputValues(ezImage& image, float maxValue) co
   // RGBA32F which should result in tightly packed mipmaps.
   EZ_ASSERT_DEV(image.GetImageFormat() == ezImageFormat::R32G32B32A32_FLOAT && image.GetRowPitch() % sizeof(float[4]) == 0, "");
 
-  for (auto& value : image.GetBlobPtr<float>())
-  {
-    if (ezMath::IsNaN(value))
-    {
-      value = 0.f;
-    }
-    else
+  ezBlobPtr<float> values = image.GetBlobPtr<float>();
+
+  ezImageUtils::ParallelForPixels(values.GetCount(), [&](ezUInt64 uiStart, ezUInt64 uiEnd)
     {
-      value = ezMath::Clamp(value, -maxValue, maxValue);
-    }
-  }
+      for (ezUInt64 i = uiStart; i < uiEnd; ++i)
+      {
+        float& value = values[i];
+        if (ezMath::IsNaN(value))
+        {
+          value = 0.f;
+        }
+        else
+        {
+          value = ezMath::Clamp(value, -maxValue, maxValue);
+        }
+      } },
+    "ClampInputValues");
 
   return EZ_SUCCESS;
 }
@@ -389,16 +405,44 @@ static ezColor GetAvgColor(ezColor* pPixels, ezInt32 iWidth, ezInt32 iHeight, ez
   return avg;
 }
 
-static void DilateColors(ezColor* pPixels, ezInt32 iWidth, ezInt32 iHeight, float fMarkAlpha)
+static void DilateRow(ezColor* pPixels, ezInt32 iWidth, ezInt32 iHeight, ezInt32 y, float fMarkAlpha)
 {
-  for (ezInt32 y = 0; y < iHeight; ++y)
+  for (ezInt32 x = 0; x < iWidth; ++x)
   {
-    for (ezInt32 x = 0; x < iWidth; ++x)
+    const ezColor avg = GetAvgColor(pPixels, iWidth, iHeight, x, y, fMarkAlpha);
+
+    SetPixelValue(pPixels, iWidth, x, y, avg);
+  }
+}
+
+static void DilateColors(ezColor* pPixels, ezInt32 iWidth, ezInt32 iHeight, float fMarkAlpha)
+{
+  // A pass only writes to pixels with zero alpha and marks them with exactly fMarkAlpha.
+  // Neither of those values passes the 'col.a > fMarkAlpha' test in GetAvgColor, so a pixel's result does not depend on
+  // whether its neighbors were already processed in this pass. This allows to dilate rows in any order and still get
+  // the same result as the sequential loop.
+  // To prevent one task from reading a row that another task is writing, every band of rows first skips its first row,
+  // which is filled in afterwards, once no other rows are modified anymore.
+
+  constexpr ezUInt32 uiRowsPerBand = 32;
+  const ezUInt32 uiNumBands = (static_cast<ezUInt32>(iHeight) + uiRowsPerBand - 1) / uiRowsPerBand;
+
+  ezImageUtils::ParallelForLines(uiNumBands, ezUInt64(uiRowsPerBand) * iWidth, [&](ezUInt32 uiStartBand, ezUInt32 uiEndBand)
     {
-      const ezColor avg = GetAvgColor(pPixels, iWidth, iHeight, x, y, fMarkAlpha);
+      for (ezUInt32 band = uiStartBand; band < uiEndBand; ++band)
+      {
+        const ezInt32 iEndRow = ezMath::Min<ezInt32>((band + 1) * uiRowsPerBand, iHeight);
 
-      SetPixelValue(pPixels, iWidth, x, y, avg);
-    }
+        for (ezInt32 y = band * uiRowsPerBand + 1; y < iEndRow; ++y)
+        {
+          DilateRow(pPixels, iWidth, iHeight, y, fMarkAlpha);
+        }
+      } },
+    "DilateColors");
+
+  for (ezUInt32 band = 0; band < uiNumBands; ++band)
+  {
+    DilateRow(pPixels, iWidth, iHeight, band * uiRowsPerBand, fMarkAlpha);
   }
 }
 
@@ -438,10 +482,15 @@ ezResult ezTexConvProcessor::InvertNormalMap(ezImage& image)
   // RGBA32F which should result in tightly packed mipmaps.
   EZ_ASSERT_DEV(image.GetImageFormat() == ezImageFormat::R32G32B32A32_FLOAT && image.GetRowPitch() % sizeof(float[4]) == 0, "");
 
-  for (auto& value : image.GetBlobPtr<ezColor>())
-  {
-    value.g = 1.0f - value.g;
-  }
+  ezBlobPtr<ezColor> pixels = image.GetBlobPtr<ezColor>();
+
+  ezImageUtils::ParallelForPixels(pixels.GetCount(), [&](ezUInt64 uiStart, ezUInt64 uiEnd)
+    {
+      for (ezUInt64 i = uiStart; i < uiEnd; ++i)
+      {
+        pixels[i].g = 1.0f - pixels[i].g;
+      } },
+    "InvertNormalMap");
 
   return EZ_SUCCESS;
 }
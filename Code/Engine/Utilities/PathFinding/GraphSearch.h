@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Math.h>
 #include <Utilities/PathFinding/PathState.h>
 #include <Utilities/UtilitiesDLL.h>
@@ -56,16 +58,72 @@ public:
   /// \brief Needs to be called by the used ezPathStateGenerator to add nodes to evaluate.
   void AddPathNode(ezInt64 iNodeIndex, const PathStateType& NewState);
 
+  /// \brief Makes the path search look up the state of a node through an array instead of a hash table.
+  ///
+  /// This can be used when all node indices are in the range [0; uiNumNodes), for example the cell indices of a grid.
+  /// It makes large searches a lot faster, but costs 8 bytes of memory per node, even for nodes that are never visited.
+  /// Pass 0 to switch back to the hash table.
+  void SetDenseNodeRange(ezUInt32 uiNumNodes);
+
 private:
+  struct NodeState
+  {
+    PathStateType m_State;
+    ezInt64 m_iNodeIndex;
+
+    /// The position of this node in m_OpenList, ezInvalidIndex once it was expanded.
+    ezUInt32 m_uiOpenListIndex;
+  };
+
+  /// The open list is a binary min-heap on the estimated costs. The costs are duplicated here for cache-friendly heap operations.
+  struct OpenListEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fEstimatedCostToTarget;
+    ezUInt32 m_uiNodeState;
+  };
+
+  /// Node indices are often consecutive numbers (e.g. grid cells), which the default hash function maps to consecutive buckets.
+  /// Spread them out, to prevent long probing chains in the hash table.
+  struct NodeIndexHashHelper
+  {
+    EZ_ALWAYS_INLINE static ezUInt32 Hash(ezInt64 iNodeIndex) { return static_cast<ezUInt32>((static_cast<ezUInt64>(iNodeIndex) * 0x9E3779B97F4A7C15ull) >> 32); }
+    EZ_ALWAYS_INLINE static bool Equal(ezInt64 a, ezInt64 b) { return a == b; }
+  };
+
+  struct DenseNodeSlot
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiSearchCounter;
+    ezUInt32 m_uiNodeState;
+  };
+
   void ClearPathStates();
+  NodeState* FindNodeState(ezInt64 iNodeIndex);
+  NodeState& AddNodeState(ezInt64 iNodeIndex, const PathStateType& state, ezInt64 iReachedThroughNode);
   ezInt64 FindBestNodeToExpand(PathStateType*& out_pPathState);
   void FillOutPathResult(ezInt64 iEndNodeIndex, ezDeque<PathResultData>& out_Path);
 
+  void PushToOpenList(ezUInt32 uiNodeState);
+  void MoveUpInOpenList(ezUInt32 uiOpenListIndex);
+  void MoveDownInOpenList(ezUInt32 uiOpenListIndex);
+  void SetOpenListEntry(ezUInt32 uiOpenListIndex, const OpenListEntry& entry);
+
   ezPathStateGenerator<PathStateType>* m_pStateGenerator;
 
-  ezHashTable<ezInt64, PathStateType> m_PathStates;
+  /// All states that were reached during the current search. A deque, so that pointers to the states stay valid.
+  ezDeque<NodeState> m_NodeStates;
+
+  /// Maps node indices to m_NodeStates, if no dense node range is set.
+  ezHashTable<ezInt64, ezUInt32, NodeIndexHashHelper> m_NodeToState;
+
+  /// Maps node indices to m_NodeStates, if a dense node range is set. Slots from previous searches are detected through the search counter.
+  ezDynamicArray<DenseNodeSlot> m_DenseNodeToState;
+  ezUInt32 m_uiSearchCounter = 0;
 
-  ezDeque<ezInt64> m_StateQueue;
+  ezDynamicArray<OpenListEntry> m_OpenList;
 
   ezInt64 m_iCurNodeIndex;
   PathStateType m_CurState;
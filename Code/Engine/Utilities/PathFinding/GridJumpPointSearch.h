@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Foundation/Math/Vec2.h>
+#include <Utilities/PathFinding/GraphSearch.h>
+#include <Utilities/PathFinding/GridNavmesh.h>
+
+/// \brief A path state generator that implements jump point search (JPS) on a grid where all free cells have the same movement costs.
+///
+/// Instead of adding every neighbor cell to the path search, JPS skips along straight and diagonal lines until it reaches a cell
+/// next to an obstacle, where the path might have to turn. Only those 'jump points' are added to the path search,
+/// which makes searches through large, open grids a lot cheaper than expanding every cell.
+///
+/// The node indices are the cell indices of the grid, ie. y * Width + x, like ezGameGrid::ConvertCellCoordinateToIndex().
+/// Straight moves cost 1, diagonal moves cost sqrt(2). Diagonal moves are only allowed when both adjacent straight cells are free,
+/// so paths never cut corners.
+///
+/// The resulting path only contains the jump points. Consecutive jump points are always connected by a straight or diagonal line.
+/// With FindClosest() the callback is only evaluated for jump points, so it is mainly useful together with FindPath().
+/// Combine it with ezPathSearch::SetDenseNodeRange(Width * Height) for large grids.
+class EZ_UTILITIES_DLL ezGridJumpPointSearch : public ezPathStateGenerator<ezPathState>
+{
+public:
+  /// \brief Sets the size of the grid and the callback that decides which cells are blocked. Cells outside the grid are always blocked.
+  ///
+  /// The callback has the same signature as the one that is used to create an ezGridNavmesh.
+  void SetGrid(ezUInt32 uiWidth, ezUInt32 uiHeight, ezGridNavmesh::CellBlocked isCellBlocked, void* pPassThrough);
+
+  virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& StartState, ezPathSearch<ezPathState>* pPathSearch) override;
+  virtual void StartSearchForClosest(ezInt64 iStartNodeIndex, const ezPathState* pStartState) override;
+  virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override;
+
+private:
+  bool IsFree(ezInt32 x, ezInt32 y) const;
+  bool IsTarget(ezInt32 x, ezInt32 y) const { return m_bHasTarget && x == m_vTarget.x && y == m_vTarget.y; }
+
+  bool Jump(ezVec2I32 vFrom, ezVec2I32 vDir, ezVec2I32& out_vJumpPoint) const;
+  bool JumpStraight(ezInt32 x, ezInt32 y, ezInt32 dx, ezInt32 dy, ezVec2I32& out_vJumpPoint) const;
+
+  ezVec2I32 GetCoordinate(ezInt64 iNodeIndex) const;
+  static float GetOctileDistance(const ezVec2I32& a, const ezVec2I32& b);
+
+  ezUInt32 m_uiWidth = 0;
+  ezUInt32 m_uiHeight = 0;
+  ezGridNavmesh::CellBlocked m_IsCellBlocked = nullptr;
+  void* m_pPassThrough = nullptr;
+
+  bool m_bHasTarget = false;
+  ezVec2I32 m_vTarget = ezVec2I32::MakeZero();
+};
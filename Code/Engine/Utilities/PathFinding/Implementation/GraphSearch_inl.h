@@ -1,39 +1,156 @@
 #pragma once
 
 template <typename PathStateType>
-void ezPathSearch<PathStateType>::ClearPathStates()
+void ezPathSearch<PathStateType>::SetDenseNodeRange(ezUInt32 uiNumNodes)
 {
-  m_PathStates.Clear();
-  m_StateQueue.Clear();
+  m_DenseNodeToState.Clear();
+  m_DenseNodeToState.SetCount(uiNumNodes);
+  m_DenseNodeToState.Compact();
+  m_uiSearchCounter = 0;
 }
 
 template <typename PathStateType>
-ezInt64 ezPathSearch<PathStateType>::FindBestNodeToExpand(PathStateType*& out_pPathState)
+void ezPathSearch<PathStateType>::ClearPathStates()
 {
-  float fLowestEstimation = ezMath::Infinity<float>();
-  out_pPathState = nullptr;
-  ezUInt32 iBestInQueue = 0;
+  m_NodeStates.Clear();
+  m_NodeToState.Clear();
+  m_OpenList.Clear();
 
-  for (ezUInt32 i = 0; i < m_StateQueue.GetCount(); ++i)
+  if (!m_DenseNodeToState.IsEmpty())
   {
-    const ezInt64 iNodeIndex = m_StateQueue[i];
+    ++m_uiSearchCounter;
 
-    PathStateType* pState = &m_PathStates[iNodeIndex];
-
-    if (pState->m_fEstimatedCostToTarget < fLowestEstimation)
+    // after a wrap-around, slots from old searches could look valid again
+    if (m_uiSearchCounter == 0)
     {
-      fLowestEstimation = pState->m_fEstimatedCostToTarget;
-      out_pPathState = pState;
-      iBestInQueue = i;
+      ezMemoryUtils::ZeroFill(m_DenseNodeToState.GetData(), m_DenseNodeToState.GetCount());
+      m_uiSearchCounter = 1;
     }
   }
+}
+
+template <typename PathStateType>
+typename ezPathSearch<PathStateType>::NodeState* ezPathSearch<PathStateType>::FindNodeState(ezInt64 iNodeIndex)
+{
+  if (!m_DenseNodeToState.IsEmpty())
+  {
+    EZ_ASSERT_DEBUG(iNodeIndex >= 0 && static_cast<ezUInt64>(iNodeIndex) < m_DenseNodeToState.GetCount(), "Node index {} is outside of the dense node range", iNodeIndex);
+
+    const DenseNodeSlot& slot = m_DenseNodeToState[static_cast<ezUInt32>(iNodeIndex)];
+    return slot.m_uiSearchCounter == m_uiSearchCounter ? &m_NodeStates[slot.m_uiNodeState] : nullptr;
+  }
 
-  EZ_ASSERT_DEV(out_pPathState != nullptr, "Implementation Error");
+  ezUInt32 uiNodeState;
+  return m_NodeToState.TryGetValue(iNodeIndex, uiNodeState) ? &m_NodeStates[uiNodeState] : nullptr;
+}
+
+template <typename PathStateType>
+typename ezPathSearch<PathStateType>::NodeState& ezPathSearch<PathStateType>::AddNodeState(ezInt64 iNodeIndex, const PathStateType& state, ezInt64 iReachedThroughNode)
+{
+  const ezUInt32 uiNodeState = m_NodeStates.GetCount();
+
+  if (!m_DenseNodeToState.IsEmpty())
+  {
+    EZ_ASSERT_DEBUG(iNodeIndex >= 0 && static_cast<ezUInt64>(iNodeIndex) < m_DenseNodeToState.GetCount(), "Node index {} is outside of the dense node range", iNodeIndex);
+
+    DenseNodeSlot& slot = m_DenseNodeToState[static_cast<ezUInt32>(iNodeIndex)];
+    slot.m_uiSearchCounter = m_uiSearchCounter;
+    slot.m_uiNodeState = uiNodeState;
+  }
+  else
+  {
+    m_NodeToState.Insert(iNodeIndex, uiNodeState);
+  }
 
-  const ezInt64 iBestNodeIndex = m_StateQueue[iBestInQueue];
-  m_StateQueue.RemoveAtAndSwap(iBestInQueue);
+  NodeState& nodeState = m_NodeStates.ExpandAndGetRef();
+  nodeState.m_State = state;
+  nodeState.m_State.m_iReachedThroughNode = iReachedThroughNode;
+  nodeState.m_iNodeIndex = iNodeIndex;
+  nodeState.m_uiOpenListIndex = ezInvalidIndex;
 
-  return iBestNodeIndex;
+  return nodeState;
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::SetOpenListEntry(ezUInt32 uiOpenListIndex, const OpenListEntry& entry)
+{
+  m_OpenList[uiOpenListIndex] = entry;
+  m_NodeStates[entry.m_uiNodeState].m_uiOpenListIndex = uiOpenListIndex;
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::MoveUpInOpenList(ezUInt32 uiOpenListIndex)
+{
+  const OpenListEntry entry = m_OpenList[uiOpenListIndex];
+
+  while (uiOpenListIndex > 0)
+  {
+    const ezUInt32 uiParent = (uiOpenListIndex - 1) / 2;
+
+    if (m_OpenList[uiParent].m_fEstimatedCostToTarget <= entry.m_fEstimatedCostToTarget)
+      break;
+
+    SetOpenListEntry(uiOpenListIndex, m_OpenList[uiParent]);
+    uiOpenListIndex = uiParent;
+  }
+
+  SetOpenListEntry(uiOpenListIndex, entry);
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::MoveDownInOpenList(ezUInt32 uiOpenListIndex)
+{
+  const OpenListEntry entry = m_OpenList[uiOpenListIndex];
+  const ezUInt32 uiCount = m_OpenList.GetCount();
+
+  while (true)
+  {
+    ezUInt32 uiChild = uiOpenListIndex * 2 + 1;
+    if (uiChild >= uiCount)
+      break;
+
+    if (uiChild + 1 < uiCount && m_OpenList[uiChild + 1].m_fEstimatedCostToTarget < m_OpenList[uiChild].m_fEstimatedCostToTarget)
+      ++uiChild;
+
+    if (entry.m_fEstimatedCostToTarget <= m_OpenList[uiChild].m_fEstimatedCostToTarget)
+      break;
+
+    SetOpenListEntry(uiOpenListIndex, m_OpenList[uiChild]);
+    uiOpenListIndex = uiChild;
+  }
+
+  SetOpenListEntry(uiOpenListIndex, entry);
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::PushToOpenList(ezUInt32 uiNodeState)
+{
+  OpenListEntry& entry = m_OpenList.ExpandAndGetRef();
+  entry.m_fEstimatedCostToTarget = m_NodeStates[uiNodeState].m_State.m_fEstimatedCostToTarget;
+  entry.m_uiNodeState = uiNodeState;
+
+  MoveUpInOpenList(m_OpenList.GetCount() - 1);
+}
+
+template <typename PathStateType>
+ezInt64 ezPathSearch<PathStateType>::FindBestNodeToExpand(PathStateType*& out_pPathState)
+{
+  EZ_ASSERT_DEV(!m_OpenList.IsEmpty(), "Implementation Error");
+
+  NodeState& best = m_NodeStates[m_OpenList[0].m_uiNodeState];
+  best.m_uiOpenListIndex = ezInvalidIndex;
+
+  const OpenListEntry last = m_OpenList.PeekBack();
+  m_OpenList.PopBack();
+
+  if (!m_OpenList.IsEmpty())
+  {
+    m_OpenList[0] = last;
+    MoveDownInOpenList(0);
+  }
+
+  out_pPathState = &best.m_State;
+  return best.m_iNodeIndex;
 }
 
 template <typename PathStateType>
@@ -43,7 +160,7 @@ void ezPathSearch<PathStateType>::FillOutPathResult(ezInt64 iEndNodeIndex, ezDeq
 
   while (true)
   {
-    const PathStateType* pCurState = &m_PathStates[iEndNodeIndex];
+    const PathStateType* pCurState = &FindNodeState(iEndNodeIndex)->m_State;
 
     PathResultData r;
     r.m_iNodeIndex = iEndNodeIndex;
@@ -69,28 +186,33 @@ void ezPathSearch<PathStateType>::AddPathNode(ezInt64 iNodeIndex, const PathStat
   // ezArgF(m_pCurPathState->m_fEstimatedCostToTarget, 2), ezArgF(NewState.m_fEstimatedCostToTarget, 2));
   EZ_ASSERT_DEV(NewState.m_fEstimatedCostToTarget >= NewState.m_fCostToNode, "Unrealistic expectations will get you nowhere.");
 
-  PathStateType* pExistingState;
-
-  if (m_PathStates.TryGetValue(iNodeIndex, pExistingState))
+  if (NodeState* pExistingState = FindNodeState(iNodeIndex))
   {
-    // state already exists in the hash table, and has a lower cost -> ignore the new state
-    if (pExistingState->m_fCostToNode <= NewState.m_fCostToNode)
+    // state already exists, and has a lower cost -> ignore the new state
+    if (pExistingState->m_State.m_fCostToNode <= NewState.m_fCostToNode)
       return;
 
     // incoming state is better than the existing state -> update existing state
-    *pExistingState = NewState;
-    pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+    pExistingState->m_State = NewState;
+    pExistingState->m_State.m_iReachedThroughNode = m_iCurNodeIndex;
+
+    // if it still waits for expansion, move it to its new place in the open list
+    const ezUInt32 uiOpenListIndex = pExistingState->m_uiOpenListIndex;
+    if (uiOpenListIndex != ezInvalidIndex)
+    {
+      m_OpenList[uiOpenListIndex].m_fEstimatedCostToTarget = NewState.m_fEstimatedCostToTarget;
+      MoveUpInOpenList(uiOpenListIndex);
+      MoveDownInOpenList(pExistingState->m_uiOpenListIndex);
+    }
+
     return;
   }
 
   // the state has not been reached before -> insert it
-  pExistingState = &m_PathStates[iNodeIndex];
-
-  *pExistingState = NewState;
-  pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+  AddNodeState(iNodeIndex, NewState, m_iCurNodeIndex);
 
   // put it into the queue of states that still need to be expanded
-  m_StateQueue.PushBack(iNodeIndex);
+  PushToOpenList(m_NodeStates.GetCount() - 1);
 }
 
 template <typename PathStateType>
@@ -103,13 +225,9 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
 
   if (iStartNodeIndex == iTargetNodeIndex)
   {
-    m_PathStates.Reserve(1);
-
-    m_PathStates[iTargetNodeIndex] = StartState;
-
     PathResultData r;
     r.m_iNodeIndex = iTargetNodeIndex;
-    r.m_pPathState = &m_PathStates[iTargetNodeIndex];
+    r.m_pPathState = &AddNodeState(iTargetNodeIndex, StartState, iTargetNodeIndex).m_State;
 
     out_Path.Clear();
     out_Path.PushBack(r);
@@ -117,21 +235,21 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
     return EZ_SUCCESS;
   }
 
-  m_PathStates.Reserve(10000);
+  if (m_DenseNodeToState.IsEmpty())
+  {
+    m_NodeToState.Reserve(10000);
+  }
 
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
+  // make sure the first state references itself, as that is a termination criterion
+  PathStateType& FirstState = AddNodeState(iStartNodeIndex, StartState, iStartNodeIndex).m_State;
 
   m_pStateGenerator->StartSearch(iStartNodeIndex, &FirstState, iTargetNodeIndex);
 
-  // make sure the first state references itself, as that is a termination criterion
-  FirstState = StartState;
-  FirstState.m_iReachedThroughNode = iStartNodeIndex;
-
   // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  PushToOpenList(0);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (!m_OpenList.IsEmpty())
   {
     PathStateType* pCurState;
     m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
@@ -172,21 +290,21 @@ ezResult ezPathSearch<PathStateType>::FindClosest(
 
   ClearPathStates();
 
-  m_PathStates.Reserve(10000);
+  if (m_DenseNodeToState.IsEmpty())
+  {
+    m_NodeToState.Reserve(10000);
+  }
 
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
+  // make sure the first state references itself, as that is a termination criterion
+  PathStateType& FirstState = AddNodeState(iStartNodeIndex, StartState, iStartNodeIndex).m_State;
 
   m_pStateGenerator->StartSearchForClosest(iStartNodeIndex, &FirstState);
 
-  // make sure the first state references itself, as that is a termination criterion
-  FirstState = StartState;
-  FirstState.m_iReachedThroughNode = iStartNodeIndex;
-
   // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  PushToOpenList(0);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (!m_OpenList.IsEmpty())
   {
     PathStateType* pCurState;
     m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
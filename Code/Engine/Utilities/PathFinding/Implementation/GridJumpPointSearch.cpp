@@ -0,0 +1,188 @@
+#include <Utilities/UtilitiesPCH.h>
+
+#include <Utilities/PathFinding/GridJumpPointSearch.h>
+
+void ezGridJumpPointSearch::SetGrid(ezUInt32 uiWidth, ezUInt32 uiHeight, ezGridNavmesh::CellBlocked isCellBlocked, void* pPassThrough)
+{
+  m_uiWidth = uiWidth;
+  m_uiHeight = uiHeight;
+  m_IsCellBlocked = isCellBlocked;
+  m_pPassThrough = pPassThrough;
+}
+
+void ezGridJumpPointSearch::StartSearchForClosest(ezInt64 iStartNodeIndex, const ezPathState* pStartState)
+{
+  EZ_IGNORE_UNUSED(iStartNodeIndex);
+  EZ_IGNORE_UNUSED(pStartState);
+  EZ_ASSERT_DEV(m_IsCellBlocked != nullptr, "SetGrid() has not been called.");
+
+  m_bHasTarget = false;
+}
+
+void ezGridJumpPointSearch::StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex)
+{
+  EZ_IGNORE_UNUSED(iStartNodeIndex);
+  EZ_IGNORE_UNUSED(pStartState);
+  EZ_ASSERT_DEV(m_IsCellBlocked != nullptr, "SetGrid() has not been called.");
+
+  m_bHasTarget = true;
+  m_vTarget = GetCoordinate(iTargetNodeIndex);
+}
+
+ezVec2I32 ezGridJumpPointSearch::GetCoordinate(ezInt64 iNodeIndex) const
+{
+  return ezVec2I32(static_cast<ezInt32>(iNodeIndex % m_uiWidth), static_cast<ezInt32>(iNodeIndex / m_uiWidth));
+}
+
+float ezGridJumpPointSearch::GetOctileDistance(const ezVec2I32& a, const ezVec2I32& b)
+{
+  const ezInt32 iDiffX = ezMath::Abs(a.x - b.x);
+  const ezInt32 iDiffY = ezMath::Abs(a.y - b.y);
+
+  return static_cast<float>(ezMath::Max(iDiffX, iDiffY) - ezMath::Min(iDiffX, iDiffY)) + static_cast<float>(ezMath::Min(iDiffX, iDiffY)) * ezMath::Sqrt(2.0f);
+}
+
+bool ezGridJumpPointSearch::IsFree(ezInt32 x, ezInt32 y) const
+{
+  if (x < 0 || y < 0 || static_cast<ezUInt32>(x) >= m_uiWidth || static_cast<ezUInt32>(y) >= m_uiHeight)
+    return false;
+
+  return !m_IsCellBlocked(static_cast<ezUInt32>(y) * m_uiWidth + static_cast<ezUInt32>(x), m_pPassThrough);
+}
+
+bool ezGridJumpPointSearch::JumpStraight(ezInt32 x, ezInt32 y, ezInt32 dx, ezInt32 dy, ezVec2I32& out_vJumpPoint) const
+{
+  while (IsFree(x, y))
+  {
+    if (IsTarget(x, y))
+    {
+      out_vJumpPoint.Set(x, y);
+      return true;
+    }
+
+    // a cell is a jump point, if a neighbor next to it can only be reached optimally through it,
+    // because the cell behind that neighbor is blocked
+    if (dx != 0)
+    {
+      if ((IsFree(x, y - 1) && !IsFree(x - dx, y - 1)) || (IsFree(x, y + 1) && !IsFree(x - dx, y + 1)))
+      {
+        out_vJumpPoint.Set(x, y);
+        return true;
+      }
+    }
+    else
+    {
+      if ((IsFree(x - 1, y) && !IsFree(x - 1, y - dy)) || (IsFree(x + 1, y) && !IsFree(x + 1, y - dy)))
+      {
+        out_vJumpPoint.Set(x, y);
+        return true;
+      }
+    }
+
+    x += dx;
+    y += dy;
+  }
+
+  return false;
+}
+
+bool ezGridJumpPointSearch::Jump(ezVec2I32 vFrom, ezVec2I32 vDir, ezVec2I32& out_vJumpPoint) const
+{
+  if (vDir.x == 0 || vDir.y == 0)
+    return JumpStraight(vFrom.x + vDir.x, vFrom.y + vDir.y, vDir.x, vDir.y, out_vJumpPoint);
+
+  ezInt32 x = vFrom.x;
+  ezInt32 y = vFrom.y;
+
+  while (true)
+  {
+    // diagonal moves must not cut corners
+    if (!IsFree(x + vDir.x, y) || !IsFree(x, y + vDir.y))
+      return false;
+
+    x += vDir.x;
+    y += vDir.y;
+
+    if (!IsFree(x, y))
+      return false;
+
+    if (IsTarget(x, y))
+    {
+      out_vJumpPoint.Set(x, y);
+      return true;
+    }
+
+    // a diagonal cell is a jump point, if a jump point can be reached from it by moving straight
+    ezVec2I32 vStraightJumpPoint;
+    if (JumpStraight(x + vDir.x, y, vDir.x, 0, vStraightJumpPoint) || JumpStraight(x, y + vDir.y, 0, vDir.y, vStraightJumpPoint))
+    {
+      out_vJumpPoint.Set(x, y);
+      return true;
+    }
+  }
+}
+
+void ezGridJumpPointSearch::GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& StartState, ezPathSearch<ezPathState>* pPathSearch)
+{
+  const ezVec2I32 vCur = GetCoordinate(iNodeIndex);
+
+  ezHybridArray<ezVec2I32, 8> directions;
+
+  if (StartState.m_iReachedThroughNode == iNodeIndex)
+  {
+    // the start node expands into all directions
+    for (ezInt32 dy = -1; dy <= 1; ++dy)
+    {
+      for (ezInt32 dx = -1; dx <= 1; ++dx)
+      {
+        if (dx != 0 || dy != 0)
+        {
+          directions.PushBack(ezVec2I32(dx, dy));
+        }
+      }
+    }
+  }
+  else
+  {
+    // all other nodes only continue in the direction that they were reached from, plus the directions that may have been forced by obstacles
+    const ezVec2I32 vPrev = GetCoordinate(StartState.m_iReachedThroughNode);
+    const ezInt32 dx = ezMath::Sign(vCur.x - vPrev.x);
+    const ezInt32 dy = ezMath::Sign(vCur.y - vPrev.y);
+
+    if (dx != 0 && dy != 0)
+    {
+      directions.PushBack(ezVec2I32(dx, 0));
+      directions.PushBack(ezVec2I32(0, dy));
+      directions.PushBack(ezVec2I32(dx, dy));
+    }
+    else if (dx != 0)
+    {
+      directions.PushBack(ezVec2I32(dx, 0));
+      directions.PushBack(ezVec2I32(dx, 1));
+      directions.PushBack(ezVec2I32(dx, -1));
+      directions.PushBack(ezVec2I32(0, 1));
+      directions.PushBack(ezVec2I32(0, -1));
+    }
+    else
+    {
+      directions.PushBack(ezVec2I32(0, dy));
+      directions.PushBack(ezVec2I32(1, dy));
+      directions.PushBack(ezVec2I32(-1, dy));
+      directions.PushBack(ezVec2I32(1, 0));
+      directions.PushBack(ezVec2I32(-1, 0));
+    }
+  }
+
+  for (const ezVec2I32& vDir : directions)
+  {
+    ezVec2I32 vJumpPoint;
+    if (!Jump(vCur, vDir, vJumpPoint))
+      continue;
+
+    ezPathState state;
+    state.m_fCostToNode = StartState.m_fCostToNode + GetOctileDistance(vCur, vJumpPoint);
+    state.m_fEstimatedCostToTarget = state.m_fCostToNode + (m_bHasTarget ? GetOctileDistance(vJumpPoint, m_vTarget) : 0.0f);
+
+    pPathSearch->AddPathNode(static_cast<ezInt64>(vJumpPoint.y) * m_uiWidth + vJumpPoint.x, state);
+  }
+}
@@ -59,13 +59,22 @@ public:
 
   /// \brief Automatically called by ezPathSearch objects when a new path search is about to start (ezPathSearch::FindClosest).
   /// Allows the generator to do some initial setup.
-  virtual void StartSearchForClosest(ezInt64 iStartNodeIndex, const PathStateType* pStartState) {}
+  virtual void StartSearchForClosest(ezInt64 iStartNodeIndex, const PathStateType* pStartState)
+  {
+    EZ_IGNORE_UNUSED(iStartNodeIndex);
+    EZ_IGNORE_UNUSED(pStartState);
+  }
 
   /// \brief Automatically called by ezPathSearch objects when a new path search is about to start (ezPathSearch::FindPath).
   /// Allows the generator to do some initial setup.
-  virtual void StartSearch(ezInt64 iStartNodeIndex, const PathStateType* pStartState, ezInt64 iTargetNodeIndex) {}
+  virtual void StartSearch(ezInt64 iStartNodeIndex, const PathStateType* pStartState, ezInt64 iTargetNodeIndex)
+  {
+    EZ_IGNORE_UNUSED(iStartNodeIndex);
+    EZ_IGNORE_UNUSED(pStartState);
+    EZ_IGNORE_UNUSED(iTargetNodeIndex);
+  }
 
   /// \brief Automatically called by ezPathSearch objects when a path search was finished.
   /// Allows the generator to do some cleanup.
-  virtual void SearchFinished(ezResult res) {}
+  virtual void SearchFinished(ezResult res) { EZ_IGNORE_UNUSED(res); }
 };
@@ -0,0 +1,9 @@
+//
+// This file is auto-generated by CMake.
+//
+
+#pragma once
+
+#define EZ_GIT_COMMIT_HASH_SHORT @EZ_GIT_COMMIT_HASH_SHORT @
+#define EZ_GIT_COMMIT_HASH_LONG @EZ_GIT_COMMIT_HASH_LONG @
+#define EZ_GIT_BRANCH_NAME "master"
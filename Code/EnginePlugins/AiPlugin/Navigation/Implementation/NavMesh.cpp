@@ -13,6 +13,8 @@ ezAiNavMeshSector::ezAiNavMeshSector()
   m_FlagInvalidate = 0;
   m_FlagUpdateAvailable = 0;
   m_FlagUsable = 0;
+  m_FlagBuilding = 0;
+  m_FlagOutdated = 0;
 }
 
 ezAiNavMeshSector::~ezAiNavMeshSector() = default;
@@ -74,6 +76,7 @@ const ezAiNavMeshSector* ezAiNavMesh::GetSector(SectorID sectorID) const
 bool ezAiNavMesh::RequestSector(SectorID sectorID)
 {
   auto& sector = m_Sectors.FindOrAdd(sectorID).Value();
+  sector.m_uiLastUsed = m_uiUpdateCounter;
 
   if (sector.m_FlagUsable == 0)
   {
@@ -142,6 +145,20 @@ void ezAiNavMesh::InvalidateSector(SectorID sectorID, bool bRebuildAsSoonAsPossi
 
   auto& sector = it.Value();
 
+  if (sector.m_FlagBuilding == 1)
+  {
+    // the sector is currently built from geometry that is now out of date
+    // discard that result once it arrives, FinalizeSectorUpdates() then rebuilds or unloads the sector
+    sector.m_FlagOutdated = 1;
+
+    if (!bRebuildAsSoonAsPossible)
+    {
+      sector.m_FlagRequested = 0;
+    }
+
+    return;
+  }
+
   if (sector.m_FlagInvalidate == 0 && (sector.m_FlagUsable == 1 || sector.m_FlagUpdateAvailable == 1))
   {
     if (bRebuildAsSoonAsPossible)
@@ -159,15 +176,45 @@ void ezAiNavMesh::InvalidateSector(SectorID sectorID, bool bRebuildAsSoonAsPossi
 
 void ezAiNavMesh::FinalizeSectorUpdates()
 {
-  EZ_LOCK(m_Mutex);
+  ++m_uiUpdateCounter;
+
+  ezHybridArray<FinishedSector, 8> finishedSectors;
 
-  for (auto sectorID : m_UpdatingSectors)
   {
+    EZ_LOCK(m_Mutex);
+    finishedSectors.Swap(m_FinishedSectors);
+  }
+
+  for (auto& finished : finishedSectors)
+  {
+    const SectorID sectorID = finished.m_SectorID;
     const auto coord = CalculateSectorCoord(sectorID);
 
     auto& sector = m_Sectors[sectorID];
 
-    EZ_ASSERT_DEV(sector.m_FlagUpdateAvailable == 1, "Invalid sector update state");
+    EZ_ASSERT_DEV(sector.m_FlagBuilding == 1, "Invalid sector update state");
+    sector.m_FlagBuilding = 0;
+
+    if (sector.m_FlagOutdated == 1)
+    {
+      // the sector got invalidated while it was built, the result is already out of date
+      sector.m_FlagOutdated = 0;
+
+      if (sector.m_FlagRequested == 1)
+      {
+        sector.m_FlagInvalidate = 1;
+        m_RequestedSectors.PushBack(sectorID);
+      }
+      else
+      {
+        m_UnloadingSectors.PushBack(sectorID);
+      }
+
+      continue;
+    }
+
+    sector.m_NavmeshDataNew.Swap(finished.m_NavmeshData);
+    sector.m_FlagUpdateAvailable = 1;
 
     if (!sector.m_NavmeshDataCur.IsEmpty())
     {
@@ -179,6 +226,8 @@ void ezAiNavMesh::FinalizeSectorUpdates()
       {
         ezLog::Error("NavMesh removeTile error: {}", res);
       }
+
+      m_uiLoadedSectorMemory -= sector.m_NavmeshDataCur.GetCount();
     }
 
     sector.m_NavmeshDataCur.Swap(sector.m_NavmeshDataNew);
@@ -193,10 +242,12 @@ void ezAiNavMesh::FinalizeSectorUpdates()
       {
         ezLog::Success("Loaded navmesh tile {}|{}", coord.x, coord.y);
         sector.m_FlagUsable = 1;
+        m_uiLoadedSectorMemory += sector.m_NavmeshDataCur.GetCount();
       }
       else
       {
         ezLog::Error("NavMesh addTile error: {}", res);
+        sector.m_NavmeshDataCur.Clear();
       }
     }
     else
@@ -210,47 +261,113 @@ void ezAiNavMesh::FinalizeSectorUpdates()
     // sector.m_FlagRequested = 0; // do not reset the requested flag
   }
 
-  m_UpdatingSectors.Clear();
-
   for (auto sectorID : m_UnloadingSectors)
   {
     auto& sector = m_Sectors[sectorID];
 
     // Sector has been requested since then, don't unload it.
-    if (sector.m_FlagRequested == 1)
+    // Sectors that are being built are unloaded once the (outdated) result arrives.
+    if (sector.m_FlagRequested == 1 || sector.m_FlagBuilding == 1)
       continue;
 
-    if (!sector.m_NavmeshDataCur.IsEmpty())
-    {
-      const auto res = m_pNavMesh->removeTile(sector.m_TileRef, nullptr, nullptr);
+    UnloadSector(sector);
+  }
 
-      if (res != DT_SUCCESS)
-      {
-        ezLog::Error("NavMesh removeTile error: {}", res);
-      }
+  m_UnloadingSectors.Clear();
+}
 
-      sector.m_NavmeshDataCur.Clear();
-      sector.m_NavmeshDataCur.Compact();
+void ezAiNavMesh::UnloadSector(ezAiNavMeshSector& ref_sector)
+{
+  if (!ref_sector.m_NavmeshDataCur.IsEmpty())
+  {
+    const auto res = m_pNavMesh->removeTile(ref_sector.m_TileRef, nullptr, nullptr);
+
+    if (res != DT_SUCCESS)
+    {
+      ezLog::Error("NavMesh removeTile error: {}", res);
     }
 
-    sector.m_FlagRequested = 0;
-    sector.m_FlagInvalidate = 0;
-    sector.m_FlagUpdateAvailable = 0;
-    sector.m_FlagUsable = 0;
+    m_uiLoadedSectorMemory -= ref_sector.m_NavmeshDataCur.GetCount();
+
+    ref_sector.m_NavmeshDataCur.Clear();
+    ref_sector.m_NavmeshDataCur.Compact();
   }
 
-  m_UnloadingSectors.Clear();
+  ref_sector.m_FlagRequested = 0;
+  ref_sector.m_FlagInvalidate = 0;
+  ref_sector.m_FlagUpdateAvailable = 0;
+  ref_sector.m_FlagUsable = 0;
+}
+
+void ezAiNavMesh::UnloadUnusedSectors(ezUInt64 uiMemoryBudget, ezUInt32 uiMinUnusedUpdates)
+{
+  if (m_uiLoadedSectorMemory <= uiMemoryBudget)
+    return;
+
+  struct Candidate
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiLastUsed;
+    ezAiNavMeshSector* m_pSector;
+  };
+
+  ezHybridArray<Candidate, 64> candidates;
+
+  for (auto it = m_Sectors.GetIterator(); it.IsValid(); ++it)
+  {
+    ezAiNavMeshSector& sector = it.Value();
+
+    // sectors that are (re-)built right now are finalized or unloaded by FinalizeSectorUpdates() once the result arrives
+    if (sector.m_FlagUsable == 0 || sector.m_FlagBuilding == 1 || sector.m_FlagOutdated == 1 || sector.m_NavmeshDataCur.IsEmpty())
+      continue;
+
+    if (sector.m_uiLastUsed + uiMinUnusedUpdates >= m_uiUpdateCounter)
+      continue;
+
+    candidates.PushBack({sector.m_uiLastUsed, &sector});
+  }
+
+  // least recently used first
+  candidates.Sort([](const Candidate& lhs, const Candidate& rhs)
+    { return lhs.m_uiLastUsed < rhs.m_uiLastUsed; });
+
+  for (const Candidate& candidate : candidates)
+  {
+    if (m_uiLoadedSectorMemory <= uiMemoryBudget)
+      break;
+
+    UnloadSector(*candidate.m_pSector);
+  }
 }
 
 ezAiNavMesh::SectorID ezAiNavMesh::RetrieveRequestedSector()
 {
-  if (m_RequestedSectors.IsEmpty())
-    return ezInvalidIndex;
+  while (!m_RequestedSectors.IsEmpty())
+  {
+    const ezAiNavMesh::SectorID id = m_RequestedSectors.PeekFront();
+    m_RequestedSectors.PopFront();
 
-  ezAiNavMesh::SectorID id = m_RequestedSectors.PeekFront();
-  m_RequestedSectors.PopFront();
+    auto& sector = m_Sectors[id];
+
+    // already queued multiple times, InvalidateSector() takes care of sectors that change while they are built
+    if (sector.m_FlagBuilding == 1)
+      continue;
+
+    sector.m_FlagBuilding = 1;
+    return id;
+  }
+
+  return ezInvalidIndex;
+}
+
+void ezAiNavMesh::FinishSectorBuild(SectorID sectorID, ezDataBuffer&& navmeshData)
+{
+  EZ_LOCK(m_Mutex);
 
-  return id;
+  auto& finished = m_FinishedSectors.ExpandAndGetRef();
+  finished.m_SectorID = sectorID;
+  finished.m_NavmeshData = std::move(navmeshData);
 }
 
 ezVec2 ezAiNavMesh::GetSectorPositionOffset(ezVec2I32 vCoord) const
@@ -217,7 +217,11 @@ ezResult BuildDetourNavMeshData(const ezAiNavmeshConfig& config, const rcPolyMes
 
 void ezNavMeshSectorGenerationTask::Execute()
 {
-  m_pWorldNavMesh->BuildSector(m_SectorID, m_pNavGeo);
+  ezDataBuffer navmeshData;
+  m_pWorldNavMesh->BuildSector(m_SectorID, m_Triangles, navmeshData);
+  m_pWorldNavMesh->FinishSectorBuild(m_SectorID, std::move(navmeshData));
+
+  m_Triangles.Clear();
 }
 
 static ezInt8 GetSurfaceGroundType(const ezSurfaceResource* pSurf)
@@ -243,14 +247,8 @@ static ezInt8 GetSurfaceGroundType(const ezSurfaceResource* pSurf)
   return 1; // the "<Default>" ground type that is not "<None>"
 }
 
-static void QueryInputGeo(const ezNavmeshGeoWorldModuleInterface* pGeo, ezUInt32 uiCollisionLayer, ezBoundingBox bounds, ezAiNavMeshInputGeo& out_inputGeo)
+static void ConvertInputGeo(ezDynamicArray<ezNavmeshTriangle>& triangles, ezAiNavMeshInputGeo& out_inputGeo)
 {
-  bounds.Grow(ezVec3(1.0f));
-
-  ezHybridArray<ezNavmeshTriangle, 64> triangles;
-
-  pGeo->RetrieveGeometryInArea(uiCollisionLayer, bounds, triangles);
-
   // sort all triangles by surface (pointer)
   triangles.Sort([](const ezNavmeshTriangle& lhs, const ezNavmeshTriangle& rhs)
     { return lhs.m_pSurface < rhs.m_pSurface; });
@@ -306,28 +304,35 @@ static void QueryInputGeo(const ezNavmeshGeoWorldModuleInterface* pGeo, ezUInt32
   }
 }
 
-void ezAiNavMesh::BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleInterface* pGeo)
+void ezAiNavMesh::RetrieveSectorGeometry(SectorID sectorID, const ezNavmeshGeoWorldModuleInterface* pGeo, ezDynamicArray<ezNavmeshTriangle>& out_triangles) const
 {
-  const ezVec2I32 sectorCoord = CalculateSectorCoord(sectorID);
-  auto& sector = m_Sectors[sectorID];
+  ezBoundingBox bounds = GetSectorBounds(CalculateSectorCoord(sectorID), -1000, +1000);
+
+  const float cs = m_NavmeshConfig.m_fCellSize;
+  const float borderSize = ceilf(m_NavmeshConfig.m_fAgentRadius / cs) + 3;
+  bounds.m_vMin.x -= borderSize * cs;
+  bounds.m_vMin.y -= borderSize * cs;
+  bounds.m_vMax.x += borderSize * cs;
+  bounds.m_vMax.y += borderSize * cs;
+  bounds.Grow(ezVec3(1.0f));
 
-  EZ_ASSERT_DEV(sector.m_FlagUpdateAvailable == 0, "Shouldn't update a sector that is already being updated");
+  out_triangles.Clear();
+  pGeo->RetrieveGeometryInArea(m_NavmeshConfig.m_uiCollisionLayer, bounds, out_triangles);
+}
 
+void ezAiNavMesh::BuildSector(SectorID sectorID, ezDynamicArray<ezNavmeshTriangle>& ref_triangles, ezDataBuffer& out_navmeshData) const
+{
+  const ezVec2I32 sectorCoord = CalculateSectorCoord(sectorID);
   const ezBoundingBox bounds = GetSectorBounds(sectorCoord, -1000, +1000);
 
+  out_navmeshData.Clear();
+
   ezAiNavMeshInputGeo inputGeo;
-  {
-    ezBoundingBox boundsWithBorder = bounds;
-    const float cs = m_NavmeshConfig.m_fCellSize;
-    const float borderSize = ceilf(m_NavmeshConfig.m_fAgentRadius / cs) + 3;
-    boundsWithBorder.m_vMin.x -= borderSize * cs;
-    boundsWithBorder.m_vMin.y -= borderSize * cs;
-    boundsWithBorder.m_vMax.x += borderSize * cs;
-    boundsWithBorder.m_vMax.y += borderSize * cs;
-    QueryInputGeo(pGeo, m_NavmeshConfig.m_uiCollisionLayer, boundsWithBorder, inputGeo);
-  }
+  ConvertInputGeo(ref_triangles, inputGeo);
+
   if (!inputGeo.m_Vertices.IsEmpty())
   {
+    // every build uses its own context, so that multiple sectors can be built at the same time
     rcContext recastContext;
     rcPolyMesh polyMesh;
 
@@ -335,15 +340,7 @@ void ezAiNavMesh::BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleIn
 
     if (polyMesh.nverts > 0 && polyMesh.npolys > 0)
     {
-      BuildDetourNavMeshData(m_NavmeshConfig, polyMesh, sector.m_NavmeshDataNew, sectorCoord).AssertSuccess();
+      BuildDetourNavMeshData(m_NavmeshConfig, polyMesh, out_navmeshData, sectorCoord).AssertSuccess();
     }
   }
-
-  {
-    EZ_ASSERT_DEV(sector.m_FlagUpdateAvailable == 0, "Race condition in navmesh sector update");
-    sector.m_FlagUpdateAvailable = 1;
-
-    EZ_LOCK(m_Mutex);
-    m_UpdatingSectors.PushBack(sectorID);
-  }
 }
@@ -1,16 +1,18 @@
 #pragma once
 
 #include <AiPlugin/Navigation/NavMesh.h>
+#include <Core/Interfaces/NavmeshGeoWorldModule.h>
 #include <Foundation/Threading/TaskSystem.h>
 
-class ezNavmeshGeoWorldModuleInterface;
-
+/// \brief Builds a single navmesh sector from a snapshot of the physics geometry.
+///
+/// Multiple of these tasks may run at the same time, each one only works on its own data.
 class ezNavMeshSectorGenerationTask : public ezTask
 {
 public:
   ezAiNavMesh::SectorID m_SectorID = ezInvalidIndex;
   ezAiNavMesh* m_pWorldNavMesh = nullptr;
-  const ezNavmeshGeoWorldModuleInterface* m_pNavGeo = nullptr;
+  ezDynamicArray<ezNavmeshTriangle> m_Triangles;
 
 protected:
   virtual void Execute() override;
@@ -6,6 +6,11 @@
 #include <Foundation/Configuration/CVar.h>
 
 ezCVarInt cvar_NavMeshVisualize("AI.Navmesh.Visualize", -1, ezCVarFlags::None, "Visualize the n-th navmesh.");
+ezCVarInt cvar_NavMeshMaxConcurrentSectors("AI.Navmesh.MaxConcurrentSectors", 4, ezCVarFlags::Default, "How many navmesh sectors may be generated at the same time.");
+ezCVarInt cvar_NavMeshMemoryBudget("AI.Navmesh.MemoryBudget", 64, ezCVarFlags::Default, "Memory budget (in MB) for the loaded sectors of each navmesh. Unused sectors are unloaded when it is exceeded. 0 disables unloading.");
+
+/// Sectors that were used within this many updates are never unloaded to stay within the memory budget.
+static constexpr ezUInt32 s_uiMinUnusedNavMeshUpdates = 60;
 
 // clang-format off
 EZ_IMPLEMENT_WORLD_MODULE(ezAiNavMeshWorldModule);
@@ -74,15 +79,22 @@ void ezAiNavMeshWorldModule::Initialize()
     m_WorldNavMeshes[cfg.m_sName] = EZ_DEFAULT_NEW(ezAiNavMesh, cfg);
   }
 
-  m_pGenerateSectorTask = EZ_DEFAULT_NEW(ezNavMeshSectorGenerationTask);
-  m_pGenerateSectorTask->ConfigureTask("Generate Navmesh Sector", ezTaskNesting::Maybe);
+  m_uiNextNavMeshToGenerate = 0;
 }
 
 void ezAiNavMeshWorldModule::Deinitialize()
 {
-  m_pGenerateSectorTask = nullptr;
-  ezTaskSystem::CancelGroup(m_GenerateSectorTaskID).IgnoreResult();
-  ezTaskSystem::WaitForGroup(m_GenerateSectorTaskID);
+  for (auto& task : m_GenerateSectorTasks)
+  {
+    ezTaskSystem::CancelGroup(task.m_TaskID).IgnoreResult();
+  }
+
+  for (auto& task : m_GenerateSectorTasks)
+  {
+    ezTaskSystem::WaitForGroup(task.m_TaskID);
+  }
+
+  m_GenerateSectorTasks.Clear();
 }
 
 ezAiNavMesh* ezAiNavMeshWorldModule::GetNavMesh(ezStringView sName)
@@ -114,6 +126,11 @@ void ezAiNavMeshWorldModule::Update(const UpdateContext& ctxt)
   for (auto& nm : m_WorldNavMeshes)
   {
     nm.Value()->FinalizeSectorUpdates();
+
+    if (cvar_NavMeshMemoryBudget > 0)
+    {
+      nm.Value()->UnloadUnusedSectors(static_cast<ezUInt64>(cvar_NavMeshMemoryBudget) * 1024 * 1024, s_uiMinUnusedNavMeshUpdates);
+    }
   }
 
   if (cvar_NavMeshVisualize >= 0)
@@ -129,26 +146,59 @@ void ezAiNavMeshWorldModule::Update(const UpdateContext& ctxt)
     }
   }
 
-  if (!ezTaskSystem::IsTaskGroupFinished(m_GenerateSectorTaskID))
-    return;
-
   auto pNavGeo = GetWorld()->GetOrCreateModule<ezNavmeshGeoWorldModuleInterface>();
   if (pNavGeo == nullptr)
     return;
 
-  for (auto& nm : m_WorldNavMeshes)
+  StartSectorGeneration(pNavGeo);
+}
+
+void ezAiNavMeshWorldModule::StartSectorGeneration(const ezNavmeshGeoWorldModuleInterface* pNavGeo)
+{
+  const ezUInt32 uiMaxTasks = static_cast<ezUInt32>(ezMath::Max<int>(cvar_NavMeshMaxConcurrentSectors, 1));
+  const ezUInt32 uiNumNavMeshes = m_WorldNavMeshes.GetCount();
+
+  for (ezUInt32 uiTask = 0; uiTask < uiMaxTasks; ++uiTask)
   {
-    auto sectorID = nm.Value()->RetrieveRequestedSector();
-    if (sectorID == ezInvalidIndex)
+    if (uiTask == m_GenerateSectorTasks.GetCount())
+    {
+      auto& task = m_GenerateSectorTasks.ExpandAndGetRef();
+      task.m_pTask = EZ_DEFAULT_NEW(ezNavMeshSectorGenerationTask);
+      task.m_pTask->ConfigureTask("Generate Navmesh Sector", ezTaskNesting::Maybe);
+    }
+
+    auto& task = m_GenerateSectorTasks[uiTask];
+
+    if (!ezTaskSystem::IsTaskGroupFinished(task.m_TaskID))
       continue;
 
-    m_pGenerateSectorTask->m_pWorldNavMesh = nm.Value();
-    m_pGenerateSectorTask->m_SectorID = sectorID;
-    m_pGenerateSectorTask->m_pNavGeo = pNavGeo;
+    // go through the navmeshes round-robin, so that one navmesh with many requests doesn't starve the others
+    ezAiNavMesh* pNavMesh = nullptr;
+    ezAiNavMesh::SectorID sectorID = ezInvalidIndex;
+
+    for (ezUInt32 i = 0; i < uiNumNavMeshes && sectorID == ezInvalidIndex; ++i)
+    {
+      auto it = m_WorldNavMeshes.GetIterator();
+      for (ezUInt32 uiSkip = (m_uiNextNavMeshToGenerate + i) % uiNumNavMeshes; uiSkip > 0; --uiSkip)
+      {
+        ++it;
+      }
+
+      pNavMesh = it.Value();
+      sectorID = pNavMesh->RetrieveRequestedSector();
+    }
+
+    if (sectorID == ezInvalidIndex)
+      return;
+
+    m_uiNextNavMeshToGenerate = (m_uiNextNavMeshToGenerate + 1) % uiNumNavMeshes;
 
-    m_GenerateSectorTaskID = ezTaskSystem::StartSingleTask(m_pGenerateSectorTask, ezTaskPriority::LongRunning);
+    // the geometry is retrieved on the main thread, the task then only works on this snapshot
+    task.m_pTask->m_pWorldNavMesh = pNavMesh;
+    task.m_pTask->m_SectorID = sectorID;
+    pNavMesh->RetrieveSectorGeometry(sectorID, pNavGeo, task.m_pTask->m_Triangles);
 
-    break;
+    task.m_TaskID = ezTaskSystem::StartSingleTask(task.m_pTask, ezTaskPriority::LongRunning);
   }
 }
 
@@ -16,6 +16,7 @@ using ezDataBuffer = ezDynamicArray<ezUInt8>;
 
 class ezNavmeshGeoWorldModuleInterface;
 class dtNavMesh;
+struct ezNavmeshTriangle;
 
 /// \brief Stores indices for a triangle.
 struct ezAiNavMeshTriangle final
@@ -51,6 +52,10 @@ struct ezAiNavMeshSector final
   ezUInt8 m_FlagInvalidate : 1;
   ezUInt8 m_FlagUpdateAvailable : 1;
   ezUInt8 m_FlagUsable : 1;
+  ezUInt8 m_FlagBuilding : 1; ///< A generation task is currently building this sector.
+  ezUInt8 m_FlagOutdated : 1; ///< The sector was invalidated while it was being built, the result has to be discarded.
+
+  ezUInt32 m_uiLastUsed = 0; ///< The update counter of the navmesh when this sector was requested the last time.
 
   ezDataBuffer m_NavmeshDataCur;
   ezDataBuffer m_NavmeshDataNew;
@@ -109,10 +114,38 @@ public:
   /// Otherwise, it will be unloaded and will not be rebuilt until it is requested again.
   void InvalidateSector(const ezVec2& vCenter, const ezVec2& vHalfExtents, bool bRebuildAsSoonAsPossible);
 
+  /// \brief Integrates all sectors that finished building since the last call and unloads sectors that were invalidated.
+  ///
+  /// Must be called once per frame from the main thread. Also advances the counter that is used for sector usage tracking.
   void FinalizeSectorUpdates();
 
+  /// \brief Unloads the least recently used sectors until the navmesh data of all loaded sectors fits into the given budget.
+  ///
+  /// Sectors that were requested within the last \a uiMinUnusedUpdates updates are never unloaded, so the budget may be exceeded.
+  /// Unloaded sectors are rebuilt once they are requested again.
+  void UnloadUnusedSectors(ezUInt64 uiMemoryBudget, ezUInt32 uiMinUnusedUpdates);
+
+  /// \brief Returns the size of the navmesh data of all loaded sectors.
+  ezUInt64 GetLoadedSectorMemory() const { return m_uiLoadedSectorMemory; }
+
+  /// \brief Returns the next sector that should be built and marks it as being built.
+  ///
+  /// Returns ezInvalidIndex, if no sector needs to be built at the moment.
   SectorID RetrieveRequestedSector();
-  void BuildSector(SectorID sectorID, const ezNavmeshGeoWorldModuleInterface* pGeo);
+
+  /// \brief Retrieves the physics geometry from which the given sector is built.
+  ///
+  /// This is called on the main thread, so that the sector can then be built on any thread from this snapshot.
+  void RetrieveSectorGeometry(SectorID sectorID, const ezNavmeshGeoWorldModuleInterface* pGeo, ezDynamicArray<ezNavmeshTriangle>& out_triangles) const;
+
+  /// \brief Builds the navmesh data for a sector from the given geometry snapshot.
+  ///
+  /// This does not modify the navmesh and can be called for multiple sectors in parallel. The triangles are modified in place.
+  /// The result is passed on to FinalizeSectorUpdates() through FinishSectorBuild().
+  void BuildSector(SectorID sectorID, ezDynamicArray<ezNavmeshTriangle>& ref_triangles, ezDataBuffer& out_navmeshData) const;
+
+  /// \brief Queues the result of BuildSector() for FinalizeSectorUpdates(). Can be called from any thread.
+  void FinishSectorBuild(SectorID sectorID, ezDataBuffer&& navmeshData);
 
   const dtNavMesh* GetDetourNavMesh() const { return m_pNavMesh; }
 
@@ -121,6 +154,7 @@ public:
   const ezAiNavmeshConfig& GetConfig() const { return m_NavmeshConfig; }
 
 private:
+  void UnloadSector(ezAiNavMeshSector& ref_sector);
   void DebugDrawSector(ezDebugRendererContext context, const ezAiNavigationConfig& config, int iTileIdx);
 
   ezAiNavmeshConfig m_NavmeshConfig;
@@ -134,8 +168,17 @@ private:
   ezMap<SectorID, ezAiNavMeshSector> m_Sectors;
   ezDeque<SectorID> m_RequestedSectors;
 
+  struct FinishedSector
+  {
+    SectorID m_SectorID = ezInvalidIndex;
+    ezDataBuffer m_NavmeshData;
+  };
+
   ezMutex m_Mutex;
-  ezDynamicArray<SectorID> m_UpdatingSectors;
+  ezDynamicArray<FinishedSector> m_FinishedSectors;
 
   ezDynamicArray<SectorID> m_UnloadingSectors;
+
+  ezUInt32 m_uiUpdateCounter = 1;
+  ezUInt64 m_uiLoadedSectorMemory = 0;
 };
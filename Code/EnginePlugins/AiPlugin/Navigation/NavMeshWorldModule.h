@@ -10,6 +10,11 @@ class dtNavMesh;
 /// This world module keeps track of all the configured navmeshes (for different character types)
 /// and makes sure to build their sectors in the background.
 ///
+/// Multiple sectors are built in parallel (see the CVar 'AI.Navmesh.MaxConcurrentSectors'). Each generation task works on its
+/// own snapshot of the physics geometry, which is retrieved on the main thread when the task is started.
+/// Sectors that have not been used for a while are unloaded again, once the navmesh exceeds its memory budget
+/// (see the CVar 'AI.Navmesh.MemoryBudget').
+///
 /// Through this you can get access to one of the available navmeshes.
 /// Additionally, it also provides access to the different path search filters.
 class EZ_AIPLUGIN_DLL ezAiNavMeshWorldModule final : public ezWorldModule
@@ -36,10 +41,19 @@ private:
 
   ezMap<ezString, ezAiNavMesh*> m_WorldNavMeshes;
 
+  void StartSectorGeneration(const ezNavmeshGeoWorldModuleInterface* pNavGeo);
+
   // TODO: this is a hacky solution to delay the navmesh generation until after Physics has been set up.
   ezUInt32 m_uiUpdateDelay = 10;
-  ezTaskGroupID m_GenerateSectorTaskID;
-  ezSharedPtr<ezNavMeshSectorGenerationTask> m_pGenerateSectorTask;
+
+  struct SectorGenerationTask
+  {
+    ezTaskGroupID m_TaskID;
+    ezSharedPtr<ezNavMeshSectorGenerationTask> m_pTask;
+  };
+
+  ezDynamicArray<SectorGenerationTask> m_GenerateSectorTasks;
+  ezUInt32 m_uiNextNavMeshToGenerate = 0;
 
   ezAiNavigationConfig m_Config;
 
@@ -53,10 +67,7 @@ Navmesh Generation
 
 * fix navmesh on hills
 * collision group filtering
-* invalidate sectors, re-generate
 * Invalidate path searches after sector changes
-* sector usage tracking
-* unload unused sectors
 
 Path Search
 ===========
@@ -4,8 +4,10 @@
 #include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/GlobalEvent.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
 #include <Foundation/Types/ScopeExit.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
@@ -71,6 +73,8 @@ void ezFileserveClient::ClearState()
 {
   m_bDownloading = false;
   m_bWaitingForUploadFinished = false;
+  m_bServerProtocolVersionKnown = false;
+  m_uiServerProtocolVersion = 0;
   m_CurFileRequestGuid = ezUuid();
   m_sCurFileRequest.Clear();
   m_Download.Clear();
@@ -126,7 +130,10 @@ ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
       ezLog::Success("Connected to ezFileserver '{0}", m_sServerConnectionAddress);
       m_pNetwork->SetMessageHandler('FSRV', ezMakeDelegate(&ezFileserveClient::NetworkMsgHandler, this));
 
-      m_pNetwork->Send('FSRV', 'HELO'); // be friendly
+      // be friendly, and tell the server which protocol version we speak, newer servers answer with their own version
+      ezRemoteMessage msg('FSRV', 'HELO');
+      msg.GetWriter() << ezFileserveProtocolVersion;
+      m_pNetwork->Send(ezRemoteTransmitMode::Reliable, msg);
     }
 
     m_bFailedToConnect = false;
@@ -137,7 +144,12 @@ ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
 
 void ezFileserveClient::UpdateClient()
 {
-  EZ_LOCK(m_Mutex);
+  // if another thread is currently downloading, it processes all incoming messages anyway, no need to block until it is done
+  if (m_Mutex.TryLock().Failed())
+    return;
+
+  EZ_SCOPE_EXIT(m_Mutex.Unlock());
+
   if (m_pNetwork == nullptr || m_bFailedToConnect || !s_bEnableFileserve)
     return;
 
@@ -347,6 +359,25 @@ void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'VERS')
+  {
+    msg.GetReader() >> m_uiServerProtocolVersion;
+    m_bServerProtocolVersionKnown = true;
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PFST')
+  {
+    HandlePrefetchFileStateMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PFDL')
+  {
+    HandlePrefetchFileTransferMsg(msg);
+    return;
+  }
+
   static bool s_bReloadResources = false;
 
   if (msg.GetMessageID() == 'RLDR')
@@ -514,13 +545,20 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   ezUInt16 uiFoundInDataDir = 0;
   msg.GetReader() >> uiFoundInDataDir;
 
-  if (uiFoundInDataDir == 0xffff)         // file does not exist on server in any data dir
+  ApplyFileState(m_sCurFileRequest, fileState, iFileTimeStamp, uiFileHash, uiFoundInDataDir, m_Download);
+}
+
+void ezFileserveClient::ApplyFileState(const ezString& sFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash, ezUInt16 uiFoundInDataDir, ezArrayPtr<const ezUInt8> fileContent)
+{
+  EZ_LOCK(m_Mutex);
+
+  if (uiFoundInDataDir == 0xffff) // file does not exist on server in any data dir
   {
-    m_FileDataDir[m_sCurFileRequest] = 0; // placeholder
+    m_FileDataDir[sFile] = 0;     // placeholder
 
     for (ezUInt32 i = 0; i < m_MountedDataDirs.GetCount(); ++i)
     {
-      auto& ref = m_MountedDataDirs[i].m_CacheStatus[m_sCurFileRequest];
+      auto& ref = m_MountedDataDirs[i].m_CacheStatus[sFile];
       ref.m_FileHash = 0;
       ref.m_TimeStamp = 0;
       ref.m_LastCheck = m_CurrentTime;
@@ -530,9 +568,9 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   }
   else
   {
-    m_FileDataDir[m_sCurFileRequest] = uiFoundInDataDir;
+    m_FileDataDir[sFile] = uiFoundInDataDir;
 
-    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[m_sCurFileRequest];
+    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[sFile];
     ref.m_FileHash = uiFileHash;
     ref.m_TimeStamp = iFileTimeStamp;
     ref.m_LastCheck = m_CurrentTime;
@@ -544,7 +582,7 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 
   const ezString& sMountPoint = m_MountedDataDirs[uiFoundInDataDir].m_sMountPoint;
   ezStringBuilder sCachedFile, sCachedMetaFile;
-  BuildPathInCache(m_sCurFileRequest, sMountPoint, &sCachedFile, &sCachedMetaFile);
+  BuildPathInCache(sFile, sMountPoint, &sCachedFile, &sCachedMetaFile);
 
   if (fileState == ezFileserveFileState::NonExistant)
   {
@@ -562,7 +600,7 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 
   if (fileState == ezFileserveFileState::Different)
   {
-    WriteDownloadToDisk(sCachedFile);
+    WriteDownloadToDisk(sCachedFile, fileContent);
     WriteMetaFile(sCachedMetaFile, iFileTimeStamp, uiFileHash);
   }
 }
@@ -584,14 +622,13 @@ void ezFileserveClient::WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 i
   }
 }
 
-void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile)
+void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile, ezArrayPtr<const ezUInt8> fileContent)
 {
-  EZ_LOCK(m_Mutex);
   ezOSFile file;
   if (file.Open(sCachedFile, ezFileOpenMode::Write).Succeeded())
   {
-    if (!m_Download.IsEmpty())
-      file.Write(m_Download.GetData(), m_Download.GetCount()).IgnoreResult();
+    if (!fileContent.IsEmpty())
+      file.Write(fileContent.GetPtr(), fileContent.GetCount()).IgnoreResult();
 
     file.Close();
   }
@@ -689,6 +726,243 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   }
 }
 
+bool ezFileserveClient::IsPrefetchingSupported()
+{
+  EZ_LOCK(m_Mutex);
+  if (m_pNetwork == nullptr || !m_pNetwork->IsConnectedToServer())
+    return false;
+
+  if (!m_bServerProtocolVersionKnown)
+  {
+    // the server answers 'HELO' right away, so if it hasn't done so after a while, it is an older version that never will
+    const ezTime tStart = ezTime::Now();
+    while (!m_bServerProtocolVersionKnown && ezTime::Now() - tStart < ezTime::MakeFromSeconds(2) && m_pNetwork->IsConnectedToServer())
+    {
+      m_pNetwork->UpdateRemoteInterface();
+      if (m_pNetwork->ExecuteAllMessageHandlers() == 0)
+      {
+        ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+      }
+    }
+
+    if (!m_bServerProtocolVersionKnown)
+    {
+      ezLog::Warning("Fileserver did not report its protocol version, it is probably outdated. File prefetching is disabled.");
+      m_bServerProtocolVersionKnown = true;
+      m_uiServerProtocolVersion = 0;
+    }
+  }
+
+  // version 1 introduced 'PFCH'
+  return m_uiServerProtocolVersion >= 1;
+}
+
+void ezFileserveClient::PrefetchFiles(ezUInt16 uiDataDirID, ezArrayPtr<const ezString> files, bool bForceThisDataDir)
+{
+  if (files.IsEmpty() || !IsPrefetchingSupported())
+    return;
+
+  // the mutex is held while waiting for the server, so only request a limited number of files at a time,
+  // that gives other threads, which need to download a file right now, a chance to get their turn in between
+  constexpr ezUInt32 uiMaxFilesPerBatch = 64;
+  for (ezUInt32 uiFirstFile = 0; uiFirstFile < files.GetCount(); uiFirstFile += uiMaxFilesPerBatch)
+  {
+    const ezUInt32 uiNumFiles = ezMath::Min(uiMaxFilesPerBatch, files.GetCount() - uiFirstFile);
+    PrefetchFileBatch(uiDataDirID, files.GetSubArray(uiFirstFile, uiNumFiles), bForceThisDataDir);
+  }
+}
+
+void ezFileserveClient::PrefetchFileBatch(ezUInt16 uiDataDirID, ezArrayPtr<const ezString> files, bool bForceThisDataDir)
+{
+  EZ_LOCK(m_Mutex);
+  if (m_bDownloading)
+    return;
+
+  EZ_ASSERT_DEV(uiDataDirID < m_MountedDataDirs.GetCount(), "Invalid data dir index {0}", uiDataDirID);
+  EZ_ASSERT_DEV(m_MountedDataDirs[uiDataDirID].m_bMounted, "Data directory {0} is not mounted", uiDataDirID);
+
+  if (m_pNetwork == nullptr || !m_pNetwork->IsConnectedToServer())
+    return;
+
+  m_Prefetch.m_Files.Clear();
+  m_Prefetch.m_uiNumFinishedFiles = 0;
+
+  for (const ezString& sFile : files)
+  {
+    bool bCachedYet = false;
+    auto itFileDataDir = m_FileDataDir.FindOrAdd(sFile, &bCachedYet);
+    if (!bCachedYet)
+    {
+      FillFileStatusCache(sFile);
+    }
+
+    const ezUInt16 uiUseDataDirCache = bForceThisDataDir ? uiDataDirID : itFileDataDir.Value();
+    const FileCacheStatus& CacheStatus = m_MountedDataDirs[uiUseDataDirCache].m_CacheStatus[sFile];
+
+    // same rule as in DownloadFile(), no need to ask the server again
+    if (m_CurrentTime - CacheStatus.m_LastCheck < ezTime::MakeFromSeconds(5.0f))
+      continue;
+
+    auto& file = m_Prefetch.m_Files.ExpandAndGetRef();
+    file.m_sFile = sFile;
+    file.m_uiDataDirID = uiUseDataDirCache;
+    file.m_iTimeStamp = CacheStatus.m_TimeStamp;
+    file.m_uiFileHash = CacheStatus.m_FileHash;
+  }
+
+  if (m_Prefetch.m_Files.IsEmpty())
+    return;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  const bool bAcceptCompressed = true;
+#else
+  const bool bAcceptCompressed = false;
+#endif
+
+  m_Prefetch.m_Guid = ezUuid::MakeUuid();
+  m_bDownloading = true;
+
+  // all requests are sent right away, the server answers them one after the other without waiting for the client
+  constexpr ezUInt32 uiMaxFilesPerMessage = 256;
+  for (ezUInt32 uiFirstFile = 0; uiFirstFile < m_Prefetch.m_Files.GetCount(); uiFirstFile += uiMaxFilesPerMessage)
+  {
+    const ezUInt32 uiNumFiles = ezMath::Min(uiMaxFilesPerMessage, m_Prefetch.m_Files.GetCount() - uiFirstFile);
+
+    ezRemoteMessage msg('FSRV', 'PFCH');
+    msg.GetWriter() << m_Prefetch.m_Guid;
+    msg.GetWriter() << bAcceptCompressed;
+    msg.GetWriter() << uiFirstFile;
+    msg.GetWriter() << uiNumFiles;
+
+    for (ezUInt32 i = uiFirstFile; i < uiFirstFile + uiNumFiles; ++i)
+    {
+      const auto& file = m_Prefetch.m_Files[i];
+      msg.GetWriter() << file.m_uiDataDirID;
+      msg.GetWriter() << bForceThisDataDir;
+      msg.GetWriter() << file.m_sFile;
+      msg.GetWriter() << file.m_iTimeStamp;
+      msg.GetWriter() << file.m_uiFileHash;
+    }
+
+    m_pNetwork->Send(ezRemoteTransmitMode::Reliable, msg);
+  }
+
+  while (m_Prefetch.m_uiNumFinishedFiles < m_Prefetch.m_Files.GetCount() && m_pNetwork->IsConnectedToServer())
+  {
+    m_pNetwork->UpdateRemoteInterface();
+    if (m_pNetwork->ExecuteAllMessageHandlers() == 0)
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+  }
+
+  // ignore anything that might still arrive for this request
+  m_Prefetch.m_Guid = ezUuid();
+  m_Prefetch.m_Files.Clear();
+  m_bDownloading = false;
+}
+
+void ezFileserveClient::HandlePrefetchFileStateMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  {
+    ezUuid prefetchGuid;
+    msg.GetReader() >> prefetchGuid;
+
+    if (!m_Prefetch.m_Guid.IsValid() || prefetchGuid != m_Prefetch.m_Guid)
+      return;
+  }
+
+  ezUInt32 uiFile = 0;
+  msg.GetReader() >> uiFile;
+
+  if (uiFile >= m_Prefetch.m_Files.GetCount())
+    return;
+
+  ezInt8 iFileStatus = 0;
+  msg.GetReader() >> iFileStatus;
+  m_Prefetch.m_CurFileState = (ezFileserveFileState)iFileStatus;
+
+  m_Prefetch.m_uiCurFile = uiFile;
+  msg.GetReader() >> m_Prefetch.m_iCurFileTimeStamp;
+  msg.GetReader() >> m_Prefetch.m_uiCurFileHash;
+  msg.GetReader() >> m_Prefetch.m_uiCurFileDataDir;
+  msg.GetReader() >> m_Prefetch.m_uiCurFileSize;
+  msg.GetReader() >> m_Prefetch.m_uiCurTransferSize;
+  msg.GetReader() >> m_Prefetch.m_bCurFileCompressed;
+
+  m_Download.Clear();
+  m_Download.Reserve(m_Prefetch.m_uiCurTransferSize);
+
+  // no content follows
+  if (m_Prefetch.m_uiCurTransferSize == 0)
+  {
+    FinishPrefetchedFile();
+  }
+}
+
+void ezFileserveClient::HandlePrefetchFileTransferMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  {
+    ezUuid prefetchGuid;
+    msg.GetReader() >> prefetchGuid;
+
+    if (!m_Prefetch.m_Guid.IsValid() || prefetchGuid != m_Prefetch.m_Guid)
+      return;
+  }
+
+  ezUInt32 uiChunkSize = 0;
+  msg.GetReader() >> uiChunkSize;
+
+  const ezUInt32 uiStartPos = m_Download.GetCount();
+  m_Download.SetCountUninitialized(uiStartPos + uiChunkSize);
+
+  if (uiChunkSize > 0)
+  {
+    msg.GetReader().ReadBytes(&m_Download[uiStartPos], uiChunkSize);
+  }
+
+  if (m_Download.GetCount() >= m_Prefetch.m_uiCurTransferSize)
+  {
+    FinishPrefetchedFile();
+  }
+}
+
+void ezFileserveClient::FinishPrefetchedFile()
+{
+  EZ_LOCK(m_Mutex);
+  EZ_SCOPE_EXIT(++m_Prefetch.m_uiNumFinishedFiles);
+
+  ezArrayPtr<const ezUInt8> fileContent = m_Download;
+
+  if (m_Prefetch.m_bCurFileCompressed)
+  {
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    m_DecompressedDownload.SetCountUninitialized(m_Prefetch.m_uiCurFileSize);
+
+    ezRawMemoryStreamReader reader(m_Download.GetData(), m_Download.GetCount());
+    ezCompressedStreamReaderZstd decompressor(&reader);
+
+    if (decompressor.ReadBytes(m_DecompressedDownload.GetData(), m_Prefetch.m_uiCurFileSize) != m_Prefetch.m_uiCurFileSize)
+    {
+      // leave the cache status untouched, the file will be requested again, once it is actually read
+      ezLog::Error("Failed to decompress prefetched file '{0}'", m_Prefetch.m_Files[m_Prefetch.m_uiCurFile].m_sFile);
+      return;
+    }
+
+    fileContent = m_DecompressedDownload;
+#else
+    EZ_REPORT_FAILURE("Fileserver sent compressed data, even though it was not requested.");
+    return;
+#endif
+  }
+
+  ApplyFileState(m_Prefetch.m_Files[m_Prefetch.m_uiCurFile].m_sFile, m_Prefetch.m_CurFileState, m_Prefetch.m_iCurFileTimeStamp, m_Prefetch.m_uiCurFileHash, m_Prefetch.m_uiCurFileDataDir, fileContent);
+}
+
 void ezFileserveClient::DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const
 {
   EZ_LOCK(m_Mutex);
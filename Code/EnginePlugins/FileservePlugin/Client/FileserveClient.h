@@ -3,6 +3,7 @@
 #include <FileservePlugin/FileservePluginDLL.h>
 
 #include <Core/Interfaces/RemoteToolingInterface.h>
+#include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/RemoteInterface.h>
 #include <Foundation/Configuration/Singleton.h>
 #include <Foundation/Types/UniquePtr.h>
@@ -66,6 +67,14 @@ public:
   /// Also achieved through the command line argument "-fs_off"
   static void DisabledFileserveClient() { s_bEnableFileserve = false; }
 
+  /// \brief Enables the file serving functionality again.
+  ///
+  /// Creating an ezFileserver disables the client. This is only needed when a client and a server run in the same process, e.g. for testing.
+  static void EnableFileserveClient() { s_bEnableFileserve = true; }
+
+  /// \brief Returns whether the file serving functionality is enabled.
+  static bool IsFileserveClientEnabled() { return s_bEnableFileserve; }
+
   /// \brief Returns the address through which the Fileserve client tried to connect with the server last.
   const char* GetServerConnectionAddress() { return m_sServerConnectionAddress; }
 
@@ -117,9 +126,26 @@ private:
   void NetworkMsgHandler(ezRemoteMessage& msg);
   void HandleFileTransferMsg(ezRemoteMessage& msg);
   void HandleFileTransferFinishedMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFileStateMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFileTransferMsg(ezRemoteMessage& msg);
+  void FinishPrefetchedFile();
+  void ApplyFileState(const ezString& sFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash, ezUInt16 uiFoundInDataDir, ezArrayPtr<const ezUInt8> fileContent);
   static void WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash);
-  void WriteDownloadToDisk(ezStringBuilder sCachedFile);
+  static void WriteDownloadToDisk(ezStringBuilder sCachedFile, ezArrayPtr<const ezUInt8> fileContent);
   ezResult DownloadFile(ezUInt16 uiDataDirID, const char* szFile, bool bForceThisDataDir, ezStringBuilder* out_pFullPath);
+
+  /// \brief Sends the cache status of all given files to the server in one go, and waits until the server has sent back everything that changed.
+  ///
+  /// The server answers the requests back to back without waiting for the client, so this only costs a single round trip.
+  /// Afterwards DownloadFile() can answer from the cache for all these files, without asking the server again.
+  ///
+  /// The files are requested in small batches, so that other threads are not locked out of the client for long.
+  /// Does nothing, if the server is too old to support prefetching.
+  void PrefetchFiles(ezUInt16 uiDataDirID, ezArrayPtr<const ezString> files, bool bForceThisDataDir);
+  void PrefetchFileBatch(ezUInt16 uiDataDirID, ezArrayPtr<const ezString> files, bool bForceThisDataDir);
+
+  /// \brief Checks the protocol version that the server reported, waits for its answer, if necessary.
+  bool IsPrefetchingSupported();
   void DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const;
   void UploadFile(ezUInt16 uiDataDirID, const char* szFile, const ezDynamicArray<ezUInt8>& fileContent);
   void InvalidateFileCache(ezUInt16 uiDataDirID, ezStringView sFile, ezUInt64 uiHash);
@@ -136,13 +162,43 @@ private:
   bool m_bDownloading = false;
   bool m_bFailedToConnect = false;
   bool m_bWaitingForUploadFinished = false;
+  bool m_bServerProtocolVersionKnown = false;
+  ezUInt32 m_uiServerProtocolVersion = 0;
   ezUuid m_CurFileRequestGuid;
   ezStringBuilder m_sCurFileRequest;
   ezUniquePtr<ezRemoteInterface> m_pNetwork;
   ezDynamicArray<ezUInt8> m_Download;
+  ezDynamicArray<ezUInt8> m_DecompressedDownload;
   ezTime m_CurrentTime;
   ezHybridArray<ezString, 4> m_TryServerAddresses;
 
   ezMap<ezString, ezUInt16> m_FileDataDir;
   ezHybridArray<DataDir, 8> m_MountedDataDirs;
+
+  struct PrefetchFile
+  {
+    ezString m_sFile;
+    ezUInt16 m_uiDataDirID = 0;
+    ezInt64 m_iTimeStamp = 0;
+    ezUInt64 m_uiFileHash = 0;
+  };
+
+  struct PrefetchState
+  {
+    ezUuid m_Guid;
+    ezDynamicArray<PrefetchFile> m_Files;
+    ezUInt32 m_uiNumFinishedFiles = 0;
+
+    // the file that the server is currently sending
+    ezUInt32 m_uiCurFile = 0;
+    ezFileserveFileState m_CurFileState = ezFileserveFileState::None;
+    ezInt64 m_iCurFileTimeStamp = 0;
+    ezUInt64 m_uiCurFileHash = 0;
+    ezUInt16 m_uiCurFileDataDir = 0;
+    ezUInt32 m_uiCurFileSize = 0;
+    ezUInt32 m_uiCurTransferSize = 0;
+    bool m_bCurFileCompressed = false;
+  };
+
+  PrefetchState m_Prefetch;
 };
@@ -121,6 +121,33 @@ bool ezDataDirectory::FileserveType::ExistsFile(ezStringView sFile, bool bOneSpe
   return ezFileserveClient::GetSingleton()->DownloadFile(m_uiDataDirID, sRedirected, bOneSpecificDataDir, nullptr).Succeeded();
 }
 
+void ezDataDirectory::FileserveType::PrefetchFiles(ezArrayPtr<const ezString> files, bool bOneSpecificDataDir)
+{
+  ezDynamicArray<ezString> anyDataDirFiles;
+  ezDynamicArray<ezString> thisDataDirFiles;
+
+  ezStringBuilder sRedirected;
+  for (const ezString& sFile : files)
+  {
+    // same filtering as in OpenFileToRead()
+    if (ezPathUtils::IsAbsolutePath(sFile))
+      continue;
+
+    const bool bRedirected = ResolveAssetRedirection(sFile, sRedirected);
+
+    if (ezConversionUtils::IsStringUuid(sRedirected))
+      continue;
+
+    if (bOneSpecificDataDir || bRedirected)
+      thisDataDirFiles.PushBack(sRedirected);
+    else
+      anyDataDirFiles.PushBack(sRedirected);
+  }
+
+  ezFileserveClient::GetSingleton()->PrefetchFiles(m_uiDataDirID, anyDataDirFiles, false);
+  ezFileserveClient::GetSingleton()->PrefetchFiles(m_uiDataDirID, thisDataDirFiles, true);
+}
+
 ezDataDirectoryType* ezDataDirectory::FileserveType::Factory(ezStringView sDataDirectory, ezStringView sGroup, ezStringView sRootName, ezDataDirUsage usage)
 {
   if (!ezFileserveClient::s_bEnableFileserve || ezFileserveClient::GetSingleton() == nullptr)
@@ -48,6 +48,8 @@ namespace ezDataDirectory
     virtual bool ExistsFile(ezStringView sFile, bool bOneSpecificDataDir) override;
     /// \brief Limitation: Fileserve does not handle folders, only files. If someone stats a folder, this will fail.
     virtual ezResult GetFileStats(ezStringView sFileOrFolder, bool bOneSpecificDataDir, ezFileStats& out_Stats) override;
+    /// \brief Downloads all files that changed on the server in one batch.
+    virtual void PrefetchFiles(ezArrayPtr<const ezString> files, bool bOneSpecificDataDir) override;
     virtual FolderReader* CreateFolderReader() const override;
     virtual FolderWriter* CreateFolderWriter() const override;
 
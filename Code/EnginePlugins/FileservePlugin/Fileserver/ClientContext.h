@@ -4,6 +4,11 @@
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Strings/String.h>
 
+/// \brief The version of the fileserve protocol. Clients send it with 'HELO', servers answer with 'VERS'.
+///
+/// Version 0 (no version sent at all) is the original protocol, version 1 added prefetching files ('PFCH').
+constexpr ezUInt32 ezFileserveProtocolVersion = 1;
+
 enum class ezFileserveFileState
 {
   None = 0,
@@ -4,7 +4,9 @@
 #include <FileservePlugin/Fileserver/Fileserver.h>
 #include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Utilities/CommandLineUtils.h>
 
 EZ_IMPLEMENT_SINGLETON(ezFileserver);
@@ -84,7 +86,17 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
   auto& client = DetermineClient(msg);
 
   if (msg.GetMessageID() == 'HELO')
+  {
+    // older clients don't send a protocol version and don't know the answer either
+    if (!msg.GetMessageData().IsEmpty())
+    {
+      ezRemoteMessage ret('FSRV', 'VERS');
+      ret.GetWriter() << ezFileserveProtocolVersion;
+      m_pNetwork->Send(ezRemoteTransmitMode::Reliable, ret);
+    }
+
     return;
+  }
 
   if (msg.GetMessageID() == 'RUTR')
   {
@@ -103,6 +115,12 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PFCH')
+  {
+    HandlePrefetchRequest(client, msg);
+    return;
+  }
+
   if (msg.GetMessageID() == 'UPLH')
   {
     HandleUploadFileHeader(client, msg);
@@ -345,6 +363,130 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
   }
 }
 
+void ezFileserver::HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
+{
+  ezUuid prefetchGuid;
+  msg.GetReader() >> prefetchGuid;
+
+  bool bAcceptCompressed = false;
+  msg.GetReader() >> bAcceptCompressed;
+
+  ezUInt32 uiFirstFile = 0;
+  msg.GetReader() >> uiFirstFile;
+
+  ezUInt32 uiNumFiles = 0;
+  msg.GetReader() >> uiNumFiles;
+
+  ezStringBuilder sRequestedFile;
+
+  // answer all requests back to back, the client only waits once for all of them
+  for (ezUInt32 uiFile = uiFirstFile; uiFile < uiFirstFile + uiNumFiles; ++uiFile)
+  {
+    ezUInt16 uiDataDirID = 0;
+    bool bForceThisDataDir = false;
+
+    msg.GetReader() >> uiDataDirID;
+    msg.GetReader() >> bForceThisDataDir;
+    msg.GetReader() >> sRequestedFile;
+
+    ezFileserveClientContext::FileStatus status;
+    msg.GetReader() >> status.m_iTimestamp;
+    msg.GetReader() >> status.m_uiHash;
+
+    ezFileserverEvent e;
+    e.m_uiClientID = client.m_uiApplicationID;
+    e.m_szPath = sRequestedFile;
+    e.m_uiSentTotal = 0;
+
+    const ezFileserveFileState filestate = client.GetFileStatus(uiDataDirID, sRequestedFile, status, m_SendToClient, bForceThisDataDir);
+
+    {
+      e.m_Type = ezFileserverEvent::Type::FileDownloadRequest;
+      e.m_uiSizeTotal = m_SendToClient.GetCount();
+      e.m_FileState = filestate;
+      m_Events.Broadcast(e);
+    }
+
+    ezArrayPtr<const ezUInt8> transfer;
+    bool bCompressed = false;
+
+    if (filestate == ezFileserveFileState::Different)
+    {
+      transfer = m_SendToClient;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      if (bAcceptCompressed && !m_SendToClient.IsEmpty())
+      {
+        m_CompressedSendToClient.Clear();
+
+        {
+          ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&m_CompressedSendToClient);
+          ezMemoryStreamWriter writer(&storage);
+          ezCompressedStreamWriterZstd compressor(&writer, 0, ezCompressedStreamWriterZstd::Compression::Fastest);
+          compressor.WriteBytes(m_SendToClient.GetData(), m_SendToClient.GetCount()).IgnoreResult();
+          compressor.FinishCompressedStream().IgnoreResult();
+        }
+
+        // already compressed data (textures, audio) often doesn't get any smaller
+        if (m_CompressedSendToClient.GetCount() < m_SendToClient.GetCount())
+        {
+          transfer = m_CompressedSendToClient;
+          bCompressed = true;
+        }
+      }
+#else
+      EZ_IGNORE_UNUSED(bAcceptCompressed);
+#endif
+    }
+
+    {
+      ezRemoteMessage ret('FSRV', 'PFST');
+      ret.GetWriter() << prefetchGuid;
+      ret.GetWriter() << uiFile;
+      ret.GetWriter() << (ezInt8)filestate;
+      ret.GetWriter() << status.m_iTimestamp;
+      ret.GetWriter() << status.m_uiHash;
+      ret.GetWriter() << uiDataDirID;
+      ret.GetWriter() << (filestate == ezFileserveFileState::Different ? m_SendToClient.GetCount() : 0u);
+      ret.GetWriter() << transfer.GetCount();
+      ret.GetWriter() << bCompressed;
+
+      m_pNetwork->Send(ezRemoteTransmitMode::Reliable, ret);
+    }
+
+    // the state message announces the size, so there is no need for a final message
+    // and the chunks can be much larger than for single file requests
+    ezUInt32 uiNextByte = 0;
+    while (uiNextByte < transfer.GetCount())
+    {
+      const ezUInt32 uiChunkSize = ezMath::Min<ezUInt32>(16 * 1024, transfer.GetCount() - uiNextByte);
+
+      ezRemoteMessage ret;
+      ret.GetWriter() << prefetchGuid;
+      ret.GetWriter() << uiChunkSize;
+      ret.GetWriter().WriteBytes(&transfer[uiNextByte], uiChunkSize).IgnoreResult();
+
+      ret.SetMessageID('FSRV', 'PFDL');
+      m_pNetwork->Send(ezRemoteTransmitMode::Reliable, ret);
+
+      uiNextByte += uiChunkSize;
+
+      // reuse previous values
+      {
+        e.m_Type = ezFileserverEvent::Type::FileDownloading;
+        e.m_uiSentTotal = uiNextByte;
+        m_Events.Broadcast(e);
+      }
+    }
+
+    // reuse previous values
+    {
+      e.m_Type = ezFileserverEvent::Type::FileDownloadFinished;
+      m_Events.Broadcast(e);
+    }
+  }
+}
+
 void ezFileserver::HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
 {
   ezUInt16 uiDataDirID = 0xffff;
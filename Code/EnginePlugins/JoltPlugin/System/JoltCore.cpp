@@ -12,6 +12,7 @@
 #include <JoltPlugin/Shapes/Implementation/JoltCustomShapeInfo.h>
 #include <JoltPlugin/System/JoltCore.h>
 #include <JoltPlugin/System/JoltDebugRenderer.h>
+#include <JoltPlugin/System/JoltJobSystem.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <stdarg.h>
 
@@ -34,6 +35,8 @@ EZ_BEGIN_STATIC_REFLECTED_BITFLAGS(ezOnJoltContact, 1)
 EZ_END_STATIC_REFLECTED_BITFLAGS;
 // clang-format on
 
+ezCVarBool cvar_JoltUseTaskSystem("Jolt.UseTaskSystem", true, ezCVarFlags::RequiresRestart, "Run the physics jobs on the ezTaskSystem instead of a separate Jolt thread pool.");
+
 ezJoltMaterial* ezJoltCore::s_pDefaultMaterial = nullptr;
 std::unique_ptr<JPH::JobSystem> ezJoltCore::s_pJobSystem;
 ezUniquePtr<ezProxyAllocator> ezJoltCore::s_pAllocator;
@@ -128,8 +131,14 @@ void ezJoltCore::Startup()
 
   ezJoltCustomShapeInfo::sRegister();
 
-  // TODO: custom job system
-  s_pJobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+  if (cvar_JoltUseTaskSystem)
+  {
+    s_pJobSystem = std::make_unique<ezJoltJobSystem>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+  }
+  else
+  {
+    s_pJobSystem = std::make_unique<JPH::JobSystemThreadPool>(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+  }
 
   s_pDefaultMaterial = new ezJoltMaterial;
   s_pDefaultMaterial->AddRef();
@@ -0,0 +1,140 @@
+#include <JoltPlugin/JoltPluginPCH.h>
+
+#include <Foundation/Containers/SmallArray.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <JoltPlugin/System/JoltJobSystem.h>
+
+/// Executes one or multiple Jolt jobs. Each job has been AddRef'ed when it was queued and is released after it was executed.
+///
+/// The tasks are reused by the job system, SetJobs() is called before every start.
+class ezJoltJobSystem::JobTask final : public ezTask
+{
+public:
+  JobTask(ezJoltJobSystem* pOwner)
+    : m_pOwner(pOwner)
+  {
+    ConfigureTask("Jolt Job", ezTaskNesting::Never);
+  }
+
+  void SetJobs(Job** pJobs, JPH::uint uiNumJobs)
+  {
+    m_Jobs.SetCountUninitialized(static_cast<ezUInt16>(uiNumJobs));
+    ezMemoryUtils::Copy(m_Jobs.GetData(), pJobs, uiNumJobs);
+
+    SetMultiplicity(uiNumJobs > 1 ? uiNumJobs : 0);
+  }
+
+  virtual void Execute() override
+  {
+    RunJob(m_Jobs[0]);
+  }
+
+  virtual void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override
+  {
+    RunJob(m_Jobs[uiInvocation]);
+  }
+
+private:
+  void RunJob(Job* pJob) const
+  {
+    // if a thread that waits on a barrier already executed the job, this does nothing
+    pJob->Execute();
+    pJob->Release();
+
+    m_pOwner->m_iNumQueuedJobs.Decrement();
+  }
+
+  ezJoltJobSystem* m_pOwner = nullptr;
+  ezSmallArray<Job*, 4> m_Jobs;
+};
+
+ezJoltJobSystem::ezJoltJobSystem(ezUInt32 uiMaxJobs, ezUInt32 uiMaxBarriers, ezTaskPriority::Enum priority)
+  : JPH::JobSystemWithBarrier(uiMaxBarriers)
+  , m_TaskPriority(priority)
+{
+  m_Jobs.Init(uiMaxJobs, uiMaxJobs);
+}
+
+ezJoltJobSystem::~ezJoltJobSystem()
+{
+  // tasks for jobs that were executed while waiting on a barrier may still be queued, they reference this job system
+  ezTaskSystem::WaitForCondition([this]()
+    { return m_iNumQueuedJobs == 0; });
+}
+
+int ezJoltJobSystem::GetMaxConcurrency() const
+{
+  // the thread that waits on a barrier executes jobs as well
+  return static_cast<int>(ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks)) + 1;
+}
+
+JPH::JobHandle ezJoltJobSystem::CreateJob(const char* szName, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies)
+{
+  ezUInt32 uiIndex = AvailableJobs::cInvalidObjectIndex;
+  while (true)
+  {
+    uiIndex = m_Jobs.ConstructObject(szName, color, this, jobFunction, uiNumDependencies);
+    if (uiIndex != AvailableJobs::cInvalidObjectIndex)
+      break;
+
+    EZ_REPORT_FAILURE("Jolt job pool exhausted, increase the maximum number of jobs.");
+    ezThreadUtils::YieldTimeSlice();
+  }
+
+  Job* pJob = &m_Jobs.Get(uiIndex);
+
+  // the handle keeps a reference, the job may be finished before this function returns
+  JobHandle handle(pJob);
+
+  if (uiNumDependencies == 0)
+  {
+    QueueJob(pJob);
+  }
+
+  return handle;
+}
+
+void ezJoltJobSystem::QueueJob(Job* pJob)
+{
+  QueueJobs(&pJob, 1);
+}
+
+void ezJoltJobSystem::QueueJobs(Job** pJobs, JPH::uint uiNumJobs)
+{
+  if (uiNumJobs == 0)
+    return;
+
+  for (JPH::uint i = 0; i < uiNumJobs; ++i)
+  {
+    pJobs[i]->AddRef();
+  }
+
+  m_iNumQueuedJobs.Add(static_cast<ezInt32>(uiNumJobs));
+
+  EZ_LOCK(m_TasksMutex);
+
+  ezSharedPtr<JobTask> pTask;
+  for (const ezSharedPtr<JobTask>& pExistingTask : m_Tasks)
+  {
+    if (pExistingTask->IsTaskFinished())
+    {
+      pTask = pExistingTask;
+      break;
+    }
+  }
+
+  // could not find any unused task -> need to create a new one
+  if (pTask == nullptr)
+  {
+    pTask = EZ_DEFAULT_NEW(JobTask, this);
+    m_Tasks.PushBack(pTask);
+  }
+
+  pTask->SetJobs(pJobs, uiNumJobs);
+  ezTaskSystem::StartSingleTask(pTask, m_TaskPriority);
+}
+
+void ezJoltJobSystem::FreeJob(Job* pJob)
+{
+  m_Jobs.DestructObject(pJob);
+}
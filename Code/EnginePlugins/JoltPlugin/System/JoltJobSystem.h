@@ -0,0 +1,50 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Implementation/TaskSystemDeclarations.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Types/SharedPtr.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+#include <JoltPlugin/JoltPluginDLL.h>
+
+/// \brief A JPH::JobSystem that runs Jolt's jobs as ezTasks.
+///
+/// By default Jolt uses its own thread pool, which competes with the ezTaskSystem worker threads for the CPU cores.
+/// This job system schedules all physics jobs on the ezTaskSystem instead, so that physics and game tasks share one scheduler.
+///
+/// Barriers are implemented by JPH::JobSystemWithBarrier. While waiting for a barrier, the waiting thread executes
+/// the jobs of that barrier itself, so waiting on a task system worker thread can't dead-lock.
+class EZ_JOLTPLUGIN_DLL ezJoltJobSystem final : public JPH::JobSystemWithBarrier
+{
+public:
+  /// \param uiMaxJobs Max number of jobs that can be allocated at any time.
+  /// \param uiMaxBarriers Max number of barriers that can be allocated at any time.
+  /// \param priority The priority of the tasks that execute the jobs. Should match the priority of the task that runs the physics update.
+  ezJoltJobSystem(ezUInt32 uiMaxJobs, ezUInt32 uiMaxBarriers, ezTaskPriority::Enum priority = ezTaskPriority::EarlyThisFrame);
+  ~ezJoltJobSystem();
+
+  virtual int GetMaxConcurrency() const override;
+  virtual JobHandle CreateJob(const char* szName, JPH::ColorArg color, const JobFunction& jobFunction, JPH::uint32 uiNumDependencies = 0) override;
+
+protected:
+  virtual void QueueJob(Job* pJob) override;
+  virtual void QueueJobs(Job** pJobs, JPH::uint uiNumJobs) override;
+  virtual void FreeJob(Job* pJob) override;
+
+private:
+  class JobTask;
+
+  using AvailableJobs = JPH::FixedSizeFreeList<Job>;
+  AvailableJobs m_Jobs;
+
+  ezTaskPriority::Enum m_TaskPriority;
+
+  /// Number of jobs that were queued but whose task hasn't run yet. The destructor waits until this is zero.
+  ezAtomicInteger32 m_iNumQueuedJobs;
+
+  /// The tasks are reused once they are finished, so queuing jobs doesn't allocate a new task every time.
+  ezMutex m_TasksMutex;
+  ezDynamicArray<ezSharedPtr<JobTask>> m_Tasks;
+};
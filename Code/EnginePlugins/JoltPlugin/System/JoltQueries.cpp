@@ -1,5 +1,7 @@
 #include <JoltPlugin/JoltPluginPCH.h>
 
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <JoltPlugin/Actors/JoltActorComponent.h>
 #include <JoltPlugin/Resources/JoltMaterial.h>
 #include <JoltPlugin/Shapes/JoltShapeComponent.h>
@@ -7,6 +9,99 @@
 #include <JoltPlugin/Utilities/JoltUserData.h>
 #include <Physics/Collision/CollisionCollectorImpl.h>
 
+namespace
+{
+  /// \brief The query filters only depend on the query parameters.
+  ///
+  /// They are stateless, so batched queries create them once and share them between all queries and worker threads.
+  struct ezJoltQueryFilters
+  {
+    explicit ezJoltQueryFilters(const ezPhysicsQueryParameters& params)
+      : m_BroadphaseFilter(params.m_ShapeTypes)
+      , m_ObjectFilter(params.m_uiCollisionLayer)
+      , m_BodyFilter(params.m_uiIgnoreObjectFilterID)
+    {
+    }
+
+    ezJoltBroadPhaseLayerFilter m_BroadphaseFilter;
+    ezJoltObjectLayerFilter m_ObjectFilter;
+    ezJoltBodyFilter m_BodyFilter;
+  };
+
+  /// \brief Batches with fewer queries than this are executed on the calling thread.
+  constexpr ezUInt32 s_uiMinBatchQueriesPerTask = 32;
+
+  template <typename FUNC>
+  void ExecuteBatchQueries(ezUInt32 uiNumQueries, FUNC func)
+  {
+    ezParallelForParams parallelParams;
+    parallelParams.m_uiBinSize = s_uiMinBatchQueriesPerTask;
+
+    ezTaskSystem::ParallelForIndexed(
+      0u, uiNumQueries, [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          func(i);
+        } },
+      "Jolt Batch Queries", ezTaskNesting::Never, parallelParams);
+  }
+
+  ezUInt32 CountHits(ezArrayPtr<const bool> hits)
+  {
+    ezUInt32 uiNumHits = 0;
+    for (bool bHit : hits)
+    {
+      uiNumHits += bHit ? 1 : 0;
+    }
+
+    return uiNumHits;
+  }
+
+  JPH::Mat44 MakeCapsuleTransform(const ezTransform& transform)
+  {
+    // Jolt capsules are oriented along the Y axis, ours along Z
+    const ezQuat qFixRot = ezQuat::MakeFromAxisAndAngle(ezVec3(1, 0, 0), ezAngle::MakeFromDegree(90.0f));
+    const ezQuat qRot = transform.m_qRotation * qFixRot;
+
+    return JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(qRot), ezJoltConversionUtils::ToVec3(transform.m_vPosition));
+  }
+
+  /// \brief Creates the Jolt shape for a batched query on the stack and passes it to func.
+  template <typename FUNC>
+  bool WithQueryShape(const ezPhysicsQueryShape& shape, const ezTransform& transform, FUNC func)
+  {
+    switch (shape.m_Type)
+    {
+      case ezPhysicsQueryShape::Type::Sphere:
+      {
+        if (shape.m_fRadius <= 0.0f)
+          return false;
+
+        const JPH::SphereShape sphere(shape.m_fRadius);
+        return func(sphere, JPH::Mat44::sTranslation(ezJoltConversionUtils::ToVec3(transform.m_vPosition)));
+      }
+
+      case ezPhysicsQueryShape::Type::Box:
+      {
+        const JPH::BoxShape box(ezJoltConversionUtils::ToVec3(shape.m_vBoxExtents * 0.5f));
+        return func(box, JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(transform.m_qRotation), ezJoltConversionUtils::ToVec3(transform.m_vPosition)));
+      }
+
+      case ezPhysicsQueryShape::Type::Capsule:
+      {
+        if (shape.m_fRadius <= 0.0f)
+          return false;
+
+        const JPH::CapsuleShape capsule(shape.m_fHeight * 0.5f, shape.m_fRadius);
+        return func(capsule, MakeCapsuleTransform(transform));
+      }
+    }
+
+    return false;
+  }
+} // namespace
+
 void FillCastResult(ezPhysicsCastResult& ref_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const JPH::BodyID& bodyId, const JPH::SubShapeID& subShapeId, const JPH::BodyLockInterface& lockInterface, const JPH::BodyInterface& bodyInterface, const ezJoltWorldModule* pModule)
 {
   JPH::BodyLockRead bodyLock(lockInterface, bodyId);
@@ -61,12 +156,12 @@ public:
   }
 };
 
-bool ezJoltWorldModule::Raycast(ezPhysicsCastResult& out_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+static bool CastRay(const JPH::PhysicsSystem& system, const ezJoltQueryFilters& filters, ezPhysicsCastResult& out_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, bool bIgnoreInitialOverlap, ezPhysicsHitCollection collection, const ezJoltWorldModule* pModule)
 {
   if (fDistance <= 0.001f || vDir.IsZero())
     return false;
 
-  const JPH::NarrowPhaseQuery& query = m_pSystem->GetNarrowPhaseQuery();
+  const JPH::NarrowPhaseQuery& query = system.GetNarrowPhaseQuery();
 
   JPH::RRayCast ray;
   ray.mOrigin = ezJoltConversionUtils::ToVec3(vStart);
@@ -75,36 +170,53 @@ bool ezJoltWorldModule::Raycast(ezPhysicsCastResult& out_result, const ezVec3& v
   ezRayCastCollector collector;
   collector.m_bAnyHit = collection == ezPhysicsHitCollection::Any;
 
-  ezJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  ezJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  ezJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
-
-  if (params.m_bIgnoreInitialOverlap)
+  if (bIgnoreInitialOverlap)
   {
     JPH::RayCastSettings opt;
     opt.mBackFaceModeTriangles = JPH::EBackFaceMode::IgnoreBackFaces;
     opt.mBackFaceModeConvex = JPH::EBackFaceMode::IgnoreBackFaces;
     opt.mTreatConvexAsSolid = false;
 
-    query.CastRay(ray, opt, collector, broadphaseFilter, objectFilter, bodyFilter);
+    query.CastRay(ray, opt, collector, filters.m_BroadphaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
 
     if (collector.m_bFoundAny == false)
       return false;
   }
   else
   {
-    if (!query.CastRay(ray, collector.m_Result, broadphaseFilter, objectFilter, bodyFilter))
+    if (!query.CastRay(ray, collector.m_Result, filters.m_BroadphaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter))
       return false;
   }
 
   out_result.m_fDistance = collector.m_Result.mFraction * fDistance;
   out_result.m_vPosition = vStart + fDistance * collector.m_Result.mFraction * vDir;
 
-  FillCastResult(out_result, vStart, vDir, fDistance, collector.m_Result.mBodyID, collector.m_Result.mSubShapeID2, m_pSystem->GetBodyLockInterfaceNoLock(), m_pSystem->GetBodyInterfaceNoLock(), this);
+  FillCastResult(out_result, vStart, vDir, fDistance, collector.m_Result.mBodyID, collector.m_Result.mSubShapeID2, system.GetBodyLockInterfaceNoLock(), system.GetBodyInterfaceNoLock(), pModule);
 
   return true;
 }
 
+bool ezJoltWorldModule::Raycast(ezPhysicsCastResult& out_result, const ezVec3& vStart, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection /*= ezPhysicsHitCollection::Closest*/) const
+{
+  return CastRay(*m_pSystem, ezJoltQueryFilters(params), out_result, vStart, vDir, fDistance, params.m_bIgnoreInitialOverlap, collection, this);
+}
+
+ezUInt32 ezJoltWorldModule::RaycastBatch(ezArrayPtr<const ezPhysicsRaycastQuery> queries, ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == queries.GetCount() && out_hits.GetCount() == queries.GetCount(), "Result arrays must have the same size as the query array");
+  EZ_PROFILE_SCOPE("RaycastBatch");
+
+  const ezJoltQueryFilters filters(params);
+
+  ExecuteBatchQueries(queries.GetCount(), [&](ezUInt32 i)
+    {
+      const ezPhysicsRaycastQuery& query = queries[i];
+      out_hits[i] = CastRay(*m_pSystem, filters, out_results[i], query.m_vStart, query.m_vDir, query.m_fDistance, params.m_bIgnoreInitialOverlap, collection, this);
+    });
+
+  return CountHits(out_hits);
+}
+
 class ezRayCastCollectorAll : public JPH::CastRayCollector
 {
 public:
@@ -210,31 +322,21 @@ bool ezJoltWorldModule::SweepTestCapsule(ezPhysicsCastResult& out_result, float
 
   const JPH::CapsuleShape shape(fCapsuleHeight * 0.5f, fCapsuleRadius);
 
-  ezQuat qFixRot = ezQuat::MakeFromAxisAndAngle(ezVec3(1, 0, 0), ezAngle::MakeFromDegree(90.0f));
-
-  ezQuat qRot;
-  qRot = transform.m_qRotation;
-  qRot = qRot * qFixRot;
-
-  const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(qRot), ezJoltConversionUtils::ToVec3(transform.m_vPosition));
+  const JPH::Mat44 trans = MakeCapsuleTransform(transform);
 
   return SweepTest(out_result, shape, trans, vDir, fDistance, params, collection);
 }
 
-bool ezJoltWorldModule::SweepTest(ezPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
+static bool CastShape(const JPH::PhysicsSystem& system, const ezJoltQueryFilters& filters, ezPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const ezVec3& vDir, float fDistance, ezPhysicsHitCollection collection, const ezJoltWorldModule* pModule)
 {
-  const JPH::NarrowPhaseQuery& query = m_pSystem->GetNarrowPhaseQuery();
-
-  ezJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  ezJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  ezJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
+  const JPH::NarrowPhaseQuery& query = system.GetNarrowPhaseQuery();
 
   JPH::RShapeCast cast(&shape, JPH::Vec3(1, 1, 1), transform, ezJoltConversionUtils::ToVec3(vDir * fDistance));
 
   ezJoltShapeCastCollector collector;
   collector.m_bAnyHit = collection == ezPhysicsHitCollection::Any;
 
-  query.CastShape(cast, {}, JPH::RVec3::sZero(), collector, broadphaseFilter, objectFilter, bodyFilter);
+  query.CastShape(cast, {}, JPH::RVec3::sZero(), collector, filters.m_BroadphaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
 
   if (!collector.m_bFoundAny)
     return false;
@@ -244,11 +346,33 @@ bool ezJoltWorldModule::SweepTest(ezPhysicsCastResult& out_Result, const JPH::Sh
   out_Result.m_fDistance = res.mFraction * fDistance;
   out_Result.m_vPosition = ezJoltConversionUtils::ToVec3(res.mContactPointOn2);
 
-  FillCastResult(out_Result, ezJoltConversionUtils::ToVec3(transform.GetTranslation()), vDir, fDistance, res.mBodyID2, res.mSubShapeID2, m_pSystem->GetBodyLockInterfaceNoLock(), m_pSystem->GetBodyInterfaceNoLock(), this);
+  FillCastResult(out_Result, ezJoltConversionUtils::ToVec3(transform.GetTranslation()), vDir, fDistance, res.mBodyID2, res.mSubShapeID2, system.GetBodyLockInterfaceNoLock(), system.GetBodyInterfaceNoLock(), pModule);
 
   return true;
 }
 
+bool ezJoltWorldModule::SweepTest(ezPhysicsCastResult& out_Result, const JPH::Shape& shape, const JPH::Mat44& transform, const ezVec3& vDir, float fDistance, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
+{
+  return CastShape(*m_pSystem, ezJoltQueryFilters(params), out_Result, shape, transform, vDir, fDistance, collection, this);
+}
+
+ezUInt32 ezJoltWorldModule::SweepBatch(ezArrayPtr<const ezPhysicsSweepQuery> queries, ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection) const
+{
+  EZ_ASSERT_DEV(out_results.GetCount() == queries.GetCount() && out_hits.GetCount() == queries.GetCount(), "Result arrays must have the same size as the query array");
+  EZ_PROFILE_SCOPE("SweepBatch");
+
+  const ezJoltQueryFilters filters(params);
+
+  ExecuteBatchQueries(queries.GetCount(), [&](ezUInt32 i)
+    {
+      const ezPhysicsSweepQuery& query = queries[i];
+      out_hits[i] = WithQueryShape(query.m_Shape, query.m_Transform, [&](const JPH::Shape& shape, const JPH::Mat44& transform)
+        { return CastShape(*m_pSystem, filters, out_results[i], shape, transform, query.m_vDir, query.m_fDistance, collection, this); });
+    });
+
+  return CountHits(out_hits);
+}
+
 class ezJoltShapeCollectorAny : public JPH::CollideShapeCollector
 {
 public:
@@ -294,29 +418,41 @@ bool ezJoltWorldModule::OverlapTestCapsule(float fCapsuleRadius, float fCapsuleH
 
   const JPH::CapsuleShape shape(fCapsuleHeight * 0.5f, fCapsuleRadius);
 
-  ezQuat qFixRot = ezQuat::MakeFromAxisAndAngle(ezVec3(1, 0, 0), ezAngle::MakeFromDegree(90.0f));
+  const JPH::Mat44 trans = MakeCapsuleTransform(transform);
 
-  ezQuat qRot;
-  qRot = transform.m_qRotation;
-  qRot = qRot * qFixRot;
+  return OverlapTest(shape, trans, params);
+}
+
+static bool CollideShapeAny(const JPH::PhysicsSystem& system, const ezJoltQueryFilters& filters, const JPH::Shape& shape, const JPH::Mat44& transform)
+{
+  const JPH::NarrowPhaseQuery& query = system.GetNarrowPhaseQuery();
 
-  const JPH::Mat44 trans = JPH::Mat44::sRotationTranslation(ezJoltConversionUtils::ToQuat(qRot), ezJoltConversionUtils::ToVec3(transform.m_vPosition));
+  ezJoltShapeCollectorAny collector;
+  query.CollideShape(&shape, JPH::Vec3(1, 1, 1), transform, {}, JPH::RVec3::sZero(), collector, filters.m_BroadphaseFilter, filters.m_ObjectFilter, filters.m_BodyFilter);
 
-  return OverlapTest(shape, trans, params);
+  return collector.m_bFoundAny;
 }
 
 bool ezJoltWorldModule::OverlapTest(const JPH::Shape& shape, const JPH::Mat44& transform, const ezPhysicsQueryParameters& params) const
 {
-  const JPH::NarrowPhaseQuery& query = m_pSystem->GetNarrowPhaseQuery();
+  return CollideShapeAny(*m_pSystem, ezJoltQueryFilters(params), shape, transform);
+}
 
-  ezJoltBroadPhaseLayerFilter broadphaseFilter(params.m_ShapeTypes);
-  ezJoltBodyFilter bodyFilter(params.m_uiIgnoreObjectFilterID);
-  ezJoltObjectLayerFilter objectFilter(params.m_uiCollisionLayer);
+ezUInt32 ezJoltWorldModule::OverlapBatch(ezArrayPtr<const ezPhysicsOverlapQuery> queries, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params) const
+{
+  EZ_ASSERT_DEV(out_hits.GetCount() == queries.GetCount(), "Result array must have the same size as the query array");
+  EZ_PROFILE_SCOPE("OverlapBatch");
 
-  ezJoltShapeCollectorAny collector;
-  query.CollideShape(&shape, JPH::Vec3(1, 1, 1), transform, {}, JPH::RVec3::sZero(), collector, broadphaseFilter, objectFilter, bodyFilter);
+  const ezJoltQueryFilters filters(params);
 
-  return collector.m_bFoundAny;
+  ExecuteBatchQueries(queries.GetCount(), [&](ezUInt32 i)
+    {
+      const ezPhysicsOverlapQuery& query = queries[i];
+      out_hits[i] = WithQueryShape(query.m_Shape, query.m_Transform, [&](const JPH::Shape& shape, const JPH::Mat44& transform)
+        { return CollideShapeAny(*m_pSystem, filters, shape, transform); });
+    });
+
+  return CountHits(out_hits);
 }
 
 void ezJoltWorldModule::QueryShapesInSphere(ezPhysicsOverlapResultArray& out_results, float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const
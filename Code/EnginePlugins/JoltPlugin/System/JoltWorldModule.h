@@ -74,6 +74,12 @@ public:
 
   virtual void QueryShapesInSphere(ezPhysicsOverlapResultArray& out_results, float fSphereRadius, const ezVec3& vPosition, const ezPhysicsQueryParameters& params) const override;
 
+  virtual ezUInt32 RaycastBatch(ezArrayPtr<const ezPhysicsRaycastQuery> queries, ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const override;
+
+  virtual ezUInt32 SweepBatch(ezArrayPtr<const ezPhysicsSweepQuery> queries, ezArrayPtr<ezPhysicsCastResult> out_results, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params, ezPhysicsHitCollection collection = ezPhysicsHitCollection::Closest) const override;
+
+  virtual ezUInt32 OverlapBatch(ezArrayPtr<const ezPhysicsOverlapQuery> queries, ezArrayPtr<bool> out_hits, const ezPhysicsQueryParameters& params) const override;
+
   virtual void AddStaticCollisionBox(ezGameObject* pObject, ezVec3 vBoxSize) override;
 
   virtual void AddFixedJointComponent(ezGameObject* pOwner, const ezPhysicsWorldModuleInterface::FixedJointConfig& cfg) override;
@@ -1,5 +1,6 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
+#include <Foundation/DataProcessing/Stream/ProcessingStreamBatchIterator.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Math/Color16f.h>
 #include <Foundation/Profiling/Profiling.h>
@@ -154,69 +155,64 @@ void ezParticleBehavior_ColorGradient::Process(ezUInt64 uiNumElements)
 
   const ezColorGradient& gradient = pGradient->GetDescriptor().m_Gradient;
 
-  ezProcessingStreamIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumElements, 0);
+  // only every n-th particle is updated each frame, since sampling the color gradient is pretty expensive
+  // the particles that are updated are processed in blocks, the gradient itself is sampled per particle
+  const ezUInt64 uiNumToUpdate = uiNumElements > m_uiFirstToUpdate ? uiNumElements - m_uiFirstToUpdate : 0;
 
-  // skip the first n particles
-  itColor.Advance(m_uiFirstToUpdate);
+  const ezSimdVec4f vTint = ezSimdConversion::ToVec4(m_TintColor.GetAsVec4());
 
-  if (m_GradientMode == ezParticleColorGradientMode::Age)
+  ezProcessingStreamBatchIterator<ezColorLinear16f> itColor(m_pStreamColor, uiNumToUpdate, m_uiFirstToUpdate, m_uiCurrentUpdateInterval);
+
+  auto EvaluateBlock = [&](const ezSimdVec4f& vPosX)
   {
-    ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
+    float fPosX[4];
+    vPosX.Store<4>(fPosX);
+
+    for (ezUInt32 i = 0; i < itColor.GetNumElements(); ++i)
+    {
+      ezColor rgba;
+      ezUInt8 alpha;
+      gradient.EvaluateColor(fPosX[i], rgba);
+      gradient.EvaluateAlpha(fPosX[i], alpha);
+      rgba.a = ezMath::ColorByteToFloat(alpha);
+
+      ezProcessingStreamBatch::StoreColor(itColor, i, ezSimdConversion::ToVec4(rgba.GetAsVec4()).CompMul(vTint));
+    }
+  };
 
-    // skip the first n particles
-    itLifeTime.Advance(m_uiFirstToUpdate);
+  if (m_GradientMode == ezParticleColorGradientMode::Age)
+  {
+    ezProcessingStreamBatchIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumToUpdate, m_uiFirstToUpdate, m_uiCurrentUpdateInterval);
 
     while (!itLifeTime.HasReachedEnd())
     {
-      // if (itLifeTime.Current().y > 0)
-      {
-        const float fLifeTimeFraction = itLifeTime.Current().x * itLifeTime.Current().y;
-        const float posx = 1.0f - fLifeTimeFraction;
-
-        ezColor rgba;
-        ezUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = ezMath::ColorByteToFloat(alpha);
-
-        itColor.Current() = rgba * m_TintColor;
-      }
-
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itLifeTime.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
+      ezSimdVec4f vLifeTime, vInvMaxLifeTime;
+      ezProcessingStreamBatch::Load(itLifeTime, vLifeTime, vInvMaxLifeTime);
+
+      EvaluateBlock(ezSimdVec4f(1.0f) - vLifeTime.CompMul(vInvMaxLifeTime));
+
+      itLifeTime.Advance();
+      itColor.Advance();
     }
   }
   else if (m_GradientMode == ezParticleColorGradientMode::Speed)
   {
-    ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+    ezProcessingStreamBatchIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumToUpdate, m_uiFirstToUpdate, m_uiCurrentUpdateInterval);
 
-    // skip the first n particles
-    itVelocity.Advance(m_uiFirstToUpdate);
+    const ezSimdFloat fMaxSpeed = m_fMaxSpeed;
 
     while (!itVelocity.HasReachedEnd())
     {
-      // if (itLifeTime.Current().y > 0)
-      {
-        const float fSpeed = itVelocity.Current().GetLength();
-        const float posx = fSpeed / m_fMaxSpeed; // no need to clamp the range, the color lookup will already do that
-
-        ezColor rgba;
-        ezUInt8 alpha;
-        gradient.EvaluateColor(posx, rgba);
-        gradient.EvaluateAlpha(posx, alpha);
-        rgba.a = ezMath::ColorByteToFloat(alpha);
-
-        itColor.Current() = rgba * m_TintColor;
-      }
-
-      // skip the next n items
-      // this is to reduce the number of particles that need to be fully evaluated,
-      // since sampling the color gradient is pretty expensive
-      itVelocity.Advance(m_uiCurrentUpdateInterval);
-      itColor.Advance(m_uiCurrentUpdateInterval);
+      ezSimdVec4f x, y, z;
+      ezProcessingStreamBatch::Load(itVelocity, x, y, z);
+
+      const ezSimdVec4f vSpeed = (x.CompMul(x) + y.CompMul(y) + z.CompMul(z)).GetSqrt();
+
+      // no need to clamp the range, the color lookup will already do that
+      EvaluateBlock(vSpeed / fMaxSpeed);
+
+      itVelocity.Advance();
+      itColor.Advance();
     }
   }
 
@@ -3,7 +3,7 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/World/World.h>
 #include <Core/World/WorldModule.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamBatchIterator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Gravity.h>
@@ -82,11 +82,28 @@ void ezParticleBehavior_Gravity::Process(ezUInt64 uiNumElements)
   const float tDiff = (float)m_TimeDiff.GetSeconds();
   const ezVec3 addGravity = vGravity * m_fGravityFactor * tDiff;
 
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  // full blocks are processed as three registers of interleaved xyz values, so the gravity vector is rotated accordingly
+  const ezSimdVec4f vAdd0 = ezSimdVec4f(addGravity.x, addGravity.y, addGravity.z, addGravity.x);
+  const ezSimdVec4f vAdd1 = ezSimdVec4f(addGravity.y, addGravity.z, addGravity.x, addGravity.y);
+  const ezSimdVec4f vAdd2 = ezSimdVec4f(addGravity.z, addGravity.x, addGravity.y, addGravity.z);
+
+  ezProcessingStreamBatchIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
 
   while (!itVelocity.HasReachedEnd())
   {
-    itVelocity.Current() += addGravity;
+    if (itVelocity.IsContiguous())
+    {
+      ezSimdVec4f v0, v1, v2;
+      ezProcessingStreamBatch::LoadInterleaved(itVelocity, v0, v1, v2);
+      ezProcessingStreamBatch::StoreInterleaved(itVelocity, v0 + vAdd0, v1 + vAdd1, v2 + vAdd2);
+    }
+    else
+    {
+      for (ezUInt32 i = 0; i < itVelocity.GetNumElements(); ++i)
+      {
+        itVelocity.Element(i) += addGravity;
+      }
+    }
 
     itVelocity.Advance();
   }
@@ -2,7 +2,6 @@
 
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Math/Float16.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Raycast.h>
@@ -143,99 +142,118 @@ void ezParticleBehavior_Raycast::Process(ezUInt64 uiNumElements)
 {
   EZ_PROFILE_SCOPE("PFX: Raycast");
 
+  if (m_pPhysicsModule == nullptr)
+    return;
+
   const float tDiff = (float)m_TimeDiff.GetSeconds();
 
-  ezProcessingStreamIterator<ezVec4> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<const ezVec3> itLastPosition(m_pStreamLastPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  ezVec4* pPosition = m_pStreamPosition->GetWritableData<ezVec4>();
+  const ezVec3* pLastPosition = m_pStreamLastPosition->GetData<ezVec3>();
+  ezVec3* pVelocity = m_pStreamVelocity->GetWritableData<ezVec3>();
+  const ezFloat16* pSize = m_pStreamSize != nullptr ? m_pStreamSize->GetData<ezFloat16>() : nullptr;
 
-  ezFloat16 fDummySize = 0.0f;
-  const ezFloat16* pSize = m_pStreamSize != nullptr ? m_pStreamSize->GetData<ezFloat16>() : &fDummySize;
+  // first gather the rays of all particles that moved, then cast them all at once
 
-  ezPhysicsCastResult hitResult;
+  m_Rays.Clear();
+  m_RayParticles.Clear();
 
-  ezUInt32 i = 0;
-  while (!itPosition.HasReachedEnd())
+  for (ezUInt32 i = 0; i < static_cast<ezUInt32>(uiNumElements); ++i)
   {
-    const ezVec3 vLastPos = itLastPosition.Current();
-    const ezVec3 vCurPos = itPosition.Current().GetAsVec3();
+    const ezVec3 vLastPos = pLastPosition[i];
+
+    if (vLastPos.IsZero())
+      continue;
+
+    ezVec3 vDirection = pPosition[i].GetAsVec3() - vLastPos;
+
+    if (vDirection.IsZero(ezMath::DefaultEpsilon<float>()))
+      continue;
+
+    const float fSize = ezMath::Max((pSize != nullptr ? static_cast<float>(pSize[i]) : 0.0f) * m_fSizeFactor, 0.01f);
+    const float fMaxLen = vDirection.GetLengthAndNormalize();
+
+    ezPhysicsRaycastQuery& ray = m_Rays.ExpandAndGetRef();
+    ray.m_vStart = vLastPos;
+    ray.m_vDir = vDirection;
+    ray.m_fDistance = fMaxLen + fSize;
+
+    RayParticle& particle = m_RayParticles.ExpandAndGetRef();
+    particle.m_uiIndex = i;
+    particle.m_fSize = fSize;
+  }
+
+  if (m_Rays.IsEmpty())
+    return;
+
+  m_HitResults.SetCount(m_Rays.GetCount());
+  m_Hits.SetCount(m_Rays.GetCount());
+
+  ezPhysicsQueryParameters query(m_uiCollisionLayer);
+  query.m_ShapeTypes = ezPhysicsShapeType::Static | ezPhysicsShapeType::Dynamic;
+
+  if (m_pPhysicsModule->RaycastBatch(m_Rays, m_HitResults, m_Hits, query) == 0)
+    return;
 
-    if (!vLastPos.IsZero())
+  for (ezUInt32 uiRay = 0; uiRay < m_Rays.GetCount(); ++uiRay)
+  {
+    if (!m_Hits[uiRay])
+      continue;
+
+    const ezUInt32 i = m_RayParticles[uiRay].m_uiIndex;
+    const float fSize = m_RayParticles[uiRay].m_fSize;
+    const ezVec3 vDirection = m_Rays[uiRay].m_vDir;
+    const ezVec3 vCurPos = pPosition[i].GetAsVec3();
+    const ezVec3 vChange = vCurPos - pLastPosition[i];
+    const float fMaxLen = m_Rays[uiRay].m_fDistance - fSize;
+
+    ezPhysicsCastResult& hitResult = m_HitResults[uiRay];
+    hitResult.m_vPosition -= vDirection * fSize;
+    const float fRemainingLen = (vCurPos - hitResult.m_vPosition).GetLength();
+    const float fRemainder = fRemainingLen / fMaxLen;
+
+    if (m_Reaction == ezParticleRaycastHitReaction::Bounce)
     {
-      const ezVec3 vChange = vCurPos - vLastPos;
+      const ezVec3 vTangentDir = vChange - hitResult.m_vNormal * hitResult.m_vNormal.Dot(vChange);
+      const ezVec3 vNormalDir = vTangentDir - vChange;
+
+      const ezVec3 vNewDir = vNormalDir * m_fBounceFactor + vTangentDir * m_fSlideFactor;
 
-      if (!vChange.IsZero(ezMath::DefaultEpsilon<float>()))
+      if (vNewDir.GetLengthSquared() < ezMath::Square(0.01f))
+      {
+        pPosition[i] = hitResult.m_vPosition.GetAsPositionVec4();
+        pVelocity[i].SetZero();
+      }
+      else
       {
-        ezVec3 vDirection = vChange;
-
-        const float fSize = ezMath::Max(*pSize * m_fSizeFactor, 0.01f);
-        const float fMaxLen = vDirection.GetLengthAndNormalize();
-
-        ezPhysicsQueryParameters query(m_uiCollisionLayer);
-        query.m_ShapeTypes = ezPhysicsShapeType::Static | ezPhysicsShapeType::Dynamic;
-
-        if (m_pPhysicsModule != nullptr && m_pPhysicsModule->Raycast(hitResult, vLastPos, vDirection, fMaxLen + fSize, query))
-        {
-          hitResult.m_vPosition -= vDirection * fSize;
-          const float fRemainingLen = (vCurPos - hitResult.m_vPosition).GetLength();
-          const float fRemainder = fRemainingLen / fMaxLen;
-
-          if (m_Reaction == ezParticleRaycastHitReaction::Bounce)
-          {
-            const ezVec3 vTangentDir = vChange - hitResult.m_vNormal * hitResult.m_vNormal.Dot(vChange);
-            const ezVec3 vNormalDir = vTangentDir - vChange;
-
-            const ezVec3 vNewDir = vNormalDir * m_fBounceFactor + vTangentDir * m_fSlideFactor;
-
-            if (vNewDir.GetLengthSquared() < ezMath::Square(0.01f))
-            {
-              itPosition.Current() = hitResult.m_vPosition.GetAsPositionVec4();
-              itVelocity.Current().SetZero();
-            }
-            else
-            {
-              itPosition.Current() = (hitResult.m_vPosition + vNewDir * fRemainder).GetAsVec4(0);
-              itVelocity.Current() = vNewDir / tDiff;
-            }
-          }
-          else if (m_Reaction == ezParticleRaycastHitReaction::Die)
-          {
-            /// \todo Get current element index from iterator ?
-            m_pStreamGroup->RemoveElement(i);
-          }
-          else if (m_Reaction == ezParticleRaycastHitReaction::Stop)
-          {
-            itPosition.Current() = hitResult.m_vPosition.GetAsPositionVec4();
-            itVelocity.Current().SetZero();
-          }
-
-          if (!m_sOnCollideEvent.IsEmpty())
-          {
-            ezParticleEvent e;
-            e.m_EventType = m_sOnCollideEvent;
-            e.m_vPosition = hitResult.m_vPosition;
-            e.m_vNormal = hitResult.m_vNormal;
-            e.m_vDirection = vDirection;
-
-            GetOwnerEffect()->AddParticleEvent(e);
-          }
-        }
-
-        if constexpr (false)
-        {
-          ezDebugRenderer::DrawLineSphere(m_pPhysicsModule->GetWorld(), ezBoundingSphere::MakeFromCenterAndRadius(itPosition.Current().GetAsVec3(), fSize), ezColor::Red);
-        }
+        pPosition[i] = (hitResult.m_vPosition + vNewDir * fRemainder).GetAsVec4(0);
+        pVelocity[i] = vNewDir / tDiff;
       }
     }
+    else if (m_Reaction == ezParticleRaycastHitReaction::Die)
+    {
+      m_pStreamGroup->RemoveElement(i);
+    }
+    else if (m_Reaction == ezParticleRaycastHitReaction::Stop)
+    {
+      pPosition[i] = hitResult.m_vPosition.GetAsPositionVec4();
+      pVelocity[i].SetZero();
+    }
 
-    itPosition.Advance();
-    itLastPosition.Advance();
-    itVelocity.Advance();
+    if (!m_sOnCollideEvent.IsEmpty())
+    {
+      ezParticleEvent e;
+      e.m_EventType = m_sOnCollideEvent;
+      e.m_vPosition = hitResult.m_vPosition;
+      e.m_vNormal = hitResult.m_vNormal;
+      e.m_vDirection = vDirection;
 
-    if (m_pStreamSize != nullptr)
-      ++pSize;
+      GetOwnerEffect()->AddParticleEvent(e);
+    }
 
-    ++i;
+    if constexpr (false)
+    {
+      ezDebugRenderer::DrawLineSphere(m_pPhysicsModule->GetWorld(), ezBoundingSphere::MakeFromCenterAndRadius(pPosition[i].GetAsVec3(), fSize), ezColor::Red);
+    }
   }
 }
 
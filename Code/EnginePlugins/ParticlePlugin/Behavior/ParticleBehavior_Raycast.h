@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Core/Interfaces/PhysicsQuery.h>
 #include <Foundation/Strings/String.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior.h>
 
@@ -76,4 +77,18 @@ protected:
   ezProcessingStream* m_pStreamLastPosition = nullptr;
   ezProcessingStream* m_pStreamVelocity = nullptr;
   const ezProcessingStream* m_pStreamSize = nullptr;
+
+  struct RayParticle
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiIndex;
+    float m_fSize;
+  };
+
+  // kept across updates to not reallocate the batch every frame
+  ezDynamicArray<ezPhysicsRaycastQuery> m_Rays;
+  ezDynamicArray<RayParticle> m_RayParticles;
+  ezDynamicArray<ezPhysicsCastResult> m_HitResults;
+  ezDynamicArray<bool> m_Hits;
 };
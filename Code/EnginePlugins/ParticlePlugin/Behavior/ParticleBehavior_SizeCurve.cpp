@@ -1,5 +1,6 @@
 #include <ParticlePlugin/ParticlePluginPCH.h>
 
+#include <Foundation/DataProcessing/Stream/ProcessingStreamBatchIterator.h>
 #include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
 #include <Foundation/Math/Float16.h>
 #include <Foundation/Profiling/Profiling.h>
@@ -91,9 +92,6 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
 
   EZ_PROFILE_SCOPE("PFX: Size Curve");
 
-  ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumElements, 0);
-  ezProcessingStreamIterator<ezFloat16> itSize(m_pStreamSize, uiNumElements, 0);
-
   ezResourceLock<ezCurve1DResource> pCurve(m_hCurve, ezResourceAcquireMode::BlockTillLoaded);
 
   if (pCurve.GetAcquireResult() == ezResourceAcquireResult::MissingFallback)
@@ -107,40 +105,43 @@ void ezParticleBehavior_SizeCurve::Process(ezUInt64 uiNumElements)
   double fMinX, fMaxX;
   curve.QueryExtents(fMinX, fMaxX);
 
-  // skip the first n particles
-  {
-    for (ezUInt32 i = 0; i < m_uiFirstToUpdate; ++i)
-    {
-      itLifeTime.Advance();
-      itSize.Advance();
-    }
+  // only every n-th particle is updated each frame, since sampling the curve is expensive
+  const ezUInt32 uiFirstToUpdate = m_uiFirstToUpdate;
+  const ezUInt64 uiNumToUpdate = uiNumElements > uiFirstToUpdate ? uiNumElements - uiFirstToUpdate : 0;
 
-    ++m_uiFirstToUpdate;
-    if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
-      m_uiFirstToUpdate = 0;
-  }
+  ++m_uiFirstToUpdate;
+  if (m_uiFirstToUpdate >= m_uiCurrentUpdateInterval)
+    m_uiFirstToUpdate = 0;
+
+  ezProcessingStreamBatchIterator<ezFloat16Vec2> itLifeTime(m_pStreamLifeTime, uiNumToUpdate, uiFirstToUpdate, m_uiCurrentUpdateInterval);
+  ezProcessingStreamBatchIterator<ezFloat16> itSize(m_pStreamSize, uiNumToUpdate, uiFirstToUpdate, m_uiCurrentUpdateInterval);
+
+  const ezSimdFloat fBaseSize = m_fBaseSize;
+  const ezSimdFloat fCurveScale = m_fCurveScale;
 
   while (!itLifeTime.HasReachedEnd())
   {
-    // if (itLifeTime.Current().y > 0)
-    {
-      const float fLifeTimeFraction = 1.0f - (itLifeTime.Current().x * itLifeTime.Current().y);
+    ezSimdVec4f vLifeTime, vInvMaxLifeTime;
+    ezProcessingStreamBatch::Load(itLifeTime, vLifeTime, vInvMaxLifeTime);
 
-      const double evalPos = curve.ConvertNormalizedPos(fLifeTimeFraction);
-      double val = curve.Evaluate(evalPos);
-      val = curve.NormalizeValue(val);
-
-      itSize.Current() = m_fBaseSize + (float)val * m_fCurveScale;
-    }
+    float fLifeTimeFraction[4];
+    (ezSimdVec4f(1.0f) - vLifeTime.CompMul(vInvMaxLifeTime)).Store<4>(fLifeTimeFraction);
 
-    // skip the next n items
-    // this is to reduce the number of particles that need to be fully evaluated,
-    // since sampling the curve is expensive
-    for (ezUInt32 i = 0; i < m_uiCurrentUpdateInterval; ++i)
+    float fValues[4] = {};
+    for (ezUInt32 i = 0; i < itLifeTime.GetNumElements(); ++i)
     {
-      itLifeTime.Advance();
-      itSize.Advance();
+      const double evalPos = curve.ConvertNormalizedPos(fLifeTimeFraction[i]);
+      double val = curve.Evaluate(evalPos);
+      fValues[i] = (float)curve.NormalizeValue(val);
     }
+
+    ezSimdVec4f vValues;
+    vValues.Load<4>(fValues);
+
+    ezProcessingStreamBatch::Store(itSize, vValues * fCurveScale + ezSimdVec4f(fBaseSize));
+
+    itLifeTime.Advance();
+    itSize.Advance();
   }
 }
 
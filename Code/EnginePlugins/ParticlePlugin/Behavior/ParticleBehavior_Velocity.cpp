@@ -3,7 +3,7 @@
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/Interfaces/WindWorldModule.h>
 #include <Core/World/World.h>
-#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamBatchIterator.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/Clock.h>
 #include <ParticlePlugin/Behavior/ParticleBehavior_Velocity.h>
@@ -117,34 +117,50 @@ void ezParticleBehavior_Velocity::Process(ezUInt64 uiNumElements)
   const float fFriction = ezMath::Clamp(m_fFriction, 0.0f, 100.0f);
   const float fFrictionFactor = ezMath::Pow(0.5f, tDiff * fFriction);
 
-  ezProcessingStreamIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
-  ezProcessingStreamIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+  const ezSimdFloat fFrictionFactorSimd = fFrictionFactor;
+  const ezSimdFloat fWindFactor = m_fWindInfluence * tDiff;
+  const bool bApplyWind = m_fWindInfluence > 0;
 
-  if (m_fWindInfluence > 0)
+  ezProcessingStreamBatchIterator<ezSimdVec4f> itPosition(m_pStreamPosition, uiNumElements, 0);
+  ezProcessingStreamBatchIterator<ezVec3> itVelocity(m_pStreamVelocity, uiNumElements, 0);
+
+  while (!itPosition.HasReachedEnd())
   {
-    const ezSimdFloat fWindFactor = m_fWindInfluence * tDiff;
+    const ezUInt32 uiNumInBlock = itPosition.GetNumElements();
 
-    while (!itPosition.HasReachedEnd())
+    if (bApplyWind)
     {
-      ezSimdVec4f addPos = vRise + pOwner->GetWindAt(itPosition.Current()) * fWindFactor;
-
-      itPosition.Current() += addPos;
-      itVelocity.Current() *= fFrictionFactor;
-
-      itPosition.Advance();
-      itVelocity.Advance();
+      for (ezUInt32 i = 0; i < uiNumInBlock; ++i)
+      {
+        ezSimdVec4f& vPosition = itPosition.Element(i);
+        vPosition += vRise + pOwner->GetWindAt(vPosition) * fWindFactor;
+      }
     }
-  }
-  else
-  {
-    while (!itPosition.HasReachedEnd())
+    else
     {
-      itPosition.Current() += vRise;
-      itVelocity.Current() *= fFrictionFactor;
+      for (ezUInt32 i = 0; i < uiNumInBlock; ++i)
+      {
+        itPosition.Element(i) += vRise;
+      }
+    }
 
-      itPosition.Advance();
-      itVelocity.Advance();
+    if (itVelocity.IsContiguous())
+    {
+      // friction scales all components uniformly, so there is no need to separate them
+      ezSimdVec4f v0, v1, v2;
+      ezProcessingStreamBatch::LoadInterleaved(itVelocity, v0, v1, v2);
+      ezProcessingStreamBatch::StoreInterleaved(itVelocity, v0 * fFrictionFactorSimd, v1 * fFrictionFactorSimd, v2 * fFrictionFactorSimd);
     }
+    else
+    {
+      for (ezUInt32 i = 0; i < uiNumInBlock; ++i)
+      {
+        itVelocity.Element(i) *= fFrictionFactor;
+      }
+    }
+
+    itPosition.Advance();
+    itVelocity.Advance();
   }
 }
 
@@ -116,59 +116,61 @@ ezUInt32 PlacementTile::PlaceObjects(ezWorld& ref_world, ezArrayPtr<const Placem
 {
   EZ_PROFILE_SCOPE("PlacementTile::PlaceObjects");
 
-  ezGameObjectDesc desc;
   auto& objectsToPlace = m_pOutput->m_ObjectsToPlace;
 
-  ezHybridArray<ezPrefabResource*, 4> prefabs;
-  prefabs.SetCount(objectsToPlace.GetCount());
-
-
+  // group the transforms by prefab, so that all instances of the same prefab can be created in one batch
+  ezHybridArray<ezDynamicArray<ezTransform>, 4> transformsPerObject;
+  ezHybridArray<ezDynamicArray<const PlacementTransform*>, 4> placementsPerObject;
+  transformsPerObject.SetCount(objectsToPlace.GetCount());
+  placementsPerObject.SetCount(objectsToPlace.GetCount());
 
   for (auto& objectTransform : objectTransforms)
   {
     const ezUInt32 uiObjectIndex = objectTransform.m_uiObjectIndex;
-    ezPrefabResource* pPrefab = prefabs[uiObjectIndex];
+    transformsPerObject[uiObjectIndex].PushBack(ezSimdConversion::ToTransform(objectTransform.m_Transform));
+    placementsPerObject[uiObjectIndex].PushBack(&objectTransform);
+  }
 
-    if (pPrefab == nullptr)
-    {
-      pPrefab = ezResourceManager::BeginAcquireResource(objectsToPlace[uiObjectIndex], ezResourceAcquireMode::BlockTillLoaded);
-      prefabs[uiObjectIndex] = pPrefab;
-    }
+  ezDynamicArray<ezGameObject*> rootObjects;
 
-    ezTransform transform = ezSimdConversion::ToTransform(objectTransform.m_Transform);
-    ezHybridArray<ezGameObject*, 8> rootObjects;
+  for (ezUInt32 uiObjectIndex = 0; uiObjectIndex < objectsToPlace.GetCount(); ++uiObjectIndex)
+  {
+    const auto& transforms = transformsPerObject[uiObjectIndex];
+    if (transforms.IsEmpty())
+      continue;
+
+    ezResourceLock<ezPrefabResource> pPrefab(objectsToPlace[uiObjectIndex], ezResourceAcquireMode::BlockTillLoaded);
+
+    rootObjects.Clear();
 
     ezPrefabInstantiationOptions options;
     options.m_pCreatedRootObjectsOut = &rootObjects;
 
-    pPrefab->InstantiatePrefab(ref_world, transform, options);
+    pPrefab->InstantiatePrefabs(ref_world, transforms, options);
+
+    if (rootObjects.IsEmpty())
+      continue;
 
-    // only send the color message, if we actually have a custom color
-    if (objectTransform.m_bHasValidColor)
+    const ezUInt32 uiNumRootObjectsPerInstance = rootObjects.GetCount() / transforms.GetCount();
+
+    for (ezUInt32 i = 0; i < rootObjects.GetCount(); ++i)
     {
-      for (auto pRootObject : rootObjects)
+      ezGameObject* pRootObject = rootObjects[i];
+      const PlacementTransform& objectTransform = *placementsPerObject[uiObjectIndex][i / uiNumRootObjectsPerInstance];
+
+      // only send the color message, if we actually have a custom color
+      if (objectTransform.m_bHasValidColor)
       {
         // Set the color
         ezMsgSetColor msg;
         msg.m_Color = objectTransform.m_ObjectColor.ToLinearFloat();
         pRootObject->PostMessageRecursive(msg, ezTime::MakeZero(), ezObjectMsgQueueType::AfterInitialized);
       }
-    }
 
-    for (auto pRootObject : rootObjects)
-    {
       m_PlacedObjects.PushBack(pRootObject->GetHandle());
     }
   }
 
-  for (auto pPrefab : prefabs)
-  {
-    if (pPrefab != nullptr)
-    {
-      ezResourceManager::EndAcquireResource(pPrefab);
-    }
-  }
-
   m_State = State::Finished;
 
   return m_PlacedObjects.GetCount();
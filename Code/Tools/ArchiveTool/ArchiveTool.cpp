@@ -118,6 +118,14 @@ protected:
     const ezUInt64 uiPercentage = (uiSourceSize == 0) ? 100 : (uiStoredSize * 100 / uiSourceSize);
     ezLog::Info(" [{}%%] {} ({}%%) - {}", ezArgU(100 * uiCurEntry / uiMaxEntries, 2), sSourceFile, uiPercentage, duration);
   }
+
+  virtual void WriteArchiveResultCallback(const Statistics& stats) const override
+  {
+    const ezUInt64 uiPercentage = (stats.m_uiUncompressedSize == 0) ? 100 : (stats.m_uiStoredSize * 100 / stats.m_uiUncompressedSize);
+    const double fSpeedup = stats.m_TotalDuration.IsPositive() ? stats.m_ProcessingDuration.GetSeconds() / stats.m_TotalDuration.GetSeconds() : 1.0;
+
+    ezLog::Info("Packed {} files, {} -> {} ({}%%) in {}, {} of processing time ({}x speedup through multi-threading)", stats.m_uiNumEntries, ezArgFileSize(stats.m_uiUncompressedSize), ezArgFileSize(stats.m_uiStoredSize), uiPercentage, stats.m_TotalDuration, stats.m_ProcessingDuration, ezArgF(fSpeedup, 1));
+  }
 };
 
 class ezArchiveReaderImpl : public ezArchiveReader
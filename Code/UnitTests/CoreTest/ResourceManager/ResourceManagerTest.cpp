@@ -1,6 +1,8 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/ResourceManager/ResourceManager.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/ScopeExit.h>
 
 EZ_CREATE_SIMPLE_TEST_GROUP(ResourceManager);
@@ -286,3 +288,119 @@ EZ_CREATE_SIMPLE_TEST(ResourceManager, NestedLoading)
     EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
   }
 }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(ResourceManager, ConcurrentAccess)
+{
+  TestResourceTypeLoader TypeLoader;
+  ezResourceManager::AllowResourceTypeAcquireDuringUpdateContent<TestResource, TestResource>();
+  ezResourceManager::SetResourceTypeLoader<TestResource>(&TypeLoader);
+  EZ_SCOPE_EXIT(ezResourceManager::SetResourceTypeLoader<TestResource>(nullptr));
+
+  constexpr ezUInt32 uiNumResources = 64;
+
+  ezParallelForParams params;
+  params.m_uiBinSize = 64;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load, acquire and unload")
+  {
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+
+    ezAtomicInteger32 iNumFailed;
+
+    // resources are loaded, acquired and freed again from many threads at once, a reference handed out while a resource gets
+    // unloaded would crash or fail the acquire
+    ezTaskSystem::ParallelForIndexed(
+      0u, 20000u,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        ezStringBuilder sResourceID;
+
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          sResourceID.SetFormat("Concurrent-{}", i % uiNumResources);
+          TestResourceHandle hResource = ezResourceManager::LoadResource<TestResource>(sResourceID);
+
+          ezResourceLock<TestResource> pTestResource(hResource, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+
+          if (pTestResource.GetAcquireResult() != ezResourceAcquireResult::Final)
+          {
+            iNumFailed.Increment();
+          }
+
+          if ((i % 1000) == 0)
+          {
+            ezResourceManager::FreeUnusedResources(ezTime::MakeFromMilliseconds(1), ezTime::MakeZero());
+          }
+        }
+      },
+      "ResourceManagerConcurrentAccess", ezTaskNesting::Maybe, params);
+
+    EZ_TEST_INT(iNumFailed, 0);
+    EZ_TEST_BOOL(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount() <= uiNumResources);
+
+    while (ezResourceManager::IsAnyLoadingInProgress())
+    {
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(10));
+    }
+
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Acquire throughput")
+  {
+    ezDynamicArray<TestResourceHandle> hResources;
+
+    ezStringBuilder sResourceID;
+    for (ezUInt32 i = 0; i < uiNumResources; ++i)
+    {
+      sResourceID.SetFormat("Concurrent-{}", i);
+      hResources.PushBack(ezResourceManager::LoadResource<TestResource>(sResourceID));
+
+      ezResourceLock<TestResource> pTestResource(hResources.PeekBack(), ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+    }
+
+    constexpr ezUInt32 uiNumIterations = 1000000;
+
+    ezStopwatch sw;
+
+    ezTaskSystem::ParallelForIndexed(
+      0u, uiNumIterations,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        ezStringBuilder sResourceID;
+
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          // mix loading by ID with acquiring through an existing handle
+          if ((i & 7) == 0)
+          {
+            sResourceID.SetFormat("Concurrent-{}", i % uiNumResources);
+            TestResourceHandle hResource = ezResourceManager::LoadResource<TestResource>(sResourceID);
+            ezResourceLock<TestResource> pTestResource(hResource, ezResourceAcquireMode::AllowLoadingFallback);
+          }
+          else
+          {
+            ezResourceLock<TestResource> pTestResource(hResources[i % uiNumResources], ezResourceAcquireMode::AllowLoadingFallback);
+          }
+        }
+      },
+      "ResourceManagerAcquireThroughput", ezTaskNesting::Never, params);
+
+    const ezTime tDiff = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u acquires in %.2fms -> %.1f million acquires/s", uiNumIterations, tDiff.GetMilliseconds(),
+      uiNumIterations / tDiff.GetSeconds() / 1000000.0);
+
+    hResources.Clear();
+
+    ezResourceManager::FreeAllUnusedResources();
+    EZ_TEST_INT(ezResourceManager::GetAllResourcesOfType<TestResource>()->GetCount(), 0);
+  }
+}
@@ -1,8 +1,12 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/World/World.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/Thread.h>
 #include <Foundation/Time/Clock.h>
+#include <Foundation/Time/Stopwatch.h>
 
 namespace
 {
@@ -80,6 +84,30 @@ namespace
   EZ_END_COMPONENT_TYPE;
   // clang-format on
 
+  class PostingThread : public ezThread
+  {
+  public:
+    PostingThread(const ezWorld& world, ezComponentHandle hComponent)
+      : ezThread("Message Posting Thread")
+      , m_World(world)
+      , m_hComponent(hComponent)
+    {
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      TestMessage1 msg;
+      msg.m_iValue = 1;
+      m_World.PostMessage(m_hComponent, msg, ezTime::MakeZero());
+
+      return 0;
+    }
+
+    const ezWorld& m_World;
+    ezComponentHandle m_hComponent;
+  };
+
   void ResetComponents(ezGameObject& ref_object)
   {
     TestComponentMsg* pComponent = nullptr;
@@ -96,6 +124,12 @@ namespace
   }
 } // namespace
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum MessagingBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum MessagingBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
 EZ_CREATE_SIMPLE_TEST(World, Messaging)
 {
   ezWorldDesc worldDesc("Test");
@@ -233,4 +267,163 @@ EZ_CREATE_SIMPLE_TEST(World, Messaging)
 
     ezFrameAllocator::Reset();
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing from multiple threads")
+  {
+    ResetComponents(*pRoot);
+
+    TestComponentMsg* pComponent2 = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent2));
+    const ezComponentHandle hComponent = pComponent2->GetHandle();
+
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromSeconds(1.001f));
+
+    const ezUInt32 uiNumMessages = 10000;
+    ezTaskSystem::ParallelForIndexed(
+      0u, uiNumMessages,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          TestMessage1 msg;
+          msg.m_iValue = 1;
+          world.PostMessage(hComponent, msg, ezTime::MakeZero());
+
+          TestMessage2 msg2;
+          msg2.m_iValue = 1;
+          world.PostMessage(hComponent, msg2, ezTime::MakeFromSeconds(1));
+        }
+      });
+
+    world.Update();
+
+    EZ_TEST_INT(pComponent2->m_iSomeData, 1 + uiNumMessages);
+    EZ_TEST_INT(pComponent2->m_iSomeData2, 2 + 2 * uiNumMessages);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Many messages with delay")
+  {
+    ResetComponents(*pRoot);
+
+    TestComponentMsg* pComponent2 = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent2));
+
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    // the delays cover all levels of the timing wheel, they are chosen such that they never coincide with a frame time
+    const ezTime startTime = world.GetClock().GetAccumulatedTime();
+    ezDynamicArray<ezTime> dueTimes;
+    for (ezUInt32 i = 0; i < 10000; ++i)
+    {
+      const ezTime delay = ezTime::MakeFromMilliseconds(rnd.UIntInRange(i < 100 ? 1000000 : 100000) + 0.5);
+      dueTimes.PushBack(startTime + delay);
+
+      TestMessage1 msg;
+      msg.m_iValue = 1;
+      pRoot->PostMessage(msg, delay);
+    }
+
+    // small steps first, then larger jumps in time
+    for (ezUInt32 uiFrame = 0; uiFrame < 300; ++uiFrame)
+    {
+      world.GetClock().SetFixedTimeStep(ezTime::MakeFromMilliseconds(uiFrame < 200 ? 100 : uiFrame < 280 ? 1000 : 50000));
+
+      world.Update();
+
+      const ezTime now = world.GetClock().GetAccumulatedTime();
+      ezInt32 iNumDue = 0;
+      for (ezTime due : dueTimes)
+      {
+        iNumDue += (due <= now) ? 1 : 0;
+      }
+
+      EZ_TEST_INT(pComponent2->m_iSomeData, 1 + iNumDue);
+    }
+
+    EZ_TEST_INT(pComponent2->m_iSomeData, 1 + dueTimes.GetCount());
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Queuing from short-lived threads")
+  {
+    ResetComponents(*pRoot);
+
+    TestComponentMsg* pComponent2 = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent2));
+    const ezComponentHandle hComponent = pComponent2->GetHandle();
+
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromMilliseconds(16));
+
+    // the buffers of exited threads are recycled after a while, also the one of this thread which is idle meanwhile
+    const ezUInt32 uiNumThreads = 200;
+    for (ezUInt32 i = 0; i < uiNumThreads; ++i)
+    {
+      PostingThread thread(world, hComponent);
+      thread.Start();
+      thread.Join();
+
+      world.Update();
+
+      EZ_TEST_INT(pComponent2->m_iSomeData, 1 + i + 1);
+    }
+
+    // only the threads of the last MaxIdleThreadMessageBufferUpdates updates still own a buffer, plus possibly the one of this thread
+    EZ_TEST_BOOL(world.GetThreadMessageBufferCount() <= ezInternal::WorldData::MaxIdleThreadMessageBufferUpdates + 1);
+
+    TestMessage1 msg;
+    msg.m_iValue = 1;
+    world.PostMessage(hComponent, msg, ezTime::MakeZero());
+
+    world.Update();
+
+    EZ_TEST_INT(pComponent2->m_iSomeData, 1 + uiNumThreads + 1);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(MessagingBenchmarkEnabled, "Benchmark")
+  {
+    TestComponentMsg* pComponent2 = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pComponent2));
+    const ezComponentHandle hComponent = pComponent2->GetHandle();
+
+    world.GetClock().SetFixedTimeStep(ezTime::MakeFromMilliseconds(16));
+
+    ezRandom rnd;
+    rnd.Initialize(13);
+
+    ezStopwatch sw;
+
+    // many timed messages are pending, only few of them are due each frame
+    for (ezUInt32 i = 0; i < 50000; ++i)
+    {
+      TestMessage1 msg;
+      msg.m_iValue = 1;
+      world.PostMessage(hComponent, msg, ezTime::MakeFromMilliseconds(rnd.UIntInRange(600000) + 1));
+    }
+
+    const ezTime tPost = sw.Checkpoint();
+
+    for (ezUInt32 uiFrame = 0; uiFrame < 100; ++uiFrame)
+    {
+      for (ezUInt32 i = 0; i < 100; ++i)
+      {
+        TestMessage2 msg;
+        msg.m_iValue = 1;
+        world.PostMessage(hComponent, msg, ezTime::MakeZero());
+      }
+
+      world.Update();
+    }
+
+    const ezTime tUpdate = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Posting 50000 timed messages: %.2fms, 100 updates: %.2fms", tPost.GetMilliseconds(), tUpdate.GetMilliseconds());
+
+    ezFrameAllocator::Reset();
+  }
 }
@@ -0,0 +1,238 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  class PrefabTestComponent;
+  using PrefabTestComponentManager = ezComponentManager<PrefabTestComponent, ezBlockStorageType::FreeList>;
+
+  class PrefabTestComponent : public ezComponent
+  {
+    EZ_DECLARE_COMPONENT_TYPE(PrefabTestComponent, ezComponent, PrefabTestComponentManager);
+
+  public:
+    virtual void SerializeComponent(ezWorldWriter& inout_stream) const override
+    {
+      SUPER::SerializeComponent(inout_stream);
+
+      auto& s = inout_stream.GetStream();
+      s << m_iValue;
+      s << m_sText;
+      inout_stream.WriteGameObjectHandle(m_hTarget);
+    }
+
+    virtual void DeserializeComponent(ezWorldReader& inout_stream) override
+    {
+      SUPER::DeserializeComponent(inout_stream);
+
+      auto& s = inout_stream.GetStream();
+      s >> m_iValue;
+      s >> m_sText;
+      m_hTarget = inout_stream.ReadGameObjectHandle();
+    }
+
+    ezInt32 m_iValue = 0;
+    ezString m_sText;
+    ezGameObjectHandle m_hTarget;
+  };
+
+  // clang-format off
+  EZ_BEGIN_COMPONENT_TYPE(PrefabTestComponent, 1, ezComponentMode::Static)
+  EZ_END_COMPONENT_TYPE;
+  // clang-format on
+
+  /// Creates a small hierarchy with a couple of components and serializes it like a prefab.
+  void WritePrefab(ezDefaultMemoryStreamStorage& ref_storage)
+  {
+    ezWorldDesc worldDesc("PrefabSource");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    PrefabTestComponentManager* pManager = world.GetOrCreateComponentManager<PrefabTestComponentManager>();
+
+    ezGameObjectDesc desc;
+    desc.m_sName.Assign("Root");
+    desc.m_LocalPosition.Set(1, 2, 3);
+
+    ezGameObject* pRoot = nullptr;
+    const ezGameObjectHandle hRoot = world.CreateObject(desc, pRoot);
+
+    ezGameObject* pChildren[3] = {};
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      ezStringBuilder sName;
+      sName.SetFormat("Child{}", i);
+
+      desc.m_sName.Assign(sName);
+      desc.m_hParent = (i == 2) ? pChildren[1]->GetHandle() : hRoot;
+      desc.m_LocalPosition.Set(static_cast<float>(i), 0, 0);
+      world.CreateObject(desc, pChildren[i]);
+
+      PrefabTestComponent* pComponent = nullptr;
+      pManager->CreateComponent(pChildren[i], pComponent);
+      pComponent->m_iValue = 10 + i;
+      pComponent->m_sText = sName;
+      pComponent->m_hTarget = hRoot;
+      pComponent->SetUserFlag(i, true);
+      pComponent->SetActiveFlag(i != 1);
+    }
+
+    PrefabTestComponent* pComponent = nullptr;
+    pManager->CreateComponent(pRoot, pComponent);
+    pComponent->m_iValue = 42;
+    pComponent->m_sText = "Root";
+    pComponent->m_hTarget = pChildren[2]->GetHandle();
+
+    const ezGameObject* roots[] = {pRoot};
+
+    ezMemoryStreamWriter writer(&ref_storage);
+    ezWorldWriter worldWriter;
+    worldWriter.WriteObjects(writer, roots);
+  }
+
+  /// Checks that the given root object is an exact copy of the prefab, placed at the given transform.
+  void CheckInstance(const ezWorld& world, ezGameObject* pRoot, const ezTransform& rootTransform)
+  {
+    EZ_TEST_STRING(pRoot->GetName(), "Root");
+    EZ_TEST_VEC3(pRoot->GetGlobalPosition(), rootTransform.TransformPosition(ezVec3(1, 2, 3)), 0.0001f);
+    EZ_TEST_INT(pRoot->GetChildCount(), 2);
+
+    ezGameObject* pChild1 = pRoot->FindChildByName(ezTempHashedString("Child1"), false);
+    ezGameObject* pChild2 = pRoot->FindChildByName(ezTempHashedString("Child2"), true);
+    if (!EZ_TEST_BOOL(pChild1 != nullptr && pChild2 != nullptr))
+      return;
+
+    EZ_TEST_BOOL(pChild2->GetParent() == pChild1);
+
+    const PrefabTestComponent* pRootComponent = nullptr;
+    EZ_TEST_BOOL(pRoot->TryGetComponentOfBaseType(pRootComponent));
+    EZ_TEST_INT(pRootComponent->m_iValue, 42);
+    EZ_TEST_BOOL(pRootComponent->m_hTarget == pChild2->GetHandle());
+    EZ_TEST_BOOL(pRootComponent->IsActive());
+
+    const PrefabTestComponent* pChildComponent = nullptr;
+    EZ_TEST_BOOL(pChild1->TryGetComponentOfBaseType(pChildComponent));
+    EZ_TEST_INT(pChildComponent->m_iValue, 11);
+    EZ_TEST_STRING(pChildComponent->m_sText, "Child1");
+    EZ_TEST_BOOL(pChildComponent->m_hTarget == pRoot->GetHandle());
+    EZ_TEST_BOOL(!pChildComponent->GetActiveFlag());
+    EZ_TEST_BOOL(pChildComponent->GetUserFlag(1));
+    EZ_TEST_BOOL(!pChildComponent->GetUserFlag(0));
+
+    EZ_TEST_BOOL(world.IsValidObject(pRoot->GetHandle()));
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum PrefabBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum PrefabBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(World, PrefabInstantiation)
+{
+  ezDefaultMemoryStreamStorage prefabStorage;
+  WritePrefab(prefabStorage);
+
+  ezWorldReader worldReader;
+  {
+    ezMemoryStreamReader reader(&prefabStorage);
+    EZ_TEST_RESULT(worldReader.ReadWorldDescription(reader));
+  }
+
+  EZ_TEST_INT(worldReader.GetRootObjectCount(), 1);
+  EZ_TEST_INT(worldReader.GetChildObjectCount(), 3);
+
+  ezWorldDesc worldDesc("PrefabInstantiation");
+  ezWorld world(worldDesc);
+
+  ezDynamicArray<ezTransform> transforms;
+  for (ezUInt32 i = 0; i < 16; ++i)
+  {
+    transforms.PushBack(ezTransform(ezVec3(i * 10.0f, 0, 0), ezQuat::MakeFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::MakeFromDegree(i * 20.0f))));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefab")
+  {
+    for (const ezTransform& transform : transforms)
+    {
+      ezHybridArray<ezGameObject*, 8> rootObjects;
+
+      ezPrefabInstantiationOptions options;
+      options.m_pCreatedRootObjectsOut = &rootObjects;
+      worldReader.InstantiatePrefab(world, transform, options);
+
+      EZ_LOCK(world.GetReadMarker());
+      if (EZ_TEST_INT(rootObjects.GetCount(), 1))
+      {
+        CheckInstance(world, rootObjects[0], transform);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "InstantiatePrefabs")
+  {
+    ezUInt32 uiObjectCountBefore = 0;
+    {
+      EZ_LOCK(world.GetReadMarker());
+      uiObjectCountBefore = world.GetObjectCount();
+    }
+
+    ezDynamicArray<ezGameObject*> rootObjects;
+    ezDynamicArray<ezGameObject*> childObjects;
+    rootObjects.PushBack(nullptr); // output arrays are only appended to
+
+    ezPrefabInstantiationOptions options;
+    options.m_pCreatedRootObjectsOut = &rootObjects;
+    options.m_pCreatedChildObjectsOut = &childObjects;
+    worldReader.InstantiatePrefabs(world, transforms, options);
+
+    EZ_LOCK(world.GetReadMarker());
+    EZ_TEST_INT(world.GetObjectCount(), uiObjectCountBefore + transforms.GetCount() * 4);
+    EZ_TEST_INT(childObjects.GetCount(), transforms.GetCount() * 3);
+
+    if (EZ_TEST_INT(rootObjects.GetCount(), transforms.GetCount() + 1))
+    {
+      for (ezUInt32 i = 0; i < transforms.GetCount(); ++i)
+      {
+        CheckInstance(world, rootObjects[i + 1], transforms[i]);
+        EZ_TEST_BOOL(childObjects[i * 3]->GetParent() == rootObjects[i + 1]);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(PrefabBenchmarkEnabled, "Benchmark")
+  {
+    transforms.SetCount(10000);
+
+    ezTime durations[2];
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      ezWorld benchmarkWorld(worldDesc);
+
+      ezStopwatch sw;
+      if (i == 0)
+      {
+        for (const ezTransform& transform : transforms)
+        {
+          worldReader.InstantiatePrefab(benchmarkWorld, transform, ezPrefabInstantiationOptions());
+        }
+      }
+      else
+      {
+        worldReader.InstantiatePrefabs(benchmarkWorld, transforms, ezPrefabInstantiationOptions());
+      }
+      durations[i] = sw.GetRunningTotal();
+
+      EZ_LOCK(benchmarkWorld.GetReadMarker());
+      EZ_TEST_INT(benchmarkWorld.GetObjectCount(), transforms.GetCount() * 4);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Instantiating %u prefabs: one by one %.1fms, batched %.1fms", transforms.GetCount(), durations[0].GetMilliseconds(), durations[1].GetMilliseconds());
+  }
+}
@@ -56,266 +56,366 @@ namespace
   }
   EZ_END_COMPONENT_TYPE;
   // clang-format on
-} // namespace
 
-EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
-{
-  ezWorldDesc worldDesc("Test");
-  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+  void TestSpatialSystem(ezSpatialSystemType::Enum spatialSystemType)
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+    worldDesc.m_SpatialSystemType = spatialSystemType;
 
-  ezWorld world(worldDesc);
-  EZ_LOCK(world.GetWriteMarker());
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
 
-  auto& rng = world.GetRandomNumberGenerator();
+    auto& rng = world.GetRandomNumberGenerator();
 
-  ezDynamicArray<ezGameObject*> objects;
-  objects.Reserve(1000);
+    ezDynamicArray<ezGameObject*> objects;
+    objects.Reserve(1000);
 
-  for (ezUInt32 i = 0; i < 1000; ++i)
-  {
-    constexpr const double range = 10000.0;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      constexpr const double range = 10000.0;
 
-    float x = (float)rng.DoubleMinMax(-range, range);
-    float y = (float)rng.DoubleMinMax(-range, range);
-    float z = (float)rng.DoubleMinMax(-range, range);
+      float x = (float)rng.DoubleMinMax(-range, range);
+      float y = (float)rng.DoubleMinMax(-range, range);
+      float z = (float)rng.DoubleMinMax(-range, range);
 
-    ezGameObjectDesc desc;
-    desc.m_bDynamic = (i >= 500);
-    desc.m_LocalPosition = ezVec3(x, y, z);
+      ezGameObjectDesc desc;
+      desc.m_bDynamic = (i >= 500);
+      desc.m_LocalPosition = ezVec3(x, y, z);
 
-    ezGameObject* pObject = nullptr;
-    world.CreateObject(desc, pObject);
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
 
-    objects.PushBack(pObject);
+      objects.PushBack(pObject);
 
-    TestBoundsComponent* pComponent = nullptr;
-    TestBoundsComponent::CreateComponent(pObject, pComponent);
-  }
+      TestBoundsComponent* pComponent = nullptr;
+      TestBoundsComponent::CreateComponent(pObject, pComponent);
+    }
 
-  world.Update();
+    world.Update();
 
-  ezSpatialSystem::QueryParams queryParams;
-  queryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+    ezSpatialSystem::QueryParams queryParams;
+    queryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInSphere")
-  {
-    ezBoundingSphere testSphere = ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(100.0f, 60.0f, 400.0f), 3000.0f);
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInSphere")
+    {
+      ezBoundingSphere testSphere = ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(100.0f, 60.0f, 400.0f), 3000.0f);
 
-    ezDynamicArray<ezGameObject*> objectsInSphere;
-    ezHashSet<ezGameObject*> uniqueObjects;
-    world.GetSpatialSystem()->FindObjectsInSphere(testSphere, queryParams, objectsInSphere);
+      ezDynamicArray<ezGameObject*> objectsInSphere;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInSphere(testSphere, queryParams, objectsInSphere);
 
-    for (auto pObject : objectsInSphere)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+      for (auto pObject : objectsInSphere)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
 
-      EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
-      EZ_TEST_BOOL(pObject->IsStatic());
-    }
+        EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
-    {
-      ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
-      if (testSphere.Overlaps(objSphere))
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testSphere.Overlaps(objSphere))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        }
       }
-    }
 
-    objectsInSphere.Clear();
-    uniqueObjects.Clear();
+      objectsInSphere.Clear();
+      uniqueObjects.Clear();
 
-    world.GetSpatialSystem()->FindObjectsInSphere(testSphere, queryParams, [&](ezGameObject* pObject)
-      {
-      objectsInSphere.PushBack(pObject);
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+      world.GetSpatialSystem()->FindObjectsInSphere(testSphere, queryParams, [&](ezGameObject* pObject)
+        {
+        objectsInSphere.PushBack(pObject);
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
 
-      return ezVisitorExecution::Continue; });
+        return ezVisitorExecution::Continue; });
 
-    for (auto pObject : objectsInSphere)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+      for (auto pObject : objectsInSphere)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
 
-      EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
-      EZ_TEST_BOOL(pObject->IsStatic());
-    }
+        EZ_TEST_BOOL(testSphere.Overlaps(objSphere));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
-    {
-      ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
-      if (testSphere.Overlaps(objSphere))
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        ezBoundingSphere objSphere = it->GetGlobalBounds().GetSphere();
+        if (testSphere.Overlaps(objSphere))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        }
       }
     }
-  }
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInBox")
-  {
-    ezBoundingBox testBox = ezBoundingBox::MakeFromCenterAndHalfExtents(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(3000.0f));
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindObjectsInBox")
+    {
+      ezBoundingBox testBox = ezBoundingBox::MakeFromCenterAndHalfExtents(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(3000.0f));
 
-    ezDynamicArray<ezGameObject*> objectsInBox;
-    ezHashSet<ezGameObject*> uniqueObjects;
-    world.GetSpatialSystem()->FindObjectsInBox(testBox, queryParams, objectsInBox);
+      ezDynamicArray<ezGameObject*> objectsInBox;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInBox(testBox, queryParams, objectsInBox);
 
-    for (auto pObject : objectsInBox)
-    {
-      ezBoundingBox objBox = pObject->GetGlobalBounds().GetBox();
+      for (auto pObject : objectsInBox)
+      {
+        ezBoundingBox objBox = pObject->GetGlobalBounds().GetBox();
 
-      EZ_TEST_BOOL(testBox.Overlaps(objBox));
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
-      EZ_TEST_BOOL(pObject->IsStatic());
-    }
+        EZ_TEST_BOOL(testBox.Overlaps(objBox));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
-    {
-      ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
-      if (testBox.Overlaps(objBox))
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
+        if (testBox.Overlaps(objBox))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        }
       }
-    }
 
-    objectsInBox.Clear();
-    uniqueObjects.Clear();
+      objectsInBox.Clear();
+      uniqueObjects.Clear();
 
-    world.GetSpatialSystem()->FindObjectsInBox(testBox, queryParams, [&](ezGameObject* pObject)
-      {
-      objectsInBox.PushBack(pObject);
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+      world.GetSpatialSystem()->FindObjectsInBox(testBox, queryParams, [&](ezGameObject* pObject)
+        {
+        objectsInBox.PushBack(pObject);
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
 
-      return ezVisitorExecution::Continue; });
+        return ezVisitorExecution::Continue; });
 
-    for (auto pObject : objectsInBox)
-    {
-      ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
+      for (auto pObject : objectsInBox)
+      {
+        ezBoundingSphere objSphere = pObject->GetGlobalBounds().GetSphere();
 
-      EZ_TEST_BOOL(testBox.Overlaps(objSphere));
-      EZ_TEST_BOOL(pObject->IsStatic());
+        EZ_TEST_BOOL(testBox.Overlaps(objSphere));
+        EZ_TEST_BOOL(pObject->IsStatic());
+      }
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
+        if (testBox.Overlaps(objBox))
+        {
+          EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        }
+      }
     }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects")
     {
-      ezBoundingBox objBox = it->GetGlobalBounds().GetBox();
-      if (testBox.Overlaps(objBox))
+      constexpr uint32_t numUpdates = 13;
+
+      // update a few times to increase internal frame counter
+      for (uint32_t i = 0; i < numUpdates; ++i)
       {
-        EZ_TEST_BOOL(it->IsDynamic() || uniqueObjects.Contains((ezGameObject*)it));
+        world.Update();
       }
-    }
-  }
 
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects")
-  {
-    constexpr uint32_t numUpdates = 13;
+      queryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
 
-    // update a few times to increase internal frame counter
-    for (uint32_t i = 0; i < numUpdates; ++i)
-    {
-      world.Update();
-    }
+      ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(ezVec3::MakeZero(), ezVec3::MakeAxisX(), ezVec3::MakeAxisZ());
+      ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 10000.0f);
 
-    queryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+      ezFrustum testFrustum = ezFrustum::MakeFromMVP(projection * lookAt);
 
-    ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(ezVec3::MakeZero(), ezVec3::MakeAxisX(), ezVec3::MakeAxisZ());
-    ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 10000.0f);
+      ezDynamicArray<const ezGameObject*> visibleObjects;
+      ezHashSet<const ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindVisibleObjects(testFrustum, queryParams, visibleObjects, {}, ezVisibilityState::Direct);
 
-    ezFrustum testFrustum = ezFrustum::MakeFromMVP(projection * lookAt);
+      EZ_TEST_BOOL(!visibleObjects.IsEmpty());
 
-    ezDynamicArray<const ezGameObject*> visibleObjects;
-    ezHashSet<const ezGameObject*> uniqueObjects;
-    world.GetSpatialSystem()->FindVisibleObjects(testFrustum, queryParams, visibleObjects, {}, ezVisibilityState::Direct);
+      for (auto pObject : visibleObjects)
+      {
+        EZ_TEST_BOOL(testFrustum.Overlaps(pObject->GetGlobalBoundsSimd().GetSphere()));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsDynamic());
 
-    EZ_TEST_BOOL(!visibleObjects.IsEmpty());
+        ezVisibilityState::Enum visType = pObject->GetVisibilityState();
+        EZ_TEST_BOOL(visType == ezVisibilityState::Direct);
+      }
 
-    for (auto pObject : visibleObjects)
-    {
-      EZ_TEST_BOOL(testFrustum.Overlaps(pObject->GetGlobalBoundsSimd().GetSphere()));
-      EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
-      EZ_TEST_BOOL(pObject->IsDynamic());
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        ezGameObject* pObject = it;
 
-      ezVisibilityState::Enum visType = pObject->GetVisibilityState();
-      EZ_TEST_BOOL(visType == ezVisibilityState::Direct);
-    }
+        if (testFrustum.GetObjectPosition(pObject->GetGlobalBounds().GetSphere()) == ezVolumePosition::Outside)
+        {
+          ezVisibilityState::Enum visType = pObject->GetVisibilityState();
+          EZ_TEST_BOOL(visType == ezVisibilityState::Invisible);
+        }
+      }
 
-    // Check for missing objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
-    {
-      ezGameObject* pObject = it;
+      // Move some objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        constexpr const double range = 500.0f;
 
-      if (testFrustum.GetObjectPosition(pObject->GetGlobalBounds().GetSphere()) == ezVolumePosition::Outside)
+        if (it->IsDynamic())
+        {
+          ezVec3 pos = it->GetLocalPosition();
+
+          pos.x += (float)rng.DoubleMinMax(-range, range);
+          pos.y += (float)rng.DoubleMinMax(-range, range);
+          pos.z += (float)rng.DoubleMinMax(-range, range);
+
+          it->SetLocalPosition(pos);
+        }
+      }
+
+      world.Update();
+
+      // Check that last frame visible doesn't reset entirely after moving
+      for (const ezGameObject* pObject : visibleObjects)
       {
         ezVisibilityState::Enum visType = pObject->GetVisibilityState();
-        EZ_TEST_BOOL(visType == ezVisibilityState::Invisible);
+        EZ_TEST_BOOL(visType == ezVisibilityState::Direct);
       }
     }
 
-    // Move some objects
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindVisibleObjects with occlusion")
     {
-      constexpr const double range = 500.0f;
+      ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(ezVec3::MakeZero(), ezVec3::MakeAxisX(), ezVec3::MakeAxisZ());
+      ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 10000.0f);
+
+      ezFrustum testFrustum = ezFrustum::MakeFromMVP(projection * lookAt);
 
-      if (it->IsDynamic())
+      // everything that is completely on the left side of the camera counts as occluded
+      auto IsOccluded = [](const ezSimdBBox& box)
       {
-        ezVec3 pos = it->GetLocalPosition();
+        return box.m_Max.y() < 0.0f;
+      };
+
+      ezUInt32 uiNumBatchedBoxes = 0;
+      auto AreOccluded = [&](ezArrayPtr<const ezSimdBBox> boxes, ezArrayPtr<bool> out_occluded)
+      {
+        for (ezUInt32 i = 0; i < boxes.GetCount(); ++i)
+        {
+          out_occluded[i] = IsOccluded(boxes[i]);
+        }
+
+        uiNumBatchedBoxes += boxes.GetCount();
+      };
+
+      ezDynamicArray<const ezGameObject*> visibleObjects;
+      world.GetSpatialSystem()->FindVisibleObjects(testFrustum, queryParams, visibleObjects, IsOccluded, ezVisibilityState::Direct);
 
-        pos.x += (float)rng.DoubleMinMax(-range, range);
-        pos.y += (float)rng.DoubleMinMax(-range, range);
-        pos.z += (float)rng.DoubleMinMax(-range, range);
+      ezDynamicArray<const ezGameObject*> visibleObjectsBatched;
+      world.GetSpatialSystem()->FindVisibleObjects(testFrustum, queryParams, visibleObjectsBatched, IsOccluded, ezVisibilityState::Direct, AreOccluded);
 
-        it->SetLocalPosition(pos);
+      EZ_TEST_BOOL(!visibleObjects.IsEmpty());
+      EZ_TEST_BOOL(uiNumBatchedBoxes >= visibleObjectsBatched.GetCount());
+      EZ_TEST_INT(visibleObjects.GetCount(), visibleObjectsBatched.GetCount());
+
+      ezHashSet<const ezGameObject*> uniqueObjects;
+      for (auto pObject : visibleObjects)
+      {
+        EZ_TEST_BOOL(!IsOccluded(pObject->GetGlobalBoundsSimd().GetBox()));
+        uniqueObjects.Insert(pObject);
       }
-    }
 
-    world.Update();
+      for (auto pObject : visibleObjectsBatched)
+      {
+        EZ_TEST_BOOL(uniqueObjects.Contains(pObject));
+      }
+    }
 
-    // Check that last frame visible doesn't reset entirely after moving
-    for (const ezGameObject* pObject : visibleObjects)
+    if (false)
     {
-      ezVisibilityState::Enum visType = pObject->GetVisibilityState();
-      EZ_TEST_BOOL(visType == ezVisibilityState::Direct);
+      ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezDataDirUsage::AllowWrites) == EZ_SUCCESS);
+
+      ezProfilingUtils::SaveProfilingCapture(":output/profiling.json").IgnoreResult();
     }
-  }
 
-  if (false)
-  {
-    ezStringBuilder outputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
-    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(outputPath.GetData(), "test", "output", ezDataDirUsage::AllowWrites) == EZ_SUCCESS);
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Moving objects")
+    {
+      // dynamic objects are updated through the deferred bounds update of the multi-threaded transform update
+      for (ezUInt32 i = 500; i < objects.GetCount(); ++i)
+      {
+        constexpr const double range = 5000.0;
 
-    ezProfilingUtils::SaveProfilingCapture(":output/profiling.json").IgnoreResult();
-  }
+        float x = (float)rng.DoubleMinMax(-range, range);
+        float y = (float)rng.DoubleMinMax(-range, range);
+        float z = (float)rng.DoubleMinMax(-range, range);
 
-  // Test multiple categories for spatial data
-  EZ_TEST_BLOCK(ezTestBlock::Enabled, "MultipleCategories")
-  {
-    for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
-    {
-      ezGameObject* pObject = objects[i];
+        objects[i]->SetLocalPosition(ezVec3(x, y, z));
+      }
 
-      TestBoundsComponent* pComponent = nullptr;
-      TestBoundsComponent::CreateComponent(pObject, pComponent);
-      pComponent->m_SpecialCategory = s_SpecialTestCategory;
-    }
+      world.Update();
 
-    world.Update();
+      ezSpatialSystem::QueryParams dynamicQueryParams;
+      dynamicQueryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
 
-    ezDynamicArray<ezGameObjectHandle> allObjects;
-    allObjects.Reserve(world.GetObjectCount());
+      ezBoundingBox testBox = ezBoundingBox::MakeFromCenterAndHalfExtents(ezVec3(100.0f, 60.0f, 400.0f), ezVec3(3000.0f));
 
-    for (auto it = world.GetObjects(); it.IsValid(); ++it)
-    {
-      allObjects.PushBack(it->GetHandle());
+      ezDynamicArray<ezGameObject*> objectsInBox;
+      ezHashSet<ezGameObject*> uniqueObjects;
+      world.GetSpatialSystem()->FindObjectsInBox(testBox, dynamicQueryParams, objectsInBox);
+
+      for (auto pObject : objectsInBox)
+      {
+        EZ_TEST_BOOL(testBox.Overlaps(pObject->GetGlobalBounds().GetSphere()));
+        EZ_TEST_BOOL(!uniqueObjects.Insert(pObject));
+        EZ_TEST_BOOL(pObject->IsDynamic());
+      }
+
+      // Check for missing objects
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        if (testBox.Overlaps(it->GetGlobalBounds().GetSphere()))
+        {
+          EZ_TEST_BOOL(it->IsStatic() || uniqueObjects.Contains((ezGameObject*)it));
+        }
+      }
     }
 
-    for (ezUInt32 i = allObjects.GetCount(); i-- > 0;)
+    // Test multiple categories for spatial data
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "MultipleCategories")
     {
-      world.DeleteObjectNow(allObjects[i]);
-    }
+      for (ezUInt32 i = 0; i < objects.GetCount(); ++i)
+      {
+        ezGameObject* pObject = objects[i];
 
-    world.Update();
+        TestBoundsComponent* pComponent = nullptr;
+        TestBoundsComponent::CreateComponent(pObject, pComponent);
+        pComponent->m_SpecialCategory = s_SpecialTestCategory;
+      }
+
+      world.Update();
+
+      ezDynamicArray<ezGameObjectHandle> allObjects;
+      allObjects.Reserve(world.GetObjectCount());
+
+      for (auto it = world.GetObjects(); it.IsValid(); ++it)
+      {
+        allObjects.PushBack(it->GetHandle());
+      }
+
+      for (ezUInt32 i = allObjects.GetCount(); i-- > 0;)
+      {
+        world.DeleteObjectNow(allObjects[i]);
+      }
+
+      world.Update();
+    }
   }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+{
+  TestSpatialSystem(ezSpatialSystemType::RegularGrid);
+}
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem_BVH)
+{
+  TestSpatialSystem(ezSpatialSystemType::BVH);
 }
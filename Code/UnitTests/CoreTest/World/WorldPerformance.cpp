@@ -1,6 +1,9 @@
 #include <CoreTest/CoreTestPCH.h>
 
+#include <Core/World/SpatialSystem_BVH.h>
+#include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Time/Clock.h>
 #include <Foundation/Time/Stopwatch.h>
 
@@ -246,6 +249,27 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 
+  EZ_TEST_BLOCK(EnableInRelease, "ST Spatial Update 250,000 dynamic objects")
+  {
+    ezWorldDesc worldDesc("Test");
+    worldDesc.m_bMultiThreadedSpatialDataUpdate = false; // forces the single-threaded update with a spatial system
+    ezWorld world(worldDesc);
+    MeasureCreationTime(true, 200, 5, 6, 0, &world);
+
+    ezStopwatch sw;
+
+    // first round always has some overhead
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      EZ_LOCK(world.GetWriteMarker());
+      world.Update();
+
+      const ezTime tDiff = sw.Checkpoint();
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Updating %u objects (ST spatial): %.2fms", world.GetObjectCount(), tDiff.GetMilliseconds());
+    }
+  }
+
   EZ_TEST_BLOCK(EnableInRelease, "MT Update 250,000 dynamic objects")
   {
     ezWorldDesc worldDesc("Test");
@@ -288,3 +312,112 @@ EZ_CREATE_SIMPLE_TEST(World, Profile_Update)
     }
   }
 }
+
+namespace
+{
+  void MeasureSpatialSystem(ezSpatialSystem& ref_system, const char* szName)
+  {
+    constexpr ezUInt32 uiNumObjects = 100000;
+    constexpr ezUInt32 uiNumQueries = 1000;
+    constexpr float fRange = 5000.0f;
+
+    const ezUInt32 uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    auto GetRandomBounds = [&](ezUInt32 i)
+    {
+      const ezVec3 vCenter(rng.FloatMinMax(-fRange, fRange), rng.FloatMinMax(-fRange, fRange), rng.FloatMinMax(-fRange, 0.0f));
+
+      // mostly small objects with a few huge ones in between, which is the worst case for a regular grid
+      const float fHalfExtents = (i % 100 == 0) ? rng.FloatMinMax(200.0f, 1000.0f) : rng.FloatMinMax(0.1f, 5.0f);
+
+      return ezSimdBBoxSphere::MakeFromBox(ezSimdBBox::MakeFromCenterAndHalfExtents(ezSimdConversion::ToVec3(vCenter), ezSimdVec4f(fHalfExtents)));
+    };
+
+    ezDynamicArray<ezSpatialDataHandle> handles;
+    handles.SetCountUninitialized(uiNumObjects);
+
+    ezStopwatch sw;
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      handles[i] = ref_system.CreateSpatialData(GetRandomBounds(i), nullptr, uiCategoryBitmask, ezTagSet());
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: Creating %u objects: %.2fms", szName, uiNumObjects, sw.Checkpoint().GetMilliseconds());
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ref_system.UpdateSpatialDataBounds(handles[i], GetRandomBounds(i));
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: Moving %u objects: %.2fms", szName, uiNumObjects, sw.Checkpoint().GetMilliseconds());
+
+    ezSpatialSystem::QueryParams queryParams;
+    queryParams.m_uiCategoryBitmask = uiCategoryBitmask;
+
+    ezUInt32 uiNumFound = 0;
+    auto countFunc = [&](ezGameObject*)
+    {
+      ++uiNumFound;
+      return ezVisitorExecution::Continue;
+    };
+
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const ezVec3 vCenter(rng.FloatMinMax(-fRange, fRange), rng.FloatMinMax(-fRange, fRange), rng.FloatMinMax(-fRange, 0.0f));
+      ref_system.FindObjectsInBox(ezBoundingBox::MakeFromCenterAndHalfExtents(vCenter, ezVec3(100.0f)), queryParams, countFunc);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: %u box queries, %u objects found: %.2fms", szName, uiNumQueries, uiNumFound, sw.Checkpoint().GetMilliseconds());
+
+    uiNumFound = 0;
+    for (ezUInt32 i = 0; i < uiNumQueries; ++i)
+    {
+      const ezVec3 vCenter(rng.FloatMinMax(-fRange, fRange), rng.FloatMinMax(-fRange, fRange), rng.FloatMinMax(-fRange, 0.0f));
+      ref_system.FindObjectsInSphere(ezBoundingSphere::MakeFromCenterAndRadius(vCenter, 100.0f), queryParams, countFunc);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: %u sphere queries, %u objects found: %.2fms", szName, uiNumQueries, uiNumFound, sw.Checkpoint().GetMilliseconds());
+
+    ezDynamicArray<const ezGameObject*> visibleObjects;
+    uiNumFound = 0;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      const ezAngle angle = ezAngle::MakeFromDegree(i * 3.6f);
+      const ezVec3 vDir(ezMath::Cos(angle), ezMath::Sin(angle), 0.0f);
+
+      ezFrustum frustum = ezFrustum::MakeFromFOV(ezVec3::MakeZero(), vDir, ezVec3(0, 0, 1), ezAngle::MakeFromDegree(90), ezAngle::MakeFromDegree(90), 0.1f, 1000.0f);
+
+      visibleObjects.Clear();
+      ref_system.FindVisibleObjects(frustum, queryParams, visibleObjects, {}, ezVisibilityState::Direct);
+      uiNumFound += visibleObjects.GetCount();
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: 100 frustum queries, %u objects found: %.2fms", szName, uiNumFound, sw.Checkpoint().GetMilliseconds());
+
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      ref_system.DeleteSpatialData(handles[i]);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: Deleting %u objects: %.2fms", szName, uiNumObjects, sw.Checkpoint().GetMilliseconds());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, Profile_SpatialSystem)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Regular Grid")
+  {
+    ezUniquePtr<ezSpatialSystem> pSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_RegularGrid);
+    MeasureSpatialSystem(*pSystem, "Regular Grid");
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "BVH")
+  {
+    ezUniquePtr<ezSpatialSystem> pSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_BVH);
+    MeasureSpatialSystem(*pSystem, "BVH");
+  }
+}
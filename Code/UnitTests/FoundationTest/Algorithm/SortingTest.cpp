@@ -1,6 +1,7 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Time/Stopwatch.h>
 
 namespace
 {
@@ -11,8 +12,49 @@ namespace
     // Comparision via operator. Sorting algorithm should prefer Less operator
     bool operator()(ezInt32 a, ezInt32 b) const { return a < b; }
   };
+
+  struct SortableItem
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt64 m_uiKey;
+    ezUInt32 m_uiOriginalIndex;
+  };
+
+  void CreateSortableItems(ezDynamicArray<SortableItem>& out_items, ezUInt32 uiCount, ezUInt64 uiKeyMask)
+  {
+    ezUInt64 uiSeed = 0x9E3779B97F4A7C15ull;
+
+    out_items.SetCountUninitialized(uiCount);
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      uiSeed = uiSeed * 6364136223846793005ull + 1442695040888963407ull;
+      out_items[i].m_uiKey = (uiSeed ^ (uiSeed >> 29)) & uiKeyMask;
+      out_items[i].m_uiOriginalIndex = i;
+    }
+  }
+
+  bool IsStablySorted(const ezDynamicArray<SortableItem>& items)
+  {
+    for (ezUInt32 i = 1; i < items.GetCount(); ++i)
+    {
+      const SortableItem& a = items[i - 1];
+      const SortableItem& b = items[i];
+
+      if (a.m_uiKey > b.m_uiKey || (a.m_uiKey == b.m_uiKey && a.m_uiOriginalIndex > b.m_uiOriginalIndex))
+        return false;
+    }
+
+    return true;
+  }
 } // namespace
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum SortingBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum SortingBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
 EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
 {
   ezDynamicArray<ezInt32> a1;
@@ -53,4 +95,75 @@ EZ_CREATE_SIMPLE_TEST(Algorithm, Sorting)
       EZ_TEST_BOOL(a2[i - 1] >= a2[i]);
     }
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RadixSort")
+  {
+    auto GetKey = [](const SortableItem& item)
+    { return item.m_uiKey; };
+
+    // small arrays use insertion sort, the masks produce many duplicates and constant digits
+    const ezUInt32 counts[] = {0, 1, 50, 1000, 100000};
+    const ezUInt64 masks[] = {0xFFFFFFFFFFFFFFFFull, 0xFFull, 0xFF00FF0000ull, 0};
+
+    for (ezUInt32 uiCount : counts)
+    {
+      for (ezUInt64 uiMask : masks)
+      {
+        ezDynamicArray<SortableItem> items;
+        CreateSortableItems(items, uiCount, uiMask);
+        ezSorting::RadixSort(items, GetKey);
+        EZ_TEST_BOOL_MSG(IsStablySorted(items), "Count: %u, Mask: %llx", uiCount, uiMask);
+
+        CreateSortableItems(items, uiCount, uiMask);
+        ezSorting::RadixSort(items, GetKey, true);
+        EZ_TEST_BOOL_MSG(IsStablySorted(items), "Multi-threaded, Count: %u, Mask: %llx", uiCount, uiMask);
+      }
+    }
+
+    ezDynamicArray<ezUInt32> values;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      values.PushBack(rand() % 100000);
+    }
+
+    ezDynamicArray<ezUInt32> scratch;
+    scratch.SetCountUninitialized(values.GetCount());
+
+    ezSorting::RadixSort(values.GetArrayPtr(), scratch.GetArrayPtr(), [](ezUInt32 uiValue)
+      { return uiValue; });
+
+    for (ezUInt32 i = 1; i < values.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(values[i - 1] <= values[i]);
+    }
+  }
+
+  EZ_TEST_BLOCK(SortingBenchmarkEnabled, "RadixSort vs. QuickSort")
+  {
+    const ezUInt32 uiCount = 100000;
+
+    ezDynamicArray<SortableItem> items;
+
+    ezTime durations[3];
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      CreateSortableItems(items, uiCount, 0xFFFFFFFFFFFFFFFFull);
+
+      ezStopwatch sw;
+      if (i == 0)
+      {
+        ezSorting::QuickSort(items, [](const SortableItem& a, const SortableItem& b)
+          { return a.m_uiKey < b.m_uiKey; });
+      }
+      else
+      {
+        ezSorting::RadixSort(items, [](const SortableItem& item)
+          { return item.m_uiKey; }, i == 2);
+      }
+      durations[i] = sw.GetRunningTotal();
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Sorting %u items: QuickSort %.2fms, RadixSort %.2fms, RadixSort multi-threaded %.2fms", uiCount,
+      durations[0].GetMilliseconds(), durations[1].GetMilliseconds(), durations[2].GetMilliseconds());
+  }
 }
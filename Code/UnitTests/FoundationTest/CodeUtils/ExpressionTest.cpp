@@ -7,6 +7,9 @@
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Math/Float16.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/UniquePtr.h>
 
 namespace
@@ -403,6 +406,75 @@ namespace
     }
   }
 
+  static const char* s_szManyInstancesCode = "var x = a * b + c\n"
+                                             "var y = sqrt(abs(x)) * d\n"
+                                             "var z = max(x, y) - min(a, c) * 0.5\n"
+                                             "output = z * z + floor(y)";
+
+  static float ManyInstancesReference(float a, float b, float c, float d)
+  {
+    const float x = a * b + c;
+    const float y = ezMath::Sqrt(ezMath::Abs(x)) * d;
+    const float z = ezMath::Max(x, y) - ezMath::Min(a, c) * 0.5f;
+    return z * z + ezMath::Floor(y);
+  }
+
+  static void FillManyInstancesInputs(ezDynamicArray<float>& out_a, ezDynamicArray<float>& out_b, ezDynamicArray<float>& out_c, ezDynamicArray<float>& out_d, ezUInt32 uiCount)
+  {
+    out_a.SetCountUninitialized(uiCount);
+    out_b.SetCountUninitialized(uiCount);
+    out_c.SetCountUninitialized(uiCount);
+    out_d.SetCountUninitialized(uiCount);
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      out_a[i] = static_cast<float>(i % 101) * 0.25f - 10.0f;
+      out_b[i] = static_cast<float>(i % 37) * 0.5f;
+      out_c[i] = static_cast<float>(i % 13) - 6.0f;
+      out_d[i] = static_cast<float>(i % 7) * 0.125f;
+    }
+  }
+
+  static ezResult ExecuteManyInstances(const ezExpressionByteCode& byteCode, ezDynamicArray<float>& ref_a, ezDynamicArray<float>& ref_b, ezDynamicArray<float>& ref_c, ezDynamicArray<float>& ref_d, ezDynamicArray<float>& ref_output, ezBitflags<ezExpressionVM::Flags> flags)
+  {
+    ezProcessingStream inputs[] = {
+      ezProcessingStream(s_sA, ref_a.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sB, ref_b.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sC, ref_c.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+      ezProcessingStream(s_sD, ref_d.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    ezProcessingStream outputs[] = {
+      ezProcessingStream(s_sOutput, ref_output.GetByteArrayPtr(), ezProcessingStream::DataType::Float),
+    };
+
+    return s_pVM->Execute(byteCode, inputs, outputs, ref_a.GetCount(), ezExpression::GlobalData(), flags);
+  }
+
+  static void TestManyInstances(const ezExpressionByteCode& byteCode, ezUInt32 uiCount, ezBitflags<ezExpressionVM::Flags> flags)
+  {
+    ezDynamicArray<float> a, b, c, d, o;
+    FillManyInstancesInputs(a, b, c, d, uiCount);
+
+    // one more element than needed, to detect writes past the end
+    o.SetCount(uiCount + 1, -1.0f);
+
+    EZ_TEST_BOOL(ExecuteManyInstances(byteCode, a, b, c, d, o, flags).Succeeded());
+
+    ezUInt32 uiNumErrors = 0;
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const float fExpected = ManyInstancesReference(a[i], b[i], c[i], d[i]);
+      if (!ezMath::IsEqual(o[i], fExpected, ezMath::Max(1.0f, ezMath::Abs(fExpected)) * 0.0001f))
+      {
+        ++uiNumErrors;
+      }
+    }
+
+    EZ_TEST_INT(uiNumErrors, 0);
+    EZ_TEST_FLOAT(o[uiCount], -1.0f, 0.0f);
+  }
+
   static const ezEnum<ezExpression::RegisterType> s_TestFunc1InputTypes[] = {ezExpression::RegisterType::Float, ezExpression::RegisterType::Int};
   static const ezEnum<ezExpression::RegisterType> s_TestFunc2InputTypes[] = {ezExpression::RegisterType::Float, ezExpression::RegisterType::Float, ezExpression::RegisterType::Int};
 
@@ -469,6 +541,12 @@ namespace
 
 } // namespace
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum ExpressionBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum ExpressionBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
 EZ_CREATE_SIMPLE_TEST(CodeUtils, Expression)
 {
   s_uiNumByteCodeComparisons = 0;
@@ -1192,4 +1270,71 @@ EZ_CREATE_SIMPLE_TEST(CodeUtils, Expression)
     Compile<ezVec3>(testCode, testByteCode);
     EZ_TEST_VEC3(Execute<ezVec3>(testByteCode), ezVec3(61, 54, 54), ezMath::DefaultEpsilon<float>());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Many instances")
+  {
+    ezExpressionByteCode testByteCode;
+    Compile<float>(s_szManyInstancesCode, testByteCode);
+
+    const ezUInt32 uiCounts[] = {1, 3, 8, 255, 256, 257, 1029, 100003};
+    for (ezUInt32 uiCount : uiCounts)
+    {
+      TestManyInstances(testByteCode, uiCount, ezExpressionVM::Flags::Default);
+      TestManyInstances(testByteCode, uiCount, ezExpressionVM::Flags::BestPerformance);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Many instances in a task that must not wait")
+  {
+    ezExpressionByteCode testByteCode;
+    Compile<float>(s_szManyInstancesCode, testByteCode);
+
+    constexpr ezUInt32 uiCount = 100003;
+
+    ezDynamicArray<float> a, b, c, d, o;
+    FillManyInstancesInputs(a, b, c, d, uiCount);
+    o.SetCount(uiCount);
+
+    // BestPerformance would split the work across tasks, which this task isn't allowed to wait for
+    ezResult result = EZ_FAILURE;
+    ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "ExpressionNeverNesting", ezTaskNesting::Never, [&]()
+      { result = ExecuteManyInstances(testByteCode, a, b, c, d, o, ezExpressionVM::Flags::BestPerformance); });
+
+    ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::EarlyThisFrame));
+
+    EZ_TEST_BOOL(result.Succeeded());
+
+    ezUInt32 uiNumErrors = 0;
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const float fExpected = ManyInstancesReference(a[i], b[i], c[i], d[i]);
+      if (!ezMath::IsEqual(o[i], fExpected, ezMath::Max(1.0f, ezMath::Abs(fExpected)) * 0.0001f))
+      {
+        ++uiNumErrors;
+      }
+    }
+
+    EZ_TEST_INT(uiNumErrors, 0);
+  }
+
+  EZ_TEST_BLOCK(ExpressionBenchmarkEnabled, "Benchmark")
+  {
+    ezExpressionByteCode testByteCode;
+    Compile<float>(s_szManyInstancesCode, testByteCode);
+
+    constexpr ezUInt32 uiCount = 1000000;
+
+    ezDynamicArray<float> a, b, c, d, o;
+    FillManyInstancesInputs(a, b, c, d, uiCount);
+    o.SetCount(uiCount);
+
+    ezStopwatch sw;
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      ExecuteManyInstances(testByteCode, a, b, c, d, o, ezExpressionVM::Flags::BestPerformance).IgnoreResult();
+    }
+    const ezTime duration = sw.GetRunningTotal();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u instances, %u instructions: %.2fms", uiCount, testByteCode.GetNumInstructions(), duration.GetMilliseconds() / 10.0);
+  }
 }
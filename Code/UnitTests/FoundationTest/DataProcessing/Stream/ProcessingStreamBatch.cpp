@@ -0,0 +1,295 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/DataProcessing/Stream/ProcessingStreamBatchIterator.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamGroup.h>
+#include <Foundation/DataProcessing/Stream/ProcessingStreamIterator.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  void FillLifeTimes(ezProcessingStream* pStream, ezUInt32 uiNumElements)
+  {
+    ezFloat16Vec2* pData = pStream->GetWritableData<ezFloat16Vec2>();
+    for (ezUInt32 i = 0; i < uiNumElements; ++i)
+    {
+      const float fMaxLifeTime = 1.0f + (i % 7);
+      pData[i] = ezVec2(fMaxLifeTime * (i % 13) / 13.0f, 1.0f / fMaxLifeTime);
+    }
+  }
+
+  void AddScalar(ezProcessingStream* pStream, ezUInt64 uiNumElements, const ezVec3& vAdd)
+  {
+    ezProcessingStreamIterator<ezVec3> it(pStream, uiNumElements, 0);
+    while (!it.HasReachedEnd())
+    {
+      it.Current() += vAdd;
+      it.Advance();
+    }
+  }
+
+  void AddBatch(ezProcessingStream* pStream, ezUInt64 uiNumElements, const ezVec3& vAdd)
+  {
+    const ezSimdVec4f vAdd0(vAdd.x, vAdd.y, vAdd.z, vAdd.x);
+    const ezSimdVec4f vAdd1(vAdd.y, vAdd.z, vAdd.x, vAdd.y);
+    const ezSimdVec4f vAdd2(vAdd.z, vAdd.x, vAdd.y, vAdd.z);
+
+    ezProcessingStreamBatchIterator<ezVec3> it(pStream, uiNumElements, 0);
+    while (!it.HasReachedEnd())
+    {
+      if (it.IsContiguous())
+      {
+        ezSimdVec4f v0, v1, v2;
+        ezProcessingStreamBatch::LoadInterleaved(it, v0, v1, v2);
+        ezProcessingStreamBatch::StoreInterleaved(it, v0 + vAdd0, v1 + vAdd1, v2 + vAdd2);
+      }
+      else
+      {
+        ezSimdVec4f x, y, z;
+        ezProcessingStreamBatch::Load(it, x, y, z);
+        ezProcessingStreamBatch::Store(it, x + ezSimdVec4f(vAdd.x), y + ezSimdVec4f(vAdd.y), z + ezSimdVec4f(vAdd.z));
+      }
+
+      it.Advance();
+    }
+  }
+
+  void ComputeSizeScalar(ezProcessingStream* pLifeTime, ezProcessingStream* pSize, ezUInt64 uiNumElements)
+  {
+    ezProcessingStreamIterator<ezFloat16Vec2> itLifeTime(pLifeTime, uiNumElements, 0);
+    ezProcessingStreamIterator<ezFloat16> itSize(pSize, uiNumElements, 0);
+    while (!itLifeTime.HasReachedEnd())
+    {
+      const float fLifeTimeFraction = 1.0f - (itLifeTime.Current().x * itLifeTime.Current().y);
+      itSize.Current() = 0.5f + fLifeTimeFraction * 2.0f;
+
+      itLifeTime.Advance();
+      itSize.Advance();
+    }
+  }
+
+  void ComputeSizeBatch(ezProcessingStream* pLifeTime, ezProcessingStream* pSize, ezUInt64 uiNumElements)
+  {
+    ezProcessingStreamBatchIterator<ezFloat16Vec2> itLifeTime(pLifeTime, uiNumElements, 0);
+    ezProcessingStreamBatchIterator<ezFloat16> itSize(pSize, uiNumElements, 0);
+    while (!itLifeTime.HasReachedEnd())
+    {
+      ezSimdVec4f x, y;
+      ezProcessingStreamBatch::Load(itLifeTime, x, y);
+
+      const ezSimdVec4f vLifeTimeFraction = ezSimdVec4f(1.0f) - x.CompMul(y);
+      ezProcessingStreamBatch::Store(itSize, ezSimdVec4f(0.5f) + vLifeTimeFraction * ezSimdFloat(2.0f));
+
+      itLifeTime.Advance();
+      itSize.Advance();
+    }
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableBatchBenchmarkInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableBatchBenchmarkInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(DataProcessing, ProcessingStreamBatch)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Block iteration")
+  {
+    ezProcessingStreamGroup group;
+    ezProcessingStream* pStream = group.AddStream("Float", ezProcessingStream::DataType::Float);
+    group.SetSize(16);
+    group.Process(); // allocates the stream data
+
+    ezHybridArray<ezUInt32, 8> blockSizes;
+    for (ezProcessingStreamBatchIterator<float> it(pStream, 10, 0); !it.HasReachedEnd(); it.Advance())
+    {
+      blockSizes.PushBack(it.GetNumElements());
+    }
+
+    EZ_TEST_INT(blockSizes.GetCount(), 3);
+    EZ_TEST_INT(blockSizes[0], 4);
+    EZ_TEST_INT(blockSizes[1], 4);
+    EZ_TEST_INT(blockSizes[2], 2);
+
+    float* pData = pStream->GetWritableData<float>();
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      pData[i] = (float)i;
+    }
+
+    // every third element, starting at index 1, up to index 10
+    ezProcessingStreamBatchIterator<float> it(pStream, 10, 1, 3);
+    EZ_TEST_INT(it.GetNumElements(), 4);
+    EZ_TEST_BOOL(!it.IsContiguous());
+    EZ_TEST_FLOAT(it.Element(0), 1.0f, 0.0f);
+    EZ_TEST_FLOAT(it.Element(3), 10.0f, 0.0f);
+
+    ezProcessingStreamBatch::Store(it, ezSimdVec4f(-1.0f));
+    it.Advance();
+    EZ_TEST_BOOL(it.HasReachedEnd());
+
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      const bool bWritten = i >= 1 && i <= 10 && (i - 1) % 3 == 0;
+      EZ_TEST_FLOAT(pData[i], bWritten ? -1.0f : (float)i, 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Strided stream")
+  {
+    struct Interleaved
+    {
+      float m_fValue;
+      float m_fOther;
+    };
+
+    Interleaved data[8];
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      data[i].m_fValue = (float)i;
+      data[i].m_fOther = -1.0f;
+    }
+
+    // every value is followed by data of another stream, so a full block must not be treated as contiguous
+    ezProcessingStream stream(ezMakeHashedString("Value"), ezArrayPtr<ezUInt8>(reinterpret_cast<ezUInt8*>(data), sizeof(data)), ezProcessingStream::DataType::Float, sizeof(Interleaved));
+
+    ezProcessingStreamBatchIterator<float> it(&stream, 8, 0);
+    EZ_TEST_INT(it.GetNumElements(), 4);
+    EZ_TEST_BOOL(!it.IsContiguous());
+    EZ_TEST_BOOL((ezProcessingStreamBatch::Load(it) == ezSimdVec4f(0.0f, 1.0f, 2.0f, 3.0f)).AllSet());
+
+    it.Advance();
+    EZ_TEST_BOOL((ezProcessingStreamBatch::Load(it) == ezSimdVec4f(4.0f, 5.0f, 6.0f, 7.0f)).AllSet());
+    ezProcessingStreamBatch::Store(it, ezSimdVec4f(10.0f));
+
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      EZ_TEST_FLOAT(data[i].m_fValue, i < 4 ? (float)i : 10.0f, 0.0f);
+      EZ_TEST_FLOAT(data[i].m_fOther, -1.0f, 0.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Load / Store")
+  {
+    ezProcessingStreamGroup group;
+    ezProcessingStream* pVec3 = group.AddStream("Vec3", ezProcessingStream::DataType::Float3);
+    ezProcessingStream* pHalf = group.AddStream("Half", ezProcessingStream::DataType::Half);
+    ezProcessingStream* pHalf2 = group.AddStream("Half2", ezProcessingStream::DataType::Half2);
+    group.SetSize(8);
+    group.Process(); // allocates the stream data
+
+    ezVec3* pVec3Data = pVec3->GetWritableData<ezVec3>();
+    ezFloat16* pHalfData = pHalf->GetWritableData<ezFloat16>();
+    ezFloat16Vec2* pHalf2Data = pHalf2->GetWritableData<ezFloat16Vec2>();
+    for (ezUInt32 i = 0; i < 8; ++i)
+    {
+      pVec3Data[i].Set((float)i, i * 10.0f, i * 100.0f);
+      pHalfData[i] = i * 0.5f;
+      pHalf2Data[i] = ezVec2((float)i, -(float)i);
+    }
+
+    // a partial block, the remaining lanes have to be zero and must not be written
+    ezProcessingStreamBatchIterator<ezVec3> itVec3(pVec3, 3, 5);
+    ezSimdVec4f x, y, z;
+    ezProcessingStreamBatch::Load(itVec3, x, y, z);
+    EZ_TEST_BOOL((x == ezSimdVec4f(5.0f, 6.0f, 7.0f, 0.0f)).AllSet());
+    EZ_TEST_BOOL((y == ezSimdVec4f(50.0f, 60.0f, 70.0f, 0.0f)).AllSet());
+    EZ_TEST_BOOL((z == ezSimdVec4f(500.0f, 600.0f, 700.0f, 0.0f)).AllSet());
+
+    ezProcessingStreamBatch::Store(itVec3, z, x, y);
+    EZ_TEST_VEC3(pVec3Data[4], ezVec3(4.0f, 40.0f, 400.0f), 0.0f);
+    EZ_TEST_VEC3(pVec3Data[5], ezVec3(500.0f, 5.0f, 50.0f), 0.0f);
+    EZ_TEST_VEC3(pVec3Data[7], ezVec3(700.0f, 7.0f, 70.0f), 0.0f);
+
+    ezProcessingStreamBatchIterator<ezVec3> itInterleaved(pVec3, 8, 0);
+    EZ_TEST_BOOL(itInterleaved.IsContiguous());
+    ezSimdVec4f v0, v1, v2;
+    ezProcessingStreamBatch::LoadInterleaved(itInterleaved, v0, v1, v2);
+    EZ_TEST_BOOL((v0 == ezSimdVec4f(0.0f, 0.0f, 0.0f, 1.0f)).AllSet());
+    EZ_TEST_BOOL((v2 == ezSimdVec4f(200.0f, 3.0f, 30.0f, 300.0f)).AllSet());
+    ezProcessingStreamBatch::StoreInterleaved(itInterleaved, v0, v1 + ezSimdVec4f(1.0f), v2);
+    EZ_TEST_VEC3(pVec3Data[1], ezVec3(1.0f, 11.0f, 101.0f), 0.0f);
+    EZ_TEST_VEC3(pVec3Data[2], ezVec3(3.0f, 21.0f, 200.0f), 0.0f);
+
+    ezProcessingStreamBatchIterator<ezFloat16> itHalf(pHalf, 8, 0);
+    EZ_TEST_BOOL(itHalf.IsContiguous());
+    EZ_TEST_BOOL((ezProcessingStreamBatch::Load(itHalf) == ezSimdVec4f(0.0f, 0.5f, 1.0f, 1.5f)).AllSet());
+    ezProcessingStreamBatch::Store(itHalf, ezSimdVec4f(4.0f, 3.0f, 2.0f, 1.0f));
+    EZ_TEST_FLOAT(pHalfData[0], 4.0f, 0.0f);
+    EZ_TEST_FLOAT(pHalfData[3], 1.0f, 0.0f);
+    EZ_TEST_FLOAT(pHalfData[4], 2.0f, 0.0f);
+
+    ezProcessingStreamBatchIterator<ezFloat16Vec2> itHalf2(pHalf2, 8, 0);
+    itHalf2.Advance();
+    ezSimdVec4f hx, hy;
+    ezProcessingStreamBatch::Load(itHalf2, hx, hy);
+    EZ_TEST_BOOL((hx == ezSimdVec4f(4.0f, 5.0f, 6.0f, 7.0f)).AllSet());
+    EZ_TEST_BOOL((hy == ezSimdVec4f(-4.0f, -5.0f, -6.0f, -7.0f)).AllSet());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scalar and batch kernels match")
+  {
+    constexpr ezUInt32 uiNumElements = 1023;
+
+    ezProcessingStreamGroup group;
+    ezProcessingStream* pVelocityScalar = group.AddStream("VelocityScalar", ezProcessingStream::DataType::Float3);
+    ezProcessingStream* pVelocityBatch = group.AddStream("VelocityBatch", ezProcessingStream::DataType::Float3);
+    ezProcessingStream* pLifeTime = group.AddStream("LifeTime", ezProcessingStream::DataType::Half2);
+    ezProcessingStream* pSizeScalar = group.AddStream("SizeScalar", ezProcessingStream::DataType::Half);
+    ezProcessingStream* pSizeBatch = group.AddStream("SizeBatch", ezProcessingStream::DataType::Half);
+    group.SetSize(uiNumElements);
+    group.Process(); // allocates the stream data
+
+    for (ezUInt32 i = 0; i < uiNumElements; ++i)
+    {
+      pVelocityScalar->GetWritableData<ezVec3>()[i].Set((float)i, 1.0f, -(float)i);
+      pVelocityBatch->GetWritableData<ezVec3>()[i].Set((float)i, 1.0f, -(float)i);
+    }
+
+    FillLifeTimes(pLifeTime, uiNumElements);
+
+    AddScalar(pVelocityScalar, uiNumElements, ezVec3(0.1f, 0.2f, -9.81f));
+    AddBatch(pVelocityBatch, uiNumElements, ezVec3(0.1f, 0.2f, -9.81f));
+    EZ_TEST_INT(ezMemoryUtils::RawByteCompare(pVelocityScalar->GetData(), pVelocityBatch->GetData(), uiNumElements * sizeof(ezVec3)), 0);
+
+    ComputeSizeScalar(pLifeTime, pSizeScalar, uiNumElements);
+    ComputeSizeBatch(pLifeTime, pSizeBatch, uiNumElements);
+    EZ_TEST_INT(ezMemoryUtils::RawByteCompare(pSizeScalar->GetData(), pSizeBatch->GetData(), uiNumElements * sizeof(ezFloat16)), 0);
+  }
+
+  EZ_TEST_BLOCK(EnableBatchBenchmarkInRelease, "Scalar vs. batch performance")
+  {
+    constexpr ezUInt32 uiNumElements = 100000;
+    constexpr ezUInt32 uiNumIterations = 100;
+
+    ezProcessingStreamGroup group;
+    ezProcessingStream* pVelocity = group.AddStream("Velocity", ezProcessingStream::DataType::Float3);
+    ezProcessingStream* pLifeTime = group.AddStream("LifeTime", ezProcessingStream::DataType::Half2);
+    ezProcessingStream* pSize = group.AddStream("Size", ezProcessingStream::DataType::Half);
+    group.SetSize(uiNumElements);
+    group.Process(); // allocates the stream data
+
+    ezMemoryUtils::ZeroFill(pVelocity->GetWritableData<ezVec3>(), uiNumElements);
+    FillLifeTimes(pLifeTime, uiNumElements);
+
+    auto Measure = [&](const char* szName, auto func)
+    {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      {
+        func();
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: %.3f ms per %u elements", szName, sw.GetRunningTotal().GetMilliseconds() / uiNumIterations, uiNumElements);
+    };
+
+    Measure("Add vec3 (scalar)", [&]()
+      { AddScalar(pVelocity, uiNumElements, ezVec3(0.0f, 0.0f, -0.01f)); });
+    Measure("Add vec3 (batch)", [&]()
+      { AddBatch(pVelocity, uiNumElements, ezVec3(0.0f, 0.0f, -0.01f)); });
+    Measure("Lifetime to size (scalar)", [&]()
+      { ComputeSizeScalar(pLifeTime, pSize, uiNumElements); });
+    Measure("Lifetime to size (batch)", [&]()
+      { ComputeSizeBatch(pLifeTime, pSize, uiNumElements); });
+  }
+}
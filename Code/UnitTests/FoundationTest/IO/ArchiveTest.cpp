@@ -1,6 +1,9 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveChunkedReaderZstd.h>
+#include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/Archive/DataDirTypeArchive.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
@@ -159,3 +162,189 @@ EZ_CREATE_SIMPLE_TEST(IO, Archive)
 }
 
 #endif
+
+#if (EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) && EZ_ENABLED(EZ_SUPPORTS_FILE_STATS) && EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE))
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveBuilder)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveBuilderTest");
+  sOutputFolder.MakeCleanPath();
+
+  // make sure it is empty
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveBuilder", "output", ezDataDirUsage::AllowWrites).Succeeded()))
+    return;
+
+  // the number of ezUInt64 values in each file
+  // 'Large' spans multiple chunks and ends with a partial chunk, 'Random' does not compress at all
+  const char* szFileList[] = {"Empty.txt", "Small.txt", "Large.txt", "Random.bin"};
+  const ezUInt32 uiFileValues[] = {0, 1024, (ezArchiveUtils::ArchiveChunkSize / 8) * 3 + 1000, (ezArchiveUtils::ArchiveChunkSize / 8) * 2};
+
+  auto GetValue = [](ezUInt32 uiFileIdx, ezUInt64 uiIndex) -> ezUInt64
+  {
+    if (uiFileIdx != 3)
+      return uiIndex;
+
+    // splitmix64
+    ezUInt64 z = (uiIndex + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  };
+
+  ezArchiveBuilder builder;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Generate Data")
+  {
+    ezStringBuilder fileName;
+
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < EZ_ARRAY_SIZE(szFileList); ++uiFileIdx)
+    {
+      fileName.Set(":output/Data/", szFileList[uiFileIdx]);
+
+      {
+        ezFileWriter file;
+        if (!EZ_TEST_BOOL(file.Open(fileName).Succeeded()))
+          return;
+
+        for (ezUInt32 i = 0; i < uiFileValues[uiFileIdx]; ++i)
+        {
+          file << GetValue(uiFileIdx, i);
+        }
+      }
+
+      fileName.Set(sOutputFolder, "/Data/", szFileList[uiFileIdx]);
+
+      auto& e = builder.m_Entries.ExpandAndGetRef();
+      e.m_sAbsSourcePath = fileName;
+      e.m_sRelTargetPath = szFileList[uiFileIdx];
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      e.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+      e.m_iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Fast);
+#  endif
+    }
+  }
+
+  const ezStringBuilder sArchiveFile(sOutputFolder, "/Data.ezArchive");
+  const ezStringBuilder sArchiveFile2(sOutputFolder, "/Data2.ezArchive");
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Write Archive")
+  {
+    EZ_TEST_BOOL(builder.WriteArchive(":output/Data.ezArchive").Succeeded());
+    EZ_TEST_BOOL(builder.WriteArchive(":output/Data2.ezArchive").Succeeded());
+
+    // the entries are processed in parallel, but the output must not depend on the scheduling
+    EZ_TEST_FILES(sArchiveFile, sArchiveFile2, "Archives must be deterministic");
+  }
+
+  ezArchiveReader reader;
+  if (!EZ_TEST_BOOL(reader.OpenArchive(sArchiveFile).Succeeded()))
+    return;
+
+  const ezArchiveTOC& toc = reader.GetArchiveTOC();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compression Modes")
+  {
+    EZ_TEST_INT(toc.m_Entries.GetCount(), EZ_ARRAY_SIZE(szFileList));
+    EZ_TEST_BOOL(toc.m_Entries[toc.FindEntry("Empty.txt")].m_CompressionMode == ezArchiveCompressionMode::Uncompressed);
+    EZ_TEST_BOOL(toc.m_Entries[toc.FindEntry("Random.bin")].m_CompressionMode == ezArchiveCompressionMode::Uncompressed);
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    EZ_TEST_BOOL(toc.m_Entries[toc.FindEntry("Small.txt")].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd);
+    EZ_TEST_BOOL(toc.m_Entries[toc.FindEntry("Large.txt")].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_chunked);
+#  endif
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Entries")
+  {
+    for (ezUInt32 uiFileIdx = 0; uiFileIdx < EZ_ARRAY_SIZE(szFileList); ++uiFileIdx)
+    {
+      const ezUInt32 uiEntry = toc.FindEntry(szFileList[uiFileIdx]);
+      if (!EZ_TEST_BOOL(uiEntry != ezInvalidIndex))
+        continue;
+
+      EZ_TEST_INT(toc.m_Entries[uiEntry].m_uiUncompressedDataSize, uiFileValues[uiFileIdx] * sizeof(ezUInt64));
+
+      ezUniquePtr<ezStreamReader> pReader = reader.CreateEntryReader(uiEntry);
+
+      bool bAllEqual = true;
+      for (ezUInt32 i = 0; i < uiFileValues[uiFileIdx]; ++i)
+      {
+        ezUInt64 uiValue = 0;
+        *pReader >> uiValue;
+        bAllEqual &= (uiValue == GetValue(uiFileIdx, i));
+      }
+
+      EZ_TEST_BOOL_MSG(bAllEqual, "Content of '%s' differs", szFileList[uiFileIdx]);
+
+      ezUInt8 uiEnd = 0;
+      EZ_TEST_INT(pReader->ReadBytes(&uiEnd, 1), 0);
+    }
+  }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Seek in Chunked Entry")
+  {
+    const ezUInt32 uiFileIdx = 2;
+    ezUniquePtr<ezStreamReader> pReader = reader.CreateEntryReader(toc.FindEntry(szFileList[uiFileIdx]));
+    ezArchiveChunkedReaderZstd* pChunkedReader = static_cast<ezArchiveChunkedReaderZstd*>(pReader.Borrow());
+
+    ezUInt64 uiValue = 0;
+
+    // skipping into the third chunk must only decompress that chunk
+    const ezUInt64 uiSkipValues = (ezArchiveUtils::ArchiveChunkSize / 8) * 2 + 17;
+    EZ_TEST_INT(pChunkedReader->SkipBytes(uiSkipValues * 8), uiSkipValues * 8);
+    EZ_TEST_INT(pChunkedReader->GetNumDecompressedChunks(), 0);
+
+    *pChunkedReader >> uiValue;
+    EZ_TEST_INT(uiValue, GetValue(uiFileIdx, uiSkipValues));
+    EZ_TEST_INT(pChunkedReader->GetNumDecompressedChunks(), 1);
+
+    // reading across the chunk border decompresses the next chunk
+    pChunkedReader->SetReadPosition(ezArchiveUtils::ArchiveChunkSize * 3 - 8);
+    *pChunkedReader >> uiValue;
+    EZ_TEST_INT(uiValue, GetValue(uiFileIdx, (ezArchiveUtils::ArchiveChunkSize / 8) * 3 - 1));
+    *pChunkedReader >> uiValue;
+    EZ_TEST_INT(uiValue, GetValue(uiFileIdx, (ezArchiveUtils::ArchiveChunkSize / 8) * 3));
+    EZ_TEST_INT(pChunkedReader->GetNumDecompressedChunks(), 2);
+
+    // seeking backwards
+    pChunkedReader->SetReadPosition(8 * 5);
+    *pChunkedReader >> uiValue;
+    EZ_TEST_INT(uiValue, GetValue(uiFileIdx, 5));
+    EZ_TEST_INT(pChunkedReader->GetNumDecompressedChunks(), 3);
+
+    // skipping past the end is clamped
+    EZ_TEST_INT(pChunkedReader->SkipBytes(ezArchiveUtils::ArchiveChunkSize * 10), (uiFileValues[uiFileIdx] - 6) * 8);
+    EZ_TEST_INT(pChunkedReader->GetNumDecompressedChunks(), 3);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mount as Data Dir")
+  {
+    if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchiveFile, "ArchiveBuilder", "archive", ezDataDirUsage::ReadOnly) == EZ_SUCCESS))
+      return;
+
+    const ezUInt32 uiFileIdx = 2;
+
+    ezFileReader file;
+    if (!EZ_TEST_BOOL(file.Open(":archive/Large.txt").Succeeded()))
+      return;
+
+    EZ_TEST_INT(file.GetFileSize(), uiFileValues[uiFileIdx] * 8);
+
+    const ezUInt64 uiSkipValues = uiFileValues[uiFileIdx] - 10;
+    EZ_TEST_INT(file.SkipBytes(uiSkipValues * 8), uiSkipValues * 8);
+
+    ezUInt64 uiValue = 0;
+    file >> uiValue;
+    EZ_TEST_INT(uiValue, GetValue(uiFileIdx, uiSkipValues));
+  }
+#  endif
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveBuilder");
+}
+
+#endif
@@ -0,0 +1,196 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Texture/Image/ImageConversion.h>
+#include <Texture/Image/ImageUtils.h>
+#include <Texture/TexConv/TexConvProcessor.h>
+
+namespace
+{
+  /// Creates a deterministic RGBA float image with gradients, noise and fully transparent areas.
+  void CreateTestImage(ezImage& out_image, ezUInt32 uiWidth, ezUInt32 uiHeight)
+  {
+    ezImageHeader header;
+    header.SetWidth(uiWidth);
+    header.SetHeight(uiHeight);
+    header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+    out_image.ResetAndAlloc(header);
+
+    ezUInt32 uiSeed = 12345;
+    for (ezUInt32 y = 0; y < uiHeight; ++y)
+    {
+      for (ezUInt32 x = 0; x < uiWidth; ++x)
+      {
+        uiSeed = uiSeed * 1664525u + 1013904223u;
+
+        ezColor& col = *out_image.GetPixelPointer<ezColor>(0, 0, 0, x, y);
+        col.r = static_cast<float>(x) / uiWidth;
+        col.g = static_cast<float>(y) / uiHeight;
+        col.b = static_cast<float>(uiSeed >> 8) / static_cast<float>(1u << 24);
+        col.a = ((x / 37 + y / 29) % 5 == 0) ? 0.0f : col.b;
+      }
+    }
+  }
+
+  bool IsBitIdentical(const ezImageView& a, const ezImageView& b)
+  {
+    if (a.GetImageFormat() != b.GetImageFormat() || a.GetNumMipLevels() != b.GetNumMipLevels())
+      return false;
+
+    const ezConstByteBlobPtr dataA = a.GetByteBlobPtr();
+    const ezConstByteBlobPtr dataB = b.GetByteBlobPtr();
+    return dataA.GetCount() == dataB.GetCount() && ezMemoryUtils::IsEqual(dataA.GetPtr(), dataB.GetPtr(), static_cast<size_t>(dataA.GetCount()));
+  }
+
+  /// Runs the given operation once single-threaded and once multi-threaded and returns whether both results are identical.
+  template <typename Func>
+  bool CompareSerialAndParallel(Func func)
+  {
+    ezImage serial, parallel;
+
+    ezImageUtils::SetMultiThreadingEnabled(false);
+    func(serial);
+    ezImageUtils::SetMultiThreadingEnabled(true);
+    func(parallel);
+
+    return IsBitIdentical(serial, parallel);
+  }
+
+  ezResult RunTexConv(const ezImage& input, ezTexConvUsage::Enum usage, ezImage& out_result)
+  {
+    ezTexConvProcessor processor;
+    processor.m_Descriptor.m_InputImages.ExpandAndGetRef().ResetAndCopy(input);
+    processor.m_Descriptor.m_ChannelMappings.SetCount(1);
+    for (ezUInt32 c = 0; c < 4; ++c)
+    {
+      processor.m_Descriptor.m_ChannelMappings[0].m_Channel[c].m_iInputImageIndex = 0;
+      processor.m_Descriptor.m_ChannelMappings[0].m_Channel[c].m_ChannelValue = static_cast<ezTexConvChannelValue::Enum>(ezTexConvChannelValue::Red + c);
+    }
+    processor.m_Descriptor.m_OutputType = ezTexConvOutputType::Texture2D;
+    processor.m_Descriptor.m_Usage = usage;
+    processor.m_Descriptor.m_CompressionMode = ezTexConvCompressionMode::None;
+    processor.m_Descriptor.m_MipmapMode = ezTexConvMipmapMode::Kaiser;
+    processor.m_Descriptor.m_bPreserveMipmapCoverage = true;
+    processor.m_Descriptor.m_uiDilateColor = 4;
+    processor.m_Descriptor.m_bPremultiplyAlpha = true;
+
+    EZ_SUCCEED_OR_RETURN(processor.Process());
+
+    out_result.ResetAndMove(std::move(processor.m_OutputImage));
+    return EZ_SUCCESS;
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum ImageBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum ImageBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Image, ImageMultiThreading)
+{
+  ezImage source;
+  CreateTestImage(source, 1024, 512);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scale")
+  {
+    EZ_TEST_BOOL(CompareSerialAndParallel([&](ezImage& out_result)
+      { ezImageUtils::Scale(source, out_result, 700, 300, nullptr, ezImageAddressMode::Repeat, ezImageAddressMode::Mirror).IgnoreResult(); }));
+
+    ezImageFilterSincWithKaiserWindow kaiser;
+    EZ_TEST_BOOL(CompareSerialAndParallel([&](ezImage& out_result)
+      { ezImageUtils::Scale(source, out_result, 2000, 1100, &kaiser, ezImageAddressMode::ClampBorder, ezImageAddressMode::Clamp, ezColor::CornflowerBlue).IgnoreResult(); }));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scale (fast path)")
+  {
+    ezImage source8;
+    EZ_TEST_RESULT(ezImageConversion::Convert(source, source8, ezImageFormat::R8G8B8A8_UNORM));
+
+    EZ_TEST_BOOL(CompareSerialAndParallel([&](ezImage& out_result)
+      { ezImageUtils::Scale(source8, out_result, 256, 256).IgnoreResult(); }));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GenerateMipMaps")
+  {
+    ezImageUtils::MipMapOptions options;
+    options.m_preserveCoverage = true;
+    options.m_renormalizeNormals = true;
+
+    EZ_TEST_BOOL(CompareSerialAndParallel([&](ezImage& out_result)
+      { ezImageUtils::GenerateMipMaps(source, out_result, options); }));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Pixel operations")
+  {
+    EZ_TEST_BOOL(CompareSerialAndParallel([&](ezImage& out_result)
+      {
+        out_result.ResetAndCopy(source);
+        ezImageUtils::ReconstructNormalZ(out_result);
+        ezImageUtils::ChangeExposure(out_result, 1.5f);
+        ezImageUtils::RenormalizeNormalMap(out_result);
+      }));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezImageConversion")
+  {
+    const ezImageFormat::Enum formats[] = {ezImageFormat::R8G8B8A8_UNORM_SRGB, ezImageFormat::B8G8R8A8_UNORM, ezImageFormat::R16G16B16A16_FLOAT, ezImageFormat::R10G10B10A2_UNORM, ezImageFormat::B5G6R5_UNORM};
+
+    for (ezImageFormat::Enum format : formats)
+    {
+      EZ_TEST_BOOL_MSG(CompareSerialAndParallel([&](ezImage& out_result)
+                         { ezImageConversion::Convert(source, out_result, format).IgnoreResult(); }),
+        "Conversion to '%s' differs", ezImageFormat::GetName(format));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Convert in a task that must not wait")
+  {
+    // e.g. the screenshot task converts the whole frame, it mustn't wait for the parallel conversion tasks
+    ezImage expected;
+    EZ_TEST_RESULT(ezImageConversion::Convert(source, expected, ezImageFormat::R8G8B8_UNORM_SRGB));
+
+    ezImage converted;
+    ezResult result = EZ_FAILURE;
+    ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "ImageConvertNeverNesting", ezTaskNesting::Never, [&]()
+      { result = ezImageConversion::Convert(source, converted, ezImageFormat::R8G8B8_UNORM_SRGB); });
+
+    ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::EarlyThisFrame));
+
+    EZ_TEST_RESULT(result);
+    EZ_TEST_BOOL(IsBitIdentical(expected, converted));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezTexConvProcessor")
+  {
+    EZ_TEST_BOOL(CompareSerialAndParallel([&](ezImage& out_result)
+      { EZ_TEST_RESULT(RunTexConv(source, ezTexConvUsage::Color, out_result)); }));
+
+    EZ_TEST_BOOL(CompareSerialAndParallel([&](ezImage& out_result)
+      { EZ_TEST_RESULT(RunTexConv(source, ezTexConvUsage::BumpMap, out_result)); }));
+  }
+
+  EZ_TEST_BLOCK(ImageBenchmarkEnabled, "Benchmark")
+  {
+    ezImage large;
+    CreateTestImage(large, 2048, 2048);
+
+    ezTime durations[2];
+    for (ezUInt32 i = 0; i < 2; ++i)
+    {
+      ezImageUtils::SetMultiThreadingEnabled(i == 1);
+
+      ezImage result;
+      ezStopwatch sw;
+      EZ_TEST_RESULT(RunTexConv(large, ezTexConvUsage::Color, result));
+      durations[i] = sw.GetRunningTotal();
+    }
+
+    ezImageUtils::SetMultiThreadingEnabled(true);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "TexConv 2048x2048: single-threaded %.1fms, multi-threaded %.1fms (%.1fx)", durations[0].GetMilliseconds(),
+      durations[1].GetMilliseconds(), durations[0].GetSeconds() / durations[1].GetSeconds());
+  }
+}
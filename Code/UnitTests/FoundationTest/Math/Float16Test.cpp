@@ -1,6 +1,8 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
 #include <Foundation/Math/Float16.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdConversion.h>
 #include <Foundation/Strings/String.h>
 
 EZ_CREATE_SIMPLE_TEST(Math, Float16)
@@ -55,4 +57,89 @@ EZ_CREATE_SIMPLE_TEST(Math, Float16)
 
     EZ_TEST_INT(f.GetRawData(), 23);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SIMD conversion to float")
+  {
+    ezUInt32 uiNumMismatches = 0;
+
+    for (ezUInt32 i = 0; i < 0x10000; i += 4)
+    {
+      ezFloat16 halfs[4];
+      for (ezUInt32 j = 0; j < 4; ++j)
+      {
+        halfs[j].SetRawData(static_cast<ezUInt16>(i + j));
+      }
+
+      float simd[4];
+      ezSimdConversion::ToVec4(halfs).Store<4>(simd);
+
+      for (ezUInt32 j = 0; j < 4; ++j)
+      {
+        const float scalar = halfs[j];
+        if (ezMemoryUtils::RawByteCompare(&scalar, &simd[j], sizeof(float)) != 0)
+          ++uiNumMismatches;
+      }
+    }
+
+    EZ_TEST_INT(uiNumMismatches, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SIMD conversion to half")
+  {
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    ezUInt32 uiNumMismatches = 0;
+
+    auto Check = [&](const float* pValues)
+    {
+      ezSimdVec4f v;
+      v.Load<4>(pValues);
+
+      ezFloat16 simd[4];
+      ezSimdConversion::ToFloat16(v, simd);
+
+      for (ezUInt32 j = 0; j < 4; ++j)
+      {
+        if (ezFloat16(pValues[j]).GetRawData() != simd[j].GetRawData())
+          ++uiNumMismatches;
+      }
+    };
+
+    // every representable half and the values halfway to the next one
+    for (ezUInt32 i = 0; i < 0x10000; i += 4)
+    {
+      float values[4];
+      float midValues[4];
+      for (ezUInt32 j = 0; j < 4; ++j)
+      {
+        ezFloat16 h;
+        h.SetRawData(static_cast<ezUInt16>(i + j));
+        values[j] = h;
+
+        ezUInt32 uiBits;
+        ezMemoryUtils::RawByteCopy(&uiBits, &values[j], sizeof(float));
+        uiBits += 1 << 12;
+        ezMemoryUtils::RawByteCopy(&midValues[j], &uiBits, sizeof(float));
+      }
+
+      Check(values);
+      Check(midValues);
+    }
+
+    // random bit patterns, including overflow, underflow and NaN payloads
+    for (ezUInt32 i = 0; i < 10000; ++i)
+    {
+      float values[4];
+      for (ezUInt32 j = 0; j < 4; ++j)
+      {
+        const ezUInt32 uiBits = rnd.UInt();
+        ezMemoryUtils::RawByteCopy(&values[j], &uiBits, sizeof(float));
+      }
+
+      Check(values);
+    }
+
+    EZ_TEST_INT(uiNumMismatches, 0);
+  }
 }
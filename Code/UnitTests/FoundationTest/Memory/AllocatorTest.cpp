@@ -3,6 +3,9 @@
 #include <Foundation/Memory/CommonAllocators.h>
 #include <Foundation/Memory/LargeBlockAllocator.h>
 #include <Foundation/Memory/LinearAllocator.h>
+#include <Foundation/System/StackTracer.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
 
 struct alignas(EZ_ALIGNMENT_MINIMUM) NonAlignedVector
 {
@@ -82,6 +85,12 @@ void TestAlignmentHelper(size_t uiExpectedAlignment)
   }
 }
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum TrackingBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum TrackingBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
 EZ_CREATE_SIMPLE_TEST_GROUP(Memory);
 
 EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
@@ -242,4 +251,137 @@ EZ_CREATE_SIMPLE_TEST(Memory, Allocator)
 
     EZ_TEST_BOOL(ezConstructionCounter::HasDestructed(50));
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tracking from multiple threads")
+  {
+    ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::AllocationStats> allocator("TestTracking", ezFoundation::GetDefaultAllocator());
+
+    const ezUInt32 uiNumAllocations = 20000;
+    ezDynamicArray<void*> allocations;
+    allocations.SetCount(uiNumAllocations);
+
+    ezTaskSystem::ParallelForIndexed(0u, uiNumAllocations,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          allocations[i] = allocator.Allocate(16 + (i % 64), 8);
+        }
+      });
+
+    ezAllocator::Stats stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, uiNumAllocations);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, 0);
+
+    ezUInt64 uiExpectedSize = 0;
+    for (ezUInt32 i = 0; i < uiNumAllocations; ++i)
+    {
+      EZ_TEST_INT(allocator.AllocatedSize(allocations[i]), 16 + (i % 64));
+      uiExpectedSize += 16 + (i % 64);
+    }
+    EZ_TEST_INT(stats.m_uiAllocationSize, uiExpectedSize);
+
+    // free every other allocation, on other threads than the ones that allocated it
+    ezTaskSystem::ParallelForIndexed(0u, uiNumAllocations / 2,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          allocator.Deallocate(allocations[uiNumAllocations - 1 - i * 2]);
+        }
+      });
+
+    stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiNumAllocations, uiNumAllocations);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, uiNumAllocations / 2);
+
+    for (ezUInt32 i = 0; i < uiNumAllocations; i += 2)
+    {
+      uiExpectedSize -= 16 + ((uiNumAllocations - 1 - i) % 64);
+    }
+    EZ_TEST_INT(stats.m_uiAllocationSize, uiExpectedSize);
+
+    for (ezUInt32 i = 0; i < uiNumAllocations; i += 2)
+    {
+      allocator.Deallocate(allocations[i]);
+    }
+
+    stats = allocator.GetStats();
+    EZ_TEST_INT(stats.m_uiAllocationSize, 0);
+    EZ_TEST_INT(stats.m_uiNumDeallocations, uiNumAllocations);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sampled stack traces")
+  {
+    void* pBuffer[64];
+    ezArrayPtr<void*> tempTrace(pBuffer);
+    const bool bHasStackTraces = ezStackTracer::GetStackTrace(tempTrace) > 0;
+
+    const ezUInt32 uiPrevInterval = ezMemoryTracker::GetStackTraceSamplingInterval();
+    ezMemoryTracker::SetStackTraceSamplingInterval(4096);
+
+    ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::AllocationStatsAndSampledStacktraces> allocator("TestSampling", ezFoundation::GetDefaultAllocator());
+
+    // 1000 * 256 bytes should get about 62 samples
+    ezHybridArray<void*, 1000> allocations;
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      allocations.PushBack(allocator.Allocate(256, 8));
+    }
+
+    ezUInt32 uiNumSampled = 0;
+    for (void* pPtr : allocations)
+    {
+      EZ_TEST_INT(allocator.AllocatedSize(pPtr), 256);
+
+      if (!ezMemoryTracker::GetAllocationInfo(allocator.GetId(), pPtr).GetStackTrace().IsEmpty())
+      {
+        ++uiNumSampled;
+      }
+    }
+
+    if (bHasStackTraces)
+    {
+      EZ_TEST_BOOL(uiNumSampled > 20 && uiNumSampled < 150);
+    }
+
+    for (void* pPtr : allocations)
+    {
+      allocator.Deallocate(pPtr);
+    }
+
+    EZ_TEST_INT(allocator.GetStats().m_uiAllocationSize, 0);
+
+    ezMemoryTracker::SetStackTraceSamplingInterval(uiPrevInterval);
+  }
+
+  EZ_TEST_BLOCK(TrackingBenchmarkEnabled, "Tracking Benchmark")
+  {
+    ezAllocatorWithPolicy<ezAllocPolicyHeap, ezAllocatorTrackingMode::AllocationStats> allocator("TestTrackingBenchmark", ezFoundation::GetDefaultAllocator());
+
+    const ezUInt32 uiNumAllocations = 1000000;
+
+    ezStopwatch sw;
+
+    ezTaskSystem::ParallelForIndexed(0u, uiNumAllocations / 100,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        void* allocations[100];
+
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          for (ezUInt32 j = 0; j < EZ_ARRAY_SIZE(allocations); ++j)
+          {
+            allocations[j] = allocator.Allocate(32 + j, 8);
+          }
+
+          for (ezUInt32 j = 0; j < EZ_ARRAY_SIZE(allocations); ++j)
+          {
+            allocator.Deallocate(allocations[j]);
+          }
+        }
+      });
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u tracked allocations on all threads: %.2fms", uiNumAllocations, sw.GetRunningTotal().GetMilliseconds());
+  }
 }
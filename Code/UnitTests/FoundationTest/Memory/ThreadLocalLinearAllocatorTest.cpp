@@ -0,0 +1,266 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Memory/ThreadLocalLinearAllocator.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/Thread.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  struct ezThreadLocalAllocTestObject
+  {
+    static ezAtomicInteger32 s_iNumConstructed;
+    static ezAtomicInteger32 s_iNumDestructed;
+
+    ezThreadLocalAllocTestObject()
+      : m_uiValue(0xDEADBEEF)
+    {
+      s_iNumConstructed.Increment();
+    }
+
+    ~ezThreadLocalAllocTestObject()
+    {
+      EZ_TEST_INT(m_uiValue, 0xDEADBEEF);
+      s_iNumDestructed.Increment();
+    }
+
+    ezUInt32 m_uiValue;
+  };
+
+  ezAtomicInteger32 ezThreadLocalAllocTestObject::s_iNumConstructed;
+  ezAtomicInteger32 ezThreadLocalAllocTestObject::s_iNumDestructed;
+
+  class ezThreadLocalAllocTestThread : public ezThread
+  {
+  public:
+    ezThreadLocalAllocTestThread(ezAllocator* pAllocator)
+      : ezThread("ThreadLocalAllocTestThread")
+      , m_pAllocator(pAllocator)
+    {
+    }
+
+    virtual ezUInt32 Run() override
+    {
+      m_pMemory = m_pAllocator->Allocate(64, 16);
+      return 0;
+    }
+
+    ezAllocator* m_pAllocator = nullptr;
+    void* m_pMemory = nullptr;
+  };
+
+  void MeasureContendedAllocations(ezLinearAllocatorMode::Enum mode, const char* szModeName)
+  {
+    constexpr ezUInt32 uiNumFrames = 10;
+    constexpr ezUInt32 uiNumAllocationsPerFrame = 200000;
+
+    ezDoubleBufferedLinearAllocator allocator("ContendedAllocations", ezFoundation::GetAlignedAllocator(), mode);
+
+    ezParallelForParams params;
+    params.m_uiBinSize = 256;
+
+    ezStopwatch sw;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+    {
+      ezTaskSystem::ParallelForIndexed(
+        0, uiNumAllocationsPerFrame,
+        [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+        {
+          ezAllocator* pAllocator = allocator.GetCurrentAllocator();
+
+          for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+          {
+            void* pMem = pAllocator->Allocate(32 + (i & 127), 16);
+            ezMemoryUtils::ZeroFill(static_cast<ezUInt8*>(pMem), 32);
+          }
+        },
+        "ContendedAllocations", ezTaskNesting::Never, params);
+
+      allocator.Swap();
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    const ezUInt32 uiNumAllocations = uiNumFrames * uiNumAllocationsPerFrame;
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: %u allocations in %.2fms -> %.1f million allocations/s", szModeName, uiNumAllocations,
+      tDiff.GetMilliseconds(), uiNumAllocations / tDiff.GetSeconds() / 1000000.0);
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Memory, ThreadLocalLinearAllocator)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Allocate and Reset")
+  {
+    ezThreadLocalLinearAllocator allocator("TestThreadLocalAllocator", ezFoundation::GetAlignedAllocator());
+
+    size_t sizes[] = {1, 16, 128, 4096, 1024, 16000, 512, 768, 16000, 16000, 3};
+    void* allocs[EZ_ARRAY_SIZE(sizes)];
+    for (size_t i = 0; i < EZ_ARRAY_SIZE(sizes); i++)
+    {
+      allocs[i] = allocator.Allocate(sizes[i], 16, nullptr);
+      EZ_TEST_BOOL(allocs[i] != nullptr);
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(allocs[i], 16));
+      EZ_TEST_INT(allocator.AllocatedSize(allocs[i]), sizes[i]);
+
+      ezMemoryUtils::PatternFill(static_cast<ezUInt8*>(allocs[i]), static_cast<ezUInt8>(i), sizes[i]);
+    }
+
+    // no allocation may have overwritten another one
+    for (size_t i = 0; i < EZ_ARRAY_SIZE(sizes); i++)
+    {
+      const ezUInt8* pData = static_cast<const ezUInt8*>(allocs[i]);
+      EZ_TEST_INT(pData[0], i);
+      EZ_TEST_INT(pData[sizes[i] - 1], i);
+    }
+
+    EZ_TEST_BOOL(allocator.Allocate(0, 16, nullptr) == nullptr);
+
+    allocator.Reset();
+
+    const ezAllocator::Stats stats = allocator.GetStats();
+    EZ_TEST_BOOL(stats.m_uiNumAllocations > 0);
+    EZ_TEST_BOOL(stats.m_uiAllocationSize >= 16000 * 3);
+    EZ_TEST_BOOL(stats.m_uiPerFrameAllocationSize >= 16000 * 3);
+
+    // the pages are reused after a reset
+    void* pFirst = allocator.Allocate(8, 8, nullptr);
+    EZ_TEST_BOOL(pFirst == allocs[0]);
+
+    allocator.Reset();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Non-PODs")
+  {
+    ezThreadLocalAllocTestObject::s_iNumConstructed = 0;
+    ezThreadLocalAllocTestObject::s_iNumDestructed = 0;
+
+    ezThreadLocalLinearAllocator allocator("TestThreadLocalAllocator", ezFoundation::GetAlignedAllocator());
+
+    ezDynamicArray<ezThreadLocalAllocTestObject*> objects;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      objects.PushBack(EZ_NEW(&allocator, ezThreadLocalAllocTestObject));
+    }
+
+    EZ_TEST_INT(ezThreadLocalAllocTestObject::s_iNumConstructed, 100);
+
+    for (ezUInt32 i = 0; i < 50; ++i)
+    {
+      EZ_DELETE(&allocator, objects[i * 2]);
+    }
+
+    EZ_TEST_INT(ezThreadLocalAllocTestObject::s_iNumDestructed, 50);
+
+    // only the remaining objects are destructed
+    allocator.Reset();
+
+    EZ_TEST_INT(ezThreadLocalAllocTestObject::s_iNumDestructed, 100);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multi-threaded")
+  {
+    ezThreadLocalAllocTestObject::s_iNumConstructed = 0;
+    ezThreadLocalAllocTestObject::s_iNumDestructed = 0;
+
+    constexpr ezUInt32 uiNumObjects = 10000;
+
+    ezThreadLocalLinearAllocator allocator("TestThreadLocalAllocator", ezFoundation::GetAlignedAllocator());
+
+    ezDynamicArray<ezThreadLocalAllocTestObject*> objects;
+    objects.SetCount(uiNumObjects);
+
+    ezParallelForParams params;
+    params.m_uiBinSize = 64;
+
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumObjects,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          objects[i] = EZ_NEW(&allocator, ezThreadLocalAllocTestObject);
+          objects[i]->m_uiValue = i;
+        }
+      },
+      "ThreadLocalAllocatorTest", ezTaskNesting::Never, params);
+
+    EZ_TEST_INT(ezThreadLocalAllocTestObject::s_iNumConstructed, uiNumObjects);
+
+    // all objects must still be intact, i.e. no two threads got the same memory
+    bool bAllIntact = true;
+    for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+    {
+      bAllIntact &= (objects[i]->m_uiValue == i);
+      objects[i]->m_uiValue = 0xDEADBEEF;
+    }
+    EZ_TEST_BOOL(bAllIntact);
+
+    // delete some of them on other threads than they were allocated on
+    ezTaskSystem::ParallelForIndexed(
+      0, uiNumObjects / 2,
+      [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          EZ_DELETE(&allocator, objects[uiNumObjects - 1 - i * 2]);
+        }
+      },
+      "ThreadLocalAllocatorTest", ezTaskNesting::Never, params);
+
+    EZ_TEST_INT(ezThreadLocalAllocTestObject::s_iNumDestructed, uiNumObjects / 2);
+
+    allocator.Reset();
+
+    EZ_TEST_INT(ezThreadLocalAllocTestObject::s_iNumDestructed, uiNumObjects);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Thread Slots")
+  {
+    ezThreadLocalLinearAllocator allocator("TestThreadLocalAllocator", ezFoundation::GetAlignedAllocator());
+
+    // more threads than slots, but only one at a time, so every thread reuses the slot and the page of its predecessor
+    for (ezUInt32 i = 0; i < ezThreadLocalLinearAllocator::MaxThreads + 16; ++i)
+    {
+      ezThreadLocalAllocTestThread thread(&allocator);
+      thread.Start();
+      thread.Join();
+
+      EZ_TEST_BOOL(thread.m_pMemory != nullptr);
+
+      allocator.Reset();
+    }
+
+    EZ_TEST_INT(allocator.GetStats().m_uiNumAllocations, 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FrameAllocator Mode")
+  {
+    const ezLinearAllocatorMode::Enum previousMode = ezFrameAllocator::GetMode();
+
+    ezFrameAllocator::SetMode(ezLinearAllocatorMode::Shared);
+    EZ_TEST_BOOL(ezFrameAllocator::GetMode() == ezLinearAllocatorMode::Shared);
+    EZ_TEST_BOOL(ezFrameAllocator::GetCurrentAllocator()->Allocate(64, 16) != nullptr);
+    ezFrameAllocator::Swap();
+
+    ezFrameAllocator::SetMode(ezLinearAllocatorMode::ThreadLocal);
+    EZ_TEST_BOOL(ezFrameAllocator::GetMode() == ezLinearAllocatorMode::ThreadLocal);
+    EZ_TEST_BOOL(ezFrameAllocator::GetCurrentAllocator()->Allocate(64, 16) != nullptr);
+    ezFrameAllocator::Swap();
+
+    ezFrameAllocator::SetMode(previousMode);
+  }
+
+  EZ_TEST_BLOCK(EnableInRelease, "Contended allocations")
+  {
+    MeasureContendedAllocations(ezLinearAllocatorMode::Shared, "Shared");
+    MeasureContendedAllocations(ezLinearAllocatorMode::ThreadLocal, "Thread local");
+  }
+}
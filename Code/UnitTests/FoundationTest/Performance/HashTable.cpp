@@ -0,0 +1,155 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Containers/FlatHashTable.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace HashTablePerformanceDetail
+{
+  enum
+  {
+    NUM_KEYS = 1024 * 256,
+    NUM_REPETITIONS = 4,
+  };
+
+  double ToNanosecondsPerKey(ezTime duration)
+  {
+    return duration.GetNanoseconds() / ((double)NUM_KEYS * NUM_REPETITIONS);
+  }
+
+  /// Measures inserting all keys into an empty table, looking up existing and missing keys and erasing all keys again.
+  /// Missing keys are looked up twice: once in the full table and once after every other key has been removed,
+  /// which leaves many removed entries behind that lookups have to skip.
+  template <typename TABLE>
+  void MeasureHashTable(const char* szTableName, const char* szKeysName, ezArrayPtr<const ezUInt64> keys, ezArrayPtr<const ezUInt64> missingKeys)
+  {
+    ezTime tInsert, tFindHit, tFindMiss, tFindMissAfterErase, tErase;
+    ezUInt64 uiSum = 0;
+
+    for (ezUInt32 uiRepetition = 0; uiRepetition < NUM_REPETITIONS; ++uiRepetition)
+    {
+      TABLE table;
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < NUM_KEYS; ++i)
+      {
+        table.Insert(keys[i], i);
+      }
+
+      tInsert += sw.Checkpoint();
+
+      for (ezUInt32 i = 0; i < NUM_KEYS; ++i)
+      {
+        uiSum += *table.GetValue(keys[i]);
+      }
+
+      tFindHit += sw.Checkpoint();
+
+      for (ezUInt32 i = 0; i < NUM_KEYS; ++i)
+      {
+        uiSum += table.Contains(missingKeys[i]) ? 1 : 0;
+      }
+
+      tFindMiss += sw.Checkpoint();
+
+      for (ezUInt32 i = 0; i < NUM_KEYS; i += 2)
+      {
+        table.Remove(keys[i]);
+      }
+
+      tErase += sw.Checkpoint();
+
+      for (ezUInt32 i = 0; i < NUM_KEYS; ++i)
+      {
+        uiSum += table.Contains(missingKeys[i]) ? 1 : 0;
+      }
+
+      tFindMissAfterErase += sw.Checkpoint();
+
+      for (ezUInt32 i = 1; i < NUM_KEYS; i += 2)
+      {
+        table.Remove(keys[i]);
+      }
+
+      tErase += sw.Checkpoint();
+
+      EZ_TEST_BOOL(table.IsEmpty());
+    }
+
+    EZ_TEST_INT(uiSum, (ezUInt64)NUM_REPETITIONS * NUM_KEYS * (NUM_KEYS - 1) / 2);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s, %s keys: insert %.1f ns, find hit %.1f ns, find miss %.1f ns, find miss after erase %.1f ns, erase %.1f ns",
+      szTableName, szKeysName, ToNanosecondsPerKey(tInsert), ToNanosecondsPerKey(tFindHit), ToNanosecondsPerKey(tFindMiss),
+      ToNanosecondsPerKey(tFindMissAfterErase), ToNanosecondsPerKey(tErase));
+  }
+
+  void MeasureHashTables(const char* szKeysName, ezArrayPtr<const ezUInt64> keys, ezArrayPtr<const ezUInt64> missingKeys)
+  {
+    MeasureHashTable<ezHashTable<ezUInt64, ezUInt32>>("ezHashTable", szKeysName, keys, missingKeys);
+    MeasureHashTable<ezFlatHashTable<ezUInt64, ezUInt32>>("ezFlatHashTable", szKeysName, keys, missingKeys);
+  }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+  static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+} // namespace HashTablePerformanceDetail
+
+EZ_CREATE_SIMPLE_TEST(Performance, HashTable)
+{
+  ezDynamicArray<ezUInt64> keys;
+  ezDynamicArray<ezUInt64> missingKeys;
+  keys.SetCountUninitialized(HashTablePerformanceDetail::NUM_KEYS);
+  missingKeys.SetCountUninitialized(HashTablePerformanceDetail::NUM_KEYS);
+
+  EZ_TEST_BLOCK(HashTablePerformanceDetail::EnableInRelease, "Consecutive Keys")
+  {
+    // ezHashHelper<ezUInt64> maps consecutive keys to consecutive hashes, so ezHashTable stores them without any collisions
+    for (ezUInt32 i = 0; i < HashTablePerformanceDetail::NUM_KEYS; ++i)
+    {
+      keys[i] = i;
+      missingKeys[i] = HashTablePerformanceDetail::NUM_KEYS + i;
+    }
+
+    HashTablePerformanceDetail::MeasureHashTables("consecutive", keys, missingKeys);
+  }
+
+  EZ_TEST_BLOCK(HashTablePerformanceDetail::EnableInRelease, "Strided Keys")
+  {
+    // keys like aligned addresses: ezHashHelper<ezUInt64> maps them to hashes that are multiples of 16, which makes linear probing form long clusters
+    for (ezUInt32 i = 0; i < HashTablePerformanceDetail::NUM_KEYS; ++i)
+    {
+      keys[i] = (ezUInt64)i * 64;
+      missingKeys[i] = (ezUInt64)(HashTablePerformanceDetail::NUM_KEYS + i) * 64;
+    }
+
+    HashTablePerformanceDetail::MeasureHashTables("strided", keys, missingKeys);
+  }
+
+  EZ_TEST_BLOCK(HashTablePerformanceDetail::EnableInRelease, "Random Keys")
+  {
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    // the lowest bit separates the keys from the missing keys
+    for (ezUInt32 i = 0; i < HashTablePerformanceDetail::NUM_KEYS; ++i)
+    {
+      keys[i] = ((ezUInt64)rnd.UInt() << 32 | rnd.UInt()) & ~1ull;
+      missingKeys[i] = ((ezUInt64)rnd.UInt() << 32 | rnd.UInt()) | 1ull;
+    }
+
+    // random keys might contain duplicates, which would break the checks
+    ezHashTable<ezUInt64, ezUInt32> uniqueKeys;
+    for (ezUInt32 i = 0; i < HashTablePerformanceDetail::NUM_KEYS; ++i)
+    {
+      while (uniqueKeys.Insert(keys[i], i))
+      {
+        keys[i] += 2;
+      }
+    }
+
+    HashTablePerformanceDetail::MeasureHashTables("random", keys, missingKeys);
+  }
+}
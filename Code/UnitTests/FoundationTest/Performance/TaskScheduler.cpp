@@ -0,0 +1,104 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  /// Does a tiny amount of work per invocation, so that the scheduling overhead dominates.
+  class ezTinyTask final : public ezTask
+  {
+  public:
+    ezTinyTask() { ConfigureTask("ezTinyTask", ezTaskNesting::Never); }
+
+    mutable ezAtomicInteger32 m_iSum;
+
+  private:
+    virtual void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override
+    {
+      ezUInt32 uiValue = uiInvocation;
+      for (ezUInt32 i = 0; i < 64; ++i)
+      {
+        uiValue = uiValue * 1664525u + 1013904223u;
+      }
+
+      m_iSum.Add(uiValue & 1);
+    }
+  };
+
+  /// Spawns many tiny tasks from within a worker thread and waits for them, which is the typical pattern for nested parallel work.
+  class ezSpawnerTask final : public ezTask
+  {
+  public:
+    ezSpawnerTask() { ConfigureTask("ezSpawnerTask", ezTaskNesting::Maybe); }
+
+    ezSharedPtr<ezTinyTask> m_pChildren;
+
+  private:
+    virtual void Execute() override
+    {
+      ezTaskGroupID group = ezTaskSystem::StartSingleTask(m_pChildren, ezTaskPriority::EarlyThisFrame);
+      ezTaskSystem::WaitForGroup(group);
+    }
+  };
+
+  void RunSchedulerBenchmark(ezTaskSchedulerMode::Enum mode, const char* szModeName)
+  {
+    constexpr ezUInt32 uiNumSpawners = 64;
+    constexpr ezUInt32 uiTasksPerSpawner = 256;
+    constexpr ezUInt32 uiNumFrames = 50;
+
+    ezTaskSystem::SetSchedulerMode(mode);
+
+    ezSharedPtr<ezSpawnerTask> spawners[uiNumSpawners];
+    for (ezUInt32 i = 0; i < uiNumSpawners; ++i)
+    {
+      spawners[i] = EZ_DEFAULT_NEW(ezSpawnerTask);
+      spawners[i]->m_pChildren = EZ_DEFAULT_NEW(ezTinyTask);
+      spawners[i]->m_pChildren->SetMultiplicity(uiTasksPerSpawner);
+    }
+
+    ezTaskSystem::ResetSchedulerStats();
+
+    ezStopwatch sw;
+
+    for (ezUInt32 frame = 0; frame < uiNumFrames; ++frame)
+    {
+      ezTaskGroupID group = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+      for (ezUInt32 i = 0; i < uiNumSpawners; ++i)
+      {
+        ezTaskSystem::AddTaskToGroup(group, spawners[i]);
+      }
+
+      ezTaskSystem::StartTaskGroup(group);
+      ezTaskSystem::WaitForGroup(group);
+      ezTaskSystem::FinishFrameTasks();
+    }
+
+    const ezTime tDiff = sw.Checkpoint();
+    const ezTaskSchedulerStats stats = ezTaskSystem::GetSchedulerStats();
+    const ezUInt64 uiNumTasks = (ezUInt64)uiNumFrames * uiNumSpawners * (uiTasksPerSpawner + 1);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s: %llu tasks in %.2fms -> %.0f tasks/s (shared: %llu, local: %llu, stolen: %llu)", szModeName,
+      uiNumTasks, tDiff.GetMilliseconds(), uiNumTasks / tDiff.GetSeconds(), stats.m_uiTasksFromSharedQueue, stats.m_uiTasksFromLocalQueue,
+      stats.m_uiTasksStolen);
+
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::Default);
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum EnableInRelease = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST(Performance, TaskScheduler)
+{
+  EZ_TEST_BLOCK(EnableInRelease, "Many small nested tasks")
+  {
+    RunSchedulerBenchmark(ezTaskSchedulerMode::SharedQueue, "Shared queue");
+    RunSchedulerBenchmark(ezTaskSchedulerMode::WorkStealing, "Work stealing");
+  }
+}
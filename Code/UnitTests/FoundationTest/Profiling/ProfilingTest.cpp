@@ -1,9 +1,12 @@
 #include <FoundationTest/FoundationTestPCH.h>
 
+#include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Profiling/ProfilingUtils.h>
 #include <Foundation/Threading/ThreadUtils.h>
+#include <Foundation/Time/Stopwatch.h>
 
 namespace
 {
@@ -25,6 +28,12 @@ namespace
 
 EZ_CREATE_SIMPLE_TEST_GROUP(Profiling);
 
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum ProfilingBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum ProfilingBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
 EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
 {
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Nested scopes")
@@ -52,4 +61,209 @@ EZ_CREATE_SIMPLE_TEST(Profiling, Profiling)
 
     WriteOutProfilingCapture(":output/profilingScopes.json");
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scope names")
+  {
+    ezProfilingSystem::Clear();
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeZero());
+
+    ezStringBuilder sDynamicName;
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      sDynamicName.SetFormat("Dynamic scope {}", i % 2);
+      EZ_PROFILE_SCOPE(sDynamicName);
+    }
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeFromMilliseconds(0.1));
+
+    ezProfilingSystem::ProfilingData profilingData;
+    ezProfilingSystem::Capture(profilingData);
+
+    ezHybridArray<ezString, 4> names;
+    for (const auto& eventBuffer : profilingData.m_AllEventBuffers)
+    {
+      if (eventBuffer.m_uiThreadId != (ezUInt64)ezThreadUtils::GetCurrentThreadID())
+        continue;
+
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        names.PushBack(profilingData.m_ScopeNames[scope.m_uiNameId]);
+      }
+    }
+
+    if (EZ_TEST_INT(names.GetCount(), 4))
+    {
+      EZ_TEST_STRING(names[0], "Dynamic scope 0");
+      EZ_TEST_STRING(names[1], "Dynamic scope 1");
+      EZ_TEST_STRING(names[2], "Dynamic scope 0");
+      EZ_TEST_STRING(names[3], "Dynamic scope 1");
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Captured names")
+  {
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeZero());
+
+    ezStringBuilder sDynamicName;
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      sDynamicName.SetFormat("Dynamic scope {}", i);
+      EZ_PROFILE_SCOPE(sDynamicName);
+    }
+
+    ezProfilingSystem::Clear();
+
+    {
+      EZ_PROFILE_SCOPE("Remaining scope");
+    }
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeFromMilliseconds(0.1));
+
+    ezProfilingSystem::ProfilingData merged;
+    {
+      ezProfilingSystem::ProfilingData profilingData;
+      ezProfilingSystem::Capture(profilingData);
+
+      // the cleared scopes are gone, so are their names
+      for (const ezString& sName : profilingData.m_ScopeNames)
+      {
+        EZ_TEST_BOOL(!sName.StartsWith("Dynamic scope"));
+      }
+
+      const ezProfilingSystem::ProfilingData* inputs[] = {&profilingData};
+      ezProfilingSystem::ProfilingData::Merge(merged, inputs);
+    }
+
+    // the merged data must not point into the data that it was merged from
+    ezUInt32 uiNumRemainingScopes = 0;
+    for (const auto& eventBuffer : merged.m_AllEventBuffers)
+    {
+      if (eventBuffer.m_uiThreadId != (ezUInt64)ezThreadUtils::GetCurrentThreadID())
+        continue;
+
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        EZ_TEST_BOOL(scope.m_szFunctionName == nullptr);
+
+        if (merged.m_ScopeNames[scope.m_uiNameId] == "Remaining scope")
+        {
+          ++uiNumRemainingScopes;
+
+          if (EZ_TEST_BOOL(scope.m_uiFunctionNameId < merged.m_ScopeNames.GetCount()))
+          {
+            EZ_TEST_BOOL(merged.m_ScopeNames[scope.m_uiFunctionNameId].FindSubString("Profiling") != nullptr);
+          }
+        }
+      }
+    }
+
+    EZ_TEST_INT(uiNumRemainingScopes, 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Continuous capture")
+  {
+    EZ_TEST_BOOL(ezProfilingSystem::StartContinuousCapture(":output/profilingContinuous.ezProfile").Succeeded());
+    EZ_TEST_BOOL(ezProfilingSystem::IsContinuousCaptureActive());
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeZero());
+
+    constexpr ezUInt32 uiNumFrames = 5;
+    for (ezUInt32 i = 0; i < uiNumFrames; ++i)
+    {
+      ezProfilingSystem::StartNewFrame();
+
+      EZ_PROFILE_SCOPE("Continuous frame");
+
+      // more scopes than the ring buffer of the main thread can hold
+      for (ezUInt32 j = 0; j < 50000; ++j)
+      {
+        EZ_PROFILE_SCOPE("Continuous inner scope");
+      }
+
+      // give the writer thread a chance to write some of the data while scopes are still being recorded
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(20));
+    }
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeFromMilliseconds(0.1));
+
+    ezProfilingSystem::StopContinuousCapture();
+    EZ_TEST_BOOL(!ezProfilingSystem::IsContinuousCaptureActive());
+
+    ezProfilingSystem::ProfilingData profilingData;
+    {
+      ezFileReader reader;
+      EZ_TEST_BOOL(reader.Open(":output/profilingContinuous.ezProfile").Succeeded());
+      EZ_TEST_BOOL(ezProfilingSystem::ReadContinuousCapture(reader, profilingData).Succeeded());
+    }
+
+    ezUInt32 uiNumFrameScopes = 0;
+    ezUInt32 uiNumInnerScopes = 0;
+    for (const auto& eventBuffer : profilingData.m_AllEventBuffers)
+    {
+      for (const auto& scope : eventBuffer.m_Data)
+      {
+        const ezString& sName = profilingData.m_ScopeNames[scope.m_uiNameId];
+        if (sName == "Continuous frame")
+        {
+          ++uiNumFrameScopes;
+          if (EZ_TEST_BOOL(scope.m_uiFunctionNameId < profilingData.m_ScopeNames.GetCount()))
+          {
+            EZ_TEST_BOOL(profilingData.m_ScopeNames[scope.m_uiFunctionNameId].FindSubString("Profiling") != nullptr);
+          }
+        }
+        else if (sName == "Continuous inner scope")
+        {
+          ++uiNumInnerScopes;
+          EZ_TEST_BOOL(scope.m_BeginTime <= scope.m_EndTime);
+        }
+      }
+    }
+
+    EZ_TEST_INT(uiNumFrameScopes, uiNumFrames);
+    EZ_TEST_INT(uiNumInnerScopes, uiNumFrames * 50000);
+    EZ_TEST_INT(profilingData.m_FrameStartTimes.GetCount(), uiNumFrames);
+
+    EZ_TEST_BOOL(ezProfilingUtils::ConvertContinuousCapture(":output/profilingContinuous.ezProfile", ":output/profilingContinuous.json").Succeeded());
+
+    ezFileReader jsonReader;
+    if (EZ_TEST_BOOL(jsonReader.Open(":output/profilingContinuous.json").Succeeded()))
+    {
+      ezStringBuilder sJson;
+      sJson.ReadAll(jsonReader);
+      EZ_TEST_BOOL(sJson.FindSubString("\"Continuous frame\"") != nullptr);
+      EZ_TEST_BOOL(sJson.FindSubString("\"Continuous inner scope\"") != nullptr);
+    }
+
+    ezProfilingSystem::Clear();
+  }
+
+  EZ_TEST_BLOCK(ProfilingBenchmarkEnabled, "Benchmark")
+  {
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeZero());
+
+    constexpr ezUInt32 uiNumScopes = 1000000;
+
+    ezStopwatch sw;
+    for (ezUInt32 i = 0; i < uiNumScopes; ++i)
+    {
+      EZ_PROFILE_SCOPE("Benchmark scope");
+    }
+    const ezTime tScopes = sw.Checkpoint();
+
+    EZ_TEST_BOOL(ezProfilingSystem::StartContinuousCapture(":output/profilingBenchmark.ezProfile").Succeeded());
+
+    sw.Checkpoint();
+    for (ezUInt32 i = 0; i < uiNumScopes; ++i)
+    {
+      EZ_PROFILE_SCOPE("Benchmark scope");
+    }
+    const ezTime tContinuousScopes = sw.Checkpoint();
+
+    ezProfilingSystem::StopContinuousCapture();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u profiling scopes: %.2fms, with continuous capture %.2fms", uiNumScopes, tScopes.GetMilliseconds(), tContinuousScopes.GetMilliseconds());
+
+    ezProfilingSystem::SetDiscardThreshold(ezTime::MakeFromMilliseconds(0.1));
+    ezProfilingSystem::Clear();
+  }
 }
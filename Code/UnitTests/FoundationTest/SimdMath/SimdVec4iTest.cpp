@@ -133,6 +133,17 @@ EZ_CREATE_SIMPLE_TEST(SimdMath, SimdVec4i)
     EZ_TEST_INT(b.w(), 2147483520);
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReinterpretAsFloat / ReinterpretFromFloat")
+  {
+    ezSimdVec4i a(0x3f800000, (int)0xbf800000, 0x00000000, 0x7f800000);
+
+    ezSimdVec4f b = a.ReinterpretAsFloat();
+    EZ_TEST_BOOL(b.x() == 1.0f && b.y() == -1.0f && b.z() == 0.0f && b.w() == ezMath::Infinity<float>());
+
+    ezSimdVec4i c = ezSimdVec4i::ReinterpretFromFloat(ezSimdVec4f(2.0f, -0.0f, 0.5f, -2.0f));
+    EZ_TEST_BOOL(c.x() == 0x40000000 && c.y() == (int)0x80000000 && c.z() == 0x3f000000 && c.w() == (int)0xc0000000);
+  }
+
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Swizzle")
   {
     ezSimdVec4i a(3, 5, 7, 9);
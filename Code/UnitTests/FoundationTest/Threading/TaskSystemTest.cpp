@@ -3,6 +3,7 @@
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Threading/ThreadSignal.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Utilities/DGMLWriter.h>
 
@@ -66,6 +67,59 @@ private:
   }
 };
 
+class ezSpawningTestTask final : public ezTask
+{
+public:
+  ezSpawningTestTask() { ConfigureTask("ezSpawningTestTask", ezTaskNesting::Maybe); }
+
+  ezSharedPtr<ezTestTask> m_pChild;
+
+private:
+  virtual void Execute() override
+  {
+    // starting tasks from within a task puts them into the worker's own queue, when work stealing is enabled
+    ezTaskGroupID group = ezTaskSystem::StartSingleTask(m_pChild, ezTaskPriority::EarlyThisFrame);
+    ezTaskSystem::WaitForGroup(group);
+  }
+};
+
+class ezCancelFromLocalQueueTestTask final : public ezTask
+{
+public:
+  ezCancelFromLocalQueueTestTask()
+    : m_CancelDone(ezThreadSignal::Mode::ManualReset)
+  {
+    ConfigureTask("ezCancelFromLocalQueueTestTask", ezTaskNesting::Never);
+  }
+
+  ezSharedPtr<ezTestTask> m_pToCancel;
+
+  mutable ezTaskGroupID m_CanceledGroup;
+  mutable ezResult m_CancelResult = EZ_FAILURE;
+  mutable ezThreadSignal m_CancelDone;
+
+private:
+  mutable ezAtomicInteger32 m_iNumStarted;
+
+  virtual void ExecuteWithMultiplicity(ezUInt32 uiInvocation) const override
+  {
+    EZ_IGNORE_UNUSED(uiInvocation);
+
+    // every invocation blocks one worker until the task was canceled, the invocation that starts last thus knows
+    // that all other workers are blocked and none of them can steal the task from its local queue
+    if (m_iNumStarted.Increment() == (ezInt32)GetMultiplicity())
+    {
+      m_CanceledGroup = ezTaskSystem::StartSingleTask(m_pToCancel, ezTaskPriority::ThisFrame);
+      m_CancelResult = ezTaskSystem::CancelTask(m_pToCancel, ezOnTaskRunning::ReturnWithoutBlocking);
+      m_CancelDone.RaiseSignal();
+    }
+    else
+    {
+      m_CancelDone.WaitForSignal();
+    }
+  }
+};
+
 class TaskCallbacks
 {
 public:
@@ -550,6 +604,66 @@ EZ_CREATE_SIMPLE_TEST(Threading, TaskSystem)
     EZ_TEST_BOOL(t[2]->IsMultiplicityDone());
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Work-Stealing Scheduler")
+  {
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::WorkStealing);
+    EZ_TEST_BOOL(ezTaskSystem::GetSchedulerMode() == ezTaskSchedulerMode::WorkStealing);
+
+    ezTaskSystem::ResetSchedulerStats();
+
+    ezSharedPtr<ezSpawningTestTask> t[8];
+    ezTaskGroupID tg = ezTaskSystem::CreateTaskGroup(ezTaskPriority::ThisFrame);
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(t); ++i)
+    {
+      t[i] = EZ_DEFAULT_NEW(ezSpawningTestTask);
+      t[i]->m_pChild = EZ_DEFAULT_NEW(ezTestTask);
+      t[i]->m_pChild->SetMultiplicity(100);
+
+      ezTaskSystem::AddTaskToGroup(tg, t[i]);
+    }
+
+    ezTaskSystem::StartTaskGroup(tg);
+    ezTaskSystem::WaitForGroup(tg);
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(t); ++i)
+    {
+      EZ_TEST_BOOL(t[i]->IsTaskFinished());
+      EZ_TEST_BOOL(t[i]->m_pChild->IsMultiplicityDone());
+    }
+
+    const ezTaskSchedulerStats stats = ezTaskSystem::GetSchedulerStats();
+    EZ_TEST_BOOL(stats.m_uiTasksFromLocalQueue + stats.m_uiTasksStolen > 0);
+
+    // canceling a task that sits in the local queue of a worker thread
+    {
+      ezTaskSystem::ResetSchedulerStats();
+
+      ezSharedPtr<ezCancelFromLocalQueueTestTask> pSpawner = EZ_DEFAULT_NEW(ezCancelFromLocalQueueTestTask);
+      pSpawner->m_pToCancel = EZ_DEFAULT_NEW(ezTestTask);
+      pSpawner->SetMultiplicity(ezTaskSystem::GetNumAllocatedWorkerThreads(ezWorkerThreadType::ShortTasks));
+
+      ezTaskGroupID g0 = ezTaskSystem::StartSingleTask(pSpawner, ezTaskPriority::ThisFrame);
+
+      // WaitForGroup() would let this thread steal the task from the worker's queue before it gets canceled
+      pSpawner->m_CancelDone.WaitForSignal();
+
+      ezTaskSystem::WaitForGroup(g0);
+      ezTaskSystem::WaitForGroup(pSpawner->m_CanceledGroup);
+
+      EZ_TEST_BOOL(pSpawner->m_CancelResult == EZ_SUCCESS);
+      EZ_TEST_BOOL(pSpawner->m_pToCancel->IsTaskFinished());
+      EZ_TEST_BOOL(!pSpawner->m_pToCancel->IsStarted());
+
+      // the canceled task was dequeued from a work-stealing queue and skipped
+      const ezTaskSchedulerStats cancelStats = ezTaskSystem::GetSchedulerStats();
+      EZ_TEST_BOOL(cancelStats.m_uiTasksFromLocalQueue + cancelStats.m_uiTasksStolen >= 1);
+    }
+
+    ezTaskSystem::SetSchedulerMode(ezTaskSchedulerMode::Default);
+    EZ_TEST_BOOL(ezTaskSystem::GetSchedulerMode() == ezTaskSchedulerMode::SharedQueue);
+  }
+
   // capture profiling info for testing
   /*ezStringBuilder sOutputPath = ezTestFramework::GetInstance()->GetAbsOutputPath();
 
@@ -2,7 +2,15 @@
 
 #include "AnimationsTest.h"
 #include <Core/WorldSerializer/WorldReader.h>
+#include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <GameEngine/Animation/Skeletal/AnimatedMeshComponent.h>
+#include <GameEngine/Animation/Skeletal/AnimationControllerComponent.h>
+#include <GameEngine/Animation/Skeletal/TwoBoneIKComponent.h>
+#include <RendererCore/AnimationSystem/SkeletonResource.h>
 
 static ezGameEngineTestAnimations s_GameEngineTestAnimations;
 
@@ -20,6 +28,7 @@ ezGameEngineTestApplication* ezGameEngineTestAnimations::CreateApplication()
 void ezGameEngineTestAnimations::SetupSubTests()
 {
   AddSubTest("Skeletal", SubTests::Skeletal);
+  AddSubTest("Crowd", SubTests::Crowd);
 }
 
 ezResult ezGameEngineTestAnimations::InitializeSubTest(ezInt32 iIdentifier)
@@ -40,9 +49,192 @@ ezResult ezGameEngineTestAnimations::InitializeSubTest(ezInt32 iIdentifier)
     return EZ_SUCCESS;
   }
 
+  if (iIdentifier == SubTests::Crowd)
+  {
+    EZ_SUCCEED_OR_RETURN(m_pOwnApplication->LoadScene("Animations/AssetCache/Common/Scenes/AnimController.ezBinScene"));
+    return EZ_SUCCESS;
+  }
+
   return EZ_FAILURE;
 }
 
+void ezGameEngineTestAnimations::SpawnCrowd(ezUInt32 uiNumCharacters)
+{
+  ezWorld* pWorld = m_pOwnApplication->GetWorld();
+  EZ_LOCK(pWorld->GetWriteMarker());
+
+  const ezAnimationControllerComponentManager* pManager = pWorld->GetComponentManager<ezAnimationControllerComponentManager>();
+  EZ_TEST_BOOL(pManager != nullptr);
+  if (pManager == nullptr)
+    return;
+
+  // use every animated character in the scene as a template
+  ezDeque<const ezGameObject*> templates;
+  for (auto it = pManager->GetComponents(); it.IsValid(); it.Next())
+  {
+    const ezGameObject* pRoot = it->GetOwner();
+    while (pRoot->GetParent() != nullptr)
+    {
+      pRoot = pRoot->GetParent();
+    }
+
+    if (!templates.Contains(pRoot))
+    {
+      templates.PushBack(pRoot);
+    }
+  }
+
+  EZ_TEST_BOOL(!templates.IsEmpty());
+  if (templates.IsEmpty())
+    return;
+
+  ezDefaultMemoryStreamStorage storage;
+  {
+    ezMemoryStreamWriter writer(&storage);
+    ezWorldWriter worldWriter;
+    worldWriter.WriteObjects(writer, templates);
+  }
+
+  ezWorldReader worldReader;
+  {
+    ezMemoryStreamReader reader(&storage);
+    EZ_TEST_RESULT(worldReader.ReadWorldDescription(reader));
+  }
+
+  // place the characters in a grid behind the original ones
+  ezDynamicArray<ezTransform> transforms;
+  transforms.SetCount(uiNumCharacters / templates.GetCount());
+
+  for (ezUInt32 i = 0; i < transforms.GetCount(); ++i)
+  {
+    transforms[i] = ezTransform(ezVec3(5.0f + (i / 25) * 1.5f, (i % 25) * 1.5f - 18.0f, 0.0f));
+  }
+
+  worldReader.InstantiatePrefabs(*pWorld, transforms, ezPrefabInstantiationOptions());
+}
+
+void ezGameEngineTestAnimations::AddCrowdIK()
+{
+  ezWorld* pWorld = m_pOwnApplication->GetWorld();
+  EZ_LOCK(pWorld->GetWriteMarker());
+
+  ezAnimationControllerComponentManager* pManager = pWorld->GetComponentManager<ezAnimationControllerComponentManager>();
+  if (pManager == nullptr)
+    return;
+
+  // every character reaches for a point in front of it with the right arm
+  for (auto it = pManager->GetComponents(); it.IsValid(); it.Next())
+  {
+    it->m_bEnableIK = true;
+
+    ezGameObjectDesc gd;
+    gd.m_hParent = it->GetOwner()->GetHandle();
+    gd.m_LocalPosition.Set(0.4f, -0.3f, 1.2f);
+
+    ezGameObject* pTarget = nullptr;
+    pWorld->CreateObject(gd, pTarget);
+
+    ezTwoBoneIKComponent* pIK = nullptr;
+    ezTwoBoneIKComponent::CreateComponent(pTarget, pIK);
+    pIK->m_sJointStart.Assign("UpperArm.R");
+    pIK->m_sJointMiddle.Assign("LowerArm.R");
+    pIK->m_sJointEnd.Assign("Hand.R");
+    pIK->m_MidAxis = ezBasisAxis::PositiveZ;
+  }
+}
+
+void ezGameEngineTestAnimations::RunCrowdBenchmark()
+{
+  ezWorld* pWorld = m_pOwnApplication->GetWorld();
+  EZ_LOCK(pWorld->GetWriteMarker());
+
+  const ezAnimationControllerComponentManager* pManager = pWorld->GetComponentManager<ezAnimationControllerComponentManager>();
+  EZ_TEST_BOOL(pManager != nullptr && pManager->GetComponentCount() >= 500);
+  if (pManager == nullptr)
+    return;
+
+  // only measures the world update, without extraction and rendering
+  constexpr ezUInt32 uiNumUpdates = 30;
+
+  ezStopwatch sw;
+  for (ezUInt32 i = 0; i < uiNumUpdates; ++i)
+  {
+    pWorld->Update();
+  }
+  const ezTime tUpdate = sw.GetRunningTotal();
+
+  ezTestFramework::Output(ezTestOutput::Duration, "Crowd of %u animated characters: %.2fms per world update",
+    pManager->GetComponentCount(), tUpdate.GetMilliseconds() / uiNumUpdates);
+}
+
+void ezGameEngineTestAnimations::RetrieveCrowdPoses(ezDynamicArray<ezMat4>& out_poses)
+{
+  ezWorld* pWorld = m_pOwnApplication->GetWorld();
+
+  out_poses.Clear();
+
+  ezAnimatedMeshComponentManager* pManager = pWorld->GetComponentManager<ezAnimatedMeshComponentManager>();
+  if (pManager == nullptr)
+    return;
+
+  ezDynamicArray<ezMat4> pose;
+  ezTransform rootTransform;
+
+  for (auto it = pManager->GetComponents(); it.IsValid(); it.Next())
+  {
+    ezMsgQueryAnimationSkeleton msg;
+    it->GetOwner()->SendMessage(msg);
+
+    ezResourceLock<ezSkeletonResource> pSkeleton(msg.m_hSkeleton, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+    if (pSkeleton.GetAcquireResult() != ezResourceAcquireResult::Final)
+      continue;
+
+    it->RetrievePose(pose, rootTransform, pSkeleton->GetDescriptor().m_Skeleton);
+    out_poses.PushBackRange(pose);
+  }
+}
+
+void ezGameEngineTestAnimations::CompareCrowdPoses()
+{
+  ezWorld* pWorld = m_pOwnApplication->GetWorld();
+  EZ_LOCK(pWorld->GetWriteMarker());
+
+  ezCVarBool* pParallel = (ezCVarBool*)ezCVar::FindCVarByName("Animation.ParallelPoseGeneration");
+  if (!EZ_TEST_BOOL(pParallel != nullptr))
+    return;
+
+  const ezTwoBoneIKComponentManager* pIKManager = pWorld->GetComponentManager<ezTwoBoneIKComponentManager>();
+  EZ_TEST_BOOL(pIKManager != nullptr && pIKManager->GetComponentCount() >= 500);
+
+  // while the clock is paused, every update generates the same poses again
+  pWorld->GetClock().SetPaused(true);
+
+  ezDynamicArray<ezMat4> parallelPoses;
+  pWorld->Update();
+  RetrieveCrowdPoses(parallelPoses);
+
+  ezDynamicArray<ezMat4> serialPoses;
+  *pParallel = false;
+  pWorld->Update();
+  RetrieveCrowdPoses(serialPoses);
+  *pParallel = true;
+
+  pWorld->GetClock().SetPaused(false);
+
+  EZ_TEST_BOOL(!parallelPoses.IsEmpty());
+  if (!EZ_TEST_INT(parallelPoses.GetCount(), serialPoses.GetCount()))
+    return;
+
+  ezUInt32 uiNumDifferent = 0;
+  for (ezUInt32 i = 0; i < parallelPoses.GetCount(); ++i)
+  {
+    if (!parallelPoses[i].IsEqual(serialPoses[i], 0.0001f))
+      ++uiNumDifferent;
+  }
+
+  EZ_TEST_INT(uiNumDifferent, 0);
+}
+
 ezTestAppRun ezGameEngineTestAnimations::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
 {
   const bool bVulkan = ezGameApplication::GetActiveRenderer().IsEqual_NoCase("Vulkan");
@@ -53,6 +245,25 @@ ezTestAppRun ezGameEngineTestAnimations::RunSubTest(ezInt32 iIdentifier, ezUInt3
   if (m_pOwnApplication->ShouldApplicationQuit())
     return ezTestAppRun::Quit;
 
+  if (iIdentifier == SubTests::Crowd)
+  {
+    if (m_iFrame == 1)
+    {
+      SpawnCrowd(500);
+      AddCrowdIK();
+    }
+
+    // give the spawned characters a few frames to start their simulation and load everything
+    if (m_iFrame == 10)
+    {
+      RunCrowdBenchmark();
+      CompareCrowdPoses();
+      return ezTestAppRun::Quit;
+    }
+
+    return ezTestAppRun::Continue;
+  }
+
   if (m_ImgCompFrames[m_uiImgCompIdx] == m_iFrame)
   {
     EZ_TEST_IMAGE(m_uiImgCompIdx, 300);
@@ -16,12 +16,19 @@ protected:
   enum SubTests
   {
     Skeletal,
+    Crowd,
   };
 
   virtual void SetupSubTests() override;
   virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
   virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
 
+  void SpawnCrowd(ezUInt32 uiNumCharacters);
+  void AddCrowdIK();
+  void RunCrowdBenchmark();
+  void RetrieveCrowdPoses(ezDynamicArray<ezMat4>& out_poses);
+  void CompareCrowdPoses();
+
   ezInt32 m_iFrame = 0;
   ezGameEngineTestApplication* m_pOwnApplication = nullptr;
 
@@ -0,0 +1,203 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
+
+#  include <FileservePlugin/Client/FileserveClient.h>
+#  include <FileservePlugin/Fileserver/Fileserver.h>
+#  include <Foundation/IO/FileSystem/FileReader.h>
+#  include <Foundation/IO/FileSystem/FileSystem.h>
+#  include <Foundation/IO/OSFile.h>
+#  include <Foundation/Threading/Thread.h>
+#  include <Foundation/Types/ScopeExit.h>
+
+namespace FileservePrefetchTestDetail
+{
+  /// \brief The client blocks while it waits for the server, so the server has to be updated on another thread.
+  class ServerThread : public ezThread
+  {
+  public:
+    ServerThread(ezFileserver* pServer)
+      : ezThread("Fileserve Test Server")
+      , m_pServer(pServer)
+    {
+    }
+
+    ezAtomicBool m_bStop;
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (!m_bStop)
+      {
+        if (!m_pServer->UpdateServer())
+        {
+          ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+        }
+      }
+
+      return 0;
+    }
+
+    ezFileserver* m_pServer = nullptr;
+  };
+
+  ezDynamicArray<ezUInt8> CreateFileContent(ezUInt32 uiFile)
+  {
+    ezDynamicArray<ezUInt8> content;
+
+    switch (uiFile)
+    {
+      case 0:
+        // empty file
+        break;
+
+      case 1:
+        // compresses well, without zstd support it is sent in multiple chunks
+        content.SetCountUninitialized(64 * 1024);
+        for (ezUInt32 i = 0; i < content.GetCount(); ++i)
+        {
+          content[i] = static_cast<ezUInt8>('a' + (i / 7) % 26);
+        }
+        break;
+
+      case 2:
+      {
+        // doesn't compress and is sent in multiple chunks
+        content.SetCountUninitialized(40 * 1024);
+        ezUInt32 uiSeed = 17;
+        for (ezUInt32 i = 0; i < content.GetCount(); ++i)
+        {
+          uiSeed = uiSeed * 1664525u + 1013904223u;
+          content[i] = static_cast<ezUInt8>(uiSeed >> 24);
+        }
+        break;
+      }
+
+      default:
+      {
+        ezStringBuilder sText;
+        sText.SetFormat("Prefetched file number {0}", uiFile);
+        content.PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sText.GetData()), sText.GetElementCount()));
+        break;
+      }
+    }
+
+    return content;
+  }
+} // namespace FileservePrefetchTestDetail
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Fileserve);
+
+EZ_CREATE_SIMPLE_TEST(Fileserve, Prefetch)
+{
+  constexpr ezUInt32 uiNumFiles = 8;
+
+  if (ezFileserveClient::GetSingleton() != nullptr || ezFileserver::GetSingleton() != nullptr)
+  {
+    ezTestFramework::Output(ezTestOutput::Message, "Skipped, this application already uses fileserve.");
+    return;
+  }
+
+  ezStringBuilder sServerFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sServerFolder.AppendPath("FileservePrefetch");
+
+  ezOSFile::DeleteFolder(sServerFolder).IgnoreResult();
+  if (!EZ_TEST_RESULT(ezOSFile::CreateDirectoryStructure(sServerFolder)))
+    return;
+
+  ezStringBuilder sFile;
+  for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+  {
+    sFile.SetFormat("{0}/File{1}.bin", sServerFolder, i);
+
+    const ezDynamicArray<ezUInt8> content = FileservePrefetchTestDetail::CreateFileContent(i);
+
+    ezOSFile file;
+    EZ_TEST_RESULT(file.Open(sFile, ezFileOpenMode::Write));
+    EZ_TEST_RESULT(file.Write(content.GetData(), content.GetCount()));
+  }
+
+  ezFileSystem::SetSpecialDirectory("fileserveprefetch", sServerFolder);
+  EZ_SCOPE_EXIT(ezFileSystem::SetSpecialDirectory("fileserveprefetch", ""));
+
+  // the server reads the files through absolute paths
+  if (!EZ_TEST_RESULT(ezFileSystem::AddDataDirectory("", "FileservePrefetchTest")))
+    return;
+
+  EZ_SCOPE_EXIT(ezFileSystem::RemoveDataDirectoryGroup("FileservePrefetchTest"));
+
+  const bool bClientWasEnabled = ezFileserveClient::IsFileserveClientEnabled();
+
+  ezFileserver server;
+  server.SetPort(10427);
+
+  // creating a server disables the client
+  ezFileserveClient::EnableFileserveClient();
+  EZ_SCOPE_EXIT(if (!bClientWasEnabled) ezFileserveClient::DisabledFileserveClient(););
+
+  ezAtomicInteger32 iNumFileRequests;
+  server.m_Events.AddEventHandler([&](const ezFileserverEvent& e)
+    {
+      if (e.m_Type == ezFileserverEvent::Type::FileDownloadRequest)
+        iNumFileRequests.Increment(); });
+
+  server.StartServer();
+  EZ_SCOPE_EXIT(server.StopServer());
+
+  FileservePrefetchTestDetail::ServerThread serverThread(&server);
+  serverThread.Start();
+  EZ_SCOPE_EXIT(serverThread.m_bStop = true; serverThread.Join(););
+
+  {
+    ezFileserveClient client;
+    client.AddServerAddressToTry("localhost:10427");
+
+    if (!EZ_TEST_RESULT(client.EnsureConnected(ezTime::MakeFromSeconds(10))))
+      return;
+
+    if (!EZ_TEST_RESULT(ezFileSystem::AddDataDirectory(">fileserveprefetch/", "FileservePrefetchTest", "fsprefetch", ezDataDirUsage::ReadOnly)))
+      return;
+
+    EZ_SCOPE_EXIT(ezFileSystem::RemoveDataDirectory("fsprefetch"));
+
+    // mounting may already have requested config files
+    iNumFileRequests = 0;
+
+    ezHybridArray<ezString, uiNumFiles> files;
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sFile.SetFormat(":fsprefetch/File{0}.bin", i);
+      files.PushBack(sFile);
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Prefetch")
+    {
+      ezFileSystem::PrefetchFiles(files);
+
+      // all files were requested in one go, every request is answered before PrefetchFiles() returns
+      EZ_TEST_INT(iNumFileRequests, uiNumFiles);
+    }
+
+    EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read prefetched files")
+    {
+      for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+      {
+        const ezDynamicArray<ezUInt8> expected = FileservePrefetchTestDetail::CreateFileContent(i);
+
+        ezFileReader file;
+        if (!EZ_TEST_RESULT(file.Open(files[i])))
+          continue;
+
+        ezDynamicArray<ezUInt8> content;
+        content.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+        EZ_TEST_INT(file.ReadBytes(content.GetData(), content.GetCount()), expected.GetCount());
+        EZ_TEST_BOOL(content == expected);
+      }
+
+      // the files were served from the cache, without asking the server again
+      EZ_TEST_INT(iNumFileRequests, uiNumFiles);
+    }
+  }
+}
+
+#endif
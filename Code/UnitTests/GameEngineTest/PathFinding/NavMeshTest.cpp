@@ -0,0 +1,291 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#if defined(BUILDSYSTEM_ENABLE_RECAST_SUPPORT) && defined(BUILDSYSTEM_ENABLE_JOLT_SUPPORT)
+
+#  include <AiPlugin/Navigation/NavMesh.h>
+#  include <AiPlugin/Navigation/NavMeshWorldModule.h>
+#  include <Core/Interfaces/NavmeshGeoWorldModule.h>
+#  include <Core/Interfaces/PhysicsWorldModule.h>
+#  include <Core/World/World.h>
+#  include <Foundation/Configuration/CVar.h>
+#  include <Foundation/Threading/TaskSystem.h>
+#  include <Foundation/Threading/ThreadUtils.h>
+#  include <Foundation/Time/Stopwatch.h>
+
+namespace NavMeshTestDetail
+{
+  /// A flat static ground box, its top is at z = 0.
+  static void CreateGround(ezWorld& ref_world)
+  {
+    ezPhysicsWorldModuleInterface* pModule = ref_world.GetOrCreateModule<ezPhysicsWorldModuleInterface>();
+
+    ezGameObjectDesc gd;
+    gd.m_LocalPosition.Set(0, 0, -0.5f);
+
+    ezGameObject* pObject = nullptr;
+    ref_world.CreateObject(gd, pObject);
+
+    pModule->AddStaticCollisionBox(pObject, ezVec3(200.0f, 200.0f, 1.0f));
+  }
+
+  static const dtMeshHeader* GetHeader(const ezDataBuffer& data)
+  {
+    return data.IsEmpty() ? nullptr : reinterpret_cast<const dtMeshHeader*>(data.GetData());
+  }
+
+  /// Builds the sector on this thread, the same way the generation tasks do it.
+  static void BuildSectorSerially(const ezAiNavMesh& navMesh, const ezNavmeshGeoWorldModuleInterface* pGeo, ezAiNavMesh::SectorID sectorID, ezDataBuffer& out_navmeshData)
+  {
+    ezDynamicArray<ezNavmeshTriangle> triangles;
+    navMesh.RetrieveSectorGeometry(sectorID, pGeo, triangles);
+    navMesh.BuildSector(sectorID, triangles, out_navmeshData);
+  }
+
+  class BuildSectorTask final : public ezTask
+  {
+  public:
+    virtual void Execute() override
+    {
+      m_pNavMesh->BuildSector(m_SectorID, m_Triangles, m_NavmeshData);
+    }
+
+    ezAiNavMesh* m_pNavMesh = nullptr;
+    ezAiNavMesh::SectorID m_SectorID = ezInvalidIndex;
+    ezDynamicArray<ezNavmeshTriangle> m_Triangles;
+    ezDataBuffer m_NavmeshData;
+  };
+
+  /// Builds the sector on another thread and hands the result to the navmesh, but doesn't finalize it yet.
+  static void BuildRetrievedSector(ezAiNavMesh& ref_navMesh, const ezNavmeshGeoWorldModuleInterface* pGeo, ezAiNavMesh::SectorID sectorID)
+  {
+    ezSharedPtr<BuildSectorTask> pTask = EZ_DEFAULT_NEW(BuildSectorTask);
+    pTask->ConfigureTask("Build Navmesh Sector", ezTaskNesting::Never);
+    pTask->m_pNavMesh = &ref_navMesh;
+    pTask->m_SectorID = sectorID;
+    ref_navMesh.RetrieveSectorGeometry(sectorID, pGeo, pTask->m_Triangles);
+
+    ezTaskSystem::WaitForGroup(ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning));
+
+    ref_navMesh.FinishSectorBuild(sectorID, std::move(pTask->m_NavmeshData));
+  }
+} // namespace NavMeshTestDetail
+
+EZ_CREATE_SIMPLE_TEST(PathFinding, NavMeshSectors)
+{
+  using namespace NavMeshTestDetail;
+
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  CreateGround(world);
+  world.SetWorldSimulationEnabled(true);
+
+  ezAiNavMeshWorldModule* pModule = world.GetOrCreateModule<ezAiNavMeshWorldModule>();
+  const ezNavmeshGeoWorldModuleInterface* pGeo = world.GetOrCreateModule<ezNavmeshGeoWorldModuleInterface>();
+  if (!EZ_TEST_BOOL(pModule != nullptr && pGeo != nullptr))
+    return;
+
+  ezAiNavMesh* pNavMesh = pModule->GetNavMesh("");
+  if (!EZ_TEST_BOOL(pNavMesh != nullptr))
+    return;
+
+  // 4 x 2 sectors around the origin, all of them on the ground
+  const ezVec2 vAreaCenter(0.0f);
+  const ezVec2 vAreaHalfExtents(1.9f * pNavMesh->GetSectorSize(), 0.9f * pNavMesh->GetSectorSize());
+
+  ezHybridArray<ezAiNavMesh::SectorID, 8> sectors;
+  {
+    const ezVec2I32 coordMin = pNavMesh->CalculateSectorCoord(vAreaCenter.x - vAreaHalfExtents.x, vAreaCenter.y - vAreaHalfExtents.y);
+    const ezVec2I32 coordMax = pNavMesh->CalculateSectorCoord(vAreaCenter.x + vAreaHalfExtents.x, vAreaCenter.y + vAreaHalfExtents.y);
+
+    for (ezInt32 y = coordMin.y; y <= coordMax.y; ++y)
+    {
+      for (ezInt32 x = coordMin.x; x <= coordMax.x; ++x)
+      {
+        sectors.PushBack(pNavMesh->CalculateSectorID(ezVec2I32(x, y)));
+      }
+    }
+  }
+
+  EZ_TEST_INT(sectors.GetCount(), 8);
+
+  auto GetNumBuildingSectors = [&]()
+  {
+    ezUInt32 uiNumBuilding = 0;
+    for (ezAiNavMesh::SectorID id : sectors)
+    {
+      const ezAiNavMeshSector* pSector = pNavMesh->GetSector(id);
+      if (pSector != nullptr && pSector->m_FlagBuilding == 1)
+        ++uiNumBuilding;
+    }
+    return uiNumBuilding;
+  };
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Concurrent sector builds")
+  {
+    ezCVarInt* pMaxConcurrentSectors = (ezCVarInt*)ezCVar::FindCVarByName("AI.Navmesh.MaxConcurrentSectors");
+    if (!EZ_TEST_BOOL(pMaxConcurrentSectors != nullptr))
+      return;
+
+    const int iPrevMaxConcurrentSectors = *pMaxConcurrentSectors;
+    *pMaxConcurrentSectors = 3;
+
+    EZ_TEST_BOOL(!pNavMesh->RequestSector(vAreaCenter, vAreaHalfExtents));
+
+    // a task result is only integrated during the next update, so every update that starts tasks is followed by
+    // at least one check that sees all of them building
+    ezUInt32 uiMaxBuilding = 0;
+    ezStopwatch sw;
+
+    while (!pNavMesh->RequestSector(vAreaCenter, vAreaHalfExtents) && sw.GetRunningTotal() < ezTime::MakeFromSeconds(60))
+    {
+      world.Update();
+      uiMaxBuilding = ezMath::Max(uiMaxBuilding, GetNumBuildingSectors());
+
+      ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+
+    *pMaxConcurrentSectors = iPrevMaxConcurrentSectors;
+
+    EZ_TEST_INT(uiMaxBuilding, 3);
+    EZ_TEST_INT(GetNumBuildingSectors(), 0);
+
+    ezUInt64 uiTotalMemory = 0;
+
+    for (ezAiNavMesh::SectorID id : sectors)
+    {
+      const ezAiNavMeshSector* pSector = pNavMesh->GetSector(id);
+      if (!EZ_TEST_BOOL(pSector != nullptr && pSector->m_FlagUsable == 1))
+        continue;
+
+      uiTotalMemory += pSector->m_NavmeshDataCur.GetCount();
+
+      // the sectors built in parallel must match the ones built one after another
+      ezDataBuffer serialData;
+      BuildSectorSerially(*pNavMesh, pGeo, id, serialData);
+
+      const dtMeshHeader* pParallel = GetHeader(pSector->m_NavmeshDataCur);
+      const dtMeshHeader* pSerial = GetHeader(serialData);
+
+      if (EZ_TEST_BOOL(pParallel != nullptr && pSerial != nullptr))
+      {
+        EZ_TEST_INT(pSector->m_NavmeshDataCur.GetCount(), serialData.GetCount());
+        EZ_TEST_BOOL(pParallel->polyCount > 0);
+        EZ_TEST_INT(pParallel->polyCount, pSerial->polyCount);
+        EZ_TEST_INT(pParallel->vertCount, pSerial->vertCount);
+        EZ_TEST_INT(pParallel->detailTriCount, pSerial->detailTriCount);
+        EZ_TEST_INT(pParallel->x, pSerial->x);
+        EZ_TEST_INT(pParallel->y, pSerial->y);
+      }
+    }
+
+    EZ_TEST_INT(pNavMesh->GetLoadedSectorMemory(), uiTotalMemory);
+  }
+
+  // from here on the navmesh is driven directly, the world isn't updated anymore
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Memory budget")
+  {
+    // use the sectors one after another, so that sectors[0] is the least recently used one
+    for (ezAiNavMesh::SectorID id : sectors)
+    {
+      EZ_TEST_BOOL(pNavMesh->RequestSector(id));
+      pNavMesh->FinalizeSectorUpdates();
+    }
+
+    const ezUInt64 uiTotalMemory = pNavMesh->GetLoadedSectorMemory();
+    ezUInt64 uiOldestMemory = 0;
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      uiOldestMemory += pNavMesh->GetSector(sectors[i])->m_NavmeshDataCur.GetCount();
+    }
+
+    // everything was used recently
+    pNavMesh->UnloadUnusedSectors(0, 100);
+    EZ_TEST_INT(pNavMesh->GetLoadedSectorMemory(), uiTotalMemory);
+
+    // the budget is only exceeded by the three oldest sectors
+    pNavMesh->UnloadUnusedSectors(uiTotalMemory - uiOldestMemory, 0);
+    EZ_TEST_INT(pNavMesh->GetLoadedSectorMemory(), uiTotalMemory - uiOldestMemory);
+
+    for (ezUInt32 i = 0; i < sectors.GetCount(); ++i)
+    {
+      const ezAiNavMeshSector* pSector = pNavMesh->GetSector(sectors[i]);
+      EZ_TEST_BOOL((pSector->m_FlagUsable == 1) == (i >= 3));
+      EZ_TEST_BOOL(pSector->m_NavmeshDataCur.IsEmpty() == (i < 3));
+    }
+
+    // unloaded sectors are built again, once they are requested
+    EZ_TEST_BOOL(!pNavMesh->RequestSector(sectors[0]));
+    EZ_TEST_INT(pNavMesh->RetrieveRequestedSector(), sectors[0]);
+    EZ_TEST_INT(pNavMesh->RetrieveRequestedSector(), ezInvalidIndex);
+
+    BuildRetrievedSector(*pNavMesh, pGeo, sectors[0]);
+    pNavMesh->FinalizeSectorUpdates();
+
+    EZ_TEST_BOOL(pNavMesh->RequestSector(sectors[0]));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalidate while building")
+  {
+    const ezAiNavMesh::SectorID id = sectors[7];
+    const ezAiNavMeshSector* pSector = pNavMesh->GetSector(id);
+
+    EZ_TEST_BOOL(pSector->m_FlagUsable == 1);
+
+    // the current data stays in use, while the sector is rebuilt
+    pNavMesh->InvalidateSector(id, true);
+    EZ_TEST_INT(pNavMesh->RetrieveRequestedSector(), id);
+    EZ_TEST_BOOL(pSector->m_FlagBuilding == 1);
+
+    // the geometry changes again, before the build is done
+    pNavMesh->InvalidateSector(id, true);
+    EZ_TEST_BOOL(pSector->m_FlagOutdated == 1);
+
+    // sectors that are being built must not be unloaded, no matter the budget
+    pNavMesh->UnloadUnusedSectors(0, 0);
+    EZ_TEST_BOOL(pSector->m_FlagUsable == 1);
+    EZ_TEST_BOOL(pSector->m_FlagBuilding == 1);
+    EZ_TEST_BOOL(!pSector->m_NavmeshDataCur.IsEmpty());
+
+    const ezUInt64 uiMemory = pNavMesh->GetLoadedSectorMemory();
+    EZ_TEST_BOOL(uiMemory >= pSector->m_NavmeshDataCur.GetCount());
+
+    // the outdated result is discarded and the sector is queued for another build
+    BuildRetrievedSector(*pNavMesh, pGeo, id);
+    pNavMesh->FinalizeSectorUpdates();
+
+    EZ_TEST_BOOL(pSector->m_FlagBuilding == 0);
+    EZ_TEST_BOOL(pSector->m_FlagOutdated == 0);
+    EZ_TEST_BOOL(pSector->m_FlagInvalidate == 1);
+    EZ_TEST_BOOL(pSector->m_FlagUsable == 1);
+    EZ_TEST_INT(pNavMesh->GetLoadedSectorMemory(), uiMemory);
+
+    EZ_TEST_INT(pNavMesh->RetrieveRequestedSector(), id);
+    BuildRetrievedSector(*pNavMesh, pGeo, id);
+    pNavMesh->FinalizeSectorUpdates();
+
+    EZ_TEST_BOOL(pSector->m_FlagInvalidate == 0);
+    EZ_TEST_BOOL(pSector->m_FlagUsable == 1);
+    EZ_TEST_INT(pNavMesh->RetrieveRequestedSector(), ezInvalidIndex);
+
+    // without a rebuild request, the outdated result is discarded and the sector is unloaded
+    const ezUInt64 uiSectorMemory = pSector->m_NavmeshDataCur.GetCount();
+
+    pNavMesh->InvalidateSector(id, true);
+    EZ_TEST_INT(pNavMesh->RetrieveRequestedSector(), id);
+    pNavMesh->InvalidateSector(id, false);
+
+    BuildRetrievedSector(*pNavMesh, pGeo, id);
+    pNavMesh->FinalizeSectorUpdates();
+
+    EZ_TEST_BOOL(pSector->m_FlagBuilding == 0);
+    EZ_TEST_BOOL(pSector->m_FlagUsable == 0);
+    EZ_TEST_BOOL(pSector->m_NavmeshDataCur.IsEmpty());
+    EZ_TEST_INT(pNavMesh->GetLoadedSectorMemory(), uiMemory - uiSectorMemory);
+    EZ_TEST_INT(pNavMesh->RetrieveRequestedSector(), ezInvalidIndex);
+  }
+}
+
+#endif
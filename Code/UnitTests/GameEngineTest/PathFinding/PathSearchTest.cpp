@@ -0,0 +1,282 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Utilities/PathFinding/GridJumpPointSearch.h>
+
+namespace PathSearchTestDetail
+{
+  struct TestGrid
+  {
+    ezUInt32 m_uiWidth = 0;
+    ezUInt32 m_uiHeight = 0;
+    ezDynamicArray<bool> m_Blocked;
+
+    ezInt64 GetIndex(ezUInt32 x, ezUInt32 y) const { return static_cast<ezInt64>(y) * m_uiWidth + x; }
+  };
+
+  static bool IsCellBlocked(ezUInt32 uiCell, void* pPassThrough)
+  {
+    return static_cast<const TestGrid*>(pPassThrough)->m_Blocked[uiCell];
+  }
+
+  /// Random single blocked cells, optionally plus some longer walls.
+  static void CreateGrid(TestGrid& out_grid, ezUInt32 uiSize, ezUInt32 uiBlockedPercentage, bool bAddWalls, ezUInt32 uiSeed)
+  {
+    ezRandom rng;
+    rng.Initialize(uiSeed);
+
+    out_grid.m_uiWidth = uiSize;
+    out_grid.m_uiHeight = uiSize;
+    out_grid.m_Blocked.SetCount(uiSize * uiSize);
+
+    for (bool& bBlocked : out_grid.m_Blocked)
+    {
+      bBlocked = rng.UIntInRange(100) < uiBlockedPercentage;
+    }
+
+    if (!bAddWalls)
+      return;
+
+    for (ezUInt32 i = 0; i < uiSize / 4; ++i)
+    {
+      const ezUInt32 x = rng.UIntInRange(uiSize);
+      const ezUInt32 y = rng.UIntInRange(uiSize);
+      const ezUInt32 uiLength = rng.UIntInRange(uiSize / 4);
+      const bool bHorizontal = rng.Bool();
+
+      for (ezUInt32 l = 0; l < uiLength; ++l)
+      {
+        const ezUInt32 cx = bHorizontal ? ezMath::Min(x + l, uiSize - 1) : x;
+        const ezUInt32 cy = bHorizontal ? y : ezMath::Min(y + l, uiSize - 1);
+        out_grid.m_Blocked[cy * uiSize + cx] = true;
+      }
+    }
+  }
+
+  static ezInt64 GetRandomFreeCell(const TestGrid& grid, ezRandom& ref_rng)
+  {
+    while (true)
+    {
+      const ezUInt32 uiCell = ref_rng.UIntInRange(grid.m_Blocked.GetCount());
+      if (!grid.m_Blocked[uiCell])
+        return uiCell;
+    }
+  }
+
+  /// Plain A* expansion into the 8 neighbor cells, with the same movement rules as ezGridJumpPointSearch.
+  class NeighborCellGenerator : public ezPathStateGenerator<ezPathState>
+  {
+  public:
+    explicit NeighborCellGenerator(const TestGrid& grid)
+      : m_Grid(grid)
+    {
+    }
+
+    virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override
+    {
+      EZ_IGNORE_UNUSED(iStartNodeIndex);
+      EZ_IGNORE_UNUSED(pStartState);
+
+      m_iTargetX = static_cast<ezInt32>(iTargetNodeIndex % m_Grid.m_uiWidth);
+      m_iTargetY = static_cast<ezInt32>(iTargetNodeIndex / m_Grid.m_uiWidth);
+    }
+
+    virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& StartState, ezPathSearch<ezPathState>* pPathSearch) override
+    {
+      const ezInt32 x = static_cast<ezInt32>(iNodeIndex % m_Grid.m_uiWidth);
+      const ezInt32 y = static_cast<ezInt32>(iNodeIndex / m_Grid.m_uiWidth);
+
+      for (ezInt32 dy = -1; dy <= 1; ++dy)
+      {
+        for (ezInt32 dx = -1; dx <= 1; ++dx)
+        {
+          if ((dx == 0 && dy == 0) || !IsFree(x + dx, y + dy))
+            continue;
+
+          if (dx != 0 && dy != 0 && (!IsFree(x + dx, y) || !IsFree(x, y + dy)))
+            continue;
+
+          ezPathState state;
+          state.m_fCostToNode = StartState.m_fCostToNode + ((dx != 0 && dy != 0) ? ezMath::Sqrt(2.0f) : 1.0f);
+          state.m_fEstimatedCostToTarget = state.m_fCostToNode + GetOctileDistance(x + dx, y + dy);
+
+          pPathSearch->AddPathNode(m_Grid.GetIndex(x + dx, y + dy), state);
+        }
+      }
+    }
+
+  private:
+    bool IsFree(ezInt32 x, ezInt32 y) const
+    {
+      if (x < 0 || y < 0 || x >= static_cast<ezInt32>(m_Grid.m_uiWidth) || y >= static_cast<ezInt32>(m_Grid.m_uiHeight))
+        return false;
+
+      return !m_Grid.m_Blocked[y * m_Grid.m_uiWidth + x];
+    }
+
+    float GetOctileDistance(ezInt32 x, ezInt32 y) const
+    {
+      const ezInt32 iDiffX = ezMath::Abs(x - m_iTargetX);
+      const ezInt32 iDiffY = ezMath::Abs(y - m_iTargetY);
+      return static_cast<float>(ezMath::Max(iDiffX, iDiffY) - ezMath::Min(iDiffX, iDiffY)) + static_cast<float>(ezMath::Min(iDiffX, iDiffY)) * ezMath::Sqrt(2.0f);
+    }
+
+    const TestGrid& m_Grid;
+    ezInt32 m_iTargetX = 0;
+    ezInt32 m_iTargetY = 0;
+  };
+
+  static float GetPathCost(const ezDeque<ezPathSearch<ezPathState>::PathResultData>& path)
+  {
+    return path.PeekBack().m_pPathState->m_fCostToNode;
+  }
+} // namespace PathSearchTestDetail
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum PathSearchBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum PathSearchBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST_GROUP(PathFinding);
+
+EZ_CREATE_SIMPLE_TEST(PathFinding, PathSearch)
+{
+  using namespace PathSearchTestDetail;
+
+  ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "FindPath")
+  {
+    TestGrid grid;
+    grid.m_uiWidth = 8;
+    grid.m_uiHeight = 8;
+    grid.m_Blocked.SetCount(64);
+
+    // a wall with a single gap at the bottom
+    for (ezUInt32 y = 0; y < 7; ++y)
+    {
+      grid.m_Blocked[grid.GetIndex(4, y)] = true;
+    }
+
+    NeighborCellGenerator generator(grid);
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&generator);
+
+    EZ_TEST_BOOL(search.FindPath(grid.GetIndex(0, 0), ezPathState(), grid.GetIndex(7, 0), path).Succeeded());
+    EZ_TEST_INT(path.PeekFront().m_iNodeIndex, grid.GetIndex(0, 0));
+    EZ_TEST_INT(path.PeekBack().m_iNodeIndex, grid.GetIndex(7, 0));
+
+    for (ezUInt32 i = 0; i < path.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(!grid.m_Blocked[static_cast<ezUInt32>(path[i].m_iNodeIndex)]);
+    }
+
+    // the path has to go through the gap
+    bool bFoundGap = false;
+    for (ezUInt32 i = 0; i < path.GetCount(); ++i)
+    {
+      bFoundGap |= path[i].m_iNodeIndex == grid.GetIndex(4, 7);
+    }
+    EZ_TEST_BOOL(bFoundGap);
+
+    // close the gap
+    grid.m_Blocked[grid.GetIndex(4, 7)] = true;
+    EZ_TEST_BOOL(search.FindPath(grid.GetIndex(0, 0), ezPathState(), grid.GetIndex(7, 0), path).Failed());
+
+    EZ_TEST_BOOL(search.FindPath(grid.GetIndex(1, 1), ezPathState(), grid.GetIndex(1, 1), path).Succeeded());
+    EZ_TEST_INT(path.GetCount(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Dense node range and jump point search")
+  {
+    TestGrid grid;
+    CreateGrid(grid, 128, 20, true, 7);
+
+    NeighborCellGenerator neighborGenerator(grid);
+
+    ezGridJumpPointSearch jpsGenerator;
+    jpsGenerator.SetGrid(grid.m_uiWidth, grid.m_uiHeight, IsCellBlocked, &grid);
+
+    ezPathSearch<ezPathState> hashSearch;
+    hashSearch.SetPathStateGenerator(&neighborGenerator);
+
+    ezPathSearch<ezPathState> denseSearch;
+    denseSearch.SetPathStateGenerator(&neighborGenerator);
+    denseSearch.SetDenseNodeRange(grid.m_Blocked.GetCount());
+
+    ezPathSearch<ezPathState> jpsSearch;
+    jpsSearch.SetPathStateGenerator(&jpsGenerator);
+    jpsSearch.SetDenseNodeRange(grid.m_Blocked.GetCount());
+
+    ezRandom rng;
+    rng.Initialize(13);
+
+    ezUInt32 uiNumFound = 0;
+
+    for (ezUInt32 i = 0; i < 50; ++i)
+    {
+      const ezInt64 iStart = GetRandomFreeCell(grid, rng);
+      const ezInt64 iTarget = GetRandomFreeCell(grid, rng);
+
+      const bool bFound = hashSearch.FindPath(iStart, ezPathState(), iTarget, path).Succeeded();
+      const float fCost = bFound ? GetPathCost(path) : 0.0f;
+
+      EZ_TEST_BOOL(denseSearch.FindPath(iStart, ezPathState(), iTarget, path).Succeeded() == bFound);
+      if (bFound)
+      {
+        EZ_TEST_FLOAT(GetPathCost(path), fCost, 0.01f);
+      }
+
+      EZ_TEST_BOOL(jpsSearch.FindPath(iStart, ezPathState(), iTarget, path).Succeeded() == bFound);
+      if (bFound)
+      {
+        ++uiNumFound;
+        EZ_TEST_FLOAT(GetPathCost(path), fCost, 0.01f);
+        EZ_TEST_INT(path.PeekFront().m_iNodeIndex, iStart);
+        EZ_TEST_INT(path.PeekBack().m_iNodeIndex, iTarget);
+      }
+    }
+
+    EZ_TEST_BOOL(uiNumFound > 25);
+  }
+
+  EZ_TEST_BLOCK(PathSearchBenchmarkEnabled, "Benchmark 1024x1024")
+  {
+    TestGrid grid;
+    CreateGrid(grid, 1024, 20, false, 3);
+
+    // from one corner to the other
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      grid.m_Blocked[grid.GetIndex(i % 2, i / 2)] = false;
+      grid.m_Blocked[grid.GetIndex(1023 - i % 2, 1023 - i / 2)] = false;
+    }
+    const ezInt64 iStart = 0;
+    const ezInt64 iTarget = grid.m_Blocked.GetCount() - 1;
+
+    NeighborCellGenerator neighborGenerator(grid);
+
+    ezGridJumpPointSearch jpsGenerator;
+    jpsGenerator.SetGrid(grid.m_uiWidth, grid.m_uiHeight, IsCellBlocked, &grid);
+
+    ezPathSearch<ezPathState> search;
+
+    const char* szNames[] = {"A* hash table", "A* dense", "JPS dense"};
+    for (ezUInt32 uiMode = 0; uiMode < EZ_ARRAY_SIZE(szNames); ++uiMode)
+    {
+      search.SetPathStateGenerator(uiMode == 2 ? static_cast<ezPathStateGenerator<ezPathState>*>(&jpsGenerator) : &neighborGenerator);
+      search.SetDenseNodeRange(uiMode == 0 ? 0 : grid.m_Blocked.GetCount());
+
+      ezStopwatch sw;
+      const bool bFound = search.FindPath(iStart, ezPathState(), iTarget, path).Succeeded();
+      const ezTime duration = sw.GetRunningTotal();
+
+      EZ_TEST_BOOL(bFound);
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: %.2fms, path cost %.1f", szNames[uiMode], duration.GetMilliseconds(), bFound ? GetPathCost(path) : 0.0f);
+    }
+  }
+}
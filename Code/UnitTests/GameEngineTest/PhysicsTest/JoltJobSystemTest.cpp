@@ -0,0 +1,195 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_JOLT_SUPPORT
+
+#  include <Foundation/Time/Stopwatch.h>
+#  include <Jolt/Jolt.h>
+#  include <Jolt/Core/JobSystemThreadPool.h>
+#  include <Jolt/Core/TempAllocator.h>
+#  include <Jolt/Physics/Body/BodyCreationSettings.h>
+#  include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#  include <Jolt/Physics/PhysicsSettings.h>
+#  include <Jolt/Physics/PhysicsSystem.h>
+#  include <JoltPlugin/System/JoltCollisionFiltering.h>
+#  include <JoltPlugin/System/JoltJobSystem.h>
+
+namespace
+{
+  struct StepTimes
+  {
+    ezTime m_Total;
+    ezTime m_Max;
+  };
+
+  /// The benchmark scene: stacks of boxes on a large static ground box.
+  class BoxStacksScene
+  {
+  public:
+    BoxStacksScene(ezUInt32 uiNumStacksPerSide, ezUInt32 uiStackHeight)
+      : m_TempAllocator(32 * 1024 * 1024)
+    {
+      const ezUInt32 uiNumBoxes = uiNumStacksPerSide * uiNumStacksPerSide * uiStackHeight;
+
+      m_System.Init(uiNumBoxes + 1, 0, uiNumBoxes * 40, uiNumBoxes * 4, m_ObjectToBroadphase, m_ObjectVsBroadphaseFilter, m_ObjectLayerPairFilter);
+
+      JPH::BodyInterface& bodies = m_System.GetBodyInterface();
+
+      JPH::BodyCreationSettings ground(new JPH::BoxShape(JPH::Vec3(200, 1, 200)), JPH::RVec3(0, -1, 0), JPH::Quat::sIdentity(), JPH::EMotionType::Static, ezJoltCollisionFiltering::ConstructObjectLayer(0, ezJoltBroadphaseLayer::Static));
+      m_Ground = bodies.CreateAndAddBody(ground, JPH::EActivation::DontActivate);
+
+      JPH::RefConst<JPH::Shape> pBox = new JPH::BoxShape(JPH::Vec3(0.5f, 0.5f, 0.5f));
+      const JPH::ObjectLayer dynamicLayer = ezJoltCollisionFiltering::ConstructObjectLayer(0, ezJoltBroadphaseLayer::Dynamic);
+      const float fOffset = -0.5f * uiNumStacksPerSide * 3.0f;
+
+      for (ezUInt32 x = 0; x < uiNumStacksPerSide; ++x)
+      {
+        for (ezUInt32 z = 0; z < uiNumStacksPerSide; ++z)
+        {
+          for (ezUInt32 y = 0; y < uiStackHeight; ++y)
+          {
+            // slightly rotated, so that the stacks don't stay perfectly balanced
+            const JPH::Quat rotation = JPH::Quat::sRotation(JPH::Vec3::sAxisY(), 0.1f * static_cast<float>((x + y + z) % 7));
+            const JPH::RVec3 position(fOffset + x * 3.0f, 0.5f + y * 1.05f, fOffset + z * 3.0f);
+
+            JPH::BodyCreationSettings box(pBox, position, rotation, JPH::EMotionType::Dynamic, dynamicLayer);
+            m_Boxes.PushBack(bodies.CreateAndAddBody(box, JPH::EActivation::Activate));
+          }
+        }
+      }
+
+      m_System.OptimizeBroadPhase();
+    }
+
+    ~BoxStacksScene()
+    {
+      JPH::BodyInterface& bodies = m_System.GetBodyInterface();
+      for (const JPH::BodyID& id : m_Boxes)
+      {
+        bodies.RemoveBody(id);
+        bodies.DestroyBody(id);
+      }
+
+      bodies.RemoveBody(m_Ground);
+      bodies.DestroyBody(m_Ground);
+    }
+
+    StepTimes Simulate(JPH::JobSystem& ref_jobSystem, ezUInt32 uiNumSteps)
+    {
+      StepTimes times;
+
+      for (ezUInt32 i = 0; i < uiNumSteps; ++i)
+      {
+        ezStopwatch sw;
+        m_System.Update(1.0f / 60.0f, 1, &m_TempAllocator, &ref_jobSystem);
+
+        const ezTime stepTime = sw.GetRunningTotal();
+        times.m_Total += stepTime;
+        times.m_Max = ezMath::Max(times.m_Max, stepTime);
+      }
+
+      return times;
+    }
+
+    /// Returns the lowest y coordinate of any box. Boxes falling through the ground would indicate broken jobs.
+    float GetLowestBoxPosition()
+    {
+      float fLowest = ezMath::MaxValue<float>();
+      for (const JPH::BodyID& id : m_Boxes)
+      {
+        fLowest = ezMath::Min(fLowest, static_cast<float>(m_System.GetBodyInterface().GetCenterOfMassPosition(id).GetY()));
+      }
+
+      return fLowest;
+    }
+
+    ezUInt32 GetNumActiveBodies() const
+    {
+      return m_System.GetNumActiveBodies(JPH::EBodyType::RigidBody);
+    }
+
+  private:
+    ezJoltObjectToBroadphaseLayer m_ObjectToBroadphase;
+    ezJoltObjectVsBroadPhaseLayerFilter m_ObjectVsBroadphaseFilter;
+    ezJoltObjectLayerPairFilter m_ObjectLayerPairFilter;
+    JPH::TempAllocatorImpl m_TempAllocator;
+    JPH::PhysicsSystem m_System;
+    JPH::BodyID m_Ground;
+    ezDynamicArray<JPH::BodyID> m_Boxes;
+  };
+} // namespace
+
+#  if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum JoltBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#  else
+static const ezTestBlock::Enum JoltBenchmarkEnabled = ezTestBlock::Enabled;
+#  endif
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Physics);
+
+EZ_CREATE_SIMPLE_TEST(Physics, JoltJobSystem)
+{
+  ezJoltCollisionFiltering::LoadCollisionFilters();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Simulate")
+  {
+    ezJoltJobSystem jobSystem(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+    EZ_TEST_INT(jobSystem.GetMaxConcurrency(), ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::ShortTasks) + 1);
+
+    BoxStacksScene scene(4, 5);
+    scene.Simulate(jobSystem, 120);
+
+    EZ_TEST_BOOL(scene.GetLowestBoxPosition() > 0.0f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Jobs with dependencies")
+  {
+    ezJoltJobSystem jobSystem(64, 4);
+
+    ezAtomicInteger32 iCounter;
+    ezInt32 iValueSeenByLastJob = -1;
+
+    JPH::JobSystem::Barrier* pBarrier = jobSystem.CreateBarrier();
+
+    JPH::JobHandle lastJob = jobSystem.CreateJob("Last", JPH::Color::sGreen, [&]()
+      { iValueSeenByLastJob = iCounter; }, 16);
+    pBarrier->AddJob(lastJob);
+
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      JPH::JobHandle job = jobSystem.CreateJob("Increment", JPH::Color::sRed, [&]()
+        {
+          iCounter.Increment();
+          lastJob.RemoveDependency(); });
+      pBarrier->AddJob(job);
+    }
+
+    jobSystem.WaitForJobs(pBarrier);
+    jobSystem.DestroyBarrier(pBarrier);
+
+    EZ_TEST_INT(iValueSeenByLastJob, 16);
+  }
+
+  EZ_TEST_BLOCK(JoltBenchmarkEnabled, "Benchmark")
+  {
+    const ezUInt32 uiNumSteps = 300;
+
+    ezJoltJobSystem taskSystemJobs(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+    JPH::JobSystemThreadPool threadPoolJobs(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers, std::thread::hardware_concurrency() - 1);
+
+    JPH::JobSystem* jobSystems[] = {&threadPoolJobs, &taskSystemJobs};
+    const char* szNames[] = {"JobSystemThreadPool", "ezJoltJobSystem"};
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(jobSystems); ++i)
+    {
+      BoxStacksScene scene(20, 10);
+      const StepTimes times = scene.Simulate(*jobSystems[i], uiNumSteps);
+
+      EZ_TEST_BOOL(scene.GetLowestBoxPosition() > 0.0f);
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%s: avg step %.2fms, max step %.2fms, %u active bodies", szNames[i],
+        times.m_Total.GetMilliseconds() / uiNumSteps, times.m_Max.GetMilliseconds(), scene.GetNumActiveBodies());
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_JOLT_SUPPORT
+
+#  include <Core/Interfaces/PhysicsWorldModule.h>
+#  include <Core/World/World.h>
+#  include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  /// Fills a world with a grid of static boxes.
+  void CreateBoxGrid(ezWorld& ref_world)
+  {
+    ezPhysicsWorldModuleInterface* pModule = ref_world.GetOrCreateModule<ezPhysicsWorldModuleInterface>();
+
+    for (ezUInt32 x = 0; x < 8; ++x)
+    {
+      for (ezUInt32 y = 0; y < 8; ++y)
+      {
+        ezGameObjectDesc gd;
+        gd.m_LocalPosition.Set(x * 4.0f - 14.0f, y * 4.0f - 14.0f, (x + y) % 3 * 1.0f);
+
+        ezGameObject* pObject = nullptr;
+        ref_world.CreateObject(gd, pObject);
+
+        pModule->AddStaticCollisionBox(pObject, ezVec3(1.0f + (x % 2), 1.0f + (y % 2), 2.0f));
+      }
+    }
+  }
+
+  /// Random rays from above the grid that go downwards, so that a good fraction of them hits a box.
+  void CreateRays(ezDynamicArray<ezPhysicsRaycastQuery>& out_rays, ezUInt32 uiCount)
+  {
+    ezUInt32 uiSeed = 42;
+    auto Random = [&](float fMin, float fMax)
+    {
+      uiSeed = uiSeed * 1664525u + 1013904223u;
+      return fMin + (fMax - fMin) * static_cast<float>(uiSeed >> 8) / static_cast<float>(1u << 24);
+    };
+
+    out_rays.SetCount(uiCount);
+    for (ezPhysicsRaycastQuery& ray : out_rays)
+    {
+      ray.m_vStart.Set(Random(-16.0f, 16.0f), Random(-16.0f, 16.0f), 10.0f);
+      ray.m_vDir = ezVec3(Random(-0.5f, 0.5f), Random(-0.5f, 0.5f), -1.0f).GetNormalized();
+      ray.m_fDistance = Random(5.0f, 20.0f);
+    }
+  }
+
+  bool IsSameHit(const ezPhysicsCastResult& a, const ezPhysicsCastResult& b)
+  {
+    return a.m_vPosition.IsEqual(b.m_vPosition, 0.001f) && a.m_vNormal.IsEqual(b.m_vNormal, 0.001f) && a.m_hActorObject == b.m_hActorObject;
+  }
+} // namespace
+
+#  if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum QueriesBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#  else
+static const ezTestBlock::Enum QueriesBenchmarkEnabled = ezTestBlock::Enabled;
+#  endif
+
+EZ_CREATE_SIMPLE_TEST(Physics, JoltBatchQueries)
+{
+  ezWorldDesc worldDesc("Test");
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  // the Jolt plugin provides the implementation of the physics interface
+  ezPhysicsWorldModuleInterface* pModule = world.GetOrCreateModule<ezPhysicsWorldModuleInterface>();
+  if (!EZ_TEST_BOOL(pModule != nullptr))
+    return;
+
+  CreateBoxGrid(world);
+
+  // adds the queued bodies to the physics system
+  world.Update();
+  world.Update();
+
+  const ezPhysicsQueryParameters params(0, ezPhysicsShapeType::Static);
+
+  ezDynamicArray<ezPhysicsRaycastQuery> rays;
+  CreateRays(rays, 1000);
+
+  ezDynamicArray<ezPhysicsCastResult> results;
+  ezDynamicArray<bool> hits;
+  results.SetCount(rays.GetCount());
+  hits.SetCount(rays.GetCount());
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "RaycastBatch")
+  {
+    const ezUInt32 uiNumHits = pModule->RaycastBatch(rays, results, hits, params);
+    EZ_TEST_BOOL(uiNumHits > 100 && uiNumHits < rays.GetCount());
+
+    ezUInt32 uiNumSingleHits = 0;
+    for (ezUInt32 i = 0; i < rays.GetCount(); ++i)
+    {
+      ezPhysicsCastResult res;
+      const bool bHit = pModule->Raycast(res, rays[i].m_vStart, rays[i].m_vDir, rays[i].m_fDistance, params);
+
+      EZ_TEST_BOOL(bHit == hits[i]);
+      if (bHit && hits[i])
+      {
+        ++uiNumSingleHits;
+        EZ_TEST_BOOL(IsSameHit(res, results[i]));
+      }
+    }
+
+    EZ_TEST_INT(uiNumHits, uiNumSingleHits);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SweepBatch")
+  {
+    ezDynamicArray<ezPhysicsSweepQuery> sweeps;
+    sweeps.SetCount(rays.GetCount());
+
+    for (ezUInt32 i = 0; i < rays.GetCount(); ++i)
+    {
+      ezPhysicsSweepQuery& sweep = sweeps[i];
+      sweep.m_Shape.m_Type = (i % 2) == 0 ? ezPhysicsQueryShape::Type::Sphere : ezPhysicsQueryShape::Type::Capsule;
+      sweep.m_Shape.m_fRadius = 0.25f;
+      sweep.m_Shape.m_fHeight = 0.5f;
+      sweep.m_Transform = ezTransform(rays[i].m_vStart);
+      sweep.m_vDir = rays[i].m_vDir;
+      sweep.m_fDistance = rays[i].m_fDistance;
+    }
+
+    const ezUInt32 uiNumHits = pModule->SweepBatch(sweeps, results, hits, params);
+    EZ_TEST_BOOL(uiNumHits > 100);
+
+    for (ezUInt32 i = 0; i < sweeps.GetCount(); ++i)
+    {
+      const ezPhysicsSweepQuery& sweep = sweeps[i];
+
+      ezPhysicsCastResult res;
+      bool bHit = false;
+
+      if (sweep.m_Shape.m_Type == ezPhysicsQueryShape::Type::Sphere)
+        bHit = pModule->SweepTestSphere(res, sweep.m_Shape.m_fRadius, sweep.m_Transform.m_vPosition, sweep.m_vDir, sweep.m_fDistance, params);
+      else
+        bHit = pModule->SweepTestCapsule(res, sweep.m_Shape.m_fRadius, sweep.m_Shape.m_fHeight, sweep.m_Transform, sweep.m_vDir, sweep.m_fDistance, params);
+
+      EZ_TEST_BOOL(bHit == hits[i]);
+      if (bHit && hits[i])
+      {
+        EZ_TEST_BOOL(IsSameHit(res, results[i]));
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "OverlapBatch")
+  {
+    ezDynamicArray<ezPhysicsOverlapQuery> overlaps;
+    overlaps.SetCount(rays.GetCount());
+
+    for (ezUInt32 i = 0; i < rays.GetCount(); ++i)
+    {
+      ezPhysicsOverlapQuery& overlap = overlaps[i];
+      overlap.m_Shape.m_fRadius = 1.0f;
+      overlap.m_Transform = ezTransform(rays[i].m_vStart + rays[i].m_vDir * rays[i].m_fDistance);
+    }
+
+    const ezUInt32 uiNumHits = pModule->OverlapBatch(overlaps, hits, params);
+    EZ_TEST_BOOL(uiNumHits > 100 && uiNumHits < overlaps.GetCount());
+
+    for (ezUInt32 i = 0; i < overlaps.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(pModule->OverlapTestSphere(overlaps[i].m_Shape.m_fRadius, overlaps[i].m_Transform.m_vPosition, params) == hits[i]);
+    }
+  }
+
+  EZ_TEST_BLOCK(QueriesBenchmarkEnabled, "Benchmark")
+  {
+    CreateRays(rays, 20000);
+    results.SetCount(rays.GetCount());
+    hits.SetCount(rays.GetCount());
+
+    ezStopwatch sw;
+    for (ezUInt32 i = 0; i < rays.GetCount(); ++i)
+    {
+      hits[i] = pModule->Raycast(results[i], rays[i].m_vStart, rays[i].m_vDir, rays[i].m_fDistance, params);
+    }
+    const ezTime tSingle = sw.Checkpoint();
+
+    pModule->RaycastBatch(rays, results, hits, params);
+    const ezTime tBatch = sw.Checkpoint();
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u raycasts: single %.2fms, batch %.2fms", rays.GetCount(), tSingle.GetMilliseconds(), tBatch.GetMilliseconds());
+  }
+}
+
+#endif
@@ -0,0 +1,427 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Configuration/Startup.h>
+#include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Reflection/ReflectionUtils.h>
+#include <RendererCore/Meshes/MeshComponent.h>
+#include <RendererCore/Pipeline/Extractor.h>
+#include <RendererCore/Pipeline/Implementation/RenderPipelineResourceLoader.h>
+#include <RendererCore/Pipeline/Passes/OpaqueForwardRenderPass.h>
+#include <RendererCore/Pipeline/Passes/SourcePass.h>
+#include <RendererCore/Pipeline/Passes/TargetPass.h>
+#include <RendererCore/Pipeline/RenderPipeline.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererNull/Device/DeviceNull.h>
+#include <RendererTest/Advanced/RenderCost.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiResolutionX = 1280;
+  constexpr ezUInt32 s_uiResolutionY = 720;
+  constexpr ezInt32 s_iGridSize = 16;
+  constexpr ezUInt32 s_uiNumUniqueMaterials = 64;
+
+  // The first frames load resources and build the pipeline, so they are not representative.
+  constexpr ezUInt32 s_uiWarmUpFrames = 10;
+  constexpr ezUInt32 s_uiMeasuredFrames = 50;
+} // namespace
+
+void ezRendererTestRenderCost::SetupSubTests()
+{
+  AddSubTest("Shared Material", SubTests::ST_SharedMaterial);
+  AddSubTest("Unique Materials", SubTests::ST_UniqueMaterials);
+  AddSubTest("Parallel Extraction", SubTests::ST_ParallelExtraction);
+}
+
+ezResult ezRendererTestRenderCost::InitializeSubTest(ezInt32 iIdentifier)
+{
+  m_iFrame = -1;
+  m_bCaptureImage = false;
+  m_ImgCompFrames.Clear();
+
+  ezStartup::StartupCoreSystems();
+  EZ_SUCCEED_OR_RETURN(SetupRenderer("Null"));
+
+  {
+    ezGALTextureCreationDescription texDesc;
+    texDesc.m_uiWidth = s_uiResolutionX;
+    texDesc.m_uiHeight = s_uiResolutionY;
+    texDesc.m_Format = ezGALResourceFormat::RGBAUByteNormalizedsRGB;
+    texDesc.m_bAllowRenderTargetView = true;
+    m_hColorTarget = m_pDevice->CreateTexture(texDesc);
+
+    texDesc.m_Format = ezGALResourceFormat::D24S8;
+    m_hDepthTarget = m_pDevice->CreateTexture(texDesc);
+
+    if (m_hColorTarget.IsInvalidated() || m_hDepthTarget.IsInvalidated())
+      return EZ_FAILURE;
+  }
+
+  CreatePipeline();
+  CreateScene(iIdentifier == SubTests::ST_SharedMaterial ? 1 : s_uiNumUniqueMaterials);
+
+  {
+    m_Camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 70.0f, 0.1f, 1000.0f);
+    m_Camera.LookAt(ezVec3(-2.0f * s_iGridSize, 0, 0), ezVec3::MakeZero(), ezVec3(0, 0, 1));
+
+    ezView* pView = nullptr;
+    m_hView = ezRenderWorld::CreateView("RenderCost", pView);
+    pView->SetCameraUsageHint(ezCameraUsageHint::MainView);
+    pView->SetWorld(m_pWorld);
+    pView->SetCamera(&m_Camera);
+    pView->SetViewport(ezRectFloat(0.0f, 0.0f, (float)s_uiResolutionX, (float)s_uiResolutionY));
+    pView->SetRenderPipelineResource(m_hPipeline);
+
+    ezGALRenderTargets renderTargets;
+    renderTargets.m_hRTs[0] = m_hColorTarget;
+    renderTargets.m_hDSTarget = m_hDepthTarget;
+    pView->SetRenderTargets(renderTargets);
+  }
+
+  m_uiMeasuredFrames = 0;
+  m_FrameStats = PassStats();
+  m_FrameStats.m_sName = "Frame";
+  m_PassStats.Clear();
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezRendererTestRenderCost::DeInitializeSubTest(ezInt32 iIdentifier)
+{
+  ezRenderWorld::DeleteView(m_hView);
+  m_hView.Invalidate();
+
+  EZ_DEFAULT_DELETE(m_pWorld);
+
+  // The extracted render data still references the meshes and materials.
+  ezFrameAllocator::Reset();
+
+  m_Materials.Clear();
+  m_hPipeline.Invalidate();
+
+  m_pDevice->DestroyTexture(m_hColorTarget);
+  m_hColorTarget.Invalidate();
+  m_pDevice->DestroyTexture(m_hDepthTarget);
+  m_hDepthTarget.Invalidate();
+
+  return SUPER::DeInitializeSubTest(iIdentifier);
+}
+
+ezTestAppRun ezRendererTestRenderCost::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
+{
+  m_iFrame = uiInvocationCount;
+
+  RenderFrame();
+
+  if (uiInvocationCount < s_uiWarmUpFrames)
+    return ezTestAppRun::Continue;
+
+  if (iIdentifier == SubTests::ST_ParallelExtraction)
+  {
+    CompareParallelExtraction();
+    return ezTestAppRun::Quit;
+  }
+
+  AccumulateFrameStats();
+
+  if (m_uiMeasuredFrames < s_uiMeasuredFrames)
+    return ezTestAppRun::Continue;
+
+  const ezGALCommandStatsNull& lastFrame = static_cast<ezGALDeviceNull*>(m_pDevice)->GetLastFrameStats();
+  EZ_TEST_BOOL(lastFrame.m_uiDrawCalls > 0);
+
+  ReportStats();
+  return ezTestAppRun::Quit;
+}
+
+void ezRendererTestRenderCost::CreatePipeline()
+{
+  ezUniquePtr<ezRenderPipeline> pRenderPipeline = EZ_DEFAULT_NEW(ezRenderPipeline);
+
+  ezSourcePass* pColorSourcePass = nullptr;
+  {
+    ezUniquePtr<ezSourcePass> pPass = EZ_DEFAULT_NEW(ezSourcePass, "ColorSource");
+    pColorSourcePass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezSourcePass* pDepthSourcePass = nullptr;
+  {
+    ezUniquePtr<ezSourcePass> pPass = EZ_DEFAULT_NEW(ezSourcePass, "DepthStencil");
+
+    // The source format is only exposed as a property, pipelines are usually created in the editor.
+    const ezAbstractMemberProperty* pFormatProp = static_cast<const ezAbstractMemberProperty*>(ezGetStaticRTTI<ezSourcePass>()->FindPropertyByName("Format"));
+    ezReflectionUtils::SetMemberPropertyValue(pFormatProp, pPass.Borrow(), static_cast<ezInt64>(ezSourceFormat::Depth24BitStencil8Bit));
+
+    pDepthSourcePass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezOpaqueForwardRenderPass* pOpaquePass = nullptr;
+  {
+    ezUniquePtr<ezOpaqueForwardRenderPass> pPass = EZ_DEFAULT_NEW(ezOpaqueForwardRenderPass);
+    pOpaquePass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  ezTargetPass* pTargetPass = nullptr;
+  {
+    ezUniquePtr<ezTargetPass> pPass = EZ_DEFAULT_NEW(ezTargetPass);
+    pTargetPass = pPass.Borrow();
+    pRenderPipeline->AddPass(std::move(pPass));
+  }
+
+  EZ_VERIFY(pRenderPipeline->Connect(pColorSourcePass, "Output", pOpaquePass, "Color"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pDepthSourcePass, "Output", pOpaquePass, "DepthStencil"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pOpaquePass, "Color", pTargetPass, "Color0"), "Connect failed!");
+  EZ_VERIFY(pRenderPipeline->Connect(pOpaquePass, "DepthStencil", pTargetPass, "DepthStencil"), "Connect failed!");
+
+  pRenderPipeline->AddExtractor(EZ_DEFAULT_NEW(ezVisibleObjectsExtractor));
+
+  ezRenderPipelineResourceDescriptor desc;
+  ezRenderPipelineResourceLoader::CreateRenderPipelineResourceDescriptor(pRenderPipeline.Borrow(), desc);
+
+  m_hPipeline = ezResourceManager::GetOrCreateResource<ezRenderPipelineResource>("RenderCostPipeline", std::move(desc), "RenderCostPipeline");
+}
+
+void ezRendererTestRenderCost::CreateScene(ezUInt32 uiNumMaterials)
+{
+  ezShaderResourceHandle hMaterialShader = ezResourceManager::LoadResource<ezShaderResource>("Shaders/Materials/DefaultMaterial.ezShader");
+
+  m_Materials.Clear();
+  for (ezUInt32 i = 0; i < uiNumMaterials; ++i)
+  {
+    ezMaterialResourceDescriptor desc;
+    desc.m_hShader = hMaterialShader;
+    desc.m_RenderDataCategory = ezDefaultRenderDataCategories::LitOpaque;
+
+    auto& param = desc.m_Parameters.ExpandAndGetRef();
+    param.m_Name.Assign("BaseColor");
+    param.m_Value = ezColor::MakeHSV(360.0f * i / uiNumMaterials, 1.0f, 1.0f);
+
+    ezStringBuilder sName;
+    sName.SetFormat("RenderCostMaterial_{}", i);
+    m_Materials.PushBack(ezResourceManager::GetOrCreateResource<ezMaterialResource>(sName, std::move(desc), sName));
+  }
+
+  {
+    // The reflection pool loads its debug material from a transformed asset, which is not available in this test.
+    ezMaterialResourceDescriptor desc;
+    desc.m_hShader = hMaterialShader;
+    ezResourceManager::GetOrCreateResource<ezMaterialResource>("{ 6f8067d0-ece8-44e1-af46-79b49266de41 }", std::move(desc), "ReflectionProbeVisualization");
+  }
+
+  ezMeshResourceHandle hMesh;
+  {
+    ezMeshBufferResourceHandle hMeshBuffer = CreateSphere(2, 0.4f);
+    ezResourceLock<ezMeshBufferResource> pMeshBuffer(hMeshBuffer, ezResourceAcquireMode::BlockTillLoaded);
+
+    ezMeshResourceDescriptor desc;
+    desc.UseExistingMeshBuffer(hMeshBuffer);
+    desc.AddSubMesh(pMeshBuffer->GetPrimitiveCount(), 0, 0);
+    desc.ComputeBounds();
+
+    hMesh = ezResourceManager::GetOrCreateResource<ezMeshResource>("RenderCostMesh", std::move(desc), "RenderCostMesh");
+  }
+
+  ezWorldDesc worldDesc("RenderCost");
+  m_pWorld = EZ_DEFAULT_NEW(ezWorld, worldDesc);
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  ezMeshComponentManager* pManager = m_pWorld->GetOrCreateComponentManager<ezMeshComponentManager>();
+
+  // A wall of spheres in front of the camera, all of them are visible.
+  ezUInt32 uiObject = 0;
+  for (ezInt32 z = -s_iGridSize; z < s_iGridSize; ++z)
+  {
+    for (ezInt32 y = -s_iGridSize; y < s_iGridSize; ++y)
+    {
+      ezGameObjectDesc go;
+      go.m_LocalPosition.Set(0.0f, (float)y, (float)z);
+
+      ezGameObject* pObject = nullptr;
+      m_pWorld->CreateObject(go, pObject);
+
+      ezMeshComponent* pMesh = nullptr;
+      pManager->CreateComponent(pObject, pMesh);
+      pMesh->SetMesh(hMesh);
+      pMesh->SetMaterial(0, m_Materials[uiObject % m_Materials.GetCount()]);
+
+      ++uiObject;
+    }
+  }
+}
+
+void ezRendererTestRenderCost::RenderFrame()
+{
+  {
+    EZ_LOCK(m_pWorld->GetWriteMarker());
+    m_pWorld->Update();
+  }
+
+  ezRenderWorld::AddMainView(m_hView);
+  ezRenderWorld::ExtractMainViews();
+
+  ezRenderWorld::BeginFrame();
+  ezRenderWorld::Render(ezRenderContext::GetDefaultInstance());
+  ezRenderWorld::EndFrame();
+
+  ezRenderContext::GetDefaultInstance()->ResetContextState();
+  ezTaskSystem::FinishFrameTasks();
+  ezFrameAllocator::Swap();
+}
+
+void ezRendererTestRenderCost::AccumulateFrameStats()
+{
+  const ezGALDeviceNull* pDeviceNull = static_cast<ezGALDeviceNull*>(m_pDevice);
+
+  // Nothing was rendered yet (multi-threaded rendering renders the previous frame's data).
+  if (pDeviceNull->GetLastFrameScopes().IsEmpty())
+    return;
+
+  ++m_uiMeasuredFrames;
+
+  const ezGALCommandStatsNull& frameStats = pDeviceNull->GetLastFrameStats();
+  m_FrameStats.m_uiDrawCalls += frameStats.m_uiDrawCalls;
+  m_FrameStats.m_uiStateChanges += frameStats.GetTotalStateChanges();
+
+  for (const ezGALCommandScopeNull& scope : pDeviceNull->GetLastFrameScopes())
+  {
+    // The top-level scope is the frame itself, its name contains the frame number.
+    if (scope.m_uiDepth == 0)
+    {
+      m_FrameStats.m_CpuDuration += scope.m_CpuDuration;
+      continue;
+    }
+
+    PassStats* pStats = nullptr;
+    for (PassStats& stats : m_PassStats)
+    {
+      if (stats.m_uiDepth == scope.m_uiDepth && stats.m_sName == scope.GetName())
+      {
+        pStats = &stats;
+        break;
+      }
+    }
+
+    if (pStats == nullptr)
+    {
+      pStats = &m_PassStats.ExpandAndGetRef();
+      pStats->m_sName = scope.GetName();
+      pStats->m_uiDepth = scope.m_uiDepth;
+    }
+
+    pStats->m_CpuDuration += scope.m_CpuDuration;
+    pStats->m_uiDrawCalls += scope.m_Stats.m_uiDrawCalls;
+    pStats->m_uiStateChanges += scope.m_Stats.GetTotalStateChanges();
+  }
+}
+
+void ezRendererTestRenderCost::ReportStats()
+{
+  const double fFrames = (double)m_uiMeasuredFrames;
+
+  auto Report = [&](const PassStats& stats)
+  {
+    ezStringBuilder sIndent;
+    for (ezUInt32 i = 1; i < stats.m_uiDepth; ++i)
+      sIndent.Append("  ");
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%s%s: %.3f ms, %.1f draw calls, %.1f state changes", sIndent.GetData(), stats.m_sName.GetData(),
+      stats.m_CpuDuration.GetMilliseconds() / fFrames, stats.m_uiDrawCalls / fFrames, stats.m_uiStateChanges / fFrames);
+  };
+
+  Report(m_FrameStats);
+  for (const PassStats& stats : m_PassStats)
+  {
+    Report(stats);
+  }
+}
+
+void ezRendererTestRenderCost::CompareParallelExtraction()
+{
+  ezView* pView = nullptr;
+  if (!EZ_TEST_BOOL(ezRenderWorld::TryGetView(m_hView, pView)))
+    return;
+
+  ezDynamicArray<const ezGameObject*> visibleObjects;
+  {
+    EZ_LOCK(m_pWorld->GetReadMarker());
+
+    for (auto it = static_cast<const ezWorld*>(m_pWorld)->GetObjects(); it.IsValid(); ++it)
+    {
+      visibleObjects.PushBack(it);
+    }
+  }
+
+  // Parallel extraction is only used above a minimum number of visible objects.
+  EZ_TEST_BOOL(visibleObjects.GetCount() > 256);
+
+  ezCVarBool* pMultithreading = (ezCVarBool*)ezCVar::FindCVarByName("Rendering.Multithreading");
+  if (!EZ_TEST_BOOL(pMultithreading != nullptr))
+    return;
+
+  const bool bPrevMultithreading = *pMultithreading;
+
+  ezVisibleObjectsExtractor extractor;
+
+  auto Extract = [&](bool bMultithreading, ezExtractedRenderData& ref_renderData)
+  {
+    *pMultithreading = bMultithreading;
+
+    ref_renderData.SetCamera(m_Camera);
+    extractor.Extract(*pView, visibleObjects, ref_renderData);
+    ref_renderData.SortAndBatch();
+  };
+
+  ezExtractedRenderData serialData;
+  ezExtractedRenderData parallelData;
+  Extract(false, serialData);
+  Extract(true, parallelData);
+
+  *pMultithreading = bPrevMultithreading;
+
+  // The render data itself is allocated anew by each extraction, so compare the owners and sorting keys instead of the pointers.
+  ezUInt32 uiNumRenderData = 0;
+
+  ezDynamicArray<ezHashedString> categoryNames;
+  ezRenderData::GetAllCategoryNames(categoryNames);
+
+  for (const ezHashedString& sCategoryName : categoryNames)
+  {
+    const ezRenderData::Category category = ezRenderData::FindCategory(sCategoryName);
+
+    const ezRenderDataBatchList serialBatches = serialData.GetRenderDataBatchesWithCategory(category);
+    const ezRenderDataBatchList parallelBatches = parallelData.GetRenderDataBatchesWithCategory(category);
+
+    if (!EZ_TEST_INT(serialBatches.GetBatchCount(), parallelBatches.GetBatchCount()))
+      continue;
+
+    for (ezUInt32 uiBatch = 0; uiBatch < serialBatches.GetBatchCount(); ++uiBatch)
+    {
+      const ezRenderDataBatch serialBatch = serialBatches.GetBatch(uiBatch);
+      const ezRenderDataBatch parallelBatch = parallelBatches.GetBatch(uiBatch);
+
+      if (!EZ_TEST_INT(serialBatch.GetCount(), parallelBatch.GetCount()))
+        continue;
+
+      auto parallelIt = parallelBatch.GetIterator<ezRenderData>();
+      for (auto serialIt = serialBatch.GetIterator<ezRenderData>(); serialIt.IsValid(); ++serialIt, ++parallelIt)
+      {
+        EZ_TEST_BOOL(serialIt->m_hOwner == parallelIt->m_hOwner);
+        EZ_TEST_INT(serialIt->m_uiSortingKey, parallelIt->m_uiSortingKey);
+        EZ_TEST_INT(serialIt->m_uiBatchId, parallelIt->m_uiBatchId);
+
+        ++uiNumRenderData;
+      }
+    }
+  }
+
+  // Every sphere is extracted exactly once.
+  EZ_TEST_INT(uiNumRenderData, (ezUInt32)(4 * s_iGridSize * s_iGridSize));
+}
+
+static ezRendererTestRenderCost g_RenderCostTest;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../TestClass/TestClass.h"
+#include <Core/World/World.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/Pipeline/RenderPipelineResource.h>
+
+/// \brief Renders a world with many meshes through a complete render pipeline on the null device and reports the CPU cost.
+///
+/// The test always runs on the null device ('-renderer' is ignored), so it works headless and measures only the CPU side of rendering.
+/// After a few warm-up frames, it reports the average CPU time, draw calls and state changes per frame and per pass.
+/// The 'Parallel Extraction' sub-test instead checks that extracting the scene on multiple threads yields the same sorted render data as serial extraction.
+class ezRendererTestRenderCost : public ezGraphicsTest
+{
+  using SUPER = ezGraphicsTest;
+
+  enum SubTests
+  {
+    ST_SharedMaterial,
+    ST_UniqueMaterials,
+    ST_ParallelExtraction,
+  };
+
+public:
+  virtual const char* GetTestName() const override { return "RenderCost"; }
+
+private:
+  virtual void SetupSubTests() override;
+
+  virtual ezResult InitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezResult DeInitializeSubTest(ezInt32 iIdentifier) override;
+  virtual ezTestAppRun RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount) override;
+
+  void CreatePipeline();
+  void CreateScene(ezUInt32 uiNumMaterials);
+  void RenderFrame();
+  void AccumulateFrameStats();
+  void ReportStats();
+  void CompareParallelExtraction();
+
+  struct PassStats
+  {
+    ezString m_sName;
+    ezUInt32 m_uiDepth = 0;
+    ezTime m_CpuDuration;
+    ezUInt64 m_uiDrawCalls = 0;
+    ezUInt64 m_uiStateChanges = 0;
+  };
+
+  ezWorld* m_pWorld = nullptr;
+  ezCamera m_Camera;
+  ezViewHandle m_hView;
+  ezGALTextureHandle m_hColorTarget;
+  ezGALTextureHandle m_hDepthTarget;
+  ezRenderPipelineResourceHandle m_hPipeline;
+  ezHybridArray<ezMaterialResourceHandle, 64> m_Materials;
+
+  ezUInt32 m_uiMeasuredFrames = 0;
+  PassStats m_FrameStats;
+  ezDynamicArray<PassStats> m_PassStats;
+};
@@ -0,0 +1,211 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Memory/FrameAllocator.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererCore/Lights/Implementation/ClusteredDataUtils.h>
+
+namespace
+{
+  struct TestCluster
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_BitMask[1024 / 32];
+  };
+
+  using ClusterArray = ezDynamicArray<TestCluster>;
+  using BoundingSphereArray = ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper>;
+
+  struct TestLight
+  {
+    ezSimdBSphere m_Sphere;
+    BoundingCone m_Cone;
+    bool m_bIsSpot;
+  };
+
+  /// Creates point and spot lights scattered in front of the camera, some of them intersecting the near plane.
+  void CreateTestLights(ezDynamicArray<TestLight>& out_lights, ezUInt32 uiCount)
+  {
+    ezUInt32 uiSeed = 42;
+    auto Random = [&](float fMin, float fMax)
+    {
+      uiSeed = uiSeed * 1664525u + 1013904223u;
+      return fMin + (fMax - fMin) * static_cast<float>(uiSeed >> 8) / static_cast<float>(1u << 24);
+    };
+
+    out_lights.Clear();
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      TestLight& light = out_lights.ExpandAndGetRef();
+
+      const ezVec3 vPosition(Random(-5.0f, 150.0f), Random(-60.0f, 60.0f), Random(-20.0f, 20.0f));
+      const float fRange = Random(0.5f, 15.0f);
+
+      light.m_bIsSpot = (i % 3) == 0;
+      light.m_Sphere = ezSimdBSphere(ezSimdConversion::ToVec3(vPosition), fRange);
+
+      const ezAngle halfAngle = ezAngle::MakeFromDegree(Random(5.0f, 80.0f));
+      const ezVec3 vDir = ezVec3(Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f)).GetNormalized();
+
+      light.m_Cone.m_PositionAndRange = ezSimdConversion::ToVec3(vPosition);
+      light.m_Cone.m_PositionAndRange.SetW(fRange);
+      light.m_Cone.m_ForwardDir = ezSimdConversion::ToVec3(vDir);
+      light.m_Cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
+    }
+  }
+
+  /// Assigns the lights one cluster at a time, the way the extractor did before lights were assigned per depth slice.
+  void AssignLightsScalar(ezArrayPtr<const TestLight> lights, const ezSimdMat4f& mViewMatrix, const ezSimdMat4f& mProjectionMatrix, BoundingSphereArray& ref_clusterBoundingSpheres, ClusterArray& ref_clusters)
+  {
+    for (ezUInt32 uiLightIndex = 0; uiLightIndex < lights.GetCount(); ++uiLightIndex)
+    {
+      const TestLight& light = lights[uiLightIndex];
+
+      if (!light.m_bIsSpot)
+      {
+        RasterizeSphere(light.m_Sphere, uiLightIndex, mViewMatrix, mProjectionMatrix, ref_clusters.GetData(), ref_clusterBoundingSpheres.GetData());
+        continue;
+      }
+
+      const BoundingCone& cone = light.m_Cone;
+      const ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(GetConeBoundingSphere(cone), mViewMatrix, mProjectionMatrix);
+
+      const ezUInt32 uiBlockIndex = uiLightIndex / 32;
+      const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
+
+      FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, ref_clusters.GetData(), [&](ezUInt32 uiClusterIndex)
+        {
+          ezSimdBSphere clusterSphere = ref_clusterBoundingSpheres[uiClusterIndex];
+          ezSimdFloat clusterRadius = clusterSphere.GetRadius();
+
+          ezSimdVec4f toConePos = clusterSphere.m_CenterAndRadius - cone.m_PositionAndRange;
+          ezSimdFloat projected = cone.m_ForwardDir.Dot<3>(toConePos);
+          ezSimdFloat distToConeSq = toConePos.Dot<3>(toConePos);
+          ezSimdFloat distClosestP = cone.m_SinCosAngle.y() * (distToConeSq - projected * projected).GetSqrt() - projected * cone.m_SinCosAngle.x();
+
+          bool angleCull = distClosestP > clusterRadius;
+          bool frontCull = projected > clusterRadius + cone.m_PositionAndRange.w();
+          bool backCull = projected < -clusterRadius;
+
+          return !(angleCull || frontCull || backCull); });
+    }
+  }
+
+  void AssignLights(ezArrayPtr<const TestLight> lights, const ezSimdMat4f& mViewMatrix, const ezSimdMat4f& mProjectionMatrix, BoundingSphereArray& ref_clusterBoundingSpheres, ClusterArray& ref_clusters, bool bMultiThreaded)
+  {
+    ezDynamicArray<ClusterLight> clusterLights(ezFrameAllocator::GetCurrentAllocator());
+    clusterLights.Reserve(lights.GetCount());
+
+    for (ezUInt32 uiLightIndex = 0; uiLightIndex < lights.GetCount(); ++uiLightIndex)
+    {
+      const TestLight& light = lights[uiLightIndex];
+
+      if (light.m_bIsSpot)
+      {
+        MakeConeClusterLight(clusterLights.ExpandAndGetRef(), light.m_Cone, uiLightIndex, mViewMatrix, mProjectionMatrix);
+      }
+      else
+      {
+        MakeSphereClusterLight(clusterLights.ExpandAndGetRef(), light.m_Sphere, uiLightIndex, mViewMatrix, mProjectionMatrix);
+      }
+    }
+
+    AssignLightsToClusters<TestCluster>(clusterLights, ref_clusterBoundingSpheres, ref_clusters, bMultiThreaded);
+  }
+} // namespace
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+static const ezTestBlock::Enum LightAssignmentBenchmarkEnabled = ezTestBlock::DisabledNoWarning;
+#else
+static const ezTestBlock::Enum LightAssignmentBenchmarkEnabled = ezTestBlock::Enabled;
+#endif
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Lights);
+
+EZ_CREATE_SIMPLE_TEST(Lights, ClusteredLightAssignment)
+{
+  const float fAspectRatio = 16.0f / 9.0f;
+
+  ezCamera camera;
+  camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 70.0f, 0.1f, 1000.0f);
+  camera.LookAt(ezVec3(-10, 0, 0), ezVec3(0, 0, 0), ezVec3(0, 0, 1));
+
+  ezMat4 tmp = camera.GetViewMatrix();
+  const ezSimdMat4f viewMatrix = ezSimdConversion::ToMat4(tmp);
+  camera.GetProjectionMatrix(fAspectRatio, tmp);
+  const ezSimdMat4f projectionMatrix = ezSimdConversion::ToMat4(tmp);
+
+  BoundingSphereArray clusterBoundingSpheres;
+  clusterBoundingSpheres.SetCountUninitialized(NUM_CLUSTERS);
+  FillClusterBoundingSpheres(camera, fAspectRatio, clusterBoundingSpheres);
+
+  ClusterArray expected;
+  ClusterArray actual;
+  expected.SetCount(NUM_CLUSTERS);
+  actual.SetCount(NUM_CLUSTERS);
+
+  ezDynamicArray<TestLight> lights;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compare with scalar assignment")
+  {
+    CreateTestLights(lights, 1024);
+    AssignLightsScalar(lights, viewMatrix, projectionMatrix, clusterBoundingSpheres, expected);
+
+    for (bool bMultiThreaded : {false, true})
+    {
+      ezMemoryUtils::ZeroFill(actual.GetData(), NUM_CLUSTERS);
+      AssignLights(lights, viewMatrix, projectionMatrix, clusterBoundingSpheres, actual, bMultiThreaded);
+
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(expected.GetData(), actual.GetData(), NUM_CLUSTERS));
+    }
+
+    // make sure the test actually covers something
+    ezUInt32 uiNumAssignments = 0;
+    for (const TestCluster& cluster : expected)
+    {
+      for (ezUInt32 uiMask : cluster.m_BitMask)
+      {
+        uiNumAssignments += ezMath::CountBits(uiMask);
+      }
+    }
+
+    EZ_TEST_BOOL(uiNumAssignments > 1000);
+
+    ezFrameAllocator::Reset();
+  }
+
+  EZ_TEST_BLOCK(LightAssignmentBenchmarkEnabled, "Benchmark")
+  {
+    const ezUInt32 uiNumIterations = 20;
+
+    for (ezUInt32 uiNumLights : {64u, 256u, 1024u})
+    {
+      CreateTestLights(lights, uiNumLights);
+
+      ezTime durations[3];
+      for (ezUInt32 uiMode = 0; uiMode < 3; ++uiMode)
+      {
+        ezStopwatch sw;
+        for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+        {
+          ezMemoryUtils::ZeroFill(actual.GetData(), NUM_CLUSTERS);
+
+          if (uiMode == 0)
+          {
+            AssignLightsScalar(lights, viewMatrix, projectionMatrix, clusterBoundingSpheres, actual);
+          }
+          else
+          {
+            AssignLights(lights, viewMatrix, projectionMatrix, clusterBoundingSpheres, actual, uiMode == 2);
+          }
+
+          ezFrameAllocator::Reset();
+        }
+        durations[uiMode] = sw.GetRunningTotal() / uiNumIterations;
+      }
+
+      ezTestFramework::Output(ezTestOutput::Duration, "%u lights: scalar %.3fms, SIMD %.3fms, SIMD multi-threaded %.3fms", uiNumLights,
+        durations[0].GetMilliseconds(), durations[1].GetMilliseconds(), durations[2].GetMilliseconds());
+    }
+  }
+}
@@ -0,0 +1,158 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Core/Graphics/Camera.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Math/Color8UNorm.h>
+#include <Foundation/SimdMath/SimdBBox.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <RendererCore/Rasterizer/RasterizerObject.h>
+#include <RendererCore/Rasterizer/RasterizerView.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Rasterizer);
+
+EZ_CREATE_SIMPLE_TEST(Rasterizer, RasterizerView)
+{
+  ezCamera camera;
+  camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 90.0f, 0.1f, 200.0f);
+  camera.LookAt(ezVec3::MakeZero(), ezVec3(1, 0, 0), ezVec3(0, 0, 1));
+
+  ezRasterizerView view;
+  view.SetResolution(256, 128, 2.0f);
+  view.SetCamera(&camera);
+
+  // a wall in front of the camera that covers the center of the view
+  ezSharedPtr<const ezRasterizerObject> pWall = ezRasterizerObject::CreateBox(ezVec3(1.0f, 20.0f, 10.0f));
+
+  view.BeginScene();
+  view.AddObject(pWall.Borrow(), ezTransform(ezVec3(10.0f, 0.0f, 0.0f)));
+  view.EndScene();
+
+  // boxes in front of and behind the wall, some of them only partially hidden
+  ezDynamicArray<ezSimdBBox> boxes;
+  ezUInt32 uiSeed = 42;
+  auto Random = [&](float fMin, float fMax)
+  {
+    uiSeed = uiSeed * 1664525u + 1013904223u;
+    return fMin + (fMax - fMin) * static_cast<float>(uiSeed >> 8) / static_cast<float>(1u << 24);
+  };
+
+  for (ezUInt32 i = 0; i < 4096; ++i)
+  {
+    const ezVec3 vCenter(Random(2.0f, 40.0f), Random(-30.0f, 30.0f), Random(-15.0f, 15.0f));
+    const ezVec3 vHalfExtents(Random(0.1f, 2.0f), Random(0.1f, 2.0f), Random(0.1f, 2.0f));
+
+    boxes.PushBack(ezSimdBBox::MakeFromCenterAndHalfExtents(ezSimdConversion::ToVec3(vCenter), ezSimdConversion::ToVec3(vHalfExtents)));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batch and single queries match")
+  {
+    ezDynamicArray<bool> visible;
+    visible.SetCount(boxes.GetCount());
+
+    view.IsVisible(boxes, visible);
+
+    ezUInt32 uiNumOccluded = 0;
+    for (ezUInt32 i = 0; i < boxes.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(visible[i] == view.IsVisible(boxes[i]));
+
+      uiNumOccluded += visible[i] ? 0 : 1;
+    }
+
+    if (view.HasRasterizedAnyOccluders())
+    {
+      EZ_TEST_BOOL(uiNumOccluded > 0 && uiNumOccluded < boxes.GetCount());
+    }
+
+    // small batches are not split across tasks
+    ezArrayPtr<const ezSimdBBox> firstBoxes = boxes.GetArrayPtr().GetSubArray(0, 16);
+    ezDynamicArray<bool> visibleFirst;
+    visibleFirst.SetCount(firstBoxes.GetCount());
+
+    view.IsVisible(firstBoxes, visibleFirst);
+
+    for (ezUInt32 i = 0; i < firstBoxes.GetCount(); ++i)
+    {
+      EZ_TEST_BOOL(visibleFirst[i] == visible[i]);
+    }
+  }
+
+#if EZ_ENABLED(EZ_RASTERIZER_SUPPORTED)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Tiled and single-tile rasterization match")
+  {
+    ezCVarBool* pMultithreading = (ezCVarBool*)ezCVar::FindCVarByName("Rendering.Multithreading");
+    ezCVarInt* pMaxTiles = (ezCVarInt*)ezCVar::FindCVarByName("Spatial.Occlusion.MaxTiles");
+    if (!EZ_TEST_BOOL(pMultithreading != nullptr && pMaxTiles != nullptr))
+      return;
+
+    const bool bPrevMultithreading = *pMultithreading;
+    const int iPrevMaxTiles = *pMaxTiles;
+
+    // occluders of different sizes all over the view, many of them cross tile borders
+    // stay below Spatial.Occlusion.MaxOccluders, so that both variants rasterize all of them
+    ezHybridArray<ezTransform, 32> occluders;
+    occluders.PushBack(ezTransform(ezVec3(10.0f, 0.0f, 0.0f)));
+    for (ezUInt32 i = 0; i < 31; ++i)
+    {
+      occluders.PushBack(ezTransform(ezVec3(Random(4.0f, 30.0f), Random(-25.0f, 25.0f), Random(-20.0f, 20.0f)), ezQuat::MakeFromAxisAndAngle(ezVec3(0, 0, 1), ezAngle::MakeFromDegree(Random(0.0f, 90.0f)))));
+    }
+
+    ezSharedPtr<const ezRasterizerObject> pOccluder = ezRasterizerObject::CreateBox(ezVec3(1.0f, 4.0f, 3.0f));
+
+    auto RenderScene = [&](bool bTiled, ezDynamicArray<ezColorLinearUB>& out_depth, ezDynamicArray<bool>& out_visible)
+    {
+      *pMultithreading = bTiled;
+      *pMaxTiles = 4;
+
+      // the tiles are set up from the cvars in SetResolution()
+      ezRasterizerView sceneView;
+      sceneView.SetResolution(256, 256, 2.0f);
+      sceneView.SetCamera(&camera);
+
+      sceneView.BeginScene();
+      sceneView.AddObject(pWall.Borrow(), occluders[0]);
+      for (ezUInt32 i = 1; i < occluders.GetCount(); ++i)
+      {
+        sceneView.AddObject(pOccluder.Borrow(), occluders[i]);
+      }
+      sceneView.EndScene();
+
+      out_depth.SetCount(256 * 256);
+      sceneView.ReadBackFrame(out_depth);
+
+      out_visible.SetCount(boxes.GetCount());
+      sceneView.IsVisible(boxes, out_visible);
+    };
+
+    ezDynamicArray<ezColorLinearUB> depthSingle, depthTiled;
+    ezDynamicArray<bool> visibleSingle, visibleTiled;
+
+    RenderScene(false, depthSingle, visibleSingle);
+    RenderScene(true, depthTiled, visibleTiled);
+
+    *pMultithreading = bPrevMultithreading;
+    *pMaxTiles = iPrevMaxTiles;
+
+    // the tiles use a remapped projection, so triangle edges may round differently in a few pixels
+    ezUInt32 uiNumDifferentPixels = 0;
+    for (ezUInt32 i = 0; i < depthSingle.GetCount(); ++i)
+    {
+      if (ezMath::Abs((ezInt32)depthSingle[i].r - (ezInt32)depthTiled[i].r) > 1)
+        ++uiNumDifferentPixels;
+    }
+
+    EZ_TEST_BOOL(uiNumDifferentPixels <= depthSingle.GetCount() / 100);
+
+    ezUInt32 uiNumDifferentBoxes = 0;
+    ezUInt32 uiNumOccluded = 0;
+    for (ezUInt32 i = 0; i < boxes.GetCount(); ++i)
+    {
+      uiNumDifferentBoxes += (visibleSingle[i] != visibleTiled[i]) ? 1 : 0;
+      uiNumOccluded += visibleSingle[i] ? 0 : 1;
+    }
+
+    EZ_TEST_BOOL(uiNumOccluded > 0);
+    EZ_TEST_BOOL(uiNumDifferentBoxes <= boxes.GetCount() / 100);
+  }
+#endif
+}
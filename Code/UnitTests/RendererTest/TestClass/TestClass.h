@@ -23,7 +23,8 @@ struct ObjectCB
 class ezGraphicsTest : public ezTestBaseClass
 {
 public:
-  static ezResult CreateRenderer(ezGALDevice*& out_pDevice);
+  /// \brief Creates the device of the renderer selected with the '-renderer' command line option, or \a sRendererName if it is not empty.
+  static ezResult CreateRenderer(ezGALDevice*& out_pDevice, ezStringView sRendererName = {});
   static void SetClipSpace();
 
 public:
@@ -43,7 +44,7 @@ protected:
   ezSizeU32 GetResolution() const;
 
 protected:
-  ezResult SetupRenderer();
+  ezResult SetupRenderer(ezStringView sRendererName = {});
   void ShutdownRenderer();
 
   ezResult CreateWindow(ezUInt32 uiResolutionX = 960, ezUInt32 uiResolutionY = 540);
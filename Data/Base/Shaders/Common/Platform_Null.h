@@ -0,0 +1,43 @@
+#pragma once
+
+#define PLATFORM_NULL EZ_OFF
+
+#if defined(NULL_GAL)
+
+#  undef PLATFORM_SHADER
+#  define PLATFORM_SHADER EZ_ON
+
+#  undef PLATFORM_NULL
+#  define PLATFORM_NULL EZ_ON
+
+// The null renderer never executes shaders, the shader compiler only extracts the resource bindings from the source.
+// Push constants are declared as a normal constant buffer, like on DX11, so that they show up as a binding.
+#  define BEGIN_PUSH_CONSTANTS(Name) cbuffer Name
+#  define END_PUSH_CONSTANTS(Name) ;
+#  define GET_PUSH_CONSTANT(Name, Constant) Constant
+
+#  define SUPPORTS_TEXEL_BUFFER EZ_ON
+#  define SUPPORTS_MSAA_ARRAYS EZ_ON
+
+float ezEvaluateAttributeAtSample(float Attribute, uint SampleIndex, uint NumMsaaSamples)
+{
+  return Attribute;
+}
+float2 ezEvaluateAttributeAtSample(float2 Attribute, uint SampleIndex, uint NumMsaaSamples)
+{
+  return Attribute;
+}
+float3 ezEvaluateAttributeAtSample(float3 Attribute, uint SampleIndex, uint NumMsaaSamples)
+{
+  return Attribute;
+}
+float4 ezEvaluateAttributeAtSample(float4 Attribute, uint SampleIndex, uint NumMsaaSamples)
+{
+  return Attribute;
+}
+
+float4 ezSampleLevel_PointClampBorder(Texture2DArray DepthTexture, SamplerState DepthSampler, float2 SamplePos, int ArrayIndex, int MipLevel, float4 BorderColor)
+{
+  return DepthTexture.SampleLevel(DepthSampler, float3(SamplePos, ArrayIndex), MipLevel);
+}
+#endif